@@ -8,6 +8,7 @@ namespace Render::Creature::Bpat {
 
 inline constexpr std::array<std::uint8_t, 4> k_magic{'B', 'P', 'A', 'T'};
 inline constexpr std::uint32_t k_version = 3U;
+inline constexpr std::uint32_t k_version_quantized = 4U;
 
 inline constexpr std::uint32_t k_species_humanoid = 0U;
 inline constexpr std::uint32_t k_species_horse = 1U;
@@ -57,6 +58,38 @@ inline constexpr std::uint8_t k_no_parent_bone = 0xFFU;
 static_assert(sizeof(BpatHeaderExtV3) == 32,
               "BpatHeaderExtV3 must be exactly 32 bytes");
 
+struct BpatHeaderExtV4 {
+  std::uint64_t track_table_offset;
+  std::uint64_t key_data_offset;
+  std::uint32_t key_count;
+  float rotation_tolerance;
+  float translation_tolerance;
+  std::uint32_t reserved0;
+};
+
+static_assert(sizeof(BpatHeaderExtV4) == 32,
+              "BpatHeaderExtV4 must be exactly 32 bytes");
+
+struct BpatTrackEntry {
+  std::uint32_t key_offset;
+  std::uint32_t key_count;
+  float translation_min[3];
+  float translation_step[3];
+};
+
+static_assert(sizeof(BpatTrackEntry) == 32, "BpatTrackEntry must be exactly 32 bytes");
+
+struct BpatPoseKey {
+  std::int16_t rotation[4];
+  std::uint16_t translation[3];
+  std::uint16_t frame;
+};
+
+static_assert(sizeof(BpatPoseKey) == 16, "BpatPoseKey must be exactly 16 bytes");
+
+inline constexpr float k_rotation_quantization = 32767.0F;
+inline constexpr float k_translation_quantization = 65535.0F;
+
 inline constexpr std::uint8_t k_clip_flag_supplies_ground_contact = 0x01U;
 
 struct BpatFrameContact {
@@ -1,24 +1,101 @@
 #include "bpat_reader.h"
+#include "bpat_tracks.h"
 
-#include <QMatrix3x3>
+#include <QFile>
+#include <QString>
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <fstream>
 #include <functional>
 #include <iterator>
+#include <mutex>
 #include <utility>
 
 namespace Render::Creature::Bpat {
 
-auto BpatBlob::from_bytes(std::vector<std::uint8_t> bytes) -> BpatBlob {
+struct BpatBlob::Storage {
+  std::vector<std::uint8_t> bytes{};
+  std::unique_ptr<QFile> file{};
+  const std::uint8_t* data{nullptr};
+  std::size_t size{0U};
+};
+
+struct BpatBlob::DecodedClip {
+  std::vector<QMatrix4x4> palette{};
+  std::vector<LocalBonePose> local_poses{};
+
+  [[nodiscard]] auto bytes() const noexcept -> std::size_t {
+    return palette.capacity() * sizeof(QMatrix4x4) +
+           local_poses.capacity() * sizeof(LocalBonePose);
+  }
+};
+
+struct BpatBlob::ClipCache {
+  struct Slot {
+    std::atomic<const DecodedClip*> decoded{nullptr};
+    std::atomic<std::uint32_t> last_used{0U};
+    std::unique_ptr<DecodedClip> owned{};
+  };
+
+  explicit ClipCache(std::uint32_t clip_count)
+      : entries(std::make_unique<Slot[]>(clip_count)), entry_count(clip_count) {}
+
+  std::unique_ptr<Slot[]> entries;
+  std::uint32_t entry_count{0U};
+  std::atomic<std::uint32_t> epoch{1U};
+  std::atomic<std::uint32_t> resident{0U};
+  std::atomic<std::size_t> resident_bytes{0U};
+  std::mutex mutex{};
+  std::vector<std::unique_ptr<DecodedClip>> retired{};
+};
+
+namespace {
+
+auto decode_column_major(const float* src) -> QMatrix4x4 {
+  QMatrix4x4 m;
+  std::memcpy(m.data(), src, sizeof(float) * k_matrix_floats);
+  m.optimize();
+  return m;
+}
+
+} // namespace
+
+BpatBlob::BpatBlob() = default;
+BpatBlob::~BpatBlob() = default;
+BpatBlob::BpatBlob(BpatBlob&& other) noexcept = default;
+auto BpatBlob::operator=(BpatBlob&& other) noexcept -> BpatBlob& = default;
+
+auto BpatBlob::from_storage(std::shared_ptr<const Storage> storage) -> BpatBlob {
   BpatBlob blob{};
-  blob.m_bytes = std::move(bytes);
+  blob.m_storage = std::move(storage);
   blob.m_loaded = blob.validate();
   return blob;
 }
 
-auto BpatBlob::from_file(const std::string& path) -> BpatBlob {
+auto BpatBlob::from_bytes(std::vector<std::uint8_t> bytes) -> BpatBlob {
+  auto storage = std::make_shared<Storage>();
+  storage->bytes = std::move(bytes);
+  storage->data = storage->bytes.data();
+  storage->size = storage->bytes.size();
+  return from_storage(std::move(storage));
+}
+
+auto BpatBlob::from_file(const std::string& path, LoadMode mode) -> BpatBlob {
+  if (mode == LoadMode::Map) {
+    auto file = std::make_unique<QFile>(QString::fromStdString(path));
+    if (file->open(QIODevice::ReadOnly) && file->size() > 0) {
+      const qint64 size = file->size();
+      if (uchar* mapped = file->map(0, size); mapped != nullptr) {
+        auto storage = std::make_shared<Storage>();
+        storage->data = mapped;
+        storage->size = static_cast<std::size_t>(size);
+        storage->file = std::move(file);
+        return from_storage(std::move(storage));
+      }
+    }
+  }
   std::ifstream in(path, std::ios::binary);
   if (!in) {
     BpatBlob blob{};
@@ -30,6 +107,17 @@ auto BpatBlob::from_file(const std::string& path) -> BpatBlob {
   return from_bytes(std::move(data));
 }
 
+auto BpatBlob::mapped() const noexcept -> bool {
+  return m_storage != nullptr && m_storage->file != nullptr;
+}
+
+auto BpatBlob::raw_bytes() const noexcept -> std::span<const std::uint8_t> {
+  if (m_storage == nullptr) {
+    return {};
+  }
+  return {m_storage->data, m_storage->size};
+}
+
 bool BpatBlob::validate() {
   m_last_error.clear();
   m_header = nullptr;
@@ -42,25 +130,29 @@ bool BpatBlob::validate() {
   m_contact_count = 0U;
   m_bind_palette_data = nullptr;
   m_bone_parent_data = nullptr;
+  m_track_table = nullptr;
+  m_track_keys = nullptr;
   m_decoded_bind_palette.clear();
   m_decoded_inverse_bind_palette.clear();
-  m_decoded_local_poses.clear();
+  m_clip_cache.reset();
   m_clip_index_entries.clear();
   m_clip_index_buckets.clear();
 
-  if (m_bytes.size() < sizeof(BpatHeader)) {
+  auto const bytes = raw_bytes();
+  if (bytes.size() < sizeof(BpatHeader)) {
     m_last_error = "file shorter than header";
     return false;
   }
-  auto const* header = reinterpret_cast<const BpatHeader*>(m_bytes.data());
+  auto const* header = reinterpret_cast<const BpatHeader*>(bytes.data());
   if (std::memcmp(header->magic, k_magic.data(), k_magic.size()) != 0) {
     m_last_error = "magic mismatch";
     return false;
   }
-  if (header->version != k_version) {
+  if (header->version != k_version && header->version != k_version_quantized) {
     m_last_error = "unsupported version";
     return false;
   }
+  bool const quantized = header->version == k_version_quantized;
   if (header->species_id > k_max_species_id) {
     m_last_error = "unknown species_id";
     return false;
@@ -74,7 +166,7 @@ bool BpatBlob::validate() {
     return false;
   }
 
-  std::uint64_t const file_size = m_bytes.size();
+  std::uint64_t const file_size = bytes.size();
   auto in_bounds = [file_size](std::uint64_t offset, std::uint64_t bytes) {
     return offset <= file_size && offset + bytes <= file_size;
   };
@@ -95,9 +187,11 @@ bool BpatBlob::validate() {
     return false;
   }
 
-  std::uint64_t const palette_bytes = std::uint64_t{header->frame_total} *
-                                      header->bone_count * k_matrix_floats *
-                                      sizeof(float);
+  std::uint64_t const palette_bytes = quantized
+                                          ? 0U
+                                          : std::uint64_t{header->frame_total} *
+                                                header->bone_count * k_matrix_floats *
+                                                sizeof(float);
   if (!in_bounds(header->palette_data_offset, palette_bytes)) {
     m_last_error = "palette data out of bounds";
     return false;
@@ -115,12 +209,12 @@ bool BpatBlob::validate() {
     return false;
   }
 
-  if (m_bytes.size() < sizeof(BpatHeader) + sizeof(BpatHeaderExtV3)) {
+  if (bytes.size() < sizeof(BpatHeader) + sizeof(BpatHeaderExtV3)) {
     m_last_error = "file shorter than v3 extension header";
     return false;
   }
   auto const* ext =
-      reinterpret_cast<const BpatHeaderExtV3*>(m_bytes.data() + sizeof(BpatHeader));
+      reinterpret_cast<const BpatHeaderExtV3*>(bytes.data() + sizeof(BpatHeader));
   if (ext->contact_entry_count != 0U) {
     if (ext->contact_entry_count != header->frame_total) {
       m_last_error = "contact table size != frame_total";
@@ -133,7 +227,7 @@ bool BpatBlob::validate() {
       return false;
     }
     m_contact_data = reinterpret_cast<const BpatFrameContact*>(
-        m_bytes.data() + ext->contact_data_offset);
+        bytes.data() + ext->contact_data_offset);
     m_contact_count = ext->contact_entry_count;
   }
   if (ext->bind_palette_offset != 0U) {
@@ -144,14 +238,14 @@ bool BpatBlob::validate() {
       return false;
     }
     m_bind_palette_data =
-        reinterpret_cast<const float*>(m_bytes.data() + ext->bind_palette_offset);
+        reinterpret_cast<const float*>(bytes.data() + ext->bind_palette_offset);
   }
   if (ext->bone_parent_offset != 0U) {
     if (!in_bounds(ext->bone_parent_offset, header->bone_count)) {
       m_last_error = "bone parent table out of bounds";
       return false;
     }
-    m_bone_parent_data = m_bytes.data() + ext->bone_parent_offset;
+    m_bone_parent_data = bytes.data() + ext->bone_parent_offset;
     for (std::uint32_t b = 0; b < header->bone_count; ++b) {
       std::uint8_t const parent = m_bone_parent_data[b];
       if (parent != k_no_parent_bone && parent >= b) {
@@ -161,19 +255,51 @@ bool BpatBlob::validate() {
     }
   }
 
-  m_clip_table = reinterpret_cast<const BpatClipEntry*>(m_bytes.data() +
+  std::uint32_t track_key_count = 0U;
+  if (quantized) {
+    if (bytes.size() <
+        sizeof(BpatHeader) + sizeof(BpatHeaderExtV3) + sizeof(BpatHeaderExtV4)) {
+      m_last_error = "file shorter than v4 extension header";
+      return false;
+    }
+    if (m_bind_palette_data == nullptr || m_bone_parent_data == nullptr) {
+      m_last_error = "quantized tracks need bind palette and bone parents";
+      return false;
+    }
+    auto const* ext_v4 = reinterpret_cast<const BpatHeaderExtV4*>(
+        bytes.data() + sizeof(BpatHeader) + sizeof(BpatHeaderExtV3));
+    if (!in_bounds(ext_v4->track_table_offset,
+                   std::uint64_t{header->clip_count} * header->bone_count *
+                       sizeof(BpatTrackEntry))) {
+      m_last_error = "track table out of bounds";
+      return false;
+    }
+    if (!in_bounds(ext_v4->key_data_offset,
+                   std::uint64_t{ext_v4->key_count} * sizeof(BpatPoseKey))) {
+      m_last_error = "track keys out of bounds";
+      return false;
+    }
+    m_track_table = reinterpret_cast<const BpatTrackEntry*>(
+        bytes.data() + ext_v4->track_table_offset);
+    m_track_keys =
+        reinterpret_cast<const BpatPoseKey*>(bytes.data() + ext_v4->key_data_offset);
+    track_key_count = ext_v4->key_count;
+  }
+
+  m_clip_table = reinterpret_cast<const BpatClipEntry*>(bytes.data() +
                                                         header->clip_table_offset);
   m_socket_table = header->socket_count > 0U
                        ? reinterpret_cast<const BpatSocketEntry*>(
-                             m_bytes.data() + header->socket_table_offset)
+                             bytes.data() + header->socket_table_offset)
                        : nullptr;
   m_string_table =
-      reinterpret_cast<const char*>(m_bytes.data() + header->string_table_offset);
-  m_palette_data =
-      reinterpret_cast<const float*>(m_bytes.data() + header->palette_data_offset);
+      reinterpret_cast<const char*>(bytes.data() + header->string_table_offset);
+  m_palette_data = quantized ? nullptr
+                             : reinterpret_cast<const float*>(
+                                   bytes.data() + header->palette_data_offset);
   m_socket_data =
       header->socket_count > 0U
-          ? reinterpret_cast<const float*>(m_bytes.data() + socket_data_offset)
+          ? reinterpret_cast<const float*>(bytes.data() + socket_data_offset)
           : nullptr;
 
   std::uint32_t clip_index_bucket_count = 1U;
@@ -241,8 +367,26 @@ bool BpatBlob::validate() {
     }
   }
 
+  for (std::uint32_t i = 0; m_track_table != nullptr && i < header->clip_count; ++i) {
+    std::uint32_t const frame_count = m_clip_table[i].frame_count;
+    for (std::uint32_t b = 0; b < header->bone_count; ++b) {
+      auto const& track = m_track_table[std::size_t{i} * header->bone_count + b];
+      if (track.key_count == 0U ||
+          std::uint64_t{track.key_offset} + track.key_count > track_key_count) {
+        m_last_error = "track keys out of range";
+        return false;
+      }
+      const BpatPoseKey* const keys = m_track_keys + track.key_offset;
+      if (keys[0].frame != 0U || keys[track.key_count - 1U].frame + 1U != frame_count) {
+        m_last_error = "track does not span its clip";
+        return false;
+      }
+    }
+  }
+
   m_header = header;
-  decode_palette_cache();
+  decode_bind_palette();
+  m_clip_cache = std::make_unique<ClipCache>(header->clip_count);
   return true;
 }
 
@@ -356,31 +500,41 @@ auto BpatBlob::bone_parents() const noexcept -> std::span<const std::uint8_t> {
   return {m_bone_parent_data, m_header->bone_count};
 }
 
-auto BpatBlob::frame_local_pose_view(std::uint32_t global_frame_index) const noexcept
+auto BpatBlob::frame_local_pose_view(std::uint32_t global_frame_index) const
     -> std::span<const LocalBonePose> {
-  if (m_header == nullptr || global_frame_index >= m_header->frame_total ||
-      m_decoded_local_poses.empty()) {
+  std::uint32_t const clip_index = clip_of_frame(global_frame_index);
+  if (clip_index == k_invalid_clip_index || m_bone_parent_data == nullptr ||
+      m_decoded_bind_palette.empty()) {
     return {};
   }
+  const DecodedClip* decoded = decoded_clip(clip_index);
+  std::uint32_t const frame_in_clip =
+      global_frame_index - m_clip_table[clip_index].frame_offset;
   std::size_t const off =
-      static_cast<std::size_t>(global_frame_index) * m_header->bone_count;
-  return {m_decoded_local_poses.data() + off, m_header->bone_count};
+      static_cast<std::size_t>(frame_in_clip) * m_header->bone_count;
+  return {decoded->local_poses.data() + off, m_header->bone_count};
 }
 
-auto BpatBlob::palette_matrices() const noexcept -> std::span<const QMatrix4x4> {
-  if (m_decoded_palette == nullptr) {
+auto BpatBlob::palette_floats() const noexcept -> std::span<const float> {
+  if (m_header == nullptr || m_palette_data == nullptr) {
     return {};
   }
-  return {m_decoded_palette->data(), m_decoded_palette->size()};
+  return {m_palette_data,
+          static_cast<std::size_t>(m_header->frame_total) * m_header->bone_count *
+              k_matrix_floats};
+}
+
+auto BpatBlob::palette_storage() const noexcept -> std::shared_ptr<const void> {
+  return m_storage;
 }
 
 auto BpatBlob::bone_global_matrix(std::uint32_t global_frame_index,
                                   std::uint32_t bone_index) const -> QMatrix4x4 {
-  auto const frame = frame_palette_view(global_frame_index);
-  if (bone_index >= frame.size() || bone_index >= m_decoded_bind_palette.size()) {
+  auto const skin = palette_matrix(global_frame_index, bone_index);
+  if (skin.empty() || bone_index >= m_decoded_bind_palette.size()) {
     return {};
   }
-  return frame[bone_index] * m_decoded_bind_palette[bone_index];
+  return decode_column_major(skin.data()) * m_decoded_bind_palette[bone_index];
 }
 
 auto BpatBlob::socket(std::uint32_t index) const -> SocketView {
@@ -404,6 +558,10 @@ auto BpatBlob::palette_matrix(std::uint32_t global_frame_index,
       bone_index >= m_header->bone_count) {
     return {};
   }
+  if (m_palette_data == nullptr) {
+    auto const palette = frame_palette_view(global_frame_index);
+    return {palette[bone_index].constData(), k_matrix_floats};
+  }
   std::uint64_t const offset =
       ((std::uint64_t{global_frame_index} * m_header->bone_count) + bone_index) *
       k_matrix_floats;
@@ -412,13 +570,16 @@ auto BpatBlob::palette_matrix(std::uint32_t global_frame_index,
 
 auto BpatBlob::frame_palette_view(std::uint32_t global_frame_index) const
     -> std::span<const QMatrix4x4> {
-  if (m_header == nullptr || global_frame_index >= m_header->frame_total ||
-      m_decoded_palette == nullptr || m_decoded_palette->empty()) {
+  std::uint32_t const clip_index = clip_of_frame(global_frame_index);
+  if (clip_index == k_invalid_clip_index) {
     return {};
   }
+  const DecodedClip* decoded = decoded_clip(clip_index);
+  std::uint32_t const frame_in_clip =
+      global_frame_index - m_clip_table[clip_index].frame_offset;
   std::size_t const off =
-      static_cast<std::size_t>(global_frame_index) * m_header->bone_count;
-  return {m_decoded_palette->data() + off, m_header->bone_count};
+      static_cast<std::size_t>(frame_in_clip) * m_header->bone_count;
+  return {decoded->palette.data() + off, m_header->bone_count};
 }
 
 auto BpatBlob::socket_matrix(std::uint32_t global_frame_index,
@@ -435,72 +596,174 @@ auto BpatBlob::socket_matrix(std::uint32_t global_frame_index,
   return {m_socket_data + offset, k_socket_matrix_floats};
 }
 
-void BpatBlob::decode_palette_cache() {
-  if (m_header == nullptr || m_palette_data == nullptr) {
+auto BpatBlob::decoded_clip_count() const noexcept -> std::uint32_t {
+  return m_clip_cache != nullptr
+             ? m_clip_cache->resident.load(std::memory_order_relaxed)
+             : 0U;
+}
+
+auto BpatBlob::decoded_bytes() const noexcept -> std::size_t {
+  return m_clip_cache != nullptr
+             ? m_clip_cache->resident_bytes.load(std::memory_order_relaxed)
+             : 0U;
+}
+
+void BpatBlob::trim_decoded_clips(std::uint32_t max_resident_clips) {
+  if (m_clip_cache == nullptr) {
     return;
   }
-  std::size_t const total =
-      static_cast<std::size_t>(m_header->frame_total) * m_header->bone_count;
-  if (total == 0) {
+  auto& cache = *m_clip_cache;
+  const std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.retired.clear();
+  std::uint32_t const ending_epoch =
+      cache.epoch.fetch_add(1U, std::memory_order_relaxed);
+  std::uint32_t resident = cache.resident.load(std::memory_order_relaxed);
+  if (resident <= max_resident_clips) {
     return;
   }
-  auto const decode_column_major = [](const float* src) {
-    QMatrix4x4 m;
-    std::memcpy(m.data(), src, sizeof(float) * k_matrix_floats);
-    m.optimize();
-    return m;
-  };
-  m_decoded_palette = std::make_shared<std::vector<QMatrix4x4>>(total);
-  for (std::size_t i = 0; i < total; ++i) {
-    (*m_decoded_palette)[i] = decode_column_major(m_palette_data + i * k_matrix_floats);
-  }
-  if (m_bind_palette_data != nullptr) {
-    m_decoded_bind_palette.assign(m_header->bone_count, QMatrix4x4{});
-    m_decoded_inverse_bind_palette.assign(m_header->bone_count, QMatrix4x4{});
-    for (std::uint32_t b = 0; b < m_header->bone_count; ++b) {
-      m_decoded_bind_palette[b] =
-          decode_column_major(m_bind_palette_data + std::size_t{b} * k_matrix_floats);
-      m_decoded_inverse_bind_palette[b] = m_decoded_bind_palette[b].inverted();
+
+  std::vector<std::uint32_t> candidates;
+  for (std::uint32_t i = 0; i < cache.entry_count; ++i) {
+    auto const& slot = cache.entries[i];
+    if (slot.owned != nullptr &&
+        slot.last_used.load(std::memory_order_relaxed) != ending_epoch) {
+      candidates.push_back(i);
     }
   }
-  decode_local_poses();
+  std::sort(candidates.begin(),
+            candidates.end(),
+            [&cache](std::uint32_t lhs, std::uint32_t rhs) {
+              return cache.entries[lhs].last_used.load(std::memory_order_relaxed) <
+                     cache.entries[rhs].last_used.load(std::memory_order_relaxed);
+            });
+  for (std::uint32_t const index : candidates) {
+    if (resident <= max_resident_clips) {
+      break;
+    }
+    auto& slot = cache.entries[index];
+    slot.decoded.store(nullptr, std::memory_order_release);
+    cache.resident_bytes.fetch_sub(slot.owned->bytes(), std::memory_order_relaxed);
+    cache.retired.push_back(std::move(slot.owned));
+    --resident;
+  }
+  cache.resident.store(resident, std::memory_order_relaxed);
+}
+
+auto BpatBlob::clip_of_frame(std::uint32_t global_frame_index) const noexcept
+    -> std::uint32_t {
+  if (m_header == nullptr || global_frame_index >= m_header->frame_total) {
+    return k_invalid_clip_index;
+  }
+  const BpatClipEntry* const begin = m_clip_table;
+  const BpatClipEntry* const end = m_clip_table + m_header->clip_count;
+  const BpatClipEntry* const after =
+      std::upper_bound(begin,
+                       end,
+                       global_frame_index,
+                       [](std::uint32_t frame, const BpatClipEntry& entry) {
+                         return frame < entry.frame_offset;
+                       });
+  return static_cast<std::uint32_t>(after - begin) - 1U;
+}
+
+auto BpatBlob::decoded_clip(std::uint32_t clip_index) const -> const DecodedClip* {
+  auto& cache = *m_clip_cache;
+  auto& slot = cache.entries[clip_index];
+  std::uint32_t const epoch = cache.epoch.load(std::memory_order_relaxed);
+  if (slot.last_used.load(std::memory_order_relaxed) != epoch) {
+    slot.last_used.store(epoch, std::memory_order_relaxed);
+  }
+  if (const DecodedClip* decoded = slot.decoded.load(std::memory_order_acquire);
+      decoded != nullptr) {
+    return decoded;
+  }
+
+  const std::lock_guard<std::mutex> lock(cache.mutex);
+  if (slot.owned == nullptr) {
+    slot.owned = decode_clip(clip_index);
+    cache.resident.fetch_add(1U, std::memory_order_relaxed);
+    cache.resident_bytes.fetch_add(slot.owned->bytes(), std::memory_order_relaxed);
+    slot.decoded.store(slot.owned.get(), std::memory_order_release);
+  }
+  return slot.owned.get();
 }
 
-void BpatBlob::decode_local_poses() {
-  m_decoded_local_poses.clear();
-  if (m_header == nullptr || m_bone_parent_data == nullptr ||
-      m_decoded_bind_palette.empty() || m_decoded_palette == nullptr) {
+void BpatBlob::decode_bind_palette() {
+  if (m_header == nullptr || m_bind_palette_data == nullptr) {
     return;
   }
+  m_decoded_bind_palette.assign(m_header->bone_count, QMatrix4x4{});
+  m_decoded_inverse_bind_palette.assign(m_header->bone_count, QMatrix4x4{});
+  for (std::uint32_t b = 0; b < m_header->bone_count; ++b) {
+    m_decoded_bind_palette[b] =
+        decode_column_major(m_bind_palette_data + std::size_t{b} * k_matrix_floats);
+    m_decoded_inverse_bind_palette[b] = m_decoded_bind_palette[b].inverted();
+  }
+}
+
+auto BpatBlob::decode_clip(std::uint32_t clip_index) const
+    -> std::unique_ptr<DecodedClip> {
+  if (m_track_table != nullptr) {
+    return decode_quantized_clip(clip_index);
+  }
+  auto decoded = std::make_unique<DecodedClip>();
+  auto const& entry = m_clip_table[clip_index];
   std::uint32_t const bones = m_header->bone_count;
-  auto const rotation_of = [](const QMatrix4x4& matrix) {
-    QMatrix3x3 basis;
-    for (int col = 0; col < 3; ++col) {
-      QVector3D axis = matrix.column(col).toVector3D();
-      if (axis.lengthSquared() > 1.0e-8F) {
-        axis.normalize();
-      }
-      basis(0, col) = axis.x();
-      basis(1, col) = axis.y();
-      basis(2, col) = axis.z();
-    }
-    return QQuaternion::fromRotationMatrix(basis).normalized();
-  };
+  std::size_t const total = static_cast<std::size_t>(entry.frame_count) * bones;
+  const float* const src =
+      m_palette_data + static_cast<std::size_t>(entry.frame_offset) * bones *
+                           k_matrix_floats;
+  decoded->palette.resize(total);
+  for (std::size_t i = 0; i < total; ++i) {
+    decoded->palette[i] = decode_column_major(src + i * k_matrix_floats);
+  }
+
+  if (m_bone_parent_data == nullptr || m_decoded_bind_palette.empty()) {
+    return decoded;
+  }
   std::vector<QMatrix4x4> global(bones);
-  m_decoded_local_poses.resize(static_cast<std::size_t>(m_header->frame_total) * bones);
-  for (std::uint32_t f = 0; f < m_header->frame_total; ++f) {
-    auto const skin = frame_palette_view(f);
+  decoded->local_poses.resize(total);
+  for (std::size_t f = 0; f < entry.frame_count; ++f) {
+    const QMatrix4x4* const skin = decoded->palette.data() + f * bones;
     for (std::uint32_t b = 0; b < bones; ++b) {
       global[b] = skin[b] * m_decoded_bind_palette[b];
       std::uint8_t const parent = m_bone_parent_data[b];
-      QMatrix4x4 const local = parent == k_no_parent_bone
-                                   ? global[b]
-                                   : global[parent].inverted() * global[b];
-      auto& pose = m_decoded_local_poses[static_cast<std::size_t>(f) * bones + b];
-      pose.rotation = rotation_of(local);
-      pose.translation = local.column(3).toVector3D();
+      decoded->local_poses[f * bones + b] = local_pose_from_matrix(
+          parent == k_no_parent_bone ? global[b]
+                                     : global[parent].inverted() * global[b]);
+    }
+  }
+  return decoded;
+}
+
+auto BpatBlob::decode_quantized_clip(std::uint32_t clip_index) const
+    -> std::unique_ptr<DecodedClip> {
+  auto decoded = std::make_unique<DecodedClip>();
+  auto const& entry = m_clip_table[clip_index];
+  std::uint32_t const bones = m_header->bone_count;
+  std::size_t const total = static_cast<std::size_t>(entry.frame_count) * bones;
+  decoded->local_poses.resize(total);
+  for (std::uint32_t b = 0; b < bones; ++b) {
+    auto const& track = m_track_table[std::size_t{clip_index} * bones + b];
+    decode_track(track,
+                 m_track_keys + track.key_offset,
+                 entry.frame_count,
+                 decoded->local_poses.data() + b,
+                 bones);
+  }
+
+  std::vector<QMatrix4x4> global(bones);
+  decoded->palette.resize(total);
+  for (std::size_t f = 0; f < entry.frame_count; ++f) {
+    const LocalBonePose* const poses = decoded->local_poses.data() + f * bones;
+    for (std::uint32_t b = 0; b < bones; ++b) {
+      QMatrix4x4 const local = matrix_from_local_pose(poses[b]);
+      std::uint8_t const parent = m_bone_parent_data[b];
+      global[b] = parent == k_no_parent_bone ? local : global[parent] * local;
+      decoded->palette[f * bones + b] = global[b] * m_decoded_inverse_bind_palette[b];
     }
   }
+  return decoded;
 }
 
 } // namespace Render::Creature::Bpat
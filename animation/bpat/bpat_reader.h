@@ -45,10 +45,21 @@ class BpatBlob {
 public:
   static constexpr std::uint32_t k_invalid_clip_index = 0xFFFFu;
 
+  enum class LoadMode : std::uint8_t { Read, Map };
+
+  BpatBlob();
+  ~BpatBlob();
+  BpatBlob(BpatBlob&& other) noexcept;
+  auto operator=(BpatBlob&& other) noexcept -> BpatBlob&;
+  BpatBlob(const BpatBlob&) = delete;
+  auto operator=(const BpatBlob&) -> BpatBlob& = delete;
+
   static auto from_bytes(std::vector<std::uint8_t> bytes) -> BpatBlob;
-  static auto from_file(const std::string& path) -> BpatBlob;
+  static auto from_file(const std::string& path,
+                        LoadMode mode = LoadMode::Map) -> BpatBlob;
 
   [[nodiscard]] auto loaded() const noexcept -> bool { return m_loaded; }
+  [[nodiscard]] auto mapped() const noexcept -> bool;
   [[nodiscard]] auto last_error() const noexcept -> std::string_view {
     return m_last_error;
   }
@@ -61,6 +72,8 @@ public:
 
   [[nodiscard]] auto clip(std::uint32_t index) const -> ClipView;
   [[nodiscard]] auto clip_index(std::string_view name) const -> std::uint32_t;
+  [[nodiscard]] auto clip_of_frame(std::uint32_t global_frame_index) const noexcept
+      -> std::uint32_t;
   [[nodiscard]] auto socket(std::uint32_t index) const -> SocketView;
 
   [[nodiscard]] auto
@@ -83,15 +96,12 @@ public:
 
   [[nodiscard]] auto bone_parents() const noexcept -> std::span<const std::uint8_t>;
 
-  [[nodiscard]] auto frame_local_pose_view(std::uint32_t global_frame_index)
-      const noexcept -> std::span<const LocalBonePose>;
+  [[nodiscard]] auto frame_local_pose_view(std::uint32_t global_frame_index) const
+      -> std::span<const LocalBonePose>;
 
-  [[nodiscard]] auto palette_matrices() const noexcept -> std::span<const QMatrix4x4>;
+  [[nodiscard]] auto palette_floats() const noexcept -> std::span<const float>;
 
-  [[nodiscard]] auto
-  palette_storage() const noexcept -> std::shared_ptr<const std::vector<QMatrix4x4>> {
-    return m_decoded_palette;
-  }
+  [[nodiscard]] auto palette_storage() const noexcept -> std::shared_ptr<const void>;
 
   [[nodiscard]] auto bone_global_matrix(std::uint32_t global_frame_index,
                                         std::uint32_t bone_index) const -> QMatrix4x4;
@@ -107,9 +117,12 @@ public:
   socket_matrix(std::uint32_t global_frame_index,
                 std::uint32_t socket_index) const -> std::span<const float>;
 
-  [[nodiscard]] auto raw_bytes() const noexcept -> std::span<const std::uint8_t> {
-    return {m_bytes.data(), m_bytes.size()};
-  }
+  [[nodiscard]] auto raw_bytes() const noexcept -> std::span<const std::uint8_t>;
+
+  [[nodiscard]] auto decoded_clip_count() const noexcept -> std::uint32_t;
+  [[nodiscard]] auto decoded_bytes() const noexcept -> std::size_t;
+
+  void trim_decoded_clips(std::uint32_t max_resident_clips);
 
 private:
   struct ClipIndexEntry {
@@ -117,13 +130,23 @@ private:
     std::uint32_t clip_index{k_invalid_clip_index};
   };
 
+  struct Storage;
+  struct DecodedClip;
+  struct ClipCache;
+
   static constexpr std::uint32_t k_empty_clip_index_bucket = 0xFFFFFFFFu;
 
+  static auto from_storage(std::shared_ptr<const Storage> storage) -> BpatBlob;
+
   bool validate();
-  void decode_palette_cache();
-  void decode_local_poses();
+  void decode_bind_palette();
+  [[nodiscard]] auto decoded_clip(std::uint32_t clip_index) const -> const DecodedClip*;
+  [[nodiscard]] auto
+  decode_clip(std::uint32_t clip_index) const -> std::unique_ptr<DecodedClip>;
+  [[nodiscard]] auto decode_quantized_clip(std::uint32_t clip_index) const
+      -> std::unique_ptr<DecodedClip>;
 
-  std::vector<std::uint8_t> m_bytes{};
+  std::shared_ptr<const Storage> m_storage{};
   bool m_loaded{false};
   std::string m_last_error{};
   const BpatHeader* m_header{nullptr};
@@ -136,11 +159,12 @@ private:
   std::uint32_t m_contact_count{0U};
   const float* m_bind_palette_data{nullptr};
   const std::uint8_t* m_bone_parent_data{nullptr};
+  const BpatTrackEntry* m_track_table{nullptr};
+  const BpatPoseKey* m_track_keys{nullptr};
 
-  std::shared_ptr<std::vector<QMatrix4x4>> m_decoded_palette{};
   std::vector<QMatrix4x4> m_decoded_bind_palette{};
   std::vector<QMatrix4x4> m_decoded_inverse_bind_palette{};
-  std::vector<LocalBonePose> m_decoded_local_poses{};
+  std::unique_ptr<ClipCache> m_clip_cache{};
   std::vector<ClipIndexEntry> m_clip_index_entries{};
   std::vector<std::uint32_t> m_clip_index_buckets{};
 };
@@ -102,6 +102,12 @@ auto BpatRegistry::load_all(const std::string& asset_root) -> std::size_t {
   return loaded;
 }
 
+void BpatRegistry::trim_decoded_clips(std::uint32_t max_resident_clips) {
+  for (auto& blob : m_blobs) {
+    blob.trim_decoded_clips(max_resident_clips);
+  }
+}
+
 auto BpatRegistry::blob(std::uint32_t species_id) const noexcept -> const BpatBlob* {
   const auto* slot = species_slot(species_id);
   return (slot != nullptr && slot->loaded()) ? slot : nullptr;
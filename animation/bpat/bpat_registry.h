@@ -16,6 +16,7 @@ namespace Render::Creature::Bpat {
 class BpatRegistry {
 public:
   static constexpr std::uint32_t k_invalid_clip = 0xFFFFu;
+  static constexpr std::uint32_t k_decoded_clip_budget = 24U;
 
   [[nodiscard]] static auto instance() noexcept -> BpatRegistry&;
 
@@ -41,6 +42,8 @@ public:
                      std::uint32_t socket_index,
                      QMatrix4x4& out) const -> bool;
 
+  void trim_decoded_clips(std::uint32_t max_resident_clips = k_decoded_clip_budget);
+
   [[nodiscard]] auto last_error() const noexcept -> std::string_view {
     return m_last_error;
   }
@@ -0,0 +1,273 @@
+#include "bpat_tracks.h"
+
+#include <QMatrix3x3>
+#include <QQuaternion>
+#include <QVector3D>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SOI_BPAT_TRACKS_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SOI_BPAT_TRACKS_NEON 1
+#endif
+
+namespace Render::Creature::Bpat {
+
+namespace {
+
+auto quantize_unit(float value) -> std::int16_t {
+  float const scaled =
+      std::round(std::clamp(value, -1.0F, 1.0F) * k_rotation_quantization);
+  return static_cast<std::int16_t>(scaled);
+}
+
+auto quantize_range(float value, float min, float step) -> std::uint16_t {
+  if (step <= 0.0F) {
+    return 0U;
+  }
+  float const scaled = std::round((value - min) / step);
+  return static_cast<std::uint16_t>(
+      std::clamp(scaled, 0.0F, k_translation_quantization));
+}
+
+auto quantize_key(const QQuaternion& rotation,
+                  const QVector3D& translation,
+                  const BpatTrackEntry& entry,
+                  std::uint32_t frame) -> BpatPoseKey {
+  BpatPoseKey key{};
+  key.rotation[0] = quantize_unit(rotation.x());
+  key.rotation[1] = quantize_unit(rotation.y());
+  key.rotation[2] = quantize_unit(rotation.z());
+  key.rotation[3] = quantize_unit(rotation.scalar());
+  for (int i = 0; i < 3; ++i) {
+    key.translation[i] = quantize_range(
+        translation[i], entry.translation_min[i], entry.translation_step[i]);
+  }
+  key.frame = static_cast<std::uint16_t>(frame);
+  return key;
+}
+
+auto dequantize_key(const BpatPoseKey& key,
+                    const BpatTrackEntry& entry) -> LocalBonePose {
+  LocalBonePose pose{};
+  pose.rotation = QQuaternion(static_cast<float>(key.rotation[3]),
+                              static_cast<float>(key.rotation[0]),
+                              static_cast<float>(key.rotation[1]),
+                              static_cast<float>(key.rotation[2]))
+                      .normalized();
+  pose.translation = QVector3D(
+      entry.translation_min[0] + static_cast<float>(key.translation[0]) *
+                                     entry.translation_step[0],
+      entry.translation_min[1] + static_cast<float>(key.translation[1]) *
+                                     entry.translation_step[1],
+      entry.translation_min[2] + static_cast<float>(key.translation[2]) *
+                                     entry.translation_step[2]);
+  return pose;
+}
+
+auto rotation_error(const QQuaternion& a, const QQuaternion& b) -> float {
+  float const dot = std::abs(QQuaternion::dotProduct(a, b));
+  return 2.0F * std::acos(std::min(dot, 1.0F));
+}
+
+auto decode_pair(const BpatPoseKey& a,
+                 const BpatPoseKey& b,
+                 float t,
+                 const BpatTrackEntry& entry) -> LocalBonePose {
+  alignas(16) float rotation[4];
+  alignas(16) float translation[4];
+#if defined(SOI_BPAT_TRACKS_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i raw_a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&a));
+  const __m128i raw_b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&b));
+  const __m128 rot_a =
+      _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(raw_a, raw_a), 16));
+  const __m128 rot_b =
+      _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(raw_b, raw_b), 16));
+  const __m128 pos_a = _mm_cvtepi32_ps(_mm_unpackhi_epi16(raw_a, zero));
+  const __m128 pos_b = _mm_cvtepi32_ps(_mm_unpackhi_epi16(raw_b, zero));
+  const __m128 weight = _mm_set1_ps(t);
+  const __m128 rot = _mm_add_ps(rot_a, _mm_mul_ps(_mm_sub_ps(rot_b, rot_a), weight));
+  const __m128 pos = _mm_add_ps(pos_a, _mm_mul_ps(_mm_sub_ps(pos_b, pos_a), weight));
+  const __m128 min = _mm_setr_ps(entry.translation_min[0],
+                                 entry.translation_min[1],
+                                 entry.translation_min[2],
+                                 0.0F);
+  const __m128 step = _mm_setr_ps(entry.translation_step[0],
+                                  entry.translation_step[1],
+                                  entry.translation_step[2],
+                                  0.0F);
+  _mm_store_ps(rotation, rot);
+  _mm_store_ps(translation, _mm_add_ps(min, _mm_mul_ps(pos, step)));
+#elif defined(SOI_BPAT_TRACKS_NEON)
+  const int16x8_t raw_a = vld1q_s16(reinterpret_cast<const std::int16_t*>(&a));
+  const int16x8_t raw_b = vld1q_s16(reinterpret_cast<const std::int16_t*>(&b));
+  const float32x4_t rot_a = vcvtq_f32_s32(vmovl_s16(vget_low_s16(raw_a)));
+  const float32x4_t rot_b = vcvtq_f32_s32(vmovl_s16(vget_low_s16(raw_b)));
+  const float32x4_t pos_a =
+      vcvtq_f32_u32(vmovl_u16(vget_high_u16(vreinterpretq_u16_s16(raw_a))));
+  const float32x4_t pos_b =
+      vcvtq_f32_u32(vmovl_u16(vget_high_u16(vreinterpretq_u16_s16(raw_b))));
+  const float32x4_t weight = vdupq_n_f32(t);
+  const float32x4_t rot = vmlaq_f32(rot_a, vsubq_f32(rot_b, rot_a), weight);
+  const float32x4_t pos = vmlaq_f32(pos_a, vsubq_f32(pos_b, pos_a), weight);
+  const float min_values[4] = {entry.translation_min[0],
+                               entry.translation_min[1],
+                               entry.translation_min[2],
+                               0.0F};
+  const float step_values[4] = {entry.translation_step[0],
+                                entry.translation_step[1],
+                                entry.translation_step[2],
+                                0.0F};
+  vst1q_f32(rotation, rot);
+  vst1q_f32(translation, vmlaq_f32(vld1q_f32(min_values), pos, vld1q_f32(step_values)));
+#else
+  for (int i = 0; i < 4; ++i) {
+    float const ra = static_cast<float>(a.rotation[i]);
+    rotation[i] = ra + (static_cast<float>(b.rotation[i]) - ra) * t;
+  }
+  for (int i = 0; i < 3; ++i) {
+    float const pa = static_cast<float>(a.translation[i]);
+    float const pos = pa + (static_cast<float>(b.translation[i]) - pa) * t;
+    translation[i] = entry.translation_min[i] + pos * entry.translation_step[i];
+  }
+#endif
+  LocalBonePose pose{};
+  pose.rotation =
+      QQuaternion(rotation[3], rotation[0], rotation[1], rotation[2]).normalized();
+  pose.translation = QVector3D(translation[0], translation[1], translation[2]);
+  return pose;
+}
+
+} // namespace
+
+auto local_pose_from_matrix(const QMatrix4x4& local) -> LocalBonePose {
+  QMatrix3x3 basis;
+  for (int col = 0; col < 3; ++col) {
+    QVector3D axis = local.column(col).toVector3D();
+    if (axis.lengthSquared() > 1.0e-8F) {
+      axis.normalize();
+    }
+    basis(0, col) = axis.x();
+    basis(1, col) = axis.y();
+    basis(2, col) = axis.z();
+  }
+  LocalBonePose pose{};
+  pose.rotation = QQuaternion::fromRotationMatrix(basis).normalized();
+  pose.translation = local.column(3).toVector3D();
+  return pose;
+}
+
+auto matrix_from_local_pose(const LocalBonePose& pose) -> QMatrix4x4 {
+  QMatrix4x4 m;
+  m.translate(pose.translation);
+  m.rotate(pose.rotation);
+  return m;
+}
+
+auto lerp_local_pose(const LocalBonePose& a,
+                     const LocalBonePose& b,
+                     float t) -> LocalBonePose {
+  LocalBonePose pose{};
+  pose.rotation = QQuaternion(a.rotation.scalar() +
+                                  (b.rotation.scalar() - a.rotation.scalar()) * t,
+                              a.rotation.x() + (b.rotation.x() - a.rotation.x()) * t,
+                              a.rotation.y() + (b.rotation.y() - a.rotation.y()) * t,
+                              a.rotation.z() + (b.rotation.z() - a.rotation.z()) * t)
+                      .normalized();
+  pose.translation = a.translation + (b.translation - a.translation) * t;
+  return pose;
+}
+
+void encode_track(std::span<const LocalBonePose> frames,
+                  TrackTolerance tolerance,
+                  BpatTrackEntry& entry,
+                  std::vector<BpatPoseKey>& keys) {
+  entry = BpatTrackEntry{};
+  entry.key_offset = static_cast<std::uint32_t>(keys.size());
+  if (frames.empty()) {
+    return;
+  }
+
+  QVector3D lo = frames.front().translation;
+  QVector3D hi = lo;
+  for (const LocalBonePose& frame : frames) {
+    for (int i = 0; i < 3; ++i) {
+      lo[i] = std::min(lo[i], frame.translation[i]);
+      hi[i] = std::max(hi[i], frame.translation[i]);
+    }
+  }
+  for (int i = 0; i < 3; ++i) {
+    entry.translation_min[i] = lo[i];
+    entry.translation_step[i] = (hi[i] - lo[i]) / k_translation_quantization;
+  }
+
+  std::vector<BpatPoseKey> quantized(frames.size());
+  QQuaternion previous = frames.front().rotation;
+  for (std::size_t f = 0; f < frames.size(); ++f) {
+    QQuaternion rotation = frames[f].rotation.normalized();
+    if (QQuaternion::dotProduct(rotation, previous) < 0.0F) {
+      rotation = -rotation;
+    }
+    previous = rotation;
+    quantized[f] = quantize_key(
+        rotation, frames[f].translation, entry, static_cast<std::uint32_t>(f));
+  }
+
+  auto const segment_fits = [&](std::size_t first, std::size_t last) {
+    LocalBonePose const from = dequantize_key(quantized[first], entry);
+    LocalBonePose const to = dequantize_key(quantized[last], entry);
+    float const length = static_cast<float>(last - first);
+    for (std::size_t j = first + 1U; j < last; ++j) {
+      LocalBonePose const pose =
+          lerp_local_pose(from, to, static_cast<float>(j - first) / length);
+      if (rotation_error(pose.rotation, frames[j].rotation) >
+              tolerance.rotation_radians ||
+          (pose.translation - frames[j].translation).length() > tolerance.translation) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  keys.push_back(quantized.front());
+  std::size_t anchor = 0U;
+  for (std::size_t end = 2U; end < quantized.size(); ++end) {
+    if (!segment_fits(anchor, end)) {
+      anchor = end - 1U;
+      keys.push_back(quantized[anchor]);
+    }
+  }
+  if (quantized.size() > 1U) {
+    keys.push_back(quantized.back());
+  }
+  entry.key_count = static_cast<std::uint32_t>(keys.size()) - entry.key_offset;
+}
+
+void decode_track(const BpatTrackEntry& entry,
+                  const BpatPoseKey* keys,
+                  std::uint32_t frame_count,
+                  LocalBonePose* out,
+                  std::size_t out_stride) {
+  std::uint32_t const last = entry.key_count - 1U;
+  std::uint32_t k = 0U;
+  for (std::uint32_t f = 0; f < frame_count; ++f) {
+    while (k < last && keys[k + 1U].frame <= f) {
+      ++k;
+    }
+    const BpatPoseKey& from = keys[k];
+    const BpatPoseKey& to = keys[k < last ? k + 1U : k];
+    float const length = static_cast<float>(to.frame) - static_cast<float>(from.frame);
+    float const t =
+        length > 0.0F
+            ? std::clamp((static_cast<float>(f) - from.frame) / length, 0.0F, 1.0F)
+            : 0.0F;
+    out[static_cast<std::size_t>(f) * out_stride] = decode_pair(from, to, t, entry);
+  }
+}
+
+} // namespace Render::Creature::Bpat
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QMatrix4x4>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "bpat_format.h"
+#include "bpat_reader.h"
+
+namespace Render::Creature::Bpat {
+
+struct TrackTolerance {
+  float rotation_radians{0.002F};
+  float translation{0.001F};
+};
+
+[[nodiscard]] auto local_pose_from_matrix(const QMatrix4x4& local) -> LocalBonePose;
+
+[[nodiscard]] auto matrix_from_local_pose(const LocalBonePose& pose) -> QMatrix4x4;
+
+[[nodiscard]] auto lerp_local_pose(const LocalBonePose& a,
+                                   const LocalBonePose& b,
+                                   float t) -> LocalBonePose;
+
+void encode_track(std::span<const LocalBonePose> frames,
+                  TrackTolerance tolerance,
+                  BpatTrackEntry& entry,
+                  std::vector<BpatPoseKey>& keys);
+
+void decode_track(const BpatTrackEntry& entry,
+                  const BpatPoseKey* keys,
+                  std::uint32_t frame_count,
+                  LocalBonePose* out,
+                  std::size_t out_stride);
+
+} // namespace Render::Creature::Bpat
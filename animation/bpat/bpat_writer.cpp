@@ -42,6 +42,12 @@ void copy_matrix_column_major(const QMatrix4x4& m, float* dst) {
   std::memcpy(dst, m.constData(), sizeof(float) * k_matrix_floats);
 }
 
+auto matrix_from_column_major(const float* src) -> QMatrix4x4 {
+  QMatrix4x4 m;
+  std::memcpy(m.data(), src, sizeof(float) * k_matrix_floats);
+  return m;
+}
+
 void copy_socket_row_major(const QMatrix4x4& m, float* dst) {
   for (int row = 0; row < 3; ++row) {
     for (int col = 0; col < 4; ++col) {
@@ -120,6 +126,46 @@ void BpatWriter::set_bone_parents(std::span<const std::uint8_t> parents) {
   m_bone_parents.assign(parents.begin(), parents.end());
 }
 
+void BpatWriter::set_quantized_tracks(TrackTolerance tolerance) {
+  m_track_tolerance = tolerance;
+}
+
+void BpatWriter::encode_tracks(std::vector<BpatTrackEntry>& tracks,
+                               std::vector<BpatPoseKey>& keys) const {
+  std::vector<QMatrix4x4> bind(m_bone_count);
+  for (std::uint32_t b = 0; b < m_bone_count; ++b) {
+    bind[b] = matrix_from_column_major(m_bind_palette_floats.data() +
+                                       std::size_t{b} * k_matrix_floats);
+  }
+  tracks.resize(m_clips.size() * m_bone_count);
+  std::vector<QMatrix4x4> global(m_bone_count);
+  std::vector<LocalBonePose> poses;
+  for (std::size_t c = 0; c < m_clips.size(); ++c) {
+    std::uint32_t const frames = m_clips[c].desc.frame_count;
+    poses.resize(static_cast<std::size_t>(frames) * m_bone_count);
+    for (std::uint32_t f = 0; f < frames; ++f) {
+      const float* const skin =
+          m_palette_floats.data() +
+          (static_cast<std::size_t>(m_clips[c].frame_offset + f) * m_bone_count *
+           k_matrix_floats);
+      for (std::uint32_t b = 0; b < m_bone_count; ++b) {
+        global[b] = matrix_from_column_major(skin + b * k_matrix_floats) * bind[b];
+        std::uint8_t const parent = m_bone_parents[b];
+        QMatrix4x4 const local = parent == k_no_parent_bone
+                                     ? global[b]
+                                     : global[parent].inverted() * global[b];
+        poses[static_cast<std::size_t>(b) * frames + f] = local_pose_from_matrix(local);
+      }
+    }
+    for (std::uint32_t b = 0; b < m_bone_count; ++b) {
+      encode_track({poses.data() + static_cast<std::size_t>(b) * frames, frames},
+                   *m_track_tolerance,
+                   tracks[c * m_bone_count + b],
+                   keys);
+    }
+  }
+}
+
 void BpatWriter::append_clip_contacts(std::span<const BpatFrameContact> contacts) {
   assert(!m_clips.empty() && "add_clip() before append_clip_contacts()");
   auto& pending = m_clips.back();
@@ -152,6 +198,22 @@ auto BpatWriter::write(std::ostream& out) const -> bool {
       return false;
     }
   }
+  bool const quantized = m_track_tolerance.has_value();
+  if (quantized) {
+    if (m_bind_palette_floats.empty() || m_bone_parents.empty()) {
+      return false;
+    }
+    for (auto const& c : m_clips) {
+      if (c.desc.frame_count > 0xFFFFU) {
+        return false;
+      }
+    }
+  }
+  std::vector<BpatTrackEntry> tracks;
+  std::vector<BpatPoseKey> keys;
+  if (quantized) {
+    encode_tracks(tracks, keys);
+  }
 
   std::vector<char> string_table;
   std::unordered_map<std::string, std::uint32_t> string_offsets;
@@ -201,7 +263,8 @@ auto BpatWriter::write(std::ostream& out) const -> bool {
     socket_entries.push_back(e);
   }
 
-  std::uint64_t cursor = sizeof(BpatHeader) + sizeof(BpatHeaderExtV3);
+  std::uint64_t cursor = sizeof(BpatHeader) + sizeof(BpatHeaderExtV3) +
+                         (quantized ? sizeof(BpatHeaderExtV4) : 0U);
   std::uint64_t const clip_table_offset = cursor;
   cursor += clip_entries.size() * sizeof(BpatClipEntry);
   std::uint64_t const socket_table_offset = socket_entries.empty() ? 0U : cursor;
@@ -209,8 +272,12 @@ auto BpatWriter::write(std::ostream& out) const -> bool {
   std::uint64_t const string_table_offset = cursor;
   cursor += string_table.size();
   cursor = align_up(cursor, k_section_alignment);
+  std::uint64_t const track_table_offset = quantized ? cursor : 0U;
+  cursor += tracks.size() * sizeof(BpatTrackEntry);
+  std::uint64_t const key_data_offset = quantized ? cursor : 0U;
+  cursor += keys.size() * sizeof(BpatPoseKey);
   std::uint64_t const palette_data_offset = cursor;
-  cursor += m_palette_floats.size() * sizeof(float);
+  cursor += quantized ? 0U : m_palette_floats.size() * sizeof(float);
   cursor += m_socket_floats.size() * sizeof(float);
   cursor = align_up(cursor, k_section_alignment);
   std::uint64_t const contact_data_offset = has_contacts ? cursor : 0U;
@@ -223,7 +290,7 @@ auto BpatWriter::write(std::ostream& out) const -> bool {
 
   BpatHeader header{};
   std::memcpy(header.magic, k_magic.data(), k_magic.size());
-  header.version = k_version;
+  header.version = quantized ? k_version_quantized : k_version;
   header.species_id = m_species_id;
   header.bone_count = m_bone_count;
   header.socket_count = static_cast<std::uint32_t>(socket_entries.size());
@@ -247,6 +314,16 @@ auto BpatWriter::write(std::ostream& out) const -> bool {
   written += sizeof(header);
   write_pod(out, &ext, sizeof(ext));
   written += sizeof(ext);
+  if (quantized) {
+    BpatHeaderExtV4 ext_v4{};
+    ext_v4.track_table_offset = track_table_offset;
+    ext_v4.key_data_offset = key_data_offset;
+    ext_v4.key_count = static_cast<std::uint32_t>(keys.size());
+    ext_v4.rotation_tolerance = m_track_tolerance->rotation_radians;
+    ext_v4.translation_tolerance = m_track_tolerance->translation;
+    write_pod(out, &ext_v4, sizeof(ext_v4));
+    written += sizeof(ext_v4);
+  }
 
   if (!clip_entries.empty()) {
     write_pod(out, clip_entries.data(), clip_entries.size() * sizeof(BpatClipEntry));
@@ -263,7 +340,11 @@ auto BpatWriter::write(std::ostream& out) const -> bool {
   }
   pad_to_alignment(out, written, k_section_alignment);
 
-  if (!m_palette_floats.empty()) {
+  if (quantized) {
+    write_pod(out, tracks.data(), tracks.size() * sizeof(BpatTrackEntry));
+    write_pod(out, keys.data(), keys.size() * sizeof(BpatPoseKey));
+    written = palette_data_offset;
+  } else if (!m_palette_floats.empty()) {
     write_pod(out, m_palette_floats.data(), m_palette_floats.size() * sizeof(float));
     written = palette_data_offset + m_palette_floats.size() * sizeof(float);
   }
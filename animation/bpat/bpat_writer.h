@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <iosfwd>
+#include <optional>
 #include <ostream>
 #include <span>
 #include <string>
@@ -12,6 +13,7 @@
 #include <vector>
 
 #include "bpat_format.h"
+#include "bpat_tracks.h"
 
 namespace Render::Creature::Bpat {
 
@@ -54,6 +56,8 @@ public:
 
   void set_bone_parents(std::span<const std::uint8_t> parents);
 
+  void set_quantized_tracks(TrackTolerance tolerance);
+
   [[nodiscard]] auto write(std::ostream& out) const -> bool;
 
   [[nodiscard]] auto species_id() const noexcept -> std::uint32_t {
@@ -65,6 +69,9 @@ public:
   [[nodiscard]] auto frame_total() const noexcept -> std::uint32_t {
     return m_frame_total;
   }
+  [[nodiscard]] auto quantized_tracks() const noexcept -> bool {
+    return m_track_tolerance.has_value();
+  }
 
 private:
   struct PendingClip {
@@ -75,6 +82,9 @@ private:
     bool contacts_appended{false};
   };
 
+  void encode_tracks(std::vector<BpatTrackEntry>& tracks,
+                     std::vector<BpatPoseKey>& keys) const;
+
   std::uint32_t m_species_id;
   std::uint32_t m_bone_count;
   std::uint32_t m_frame_total{0U};
@@ -85,6 +95,7 @@ private:
   std::vector<BpatFrameContact> m_contacts{};
   std::vector<float> m_bind_palette_floats{};
   std::vector<std::uint8_t> m_bone_parents{};
+  std::optional<TrackTolerance> m_track_tolerance{};
 };
 
 } // namespace Render::Creature::Bpat
@@ -37,6 +37,8 @@ struct MeleeIntent {
   [[nodiscard]] auto strike_angle() const noexcept -> float {
     return std::atan2(strike_dir_y, strike_dir_x);
   }
+
+  auto operator==(const MeleeIntent&) const -> bool = default;
 };
 
 inline constexpr float k_melee_intent_min_axis = 1.0e-4F;
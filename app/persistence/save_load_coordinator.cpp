@@ -15,7 +15,7 @@
 #include "game/map/terrain_service.h"
 #include "game/mission/campaign_manager.h"
 #include "game/render_bridge/game_state_serializer.h"
-#include "game/save/serialization.h"
+#include "game/save/world_snapshot.h"
 #include "game/session/deterministic_rng.h"
 #include "game/session/session_context.h"
 #include "game/session/simulation_clock.h"
@@ -135,7 +135,7 @@ auto SaveLoadCoordinator::begin_save_to_slot(const SaveToSlotContext& context) c
   request.metadata = metadata;
   request.autosave_retention = context.autosave_retention;
 
-  request.world = Engine::Core::Serialization::serialize_world(&context.world);
+  request.world = Game::Save::capture_world_snapshot(context.world);
 
   const quint64 job_id = context.save_load_service.begin_save(request);
   if (job_id == 0) {
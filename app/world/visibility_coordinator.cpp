@@ -6,20 +6,33 @@
 
 void VisibilityCoordinator::FogPresenterAdapter::bind(Render::GL::FogRenderer* fog) {
   m_fog = fog;
+  m_applied_version = 0;
 }
 
 void VisibilityCoordinator::FogPresenterAdapter::apply_visibility_frame(
     const Game::Map::VisibilityService::Snapshot& snapshot) {
-  if (m_fog != nullptr) {
+  if (m_fog == nullptr) {
+    return;
+  }
+  if (snapshot.dirty_since_version != 0U &&
+      snapshot.dirty_since_version == m_applied_version) {
+    m_fog->update_mask_region(snapshot.width,
+                              snapshot.height,
+                              snapshot.tile_size,
+                              snapshot.cells,
+                              snapshot.dirty);
+  } else {
     m_fog->update_mask(
         snapshot.width, snapshot.height, snapshot.tile_size, snapshot.cells);
   }
+  m_applied_version = snapshot.version;
 }
 
 void VisibilityCoordinator::FogPresenterAdapter::clear_visibility_frame() {
   if (m_fog != nullptr) {
     m_fog->update_mask(0, 0, 1.0F, {});
   }
+  m_applied_version = 0;
 }
 
 void VisibilityCoordinator::MinimapPresenterAdapter::bind(MinimapManager* minimap) {
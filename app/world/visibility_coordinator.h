@@ -33,6 +33,7 @@ public:
 
   private:
     Render::GL::FogRenderer* m_fog = nullptr;
+    std::uint64_t m_applied_version = 0;
   };
 
   class MinimapPresenterAdapter final : public VisibilityFramePresenter {
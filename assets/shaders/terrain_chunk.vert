@@ -11,6 +11,16 @@ uniform vec2 u_noise_offset;
 uniform float u_height_noise_strength;
 uniform float u_height_noise_frequency;
 
+uniform int u_has_height_tex;
+uniform sampler2D u_height_tex;
+uniform vec2 u_height_texel_size;
+uniform vec2 u_height_uv_scale, u_height_uv_offset;
+uniform float u_height_tex_to_world;
+uniform vec3 u_camera_pos;
+// x: morph start distance, y: morph end distance, z: coarser lattice step in
+// height texels; a zero step leaves the vertex where the mesh put it.
+uniform vec3 u_lod_morph;
+
 out vec3 v_world_pos;
 out vec3 v_normal;
 out vec2 v_uv;
@@ -76,8 +86,38 @@ float sample_terrain_displacement(vec3 wp,
   return h * height_amp * shoulder_mask;
 }
 
+float height_texel(vec2 texel) {
+  ivec2 last = textureSize(u_height_tex, 0) - ivec2(1);
+  ivec2 at = clamp(ivec2(texel + 0.5), ivec2(0), last);
+  return texelFetch(u_height_tex, at, 0).r * u_height_tex_to_world;
+}
+
+// The surface the next coarser LOD draws under this vertex. Along a lattice
+// edge this is the edge itself, so a fully morphed seam closes exactly.
+float coarse_lattice_height(vec2 texel, float step) {
+  vec2 last = vec2(textureSize(u_height_tex, 0) - ivec2(1));
+  vec2 lo = floor(texel / step) * step;
+  vec2 hi = min(lo + step, last);
+  vec2 t = clamp((texel - lo) / max(hi - lo, vec2(1e-4)), 0.0, 1.0);
+  float h00 = height_texel(lo);
+  float h10 = height_texel(vec2(hi.x, lo.y));
+  float h01 = height_texel(vec2(lo.x, hi.y));
+  float h11 = height_texel(hi);
+  return mix(mix(h00, h10, t.x), mix(h01, h11, t.x), t.y);
+}
+
 void main() {
   vec3 base_wp = (u_model * vec4(a_position, 1.0)).xyz;
+
+  float lod_morph = 0.0;
+  if (u_has_height_tex != 0 && u_lod_morph.z > 0.0) {
+    float span = max(u_lod_morph.y - u_lod_morph.x, 1e-3);
+    lod_morph =
+        clamp((distance(u_camera_pos, base_wp) - u_lod_morph.x) / span, 0.0, 1.0);
+    vec2 uv = base_wp.xz * u_height_uv_scale + u_height_uv_offset;
+    vec2 texel = uv / u_height_texel_size - 0.5;
+    base_wp.y = mix(base_wp.y, coarse_lattice_height(texel, u_lod_morph.z), lod_morph);
+  }
   vec3 world_normal = normalize(mat3(u_model) * a_normal);
   float entry_mask = clamp(a_uv.y, 0.0, 1.0);
   float feature_foot = clamp(a_uv.x, 0.0, 1.0);
@@ -86,11 +126,12 @@ void main() {
   vec3 wp = base_wp;
   vec3 displaced_normal = world_normal;
 
-  if (u_height_noise_strength > 0.00001) {
+  float noise_strength = u_height_noise_strength * (1.0 - lod_morph);
+  if (noise_strength > 0.00001) {
     displacement = sample_terrain_displacement(base_wp,
                                                world_normal,
                                                u_noise_offset,
-                                               u_height_noise_strength,
+                                               noise_strength,
                                                u_height_noise_frequency,
                                                entry_mask);
     wp.y += displacement;
@@ -103,13 +144,13 @@ void main() {
     px.y += sample_terrain_displacement(px,
                                         world_normal,
                                         u_noise_offset,
-                                        u_height_noise_strength,
+                                        noise_strength,
                                         u_height_noise_frequency,
                                         entry_mask);
     pz.y += sample_terrain_displacement(pz,
                                         world_normal,
                                         u_noise_offset,
-                                        u_height_noise_strength,
+                                        noise_strength,
                                         u_height_noise_frequency,
                                         entry_mask);
     displaced_normal = normalize(cross(pz - wp, px - wp));
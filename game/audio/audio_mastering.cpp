@@ -6,6 +6,7 @@
 #include <cmath>
 #include <complex>
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -1155,6 +1156,58 @@ auto apply(float* pcm,
   return report;
 }
 
+struct StreamMeter::State {
+  LoudnessMeter loudness;
+  float peak = 0.0F;
+};
+
+StreamMeter::StreamMeter(int sample_rate)
+    : m_state(std::make_unique<State>()) {
+  m_state->loudness.prepare(std::max(1, sample_rate));
+}
+
+StreamMeter::~StreamMeter() = default;
+
+void StreamMeter::push(const float* pcm, std::size_t frames, int channels) {
+  if (pcm == nullptr || channels <= 0) {
+    return;
+  }
+  const auto stride = static_cast<std::size_t>(channels);
+  const auto active = std::min(stride, MAX_CHANNELS);
+  const float scale = 1.0F / static_cast<float>(active);
+  for (std::size_t frame = 0; frame < frames; ++frame) {
+    const float* samples = pcm + (frame * stride);
+    float sum = 0.0F;
+    for (std::size_t channel = 0; channel < active; ++channel) {
+      sum += samples[channel];
+      m_state->peak = std::max(m_state->peak, std::abs(samples[channel]));
+    }
+    m_state->loudness.push(sum * scale);
+  }
+}
+
+auto StreamMeter::peak() const -> float { return m_state->peak; }
+
+auto StreamMeter::loudness_lufs() const -> float { return m_state->loudness.lufs(); }
+
+auto stream_level(const Profile& profile, const StreamMeter& meter) -> Report {
+  Report report;
+  const float lufs = meter.loudness_lufs();
+  report.input_peak_db = to_db(meter.peak());
+  report.input_lufs = lufs;
+  float gain_db = profile.makeup_db;
+  if (profile.normalise_loudness && lufs > -60.0F) {
+    gain_db = std::clamp(profile.target_lufs - lufs,
+                         -profile.loudness_authority_db,
+                         profile.loudness_authority_db);
+  }
+  gain_db = std::min(gain_db, profile.ceiling_db - report.input_peak_db);
+  report.loudness_gain_db = gain_db;
+  report.output_lufs = lufs > -60.0F ? lufs + gain_db : lufs;
+  report.output_peak_db = report.input_peak_db + gain_db;
+  return report;
+}
+
 auto restore(std::vector<float>& interleaved_pcm,
              int channels,
              int sample_rate,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -83,6 +84,30 @@ auto apply(float* pcm,
            const Profile& profile,
            const Analysis& analysis) -> Report;
 
+// Peak and loudness of audio that is never held whole, fed block by block as it
+// is decoded. Only the loudness stage can be derived from this; the spectral
+// shaping and the look-ahead limiter need the whole signal.
+class StreamMeter {
+public:
+  explicit StreamMeter(int sample_rate);
+  ~StreamMeter();
+  StreamMeter(const StreamMeter&) = delete;
+  auto operator=(const StreamMeter&) -> StreamMeter& = delete;
+
+  void push(const float* pcm, std::size_t frames, int channels);
+
+  [[nodiscard]] auto peak() const -> float;
+  [[nodiscard]] auto loudness_lufs() const -> float;
+
+private:
+  struct State;
+  std::unique_ptr<State> m_state;
+};
+
+// Static gain the loudness stage would give a stream, held low enough that its
+// measured peak stays under the profile ceiling without limiting.
+auto stream_level(const Profile& profile, const StreamMeter& meter) -> Report;
+
 auto restore(std::vector<float>& interleaved_pcm,
              int channels,
              int sample_rate,
@@ -25,6 +25,32 @@ auto wrap_step(const float* pcm,
 
 } // namespace
 
+auto loop_fade_frames(std::size_t frames, unsigned sample_rate) -> std::size_t {
+  const auto requested =
+      static_cast<std::size_t>(k_loop_fade_seconds * static_cast<float>(sample_rate));
+  const auto ceiling =
+      static_cast<std::size_t>(k_max_loop_fade_fraction * static_cast<float>(frames));
+  return std::min(requested, ceiling);
+}
+
+void blend_loop_head(float* head,
+                     const float* tail,
+                     std::size_t fade,
+                     unsigned channels) {
+  for (std::size_t k = 0; k < fade; ++k) {
+    const float position = static_cast<float>(k) / static_cast<float>(fade) * 0.5F *
+                           std::numbers::pi_v<float>;
+    const float head_gain = std::sin(position);
+    const float tail_gain = std::cos(position);
+    float* head_frame = head + k * channels;
+    const float* tail_frame = tail + k * channels;
+    for (unsigned channel = 0; channel < channels; ++channel) {
+      head_frame[channel] =
+          head_frame[channel] * head_gain + tail_frame[channel] * tail_gain;
+    }
+  }
+}
+
 auto seal_loop(float* pcm,
                std::size_t frames,
                unsigned channels,
@@ -36,28 +62,13 @@ auto seal_loop(float* pcm,
 
   report.step_before = wrap_step(pcm, frames, channels, frames);
 
-  const auto requested =
-      static_cast<std::size_t>(k_loop_fade_seconds * static_cast<float>(sample_rate));
-  const auto ceiling =
-      static_cast<std::size_t>(k_max_loop_fade_fraction * static_cast<float>(frames));
-  const std::size_t fade = std::min(requested, ceiling);
+  const std::size_t fade = loop_fade_frames(frames, sample_rate);
   if (fade < 2) {
     return report;
   }
 
   const std::size_t loop_frames = frames - fade;
-
-  for (std::size_t k = 0; k < fade; ++k) {
-    const float position = static_cast<float>(k) / static_cast<float>(fade) * 0.5F *
-                           std::numbers::pi_v<float>;
-    const float head_gain = std::sin(position);
-    const float tail_gain = std::cos(position);
-    float* head = pcm + k * channels;
-    const float* tail = pcm + (loop_frames + k) * channels;
-    for (unsigned channel = 0; channel < channels; ++channel) {
-      head[channel] = head[channel] * head_gain + tail[channel] * tail_gain;
-    }
-  }
+  blend_loop_head(pcm, pcm + loop_frames * channels, fade, channels);
 
   report.loop_frames = loop_frames;
   report.fade_frames = fade;
@@ -17,6 +17,17 @@ inline constexpr float k_loop_fade_seconds = 0.12F;
 
 inline constexpr float k_max_loop_fade_fraction = 0.1F;
 
+// Crossfade length seal_loop uses for a source of `frames` frames; below 2 the
+// source is left unsealed.
+auto loop_fade_frames(std::size_t frames, unsigned sample_rate) -> std::size_t;
+
+// Blends `fade` frames of `tail`, the audio that follows the loop point, into
+// the first `fade` frames of `head` with an equal-power curve.
+void blend_loop_head(float* head,
+                     const float* tail,
+                     std::size_t fade,
+                     unsigned channels);
+
 auto seal_loop(float* pcm,
                std::size_t frames,
                unsigned channels,
@@ -14,6 +14,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <thread>
 #include <utility>
@@ -26,6 +27,18 @@
 namespace {
 
 constexpr int COMMAND_WAIT_ATTEMPTS = 200;
+constexpr int STREAM_MEASURE_SECONDS = 30;
+constexpr unsigned long STREAM_REFILL_MS = 5;
+constexpr unsigned long STREAM_IDLE_POLL_MS = 25;
+
+auto is_bed(Game::Audio::Mastering::Material material) -> bool {
+  return material == Game::Audio::Mastering::Material::Music ||
+         material == Game::Audio::Mastering::Material::Ambience;
+}
+
+auto stream_request_track(std::uint64_t request) -> int {
+  return static_cast<int>(request & 0xFFFFFFFFU) - 1;
+}
 
 auto sanitize_backend_volume(float volume) -> float {
   if (!std::isfinite(volume)) {
@@ -68,6 +81,16 @@ void log_mastering(const QString& id, const Game::Audio::Mastering::Report& repo
                     << " dB, limiter " << report.limiter_reduction_db << " dB";
 }
 
+void log_stream(const QString& id,
+                const Game::Audio::Mastering::Report& report,
+                std::uint64_t frames,
+                int sample_rate) {
+  qInfo().nospace() << "audio stream " << id << ": "
+                    << double(frames) / double(sample_rate) << " s, loudness "
+                    << report.input_lufs << " LUFS " << report.loudness_gain_db
+                    << " dB, peak " << report.output_peak_db << " dBFS";
+}
+
 } // namespace
 
 #define MINIAUDIO_IMPLEMENTATION
@@ -119,6 +142,154 @@ static void audioCallback(ma_device* device,
   wrapper->self->on_audio(reinterpret_cast<float*>(output_buffer), frame_count);
 }
 
+namespace {
+
+// miniaudio file system over QFile, so streams read their file incrementally
+// whether it sits on disk or in the Qt resources.
+auto qt_vfs_open(ma_vfs*, const char* path, ma_uint32 mode, ma_vfs_file* file)
+    -> ma_result {
+  if ((mode & MA_OPEN_MODE_WRITE) != 0U) {
+    return MA_INVALID_OPERATION;
+  }
+  auto handle = std::make_unique<QFile>(QString::fromUtf8(path));
+  if (!handle->open(QIODevice::ReadOnly)) {
+    return MA_DOES_NOT_EXIST;
+  }
+  *file = handle.release();
+  return MA_SUCCESS;
+}
+
+auto qt_vfs_close(ma_vfs*, ma_vfs_file file) -> ma_result {
+  delete static_cast<QFile*>(file);
+  return MA_SUCCESS;
+}
+
+auto qt_vfs_read(ma_vfs*, ma_vfs_file file, void* out, size_t bytes, size_t* read)
+    -> ma_result {
+  const qint64 got = static_cast<QFile*>(file)->read(static_cast<char*>(out),
+                                                     static_cast<qint64>(bytes));
+  if (read != nullptr) {
+    *read = got > 0 ? static_cast<size_t>(got) : 0;
+  }
+  if (got < 0) {
+    return MA_IO_ERROR;
+  }
+  return (got == 0 && bytes > 0) ? MA_AT_END : MA_SUCCESS;
+}
+
+auto qt_vfs_seek(ma_vfs*, ma_vfs_file file, ma_int64 offset, ma_seek_origin origin)
+    -> ma_result {
+  auto* handle = static_cast<QFile*>(file);
+  qint64 target = offset;
+  if (origin == ma_seek_origin_current) {
+    target += handle->pos();
+  } else if (origin == ma_seek_origin_end) {
+    target += handle->size();
+  }
+  return handle->seek(target) ? MA_SUCCESS : MA_BAD_SEEK;
+}
+
+auto qt_vfs_tell(ma_vfs*, ma_vfs_file file, ma_int64* cursor) -> ma_result {
+  *cursor = static_cast<QFile*>(file)->pos();
+  return MA_SUCCESS;
+}
+
+auto qt_vfs_info(ma_vfs*, ma_vfs_file file, ma_file_info* info) -> ma_result {
+  info->sizeInBytes = static_cast<ma_uint64>(static_cast<QFile*>(file)->size());
+  return MA_SUCCESS;
+}
+
+auto qt_file_vfs() -> ma_vfs* {
+  static ma_vfs_callbacks callbacks{qt_vfs_open,
+                                    nullptr,
+                                    qt_vfs_close,
+                                    qt_vfs_read,
+                                    nullptr,
+                                    qt_vfs_seek,
+                                    qt_vfs_tell,
+                                    qt_vfs_info};
+  return &callbacks;
+}
+
+} // namespace
+
+// A decoder reading a file a block at a time and converting it to the mix
+// rate with the same polyphase filter whole-file decodes use, so a stream plays
+// exactly the frames a full decode would have produced.
+struct StreamDecoder {
+  ma_decoder decoder{};
+  std::unique_ptr<Game::Audio::StreamResampler> resampler;
+  std::array<float, MiniaudioBackend::DECODE_BUFFER_FRAMES *
+                        MiniaudioBackend::DEFAULT_OUTPUT_CHANNELS>
+      native{};
+  bool ready = false;
+  bool at_end = false;
+
+  StreamDecoder() = default;
+  StreamDecoder(const StreamDecoder&) = delete;
+  auto operator=(const StreamDecoder&) -> StreamDecoder& = delete;
+  ~StreamDecoder() {
+    if (ready) {
+      ma_decoder_uninit(&decoder);
+    }
+  }
+
+  auto open(const QString& path, int sample_rate) -> bool {
+    const ma_decoder_config config = ma_decoder_config_init(
+        ma_format_f32, MiniaudioBackend::DEFAULT_OUTPUT_CHANNELS, 0);
+    const QByteArray encoded = path.toUtf8();
+    ready = ma_decoder_init_vfs(
+                qt_file_vfs(), encoded.constData(), &config, &decoder) == MA_SUCCESS;
+    if (ready) {
+      resampler = std::make_unique<Game::Audio::StreamResampler>(
+          MiniaudioBackend::DEFAULT_OUTPUT_CHANNELS,
+          decoder.outputSampleRate,
+          static_cast<unsigned>(sample_rate));
+    }
+    return ready;
+  }
+
+  // Length in frames at the mix rate, or 0 when the format cannot tell.
+  [[nodiscard]] auto length() -> std::uint64_t {
+    ma_uint64 frames = 0;
+    if (ma_decoder_get_length_in_pcm_frames(&decoder, &frames) != MA_SUCCESS) {
+      return 0;
+    }
+    return resampler->output_length(frames);
+  }
+
+  auto seek(std::uint64_t frame) -> bool {
+    at_end = false;
+    return ma_decoder_seek_to_pcm_frame(&decoder, resampler->seek(frame)) == MA_SUCCESS;
+  }
+
+  // Reads up to `frames` frames; fewer only at the end of the file or on error.
+  auto read(float* out, std::uint64_t frames) -> std::uint64_t {
+    std::uint64_t done = 0;
+    while (done < frames) {
+      const std::size_t pulled = resampler->pull(
+          out + (done * MiniaudioBackend::DEFAULT_OUTPUT_CHANNELS),
+          static_cast<std::size_t>(frames - done));
+      done += pulled;
+      if (pulled > 0) {
+        continue;
+      }
+      if (at_end) {
+        break;
+      }
+      ma_uint64 got = 0;
+      const ma_result result = ma_decoder_read_pcm_frames(
+          &decoder, native.data(), MiniaudioBackend::DECODE_BUFFER_FRAMES, &got);
+      resampler->push(native.data(), static_cast<std::size_t>(got));
+      if (result != MA_SUCCESS || got == 0) {
+        at_end = true;
+        resampler->finish();
+      }
+    }
+    return done;
+  }
+};
+
 MiniaudioBackend::MiniaudioBackend(QObject* parent)
     : QObject(parent) {
 }
@@ -194,6 +365,12 @@ void MiniaudioBackend::shutdown() {
   drain_commands();
   m_channels.clear();
   m_sound_effects.clear();
+  for (StreamVoice& voice : m_streams) {
+    close_stream(voice);
+    voice.claimed = false;
+    voice.request.store(0, std::memory_order_relaxed);
+    voice.serving.store(0, std::memory_order_relaxed);
+  }
 
   QMutexLocker const locker(&m_registry_mutex);
   m_track_ids.clear();
@@ -223,6 +400,12 @@ void MiniaudioBackend::start_worker() {
   m_decode_running = true;
   locker.unlock();
   m_decode_thread = std::thread([this] { decode_worker(); });
+
+  {
+    QMutexLocker const stream_locker(&m_stream_mutex);
+    m_stream_running = true;
+  }
+  m_stream_thread = std::thread([this] { stream_worker(); });
 }
 
 void MiniaudioBackend::stop_worker() {
@@ -239,6 +422,15 @@ void MiniaudioBackend::stop_worker() {
   if (m_decode_thread.joinable()) {
     m_decode_thread.join();
   }
+
+  {
+    QMutexLocker const locker(&m_stream_mutex);
+    m_stream_running = false;
+    m_stream_wake.wakeAll();
+  }
+  if (m_stream_thread.joinable()) {
+    m_stream_thread.join();
+  }
 }
 
 auto MiniaudioBackend::take_next_job(DecodeJob& job) -> bool {
@@ -264,7 +456,7 @@ void MiniaudioBackend::decode_worker() {
         m_decode_ready.wait(&m_decode_mutex);
       }
       if (!m_decode_running) {
-        return;
+        break;
       }
       if (!take_next_job(job)) {
         continue;
@@ -276,6 +468,125 @@ void MiniaudioBackend::decode_worker() {
   }
 }
 
+void MiniaudioBackend::stream_worker() {
+  QMutexLocker locker(&m_stream_mutex);
+  while (m_stream_running) {
+    service_streams();
+    // Stream claims come from the mixer, which never takes this lock, so the
+    // thread polls for them and refills playing streams on a timer.
+    m_stream_wake.wait(&m_stream_mutex,
+                       any_stream_requested() ? STREAM_REFILL_MS : STREAM_IDLE_POLL_MS);
+  }
+  for (StreamVoice& voice : m_streams) {
+    close_stream(voice);
+  }
+}
+
+void MiniaudioBackend::pump_streams() {
+  QMutexLocker const locker(&m_stream_mutex);
+  service_streams();
+}
+
+auto MiniaudioBackend::any_stream_requested() const -> bool {
+  return std::any_of(m_streams.begin(), m_streams.end(), [](const StreamVoice& voice) {
+    return voice.opened != 0 || voice.request.load(std::memory_order_relaxed) != 0;
+  });
+}
+
+void MiniaudioBackend::service_streams() {
+  for (StreamVoice& voice : m_streams) {
+    const std::uint64_t request = voice.request.load(std::memory_order_acquire);
+    if (request != voice.opened) {
+      close_stream(voice);
+      if (request != 0) {
+        const int track = stream_request_track(request);
+        {
+          QMutexLocker const locker(&m_registry_mutex);
+          const DecodedTrack* decoded = (track >= 0 && track < MAX_TRACKS)
+                                            ? m_track_storage[track].get()
+                                            : nullptr;
+          if (decoded != nullptr && decoded->stream != nullptr) {
+            voice.source = decoded->stream;
+            voice.loop_frames = decoded->frames;
+          }
+        }
+        auto decoder = std::make_unique<StreamDecoder>();
+        if (voice.source != nullptr &&
+            decoder->open(voice.source->path, m_sample_rate) &&
+            decoder->seek(voice.source->head.size() / DEFAULT_OUTPUT_CHANNELS)) {
+          voice.decoder = std::move(decoder);
+        } else {
+          qWarning() << "MiniaudioBackend: could not open stream for track" << track;
+          voice.source.reset();
+        }
+        if (voice.ring.capacity() == 0) {
+          voice.ring.allocate(STREAM_RING_FRAMES, DEFAULT_OUTPUT_CHANNELS);
+        }
+        voice.ring.reset();
+        voice.opened = request;
+        voice.serving.store(request, std::memory_order_release);
+      }
+    }
+    if (voice.decoder != nullptr) {
+      refill_stream(voice);
+    }
+  }
+}
+
+void MiniaudioBackend::refill_stream(StreamVoice& voice) {
+  const StreamSource& source = *voice.source;
+  const std::size_t head_frames = source.head.size() / DEFAULT_OUTPUT_CHANNELS;
+  std::array<float, DECODE_BUFFER_FRAMES * DEFAULT_OUTPUT_CHANNELS> buffer{};
+
+  for (;;) {
+    const std::size_t space = voice.ring.writable();
+    if (space == 0) {
+      return;
+    }
+    if (voice.position >= voice.loop_frames) {
+      if (!voice.decoder->seek(head_frames)) {
+        qWarning() << "MiniaudioBackend: stream seek failed for" << source.path;
+        voice.decoder.reset();
+        return;
+      }
+      voice.position = 0;
+    }
+
+    std::size_t count = std::min({space,
+                                  std::size_t(DECODE_BUFFER_FRAMES),
+                                  std::size_t(voice.loop_frames - voice.position)});
+    if (voice.position < head_frames) {
+      count = std::min(count, head_frames - voice.position);
+      const float* head =
+          source.head.data() + (std::size_t(voice.position) * DEFAULT_OUTPUT_CHANNELS);
+      std::copy_n(head, count * DEFAULT_OUTPUT_CHANNELS, buffer.data());
+    } else {
+      const auto got =
+          static_cast<std::size_t>(voice.decoder->read(buffer.data(), count));
+      // A file shorter than its header claimed pads with silence so the loop
+      // stays where the mixer expects it.
+      std::fill(buffer.data() + (got * DEFAULT_OUTPUT_CHANNELS),
+                buffer.data() + (count * DEFAULT_OUTPUT_CHANNELS),
+                0.0F);
+    }
+
+    const std::size_t samples = count * DEFAULT_OUTPUT_CHANNELS;
+    for (std::size_t i = 0; i < samples; ++i) {
+      buffer[i] = std::clamp(buffer[i] * source.gain, -source.ceiling, source.ceiling);
+    }
+    voice.ring.write(buffer.data(), count);
+    voice.position += static_cast<unsigned>(count);
+  }
+}
+
+void MiniaudioBackend::close_stream(StreamVoice& voice) {
+  voice.decoder.reset();
+  voice.source.reset();
+  voice.opened = 0;
+  voice.loop_frames = 0;
+  voice.position = 0;
+}
+
 void MiniaudioBackend::finish_job(const DecodeJob& job, bool decoded) {
   if (!decoded) {
     qWarning() << "MiniaudioBackend: dropping" << job.id
@@ -357,6 +668,19 @@ auto MiniaudioBackend::is_track_ready(const QString& id) const -> bool {
   return slot >= 0 && m_track_table[slot].load(std::memory_order_acquire) != nullptr;
 }
 
+auto MiniaudioBackend::is_track_streamed(const QString& id) const -> bool {
+  const int slot = find_track_slot(id);
+  if (slot < 0) {
+    return false;
+  }
+  const DecodedTrack* track = m_track_table[slot].load(std::memory_order_acquire);
+  return track != nullptr && track->stream != nullptr;
+}
+
+void MiniaudioBackend::set_stream_threshold_frames(unsigned frames) {
+  m_stream_threshold_frames.store(frames, std::memory_order_relaxed);
+}
+
 auto MiniaudioBackend::is_track_decode_pending(const QString& id) const -> bool {
   const int slot = find_track_slot(id);
   if (slot < 0) {
@@ -367,6 +691,17 @@ auto MiniaudioBackend::is_track_decode_pending(const QString& id) const -> bool
 }
 
 auto MiniaudioBackend::decode_into_slot(const DecodeJob& job) -> bool {
+  if (is_bed(job.material)) {
+    bool worker_running = false;
+    {
+      QMutexLocker const locker(&m_decode_mutex);
+      worker_running = m_decode_running;
+    }
+    if (worker_running && stream_into_slot(job)) {
+      return true;
+    }
+  }
+
   QFile file(job.path);
   if (!file.open(QIODevice::ReadOnly)) {
     qWarning() << "miniaudio: QFile open failed for" << job.path;
@@ -442,9 +777,7 @@ auto MiniaudioBackend::decode_into_slot(const DecodeJob& job) -> bool {
                                     analysis);
   log_mastering(job.id, report);
 
-  const bool loops = job.material == Game::Audio::Mastering::Material::Music ||
-                     job.material == Game::Audio::Mastering::Material::Ambience;
-  if (loops) {
+  if (is_bed(job.material)) {
     const Game::Audio::LoopSeamReport seam = Game::Audio::seal_loop(
         pcm.data(), frame_count, DEFAULT_OUTPUT_CHANNELS, m_sample_rate);
     if (seam.loop_frames > 0) {
@@ -467,7 +800,84 @@ auto MiniaudioBackend::decode_into_slot(const DecodeJob& job) -> bool {
     track->channels = DEFAULT_OUTPUT_CHANNELS;
   }
   track->pcm = std::move(pcm);
+  return publish_track(job, std::move(track));
+}
 
+auto MiniaudioBackend::stream_into_slot(const DecodeJob& job) -> bool {
+  StreamDecoder decoder;
+  if (!decoder.open(job.path, m_sample_rate)) {
+    return false;
+  }
+  const std::uint64_t length = decoder.length();
+  const unsigned threshold = m_stream_threshold_frames.load(std::memory_order_relaxed);
+  if (length == 0 || length < threshold ||
+      length > std::numeric_limits<unsigned>::max()) {
+    return false;
+  }
+  const std::size_t fade =
+      Game::Audio::loop_fade_frames(length, static_cast<unsigned>(m_sample_rate));
+  if (fade < 2) {
+    return false;
+  }
+  const std::uint64_t loop_frames = length - fade;
+
+  // One pass over the opening measures the level and keeps the head that the
+  // loop crossfade rewrites; the rest of the file is only ever read by the
+  // voices playing it.
+  auto source = std::make_shared<StreamSource>();
+  source->path = job.path;
+  source->head.resize(fade * DEFAULT_OUTPUT_CHANNELS);
+  Game::Audio::Mastering::StreamMeter meter(m_sample_rate);
+  const std::uint64_t measure_frames =
+      std::min<std::uint64_t>(loop_frames, std::uint64_t(STREAM_MEASURE_SECONDS) *
+                                               std::uint64_t(m_sample_rate));
+  std::array<float, DECODE_BUFFER_FRAMES * DEFAULT_OUTPUT_CHANNELS> buffer{};
+  std::uint64_t measured = 0;
+  while (measured < measure_frames) {
+    const std::uint64_t want =
+        std::min<std::uint64_t>(DECODE_BUFFER_FRAMES, measure_frames - measured);
+    const std::uint64_t got = decoder.read(buffer.data(), want);
+    if (got == 0) {
+      break;
+    }
+    meter.push(buffer.data(), got, DEFAULT_OUTPUT_CHANNELS);
+    if (measured < fade) {
+      const std::uint64_t keep = std::min<std::uint64_t>(got, fade - measured);
+      std::copy_n(buffer.data(),
+                  keep * DEFAULT_OUTPUT_CHANNELS,
+                  source->head.data() + (measured * DEFAULT_OUTPUT_CHANNELS));
+    }
+    measured += got;
+  }
+  if (measured < fade) {
+    return false;
+  }
+
+  std::vector<float> tail(fade * DEFAULT_OUTPUT_CHANNELS);
+  if (!decoder.seek(loop_frames) || decoder.read(tail.data(), fade) != fade) {
+    return false;
+  }
+  meter.push(tail.data(), fade, DEFAULT_OUTPUT_CHANNELS);
+  Game::Audio::blend_loop_head(
+      source->head.data(), tail.data(), fade, DEFAULT_OUTPUT_CHANNELS);
+
+  const Game::Audio::Mastering::Profile profile =
+      Game::Audio::Mastering::profile_for(job.material);
+  const Game::Audio::Mastering::Report report =
+      Game::Audio::Mastering::stream_level(profile, meter);
+  source->gain = std::pow(10.0F, report.loudness_gain_db / 20.0F);
+  source->ceiling = std::pow(10.0F, profile.ceiling_db / 20.0F);
+  log_stream(job.id, report, length, m_sample_rate);
+
+  auto track = std::make_unique<DecodedTrack>();
+  track->frames = static_cast<unsigned>(loop_frames);
+  track->channels = DEFAULT_OUTPUT_CHANNELS;
+  track->stream = std::move(source);
+  return publish_track(job, std::move(track));
+}
+
+auto MiniaudioBackend::publish_track(const DecodeJob& job,
+                                     std::unique_ptr<DecodedTrack> track) -> bool {
   QMutexLocker const locker(&m_registry_mutex);
   if (job.track < 0 || job.track >= MAX_TRACKS ||
       m_track_ids.value(job.id, -1) != job.track) {
@@ -504,9 +914,7 @@ auto MiniaudioBackend::request_track(const QString& id,
     return decode_into_slot(job);
   }
   m_pending_slots.insert(slot);
-  const bool is_bed = material == Game::Audio::Mastering::Material::Music ||
-                      material == Game::Audio::Mastering::Material::Ambience;
-  if (is_bed) {
+  if (is_bed(material)) {
     m_decode_bulk_jobs.push_back(std::move(job));
   } else {
     m_decode_jobs.push_back(std::move(job));
@@ -718,6 +1126,7 @@ void MiniaudioBackend::apply_command(const Game::Audio::AudioCommand& command) {
       return;
     }
     Channel& channel = m_channels[channel_index];
+    release_stream(channel.stream);
     channel.track = command.track;
     channel.frame_pos = 0;
     channel.looping = command.loop;
@@ -809,6 +1218,7 @@ void MiniaudioBackend::apply_command(const Game::Audio::AudioCommand& command) {
   case Type::StopSound:
     for (SoundEffect& effect : m_sound_effects) {
       if (effect.active && effect.track == command.track) {
+        release_stream(effect.stream);
         effect = SoundEffect{};
       }
     }
@@ -816,11 +1226,13 @@ void MiniaudioBackend::apply_command(const Game::Audio::AudioCommand& command) {
   case Type::ReleaseTrack:
     for (Channel& channel : m_channels) {
       if (channel.track == command.track) {
+        release_stream(channel.stream);
         channel = Channel{};
       }
     }
     for (SoundEffect& effect : m_sound_effects) {
       if (effect.track == command.track) {
+        release_stream(effect.stream);
         effect = SoundEffect{};
       }
     }
@@ -830,6 +1242,45 @@ void MiniaudioBackend::apply_command(const Game::Audio::AudioCommand& command) {
   }
 }
 
+auto MiniaudioBackend::claim_stream(int track) -> int {
+  for (std::size_t index = 0; index < m_streams.size(); ++index) {
+    StreamVoice& voice = m_streams[index];
+    if (voice.claimed) {
+      continue;
+    }
+    voice.claimed = true;
+    ++voice.generation;
+    voice.request.store((std::uint64_t(voice.generation) << 32U) |
+                            std::uint64_t(static_cast<std::uint32_t>(track + 1)),
+                        std::memory_order_release);
+    return static_cast<int>(index);
+  }
+  return -1;
+}
+
+void MiniaudioBackend::release_stream(int& stream) {
+  if (stream < 0) {
+    return;
+  }
+  StreamVoice& voice = m_streams[static_cast<std::size_t>(stream)];
+  voice.claimed = false;
+  voice.request.store(0, std::memory_order_release);
+  stream = -1;
+}
+
+auto MiniaudioBackend::stream_frames(int stream, unsigned& run) -> const float* {
+  const StreamVoice& voice = m_streams[static_cast<std::size_t>(stream)];
+  if (voice.serving.load(std::memory_order_acquire) !=
+      voice.request.load(std::memory_order_relaxed)) {
+    run = 0;
+    return nullptr;
+  }
+  std::size_t count = 0;
+  const float* frames = voice.ring.peek(run, count);
+  run = static_cast<unsigned>(count);
+  return count == 0 ? nullptr : frames;
+}
+
 void MiniaudioBackend::drain_commands() {
   m_commands.drain(
       [this](const Game::Audio::AudioCommand& command) { apply_command(command); });
@@ -873,6 +1324,13 @@ void MiniaudioBackend::on_audio(float* output, unsigned frames) {
     if (track == nullptr || track->frames == 0) {
       continue;
     }
+    const bool streamed = track->stream != nullptr;
+    if (streamed && channel.stream < 0) {
+      channel.stream = claim_stream(channel.track);
+      if (channel.stream < 0) {
+        continue;
+      }
+    }
 
     const float* const pcm = track->pcm.data();
     const unsigned stride = track->channels;
@@ -887,8 +1345,13 @@ void MiniaudioBackend::on_audio(float* output, unsigned frames) {
         }
         position = 0;
       }
-      const unsigned run = std::min(frames_left, track->frames - position);
-      const float* source = pcm + (static_cast<std::size_t>(position) * stride);
+      unsigned run = std::min(frames_left, track->frames - position);
+      const float* source = streamed
+                                ? stream_frames(channel.stream, run)
+                                : pcm + (static_cast<std::size_t>(position) * stride);
+      if (source == nullptr) {
+        break;
+      }
 
       const unsigned fading = std::min(run, channel.fade_samples);
       for (unsigned i = 0; i < fading; ++i) {
@@ -925,16 +1388,21 @@ void MiniaudioBackend::on_audio(float* output, unsigned frames) {
       }
       position += run;
       frames_left -= run;
+      if (streamed) {
+        m_streams[static_cast<std::size_t>(channel.stream)].ring.consume(run);
+      }
     }
 
     channel.frame_pos = position;
 
     if (!channel.looping && channel.frame_pos >= track->frames) {
+      release_stream(channel.stream);
       channel = Channel{};
       continue;
     }
     if (channel.fade_samples == 0 && channel.current_volume <= MIN_VOLUME &&
         channel.target_volume <= MIN_VOLUME && !channel.looping) {
+      release_stream(channel.stream);
       channel = Channel{};
     }
   }
@@ -947,9 +1415,17 @@ void MiniaudioBackend::on_audio(float* output, unsigned frames) {
         m_track_table[static_cast<std::size_t>(effect.track)].load(
             std::memory_order_acquire);
     if (track == nullptr || track->frames == 0) {
+      release_stream(effect.stream);
       effect = SoundEffect{};
       continue;
     }
+    const bool streamed = track->stream != nullptr;
+    if (streamed && effect.stream < 0) {
+      effect.stream = claim_stream(effect.track);
+      if (effect.stream < 0) {
+        continue;
+      }
+    }
 
     const float* const pcm = track->pcm.data();
     const unsigned stride = track->channels;
@@ -965,8 +1441,13 @@ void MiniaudioBackend::on_audio(float* output, unsigned frames) {
         }
         position = 0;
       }
-      const unsigned run = std::min(frames_left, track->frames - position);
-      const float* source = pcm + (static_cast<std::size_t>(position) * stride);
+      unsigned run = std::min(frames_left, track->frames - position);
+      const float* source = streamed
+                                ? stream_frames(effect.stream, run)
+                                : pcm + (static_cast<std::size_t>(position) * stride);
+      if (source == nullptr) {
+        break;
+      }
 
       const unsigned fading = std::min(run, effect.fade_samples);
       for (unsigned i = 0; i < fading; ++i) {
@@ -1002,10 +1483,14 @@ void MiniaudioBackend::on_audio(float* output, unsigned frames) {
       }
       position += run;
       frames_left -= run;
+      if (streamed) {
+        m_streams[static_cast<std::size_t>(effect.stream)].ring.consume(run);
+      }
     }
 
     effect.frame_pos = position;
     if (!effect.active) {
+      release_stream(effect.stream);
       effect = SoundEffect{};
     }
   }
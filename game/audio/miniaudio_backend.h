@@ -17,9 +17,11 @@
 #include "audio_commands.h"
 #include "audio_mastering.h"
 #include "bus_limiter.h"
+#include "stream_ring.h"
 
 struct ma_device;
 struct DeviceWrapper;
+struct StreamDecoder;
 
 class MiniaudioBackend : public QObject {
   Q_OBJECT
@@ -32,6 +34,9 @@ public:
   static constexpr int MIN_SAMPLE_RATE = 22050;
   static constexpr int MAX_TRACKS = 512;
   static constexpr std::size_t COMMAND_CAPACITY = 256;
+  static constexpr int MAX_STREAMS = 8;
+  static constexpr int STREAM_RING_FRAMES = 32768;
+  static constexpr unsigned DEFAULT_STREAM_THRESHOLD_FRAMES = DEFAULT_SAMPLE_RATE * 20;
   static constexpr float MIN_VOLUME = 0.0F;
   static constexpr float MAX_VOLUME = 2.0F;
   static constexpr float DEFAULT_VOLUME = 1.0F;
@@ -71,18 +76,60 @@ public:
 
   auto is_track_ready(const QString& id) const -> bool;
   auto is_track_decode_pending(const QString& id) const -> bool;
+  auto is_track_streamed(const QString& id) const -> bool;
+
+  // Music and ambience beds at least this long are streamed from disk rather
+  // than decoded whole; applies to tracks requested afterwards.
+  void set_stream_threshold_frames(unsigned frames);
+
+  // Opens newly claimed streams and tops up every playing ring on the calling
+  // thread. The stream thread does this every few milliseconds; headless tests
+  // call it between renders so they do not depend on its timing.
+  void pump_streams();
 
   void on_audio(float* output, unsigned frames);
 
 private:
+  // What a stream voice needs to play a bed from disk: the crossfaded head
+  // that replaces the first frames of every pass, and the loudness gain
+  // measured when the track was requested.
+  struct StreamSource {
+    QString path;
+    std::vector<float> head;
+    float gain = DEFAULT_VOLUME;
+    float ceiling = MAX_OUTPUT_SAMPLE;
+  };
+
   struct DecodedTrack {
     std::vector<float> pcm;
     unsigned frames = 0;
     unsigned channels = DEFAULT_OUTPUT_CHANNELS;
+    std::shared_ptr<const StreamSource> stream;
+  };
+
+  // One playing stream. The mixer claims a voice and publishes the request
+  // (generation << 32 | track + 1); the stream thread answers by resetting the
+  // ring, opening the file and storing the same value in `serving`, after
+  // which it keeps the ring topped up. The mixer reads the ring only while
+  // `serving` matches its latest request.
+  struct StreamVoice {
+    Game::Audio::FrameRing ring;
+    std::atomic<std::uint64_t> request{0};
+    std::atomic<std::uint64_t> serving{0};
+
+    bool claimed = false;
+    std::uint32_t generation = 0;
+
+    std::uint64_t opened = 0;
+    std::shared_ptr<const StreamSource> source;
+    std::unique_ptr<StreamDecoder> decoder;
+    unsigned loop_frames = 0;
+    unsigned position = 0;
   };
 
   struct Channel {
     int track = -1;
+    int stream = -1;
     unsigned frame_pos = 0;
     float current_volume = 0.0F;
     float target_volume = DEFAULT_VOLUME;
@@ -95,6 +142,7 @@ private:
 
   struct SoundEffect {
     int track = -1;
+    int stream = -1;
     unsigned frame_pos = 0;
     float volume = DEFAULT_VOLUME;
     float target_volume = DEFAULT_VOLUME;
@@ -116,10 +164,20 @@ private:
   auto claim_track_slot(const QString& id) -> int;
   auto find_track_slot(const QString& id) const -> int;
   auto decode_into_slot(const DecodeJob& job) -> bool;
+  auto stream_into_slot(const DecodeJob& job) -> bool;
+  auto publish_track(const DecodeJob& job, std::unique_ptr<DecodedTrack> track) -> bool;
   [[nodiscard]] auto take_next_job(DecodeJob& job) -> bool;
   void finish_job(const DecodeJob& job, bool decoded);
   void release_slot(int slot);
   void decode_worker();
+  void stream_worker();
+  [[nodiscard]] auto any_stream_requested() const -> bool;
+  void service_streams();
+  void refill_stream(StreamVoice& voice);
+  void close_stream(StreamVoice& voice);
+  auto claim_stream(int track) -> int;
+  void release_stream(int& stream);
+  auto stream_frames(int stream, unsigned& run) -> const float*;
   void start_worker();
   void stop_worker();
   void submit(const Game::Audio::AudioCommand& command);
@@ -140,6 +198,8 @@ private:
   std::array<bool, MAX_TRACKS> m_slot_taken{};
   std::array<std::unique_ptr<DecodedTrack>, MAX_TRACKS> m_track_storage;
   std::array<std::atomic<const DecodedTrack*>, MAX_TRACKS> m_track_table{};
+  std::atomic<unsigned> m_stream_threshold_frames{DEFAULT_STREAM_THRESHOLD_FRAMES};
+  std::array<StreamVoice, MAX_STREAMS> m_streams;
 
   Game::Audio::CommandRing<COMMAND_CAPACITY> m_commands;
 
@@ -160,4 +220,12 @@ private:
   std::thread m_decode_thread;
   bool m_decode_running{false};
   int m_decode_in_flight{0};
+
+  // Streams get their own thread so a long decode or stream measurement on the
+  // decode worker never leaves a ring to run dry. The mutex also serialises
+  // pump_streams() with it.
+  mutable QMutex m_stream_mutex;
+  QWaitCondition m_stream_wake;
+  std::thread m_stream_thread;
+  bool m_stream_running{false};
 };
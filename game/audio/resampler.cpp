@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <numbers>
 #include <numeric>
 #include <utility>
@@ -46,6 +48,42 @@ auto design_filter(std::size_t taps, double cutoff, double beta) -> std::vector<
   return filter;
 }
 
+struct Polyphase {
+  unsigned up = 1;
+  unsigned down = 1;
+  std::size_t taps_per_phase = 0;
+  std::size_t centre = 0;
+  std::vector<float> filter;
+};
+
+auto design_polyphase(unsigned rate_in, unsigned rate_out) -> Polyphase {
+  Polyphase design;
+  const unsigned divisor = std::gcd(rate_in, rate_out);
+  design.up = rate_out / divisor;
+  design.down = rate_in / divisor;
+  if (design.up == 1 && design.down == 1) {
+    return design;
+  }
+
+  const double intermediate =
+      static_cast<double>(rate_in) * static_cast<double>(design.up);
+  const double passband = 0.5 * static_cast<double>(std::min(rate_in, rate_out));
+  const double cutoff = passband / intermediate;
+  const double transition =
+      passband * static_cast<double>(k_resampler_transition_fraction) / intermediate;
+  const double beta = 0.1102 * (static_cast<double>(k_resampler_stopband_db) - 8.7);
+
+  auto taps = static_cast<std::size_t>(
+      std::ceil((static_cast<double>(k_resampler_stopband_db) - 8.0) /
+                (2.285 * 2.0 * std::numbers::pi * transition)));
+  taps = std::max<std::size_t>(taps, 8);
+  design.taps_per_phase = (taps + design.up - 1) / design.up;
+  taps = design.taps_per_phase * design.up;
+  design.filter = design_filter(taps, cutoff, beta);
+  design.centre = (taps - 1) / 2;
+  return design;
+}
+
 auto channels_are_identical(const std::vector<float>& pcm, unsigned channels) -> bool {
   if (channels < 2) {
     return true;
@@ -79,33 +117,19 @@ auto resample_to(std::vector<float>& pcm,
     return report;
   }
 
-  const unsigned divisor = std::gcd(rate_in, rate_out);
-  const unsigned up = rate_out / divisor;
-  const unsigned down = rate_in / divisor;
+  const Polyphase design = design_polyphase(rate_in, rate_out);
+  const unsigned up = design.up;
+  const unsigned down = design.down;
   report.up = up;
   report.down = down;
   report.frames_out = frames_in;
   if (up == 1 && down == 1) {
     return report;
   }
-
-  const double intermediate = static_cast<double>(rate_in) * static_cast<double>(up);
-  const double passband = 0.5 * static_cast<double>(std::min(rate_in, rate_out));
-  const double cutoff = passband / intermediate;
-  const double transition =
-      passband * static_cast<double>(k_resampler_transition_fraction) / intermediate;
-  const double beta = 0.1102 * (static_cast<double>(k_resampler_stopband_db) - 8.7);
-
-  auto taps = static_cast<std::size_t>(
-      std::ceil((static_cast<double>(k_resampler_stopband_db) - 8.0) /
-                (2.285 * 2.0 * std::numbers::pi * transition)));
-  taps = std::max<std::size_t>(taps, 8);
-  const std::size_t taps_per_phase = (taps + up - 1) / up;
-  taps = taps_per_phase * up;
+  const std::size_t taps_per_phase = design.taps_per_phase;
   report.taps_per_phase = taps_per_phase;
-
-  const std::vector<float> filter = design_filter(taps, cutoff, beta);
-  const std::size_t centre = (taps - 1) / 2;
+  const std::vector<float>& filter = design.filter;
+  const std::size_t centre = design.centre;
 
   const std::size_t frames_out = (frames_in * up) / down;
   if (frames_out == 0) {
@@ -147,4 +171,95 @@ auto resample_to(std::vector<float>& pcm,
   return report;
 }
 
+StreamResampler::StreamResampler(unsigned channels, unsigned rate_in, unsigned rate_out)
+    : m_channels(std::max(1U, channels)) {
+  if (rate_in == 0 || rate_out == 0) {
+    return;
+  }
+  Polyphase design = design_polyphase(rate_in, rate_out);
+  m_up = design.up;
+  m_down = design.down;
+  m_taps_per_phase = design.taps_per_phase;
+  m_centre = design.centre;
+  m_filter = std::move(design.filter);
+}
+
+auto StreamResampler::output_length(std::uint64_t input_frames) const -> std::uint64_t {
+  return (input_frames * m_up) / m_down;
+}
+
+auto StreamResampler::seek(std::uint64_t output_frame) -> std::uint64_t {
+  m_next_out = output_frame;
+  m_finished = false;
+  m_input.clear();
+  if (passthrough()) {
+    m_input_start = output_frame;
+  } else {
+    const std::uint64_t base = (output_frame * m_down + m_centre) / m_up;
+    m_input_start = base >= m_taps_per_phase - 1 ? base - (m_taps_per_phase - 1) : 0;
+  }
+  return m_input_start;
+}
+
+void StreamResampler::push(const float* frames, std::size_t count) {
+  m_input.insert(m_input.end(), frames, frames + count * m_channels);
+}
+
+void StreamResampler::finish() { m_finished = true; }
+
+auto StreamResampler::pull(float* out, std::size_t max) -> std::size_t {
+  const std::uint64_t input_end = m_input_start + m_input.size() / m_channels;
+  const std::uint64_t total_out =
+      m_finished ? output_length(input_end) : std::numeric_limits<std::uint64_t>::max();
+  std::size_t produced = 0;
+
+  if (passthrough()) {
+    produced = static_cast<std::size_t>(
+        std::min<std::uint64_t>(max, input_end - m_next_out));
+    std::copy_n(m_input.begin(), produced * m_channels, out);
+    m_input.erase(m_input.begin(),
+                  m_input.begin() + static_cast<std::ptrdiff_t>(produced * m_channels));
+    m_input_start += produced;
+    m_next_out += produced;
+    return produced;
+  }
+
+  // The same sum resample_to forms for each output frame, in the same order,
+  // reading samples past the end of the input as silence once it is finished.
+  while (produced < max && m_next_out < total_out) {
+    const std::uint64_t numerator = m_next_out * m_down + m_centre;
+    const auto phase = static_cast<std::size_t>(numerator % m_up);
+    const std::uint64_t base = (numerator - phase) / m_up;
+    if (!m_finished && base >= input_end) {
+      break;
+    }
+    const std::uint64_t first_tap = base >= input_end ? (base - input_end) + 1U : 0U;
+    const std::uint64_t last_tap = std::min<std::uint64_t>(
+        {m_taps_per_phase - 1, base, base - m_input_start});
+    float* frame_out = out + produced * m_channels;
+    for (unsigned channel = 0; channel < m_channels; ++channel) {
+      float total = 0.0F;
+      for (std::uint64_t tap = first_tap; tap <= last_tap; ++tap) {
+        const auto index = static_cast<std::size_t>(base - tap - m_input_start);
+        total += m_filter[phase + tap * m_up] * m_input[index * m_channels + channel];
+      }
+      frame_out[channel] = total * static_cast<float>(m_up);
+    }
+    ++produced;
+    ++m_next_out;
+  }
+
+  const std::uint64_t next_base = (m_next_out * m_down + m_centre) / m_up;
+  const std::uint64_t keep_from =
+      next_base >= m_taps_per_phase - 1 ? next_base - (m_taps_per_phase - 1) : 0;
+  if (keep_from > m_input_start) {
+    const auto drop = static_cast<std::size_t>(
+        std::min<std::uint64_t>(keep_from - m_input_start, input_end - m_input_start));
+    m_input.erase(m_input.begin(),
+                  m_input.begin() + static_cast<std::ptrdiff_t>(drop * m_channels));
+    m_input_start += drop;
+  }
+  return produced;
+}
+
 } // namespace Game::Audio
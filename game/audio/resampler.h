@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace Game::Audio {
@@ -24,4 +25,34 @@ auto resample_to(std::vector<float>& pcm,
                  unsigned rate_in,
                  unsigned rate_out) -> ResampleReport;
 
+// resample_to for audio that arrives a block at a time. The filter is the same
+// and so is every output frame; seek() restarts at any output frame and names
+// the input frame to resume feeding from.
+class StreamResampler {
+public:
+  StreamResampler(unsigned channels, unsigned rate_in, unsigned rate_out);
+
+  [[nodiscard]] auto passthrough() const -> bool { return m_up == 1 && m_down == 1; }
+  [[nodiscard]] auto output_length(std::uint64_t input_frames) const -> std::uint64_t;
+
+  auto seek(std::uint64_t output_frame) -> std::uint64_t;
+  void push(const float* frames, std::size_t count);
+  // No more input follows; the remaining output reads past the end as silence.
+  void finish();
+  // Writes up to `max` frames that the input so far fully determines.
+  auto pull(float* out, std::size_t max) -> std::size_t;
+
+private:
+  unsigned m_channels = 1;
+  unsigned m_up = 1;
+  unsigned m_down = 1;
+  std::size_t m_taps_per_phase = 0;
+  std::size_t m_centre = 0;
+  std::vector<float> m_filter;
+  std::vector<float> m_input;
+  std::uint64_t m_input_start = 0;
+  std::uint64_t m_next_out = 0;
+  bool m_finished = false;
+};
+
 } // namespace Game::Audio
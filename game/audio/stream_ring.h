@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Game::Audio {
+
+// Single-producer single-consumer ring of interleaved frames: the decode worker
+// writes, the mixer reads. reset() belongs to the producer and is only safe
+// while the consumer is known not to be reading.
+class FrameRing {
+public:
+  void allocate(std::size_t frames, unsigned channels) {
+    m_capacity = frames;
+    m_channels = std::max(1U, channels);
+    m_samples.assign(m_capacity * m_channels, 0.0F);
+    reset();
+  }
+
+  void reset() {
+    m_read.store(0, std::memory_order_relaxed);
+    m_write.store(0, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto capacity() const -> std::size_t { return m_capacity; }
+
+  [[nodiscard]] auto readable() const -> std::size_t {
+    return static_cast<std::size_t>(m_write.load(std::memory_order_acquire) -
+                                    m_read.load(std::memory_order_relaxed));
+  }
+
+  [[nodiscard]] auto writable() const -> std::size_t {
+    return m_capacity -
+           static_cast<std::size_t>(m_write.load(std::memory_order_relaxed) -
+                                    m_read.load(std::memory_order_acquire));
+  }
+
+  // Copies up to `count` frames in and returns how many fitted.
+  auto write(const float* frames, std::size_t count) -> std::size_t {
+    count = std::min(count, writable());
+    const std::uint64_t write = m_write.load(std::memory_order_relaxed);
+    std::size_t done = 0;
+    while (done < count) {
+      const std::size_t at = static_cast<std::size_t>((write + done) % m_capacity);
+      const std::size_t run = std::min(count - done, m_capacity - at);
+      std::copy_n(frames + done * m_channels,
+                  run * m_channels,
+                  m_samples.data() + at * m_channels);
+      done += run;
+    }
+    m_write.store(write + count, std::memory_order_release);
+    return count;
+  }
+
+  // The next contiguous run of readable frames, at most `max`; `count` receives
+  // its length. The frames stay readable until consume().
+  auto peek(std::size_t max, std::size_t& count) const -> const float* {
+    const std::uint64_t read = m_read.load(std::memory_order_relaxed);
+    const std::size_t at =
+        static_cast<std::size_t>(read % std::max<std::size_t>(1, m_capacity));
+    count = std::min({max, readable(), m_capacity - at});
+    return m_samples.data() + at * m_channels;
+  }
+
+  void consume(std::size_t count) {
+    m_read.store(m_read.load(std::memory_order_relaxed) + count,
+                 std::memory_order_release);
+  }
+
+private:
+  std::vector<float> m_samples;
+  std::size_t m_capacity = 0;
+  unsigned m_channels = 1;
+  std::atomic<std::uint64_t> m_write{0};
+  std::atomic<std::uint64_t> m_read{0};
+};
+
+} // namespace Game::Audio
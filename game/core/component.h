@@ -248,6 +248,7 @@ private:
   friend class Game::Systems::MovementSystem;
   friend class Serialization;
   friend struct MovementTestAccess;
+  friend struct MovementSnapshotAccess;
 
   bool has_target{false};
   float target_x{0.0F}, target_y{0.0F};
@@ -2297,6 +2298,7 @@ public:
   bool showcase_active{false};
   std::uint8_t showcase_move{0};
   float showcase_phase{0.0F};
+  auto operator==(const CreaturePresentationComponent&) const -> bool = default;
 };
 
 class ShowcaseRoutineComponent {
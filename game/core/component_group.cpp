@@ -0,0 +1,115 @@
+#include "component_group.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Engine::Core {
+
+namespace {
+
+auto lists_type(std::span<IComponentStorage* const> storages,
+                ComponentTypeId type_id) noexcept -> bool {
+  return std::any_of(storages.begin(), storages.end(), [type_id](const auto* store) {
+    return store->type_id() == type_id;
+  });
+}
+
+auto same_types(std::span<IComponentStorage* const> storages,
+                std::span<const ComponentTypeId> type_ids) noexcept -> bool {
+  return storages.size() == type_ids.size() &&
+         std::all_of(type_ids.begin(), type_ids.end(), [storages](ComponentTypeId id) {
+           return lists_type(storages, id);
+         });
+}
+
+} // namespace
+
+ComponentGroup::ComponentGroup(std::vector<IComponentStorage*> owned,
+                               std::vector<IComponentStorage*> observed)
+    : m_owned(std::move(owned))
+    , m_observed(std::move(observed)) {}
+
+auto ComponentGroup::owns(ComponentTypeId type_id) const noexcept -> bool {
+  return lists_type(m_owned, type_id);
+}
+
+auto ComponentGroup::involves(ComponentTypeId type_id) const noexcept -> bool {
+  return owns(type_id) || lists_type(m_observed, type_id);
+}
+
+auto ComponentGroup::type_ids() const -> std::vector<ComponentTypeId> {
+  std::vector<ComponentTypeId> ids;
+  ids.reserve(m_owned.size() + m_observed.size());
+  for (const auto* stores : {&m_owned, &m_observed}) {
+    for (const IComponentStorage* store : *stores) {
+      ids.push_back(store->type_id());
+    }
+  }
+  return ids;
+}
+
+auto ComponentGroup::covered_by(
+    std::span<const ComponentTypeId> type_ids) const noexcept -> bool {
+  auto const listed = [type_ids](const IComponentStorage* store) {
+    return std::find(type_ids.begin(), type_ids.end(), store->type_id()) !=
+           type_ids.end();
+  };
+  return std::all_of(m_owned.begin(), m_owned.end(), listed) &&
+         std::all_of(m_observed.begin(), m_observed.end(), listed);
+}
+
+auto ComponentGroup::same_layout(
+    std::span<const ComponentTypeId> owned,
+    std::span<const ComponentTypeId> observed) const noexcept -> bool {
+  return same_types(m_owned, owned) && same_types(m_observed, observed);
+}
+
+auto ComponentGroup::is_member(EntityID entity_id) const noexcept -> bool {
+  const std::uint32_t position = m_owned.front()->dense_index_of(entity_id);
+  return position != IComponentStorage::k_absent && position < m_size;
+}
+
+auto ComponentGroup::qualifies(EntityID entity_id) const noexcept -> bool {
+  auto const holds = [entity_id](const IComponentStorage* store) {
+    return store->contains(entity_id);
+  };
+  return std::all_of(m_owned.begin(), m_owned.end(), holds) &&
+         std::all_of(m_observed.begin(), m_observed.end(), holds);
+}
+
+void ComponentGroup::swap_in_owned(EntityID entity_id, std::size_t position) {
+  const auto target = static_cast<std::uint32_t>(position);
+  for (IComponentStorage* store : m_owned) {
+    store->swap_positions(store->dense_index_of(entity_id), target);
+  }
+}
+
+void ComponentGroup::enter(EntityID entity_id) {
+  if (is_member(entity_id) || !qualifies(entity_id)) {
+    return;
+  }
+  swap_in_owned(entity_id, m_size);
+  ++m_size;
+}
+
+void ComponentGroup::leave(EntityID entity_id) {
+  if (!is_member(entity_id)) {
+    return;
+  }
+  --m_size;
+  swap_in_owned(entity_id, m_size);
+}
+
+void ComponentGroup::rebuild() {
+  m_size = 0;
+  const std::span<const EntityID> candidates = m_owned.front()->entities();
+  for (std::size_t position = 0; position < candidates.size(); ++position) {
+    const EntityID entity_id = candidates[position];
+    if (qualifies(entity_id)) {
+      swap_in_owned(entity_id, m_size);
+      ++m_size;
+    }
+  }
+}
+
+} // namespace Engine::Core
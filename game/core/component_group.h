@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "component_registry.h"
+#include "component_storage.h"
+#include "entity_id.h"
+
+namespace Engine::Core {
+
+template <typename... Components>
+struct GroupGet {};
+
+template <typename... Components>
+inline constexpr GroupGet<Components...> group_get{};
+
+class ComponentGroup {
+public:
+  ComponentGroup(std::vector<IComponentStorage*> owned,
+                 std::vector<IComponentStorage*> observed);
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+  [[nodiscard]] auto lead() const noexcept -> const IComponentStorage* {
+    return m_owned.front();
+  }
+
+  [[nodiscard]] auto owns(ComponentTypeId type_id) const noexcept -> bool;
+  [[nodiscard]] auto involves(ComponentTypeId type_id) const noexcept -> bool;
+  [[nodiscard]] auto
+  covered_by(std::span<const ComponentTypeId> type_ids) const noexcept -> bool;
+  // Owned storages first, then observed ones.
+  [[nodiscard]] auto type_ids() const -> std::vector<ComponentTypeId>;
+  [[nodiscard]] auto
+  same_layout(std::span<const ComponentTypeId> owned,
+              std::span<const ComponentTypeId> observed) const noexcept -> bool;
+
+  void enter(EntityID entity_id);
+  void leave(EntityID entity_id);
+  void rebuild();
+  void reset() noexcept { m_size = 0; }
+
+private:
+  [[nodiscard]] auto is_member(EntityID entity_id) const noexcept -> bool;
+  [[nodiscard]] auto qualifies(EntityID entity_id) const noexcept -> bool;
+  void swap_in_owned(EntityID entity_id, std::size_t position);
+
+  std::vector<IComponentStorage*> m_owned;
+  std::vector<IComponentStorage*> m_observed;
+  std::size_t m_size{0};
+};
+
+} // namespace Engine::Core
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -58,6 +59,7 @@ public:
 
   virtual auto erase(EntityID entity_id) -> bool = 0;
   virtual void clear() = 0;
+  virtual void swap_positions(std::uint32_t first, std::uint32_t second) = 0;
 
 protected:
   auto track(EntityID entity_id) -> std::uint32_t {
@@ -80,11 +82,22 @@ protected:
     m_sparse[Handle::index_of(removed)] = k_absent;
   }
 
+  void swap_tracking(std::uint32_t first, std::uint32_t second) {
+    const EntityID first_id = m_dense[first];
+    const EntityID second_id = m_dense[second];
+    m_dense[first] = second_id;
+    m_dense[second] = first_id;
+    m_sparse[Handle::index_of(second_id)] = first;
+    m_sparse[Handle::index_of(first_id)] = second;
+  }
+
   void reset_tracking() {
     m_dense.clear();
     m_sparse.clear();
   }
 
+  void reserve_tracking(std::size_t count) { m_dense.reserve(m_dense.size() + count); }
+
 private:
   ComponentTypeId m_type_id;
   std::type_index m_type;
@@ -131,6 +144,19 @@ public:
     return *component;
   }
 
+  // Grows the dense arrays and pages once for `count` more components.
+  void reserve(std::size_t count) {
+    reserve_tracking(count);
+    m_slot_by_dense.reserve(m_slot_by_dense.size() + count);
+    const std::size_t reused = std::min(count, m_free_slots.size());
+    const std::size_t fresh = count - reused;
+    const std::size_t pages = (m_used_slots + fresh + k_page_size - 1) / k_page_size;
+    m_pages.reserve(pages);
+    while (m_pages.size() < pages) {
+      m_pages.push_back(std::make_unique<Page>());
+    }
+  }
+
   [[nodiscard]] auto try_get(EntityID entity_id) noexcept -> T* {
     const std::uint32_t position = dense_index_of(entity_id);
     return position == k_absent ? nullptr : element(m_slot_by_dense[position]);
@@ -165,6 +191,14 @@ public:
     return true;
   }
 
+  void swap_positions(std::uint32_t first, std::uint32_t second) override {
+    if (first == second) {
+      return;
+    }
+    std::swap(m_slot_by_dense[first], m_slot_by_dense[second]);
+    swap_tracking(first, second);
+  }
+
   void clear() override {
     destroy_all();
     m_slot_by_dense.clear();
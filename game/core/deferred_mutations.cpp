@@ -1,5 +1,8 @@
 #include "deferred_mutations.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "world.h"
 
 namespace Engine::Core {
@@ -14,31 +17,144 @@ void destroy_in(World& world, EntityID entity_id) {
   world.destroy_entity(entity_id);
 }
 
+auto next_mutation_lane() -> std::uint32_t {
+  static std::atomic<std::uint32_t> next{0};
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
 } // namespace Detail
 
 void DeferredMutations::destroy_entity(EntityID entity_id) {
-  m_actions.emplace_back(
-      [entity_id](World& world) { Detail::destroy_in(world, entity_id); });
+  m_ops.push_back(Op{entity_id, 0, 0, 0, OpKind::Destroy});
 }
 
 void DeferredMutations::run(Action action) {
   if (action) {
-    m_actions.emplace_back(std::move(action));
+    m_ops.push_back(Op{NULL_ENTITY,
+                       0,
+                       0,
+                       static_cast<std::uint32_t>(m_actions.size()),
+                       OpKind::Run});
+    m_actions.push_back(std::move(action));
+  }
+}
+
+void DeferredMutations::append(DeferredMutations&& other) {
+  if (other.m_ops.empty()) {
+    return;
   }
+  if (m_ops.empty() && m_lanes.empty() && m_actions.empty()) {
+    m_ops.swap(other.m_ops);
+    m_lanes.swap(other.m_lanes);
+    m_actions.swap(other.m_actions);
+    return;
+  }
+  m_ops.reserve(m_ops.size() + other.m_ops.size());
+  for (Op op : other.m_ops) {
+    if (op.kind == OpKind::Structural) {
+      op.payload = other.m_lanes[op.lane]->transfer(*this, op.lane, op.payload);
+    } else if (op.kind == OpKind::Run) {
+      m_actions.push_back(std::move(other.m_actions[op.payload]));
+      op.payload = static_cast<std::uint32_t>(m_actions.size() - 1U);
+    }
+    m_ops.push_back(op);
+  }
+  other.clear();
 }
 
 void DeferredMutations::apply(World& world) {
-  if (m_actions.empty()) {
+  if (m_ops.empty()) {
     return;
   }
 
-  m_applying.swap(m_actions);
-  m_actions.clear();
+  // Whatever the changes below record waits for the next barrier.
+  m_applying.swap(m_ops);
+  m_applying_lanes.swap(m_lanes);
+  m_applying_actions.swap(m_actions);
+  clear();
 
-  for (Action& action : m_applying) {
-    action(world);
+  std::size_t begin = 0;
+  for (std::size_t index = 0; index < m_applying.size(); ++index) {
+    const Op& op = m_applying[index];
+    if (op.kind != OpKind::Run) {
+      continue;
+    }
+    apply_stretch(world, begin, index);
+    m_applying_actions[op.payload](world);
+    begin = index + 1;
   }
+  apply_stretch(world, begin, m_applying.size());
+
   m_applying.clear();
+  for (auto& lane : m_applying_lanes) {
+    if (lane != nullptr) {
+      lane->reset();
+    }
+  }
+  m_applying_actions.clear();
+}
+
+void DeferredMutations::apply_stretch(World& world, std::size_t begin, std::size_t end) {
+  if (begin == end) {
+    return;
+  }
+
+  m_destroyed.clear();
+  m_sorted.clear();
+  for (std::size_t index = begin; index < end; ++index) {
+    if (m_applying[index].kind == OpKind::Destroy) {
+      m_destroyed.push_back(m_applying[index].entity);
+    }
+  }
+  std::sort(m_destroyed.begin(), m_destroyed.end());
+  m_destroyed.erase(std::unique(m_destroyed.begin(), m_destroyed.end()),
+                    m_destroyed.end());
+
+  for (std::size_t index = begin; index < end; ++index) {
+    const Op& op = m_applying[index];
+    if (op.kind == OpKind::Structural &&
+        !std::binary_search(m_destroyed.begin(), m_destroyed.end(), op.entity)) {
+      m_sorted.push_back(static_cast<std::uint32_t>(index));
+    }
+  }
+  // Ties break on record order, so the changes to one storage keep it.
+  std::sort(m_sorted.begin(),
+            m_sorted.end(),
+            [this](std::uint32_t lhs, std::uint32_t rhs) {
+              ComponentTypeId const left = m_applying[lhs].component;
+              ComponentTypeId const right = m_applying[rhs].component;
+              return left != right ? left < right : lhs < rhs;
+            });
+  for (std::uint32_t const index : m_sorted) {
+    const Op& op = m_applying[index];
+    m_applying_lanes[op.lane]->apply(world, op.entity, op.payload);
+  }
+
+  // Destroys go in the order each entity's first destroy was recorded.
+  m_destroy_done.assign(m_destroyed.size(), 0U);
+  for (std::size_t index = begin; index < end; ++index) {
+    const Op& op = m_applying[index];
+    if (op.kind != OpKind::Destroy) {
+      continue;
+    }
+    auto const slot = static_cast<std::size_t>(
+        std::lower_bound(m_destroyed.begin(), m_destroyed.end(), op.entity) -
+        m_destroyed.begin());
+    if (m_destroy_done[slot] == 0U) {
+      m_destroy_done[slot] = 1U;
+      Detail::destroy_in(world, op.entity);
+    }
+  }
+}
+
+void DeferredMutations::clear() noexcept {
+  m_ops.clear();
+  for (auto& lane : m_lanes) {
+    if (lane != nullptr) {
+      lane->reset();
+    }
+  }
+  m_actions.clear();
 }
 
 } // namespace Engine::Core
@@ -1,11 +1,15 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "component_registry.h"
 #include "entity.h"
 
 namespace Engine::Core {
@@ -16,54 +20,153 @@ namespace Detail {
 
 auto entity_in(World& world, EntityID entity_id) -> Entity*;
 void destroy_in(World& world, EntityID entity_id);
+auto next_mutation_lane() -> std::uint32_t;
+
+template <typename Lane>
+auto mutation_lane() -> std::uint32_t {
+  static std::uint32_t const lane = next_mutation_lane();
+  return lane;
+}
 
 } // namespace Detail
 
+// Structural changes recorded during a phase and applied at its barrier.
+// Component adds keep their constructor arguments in a typed lane per
+// (component, argument list), so recording allocates nothing once the lanes
+// have grown. At apply, adds and removes for an entity destroyed in the same
+// stretch are dropped, the rest are applied grouped by component storage, and
+// the destroys follow. A `run` action is a barrier that nothing is moved
+// across.
 class DeferredMutations {
 public:
   using Action = std::function<void(World&)>;
 
+  DeferredMutations() = default;
+  ~DeferredMutations() = default;
+
+  DeferredMutations(const DeferredMutations&) = delete;
+  auto operator=(const DeferredMutations&) -> DeferredMutations& = delete;
+  DeferredMutations(DeferredMutations&&) noexcept = default;
+  auto operator=(DeferredMutations&&) noexcept -> DeferredMutations& = default;
+
   void destroy_entity(EntityID entity_id);
 
   template <typename T, typename... Args>
   void add_component(EntityID entity_id, Args&&... args) {
-    m_actions.emplace_back(
-        [entity_id,
-         packed = std::make_tuple(std::forward<Args>(args)...)](World& world) mutable {
-          if (Entity* entity = Detail::entity_in(world, entity_id)) {
-            std::apply(
-                [entity](auto&&... unpacked) {
-                  entity->template add_component<T>(
-                      std::forward<decltype(unpacked)>(unpacked)...);
-                },
-                std::move(packed));
-          }
-        });
+    using Lane = AddLane<T, std::decay_t<Args>...>;
+    std::uint32_t const lane = Detail::mutation_lane<Lane>();
+    auto& values = lane_at<Lane>(lane).values;
+    std::uint32_t const payload = static_cast<std::uint32_t>(values.size());
+    values.emplace_back(std::forward<Args>(args)...);
+    m_ops.push_back(
+        Op{entity_id, component_type_id<T>(), lane, payload, OpKind::Structural});
   }
 
   template <typename T>
   void remove_component(EntityID entity_id) {
-    m_actions.emplace_back([entity_id](World& world) {
-      if (Entity* entity = Detail::entity_in(world, entity_id)) {
-        entity->template remove_component<T>();
-      }
-    });
+    using Lane = RemoveLane<T>;
+    std::uint32_t const lane = Detail::mutation_lane<Lane>();
+    lane_at<Lane>(lane);
+    m_ops.push_back(
+        Op{entity_id, component_type_id<T>(), lane, 0, OpKind::Structural});
   }
 
   void run(Action action);
 
-  [[nodiscard]] auto empty() const noexcept -> bool { return m_actions.empty(); }
-  [[nodiscard]] auto pending() const noexcept -> std::size_t {
-    return m_actions.size();
-  }
+  [[nodiscard]] auto empty() const noexcept -> bool { return m_ops.empty(); }
+  [[nodiscard]] auto pending() const noexcept -> std::size_t { return m_ops.size(); }
 
   void apply(World& world);
 
-  void clear() noexcept { m_actions.clear(); }
+  void append(DeferredMutations&& other);
+
+  void clear() noexcept;
 
 private:
+  enum class OpKind : std::uint8_t {
+    Structural,
+    Destroy,
+    Run,
+  };
+
+  struct Op {
+    EntityID entity;
+    ComponentTypeId component;
+    std::uint32_t lane;
+    std::uint32_t payload;
+    OpKind kind;
+  };
+
+  struct LaneBase {
+    virtual ~LaneBase() = default;
+    virtual void apply(World& world, EntityID entity_id, std::uint32_t payload) = 0;
+    virtual auto transfer(DeferredMutations& target, std::uint32_t lane,
+                          std::uint32_t payload) -> std::uint32_t = 0;
+    virtual void reset() noexcept = 0;
+  };
+
+  template <typename T, typename... Args>
+  struct AddLane final : LaneBase {
+    std::vector<std::tuple<Args...>> values;
+
+    void apply(World& world, EntityID entity_id, std::uint32_t payload) override {
+      if (Entity* entity = Detail::entity_in(world, entity_id)) {
+        std::apply(
+            [entity](auto&&... unpacked) {
+              entity->template add_component<T>(
+                  std::forward<decltype(unpacked)>(unpacked)...);
+            },
+            std::move(values[payload]));
+      }
+    }
+    auto transfer(DeferredMutations& target, std::uint32_t lane,
+                  std::uint32_t payload) -> std::uint32_t override {
+      auto& moved_to = target.lane_at<AddLane>(lane).values;
+      moved_to.push_back(std::move(values[payload]));
+      return static_cast<std::uint32_t>(moved_to.size() - 1U);
+    }
+    void reset() noexcept override { values.clear(); }
+  };
+
+  template <typename T>
+  struct RemoveLane final : LaneBase {
+    void apply(World& world, EntityID entity_id, std::uint32_t) override {
+      if (Entity* entity = Detail::entity_in(world, entity_id)) {
+        entity->template remove_component<T>();
+      }
+    }
+    auto transfer(DeferredMutations& target, std::uint32_t lane,
+                  std::uint32_t) -> std::uint32_t override {
+      target.lane_at<RemoveLane>(lane);
+      return 0;
+    }
+    void reset() noexcept override {}
+  };
+
+  template <typename Lane>
+  auto lane_at(std::uint32_t lane) -> Lane& {
+    if (lane >= m_lanes.size()) {
+      m_lanes.resize(lane + 1U);
+    }
+    auto& entry = m_lanes[lane];
+    if (entry == nullptr) {
+      entry = std::make_unique<Lane>();
+    }
+    return static_cast<Lane&>(*entry);
+  }
+
+  void apply_stretch(World& world, std::size_t begin, std::size_t end);
+
+  std::vector<Op> m_ops;
+  std::vector<std::unique_ptr<LaneBase>> m_lanes;
   std::vector<Action> m_actions;
-  std::vector<Action> m_applying;
+
+  std::vector<Op> m_applying;
+  std::vector<std::unique_ptr<LaneBase>> m_applying_lanes;
+  std::vector<Action> m_applying_actions;
+  std::vector<EntityID> m_destroyed;
+  std::vector<std::uint8_t> m_destroy_done;
+  std::vector<std::uint32_t> m_sorted;
 };
 
 } // namespace Engine::Core
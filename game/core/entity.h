@@ -38,7 +38,8 @@ public:
 
   template <typename T>
   [[nodiscard]] auto get_component() const -> const T* {
-    return m_registry == nullptr ? nullptr : m_registry->try_get<T>(m_id);
+    return m_registry == nullptr ? nullptr
+                                 : std::as_const(*m_registry).try_get<T>(m_id);
   }
 
   template <typename T>
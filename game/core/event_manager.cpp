@@ -1,2 +1,75 @@
+#include "event_manager.h"
 
-namespace Engine::Core {}
+#include <atomic>
+#include <mutex>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace Engine::Core::Detail {
+
+namespace {
+
+struct ChannelRegistry {
+  std::mutex mutex;
+  std::vector<std::pair<std::type_index, EventChannelBase*>> channels;
+};
+
+auto channel_registry() -> ChannelRegistry& {
+  static auto* registry = new ChannelRegistry();
+  return *registry;
+}
+
+std::atomic<SubscriptionHandle> g_next_subscription_handle{1};
+std::atomic<bool> g_handlers_retired{false};
+
+} // namespace
+
+void register_event_channel(std::type_index type, EventChannelBase* channel) {
+  auto& registry = channel_registry();
+  std::lock_guard<std::mutex> const lock(registry.mutex);
+  registry.channels.emplace_back(type, channel);
+}
+
+auto find_event_channel(const std::type_index& type) -> EventChannelBase* {
+  auto& registry = channel_registry();
+  std::lock_guard<std::mutex> const lock(registry.mutex);
+  for (const auto& [channel_type, channel] : registry.channels) {
+    if (channel_type == type) {
+      return channel;
+    }
+  }
+  return nullptr;
+}
+
+void for_each_event_channel(const std::function<void(EventChannelBase&)>& visit) {
+  std::vector<EventChannelBase*> channels;
+  {
+    auto& registry = channel_registry();
+    std::lock_guard<std::mutex> const lock(registry.mutex);
+    channels.reserve(registry.channels.size());
+    for (const auto& entry : registry.channels) {
+      channels.push_back(entry.second);
+    }
+  }
+  for (EventChannelBase* channel : channels) {
+    visit(*channel);
+  }
+}
+
+auto next_subscription_handle() -> SubscriptionHandle {
+  return g_next_subscription_handle.fetch_add(1, std::memory_order_relaxed);
+}
+
+void note_handlers_retired() {
+  g_handlers_retired.store(true, std::memory_order_release);
+}
+
+void reclaim_retired_event_handlers() {
+  if (!g_handlers_retired.exchange(false, std::memory_order_acq_rel)) {
+    return;
+  }
+  for_each_event_channel([](EventChannelBase& channel) { channel.reclaim_retired(); });
+}
+
+} // namespace Engine::Core::Detail
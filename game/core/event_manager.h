@@ -3,12 +3,14 @@
 #include <QString>
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <type_traits>
 #include <typeindex>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -31,6 +33,141 @@ using SubscriptionHandle = std::size_t;
 struct EventStats {
   size_t publish_count = 0;
   size_t subscriber_count = 0;
+  size_t retired_handler_lists = 0;
+};
+
+namespace Detail {
+
+class EventChannelBase {
+public:
+  virtual ~EventChannelBase() = default;
+  [[nodiscard]] virtual auto stats() const -> EventStats = 0;
+  virtual void clear() = 0;
+  virtual void reclaim_retired() = 0;
+};
+
+void register_event_channel(std::type_index type, EventChannelBase* channel);
+auto find_event_channel(const std::type_index& type) -> EventChannelBase*;
+void for_each_event_channel(const std::function<void(EventChannelBase&)>& visit);
+auto next_subscription_handle() -> SubscriptionHandle;
+void note_handlers_retired();
+void reclaim_retired_event_handlers();
+
+} // namespace Detail
+
+// One channel per event type. The handlers sit in an immutable list behind an
+// atomic pointer: subscribing builds a new list and swaps it in, and publishing
+// is a single acquire load, with no lock and no allocation. A replaced list is
+// retired rather than freed, since a publish may still be walking it; retired
+// lists are freed at the next phase barrier. Handlers run with no lock held, so
+// they may subscribe or unsubscribe.
+template <typename T>
+class EventChannel final : public Detail::EventChannelBase {
+public:
+  static auto instance() -> EventChannel& {
+    static auto* inst = new EventChannel();
+    return *inst;
+  }
+
+  auto subscribe(EventHandler<T> handler) -> SubscriptionHandle {
+    SubscriptionHandle const handle = Detail::next_subscription_handle();
+    std::lock_guard<std::mutex> const lock(m_write_mutex);
+    auto next = std::make_unique<HandlerList>(*m_live);
+    next->push_back(Entry{handle, std::move(handler)});
+    replace_locked(std::move(next));
+    return handle;
+  }
+
+  auto unsubscribe(SubscriptionHandle handle) -> bool {
+    std::lock_guard<std::mutex> const lock(m_write_mutex);
+    const HandlerList* const handlers = m_live.get();
+    auto const found =
+        std::find_if(handlers->begin(), handlers->end(), [handle](const Entry& e) {
+          return e.handle == handle;
+        });
+    if (found == handlers->end()) {
+      return false;
+    }
+    auto next = std::make_unique<HandlerList>();
+    next->reserve(handlers->size() - 1);
+    for (const Entry& entry : *handlers) {
+      if (entry.handle != handle) {
+        next->push_back(entry);
+      }
+    }
+    replace_locked(std::move(next));
+    return true;
+  }
+
+  void publish(const T& event) {
+    Detail::require_outside_parallel_batch("EventChannel::publish");
+    const HandlerList* const handlers = current();
+    if (handlers->empty()) {
+      return;
+    }
+    m_publish_count.fetch_add(1, std::memory_order_relaxed);
+    for (const Entry& entry : *handlers) {
+      entry.handler(event);
+    }
+  }
+
+  [[nodiscard]] auto subscriber_count() const -> std::size_t {
+    return current()->size();
+  }
+
+  [[nodiscard]] auto stats() const -> EventStats override {
+    std::size_t retired = 0;
+    {
+      std::lock_guard<std::mutex> const lock(m_write_mutex);
+      retired = m_retired.size();
+    }
+    return EventStats{m_publish_count.load(std::memory_order_relaxed),
+                      subscriber_count(),
+                      retired};
+  }
+
+  void clear() override {
+    std::lock_guard<std::mutex> const lock(m_write_mutex);
+    replace_locked(std::make_unique<HandlerList>());
+    m_publish_count.store(0, std::memory_order_relaxed);
+  }
+
+  // Frees the lists replaced since the last call. The caller guarantees that no
+  // publish on this channel is still running.
+  void reclaim_retired() override {
+    std::lock_guard<std::mutex> const lock(m_write_mutex);
+    m_retired.clear();
+  }
+
+private:
+  struct Entry {
+    SubscriptionHandle handle;
+    EventHandler<T> handler;
+  };
+  using HandlerList = std::vector<Entry>;
+
+  EventChannel()
+      : m_live(std::make_unique<const HandlerList>())
+      , m_handlers(m_live.get()) {
+    Detail::register_event_channel(std::type_index(typeid(T)), this);
+  }
+
+  [[nodiscard]] auto current() const -> const HandlerList* {
+    return m_handlers.load(std::memory_order_acquire);
+  }
+
+  void replace_locked(std::unique_ptr<const HandlerList> next) {
+    m_retired.push_back(std::move(m_live));
+    m_live = std::move(next);
+    m_handlers.store(m_live.get(), std::memory_order_release);
+    Detail::note_handlers_retired();
+  }
+
+  mutable std::mutex m_write_mutex;
+  std::unique_ptr<const HandlerList> m_live;
+  std::vector<std::unique_ptr<const HandlerList>> m_retired;
+  std::atomic<const HandlerList*> m_handlers;
+  std::atomic<std::size_t> m_publish_count{0};
 };
 
 class EventManager {
@@ -44,95 +181,34 @@ public:
   template <typename T>
   auto subscribe(EventHandler<T> handler) -> SubscriptionHandle {
     static_assert(std::is_base_of_v<Event, T>, "T must inherit from Event");
-    std::lock_guard<std::mutex> const lock(m_mutex);
-
-    SubscriptionHandle const handle = m_next_handle++;
-    auto wrapper = [handler](const void* event) {
-      handler(*static_cast<const T*>(event));
-    };
-    HandlerEntry const entry{handle, wrapper};
-    m_handlers[std::type_index(typeid(T))].push_back(entry);
-
-    m_stats[std::type_index(typeid(T))].subscriber_count++;
-
-    return handle;
+    return EventChannel<T>::instance().subscribe(std::move(handler));
   }
 
   template <typename T>
   void unsubscribe(SubscriptionHandle handle) {
     static_assert(std::is_base_of_v<Event, T>, "T must inherit from Event");
-    std::lock_guard<std::mutex> const lock(m_mutex);
-
-    auto it = m_handlers.find(std::type_index(typeid(T)));
-    if (it != m_handlers.end()) {
-      auto& handlers = it->second;
-      auto size_before = handlers.size();
-      handlers.erase(std::remove_if(handlers.begin(),
-                                    handlers.end(),
-                                    [handle](const HandlerEntry& e) {
-                                      return e.handle == handle;
-                                    }),
-                     handlers.end());
-
-      if (handlers.size() < size_before) {
-        m_stats[std::type_index(typeid(T))].subscriber_count--;
-      }
-    }
+    EventChannel<T>::instance().unsubscribe(handle);
   }
 
   template <typename T>
   void publish(const T& event) {
     static_assert(std::is_base_of_v<Event, T>, "T must inherit from Event");
-    std::vector<HandlerEntry> handlers_copy;
-
-    {
-      std::lock_guard<std::mutex> const lock(m_mutex);
-      auto it = m_handlers.find(std::type_index(typeid(T)));
-      if (it != m_handlers.end()) {
-        handlers_copy = it->second;
-        m_stats[std::type_index(typeid(T))].publish_count++;
-      }
-    }
-
-    for (const auto& entry : handlers_copy) {
-      entry.handler(&event);
-    }
+    EventChannel<T>::instance().publish(event);
   }
 
   auto get_stats(const std::type_index& event_type) const -> EventStats {
-    std::lock_guard<std::mutex> const lock(m_mutex);
-    auto it = m_stats.find(event_type);
-    if (it != m_stats.end()) {
-      return it->second;
-    }
-    return EventStats{};
+    auto const* channel = Detail::find_event_channel(event_type);
+    return channel != nullptr ? channel->stats() : EventStats{};
   }
 
   auto get_subscriber_count(const std::type_index& event_type) const -> size_t {
-    std::lock_guard<std::mutex> const lock(m_mutex);
-    auto it = m_handlers.find(event_type);
-    if (it != m_handlers.end()) {
-      return it->second.size();
-    }
-    return 0;
+    return get_stats(event_type).subscriber_count;
   }
 
   void clear_all_subscriptions() {
-    std::lock_guard<std::mutex> const lock(m_mutex);
-    m_handlers.clear();
-    m_stats.clear();
+    Detail::for_each_event_channel(
+        [](Detail::EventChannelBase& channel) { channel.clear(); });
   }
-
-private:
-  struct HandlerEntry {
-    SubscriptionHandle handle;
-    std::function<void(const void*)> handler;
-  };
-
-  mutable std::mutex m_mutex;
-  std::unordered_map<std::type_index, std::vector<HandlerEntry>> m_handlers;
-  std::unordered_map<std::type_index, EventStats> m_stats;
-  SubscriptionHandle m_next_handle = 1;
 };
 
 template <typename T>
@@ -142,7 +218,7 @@ public:
       : m_handle(0) {}
 
   ScopedEventSubscription(EventHandler<T> handler)
-      : m_handle(EventManager::instance().subscribe<T>(handler)) {}
+      : m_handle(EventManager::instance().subscribe<T>(std::move(handler))) {}
 
   ~ScopedEventSubscription() { unsubscribe(); }
 
@@ -0,0 +1,50 @@
+#include "event_queue.h"
+
+#include <atomic>
+
+namespace Engine::Core {
+
+namespace Detail {
+
+auto next_event_slot() -> std::uint32_t {
+  static std::atomic<std::uint32_t> next{0};
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace Detail
+
+void EventQueue::deliver() {
+  // Indexed rather than iterated: a handler may queue more events, which are
+  // delivered in this same pass.
+  for (std::size_t index = 0; index < m_order.size(); ++index) {
+    m_buffers[m_order[index]]->publish_next();
+  }
+  clear();
+}
+
+void EventQueue::append(EventQueue&& other) {
+  if (other.m_order.empty()) {
+    return;
+  }
+  if (m_order.empty() && m_buffers.empty()) {
+    m_buffers.swap(other.m_buffers);
+    m_order.swap(other.m_order);
+    return;
+  }
+  m_order.reserve(m_order.size() + other.m_order.size());
+  for (std::uint32_t const slot : other.m_order) {
+    other.m_buffers[slot]->move_next_into(*this);
+  }
+  other.clear();
+}
+
+void EventQueue::clear() noexcept {
+  for (auto& buffer : m_buffers) {
+    if (buffer != nullptr) {
+      buffer->reset();
+    }
+  }
+  m_order.clear();
+}
+
+} // namespace Engine::Core
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "event_manager.h"
+
+namespace Engine::Core {
+
+namespace Detail {
+
+auto next_event_slot() -> std::uint32_t;
+
+template <typename T>
+auto event_slot() -> std::uint32_t {
+  static std::uint32_t const slot = next_event_slot();
+  return slot;
+}
+
+} // namespace Detail
+
+// Events recorded during a phase and published together at its barrier. Each
+// event type keeps its own typed buffer whose capacity survives delivery, so a
+// steady stream of pushes stops allocating after the first few ticks. Events
+// are published in push order across all types.
+class EventQueue {
+public:
+  EventQueue() = default;
+  ~EventQueue() = default;
+
+  EventQueue(const EventQueue&) = delete;
+  auto operator=(const EventQueue&) -> EventQueue& = delete;
+  EventQueue(EventQueue&&) noexcept = default;
+  auto operator=(EventQueue&&) noexcept -> EventQueue& = default;
+
+  template <typename T>
+  void push(T&& event) {
+    using Stored = std::remove_cvref_t<T>;
+    static_assert(std::is_base_of_v<Event, Stored>, "T must inherit from Event");
+    std::uint32_t const slot = Detail::event_slot<Stored>();
+    buffer<Stored>(slot).events.push_back(std::forward<T>(event));
+    m_order.push_back(slot);
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return m_order.empty(); }
+  [[nodiscard]] auto pending() const noexcept -> std::size_t { return m_order.size(); }
+
+  void deliver();
+
+  void append(EventQueue&& other);
+
+  void clear() noexcept;
+
+private:
+  struct BufferBase {
+    virtual ~BufferBase() = default;
+    virtual void publish_next() = 0;
+    virtual void move_next_into(EventQueue& target) = 0;
+    virtual void reset() noexcept = 0;
+  };
+
+  template <typename T>
+  struct Buffer final : BufferBase {
+    std::vector<T> events;
+    std::size_t cursor{0};
+
+    void publish_next() override {
+      // Moved out first: a handler may push another T and grow the vector.
+      T const event = std::move(events[cursor++]);
+      EventChannel<T>::instance().publish(event);
+    }
+    void move_next_into(EventQueue& target) override {
+      target.push(std::move(events[cursor++]));
+    }
+    void reset() noexcept override {
+      events.clear();
+      cursor = 0;
+    }
+  };
+
+  template <typename T>
+  auto buffer(std::uint32_t slot) -> Buffer<T>& {
+    if (slot >= m_buffers.size()) {
+      m_buffers.resize(slot + 1U);
+    }
+    auto& entry = m_buffers[slot];
+    if (entry == nullptr) {
+      entry = std::make_unique<Buffer<T>>();
+    }
+    return static_cast<Buffer<T>&>(*entry);
+  }
+
+  std::vector<std::unique_ptr<BufferBase>> m_buffers;
+  std::vector<std::uint32_t> m_order;
+};
+
+} // namespace Engine::Core
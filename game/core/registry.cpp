@@ -1,31 +1,149 @@
 #include "registry.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 
 namespace Engine::Core {
 
+namespace {
+
+thread_local std::uint64_t t_borrowed_lock_token = 0;
+
+} // namespace
+
 auto this_thread_lock_token() noexcept -> std::uint64_t {
+  if (t_borrowed_lock_token != 0) {
+    return t_borrowed_lock_token;
+  }
   static std::atomic<std::uint64_t> next_token{1};
   static const thread_local std::uint64_t token =
       next_token.fetch_add(1, std::memory_order_relaxed);
   return token;
 }
 
+namespace Detail {
+
+BorrowedLockToken::BorrowedLockToken(std::uint64_t token) noexcept
+    : m_previous(t_borrowed_lock_token) {
+  t_borrowed_lock_token = token;
+}
+
+BorrowedLockToken::~BorrowedLockToken() {
+  t_borrowed_lock_token = m_previous;
+}
+
+auto in_parallel_batch() noexcept -> bool {
+  return t_borrowed_lock_token != 0;
+}
+
+void abort_inside_parallel_batch(const char* operation) noexcept {
+  std::fprintf(stderr,
+               "%s called from a parallel system batch. Record structural changes "
+               "on World::deferred() and events on World::events().\n",
+               operation);
+  std::abort();
+}
+
+} // namespace Detail
+
 Registry::Registry() {
   m_slots.emplace_back();
+  m_written_slots.resize(m_slots.size());
 }
 
 Registry::~Registry() = default;
 
 void Registry::detach_all_components(EntityID entity_id) {
   for (auto& store : m_storages) {
-    if (store != nullptr) {
+    if (store != nullptr && store->contains(entity_id)) {
+      leave_groups(entity_id, store->type_id());
       store->erase(entity_id);
     }
   }
 }
 
+auto Registry::attach_group(std::vector<IComponentStorage*> owned,
+                            std::vector<IComponentStorage*> observed)
+    -> const ComponentGroup* {
+  std::vector<ComponentTypeId> owned_ids;
+  std::vector<ComponentTypeId> observed_ids;
+  for (const IComponentStorage* store : owned) {
+    owned_ids.push_back(store->type_id());
+  }
+  for (const IComponentStorage* store : observed) {
+    observed_ids.push_back(store->type_id());
+  }
+
+  for (const auto& existing : m_groups) {
+    if (existing->same_layout(owned_ids, observed_ids)) {
+      return existing.get();
+    }
+    const bool overlaps = std::any_of(
+        owned_ids.begin(), owned_ids.end(), [&existing](ComponentTypeId type_id) {
+          return existing->owns(type_id);
+        });
+    if (overlaps) {
+      return nullptr;
+    }
+  }
+
+  auto group = std::make_unique<ComponentGroup>(std::move(owned), std::move(observed));
+  ComponentGroup* attached = group.get();
+  for (const auto& ids : {owned_ids, observed_ids}) {
+    for (const ComponentTypeId type_id : ids) {
+      if (m_groups_by_type.size() <= type_id) {
+        m_groups_by_type.resize(static_cast<std::size_t>(type_id) + 1U);
+      }
+      m_groups_by_type[type_id].push_back(attached);
+    }
+  }
+  m_groups.push_back(std::move(group));
+  attached->rebuild();
+  return attached;
+}
+
+auto Registry::find_group(std::span<const ComponentTypeId> type_ids) const
+    -> const ComponentGroup* {
+  const ComponentGroup* best = nullptr;
+  for (const auto& group : m_groups) {
+    if (group->covered_by(type_ids) &&
+        (best == nullptr || group->size() < best->size())) {
+      best = group.get();
+    }
+  }
+  return best;
+}
+
+auto Registry::group_layouts() const -> std::vector<std::vector<ComponentTypeId>> {
+  std::vector<std::vector<ComponentTypeId>> layouts;
+  layouts.reserve(m_groups.size());
+  for (const auto& group : m_groups) {
+    layouts.push_back(group->type_ids());
+  }
+  return layouts;
+}
+
+void Registry::enter_groups(EntityID entity_id, ComponentTypeId type_id) {
+  if (type_id >= m_groups_by_type.size()) {
+    return;
+  }
+  for (ComponentGroup* group : m_groups_by_type[type_id]) {
+    group->enter(entity_id);
+  }
+}
+
+void Registry::leave_groups(EntityID entity_id, ComponentTypeId type_id) {
+  if (type_id >= m_groups_by_type.size()) {
+    return;
+  }
+  for (ComponentGroup* group : m_groups_by_type[type_id]) {
+    group->leave(entity_id);
+  }
+}
+
 auto Registry::create_entity() -> EntityID {
+  Detail::require_outside_parallel_batch("Registry::create_entity");
   const Lock lock(*this);
 
   std::uint32_t index = 0;
@@ -35,15 +153,19 @@ auto Registry::create_entity() -> EntityID {
   } else {
     index = static_cast<std::uint32_t>(m_slots.size());
     m_slots.emplace_back();
+    m_written_slots.resize(m_slots.size());
   }
 
   Slot& slot = m_slots[index];
   slot.alive = true;
   ++m_live_count;
-  return Handle::make(index, slot.generation);
+  const EntityID entity_id = Handle::make(index, slot.generation);
+  mark_written(entity_id);
+  return entity_id;
 }
 
 auto Registry::create_entity_with_id(EntityID entity_id) -> EntityID {
+  Detail::require_outside_parallel_batch("Registry::create_entity_with_id");
   const Lock lock(*this);
   if (entity_id == NULL_ENTITY) {
     return NULL_ENTITY;
@@ -57,6 +179,7 @@ auto Registry::create_entity_with_id(EntityID entity_id) -> EntityID {
   if (m_slots.size() <= index) {
     const auto previous_size = m_slots.size();
     m_slots.resize(static_cast<std::size_t>(index) + 1U);
+    m_written_slots.resize(m_slots.size());
     for (std::size_t i = previous_size; i < index; ++i) {
       m_free_slots.push_back(static_cast<std::uint32_t>(i));
     }
@@ -74,10 +197,12 @@ auto Registry::create_entity_with_id(EntityID entity_id) -> EntityID {
   slot.generation = Handle::generation_of(entity_id);
   slot.alive = true;
   ++m_live_count;
+  mark_written(entity_id);
   return entity_id;
 }
 
 auto Registry::destroy_entity(EntityID entity_id) -> bool {
+  Detail::require_outside_parallel_batch("Registry::destroy_entity");
   const Lock lock(*this);
 
   const std::uint32_t index = Handle::index_of(entity_id);
@@ -90,6 +215,7 @@ auto Registry::destroy_entity(EntityID entity_id) -> bool {
   }
 
   detach_all_components(entity_id);
+  mark_written(entity_id);
   slot.alive = false;
   ++slot.generation;
   m_free_slots.push_back(index);
@@ -105,6 +231,9 @@ void Registry::clear() {
       m_slots[i].alive = false;
       ++m_slots[i].generation;
     }
+    if (m_write_epoch != 0) {
+      note_slot_written(static_cast<std::uint32_t>(i));
+    }
   }
   m_free_slots.clear();
   for (std::size_t i = m_slots.size(); i-- > 1;) {
@@ -117,6 +246,24 @@ void Registry::clear() {
       store->clear();
     }
   }
+  for (auto& group : m_groups) {
+    group->reset();
+  }
+}
+
+void Registry::track_writes(ComponentTypeId type_id) {
+  if (m_write_tracked.size() <= type_id) {
+    m_write_tracked.resize(static_cast<std::size_t>(type_id) + 1U, 0U);
+  }
+  m_write_tracked[type_id] = 1U;
+}
+
+void Registry::advance_write_epoch(std::uint64_t epoch,
+                                   std::vector<std::uint32_t>& written) {
+  const std::size_t count = m_written_count.exchange(0, std::memory_order_relaxed);
+  written.assign(m_written_slots.begin(),
+                 m_written_slots.begin() + static_cast<std::ptrdiff_t>(count));
+  m_write_epoch = epoch;
 }
 
 void Registry::reserve_indices_below(std::uint32_t index) {
@@ -126,6 +273,7 @@ void Registry::reserve_indices_below(std::uint32_t index) {
   }
   const auto previous_size = m_slots.size();
   m_slots.resize(index);
+  m_written_slots.resize(m_slots.size());
   for (std::size_t i = previous_size; i < index; ++i) {
     m_free_slots.push_back(static_cast<std::uint32_t>(i));
   }
@@ -1,16 +1,19 @@
 #pragma once
 
 #include <atomic>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <span>
+#include <type_traits>
 #include <typeindex>
 #include <utility>
 #include <vector>
 
+#include "component_group.h"
 #include "component_registry.h"
 #include "component_storage.h"
 #include "entity_id.h"
@@ -21,6 +24,37 @@ namespace Engine::Core {
 
 namespace Detail {
 
+class BorrowedLockToken {
+public:
+  explicit BorrowedLockToken(std::uint64_t token) noexcept;
+  ~BorrowedLockToken();
+
+  BorrowedLockToken(const BorrowedLockToken&) = delete;
+  BorrowedLockToken(BorrowedLockToken&&) = delete;
+  auto operator=(const BorrowedLockToken&) -> BorrowedLockToken& = delete;
+  auto operator=(BorrowedLockToken&&) -> BorrowedLockToken& = delete;
+
+private:
+  std::uint64_t m_previous;
+};
+
+// True on a thread running one job of a parallel system batch. Such a job may
+// only touch the components its system declared; adds, removes, entity
+// creation and events go through World::deferred() and World::events().
+[[nodiscard]] auto in_parallel_batch() noexcept -> bool;
+
+// Prints `operation` and aborts. Kept out of line so the check below stays
+// small enough to inline into every structural edit.
+[[noreturn]] void abort_inside_parallel_batch(const char* operation) noexcept;
+
+// Checked in release builds too: a structural edit from a batch job would race
+// the other jobs without any error.
+inline void require_outside_parallel_batch(const char* operation) noexcept {
+  if (in_parallel_batch()) [[unlikely]] {
+    abort_inside_parallel_batch(operation);
+  }
+}
+
 class ScopedRegistryLock {
 public:
   ScopedRegistryLock(std::recursive_mutex& mutex, std::atomic<std::uint64_t>& owner)
@@ -106,19 +140,59 @@ public:
       return nullptr;
     }
     const Detail::ScopedRegistryLock lock(m_mutex, m_lock_owner);
+    if (auto* existing = find_storage<T>();
+        existing != nullptr && existing->contains(entity_id)) {
+      T& component = existing->emplace(entity_id, std::forward<Args>(args)...);
+      note_writes<T>(entity_id);
+      return &component;
+    }
+    Detail::require_outside_parallel_batch("Registry::emplace of a new component");
     auto& store = storage<T>();
-    const bool existed = store.contains(entity_id);
     T& component = store.emplace(entity_id, std::forward<Args>(args)...);
-    if (!existed) {
-      notify(entity_id, store, true);
+    if (!m_groups.empty()) {
+      enter_groups(entity_id, store.type_id());
     }
+    mark_written(entity_id);
+    notify(entity_id, store, true);
     return &component;
   }
 
+  // Adds one component per entity under a single lock, moving from `values`.
+  // Used by snapshot loads, which fill a whole column at a time.
+  template <typename T>
+  void emplace_bulk(std::span<const EntityID> entity_ids, std::span<T> values) {
+    assert(entity_ids.size() == values.size() && "one value per entity");
+    Detail::require_outside_parallel_batch("Registry::emplace_bulk");
+    const Detail::ScopedRegistryLock lock(m_mutex, m_lock_owner);
+    auto& store = storage<T>();
+    store.reserve(entity_ids.size());
+    for (std::size_t i = 0; i < entity_ids.size(); ++i) {
+      const EntityID entity_id = entity_ids[i];
+      if (!is_alive(entity_id)) {
+        continue;
+      }
+      const bool added = !store.contains(entity_id);
+      store.emplace(entity_id, std::move(values[i]));
+      if (!added) {
+        note_writes<T>(entity_id);
+        continue;
+      }
+      if (!m_groups.empty()) {
+        enter_groups(entity_id, store.type_id());
+      }
+      mark_written(entity_id);
+      notify(entity_id, store, true);
+    }
+  }
+
   template <typename T>
   [[nodiscard]] auto try_get(EntityID entity_id) noexcept -> T* {
     auto* store = find_storage<T>();
-    return store == nullptr ? nullptr : store->try_get(entity_id);
+    T* component = store == nullptr ? nullptr : store->try_get(entity_id);
+    if (component != nullptr) {
+      note_writes<T>(entity_id);
+    }
+    return component;
   }
 
   template <typename T>
@@ -139,14 +213,85 @@ public:
     if (store == nullptr || !store->contains(entity_id)) {
       return false;
     }
+    Detail::require_outside_parallel_batch("Registry::remove");
     const Detail::ScopedRegistryLock lock(m_mutex, m_lock_owner);
+    if (!m_groups.empty()) {
+      leave_groups(entity_id, store->type_id());
+    }
     if (!store->erase(entity_id)) {
       return false;
     }
+    mark_written(entity_id);
     notify(entity_id, *store, false);
     return true;
   }
 
+  template <typename... Owned, typename... Observed>
+  auto group(GroupGet<Observed...> = {}) -> const ComponentGroup* {
+    static_assert(sizeof...(Owned) > 0, "a group must own at least one storage");
+    Detail::require_outside_parallel_batch("Registry::group");
+    const Lock lock(*this);
+    return attach_group({&storage<Owned>()...}, {&storage<Observed>()...});
+  }
+
+  [[nodiscard]] auto
+  find_group(std::span<const ComponentTypeId> type_ids) const -> const ComponentGroup*;
+
+  [[nodiscard]] auto group_count() const noexcept -> std::size_t {
+    return m_groups.size();
+  }
+
+  // The storages of each attached group, for the system scheduler.
+  [[nodiscard]] auto group_layouts() const -> std::vector<std::vector<ComponentTypeId>>;
+
+  template <typename T>
+  void track_writes() {
+    track_writes(component_type_id<T>());
+  }
+
+  void track_writes(ComponentTypeId type_id);
+
+  void set_write_epoch(std::uint64_t epoch) noexcept {
+    m_write_epoch = epoch;
+    m_written_count.store(0, std::memory_order_relaxed);
+  }
+
+  // Starts a new write epoch and hands back the slots written during the one
+  // that ended, each listed once however often it was written.
+  void advance_write_epoch(std::uint64_t epoch, std::vector<std::uint32_t>& written);
+
+  [[nodiscard]] auto write_epoch() const noexcept -> std::uint64_t {
+    return m_write_epoch;
+  }
+
+  [[nodiscard]] auto written_at(std::uint32_t index) const noexcept -> std::uint64_t {
+    if (index >= m_slots.size()) {
+      return 0;
+    }
+    return std::atomic_ref<std::uint64_t>(m_slots[index].written_at)
+        .load(std::memory_order_relaxed);
+  }
+
+  void mark_written(EntityID entity_id) noexcept {
+    const std::uint32_t index = Handle::index_of(entity_id);
+    if (m_write_epoch == 0 || index >= m_slots.size()) {
+      return;
+    }
+    note_slot_written(index);
+  }
+
+  template <typename... Components>
+  void note_writes(EntityID entity_id) noexcept {
+    if (m_write_epoch == 0) {
+      return;
+    }
+    if (((!std::is_const_v<Components> &&
+          tracks_writes(component_type_id<std::remove_const_t<Components>>())) ||
+         ...)) {
+      mark_written(entity_id);
+    }
+  }
+
   template <typename T>
   [[nodiscard]] auto storage() -> ComponentStorage<T>& {
     const ComponentTypeId type_id = component_type_id<T>();
@@ -203,8 +348,25 @@ private:
   struct Slot {
     std::uint32_t generation = 0;
     bool alive = false;
+    mutable std::uint64_t written_at = 0;
   };
 
+  // Parallel batches mark writes concurrently. The exchange lets exactly one
+  // of them append the slot, and the list is sized to the slot table, which
+  // only grows outside batches.
+  void note_slot_written(std::uint32_t index) noexcept {
+    const std::uint64_t previous =
+        std::atomic_ref<std::uint64_t>(m_slots[index].written_at)
+            .exchange(m_write_epoch, std::memory_order_relaxed);
+    if (previous != m_write_epoch) {
+      m_written_slots[m_written_count.fetch_add(1, std::memory_order_relaxed)] = index;
+    }
+  }
+
+  [[nodiscard]] auto tracks_writes(ComponentTypeId type_id) const noexcept -> bool {
+    return type_id < m_write_tracked.size() && m_write_tracked[type_id] != 0U;
+  }
+
   void notify(EntityID entity_id, const IComponentStorage& store, bool added) {
     if (m_component_change_callback) {
       m_component_change_callback(entity_id, store.type_id(), store.type(), added);
@@ -212,12 +374,22 @@ private:
   }
 
   void detach_all_components(EntityID entity_id);
+  auto attach_group(std::vector<IComponentStorage*> owned,
+                    std::vector<IComponentStorage*> observed) -> const ComponentGroup*;
+  void enter_groups(EntityID entity_id, ComponentTypeId type_id);
+  void leave_groups(EntityID entity_id, ComponentTypeId type_id);
 
   std::vector<Slot> m_slots;
   std::vector<std::uint32_t> m_free_slots;
   std::size_t m_live_count = 0;
   std::vector<std::unique_ptr<IComponentStorage>> m_storages;
+  std::vector<std::unique_ptr<ComponentGroup>> m_groups;
+  std::vector<std::vector<ComponentGroup*>> m_groups_by_type;
   ComponentChangeCallback m_component_change_callback;
+  std::vector<std::uint8_t> m_write_tracked;
+  std::uint64_t m_write_epoch = 0;
+  std::vector<std::uint32_t> m_written_slots;
+  std::atomic<std::size_t> m_written_count{0};
 
   mutable std::recursive_mutex m_mutex;
   mutable std::atomic<std::uint64_t> m_lock_owner{0};
@@ -0,0 +1,143 @@
+#include "system_executor.h"
+
+#include <utility>
+
+namespace Engine::Core {
+
+SystemExecutor::SystemExecutor(std::size_t worker_count) {
+  m_queues.reserve(worker_count + 1U);
+  for (std::size_t i = 0; i <= worker_count; ++i) {
+    m_queues.push_back(std::make_unique<Queue>());
+  }
+  m_workers.reserve(worker_count);
+  for (std::size_t i = 0; i < worker_count; ++i) {
+    m_workers.emplace_back([this, queue_index = i + 1U] { worker_loop(queue_index); });
+  }
+}
+
+SystemExecutor::~SystemExecutor() {
+  {
+    std::lock_guard const lock(m_mutex);
+    m_stop = true;
+  }
+  m_start.notify_all();
+  for (auto& worker : m_workers) {
+    worker.join();
+  }
+}
+
+auto SystemExecutor::pop_local(std::size_t queue_index, std::size_t& job) -> bool {
+  Queue& queue = *m_queues[queue_index];
+  std::lock_guard const lock(queue.mutex);
+  if (queue.jobs.empty()) {
+    return false;
+  }
+  job = queue.jobs.back();
+  queue.jobs.pop_back();
+  return true;
+}
+
+auto SystemExecutor::steal(std::size_t thief, std::size_t& job) -> bool {
+  std::size_t const count = m_queues.size();
+  for (std::size_t offset = 1; offset < count; ++offset) {
+    Queue& victim = *m_queues[(thief + offset) % count];
+    std::lock_guard const lock(victim.mutex);
+    if (victim.jobs.empty()) {
+      continue;
+    }
+    job = victim.jobs.front();
+    victim.jobs.pop_front();
+    m_steals.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+void SystemExecutor::execute(std::size_t job) {
+  try {
+    (*m_job)(job);
+  } catch (...) {
+    std::lock_guard const lock(m_mutex);
+    if (m_failure == nullptr) {
+      m_failure = std::current_exception();
+    }
+  }
+  if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1U) {
+    std::lock_guard const lock(m_mutex);
+    m_done.notify_all();
+  }
+}
+
+void SystemExecutor::drain(std::size_t queue_index) {
+  std::size_t job = 0;
+  while (pop_local(queue_index, job) || steal(queue_index, job)) {
+    execute(job);
+  }
+}
+
+void SystemExecutor::worker_loop(std::size_t queue_index) {
+  std::size_t seen_generation = 0;
+  for (;;) {
+    {
+      std::unique_lock lock(m_mutex);
+      m_start.wait(lock, [&] { return m_stop || m_generation != seen_generation; });
+      if (m_stop) {
+        return;
+      }
+      seen_generation = m_generation;
+      if (m_job == nullptr) {
+        continue;
+      }
+      ++m_active_workers;
+    }
+    drain(queue_index);
+    {
+      std::lock_guard const lock(m_mutex);
+      --m_active_workers;
+    }
+    m_done.notify_all();
+  }
+}
+
+void SystemExecutor::run(std::size_t job_count, const Job& job) {
+  if (job_count == 0) {
+    return;
+  }
+  if (m_workers.empty() || job_count == 1U) {
+    for (std::size_t i = 0; i < job_count; ++i) {
+      job(i);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard const lock(m_mutex);
+    m_job = &job;
+    m_failure = nullptr;
+    m_remaining.store(job_count, std::memory_order_release);
+    for (std::size_t i = 0; i < job_count; ++i) {
+      Queue& queue = *m_queues[i % m_queues.size()];
+      std::lock_guard const queue_lock(queue.mutex);
+      queue.jobs.push_back(i);
+    }
+    ++m_generation;
+  }
+  m_start.notify_all();
+  drain(0);
+
+  std::exception_ptr failure;
+  {
+    std::unique_lock lock(m_mutex);
+    m_done.wait(lock, [&] {
+      return m_remaining.load(std::memory_order_acquire) == 0U &&
+             m_active_workers == 0U;
+    });
+    m_job = nullptr;
+    failure = std::exchange(m_failure, nullptr);
+  }
+  if (failure != nullptr) {
+    std::rethrow_exception(failure);
+  }
+}
+
+} // namespace Engine::Core
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine::Core {
+
+class SystemExecutor {
+public:
+  using Job = std::function<void(std::size_t)>;
+
+  explicit SystemExecutor(std::size_t worker_count);
+  ~SystemExecutor();
+
+  SystemExecutor(const SystemExecutor&) = delete;
+  SystemExecutor(SystemExecutor&&) = delete;
+  auto operator=(const SystemExecutor&) -> SystemExecutor& = delete;
+  auto operator=(SystemExecutor&&) -> SystemExecutor& = delete;
+
+  [[nodiscard]] auto worker_count() const noexcept -> std::size_t {
+    return m_workers.size();
+  }
+
+  [[nodiscard]] auto steals() const noexcept -> std::uint64_t {
+    return m_steals.load(std::memory_order_relaxed);
+  }
+
+  void run(std::size_t job_count, const Job& job);
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::size_t> jobs;
+  };
+
+  void worker_loop(std::size_t queue_index);
+  void drain(std::size_t queue_index);
+  auto pop_local(std::size_t queue_index, std::size_t& job) -> bool;
+  auto steal(std::size_t thief, std::size_t& job) -> bool;
+  void execute(std::size_t job);
+
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_start;
+  std::condition_variable m_done;
+  const Job* m_job{nullptr};
+  std::atomic<std::size_t> m_remaining{0};
+  std::atomic<std::uint64_t> m_steals{0};
+  std::size_t m_generation{0};
+  std::size_t m_active_workers{0};
+  std::exception_ptr m_failure;
+  bool m_stop{false};
+};
+
+} // namespace Engine::Core
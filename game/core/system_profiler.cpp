@@ -59,6 +59,22 @@ void SystemProfiler::end_tick(std::uint64_t total_us) {
   ++m_ticks;
 }
 
+void SystemProfiler::record_render_publication(std::size_t slot_count,
+                                               std::size_t visited,
+                                               std::size_t copied,
+                                               bool full_sweep) {
+  if (!m_enabled) {
+    return;
+  }
+  ++m_render_publication.publications;
+  m_render_publication.slot_count = slot_count;
+  m_render_publication.visited = visited;
+  m_render_publication.copied = copied;
+  m_render_publication.full_sweep = full_sweep;
+  m_render_publication.total_visited += visited;
+  m_render_publication.total_copied += copied;
+}
+
 void SystemProfiler::note_collect_call_site(const char* file,
                                             unsigned line,
                                             std::size_t entities) {
@@ -85,6 +101,7 @@ void SystemProfiler::clear() {
   m_systems.clear();
   m_collect_call_sites.clear();
   m_last_tick = {};
+  m_render_publication = {};
   m_ticks = 0;
 }
 
@@ -177,6 +194,18 @@ auto SystemProfiler::format_report() const -> std::string {
                 spatial_efficiency);
   out += line;
 
+  if (m_render_publication.publications > 0) {
+    const RenderPublication& publication = m_render_publication;
+    std::snprintf(line,
+                  sizeof(line),
+                  "  render snapshot: visited %llu of %llu slots, copied %llu%s\n",
+                  static_cast<unsigned long long>(publication.visited),
+                  static_cast<unsigned long long>(publication.slot_count),
+                  static_cast<unsigned long long>(publication.copied),
+                  publication.full_sweep ? " (full sweep)" : "");
+    out += line;
+  }
+
   return out;
 }
 
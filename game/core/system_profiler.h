@@ -54,6 +54,16 @@ public:
     std::uint64_t entities{0};
   };
 
+  struct RenderPublication {
+    std::uint64_t publications{0};
+    std::size_t slot_count{0};
+    std::size_t visited{0};
+    std::size_t copied{0};
+    bool full_sweep{false};
+    std::uint64_t total_visited{0};
+    std::uint64_t total_copied{0};
+  };
+
   struct TickSummary {
     std::uint64_t tick_index{0};
     std::uint64_t total_us{0};
@@ -71,6 +81,14 @@ public:
                      const QueryCounters& delta);
   void end_tick(std::uint64_t total_us);
 
+  void record_render_publication(std::size_t slot_count,
+                                 std::size_t visited,
+                                 std::size_t copied,
+                                 bool full_sweep);
+  [[nodiscard]] auto render_publication() const -> const RenderPublication& {
+    return m_render_publication;
+  }
+
   [[nodiscard]] auto systems() const -> const std::vector<SystemRecord>& {
     return m_systems;
   }
@@ -94,6 +112,7 @@ private:
   std::vector<SystemRecord> m_systems;
   std::map<std::string, CallSite> m_collect_call_sites;
   TickSummary m_last_tick;
+  RenderPublication m_render_publication;
 };
 
 } // namespace Engine::Core
@@ -41,6 +41,27 @@ auto intersects(const std::vector<ComponentTypeId>& lhs,
   return false;
 }
 
+void widen(std::vector<ComponentTypeId>& ids,
+           std::span<const std::vector<ComponentTypeId>> linked) {
+  const std::vector<ComponentTypeId> declared = ids;
+  for (const auto& unit : linked) {
+    if (intersects(declared, unit)) {
+      ids.insert(ids.end(), unit.begin(), unit.end());
+    }
+  }
+}
+
+auto widened(const SystemAccess& access,
+             std::span<const std::vector<ComponentTypeId>> linked) -> SystemAccess {
+  // Widening the writes is enough: a reader of any linked storage then meets
+  // the writer on that storage.
+  SystemAccess result = access;
+  if (!result.exclusive) {
+    widen(result.writes, linked);
+  }
+  return result;
+}
+
 } // namespace
 
 auto SystemAccess::conflicts_with(const SystemAccess& other) const -> bool {
@@ -53,18 +74,25 @@ auto SystemAccess::conflicts_with(const SystemAccess& other) const -> bool {
          intersects(reads, other.writes);
 }
 
-auto plan_phase_batches(std::span<const SystemAccess> systems)
+auto plan_phase_batches(std::span<const SystemAccess> systems,
+                        std::span<const std::vector<ComponentTypeId>> linked)
     -> std::vector<std::vector<std::size_t>> {
   std::vector<std::vector<std::size_t>> batches;
   if (systems.empty()) {
     return batches;
   }
 
+  std::vector<SystemAccess> access;
+  access.reserve(systems.size());
+  for (const SystemAccess& system : systems) {
+    access.push_back(widened(system, linked));
+  }
+
   std::vector<std::size_t> current;
-  for (std::size_t index = 0; index < systems.size(); ++index) {
+  for (std::size_t index = 0; index < access.size(); ++index) {
     const bool collides =
         std::any_of(current.begin(), current.end(), [&](std::size_t member) {
-          return systems[index].conflicts_with(systems[member]);
+          return access[index].conflicts_with(access[member]);
         });
     if (collides && !current.empty()) {
       batches.push_back(std::move(current));
@@ -72,7 +72,12 @@ struct SystemAccess {
   [[nodiscard]] auto conflicts_with(const SystemAccess& other) const -> bool;
 };
 
-[[nodiscard]] auto plan_phase_batches(std::span<const SystemAccess> systems)
+// Each entry of `linked` lists the storages of one owning group. Adding or
+// removing any of them reorders the group's owned dense arrays, so touching one
+// counts as touching all of them.
+[[nodiscard]] auto
+plan_phase_batches(std::span<const SystemAccess> systems,
+                   std::span<const std::vector<ComponentTypeId>> linked = {})
     -> std::vector<std::vector<std::size_t>>;
 
 } // namespace Engine::Core
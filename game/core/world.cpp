@@ -9,6 +9,7 @@
 #include <memory>
 #include <mutex>
 #include <numbers>
+#include <numeric>
 #include <string>
 #include <string_view>
 #include <typeinfo>
@@ -29,6 +30,7 @@
 #include "component.h"
 #include "core/entity.h"
 #include "core/system.h"
+#include "event_manager.h"
 
 namespace Engine::Core {
 
@@ -78,7 +80,7 @@ attack_target_is_in_range(World& world,
     return false;
   }
 
-  auto* target = world.get_entity(attack_target->target_id);
+  const Entity* target = world.get_entity(attack_target->target_id);
   if (target == nullptr) {
     return false;
   }
@@ -90,7 +92,7 @@ attack_target_is_in_range(World& world,
       return contact->target_id == attack_target->target_id && contact->in_contact;
     }
   }
-  auto* target_transform = target->get_component<TransformComponent>();
+  auto const* target_transform = target->get_component<TransformComponent>();
   if (target_transform == nullptr) {
     return false;
   }
@@ -100,7 +102,7 @@ attack_target_is_in_range(World& world,
   float const dist_sq = dx * dx + dz * dz;
   float target_radius =
       std::max(target_transform->scale.x, target_transform->scale.z) * 0.5F;
-  if (auto* elephant = target->get_component<ElephantComponent>()) {
+  if (auto const* elephant = target->get_component<ElephantComponent>()) {
     target_radius = std::max(target_radius, elephant->trample_radius);
   }
   float const effective_range = attack->range + target_radius + 0.25F;
@@ -138,7 +140,7 @@ void begin_motion_presentation_frame(World& world, float delta_time) {
     if (entity == nullptr) {
       continue;
     }
-    auto* transform = entity->get_component<TransformComponent>();
+    auto const* transform = std::as_const(*entity).get_component<TransformComponent>();
     if (transform == nullptr) {
       continue;
     }
@@ -157,26 +159,29 @@ void begin_motion_presentation_frame(World& world, float delta_time) {
 
 void finalize_motion_presentation_frame(World& world, float delta_time) {
   const float safe_dt = std::max(delta_time, 1.0e-5F);
-  world.each<MotionPresentationComponent, TransformComponent, UnitComponent>(
+  world.each<MotionPresentationComponent,
+             const TransformComponent,
+             const UnitComponent>(
       [&world, delta_time, safe_dt](EntityID id,
                                     MotionPresentationComponent& motion_value,
-                                    TransformComponent& transform_value,
-                                    UnitComponent& unit_value) {
-        Entity* entity_ptr = world.get_entity(id);
+                                    const TransformComponent& transform_value,
+                                    const UnitComponent& unit_value) {
+        const Entity* entity_ptr = world.get_entity(id);
         if (entity_ptr == nullptr) {
           return;
         }
-        Entity& entity = *entity_ptr;
+        const Entity& entity = *entity_ptr;
         auto* motion = &motion_value;
-        auto* transform = &transform_value;
-        auto* unit = &unit_value;
+        auto const* transform = &transform_value;
+        auto const* unit = &unit_value;
+        bool const had_locomotion = motion->has_locomotion();
 
-        auto* movement = entity.get_component<MovementComponent>();
-        auto* attack = entity.get_component<AttackComponent>();
-        auto* attack_target = entity.get_component<AttackTargetComponent>();
-        auto* commander = entity.get_component<CommanderComponent>();
-        auto* builder_prod = entity.get_component<BuilderProductionComponent>();
-        auto* stamina = entity.get_component<StaminaComponent>();
+        auto const* movement = entity.get_component<MovementComponent>();
+        auto const* attack = entity.get_component<AttackComponent>();
+        auto const* attack_target = entity.get_component<AttackTargetComponent>();
+        auto const* commander = entity.get_component<CommanderComponent>();
+        auto const* builder_prod = entity.get_component<BuilderProductionComponent>();
+        auto const* stamina = entity.get_component<StaminaComponent>();
 
         float const displacement_x = transform->position.x - motion->previous_x;
         float const displacement_z = transform->position.z - motion->previous_z;
@@ -247,6 +252,9 @@ void finalize_motion_presentation_frame(World& world, float delta_time) {
         const MotionPresentationState next_state =
             resolve_motion_presentation_state(sample);
         motion->set_state(next_state);
+        if (motion->has_locomotion() != had_locomotion) {
+          world.registry().mark_written(id);
+        }
         motion->state_time = motion->state_changed
                                  ? 0.0F
                                  : motion->state_time + std::max(0.0F, delta_time);
@@ -294,8 +302,9 @@ void finalize_motion_presentation_frame(World& world, float delta_time) {
           motion->movement_target_z = movement->get_target_y();
           motion->has_movement_target = true;
         } else if (motion->has_chase_intent && attack_target != nullptr) {
-          if (auto* target = world.get_entity(attack_target->target_id)) {
-            if (auto* target_transform = target->get_component<TransformComponent>()) {
+          if (const Entity* target = world.get_entity(attack_target->target_id)) {
+            if (auto const* target_transform =
+                    target->get_component<TransformComponent>()) {
               motion->movement_target_x = target_transform->position.x;
               motion->movement_target_z = target_transform->position.z;
               motion->has_movement_target = true;
@@ -399,19 +408,20 @@ void publish_creature_presentation_entity(Entity* entity, World* world) {
   if (entity == nullptr) {
     return;
   }
-  auto const* unit = entity->get_component<UnitComponent>();
+  const Entity& source = *entity;
+  auto const* unit = source.get_component<UnitComponent>();
 
-  auto* presentation = get_or_add_component<CreaturePresentationComponent>(entity);
-  if (presentation == nullptr) {
-    return;
-  }
+  CreaturePresentationComponent const absent{};
+  auto const* current = source.get_component<CreaturePresentationComponent>();
+  const CreaturePresentationComponent& previous =
+      current != nullptr ? *current : absent;
   CreaturePresentationComponent next;
   next.snapshot_valid = true;
 
-  auto const* target_ref = entity->get_component<AttackTargetComponent>();
+  auto const* target_ref = source.get_component<AttackTargetComponent>();
   next.target_id = target_ref != nullptr ? target_ref->target_id : 0U;
   if (next.target_id != 0U && world != nullptr) {
-    auto* target = world->get_entity(next.target_id);
+    const Entity* target = world->get_entity(next.target_id);
     auto const* target_unit =
         target != nullptr ? target->get_component<UnitComponent>() : nullptr;
     next.target_alive = target_unit != nullptr && target_unit->health > 0 &&
@@ -419,17 +429,17 @@ void publish_creature_presentation_entity(Entity* entity, World* world) {
                         !target->has_component<DeathAnimationComponent>();
   }
 
-  auto const* death = entity->get_component<DeathAnimationComponent>();
-  auto const* builder = entity->get_component<BuilderProductionComponent>();
-  auto const* combat = entity->get_component<CombatStateComponent>();
-  auto const* attack = entity->get_component<AttackComponent>();
-  auto const* hit = entity->get_component<HitFeedbackComponent>();
-  auto const* special = entity->get_component<SpecialAttackComponent>();
+  auto const* death = source.get_component<DeathAnimationComponent>();
+  auto const* builder = source.get_component<BuilderProductionComponent>();
+  auto const* combat = source.get_component<CombatStateComponent>();
+  auto const* attack = source.get_component<AttackComponent>();
+  auto const* hit = source.get_component<HitFeedbackComponent>();
+  auto const* special = source.get_component<SpecialAttackComponent>();
   bool const uses_rpg_rules =
-      (entity->get_component<CommanderComponent>() != nullptr &&
-       entity->get_component<CommanderComponent>()->fpv_controlled) ||
-      (entity->get_component<RpgHealthComponent>() != nullptr &&
-       entity->get_component<RpgHealthComponent>()->active);
+      (source.get_component<CommanderComponent>() != nullptr &&
+       source.get_component<CommanderComponent>()->fpv_controlled) ||
+      (source.get_component<RpgHealthComponent>() != nullptr &&
+       source.get_component<RpgHealthComponent>()->active);
 
   Animation::HumanoidActionSampleInputs action_inputs{};
   if (death != nullptr) {
@@ -450,7 +460,7 @@ void publish_creature_presentation_entity(Entity* entity, World* world) {
     };
     construction_job = builder_work_job(builder->product_type);
   } else if (auto const* resident =
-                 entity->get_component<SettlementResidentComponent>();
+                 source.get_component<SettlementResidentComponent>();
 
              death == nullptr && resident != nullptr && resident->is_labouring()) {
 
@@ -517,7 +527,7 @@ void publish_creature_presentation_entity(Entity* entity, World* world) {
     next.melee_intent = combat->intent;
     next.melee_intent_valid = true;
   }
-  if (auto const* body = entity->get_component<CommanderBodyControlComponent>()) {
+  if (auto const* body = source.get_component<CommanderBodyControlComponent>()) {
     next.melee_rest_x = body->rest_dir_x;
     next.melee_rest_y = body->rest_dir_y;
     next.melee_rest_valid = body->rest_valid;
@@ -560,7 +570,7 @@ void publish_creature_presentation_entity(Entity* entity, World* world) {
   next.death_progress = action.death_progress;
   next.death_variant = action.death_variant;
 
-  auto const* formation = entity->get_component<FormationPresentationComponent>();
+  auto const* formation = source.get_component<FormationPresentationComponent>();
   next.allow_full_body_hit_reaction =
       formation == nullptr || formation->allow_full_body_hit_reaction;
   if (!next.allow_full_body_hit_reaction) {
@@ -571,15 +581,15 @@ void publish_creature_presentation_entity(Entity* entity, World* world) {
     next.hit_recoil_z = 0.0F;
   }
 
-  auto const* transform = entity->get_component<TransformComponent>();
-  auto const* healer = entity->get_component<HealerComponent>();
+  auto const* transform = source.get_component<TransformComponent>();
+  auto const* healer = source.get_component<HealerComponent>();
   if (healer != nullptr && healer->is_healing_active && transform != nullptr &&
       !action.is_in_melee_lock) {
     next.is_healing = true;
     next.healing_target_dx = healer->healing_target_x - transform->position.x;
     next.healing_target_dz = healer->healing_target_z - transform->position.z;
   }
-  auto const* commander = entity->get_component<CommanderComponent>();
+  auto const* commander = source.get_component<CommanderComponent>();
   next.has_commander = commander != nullptr;
   next.fpv_controlled = commander != nullptr && commander->fpv_controlled;
   if (commander != nullptr) {
@@ -590,14 +600,14 @@ void publish_creature_presentation_entity(Entity* entity, World* world) {
     next.flag_rally_animation_timer = commander->flag_rally_animation_timer;
     next.flag_rally_cost = commander->flag_rally_cost;
   }
-  auto const* commander_guard = entity->get_component<CommanderGuardComponent>();
-  auto const* formation_mode = entity->get_component<FormationModeComponent>();
-  auto const* guard_mode = entity->get_component<GuardModeComponent>();
-  auto const* brace = entity->get_component<SpearBraceComponent>();
+  auto const* commander_guard = source.get_component<CommanderGuardComponent>();
+  auto const* formation_mode = source.get_component<FormationModeComponent>();
+  auto const* guard_mode = source.get_component<GuardModeComponent>();
+  auto const* brace = source.get_component<SpearBraceComponent>();
   next.formation_guard_active = (formation_mode != nullptr && formation_mode->active) ||
                                 (guard_mode != nullptr && guard_mode->active);
 
-  auto const* unit_layout = entity->get_component<UnitLayoutStateComponent>();
+  auto const* unit_layout = source.get_component<UnitLayoutStateComponent>();
   next.defensive_layout_locked =
       unit_layout != nullptr &&
       unit_layout->state ==
@@ -608,9 +618,9 @@ void publish_creature_presentation_entity(Entity* entity, World* world) {
       (unit != nullptr && unit->spawn_type == Game::Units::SpawnType::Knight &&
        next.formation_guard_active) ||
       (brace != nullptr && (brace->requested || brace->active));
-  next.activity = Game::Systems::classify_unit_activity(*entity);
+  next.activity = Game::Systems::classify_unit_activity(source);
 
-  auto const* hold = entity->get_component<HoldModeComponent>();
+  auto const* hold = source.get_component<HoldModeComponent>();
   if (hold != nullptr) {
     next.hold_requested = hold->active;
     next.hold_exit_requested = !hold->active && hold->exit_cooldown > 0.0F;
@@ -620,13 +630,13 @@ void publish_creature_presentation_entity(Entity* entity, World* world) {
     next.hold_enter_duration = hold->kneel_duration;
     next.hold_exit_duration = hold->stand_up_duration;
   }
-  auto const* showcase = entity->get_component<ShowcaseRoutineComponent>();
+  auto const* showcase = source.get_component<ShowcaseRoutineComponent>();
   if (showcase != nullptr) {
     next.showcase_active = showcase->active;
     next.showcase_move = showcase->current_move;
     next.showcase_phase = showcase->phase;
   }
-  auto const* authored = entity->get_component<RpgCommanderActionComponent>();
+  auto const* authored = source.get_component<RpgCommanderActionComponent>();
   if (authored != nullptr) {
     next.authored_action_id = authored->combat_action_id;
     next.authored_action_running = authored->action_running;
@@ -637,30 +647,38 @@ void publish_creature_presentation_entity(Entity* entity, World* world) {
   next.combat_active = next.is_attacking || next.is_hit_reacting || next.is_dying ||
                        next.is_dead || next.target_id != 0U;
 
-  next.revision = presentation->revision;
+  next.revision = previous.revision;
   bool const changed =
-      presentation->snapshot_valid != next.snapshot_valid ||
-      presentation->target_id != next.target_id ||
-      presentation->target_alive != next.target_alive ||
-      presentation->combat_active != next.combat_active ||
-      presentation->is_attacking != next.is_attacking ||
-      presentation->is_melee != next.is_melee ||
-      presentation->combat_phase != next.combat_phase ||
-      presentation->is_hit_reacting != next.is_hit_reacting ||
-      presentation->hit_reaction_kind != next.hit_reaction_kind ||
-      presentation->construction_job != next.construction_job ||
-      presentation->is_dying != next.is_dying ||
-      presentation->is_dead != next.is_dead ||
-      presentation->guard_requested != next.guard_requested ||
-      presentation->defensive_layout_locked != next.defensive_layout_locked ||
-      presentation->hold_requested != next.hold_requested ||
-      presentation->showcase_active != next.showcase_active ||
-      presentation->showcase_move != next.showcase_move ||
-      presentation->showcase_phase != next.showcase_phase;
+      previous.snapshot_valid != next.snapshot_valid ||
+      previous.target_id != next.target_id ||
+      previous.target_alive != next.target_alive ||
+      previous.combat_active != next.combat_active ||
+      previous.is_attacking != next.is_attacking ||
+      previous.is_melee != next.is_melee ||
+      previous.combat_phase != next.combat_phase ||
+      previous.is_hit_reacting != next.is_hit_reacting ||
+      previous.hit_reaction_kind != next.hit_reaction_kind ||
+      previous.construction_job != next.construction_job ||
+      previous.is_dying != next.is_dying ||
+      previous.is_dead != next.is_dead ||
+      previous.guard_requested != next.guard_requested ||
+      previous.defensive_layout_locked != next.defensive_layout_locked ||
+      previous.hold_requested != next.hold_requested ||
+      previous.showcase_active != next.showcase_active ||
+      previous.showcase_move != next.showcase_move ||
+      previous.showcase_phase != next.showcase_phase;
   if (changed) {
     ++next.revision;
   }
-  *presentation = next;
+  if (current != nullptr && *current == next &&
+      current->activity.queued_orders == next.activity.queued_orders) {
+    return;
+  }
+  if (auto* presentation =
+          get_or_add_component<CreaturePresentationComponent>(entity)) {
+    *presentation = next;
+    entity->registry()->mark_written(entity->get_id());
+  }
 }
 
 void publish_creature_presentation_frame(World& world) {
@@ -812,6 +830,82 @@ auto render_entity_is_stable(const Entity& entity) -> bool {
 
 constexpr std::uint64_t k_render_signature_unstable = 0ULL;
 
+enum class RenderCategory : std::uint8_t { None, Unit, Building, Other };
+
+template <typename... Components>
+void track_component_writes(Registry& registry) {
+  (registry.track_writes<Components>(), ...);
+}
+
+void track_render_signature_writes(Registry& registry) {
+  track_component_writes<TransformComponent,
+                         UnitComponent,
+                         RenderableComponent,
+                         BuildingComponent,
+                         MovementComponent,
+                         AttackTargetComponent,
+                         CombatStateComponent,
+                         FormationContactComponent,
+                         SoldierCasualtyAnimationComponent,
+                         PendingRemovalComponent,
+                         DeathAnimationComponent,
+                         BuilderProductionComponent,
+                         ProductionComponent,
+                         CaptureComponent,
+                         CommanderComponent,
+                         CommanderAuraBuffComponent,
+                         RpgCommanderActionComponent,
+                         RpgCommanderTargetComponent,
+                         HealerComponent,
+                         BurningStatusComponent,
+                         StaggerComponent,
+                         HitFeedbackComponent,
+                         FormationHitPresentationComponent,
+                         ConstructionPreviewComponent,
+                         WallConstructionSiteComponent,
+                         StructureDamagePresentationComponent,
+                         RpgContactPresentationComponent,
+                         BloodStainComponent,
+                         FirePatchComponent,
+                         StructureFireComponent,
+                         ElephantStompImpactComponent,
+                         CatapultLoadingComponent,
+                         FarmComponent,
+                         GateComponent,
+                         UnitLayoutStateComponent,
+                         MoraleComponent,
+                         FormationPresentationComponent,
+                         FormationRosterPresentationComponent>(registry);
+}
+
+void track_ai_snapshot_writes(Registry& registry) {
+  track_component_writes<AIControlledComponent,
+                         AssaultWaveComponent,
+                         GuardModeComponent,
+                         HoldModeComponent,
+                         PatrolComponent>(registry);
+}
+
+void declare_hot_groups(Registry& registry) {
+  registry.group<TransformComponent, UnitComponent>();
+  registry.group<MovementComponent>(group_get<TransformComponent, UnitComponent>);
+  registry.group<AttackComponent>(group_get<TransformComponent, UnitComponent>);
+}
+
+auto render_category_of(const Entity& entity) -> RenderCategory {
+  if (!entity.has_component<RenderableComponent>() ||
+      entity.has_component<PendingRemovalComponent>()) {
+    return RenderCategory::None;
+  }
+  if (entity.has_component<UnitComponent>()) {
+    return RenderCategory::Unit;
+  }
+  if (entity.has_component<BuildingComponent>()) {
+    return RenderCategory::Building;
+  }
+  return RenderCategory::Other;
+}
+
 auto render_entity_signature(const Entity& entity) -> std::uint64_t {
   std::uint64_t signature = 0xcbf29ce484222325ULL;
   if (auto const* transform = entity.get_component<TransformComponent>()) {
@@ -914,7 +1008,10 @@ World::World(bool presentation_enabled, bool render_snapshot)
                                                   bool added) {
     this->on_component_changed(entity_id, type_id, component_type, added);
   });
+  declare_hot_groups(m_registry);
   if (!m_is_render_snapshot) {
+    track_render_signature_writes(m_registry);
+    track_ai_snapshot_writes(m_registry);
     std::atomic_store_explicit(&m_render_snapshot,
                                std::shared_ptr<World>(new World(false, true)),
                                std::memory_order_release);
@@ -953,7 +1050,8 @@ auto World::collect_entities_with_type(ComponentTypeId type_id,
                                        const std::source_location& where)
     -> std::vector<Entity*> {
   const EntityLock lock(*this);
-  ++m_query_counters.collects;
+  SystemProfiler::QueryCounters& counters = query_counter_sink();
+  ++counters.collects;
   const std::span<const EntityID> dense = m_registry.entities_with(type_id);
   if (dense.empty()) {
     m_system_profiler.note_collect_call_site(where.file_name(), where.line(), 0);
@@ -967,7 +1065,7 @@ auto World::collect_entities_with_type(ComponentTypeId type_id,
       result.push_back(entity);
     }
   }
-  m_query_counters.collected_entities += result.size();
+  counters.collected_entities += result.size();
   m_system_profiler.note_collect_call_site(
       where.file_name(), where.line(), result.size());
   return result;
@@ -1028,6 +1126,7 @@ void World::clear() {
 
   m_registry.clear();
   m_deferred.clear();
+  m_events.clear();
   m_spatial_index.clear();
 
   const auto observers = m_world_cleared_observers;
@@ -1059,6 +1158,7 @@ void World::add_system(std::unique_ptr<System> system) {
 void World::add_system(std::unique_ptr<System> system, SystemPhase phase) {
   m_systems.push_back(std::move(system));
   m_system_phases.push_back(phase);
+  m_schedule_dirty = true;
 }
 
 auto World::plan_phase_schedule(SystemPhase phase) const
@@ -1073,7 +1173,7 @@ auto World::plan_phase_schedule(SystemPhase phase) const
     phase_slots.push_back(slot);
   }
 
-  auto batches = plan_phase_batches(declared);
+  auto batches = plan_phase_batches(declared, m_registry.group_layouts());
   for (auto& batch : batches) {
     for (std::size_t& index : batch) {
       index = phase_slots[index];
@@ -1117,12 +1217,139 @@ auto World::system_display_name(const System& system) -> const char* {
 
 auto World::current_query_counters() const -> SystemProfiler::QueryCounters {
   SystemProfiler::QueryCounters counters = m_query_counters;
-  const WorldSpatialIndex::Stats& spatial = m_spatial_index.stats();
+  const WorldSpatialIndex::Stats spatial = m_spatial_index.stats();
   counters.spatial_queries = spatial.queries;
   counters.spatial_candidates = spatial.candidates_examined;
   return counters;
 }
 
+thread_local World::ParallelSlot* World::t_active_slot = nullptr;
+
+auto World::deferred() -> DeferredMutations& {
+  if (t_active_slot != nullptr && t_active_slot->owner == this) {
+    return t_active_slot->deferred;
+  }
+  return m_deferred;
+}
+
+auto World::events() -> EventQueue& {
+  if (t_active_slot != nullptr && t_active_slot->owner == this) {
+    return t_active_slot->events;
+  }
+  return m_events;
+}
+
+auto World::query_counter_sink() -> SystemProfiler::QueryCounters& {
+  if (t_active_slot != nullptr && t_active_slot->owner == this) {
+    return t_active_slot->queries;
+  }
+  return m_query_counters;
+}
+
+void World::set_worker_count(std::size_t workers) {
+  if (workers == worker_count()) {
+    return;
+  }
+  m_executor = workers == 0 ? nullptr : std::make_unique<SystemExecutor>(workers);
+}
+
+void World::rebuild_schedule() {
+  m_schedule.clear();
+  const auto group_layouts = m_registry.group_layouts();
+  std::vector<SystemAccess> declared;
+  std::vector<std::size_t> run_slots;
+  auto close_run = [&](SystemPhase phase) {
+    if (run_slots.empty()) {
+      return;
+    }
+    PlannedRun run;
+    run.phase = phase;
+    run.batches = plan_phase_batches(declared, group_layouts);
+    for (auto& batch : run.batches) {
+      for (std::size_t& index : batch) {
+        index = run_slots[index];
+      }
+    }
+    m_schedule.push_back(std::move(run));
+    declared.clear();
+    run_slots.clear();
+  };
+
+  SystemPhase current_phase =
+      m_system_phases.empty() ? SystemPhase::Input : m_system_phases.front();
+  for (std::size_t slot = 0; slot < m_systems.size(); ++slot) {
+    if (m_system_phases[slot] != current_phase) {
+      close_run(current_phase);
+      current_phase = m_system_phases[slot];
+    }
+    if (m_systems[slot] == nullptr) {
+      continue;
+    }
+    declared.push_back(m_systems[slot]->access());
+    run_slots.push_back(slot);
+  }
+  close_run(current_phase);
+  m_scheduled_group_count = group_layouts.size();
+  m_schedule_dirty = false;
+}
+
+void World::run_system(std::size_t slot, float delta_time, bool profiling) {
+  System& system = *m_systems[slot];
+  if (!profiling) {
+    system.update(this, delta_time);
+    return;
+  }
+
+  const SystemProfiler::QueryCounters queries_before = current_query_counters();
+  const auto started = std::chrono::steady_clock::now();
+  system.update(this, delta_time);
+  const auto elapsed = std::chrono::steady_clock::now() - started;
+  m_system_profiler.record_system(
+      slot,
+      system_display_name(system),
+      static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()),
+      current_query_counters() - queries_before);
+}
+
+void World::run_batch(const std::vector<std::size_t>& batch, float delta_time) {
+  while (m_parallel_slots.size() < batch.size()) {
+    m_parallel_slots.push_back(std::make_unique<ParallelSlot>());
+  }
+
+  const std::uint64_t lock_token = this_thread_lock_token();
+  m_executor->run(batch.size(), [&](std::size_t job) {
+    ParallelSlot& slot = *m_parallel_slots[job];
+    slot.owner = this;
+    slot.queries = {};
+    const Detail::BorrowedLockToken borrowed(lock_token);
+    ParallelSlot* const previous = std::exchange(t_active_slot, &slot);
+    try {
+      m_systems[batch[job]]->update(this, delta_time);
+    } catch (...) {
+      t_active_slot = previous;
+      throw;
+    }
+    t_active_slot = previous;
+  });
+
+  for (std::size_t job = 0; job < batch.size(); ++job) {
+    ParallelSlot& slot = *m_parallel_slots[job];
+    m_deferred.append(std::move(slot.deferred));
+    m_events.append(std::move(slot.events));
+    m_query_counters.views += slot.queries.views;
+    m_query_counters.view_candidates += slot.queries.view_candidates;
+    m_query_counters.collects += slot.queries.collects;
+    m_query_counters.collected_entities += slot.queries.collected_entities;
+  }
+}
+
+void World::apply_phase_barrier() {
+  m_deferred.apply(*this);
+  m_events.deliver();
+  Detail::reclaim_retired_event_handlers();
+}
+
 void World::update(float delta_time) {
   const EntityLock lock(*this);
   ++m_tick_id;
@@ -1136,36 +1363,39 @@ void World::update(float delta_time) {
     m_system_profiler.begin_tick(m_tick_id, m_registry.entity_count());
   }
 
-  SystemPhase current_phase =
-      m_system_phases.empty() ? SystemPhase::Input : m_system_phases.front();
-
-  for (std::size_t slot = 0; slot < m_systems.size(); ++slot) {
-    System& system = *m_systems[slot];
-
-    const SystemPhase slot_phase = m_system_phases[slot];
-    if (slot_phase != current_phase) {
-      m_deferred.apply(*this);
-      current_phase = slot_phase;
+  if (m_executor != nullptr && !profiling) {
+    if (m_schedule_dirty || m_scheduled_group_count != m_registry.group_count()) {
+      rebuild_schedule();
     }
-
-    if (!profiling) {
-      system.update(this, delta_time);
-      continue;
+    bool first_run = true;
+    for (const PlannedRun& run : m_schedule) {
+      if (!first_run) {
+        apply_phase_barrier();
+      }
+      first_run = false;
+      for (const auto& batch : run.batches) {
+        if (batch.size() == 1U) {
+          run_system(batch.front(), delta_time, false);
+        } else {
+          run_batch(batch, delta_time);
+        }
+      }
+    }
+  } else {
+    SystemPhase current_phase =
+        m_system_phases.empty() ? SystemPhase::Input : m_system_phases.front();
+
+    for (std::size_t slot = 0; slot < m_systems.size(); ++slot) {
+      const SystemPhase slot_phase = m_system_phases[slot];
+      if (slot_phase != current_phase) {
+        apply_phase_barrier();
+        current_phase = slot_phase;
+      }
+      run_system(slot, delta_time, profiling);
     }
-
-    const SystemProfiler::QueryCounters queries_before = current_query_counters();
-    const auto started = std::chrono::steady_clock::now();
-    system.update(this, delta_time);
-    const auto elapsed = std::chrono::steady_clock::now() - started;
-    m_system_profiler.record_system(
-        slot,
-        system_display_name(system),
-        static_cast<std::uint64_t>(
-            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()),
-        current_query_counters() - queries_before);
   }
 
-  m_deferred.apply(*this);
+  apply_phase_barrier();
 
   if (profiling) {
     m_system_profiler.end_tick(static_cast<std::uint64_t>(
@@ -1211,70 +1441,138 @@ void World::publish_render_snapshot() {
     buffer = std::shared_ptr<World>(new World(false, true));
   }
   auto snapshot = buffer;
-  snapshot->m_render_unit_ids.clear();
-  snapshot->m_render_building_ids.clear();
-  snapshot->m_render_other_ids.clear();
   std::size_t const slot_count = m_registry.slot_count();
   if (snapshot->m_render_entity_signatures.size() < slot_count) {
     snapshot->m_render_entity_signatures.resize(slot_count, 0U);
+    snapshot->m_render_categories.resize(
+        slot_count, static_cast<std::uint8_t>(RenderCategory::None));
   }
+  std::uint64_t const synced_revision = snapshot->m_render_synced_revision;
   ++m_render_publish_revision;
-  snapshot->m_render_unit_ids.reserve(entities_with<UnitComponent>().size());
-  snapshot->m_render_building_ids.reserve(entities_with<BuildingComponent>().size());
-  snapshot->m_render_other_ids.reserve(entities_with<RenderableComponent>().size());
-
-  for (std::size_t index = 1; index < slot_count; ++index) {
-    EntityID const source_id =
-        m_registry.entity_at_index(static_cast<std::uint32_t>(index));
-    EntityID const snapshot_id =
-        snapshot->m_registry.entity_at_index(static_cast<std::uint32_t>(index));
+  auto& writes = m_render_writes[m_render_publish_revision % m_render_writes.size()];
+  m_registry.advance_write_epoch(m_render_publish_revision + 1U, writes.slots);
+  writes.revision = m_render_publish_revision;
+
+  // A buffer only has to revisit what was written since it last synced, plus
+  // the entities it could not keep a stable copy of.
+  bool full_sweep = synced_revision == 0 ||
+                    m_render_publish_revision - synced_revision >
+                        m_render_writes.size();
+  auto& slots = m_render_publish_slots;
+  slots.clear();
+  if (!full_sweep) {
+    slots.assign(snapshot->m_render_unstable_slots.begin(),
+                 snapshot->m_render_unstable_slots.end());
+    for (std::uint64_t revision = synced_revision + 1U;
+         revision <= m_render_publish_revision;
+         ++revision) {
+      auto const& replay = m_render_writes[revision % m_render_writes.size()];
+      if (replay.revision != revision) {
+        full_sweep = true;
+        break;
+      }
+      slots.insert(slots.end(), replay.slots.begin(), replay.slots.end());
+    }
+  }
+  if (full_sweep) {
+    slots.resize(slot_count > 0U ? slot_count - 1U : 0U);
+    std::iota(slots.begin(), slots.end(), 1U);
+  } else {
+    std::sort(slots.begin(), slots.end());
+    slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+  }
+
+  std::size_t visited = 0;
+  std::size_t copied = 0;
+  bool categories_changed = full_sweep;
+  snapshot->m_render_unstable_slots.clear();
+  for (std::uint32_t const slot : slots) {
+    if (slot >= slot_count) {
+      continue;
+    }
+    std::size_t const index = slot;
+    EntityID const snapshot_id = snapshot->m_registry.entity_at_index(slot);
+    ++visited;
+
+    EntityID const source_id = m_registry.entity_at_index(slot);
+    RenderCategory category = RenderCategory::None;
     if (source_id == NULL_ENTITY) {
       if (snapshot_id != NULL_ENTITY) {
         snapshot->destroy_entity(snapshot_id);
       }
       snapshot->m_render_entity_signatures[index] = 0U;
-      continue;
-    }
-    Entity const& source = *resolve(source_id);
-    Entity* destination = snapshot->resolve(source_id);
-
-    bool const stable = render_entity_is_stable(source);
-    std::uint64_t signature = k_render_signature_unstable;
-    bool reusable = false;
-    if (destination != nullptr && stable) {
-      signature = render_entity_signature(source);
-      if (signature == k_render_signature_unstable) {
-        signature = 1ULL;
+    } else {
+      Entity const& source = *resolve(source_id);
+      Entity* destination = snapshot->resolve(source_id);
+
+      bool const stable = render_entity_is_stable(source);
+      std::uint64_t signature = k_render_signature_unstable;
+      bool reusable = false;
+      if (destination != nullptr && stable) {
+        signature = render_entity_signature(source);
+        if (signature == k_render_signature_unstable) {
+          signature = 1ULL;
+        }
+        reusable = snapshot->m_render_entity_signatures[index] == signature;
       }
-      reusable = snapshot->m_render_entity_signatures[index] == signature;
-    }
 
-    if (!reusable) {
-      if (destination == nullptr) {
-        if (snapshot_id != NULL_ENTITY) {
-          snapshot->destroy_entity(snapshot_id);
-        }
-        destination = snapshot->create_entity_with_id(source_id);
+      if (!reusable) {
         if (destination == nullptr) {
-          continue;
+          if (snapshot_id != NULL_ENTITY) {
+            snapshot->destroy_entity(snapshot_id);
+          }
+          destination = snapshot->create_entity_with_id(source_id);
+        }
+        if (destination != nullptr) {
+          copy_render_components(source, *destination);
+          ++copied;
+        }
+        snapshot->m_render_entity_signatures[index] =
+            destination != nullptr ? signature : k_render_signature_unstable;
+      }
+      if (destination != nullptr) {
+        category = render_category_of(*destination);
+        if (snapshot->m_render_entity_signatures[index] ==
+            k_render_signature_unstable) {
+          snapshot->m_render_unstable_slots.push_back(slot);
         }
       }
-      copy_render_components(source, *destination);
-      snapshot->m_render_entity_signatures[index] = signature;
     }
 
-    if (!destination->has_component<RenderableComponent>() ||
-        destination->has_component<PendingRemovalComponent>()) {
-      continue;
+    auto const stored = static_cast<std::uint8_t>(category);
+    if (snapshot->m_render_categories[index] != stored) {
+      snapshot->m_render_categories[index] = stored;
+      categories_changed = true;
     }
-    if (destination->has_component<UnitComponent>()) {
-      snapshot->m_render_unit_ids.push_back(source_id);
-    } else if (destination->has_component<BuildingComponent>()) {
-      snapshot->m_render_building_ids.push_back(source_id);
-    } else {
-      snapshot->m_render_other_ids.push_back(source_id);
+  }
+
+  if (categories_changed) {
+    snapshot->m_render_unit_ids.clear();
+    snapshot->m_render_building_ids.clear();
+    snapshot->m_render_other_ids.clear();
+    snapshot->m_render_unit_ids.reserve(entities_with<UnitComponent>().size());
+    snapshot->m_render_building_ids.reserve(entities_with<BuildingComponent>().size());
+    snapshot->m_render_other_ids.reserve(entities_with<RenderableComponent>().size());
+    for (std::size_t index = 1; index < slot_count; ++index) {
+      auto const category =
+          static_cast<RenderCategory>(snapshot->m_render_categories[index]);
+      if (category == RenderCategory::None) {
+        continue;
+      }
+      EntityID const id =
+          snapshot->m_registry.entity_at_index(static_cast<std::uint32_t>(index));
+      if (category == RenderCategory::Unit) {
+        snapshot->m_render_unit_ids.push_back(id);
+      } else if (category == RenderCategory::Building) {
+        snapshot->m_render_building_ids.push_back(id);
+      } else {
+        snapshot->m_render_other_ids.push_back(id);
+      }
     }
   }
+  snapshot->m_render_synced_revision = m_render_publish_revision;
+  m_system_profiler.record_render_publication(slot_count, visited, copied, full_sweep);
+
   std::atomic_store_explicit(
       &m_render_snapshot, std::move(snapshot), std::memory_order_release);
 }
@@ -21,8 +21,10 @@
 
 #include "deferred_mutations.h"
 #include "entity.h"
+#include "event_queue.h"
 #include "registry.h"
 #include "system.h"
+#include "system_executor.h"
 #include "system_profiler.h"
 #include "world_spatial_index.h"
 
@@ -73,7 +75,16 @@ public:
 
   void update(float delta_time);
 
-  [[nodiscard]] auto deferred() -> DeferredMutations& { return m_deferred; }
+  [[nodiscard]] auto deferred() -> DeferredMutations&;
+
+  // Events queued here are published at the next phase barrier, after the
+  // deferred mutations are applied.
+  [[nodiscard]] auto events() -> EventQueue&;
+
+  void set_worker_count(std::size_t workers);
+  [[nodiscard]] auto worker_count() const noexcept -> std::size_t {
+    return m_executor == nullptr ? std::size_t{0} : m_executor->worker_count();
+  }
 
   [[nodiscard]] auto system_phases() const -> std::span<const SystemPhase> {
     return m_system_phases;
@@ -255,11 +266,33 @@ private:
   static auto system_display_name(const System& system) -> const char*;
   [[nodiscard]] auto current_query_counters() const -> SystemProfiler::QueryCounters;
 
+  struct ParallelSlot {
+    World* owner{nullptr};
+    DeferredMutations deferred;
+    EventQueue events;
+    SystemProfiler::QueryCounters queries;
+  };
+
+  static thread_local ParallelSlot* t_active_slot;
+
+  struct PlannedRun {
+    SystemPhase phase{SystemPhase::Input};
+    std::vector<std::vector<std::size_t>> batches;
+  };
+
   void note_view_opened(std::size_t candidates) {
-    ++m_query_counters.views;
-    m_query_counters.view_candidates += candidates;
+    SystemProfiler::QueryCounters& counters = query_counter_sink();
+    ++counters.views;
+    counters.view_candidates += candidates;
   }
 
+  [[nodiscard]] auto query_counter_sink() -> SystemProfiler::QueryCounters&;
+
+  void run_system(std::size_t slot, float delta_time, bool profiling);
+  void run_batch(const std::vector<std::size_t>& batch, float delta_time);
+  void rebuild_schedule();
+  void apply_phase_barrier();
+
   [[nodiscard]] auto resolve(EntityID entity_id) const -> Entity*;
   [[nodiscard]] auto collect_units_matching(int owner_id,
                                             bool owned) const -> std::vector<Entity*>;
@@ -271,6 +304,12 @@ private:
   std::vector<std::unique_ptr<System>> m_systems;
   std::vector<SystemPhase> m_system_phases;
   DeferredMutations m_deferred;
+  EventQueue m_events;
+  std::unique_ptr<SystemExecutor> m_executor;
+  std::vector<PlannedRun> m_schedule;
+  bool m_schedule_dirty{true};
+  std::size_t m_scheduled_group_count{0};
+  std::vector<std::unique_ptr<ParallelSlot>> m_parallel_slots;
 
   template <typename Callback>
   struct ObserverEntry {
@@ -297,7 +336,20 @@ private:
   std::vector<EntityID> m_render_building_ids;
   std::vector<EntityID> m_render_other_ids;
   std::vector<std::uint64_t> m_render_entity_signatures;
+  std::vector<std::uint8_t> m_render_categories;
+  std::uint64_t m_render_synced_revision{0};
   std::uint64_t m_render_publish_revision{0};
+
+  // Slots written during one publish revision. A buffer that last synced at
+  // revision R replays the lists for R + 1 up to the current revision.
+  struct RenderWrites {
+    std::uint64_t revision{0};
+    std::vector<std::uint32_t> slots;
+  };
+  std::array<RenderWrites, 3> m_render_writes;
+  std::vector<std::uint32_t> m_render_publish_slots;
+  // On a snapshot: slots whose copy must be refreshed even when unwritten.
+  std::vector<std::uint32_t> m_render_unstable_slots;
 };
 
 class World::EntityLock {
@@ -332,9 +384,10 @@ class World::BasicView {
 public:
   static_assert(sizeof...(Components) > 0, "a view needs at least one component");
 
-  using Storages = std::tuple<ComponentStorage<Components>*...>;
+  using Storages = std::tuple<ComponentStorage<std::remove_const_t<Components>>*...>;
   using Head = std::conditional_t<WithEntity, Entity&, EntityID>;
   using Reference = std::tuple<Head, Components&...>;
+  using Indices = std::index_sequence_for<Components...>;
 
   class Iterator {
   public:
@@ -351,6 +404,7 @@ public:
     }
 
     auto operator*() const -> Reference {
+      m_owner->m_world->m_registry.template note_writes<Components...>(m_id);
       return std::apply(
           [this](auto*... components) {
             if constexpr (WithEntity) {
@@ -380,11 +434,7 @@ public:
     void seek() {
       while (m_index < m_owner->live_count()) {
         m_id = m_owner->m_source->entities()[m_index];
-        m_components = std::apply(
-            [id = m_id](auto*... storages) {
-              return std::tuple<Components*...>(storages->try_get(id)...);
-            },
-            m_owner->m_storages);
+        m_components = m_owner->fetch(m_id, m_index, Indices{});
         const bool complete = std::apply(
             [](auto*... components) { return ((components != nullptr) && ...); },
             m_components);
@@ -414,7 +464,8 @@ public:
   explicit BasicView(World& world)
       : m_world(&world)
       , m_lock(world) {
-    m_storages = Storages(world.m_registry.find_storage<Components>()...);
+    m_storages = Storages(
+        world.m_registry.find_storage<std::remove_const_t<Components>>()...);
     const bool complete = std::apply(
         [](auto*... storages) { return ((storages != nullptr) && ...); }, m_storages);
     if (!complete) {
@@ -434,6 +485,18 @@ public:
               ...);
         },
         m_storages);
+
+    const std::array<ComponentTypeId, sizeof...(Components)> type_ids{
+        component_type_id<std::remove_const_t<Components>>()...};
+    const ComponentGroup* group = world.m_registry.find_group(type_ids);
+    if (group != nullptr && group->size() <= m_limit) {
+      m_group = group;
+      m_source = group->lead();
+      m_limit = group->size();
+      for (std::size_t i = 0; i < type_ids.size(); ++i) {
+        m_owned[i] = group->owns(type_ids[i]);
+      }
+    }
     world.note_view_opened(m_limit);
   }
 
@@ -446,12 +509,27 @@ public:
 
 private:
   [[nodiscard]] auto live_count() const -> std::size_t {
-    return m_source == nullptr ? std::size_t{0} : std::min(m_limit, m_source->size());
+    if (m_source == nullptr) {
+      return 0;
+    }
+    return std::min(m_limit, m_group != nullptr ? m_group->size() : m_source->size());
+  }
+
+  template <std::size_t... I>
+  [[nodiscard]] auto fetch(EntityID id,
+                           std::size_t position,
+                           std::index_sequence<I...>) const
+      -> std::tuple<Components*...> {
+    return std::tuple<Components*...>(
+        (m_owned[I] ? &std::get<I>(m_storages)->at(position)
+                    : std::get<I>(m_storages)->try_get(id))...);
   }
 
   World* m_world{nullptr};
   Storages m_storages{};
   const IComponentStorage* m_source{nullptr};
+  const ComponentGroup* m_group{nullptr};
+  std::array<bool, sizeof...(Components)> m_owned{};
   std::size_t m_limit{0};
   EntityLock m_lock;
 };
@@ -1,9 +1,18 @@
 #include "world_spatial_index.h"
 
 #include <algorithm>
+#include <bit>
 #include <cmath>
 #include <limits>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SOI_SPATIAL_INDEX_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SOI_SPATIAL_INDEX_NEON 1
+#endif
+
 #include "component.h"
 #include "world.h"
 
@@ -13,6 +22,11 @@ namespace {
 
 constexpr int k_max_cells_per_axis = 512;
 constexpr float k_grid_margin = 4.0F;
+constexpr std::uint32_t k_unmasked_owner = 64U;
+
+auto owner_passes(std::uint64_t owner_mask, std::uint32_t owner_bit) -> bool {
+  return owner_bit == k_unmasked_owner || ((owner_mask >> owner_bit) & 1U) != 0U;
+}
 
 } // namespace
 
@@ -32,28 +46,38 @@ auto WorldSpatialIndex::clamp_cell(int cell, int count) -> int {
 void WorldSpatialIndex::clear() {
   m_entries.clear();
   m_scratch.clear();
+  m_column_x.clear();
+  m_column_z.clear();
+  m_column_flags.clear();
+  m_column_owner_bit.clear();
   m_cell_start.clear();
   m_cell_cursor.clear();
   m_cell_counts.clear();
   m_entry_by_slot.clear();
   m_cells_x = 0;
   m_cells_z = 0;
-  m_ever_built = false;
-  m_built_for_tick = 0;
+  m_built_for_tick.store(0, std::memory_order_release);
 }
 
 void WorldSpatialIndex::refresh(World& world) {
   const std::uint64_t tick = world.tick_id();
-  if (tick != 0 && m_ever_built && m_built_for_tick == tick) {
+  if (tick != 0 && m_built_for_tick.load(std::memory_order_acquire) == tick) {
+    return;
+  }
+  const std::lock_guard<std::mutex> lock(m_refresh_mutex);
+  if (tick != 0 && m_built_for_tick.load(std::memory_order_relaxed) == tick) {
     return;
   }
   rebuild(world);
 }
 
 void WorldSpatialIndex::rebuild(World& world) {
-  m_built_for_tick = world.tick_id();
-  m_ever_built = true;
-  ++m_stats.rebuilds;
+  index_entries(world);
+  m_built_for_tick.store(world.tick_id(), std::memory_order_release);
+}
+
+void WorldSpatialIndex::index_entries(World& world) {
+  ++m_rebuilds;
 
   m_scratch.clear();
 
@@ -97,7 +121,7 @@ void WorldSpatialIndex::rebuild(World& world) {
     m_scratch.push_back(entry);
   }
 
-  m_stats.entries_indexed += m_scratch.size();
+  m_entries_indexed += m_scratch.size();
 
   if (m_scratch.empty()) {
     m_entries.clear();
@@ -105,6 +129,7 @@ void WorldSpatialIndex::rebuild(World& world) {
     m_entry_by_slot.clear();
     m_cells_x = 0;
     m_cells_z = 0;
+    rebuild_columns();
     return;
   }
 
@@ -155,6 +180,129 @@ void WorldSpatialIndex::rebuild(World& world) {
   for (std::size_t i = 0; i < m_entries.size(); ++i) {
     m_entry_by_slot[Handle::index_of(m_entries[i].id)] = static_cast<std::uint32_t>(i);
   }
+  rebuild_columns();
+}
+
+void WorldSpatialIndex::rebuild_columns() {
+  const std::size_t count = m_entries.size();
+  m_column_x.resize(count);
+  m_column_z.resize(count);
+  m_column_flags.resize(count);
+  m_column_owner_bit.resize(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const Entry& entry = m_entries[i];
+    m_column_x[i] = entry.x;
+    m_column_z[i] = entry.z;
+    m_column_flags[i] = entry.flags;
+    m_column_owner_bit[i] = entry.owner_id >= 0 && entry.owner_id < k_owner_mask_bits
+                                ? static_cast<std::uint32_t>(entry.owner_id)
+                                : k_unmasked_owner;
+  }
+}
+
+void WorldSpatialIndex::filter_span(const RadiusQuery& query,
+                                    std::size_t begin,
+                                    std::size_t end,
+                                    std::vector<std::uint32_t>& hits) const {
+  const float radius_sq = query.radius * query.radius;
+  const std::uint32_t require = query.require_flags;
+  const std::uint32_t reject = query.reject_flags;
+  std::size_t i = begin;
+
+  auto const accept_lanes = [&](std::size_t base, unsigned lanes) {
+    while (lanes != 0U) {
+      const auto lane = static_cast<std::size_t>(std::countr_zero(lanes));
+      lanes &= lanes - 1U;
+      const std::size_t index = base + lane;
+      if (owner_passes(query.owner_mask, m_column_owner_bit[index])) {
+        hits.push_back(static_cast<std::uint32_t>(index));
+      }
+    }
+  };
+
+#if defined(SOI_SPATIAL_INDEX_SSE2)
+  const __m128 qx = _mm_set1_ps(query.x);
+  const __m128 qz = _mm_set1_ps(query.z);
+  const __m128 r2 = _mm_set1_ps(radius_sq);
+  const __m128i req = _mm_set1_epi32(static_cast<int>(require));
+  const __m128i rej = _mm_set1_epi32(static_cast<int>(reject));
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 4U <= end; i += 4U) {
+    const __m128 dx = _mm_sub_ps(_mm_loadu_ps(m_column_x.data() + i), qx);
+    const __m128 dz = _mm_sub_ps(_mm_loadu_ps(m_column_z.data() + i), qz);
+    const __m128 inside =
+        _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dz, dz)), r2);
+    const __m128i flags = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(m_column_flags.data() + i));
+    const __m128i has_required = _mm_cmpeq_epi32(_mm_and_si128(flags, req), req);
+    const __m128i has_rejected = _mm_cmpeq_epi32(_mm_and_si128(flags, rej), zero);
+    const __m128 pass =
+        _mm_and_ps(inside, _mm_castsi128_ps(_mm_and_si128(has_required, has_rejected)));
+    accept_lanes(i, static_cast<unsigned>(_mm_movemask_ps(pass)));
+  }
+#elif defined(SOI_SPATIAL_INDEX_NEON)
+  const float32x4_t qx = vdupq_n_f32(query.x);
+  const float32x4_t qz = vdupq_n_f32(query.z);
+  const float32x4_t r2 = vdupq_n_f32(radius_sq);
+  const uint32x4_t req = vdupq_n_u32(require);
+  const uint32x4_t rej = vdupq_n_u32(reject);
+  const uint32x4_t zero = vdupq_n_u32(0U);
+  static constexpr std::uint32_t k_lane_bits[4] = {1U, 2U, 4U, 8U};
+  const uint32x4_t lane_bits = vld1q_u32(k_lane_bits);
+  for (; i + 4U <= end; i += 4U) {
+    const float32x4_t dx = vsubq_f32(vld1q_f32(m_column_x.data() + i), qx);
+    const float32x4_t dz = vsubq_f32(vld1q_f32(m_column_z.data() + i), qz);
+    const uint32x4_t inside = vcleq_f32(vmlaq_f32(vmulq_f32(dx, dx), dz, dz), r2);
+    const uint32x4_t flags = vld1q_u32(m_column_flags.data() + i);
+    const uint32x4_t has_required = vceqq_u32(vandq_u32(flags, req), req);
+    const uint32x4_t has_rejected = vceqq_u32(vandq_u32(flags, rej), zero);
+    const uint32x4_t pass = vandq_u32(inside, vandq_u32(has_required, has_rejected));
+    accept_lanes(i, vaddvq_u32(vandq_u32(pass, lane_bits)));
+  }
+#endif
+
+  for (; i < end; ++i) {
+    const float dx = m_column_x[i] - query.x;
+    const float dz = m_column_z[i] - query.z;
+    const std::uint32_t flags = m_column_flags[i];
+    if (dx * dx + dz * dz <= radius_sq && (flags & require) == require &&
+        (flags & reject) == 0U) {
+      accept_lanes(i, 1U);
+    }
+  }
+}
+
+void WorldSpatialIndex::query_radius_batch(std::span<const RadiusQuery> queries,
+                                           BatchResult& out) const {
+  out.offsets.clear();
+  out.hits.clear();
+  out.offsets.reserve(queries.size() + 1U);
+  out.offsets.push_back(0U);
+  m_queries.fetch_add(queries.size(), std::memory_order_relaxed);
+
+  std::uint64_t examined = 0;
+  for (const RadiusQuery& query : queries) {
+    if (query.radius < 0.0F || m_cells_x <= 0 || m_cells_z <= 0 || m_entries.empty()) {
+      out.offsets.push_back(static_cast<std::uint32_t>(out.hits.size()));
+      continue;
+    }
+    const float radius = query.radius;
+    const int min_cx = clamp_cell(cell_of(query.x - radius, m_origin_x), m_cells_x);
+    const int max_cx = clamp_cell(cell_of(query.x + radius, m_origin_x), m_cells_x);
+    const int min_cz = clamp_cell(cell_of(query.z - radius, m_origin_z), m_cells_z);
+    const int max_cz = clamp_cell(cell_of(query.z + radius, m_origin_z), m_cells_z);
+    for (int cz = min_cz; cz <= max_cz; ++cz) {
+      const std::size_t row =
+          static_cast<std::size_t>(cz) * static_cast<std::size_t>(m_cells_x);
+      const std::size_t begin = m_cell_start[row + static_cast<std::size_t>(min_cx)];
+      const std::size_t end = m_cell_start[row + static_cast<std::size_t>(max_cx) + 1U];
+      examined += end - begin;
+      filter_span(query, begin, end, out.hits);
+    }
+    out.offsets.push_back(static_cast<std::uint32_t>(out.hits.size()));
+  }
+  m_candidates_examined.fetch_add(examined, std::memory_order_relaxed);
+  m_candidates_accepted.fetch_add(out.hits.size(), std::memory_order_relaxed);
 }
 
 void WorldSpatialIndex::query_radius(float x,
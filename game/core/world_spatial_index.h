@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <mutex>
+#include <span>
 #include <vector>
 
 #include "entity.h"
@@ -46,15 +49,60 @@ public:
 
   template <typename Fn>
   void for_each_in_radius(float x, float z, float radius, Fn&& fn) const {
-    visit_cells(x, z, radius, [&](const Entry& entry) {
-      const float dx = entry.x - x;
-      const float dz = entry.z - z;
-      if (dx * dx + dz * dz <= radius * radius) {
+    visit_cells(
+        x - radius, z - radius, x + radius, z + radius, [&](const Entry& entry) {
+          const float dx = entry.x - x;
+          const float dz = entry.z - z;
+          if (dx * dx + dz * dz <= radius * radius) {
+            fn(entry);
+          }
+        });
+  }
+
+  template <typename Fn>
+  void
+  for_each_in_rect(float min_x, float min_z, float max_x, float max_z, Fn&& fn) const {
+    visit_cells(min_x, min_z, max_x, max_z, [&](const Entry& entry) {
+      if (entry.x >= min_x && entry.x <= max_x && entry.z >= min_z &&
+          entry.z <= max_z) {
         fn(entry);
       }
     });
   }
 
+  struct RadiusQuery {
+    float x{0.0F};
+    float z{0.0F};
+    float radius{0.0F};
+    std::uint16_t require_flags{k_none};
+    std::uint16_t reject_flags{k_none};
+    std::uint64_t owner_mask{~std::uint64_t{0}};
+  };
+
+  struct BatchResult {
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> hits;
+
+    [[nodiscard]] auto query_count() const -> std::size_t {
+      return offsets.empty() ? 0U : offsets.size() - 1U;
+    }
+    [[nodiscard]] auto hits_for(std::size_t query) const
+        -> std::span<const std::uint32_t> {
+      return {hits.data() + offsets[query], hits.data() + offsets[query + 1U]};
+    }
+  };
+
+  static constexpr int k_owner_mask_bits = 64;
+
+  [[nodiscard]] static constexpr auto owner_bit(int owner_id) -> std::uint64_t {
+    return owner_id >= 0 && owner_id < k_owner_mask_bits
+               ? std::uint64_t{1} << static_cast<unsigned>(owner_id)
+               : std::uint64_t{0};
+  }
+
+  void query_radius_batch(std::span<const RadiusQuery> queries,
+                          BatchResult& out) const;
+
   [[nodiscard]] auto find(EntityID id) const -> const Entry*;
 
   [[nodiscard]] auto entries() const -> const std::vector<Entry>& { return m_entries; }
@@ -66,23 +114,39 @@ public:
     std::uint64_t queries{0};
     std::uint64_t candidates_examined{0};
     std::uint64_t entries_indexed{0};
+    std::uint64_t candidates_accepted{0};
   };
 
-  [[nodiscard]] auto stats() const -> const Stats& { return m_stats; }
-  void reset_stats() { m_stats = {}; }
+  [[nodiscard]] auto stats() const -> Stats {
+    return Stats{.rebuilds = m_rebuilds,
+                 .queries = m_queries.load(std::memory_order_relaxed),
+                 .candidates_examined =
+                     m_candidates_examined.load(std::memory_order_relaxed),
+                 .entries_indexed = m_entries_indexed,
+                 .candidates_accepted =
+                     m_candidates_accepted.load(std::memory_order_relaxed)};
+  }
+  void reset_stats() {
+    m_rebuilds = 0;
+    m_queries.store(0, std::memory_order_relaxed);
+    m_candidates_examined.store(0, std::memory_order_relaxed);
+    m_entries_indexed = 0;
+    m_candidates_accepted.store(0, std::memory_order_relaxed);
+  }
 
 private:
   template <typename Fn>
-  void visit_cells(float x, float z, float radius, Fn&& fn) const {
-    ++m_stats.queries;
+  void visit_cells(float min_x, float min_z, float max_x, float max_z, Fn&& fn) const {
+    m_queries.fetch_add(1, std::memory_order_relaxed);
     if (m_cells_x <= 0 || m_cells_z <= 0 || m_entries.empty()) {
       return;
     }
-    const int min_cx = clamp_cell(cell_of(x - radius, m_origin_x), m_cells_x);
-    const int max_cx = clamp_cell(cell_of(x + radius, m_origin_x), m_cells_x);
-    const int min_cz = clamp_cell(cell_of(z - radius, m_origin_z), m_cells_z);
-    const int max_cz = clamp_cell(cell_of(z + radius, m_origin_z), m_cells_z);
+    const int min_cx = clamp_cell(cell_of(min_x, m_origin_x), m_cells_x);
+    const int max_cx = clamp_cell(cell_of(max_x, m_origin_x), m_cells_x);
+    const int min_cz = clamp_cell(cell_of(min_z, m_origin_z), m_cells_z);
+    const int max_cz = clamp_cell(cell_of(max_z, m_origin_z), m_cells_z);
 
+    std::uint64_t examined = 0;
     for (int cz = min_cz; cz <= max_cz; ++cz) {
       const std::size_t row =
           static_cast<std::size_t>(cz) * static_cast<std::size_t>(m_cells_x);
@@ -90,14 +154,22 @@ private:
         const std::size_t cell = row + static_cast<std::size_t>(cx);
         const std::size_t begin = m_cell_start[cell];
         const std::size_t end = m_cell_start[cell + 1];
-        m_stats.candidates_examined += end - begin;
+        examined += end - begin;
         for (std::size_t i = begin; i < end; ++i) {
           fn(m_entries[i]);
         }
       }
     }
+    m_candidates_examined.fetch_add(examined, std::memory_order_relaxed);
   }
 
+  void index_entries(World& world);
+  void rebuild_columns();
+  void filter_span(const RadiusQuery& query,
+                   std::size_t begin,
+                   std::size_t end,
+                   std::vector<std::uint32_t>& hits) const;
+
   [[nodiscard]] auto cell_of(float value, float origin) const -> int;
   [[nodiscard]] static auto clamp_cell(int cell, int count) -> int;
 
@@ -119,10 +191,19 @@ private:
 
   std::vector<std::uint32_t> m_entry_by_slot;
 
-  std::uint64_t m_built_for_tick{0};
-  bool m_ever_built{false};
+  std::vector<float> m_column_x;
+  std::vector<float> m_column_z;
+  std::vector<std::uint32_t> m_column_flags;
+  std::vector<std::uint32_t> m_column_owner_bit;
+
+  std::atomic<std::uint64_t> m_built_for_tick{0};
+  std::mutex m_refresh_mutex;
 
-  mutable Stats m_stats;
+  std::uint64_t m_rebuilds{0};
+  std::uint64_t m_entries_indexed{0};
+  mutable std::atomic<std::uint64_t> m_queries{0};
+  mutable std::atomic<std::uint64_t> m_candidates_examined{0};
+  mutable std::atomic<std::uint64_t> m_candidates_accepted{0};
 };
 
 } // namespace Engine::Core
@@ -728,6 +728,15 @@ auto ArmyFormationRuntime::replan(Engine::Core::World& world,
   return true;
 }
 
+void ArmyFormationRuntime::defer_replan(Engine::Core::World& world,
+                                        FormationGroupID id) {
+  // A replan adds membership components to new members, so the runtime's own
+  // replans run at the phase barrier.
+  world.deferred().run([id](Engine::Core::World& at_barrier) {
+    static_cast<void>(replan(at_barrier, id));
+  });
+}
+
 void ArmyFormationRuntime::update(Engine::Core::World* world, float delta_time) {
   if (world == nullptr) {
     return;
@@ -769,7 +778,7 @@ void ArmyFormationRuntime::update(Engine::Core::World* world, float delta_time)
           !formation->has_destination || !formation->maintains_formation()) {
         continue;
       }
-      static_cast<void>(replan(*world, id));
+      defer_replan(*world, id);
     }
   }
 
@@ -796,7 +805,7 @@ void ArmyFormationRuntime::update(Engine::Core::World* world, float delta_time)
     if (formation == nullptr || !formation->needs_replan) {
       continue;
     }
-    static_cast<void>(replan(*world, id));
+    defer_replan(*world, id);
   }
 }
 
@@ -82,6 +82,7 @@ public:
 
 private:
   void advance_maintained_groups(Engine::Core::World& world, float delta_time);
+  static void defer_replan(Engine::Core::World& world, FormationGroupID id);
 
   float m_replan_accumulator{0.0F};
   float m_advance_accumulator{0.0F};
@@ -68,6 +68,89 @@ auto doctrine_for(const Engine::Core::UnitComponent& unit) -> FormationDoctrineI
   return default_doctrine_for_nation(unit.nation_id);
 }
 
+// Steps one troop's layout. `layout` is either the unit's own component or the
+// one the update is about to add to it.
+void advance_layout(Engine::Core::Entity& entity,
+                    const Engine::Core::UnitComponent& unit,
+                    Engine::Core::UnitLayoutStateComponent& layout,
+                    float delta_time) {
+  auto const troop = Game::Units::spawn_typeToTroopType(unit.spawn_type);
+  if (!troop.has_value()) {
+    return;
+  }
+
+  auto const doctrine = doctrine_for(unit);
+  auto const wanted = UnitLayoutStateSystem::desired_state(entity);
+  auto const current = static_cast<UnitLayoutState>(layout.state);
+  auto const wanted_layout = select_unit_layout(doctrine, *troop, wanted);
+
+  if (wanted == UnitLayoutState::Defensive) {
+    if (auto* transform = entity.get_component<Engine::Core::TransformComponent>()) {
+      if (current != UnitLayoutState::Defensive || !transform->has_desired_yaw) {
+        transform->desired_yaw = transform->rotation.y;
+        transform->has_desired_yaw = true;
+      }
+    }
+  }
+
+  if (layout.layout_id == k_invalid_layout) {
+    if (wanted != UnitLayoutState::Defensive) {
+      layout.state = static_cast<std::uint8_t>(wanted);
+      layout.layout_id = wanted_layout;
+      layout.requested_layout_id = wanted_layout;
+      layout.phase = static_cast<std::uint8_t>(LayoutPhase::Formed);
+      layout.transition_progress = 1.0F;
+      layout.transition_seconds = 0.0F;
+      return;
+    }
+
+    auto const normal_layout =
+        select_unit_layout(doctrine, *troop, UnitLayoutState::Normal);
+    layout.state = static_cast<std::uint8_t>(UnitLayoutState::Normal);
+    layout.layout_id = normal_layout;
+    layout.requested_layout_id = normal_layout;
+    layout.phase = static_cast<std::uint8_t>(LayoutPhase::Formed);
+    layout.transition_progress = 1.0F;
+    layout.transition_seconds = 0.0F;
+  }
+
+  if (wanted_layout != layout.requested_layout_id) {
+    layout.requested_layout_id = wanted_layout;
+    layout.transition_seconds =
+        Game::Formation::transition_seconds_for(entity, current, wanted);
+    layout.transition_progress = 0.0F;
+    layout.state = static_cast<std::uint8_t>(wanted);
+    if (layout.transition_seconds <= 0.0F) {
+      layout.layout_id = wanted_layout;
+      layout.phase = static_cast<std::uint8_t>(LayoutPhase::Formed);
+      layout.transition_progress = 1.0F;
+    } else if (current == UnitLayoutState::Defensive ||
+               current == UnitLayoutState::Braced) {
+      layout.phase = static_cast<std::uint8_t>(LayoutPhase::Breaking);
+    } else {
+      layout.layout_id = wanted_layout;
+      layout.phase = static_cast<std::uint8_t>(LayoutPhase::Forming);
+    }
+    return;
+  }
+
+  auto const phase = to_phase(layout.phase);
+  if (phase == LayoutPhase::Formed) {
+    layout.transition_progress = 1.0F;
+    return;
+  }
+
+  float const duration = std::max(0.05F, layout.transition_seconds);
+  layout.transition_progress =
+      std::min(1.0F, layout.transition_progress + (delta_time / duration));
+
+  if (layout.transition_progress >= 1.0F) {
+    layout.layout_id = layout.requested_layout_id;
+    layout.phase = static_cast<std::uint8_t>(LayoutPhase::Formed);
+    layout.transition_progress = 1.0F;
+  }
+}
+
 } // namespace
 
 auto UnitLayoutStateSystem::desired_state(const Engine::Core::Entity& entity)
@@ -152,107 +235,33 @@ void UnitLayoutStateSystem::update(Engine::Core::World* world, float delta_time)
     return;
   }
 
-  world->for_each_entity([delta_time](Engine::Core::Entity& entity) {
+  world->for_each_entity([world, delta_time](Engine::Core::Entity& entity) {
     const auto* unit = entity.get_component<Engine::Core::UnitComponent>();
     if (unit == nullptr || !Game::Units::is_troop_spawn(unit->spawn_type)) {
       return;
     }
 
-    auto* layout =
-        Engine::Core::get_or_add_component<Engine::Core::UnitLayoutStateComponent>(
-            &entity);
-    if (layout == nullptr) {
-      return;
-    }
-
-    auto const troop = Game::Units::spawn_typeToTroopType(unit->spawn_type);
-    if (!troop.has_value()) {
-      return;
-    }
-
-    auto const doctrine = doctrine_for(*unit);
-    auto const wanted = desired_state(entity);
-    auto const current = static_cast<UnitLayoutState>(layout->state);
-    auto const wanted_layout = select_unit_layout(doctrine, *troop, wanted);
-
-    if (wanted == UnitLayoutState::Defensive) {
-      if (auto* transform = entity.get_component<Engine::Core::TransformComponent>()) {
-        if (current != UnitLayoutState::Defensive || !transform->has_desired_yaw) {
-          transform->desired_yaw = transform->rotation.y;
-          transform->has_desired_yaw = true;
-        }
-      }
-    }
-
-    if (layout->layout_id == k_invalid_layout) {
-      if (wanted != UnitLayoutState::Defensive) {
-        layout->state = static_cast<std::uint8_t>(wanted);
-        layout->layout_id = wanted_layout;
-        layout->requested_layout_id = wanted_layout;
-        layout->phase = static_cast<std::uint8_t>(LayoutPhase::Formed);
-        layout->transition_progress = 1.0F;
-        layout->transition_seconds = 0.0F;
-        return;
-      }
-
-      auto const normal_layout =
-          select_unit_layout(doctrine, *troop, UnitLayoutState::Normal);
-      layout->state = static_cast<std::uint8_t>(UnitLayoutState::Normal);
-      layout->layout_id = normal_layout;
-      layout->requested_layout_id = normal_layout;
-      layout->phase = static_cast<std::uint8_t>(LayoutPhase::Formed);
-      layout->transition_progress = 1.0F;
-      layout->transition_seconds = 0.0F;
-    }
-
-    if (wanted_layout != layout->requested_layout_id) {
-      layout->requested_layout_id = wanted_layout;
-      layout->transition_seconds =
-          Game::Formation::transition_seconds_for(entity, current, wanted);
-      layout->transition_progress = 0.0F;
-      layout->state = static_cast<std::uint8_t>(wanted);
-      if (layout->transition_seconds <= 0.0F) {
-        layout->layout_id = wanted_layout;
-        layout->phase = static_cast<std::uint8_t>(LayoutPhase::Formed);
-        layout->transition_progress = 1.0F;
-      } else if (current == UnitLayoutState::Defensive ||
-                 current == UnitLayoutState::Braced) {
-        layout->phase = static_cast<std::uint8_t>(LayoutPhase::Breaking);
-      } else {
-        layout->layout_id = wanted_layout;
-        layout->phase = static_cast<std::uint8_t>(LayoutPhase::Forming);
-      }
-      return;
-    }
-
-    auto const phase = to_phase(layout->phase);
-    if (phase == LayoutPhase::Formed) {
-      layout->transition_progress = 1.0F;
+    if (auto* layout = entity.get_component<Engine::Core::UnitLayoutStateComponent>()) {
+      advance_layout(entity, *unit, *layout, delta_time);
       return;
     }
-
-    float const duration = std::max(0.05F, layout->transition_seconds);
-    layout->transition_progress =
-        std::min(1.0F, layout->transition_progress + (delta_time / duration));
-
-    if (layout->transition_progress >= 1.0F) {
-      layout->layout_id = layout->requested_layout_id;
-      layout->phase = static_cast<std::uint8_t>(LayoutPhase::Formed);
-      layout->transition_progress = 1.0F;
-    }
+    // Units join at the phase barrier, with their first step already taken.
+    Engine::Core::UnitLayoutStateComponent added;
+    advance_layout(entity, *unit, added, delta_time);
+    world->deferred().add_component<Engine::Core::UnitLayoutStateComponent>(
+        entity.get_id(), added);
   });
 }
 
 auto UnitLayoutStateSystem::access() const -> Engine::Core::SystemAccess {
   using namespace Engine::Core;
   return SystemAccess::declare(Reads<UnitComponent,
-                                     TransformComponent,
                                      MovementComponent,
                                      AttackComponent,
                                      GuardModeComponent,
                                      HoldModeComponent,
                                      MoraleComponent>{},
-                               Writes<UnitLayoutStateComponent>{});
+                               Writes<UnitLayoutStateComponent, TransformComponent>{});
 }
 
 } // namespace Game::Formation
@@ -0,0 +1,219 @@
+#include "heightfield_quadtree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Game::Map {
+
+namespace {
+
+constexpr float k_parallel_epsilon = 1.0e-8F;
+constexpr float k_span_merge_epsilon = 1.0e-4F;
+
+auto clip_axis(float origin,
+               float direction,
+               float lo,
+               float hi,
+               float& t_enter,
+               float& t_exit) -> bool {
+  if (std::abs(direction) < k_parallel_epsilon) {
+    return origin >= lo && origin <= hi;
+  }
+  float const inverse = 1.0F / direction;
+  float near_t = (lo - origin) * inverse;
+  float far_t = (hi - origin) * inverse;
+  if (near_t > far_t) {
+    std::swap(near_t, far_t);
+  }
+  t_enter = std::max(t_enter, near_t);
+  t_exit = std::min(t_exit, far_t);
+  return t_enter <= t_exit;
+}
+
+} // namespace
+
+void HeightfieldQuadtree::clear() {
+  m_levels.clear();
+  m_cells_x = 0;
+  m_cells_z = 0;
+}
+
+void HeightfieldQuadtree::build(int width,
+                                int height,
+                                float tile_size,
+                                std::span<const float> vertex_heights,
+                                float height_slack) {
+  clear();
+  if (width < 2 || height < 2 || tile_size <= 0.0F ||
+      vertex_heights.size() <
+          static_cast<std::size_t>(width) * static_cast<std::size_t>(height)) {
+    return;
+  }
+  m_cells_x = width - 1;
+  m_cells_z = height - 1;
+  m_tile_size = tile_size;
+  m_origin_x = -(static_cast<float>(width) * 0.5F - 0.5F) * tile_size;
+  m_origin_z = -(static_cast<float>(height) * 0.5F - 0.5F) * tile_size;
+
+  Level leaves;
+  leaves.columns = (m_cells_x + k_leaf_cells - 1) / k_leaf_cells;
+  leaves.rows = (m_cells_z + k_leaf_cells - 1) / k_leaf_cells;
+  std::size_t const leaf_total =
+      static_cast<std::size_t>(leaves.columns) * static_cast<std::size_t>(leaves.rows);
+  leaves.min_heights.assign(leaf_total, std::numeric_limits<float>::max());
+  leaves.max_heights.assign(leaf_total, std::numeric_limits<float>::lowest());
+  for (int z = 0; z < height; ++z) {
+    int const row_lo = std::max(0, (z - 1) / k_leaf_cells);
+    int const row_hi = std::min(leaves.rows - 1, z / k_leaf_cells);
+    for (int x = 0; x < width; ++x) {
+      float const h =
+          vertex_heights[static_cast<std::size_t>(z) * static_cast<std::size_t>(width) +
+                         static_cast<std::size_t>(x)];
+      int const column_lo = std::max(0, (x - 1) / k_leaf_cells);
+      int const column_hi = std::min(leaves.columns - 1, x / k_leaf_cells);
+      for (int row = row_lo; row <= row_hi; ++row) {
+        for (int column = column_lo; column <= column_hi; ++column) {
+          std::size_t const leaf =
+              static_cast<std::size_t>(row) * static_cast<std::size_t>(leaves.columns) +
+              static_cast<std::size_t>(column);
+          leaves.min_heights[leaf] = std::min(leaves.min_heights[leaf], h);
+          leaves.max_heights[leaf] = std::max(leaves.max_heights[leaf], h);
+        }
+      }
+    }
+  }
+  for (std::size_t i = 0; i < leaf_total; ++i) {
+    leaves.min_heights[i] -= height_slack;
+    leaves.max_heights[i] += height_slack;
+  }
+  m_levels.push_back(std::move(leaves));
+
+  while (m_levels.back().columns > 1 || m_levels.back().rows > 1) {
+    Level const& child = m_levels.back();
+    Level parent;
+    parent.columns = (child.columns + 1) / 2;
+    parent.rows = (child.rows + 1) / 2;
+    std::size_t const parent_total = static_cast<std::size_t>(parent.columns) *
+                                     static_cast<std::size_t>(parent.rows);
+    parent.min_heights.assign(parent_total, std::numeric_limits<float>::max());
+    parent.max_heights.assign(parent_total, std::numeric_limits<float>::lowest());
+    for (int row = 0; row < child.rows; ++row) {
+      for (int column = 0; column < child.columns; ++column) {
+        std::size_t const from =
+            static_cast<std::size_t>(row) * static_cast<std::size_t>(child.columns) +
+            static_cast<std::size_t>(column);
+        std::size_t const to = static_cast<std::size_t>(row / 2) *
+                                   static_cast<std::size_t>(parent.columns) +
+                               static_cast<std::size_t>(column / 2);
+        parent.min_heights[to] =
+            std::min(parent.min_heights[to], child.min_heights[from]);
+        parent.max_heights[to] =
+            std::max(parent.max_heights[to], child.max_heights[from]);
+      }
+    }
+    m_levels.push_back(std::move(parent));
+  }
+}
+
+auto HeightfieldQuadtree::min_height() const -> float {
+  return m_levels.empty() ? 0.0F : m_levels.back().min_heights.front();
+}
+
+auto HeightfieldQuadtree::max_height() const -> float {
+  return m_levels.empty() ? 0.0F : m_levels.back().max_heights.front();
+}
+
+auto HeightfieldQuadtree::leaf_count() const -> std::size_t {
+  return m_levels.empty() ? 0U : m_levels.front().min_heights.size();
+}
+
+void HeightfieldQuadtree::collect_ray_spans(const QVector3D& origin,
+                                            const QVector3D& direction,
+                                            float max_t,
+                                            std::vector<RaySpan>& out) const {
+  out.clear();
+  if (m_levels.empty() || max_t <= 0.0F) {
+    return;
+  }
+  Ray const ray{.origin = origin, .direction = direction, .max_t = max_t};
+  visit(m_levels.size() - 1U, 0, 0, ray, out);
+}
+
+auto HeightfieldQuadtree::clip_node(std::size_t level,
+                                    int column,
+                                    int row,
+                                    const Ray& ray,
+                                    RaySpan& span) const -> bool {
+  Level const& nodes = m_levels[level];
+  std::size_t const index =
+      static_cast<std::size_t>(row) * static_cast<std::size_t>(nodes.columns) +
+      static_cast<std::size_t>(column);
+  int const node_cells = k_leaf_cells << level;
+  float const min_x =
+      m_origin_x + static_cast<float>(column * node_cells) * m_tile_size;
+  float const max_x =
+      m_origin_x +
+      static_cast<float>(std::min((column + 1) * node_cells, m_cells_x)) * m_tile_size;
+  float const min_z = m_origin_z + static_cast<float>(row * node_cells) * m_tile_size;
+  float const max_z =
+      m_origin_z +
+      static_cast<float>(std::min((row + 1) * node_cells, m_cells_z)) * m_tile_size;
+
+  span.t_enter = 0.0F;
+  span.t_exit = ray.max_t;
+  return clip_axis(ray.origin.x(),
+                   ray.direction.x(),
+                   min_x,
+                   max_x,
+                   span.t_enter,
+                   span.t_exit) &&
+         clip_axis(ray.origin.z(),
+                   ray.direction.z(),
+                   min_z,
+                   max_z,
+                   span.t_enter,
+                   span.t_exit) &&
+         clip_axis(ray.origin.y(),
+                   ray.direction.y(),
+                   nodes.min_heights[index],
+                   nodes.max_heights[index],
+                   span.t_enter,
+                   span.t_exit);
+}
+
+void HeightfieldQuadtree::visit(std::size_t level,
+                                int column,
+                                int row,
+                                const Ray& ray,
+                                std::vector<RaySpan>& out) const {
+  RaySpan span;
+  if (!clip_node(level, column, row, ray, span)) {
+    return;
+  }
+  if (level == 0U) {
+    if (!out.empty() && span.t_enter <= out.back().t_exit + k_span_merge_epsilon) {
+      out.back().t_exit = std::max(out.back().t_exit, span.t_exit);
+    } else {
+      out.push_back(span);
+    }
+    return;
+  }
+
+  Level const& children = m_levels[level - 1U];
+  int const near_column = ray.direction.x() < 0.0F ? 1 : 0;
+  int const near_row = ray.direction.z() < 0.0F ? 1 : 0;
+  int const order[4][2] = {{near_column, near_row},
+                           {1 - near_column, near_row},
+                           {near_column, 1 - near_row},
+                           {1 - near_column, 1 - near_row}};
+  for (auto const& offset : order) {
+    int const child_column = column * 2 + offset[0];
+    int const child_row = row * 2 + offset[1];
+    if (child_column < children.columns && child_row < children.rows) {
+      visit(level - 1U, child_column, child_row, ray, out);
+    }
+  }
+}
+
+} // namespace Game::Map
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QVector3D>
+
+#include <span>
+#include <vector>
+
+namespace Game::Map {
+
+class HeightfieldQuadtree {
+public:
+  struct RaySpan {
+    float t_enter{0.0F};
+    float t_exit{0.0F};
+  };
+
+  static constexpr int k_leaf_cells = 8;
+
+  void build(int width,
+             int height,
+             float tile_size,
+             std::span<const float> vertex_heights,
+             float height_slack);
+  void clear();
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return m_levels.empty(); }
+  [[nodiscard]] auto min_height() const -> float;
+  [[nodiscard]] auto max_height() const -> float;
+  [[nodiscard]] auto leaf_count() const -> std::size_t;
+
+  void collect_ray_spans(const QVector3D& origin,
+                         const QVector3D& direction,
+                         float max_t,
+                         std::vector<RaySpan>& out) const;
+
+private:
+  struct Level {
+    int columns{0};
+    int rows{0};
+    std::vector<float> min_heights;
+    std::vector<float> max_heights;
+  };
+
+  struct Ray {
+    QVector3D origin;
+    QVector3D direction;
+    float max_t{0.0F};
+  };
+
+  void visit(std::size_t level,
+             int column,
+             int row,
+             const Ray& ray,
+             std::vector<RaySpan>& out) const;
+  [[nodiscard]] auto clip_node(std::size_t level,
+                               int column,
+                               int row,
+                               const Ray& ray,
+                               RaySpan& span) const -> bool;
+
+  int m_cells_x{0};
+  int m_cells_z{0};
+  float m_tile_size{1.0F};
+  float m_origin_x{0.0F};
+  float m_origin_z{0.0F};
+  std::vector<Level> m_levels;
+};
+
+} // namespace Game::Map
@@ -8,6 +8,7 @@
 #include <cmath>
 #include <memory>
 #include <optional>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -17,6 +18,7 @@
 #include "map_definition.h"
 #include "procedural_tree_generation.h"
 #include "terrain.h"
+#include "world_prop_index.h"
 
 namespace Game::Map {
 
@@ -29,6 +31,7 @@ namespace {
 constexpr float k_min_tile_size = 0.0001F;
 constexpr float k_harvest_grid_snap_distance = 3.0F;
 constexpr float k_road_index_tile_span = 8.0F;
+constexpr float k_height_quadtree_slack = 0.05F;
 
 auto authored_grid_to_world(float grid_coord, int grid_size, float tile_size) -> float {
   float const safe_tile_size = std::max(tile_size, k_min_tile_size);
@@ -60,22 +63,45 @@ auto world_prop_grid_position(const TerrainHeightMap* height_map,
   return {prop.x / safe_tile_size + half_w, prop.z / safe_tile_size + half_h};
 }
 
-auto make_world_prop_target(const TerrainHeightMap* height_map,
-                            CoordSystem coord_system,
-                            const WorldProp& prop) -> WorldPropTarget {
+auto make_world_prop_entry(const TerrainHeightMap* height_map,
+                           CoordSystem coord_system,
+                           const WorldProp& prop) -> WorldPropIndex::Entry {
   auto const [world_x, world_z] = world_prop_world_xz(height_map, coord_system, prop);
-  return WorldPropTarget{.id = prop.id, .type = prop.type, .x = world_x, .z = world_z};
+  auto const [grid_x, grid_z] =
+      world_prop_grid_position(height_map, coord_system, prop);
+  return WorldPropIndex::Entry{.id = prop.id,
+                               .type = prop.type,
+                               .grid_x = grid_x,
+                               .grid_z = grid_z,
+                               .world_x = world_x,
+                               .world_z = world_z};
+}
+
+auto make_world_prop_target(const WorldPropIndex::Entry& entry) -> WorldPropTarget {
+  return WorldPropTarget{
+      .id = entry.id, .type = entry.type, .x = entry.world_x, .z = entry.world_z};
+}
+
+auto closer_world_prop(float distance_sq,
+                       float tie_distance_sq,
+                       std::uint64_t id,
+                       const WorldPropIndex::Entry* best,
+                       float best_distance_sq,
+                       float best_tie_distance_sq) -> bool {
+  if (best == nullptr) {
+    return true;
+  }
+  return std::tie(distance_sq, tie_distance_sq, id) <
+         std::tie(best_distance_sq, best_tie_distance_sq, best->id);
 }
 
-template <typename Predicate>
 auto find_world_prop_near_world(const TerrainHeightMap* height_map,
-                                CoordSystem coord_system,
-                                const std::vector<WorldProp>& world_props,
-                                const std::unordered_set<std::uint64_t>& reserved_ids,
+                                const WorldPropIndex& index,
+                                HarvestPropKind kind,
                                 float world_x,
                                 float world_z,
-                                float max_world_distance,
-                                Predicate&& matches) -> std::optional<WorldPropTarget> {
+                                float max_world_distance)
+    -> std::optional<WorldPropTarget> {
   float const max_distance_sq =
       std::max(max_world_distance, 0.0F) * std::max(max_world_distance, 0.0F);
   float const safe_tile_size =
@@ -93,88 +119,100 @@ auto find_world_prop_near_world(const TerrainHeightMap* height_map,
            : 0.0F);
   float const max_grid_distance_sq =
       k_harvest_grid_snap_distance * k_harvest_grid_snap_distance;
-  const WorldProp* best = nullptr;
-  float best_distance_sq = max_distance_sq;
-  float best_grid_distance_sq = max_grid_distance_sq;
-  for (const auto& prop : world_props) {
-    if (!matches(prop.type) || reserved_ids.contains(prop.id)) {
-      continue;
-    }
-    auto const [prop_world_x, prop_world_z] =
-        world_prop_world_xz(height_map, coord_system, prop);
-    auto const [prop_grid_x, prop_grid_z] =
-        world_prop_grid_position(height_map, coord_system, prop);
-    float const dx = prop_world_x - world_x;
-    float const dz = prop_world_z - world_z;
-    float const distance_sq = dx * dx + dz * dz;
-    float const grid_dx = prop_grid_x - query_grid_x;
-    float const grid_dz = prop_grid_z - query_grid_z;
-    float const grid_distance_sq = grid_dx * grid_dx + grid_dz * grid_dz;
-    bool const within_world_distance = distance_sq <= max_distance_sq;
-    bool const within_grid_distance = grid_distance_sq <= max_grid_distance_sq;
-    if (!within_world_distance && !within_grid_distance) {
-      continue;
-    }
-    if (within_world_distance) {
-      if (best == nullptr || distance_sq < best_distance_sq ||
-          (distance_sq == best_distance_sq &&
-           grid_distance_sq < best_grid_distance_sq)) {
-        best = &prop;
+  float const search_radius =
+      std::max(std::max(max_world_distance, 0.0F) / safe_tile_size,
+               k_harvest_grid_snap_distance);
+  const WorldPropIndex::Entry* best = nullptr;
+  bool best_within_world_distance = false;
+  float best_distance_sq = 0.0F;
+  float best_grid_distance_sq = 0.0F;
+  index.for_each_unreserved(
+      kind,
+      query_grid_x,
+      query_grid_z,
+      search_radius,
+      [&](const WorldPropIndex::Entry& entry) {
+        float const dx = entry.world_x - world_x;
+        float const dz = entry.world_z - world_z;
+        float const distance_sq = dx * dx + dz * dz;
+        float const grid_dx = entry.grid_x - query_grid_x;
+        float const grid_dz = entry.grid_z - query_grid_z;
+        float const grid_distance_sq = grid_dx * grid_dx + grid_dz * grid_dz;
+        bool const within_world_distance = distance_sq <= max_distance_sq;
+        if (!within_world_distance && grid_distance_sq > max_grid_distance_sq) {
+          return;
+        }
+        if (best != nullptr && best_within_world_distance && !within_world_distance) {
+          return;
+        }
+        bool const promotes = !best_within_world_distance && within_world_distance;
+        bool const closer =
+            within_world_distance
+                ? closer_world_prop(distance_sq,
+                                    grid_distance_sq,
+                                    entry.id,
+                                    best,
+                                    best_distance_sq,
+                                    best_grid_distance_sq)
+                : closer_world_prop(grid_distance_sq,
+                                    distance_sq,
+                                    entry.id,
+                                    best,
+                                    best_grid_distance_sq,
+                                    best_distance_sq);
+        if (!promotes && !closer) {
+          return;
+        }
+        best = &entry;
+        best_within_world_distance = within_world_distance;
         best_distance_sq = distance_sq;
         best_grid_distance_sq = grid_distance_sq;
-      }
-      continue;
-    }
-    if (best != nullptr && best_distance_sq < max_distance_sq) {
-      continue;
-    }
-    if (grid_distance_sq > best_grid_distance_sq ||
-        (grid_distance_sq == best_grid_distance_sq &&
-         distance_sq >= best_distance_sq)) {
-      continue;
-    }
-    best = &prop;
-    best_distance_sq = distance_sq;
-    best_grid_distance_sq = grid_distance_sq;
-  }
+      });
   if (best == nullptr) {
     return std::nullopt;
   }
-  return make_world_prop_target(height_map, coord_system, *best);
+  return make_world_prop_target(*best);
 }
 
-template <typename Predicate>
-auto find_world_prop_near_grid(const TerrainHeightMap* height_map,
-                               CoordSystem coord_system,
-                               const std::vector<WorldProp>& world_props,
-                               const std::unordered_set<std::uint64_t>& reserved_ids,
+auto find_world_prop_near_grid(const WorldPropIndex& index,
+                               HarvestPropKind kind,
                                float grid_x,
                                float grid_z,
-                               float max_grid_distance,
-                               Predicate&& matches) -> std::optional<WorldPropTarget> {
-  float const max_distance_sq =
-      std::max(max_grid_distance, 0.0F) * std::max(max_grid_distance, 0.0F);
-  const WorldProp* best = nullptr;
+                               float max_grid_distance)
+    -> std::optional<WorldPropTarget> {
+  float const max_distance = std::max(max_grid_distance, 0.0F);
+  float const max_distance_sq = max_distance * max_distance;
+  const WorldPropIndex::Entry* best = nullptr;
   float best_distance_sq = max_distance_sq;
-  for (const auto& prop : world_props) {
-    if (!matches(prop.type) || reserved_ids.contains(prop.id)) {
-      continue;
-    }
-    auto const [prop_grid_x, prop_grid_z] =
-        world_prop_grid_position(height_map, coord_system, prop);
-    float const dx = prop_grid_x - grid_x;
-    float const dz = prop_grid_z - grid_z;
-    float const distance_sq = dx * dx + dz * dz;
-    if (distance_sq > best_distance_sq) {
-      continue;
-    }
-    best = &prop;
-    best_distance_sq = distance_sq;
-  }
+  index.for_each_unreserved(
+      kind, grid_x, grid_z, max_distance, [&](const WorldPropIndex::Entry& entry) {
+        float const dx = entry.grid_x - grid_x;
+        float const dz = entry.grid_z - grid_z;
+        float const distance_sq = dx * dx + dz * dz;
+        if (distance_sq > max_distance_sq ||
+            !closer_world_prop(
+                distance_sq, 0.0F, entry.id, best, best_distance_sq, 0.0F)) {
+          return;
+        }
+        best = &entry;
+        best_distance_sq = distance_sq;
+      });
   if (best == nullptr) {
     return std::nullopt;
   }
-  return make_world_prop_target(height_map, coord_system, *best);
+  return make_world_prop_target(*best);
+}
+
+auto find_world_prop_by_id(const WorldPropIndex& index,
+                           std::uint64_t world_prop_id,
+                           std::optional<HarvestPropKind> kind)
+    -> std::optional<WorldPropTarget> {
+  const WorldPropIndex::Entry* entry = index.find(world_prop_id);
+  if (entry == nullptr ||
+      (kind.has_value() && harvest_prop_kind(entry->type) != kind)) {
+    return std::nullopt;
+  }
+  return make_world_prop_target(*entry);
 }
 
 auto build_runtime_world_props(const TerrainHeightMap& height_map,
@@ -215,26 +253,6 @@ auto has_runtime_harvest_props(const std::vector<WorldProp>& world_props) -> boo
   });
 }
 
-template <typename Predicate>
-auto find_world_prop_by_id(const TerrainHeightMap* height_map,
-                           CoordSystem coord_system,
-                           const std::vector<WorldProp>& world_props,
-                           std::uint64_t world_prop_id,
-                           Predicate&& matches) -> std::optional<WorldPropTarget> {
-  if (world_prop_id == 0) {
-    return std::nullopt;
-  }
-  const auto it = std::find_if(world_props.begin(),
-                               world_props.end(),
-                               [world_prop_id, &matches](const WorldProp& prop) {
-                                 return prop.id == world_prop_id && matches(prop.type);
-                               });
-  if (it == world_props.end()) {
-    return std::nullopt;
-  }
-  return make_world_prop_target(height_map, coord_system, *it);
-}
-
 auto sample_grid_clamped(
     const std::vector<float>& values, int width, int height, int x, int z) -> float {
   if (values.empty() || width <= 0 || height <= 0) {
@@ -389,6 +407,7 @@ void TerrainService::initialize(const MapDefinition& map_def) {
   normalize_world_props(m_world_props);
   sync_world_prop_identity_state();
   rebuild_terrain_field();
+  rebuild_height_quadtree();
   bump_authored_world_props_revision();
   bump_world_props_revision();
   bump_navigation_topology_revision();
@@ -400,6 +419,7 @@ void TerrainService::clear() {
   m_prop_surface_cache.clear();
   m_prop_surface_cache_valid = false;
   m_terrain_field.clear();
+  m_height_quadtree.clear();
   m_biome_settings = BiomeSettings();
   m_coord_system = CoordSystem::Grid;
   m_authored_world_props.clear();
@@ -411,7 +431,7 @@ void TerrainService::clear() {
   m_road_index_segment_ids.clear();
   m_road_index_columns = 0;
   m_road_index_rows = 0;
-  m_reserved_world_prop_ids.clear();
+  m_world_prop_index.reset(0, 0);
   m_next_world_prop_id = 1;
   bump_authored_world_props_revision();
   bump_world_props_revision();
@@ -464,6 +484,7 @@ auto TerrainService::add_world_prop_at_world(WorldProp prop,
   prop.id = m_next_world_prop_id++;
   m_authored_world_props.push_back(prop);
   m_world_props.push_back(prop);
+  index_world_prop(prop);
   bump_authored_world_props_revision();
   bump_world_props_revision();
   return prop.id;
@@ -474,36 +495,24 @@ auto TerrainService::find_tree_near_world(float world_x,
                                           float max_world_distance) const
     -> std::optional<WorldPropTarget> {
   return find_world_prop_near_world(m_height_map.get(),
-                                    m_coord_system,
-                                    m_world_props,
-                                    m_reserved_world_prop_ids,
+                                    m_world_prop_index,
+                                    HarvestPropKind::Tree,
                                     world_x,
                                     world_z,
-                                    max_world_distance,
-                                    is_tree_world_prop_type);
+                                    max_world_distance);
 }
 
 auto TerrainService::find_tree_near_grid(float grid_x,
                                          float grid_z,
                                          float max_grid_distance) const
     -> std::optional<WorldPropTarget> {
-  return find_world_prop_near_grid(m_height_map.get(),
-                                   m_coord_system,
-                                   m_world_props,
-                                   m_reserved_world_prop_ids,
-                                   grid_x,
-                                   grid_z,
-                                   max_grid_distance,
-                                   is_tree_world_prop_type);
+  return find_world_prop_near_grid(
+      m_world_prop_index, HarvestPropKind::Tree, grid_x, grid_z, max_grid_distance);
 }
 
 auto TerrainService::find_tree_by_id(std::uint64_t tree_id) const
     -> std::optional<WorldPropTarget> {
-  return find_world_prop_by_id(m_height_map.get(),
-                               m_coord_system,
-                               m_world_props,
-                               tree_id,
-                               is_tree_world_prop_type);
+  return find_world_prop_by_id(m_world_prop_index, tree_id, HarvestPropKind::Tree);
 }
 
 auto TerrainService::find_boulder_near_world(float world_x,
@@ -511,36 +520,25 @@ auto TerrainService::find_boulder_near_world(float world_x,
                                              float max_world_distance) const
     -> std::optional<WorldPropTarget> {
   return find_world_prop_near_world(m_height_map.get(),
-                                    m_coord_system,
-                                    m_world_props,
-                                    m_reserved_world_prop_ids,
+                                    m_world_prop_index,
+                                    HarvestPropKind::Boulder,
                                     world_x,
                                     world_z,
-                                    max_world_distance,
-                                    is_boulder_world_prop_type);
+                                    max_world_distance);
 }
 
 auto TerrainService::find_boulder_near_grid(float grid_x,
                                             float grid_z,
                                             float max_grid_distance) const
     -> std::optional<WorldPropTarget> {
-  return find_world_prop_near_grid(m_height_map.get(),
-                                   m_coord_system,
-                                   m_world_props,
-                                   m_reserved_world_prop_ids,
-                                   grid_x,
-                                   grid_z,
-                                   max_grid_distance,
-                                   is_boulder_world_prop_type);
+  return find_world_prop_near_grid(
+      m_world_prop_index, HarvestPropKind::Boulder, grid_x, grid_z, max_grid_distance);
 }
 
 auto TerrainService::find_boulder_by_id(std::uint64_t boulder_id) const
     -> std::optional<WorldPropTarget> {
-  return find_world_prop_by_id(m_height_map.get(),
-                               m_coord_system,
-                               m_world_props,
-                               boulder_id,
-                               is_boulder_world_prop_type);
+  return find_world_prop_by_id(
+      m_world_prop_index, boulder_id, HarvestPropKind::Boulder);
 }
 
 auto TerrainService::find_iron_ore_near_world(float world_x,
@@ -548,85 +546,64 @@ auto TerrainService::find_iron_ore_near_world(float world_x,
                                               float max_world_distance) const
     -> std::optional<WorldPropTarget> {
   return find_world_prop_near_world(m_height_map.get(),
-                                    m_coord_system,
-                                    m_world_props,
-                                    m_reserved_world_prop_ids,
+                                    m_world_prop_index,
+                                    HarvestPropKind::IronOre,
                                     world_x,
                                     world_z,
-                                    max_world_distance,
-                                    is_iron_ore_world_prop_type);
+                                    max_world_distance);
 }
 
 auto TerrainService::find_iron_ore_near_grid(float grid_x,
                                              float grid_z,
                                              float max_grid_distance) const
     -> std::optional<WorldPropTarget> {
-  return find_world_prop_near_grid(m_height_map.get(),
-                                   m_coord_system,
-                                   m_world_props,
-                                   m_reserved_world_prop_ids,
-                                   grid_x,
-                                   grid_z,
-                                   max_grid_distance,
-                                   is_iron_ore_world_prop_type);
+  return find_world_prop_near_grid(
+      m_world_prop_index, HarvestPropKind::IronOre, grid_x, grid_z, max_grid_distance);
 }
 
 auto TerrainService::find_iron_ore_by_id(std::uint64_t iron_ore_id) const
     -> std::optional<WorldPropTarget> {
-  return find_world_prop_by_id(m_height_map.get(),
-                               m_coord_system,
-                               m_world_props,
-                               iron_ore_id,
-                               is_iron_ore_world_prop_type);
+  return find_world_prop_by_id(
+      m_world_prop_index, iron_ore_id, HarvestPropKind::IronOre);
 }
 
 auto TerrainService::find_harvestable_world_prop_by_id(
     std::uint64_t world_prop_id) const -> std::optional<WorldPropTarget> {
-  return find_world_prop_by_id(m_height_map.get(),
-                               m_coord_system,
-                               m_world_props,
-                               world_prop_id,
-                               is_harvestable_world_prop_type);
+  return find_world_prop_by_id(m_world_prop_index, world_prop_id, std::nullopt);
 }
 
 auto TerrainService::is_world_prop_reserved(std::uint64_t world_prop_id) const -> bool {
-  return world_prop_id != 0 && m_reserved_world_prop_ids.contains(world_prop_id);
+  const WorldPropIndex::Entry* entry = m_world_prop_index.find(world_prop_id);
+  return entry != nullptr && entry->reserved;
 }
 
 auto TerrainService::reserve_world_prop(std::uint64_t world_prop_id) -> bool {
-  if (!find_world_prop_by_id(m_height_map.get(),
-                             m_coord_system,
-                             m_world_props,
-                             world_prop_id,
-                             is_harvestable_world_prop_type)
-           .has_value() ||
-      m_reserved_world_prop_ids.contains(world_prop_id)) {
+  const WorldPropIndex::Entry* entry = m_world_prop_index.find(world_prop_id);
+  if (entry == nullptr || entry->reserved) {
     return false;
   }
-  m_reserved_world_prop_ids.insert(world_prop_id);
-  return true;
+  return m_world_prop_index.set_reserved(world_prop_id, true);
 }
 
 void TerrainService::release_world_prop(std::uint64_t world_prop_id) {
   if (world_prop_id == 0) {
     return;
   }
-  m_reserved_world_prop_ids.erase(world_prop_id);
+  m_world_prop_index.set_reserved(world_prop_id, false);
 }
 
 auto TerrainService::harvest_world_prop(std::uint64_t world_prop_id) -> bool {
+  if (!m_world_prop_index.remove(world_prop_id)) {
+    return false;
+  }
   const auto it = std::find_if(m_world_props.begin(),
                                m_world_props.end(),
                                [world_prop_id](const WorldProp& prop) {
-                                 return prop.id == world_prop_id &&
-                                        is_harvestable_world_prop_type(prop.type);
+                                 return prop.id == world_prop_id;
                                });
-  if (it == m_world_props.end()) {
-    release_world_prop(world_prop_id);
-    return false;
+  if (it != m_world_props.end()) {
+    m_world_props.erase(it);
   }
-  m_world_props.erase(it);
-  release_world_prop(world_prop_id);
   bump_world_props_revision();
   return true;
 }
@@ -1042,6 +1019,7 @@ void TerrainService::restore_from_serialized(
   }
   sync_world_prop_identity_state();
   rebuild_terrain_field();
+  rebuild_height_quadtree();
   bump_authored_world_props_revision();
   bump_world_props_revision();
   bump_navigation_topology_revision();
@@ -1128,6 +1106,37 @@ auto TerrainService::get_bridge_traversal_position(float world_x, float world_z)
   return m_height_map->getBridgeTraversalPosition(world_x, world_z);
 }
 
+void TerrainService::rebuild_height_quadtree() {
+  m_height_quadtree.clear();
+  if (!m_height_map) {
+    return;
+  }
+
+  const int width = m_height_map->get_width();
+  const int height = m_height_map->get_height();
+  const float tile = m_height_map->get_tile_size();
+  const float half_width = static_cast<float>(width) * 0.5F - 0.5F;
+  const float half_height = static_cast<float>(height) * 0.5F - 0.5F;
+  std::vector<float> surface(static_cast<std::size_t>(width) *
+                             static_cast<std::size_t>(height));
+  for (int z = 0; z < height; ++z) {
+    for (int x = 0; x < width; ++x) {
+      const float world_x = (static_cast<float>(x) - half_width) * tile;
+      const float world_z = (static_cast<float>(z) - half_height) * tile;
+      surface[static_cast<std::size_t>(z) * static_cast<std::size_t>(width) +
+              static_cast<std::size_t>(x)] =
+          sample_surface_height(world_x, world_z).world_y;
+    }
+  }
+
+  float bridge_rise = 0.0F;
+  for (const auto& bridge : m_height_map->get_bridges()) {
+    bridge_rise = std::max(bridge_rise, bridge.height);
+  }
+  const float slack = k_road_surface_y_offset + bridge_rise + k_height_quadtree_slack;
+  m_height_quadtree.build(width, height, tile, surface, slack);
+}
+
 void TerrainService::rebuild_terrain_field() {
   m_terrain_field.clear();
 
@@ -1193,8 +1202,6 @@ void TerrainService::normalize_world_props(std::vector<WorldProp>& world_props)
 }
 
 void TerrainService::sync_world_prop_identity_state() {
-  m_reserved_world_prop_ids.clear();
-
   std::uint64_t max_id = 0;
   for (const auto& prop : m_authored_world_props) {
     max_id = std::max(max_id, prop.id);
@@ -1203,6 +1210,24 @@ void TerrainService::sync_world_prop_identity_state() {
     max_id = std::max(max_id, prop.id);
   }
   m_next_world_prop_id = std::max(m_next_world_prop_id, max_id + 1);
+  rebuild_world_prop_index();
+}
+
+void TerrainService::rebuild_world_prop_index() {
+  m_world_prop_index.reset(
+      m_height_map != nullptr ? m_height_map->get_width() : 0,
+      m_height_map != nullptr ? m_height_map->get_height() : 0);
+  for (const auto& prop : m_world_props) {
+    index_world_prop(prop);
+  }
+}
+
+void TerrainService::index_world_prop(const WorldProp& prop) {
+  if (!is_harvestable_world_prop_type(prop.type)) {
+    return;
+  }
+  m_world_prop_index.insert(
+      make_world_prop_entry(m_height_map.get(), m_coord_system, prop));
 }
 
 void TerrainService::bump_world_props_revision() {
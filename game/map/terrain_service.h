@@ -6,11 +6,12 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
+#include "heightfield_quadtree.h"
 #include "map_definition.h"
 #include "terrain.h"
+#include "world_prop_index.h"
 
 namespace Game::Map {
 
@@ -103,6 +104,10 @@ public:
     return m_height_map.get();
   }
 
+  [[nodiscard]] auto height_quadtree() const -> const HeightfieldQuadtree& {
+    return m_height_quadtree;
+  }
+
   [[nodiscard]] auto biome_settings() const -> const BiomeSettings& {
     return m_biome_settings;
   }
@@ -214,6 +219,7 @@ public:
 
 private:
   void rebuild_terrain_field();
+  void rebuild_height_quadtree();
   void rebuild_road_spatial_index();
   [[nodiscard]] auto is_point_near_indexed_road(float world_x,
                                                 float world_z,
@@ -222,12 +228,15 @@ private:
       float world_x, float world_z, float fallback_y) const -> SurfaceHeightSample;
   void normalize_world_props(std::vector<WorldProp>& world_props);
   void sync_world_prop_identity_state();
+  void rebuild_world_prop_index();
+  void index_world_prop(const WorldProp& prop);
   void bump_world_props_revision();
   void bump_authored_world_props_revision();
   void bump_navigation_topology_revision();
 
   std::unique_ptr<TerrainHeightMap> m_height_map;
   TerrainField m_terrain_field;
+  HeightfieldQuadtree m_height_quadtree;
   BiomeSettings m_biome_settings;
   CoordSystem m_coord_system{CoordSystem::Grid};
   std::vector<WorldProp> m_authored_world_props;
@@ -254,7 +263,7 @@ private:
   int m_road_index_rows{0};
   std::vector<std::uint32_t> m_road_index_offsets;
   std::vector<std::uint32_t> m_road_index_segment_ids;
-  std::unordered_set<std::uint64_t> m_reserved_world_prop_ids;
+  WorldPropIndex m_world_prop_index;
   std::uint64_t m_next_world_prop_id{1};
   bool m_sealed{false};
   std::uint64_t m_authored_world_props_revision{0};
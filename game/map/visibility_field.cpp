@@ -0,0 +1,351 @@
+#include "visibility_field.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace Game::Map {
+
+namespace {
+
+constexpr auto k_visible = static_cast<std::uint8_t>(VisibilityState::Visible);
+constexpr auto k_explored = static_cast<std::uint8_t>(VisibilityState::Explored);
+constexpr auto k_unseen = static_cast<std::uint8_t>(VisibilityState::Unseen);
+
+auto span_table_key(const VisionCircle& circle) -> std::uint64_t {
+  std::uint32_t radius_bits = 0;
+  std::memcpy(&radius_bits, &circle.radius_cells_sq, sizeof(radius_bits));
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(circle.cell_radius))
+          << 32U) |
+         radius_bits;
+}
+
+struct RowSpan {
+  int x0 = 0;
+  int x1 = -1;
+
+  [[nodiscard]] auto empty() const -> bool { return x1 < x0; }
+};
+
+} // namespace
+
+void VisibilityDirtyRect::include(int x0, int z0, int x1, int z1) {
+  if (empty()) {
+    min_x = x0;
+    min_z = z0;
+    max_x = x1;
+    max_z = z1;
+    return;
+  }
+  min_x = std::min(min_x, x0);
+  min_z = std::min(min_z, z0);
+  max_x = std::max(max_x, x1);
+  max_z = std::max(max_z, z1);
+}
+
+void VisibilityDirtyRect::merge(const VisibilityDirtyRect& other) {
+  if (!other.empty()) {
+    include(other.min_x, other.min_z, other.max_x, other.max_z);
+  }
+}
+
+void VisibilityField::resize(int width, int height) {
+  m_width = std::max(0, width);
+  m_height = std::max(0, height);
+  m_frame = 0;
+  m_baseline_revealed = false;
+  m_viewers.clear();
+  m_sources.clear();
+  m_baseline.assign(
+      static_cast<std::size_t>(m_width) * static_cast<std::size_t>(m_height), k_unseen);
+}
+
+auto VisibilityField::add_viewer(int owner_id) -> int {
+  const int existing = find_viewer(owner_id);
+  if (existing >= 0) {
+    return existing;
+  }
+  if (m_viewers.size() >= static_cast<std::size_t>(k_max_viewers)) {
+    return -1;
+  }
+  Viewer viewer;
+  viewer.owner_id = owner_id;
+  viewer.fold_pending = m_baseline_revealed;
+  viewer.counts.assign(m_baseline.size(), 0U);
+  viewer.states = m_baseline;
+  m_viewers.push_back(std::move(viewer));
+  return static_cast<int>(m_viewers.size()) - 1;
+}
+
+auto VisibilityField::find_viewer(int owner_id) const -> int {
+  for (std::size_t slot = 0; slot < m_viewers.size(); ++slot) {
+    if (m_viewers[slot].owner_id == owner_id) {
+      return static_cast<int>(slot);
+    }
+  }
+  return -1;
+}
+
+void VisibilityField::begin_frame() { ++m_frame; }
+
+void VisibilityField::place(std::uint64_t source_id,
+                            ViewerMask viewers,
+                            const VisionCircle& circle) {
+  const auto [it, inserted] = m_sources.try_emplace(source_id);
+  PlacedSource& source = it->second;
+  source.frame = m_frame;
+  if (inserted) {
+    source.circle = circle;
+    source.viewers = viewers;
+    stamp(viewers, circle, 1);
+    return;
+  }
+  if (source.viewers == viewers && source.circle == circle) {
+    return;
+  }
+  if (source.viewers == viewers) {
+    restamp(viewers, source.circle, circle);
+  } else {
+    stamp(viewers, circle, 1);
+    stamp(source.viewers, source.circle, -1);
+  }
+  source.circle = circle;
+  source.viewers = viewers;
+}
+
+void VisibilityField::end_frame() {
+  for (auto it = m_sources.begin(); it != m_sources.end();) {
+    if (it->second.frame == m_frame) {
+      ++it;
+      continue;
+    }
+    stamp(it->second.viewers, it->second.circle, -1);
+    it = m_sources.erase(it);
+  }
+
+  for (auto& viewer : m_viewers) {
+    if (viewer.fold_pending) {
+      fold(viewer);
+    }
+  }
+  if (m_baseline_revealed) {
+    std::replace(m_baseline.begin(), m_baseline.end(), k_visible, k_explored);
+    m_baseline_revealed = false;
+  }
+}
+
+auto VisibilityField::states(int slot) const -> const std::vector<std::uint8_t>& {
+  return m_viewers[static_cast<std::size_t>(slot)].states;
+}
+
+auto VisibilityField::count_at(int slot, int grid_x, int grid_z) const -> int {
+  if (grid_x < 0 || grid_x >= m_width || grid_z < 0 || grid_z >= m_height) {
+    return 0;
+  }
+  return m_viewers[static_cast<std::size_t>(slot)]
+      .counts[static_cast<std::size_t>(grid_z) * static_cast<std::size_t>(m_width) +
+              static_cast<std::size_t>(grid_x)];
+}
+
+auto VisibilityField::take_dirty(int slot) -> VisibilityDirtyRect {
+  auto& dirty = m_viewers[static_cast<std::size_t>(slot)].dirty;
+  const VisibilityDirtyRect taken = dirty;
+  dirty = {};
+  return taken;
+}
+
+void VisibilityField::reveal_all() {
+  for (auto& viewer : m_viewers) {
+    std::fill(viewer.states.begin(), viewer.states.end(), k_visible);
+    viewer.fold_pending = true;
+    viewer.dirty = VisibilityDirtyRect::whole(m_width, m_height);
+  }
+  std::fill(m_baseline.begin(), m_baseline.end(), k_visible);
+  m_baseline_revealed = true;
+}
+
+auto VisibilityField::mark_explored(const std::vector<std::uint8_t>& explored) -> bool {
+  if (explored.size() != m_baseline.size()) {
+    return false;
+  }
+  bool changed = false;
+  auto raise = [&explored, &changed, this](std::vector<std::uint8_t>& states,
+                                           VisibilityDirtyRect* dirty) {
+    for (std::size_t idx = 0; idx < states.size(); ++idx) {
+      if (explored[idx] == 0U || states[idx] != k_unseen) {
+        continue;
+      }
+      states[idx] = k_explored;
+      changed = true;
+      if (dirty != nullptr) {
+        const int x = static_cast<int>(idx % static_cast<std::size_t>(m_width));
+        const int z = static_cast<int>(idx / static_cast<std::size_t>(m_width));
+        dirty->include(x, z, x, z);
+      }
+    }
+  };
+  raise(m_baseline, nullptr);
+  for (auto& viewer : m_viewers) {
+    raise(viewer.states, &viewer.dirty);
+  }
+  return changed;
+}
+
+auto VisibilityField::spans_for(const VisionCircle& circle) -> const std::vector<int>& {
+  auto [it, inserted] = m_span_tables.try_emplace(span_table_key(circle));
+  if (!inserted) {
+    return it->second;
+  }
+  const int radius = std::max(0, circle.cell_radius);
+  auto& spans = it->second;
+  spans.assign(static_cast<std::size_t>(radius * 2 + 1), -1);
+  for (int dz = -radius; dz <= radius; ++dz) {
+    const int dz_sq = dz * dz;
+    int half_width = -1;
+    for (int dx = 0; dx <= radius; ++dx) {
+      if (static_cast<float>(dx * dx + dz_sq) > circle.radius_cells_sq) {
+        break;
+      }
+      half_width = dx;
+    }
+    spans[static_cast<std::size_t>(dz + radius)] = half_width;
+  }
+  return spans;
+}
+
+void VisibilityField::stamp(ViewerMask viewers, const VisionCircle& circle, int delta) {
+  if (viewers == 0U) {
+    return;
+  }
+  const auto& spans = spans_for(circle);
+  const int radius = std::max(0, circle.cell_radius);
+  for (int dz = -radius; dz <= radius; ++dz) {
+    const int half_width = spans[static_cast<std::size_t>(dz + radius)];
+    if (half_width < 0) {
+      continue;
+    }
+    add_row(viewers,
+            circle.center_z + dz,
+            circle.center_x - half_width,
+            circle.center_x + half_width,
+            delta);
+  }
+}
+
+void VisibilityField::restamp(ViewerMask viewers,
+                              const VisionCircle& from,
+                              const VisionCircle& to) {
+  if (viewers == 0U) {
+    return;
+  }
+  const auto& from_spans = spans_for(from);
+  const auto& to_spans = spans_for(to);
+  const int from_radius = std::max(0, from.cell_radius);
+  const int to_radius = std::max(0, to.cell_radius);
+
+  auto row_span = [](const std::vector<int>& spans,
+                     const VisionCircle& circle,
+                     int radius,
+                     int grid_z) -> RowSpan {
+    const int dz = grid_z - circle.center_z;
+    if (dz < -radius || dz > radius) {
+      return {};
+    }
+    const int half_width = spans[static_cast<std::size_t>(dz + radius)];
+    if (half_width < 0) {
+      return {};
+    }
+    return {circle.center_x - half_width, circle.center_x + half_width};
+  };
+
+  // Adds `delta` over `span` minus `other`, which leaves at most two pieces.
+  auto apply_difference = [this, viewers](
+                              int grid_z, RowSpan span, RowSpan other, int delta) {
+    if (span.empty()) {
+      return;
+    }
+    if (other.empty() || other.x1 < span.x0 || other.x0 > span.x1) {
+      add_row(viewers, grid_z, span.x0, span.x1, delta);
+      return;
+    }
+    if (span.x0 < other.x0) {
+      add_row(viewers, grid_z, span.x0, other.x0 - 1, delta);
+    }
+    if (span.x1 > other.x1) {
+      add_row(viewers, grid_z, other.x1 + 1, span.x1, delta);
+    }
+  };
+
+  const int first_z =
+      std::min(from.center_z - from_radius, to.center_z - to_radius);
+  const int last_z = std::max(from.center_z + from_radius, to.center_z + to_radius);
+  for (int grid_z = std::max(0, first_z); grid_z <= std::min(m_height - 1, last_z);
+       ++grid_z) {
+    const RowSpan old_span = row_span(from_spans, from, from_radius, grid_z);
+    const RowSpan new_span = row_span(to_spans, to, to_radius, grid_z);
+    apply_difference(grid_z, new_span, old_span, 1);
+    apply_difference(grid_z, old_span, new_span, -1);
+  }
+}
+
+void VisibilityField::add_row(
+    ViewerMask viewers, int grid_z, int x0, int x1, int delta) {
+  if (grid_z < 0 || grid_z >= m_height) {
+    return;
+  }
+  x0 = std::max(0, x0);
+  x1 = std::min(m_width - 1, x1);
+  if (x1 < x0) {
+    return;
+  }
+  const std::size_t row =
+      static_cast<std::size_t>(grid_z) * static_cast<std::size_t>(m_width);
+  for (std::size_t slot = 0; slot < m_viewers.size(); ++slot) {
+    if ((viewers & (ViewerMask{1} << slot)) == 0U) {
+      continue;
+    }
+    Viewer& viewer = m_viewers[slot];
+    std::uint16_t* counts = viewer.counts.data() + row;
+    std::uint8_t* states = viewer.states.data() + row;
+    int changed_min = x1 + 1;
+    int changed_max = x0 - 1;
+    if (delta > 0) {
+      for (int x = x0; x <= x1; ++x) {
+        if (counts[x]++ == 0U && states[x] != k_visible) {
+          states[x] = k_visible;
+          changed_min = std::min(changed_min, x);
+          changed_max = x;
+        }
+      }
+    } else {
+      for (int x = x0; x <= x1; ++x) {
+        if (--counts[x] == 0U) {
+          states[x] = k_explored;
+          changed_min = std::min(changed_min, x);
+          changed_max = x;
+        }
+      }
+    }
+    if (changed_max >= changed_min) {
+      viewer.dirty.include(changed_min, grid_z, changed_max, grid_z);
+    }
+  }
+}
+
+void VisibilityField::fold(Viewer& viewer) {
+  bool changed = false;
+  for (std::size_t idx = 0; idx < viewer.states.size(); ++idx) {
+    if (viewer.counts[idx] == 0U && viewer.states[idx] == k_visible) {
+      viewer.states[idx] = k_explored;
+      changed = true;
+    }
+  }
+  viewer.fold_pending = false;
+  if (changed) {
+    viewer.dirty = VisibilityDirtyRect::whole(m_width, m_height);
+  }
+}
+
+} // namespace Game::Map
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Game::Map {
+
+enum class VisibilityState : std::uint8_t {
+  Unseen = 0,
+  Explored = 1,
+  Visible = 2
+};
+
+// Inclusive cell rectangle; the default value is empty.
+struct VisibilityDirtyRect {
+  int min_x = 0;
+  int min_z = 0;
+  int max_x = -1;
+  int max_z = -1;
+
+  [[nodiscard]] auto empty() const -> bool { return max_x < min_x || max_z < min_z; }
+
+  void include(int x0, int z0, int x1, int z1);
+  void merge(const VisibilityDirtyRect& other);
+
+  [[nodiscard]] static auto whole(int width, int height) -> VisibilityDirtyRect {
+    return {0, 0, width - 1, height - 1};
+  }
+};
+
+struct VisionCircle {
+  int center_x = 0;
+  int center_z = 0;
+  int cell_radius = 0;
+  float radius_cells_sq = 0.0F;
+
+  [[nodiscard]] auto operator==(const VisionCircle& other) const -> bool {
+    return center_x == other.center_x && center_z == other.center_z &&
+           cell_radius == other.cell_radius &&
+           radius_cells_sq == other.radius_cells_sq;
+  }
+};
+
+// Fog of war for every viewer at once. Each cell keeps a per-viewer count of
+// the vision circles covering it; a source stamps the viewers in its mask and,
+// when it moves, only the rows' entering and leaving spans are touched. A cell
+// turns Visible when its count leaves zero and Explored when it drops back,
+// and each viewer accumulates the rectangle of cells whose state changed.
+class VisibilityField {
+public:
+  using ViewerMask = std::uint32_t;
+  static constexpr int k_max_viewers = 32;
+
+  void resize(int width, int height);
+
+  [[nodiscard]] auto width() const -> int { return m_width; }
+  [[nodiscard]] auto height() const -> int { return m_height; }
+
+  // Returns the slot for `owner_id`, adding it if needed; -1 when full. A new
+  // viewer starts from the baseline grid.
+  auto add_viewer(int owner_id) -> int;
+  [[nodiscard]] auto find_viewer(int owner_id) const -> int;
+  [[nodiscard]] auto viewer_count() const -> int {
+    return static_cast<int>(m_viewers.size());
+  }
+  [[nodiscard]] auto viewer_owner(int slot) const -> int {
+    return m_viewers[static_cast<std::size_t>(slot)].owner_id;
+  }
+
+  void begin_frame();
+  void place(std::uint64_t source_id, ViewerMask viewers, const VisionCircle& circle);
+  // Releases every source not placed since begin_frame.
+  void end_frame();
+
+  [[nodiscard]] auto source_count() const -> std::size_t { return m_sources.size(); }
+
+  [[nodiscard]] auto states(int slot) const -> const std::vector<std::uint8_t>&;
+  [[nodiscard]] auto baseline() const -> const std::vector<std::uint8_t>& {
+    return m_baseline;
+  }
+  [[nodiscard]] auto count_at(int slot, int grid_x, int grid_z) const -> int;
+
+  [[nodiscard]] auto dirty(int slot) const -> const VisibilityDirtyRect& {
+    return m_viewers[static_cast<std::size_t>(slot)].dirty;
+  }
+  auto take_dirty(int slot) -> VisibilityDirtyRect;
+
+  // Everything turns Visible until the next end_frame, which folds cells that
+  // no source covers back to Explored.
+  void reveal_all();
+  // Raises Unseen cells flagged in `explored` to Explored for every viewer and
+  // for the baseline. Returns whether any state changed.
+  auto mark_explored(const std::vector<std::uint8_t>& explored) -> bool;
+
+private:
+  struct Viewer {
+    int owner_id = 0;
+    bool fold_pending = false;
+    std::vector<std::uint16_t> counts;
+    std::vector<std::uint8_t> states;
+    VisibilityDirtyRect dirty;
+  };
+
+  struct PlacedSource {
+    VisionCircle circle;
+    ViewerMask viewers = 0;
+    std::uint32_t frame = 0;
+  };
+
+  // Half-width of each row of a circle, indexed by dz + cell_radius; -1 marks
+  // a row the circle does not reach.
+  auto spans_for(const VisionCircle& circle) -> const std::vector<int>&;
+  void stamp(ViewerMask viewers, const VisionCircle& circle, int delta);
+  void restamp(ViewerMask viewers, const VisionCircle& from, const VisionCircle& to);
+  void add_row(ViewerMask viewers, int grid_z, int x0, int x1, int delta);
+  void fold(Viewer& viewer);
+
+  int m_width = 0;
+  int m_height = 0;
+  std::uint32_t m_frame = 0;
+  bool m_baseline_revealed = false;
+  std::vector<Viewer> m_viewers;
+  std::vector<std::uint8_t> m_baseline;
+  std::unordered_map<std::uint64_t, PlacedSource> m_sources;
+  std::unordered_map<std::uint64_t, std::vector<int>> m_span_tables;
+};
+
+} // namespace Game::Map
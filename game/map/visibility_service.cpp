@@ -28,30 +28,16 @@ namespace {
 constexpr float k_default_vision_range = 12.0F;
 constexpr float k_half_cell_offset = 0.5F;
 constexpr float k_min_tile_size = 0.0001F;
-constexpr std::chrono::milliseconds k_min_job_interval{50};
-constexpr std::uint8_t k_current_visible_marker = 0x80U;
+constexpr std::chrono::milliseconds k_min_recompute_interval{50};
 constexpr std::uint64_t k_rally_flag_visibility_tag = 0x8000000000000000ULL;
 
-auto index_static(int grid_x, int grid_z, int width) -> int {
-  return grid_z * width + grid_x;
-}
-
 auto rally_flag_visibility_id(std::uint64_t commander_id) -> std::uint64_t {
   return commander_id ^ k_rally_flag_visibility_tag;
 }
 
 } // namespace
 
-VisibilityService::~VisibilityService() {
-  m_shutdown_requested.store(true, std::memory_order_release);
-  m_queue_cv.notify_all();
-  if (m_worker_thread.joinable()) {
-    m_worker_thread.join();
-  }
-}
-
 void VisibilityService::initialize(int width, int height, float tile_size) {
-  reset_worker_state();
   std::unique_lock<std::shared_mutex> const lock(m_cells_mutex);
   m_width = std::max(1, width);
   m_height = std::max(1, height);
@@ -60,59 +46,31 @@ void VisibilityService::initialize(int width, int height, float tile_size) {
   m_half_height =
       static_cast<float>(m_height) * k_half_cell_offset - k_half_cell_offset;
 
-  const int count = m_width * m_height;
-  m_cells.assign(count, static_cast<std::uint8_t>(VisibilityState::Unseen));
-  const auto next_version =
-      std::max<std::uint64_t>(1ULL, m_version.load(std::memory_order_relaxed) + 1ULL);
-  m_version.store(next_version, std::memory_order_release);
-  m_last_positions.clear();
-  m_force_full_update = true;
+  reset_views_locked();
   reset_throttle();
   m_initialized = true;
-  publish_snapshot_locked(next_version);
+  publish_snapshot_locked();
 }
 
 void VisibilityService::reset() {
   if (!m_initialized) {
     return;
   }
-  reset_worker_state();
   std::unique_lock<std::shared_mutex> const lock(m_cells_mutex);
-  std::fill(m_cells.begin(),
-            m_cells.end(),
-            static_cast<std::uint8_t>(VisibilityState::Unseen));
-  const auto next_version = m_version.fetch_add(1, std::memory_order_release) + 1ULL;
-  m_last_positions.clear();
-  m_force_full_update = true;
+  reset_views_locked();
   reset_throttle();
-  publish_snapshot_locked(next_version);
+  publish_snapshot_locked();
 }
 
 auto VisibilityService::update(Engine::Core::World& world, int player_id) -> bool {
-  if (!m_initialized) {
+  if (!m_initialized || !should_recompute()) {
     return false;
   }
 
-  bool integrated = false;
-  {
-    std::lock_guard<std::mutex> const lock(m_queue_mutex);
-    if (m_completed_result.has_value()) {
-      integrate_result(std::move(m_completed_result.value()));
-      m_completed_result.reset();
-      integrated = true;
-    }
-  }
-
-  if (should_start_new_job()) {
-    auto sources = gather_vision_sources(world, player_id);
-
-    if (!sources.empty()) {
-      auto payload = compose_job_payload(sources);
-      enqueue_job(std::move(payload));
-    }
-  }
-
-  return integrated;
+  std::unique_lock<std::shared_mutex> const lock(m_cells_mutex);
+  place_vision_sources(world, player_id);
+  m_last_recompute_time = std::chrono::steady_clock::now();
+  return publish_snapshot_locked();
 }
 
 void VisibilityService::compute_immediate(Engine::Core::World& world, int player_id) {
@@ -120,31 +78,31 @@ void VisibilityService::compute_immediate(Engine::Core::World& world, int player
     return;
   }
 
-  const auto sources = gather_vision_sources(world, player_id);
-  auto payload = compose_job_payload(sources);
-  auto result = execute_job(std::move(payload));
-
-  if (result.changed) {
-    std::unique_lock<std::shared_mutex> const lock(m_cells_mutex);
-    m_cells = std::move(result.cells);
-    const auto next_version = m_version.fetch_add(1, std::memory_order_release) + 1ULL;
-    publish_snapshot_locked(next_version);
-  }
+  std::unique_lock<std::shared_mutex> const lock(m_cells_mutex);
+  place_vision_sources(world, player_id);
+  publish_snapshot_locked();
   reset_throttle();
 }
 
-auto VisibilityService::gather_vision_sources(Engine::Core::World& world, int player_id)
-    -> std::vector<VisibilityService::VisionSource> {
-  std::vector<VisionSource> sources;
+void VisibilityService::place_vision_sources(Engine::Core::World& world,
+                                             int player_id) {
+  auto& owner_registry = Game::Systems::OwnerRegistry::instance();
+  m_field.add_viewer(player_id);
+  for (const auto& owner : owner_registry.get_all_owners()) {
+    if (owner.type != Game::Systems::OwnerType::Neutral &&
+        !Game::Core::is_neutral_owner(owner.owner_id)) {
+      m_field.add_viewer(owner.owner_id);
+    }
+  }
+  m_local_player_id = player_id;
+  m_local_slot = m_field.find_viewer(player_id);
+  m_viewer_masks.clear();
+
   const auto entities = world.collect_entities_with<Engine::Core::TransformComponent>();
   const float range_padding = m_tile_size * k_half_cell_offset;
-
-  auto& owner_registry = Game::Systems::OwnerRegistry::instance();
   const float inverse_tile_size_sq = 1.0F / (m_tile_size * m_tile_size);
 
-  std::unordered_map<std::uint64_t, CachedPosition> current_positions;
-  bool any_moved = m_force_full_update;
-
+  m_field.begin_frame();
   for (auto* entity : entities) {
     auto* transform = entity->get_component<Engine::Core::TransformComponent>();
     auto* unit = entity->get_component<Engine::Core::UnitComponent>();
@@ -152,16 +110,12 @@ auto VisibilityService::gather_vision_sources(Engine::Core::World& world, int pl
       continue;
     }
 
-    if (Game::Core::is_neutral_owner(unit->owner_id)) {
-      continue;
-    }
-
-    if (unit->owner_id != player_id &&
-        !owner_registry.are_allies(player_id, unit->owner_id)) {
+    if (Game::Core::is_neutral_owner(unit->owner_id) || unit->health <= 0) {
       continue;
     }
 
-    if (unit->health <= 0) {
+    const VisibilityField::ViewerMask viewers = viewers_of(unit->owner_id);
+    if (viewers == 0U) {
       continue;
     }
 
@@ -172,24 +126,16 @@ auto VisibilityService::gather_vision_sources(Engine::Core::World& world, int pl
       continue;
     }
 
-    const std::uint64_t entity_id = entity->get_id();
-    current_positions[entity_id] = {center_x, center_z};
-
-    if (!any_moved) {
-      auto it = m_last_positions.find(entity_id);
-      if (it == m_last_positions.end() || it->second.grid_x != center_x ||
-          it->second.grid_z != center_z) {
-        any_moved = true;
-      }
-    }
-
     const int cell_radius =
         std::max(1, static_cast<int>(std::ceil(vision_range / m_tile_size)));
     const float expanded_range_sq =
         (vision_range + range_padding) * (vision_range + range_padding);
     const float expanded_radius_cells_sq = expanded_range_sq * inverse_tile_size_sq;
 
-    sources.push_back({center_x, center_z, cell_radius, expanded_radius_cells_sq});
+    const std::uint64_t entity_id = entity->get_id();
+    m_field.place(entity_id,
+                  viewers,
+                  {center_x, center_z, cell_radius, expanded_radius_cells_sq});
 
     auto* commander = entity->get_component<Engine::Core::CommanderComponent>();
     if (commander == nullptr || !commander->flag_rally_flag_active) {
@@ -204,155 +150,29 @@ auto VisibilityService::gather_vision_sources(Engine::Core::World& world, int pl
       continue;
     }
 
-    const std::uint64_t rally_id = rally_flag_visibility_id(entity_id);
-    current_positions[rally_id] = {rally_center_x, rally_center_z};
-    if (!any_moved) {
-      auto it = m_last_positions.find(rally_id);
-      if (it == m_last_positions.end() || it->second.grid_x != rally_center_x ||
-          it->second.grid_z != rally_center_z) {
-        any_moved = true;
-      }
-    }
-
-    sources.push_back(
+    m_field.place(
+        rally_flag_visibility_id(entity_id),
+        viewers,
         {rally_center_x, rally_center_z, cell_radius, expanded_radius_cells_sq});
   }
-
-  if (!any_moved) {
-    for (const auto& [entity_id, pos] : m_last_positions) {
-      if (current_positions.find(entity_id) == current_positions.end()) {
-        any_moved = true;
-        break;
-      }
-    }
-  }
-
-  m_last_positions = std::move(current_positions);
-  m_force_full_update = false;
-
-  if (!any_moved && !sources.empty()) {
-    return {};
-  }
-
-  return sources;
+  m_field.end_frame();
 }
 
-auto VisibilityService::compose_job_payload(
-    const std::vector<VisionSource>& sources) const -> VisibilityService::JobPayload {
-  std::shared_lock<std::shared_mutex> const lock(m_cells_mutex);
-  const auto generation_value =
-      m_generation.fetch_add(1ULL, std::memory_order_relaxed) + 1ULL;
-  return JobPayload{m_width, m_height, m_cells, sources, generation_value};
-}
-
-void VisibilityService::enqueue_job(JobPayload&& payload) {
-  {
-    std::lock_guard<std::mutex> const lock(m_queue_mutex);
-    m_pending_payload = std::move(payload);
-    m_last_job_start_time = std::chrono::steady_clock::now();
-  }
-  ensure_worker_running();
-  m_queue_cv.notify_one();
-}
-
-void VisibilityService::integrate_result(JobResult&& result) {
-  const auto current_generation = m_generation.load(std::memory_order_acquire);
-  if (result.generation != current_generation) {
-    return;
-  }
-  if (result.changed) {
-    std::unique_lock<std::shared_mutex> const lock(m_cells_mutex);
-    m_cells = std::move(result.cells);
-    const auto next_version = m_version.fetch_add(1, std::memory_order_release) + 1ULL;
-    publish_snapshot_locked(next_version);
+auto VisibilityService::viewers_of(int owner_id) -> VisibilityField::ViewerMask {
+  const auto cached = m_viewer_masks.find(owner_id);
+  if (cached != m_viewer_masks.end()) {
+    return cached->second;
   }
-}
-
-void VisibilityService::ensure_worker_running() {
-  bool expected = false;
-  if (m_worker_running.compare_exchange_strong(
-          expected, true, std::memory_order_acq_rel)) {
-    if (m_worker_thread.joinable()) {
-      m_worker_thread.join();
-    }
-    m_worker_thread = std::thread(&VisibilityService::worker_loop, this);
-  }
-}
-
-void VisibilityService::worker_loop() {
-  while (!m_shutdown_requested.load(std::memory_order_acquire)) {
-    std::optional<JobPayload> payload_to_process;
-    {
-      std::unique_lock<std::mutex> lock(m_queue_mutex);
-      m_queue_cv.wait_for(lock, std::chrono::milliseconds(100), [this] {
-        return m_pending_payload.has_value() ||
-               m_shutdown_requested.load(std::memory_order_acquire);
-      });
-      if (m_shutdown_requested.load(std::memory_order_acquire)) {
-        break;
-      }
-      if (m_pending_payload.has_value()) {
-        payload_to_process = std::move(m_pending_payload);
-        m_pending_payload.reset();
-      } else {
-        m_worker_running.store(false, std::memory_order_release);
-        break;
-      }
-    }
-
-    if (payload_to_process.has_value()) {
-      auto result = execute_job(std::move(payload_to_process.value()));
-      std::lock_guard<std::mutex> const lock(m_queue_mutex);
-      if (!m_completed_result.has_value() || result.changed) {
-        m_completed_result = std::move(result);
-      }
-    }
-  }
-}
-
-auto VisibilityService::execute_job(JobPayload payload)
-    -> VisibilityService::JobResult {
-  const int cell_count = payload.width * payload.height;
-  const auto visible_val = static_cast<std::uint8_t>(VisibilityState::Visible);
-  const auto explored_val = static_cast<std::uint8_t>(VisibilityState::Explored);
-
-  for (const auto& source : payload.sources) {
-    const int min_z = std::max(0, source.center_z - source.cell_radius);
-    const int max_z =
-        std::min(payload.height - 1, source.center_z + source.cell_radius);
-    const int min_x = std::max(0, source.center_x - source.cell_radius);
-    const int max_x = std::min(payload.width - 1, source.center_x + source.cell_radius);
-
-    for (int grid_z = min_z; grid_z <= max_z; ++grid_z) {
-      const int dz = grid_z - source.center_z;
-      const int dz_sq = dz * dz;
-      if (static_cast<float>(dz_sq) > source.expanded_radius_cells_sq) {
-        continue;
-      }
-
-      for (int grid_x = min_x; grid_x <= max_x; ++grid_x) {
-        const int dx = grid_x - source.center_x;
-        const int dist_cells_sq = dx * dx + dz_sq;
-        if (static_cast<float>(dist_cells_sq) <= source.expanded_radius_cells_sq) {
-          const int idx = index_static(grid_x, grid_z, payload.width);
-          payload.cells[idx] |= k_current_visible_marker;
-        }
-      }
+  auto& owner_registry = Game::Systems::OwnerRegistry::instance();
+  VisibilityField::ViewerMask viewers = 0;
+  for (int slot = 0; slot < m_field.viewer_count(); ++slot) {
+    const int viewer_id = m_field.viewer_owner(slot);
+    if (viewer_id == owner_id || owner_registry.are_allies(viewer_id, owner_id)) {
+      viewers |= VisibilityField::ViewerMask{1} << static_cast<unsigned>(slot);
     }
   }
-
-  bool changed = false;
-  for (int idx = 0; idx < cell_count; ++idx) {
-    const std::uint8_t previous_state = payload.cells[idx] & ~k_current_visible_marker;
-    const bool now_visible = (payload.cells[idx] & k_current_visible_marker) != 0U;
-    const std::uint8_t next_state =
-        now_visible ? visible_val
-                    : (previous_state == visible_val ? explored_val : previous_state);
-    changed = changed || (next_state != previous_state);
-    payload.cells[idx] = next_state;
-  }
-
-  return JobResult{std::move(payload.cells), payload.generation, changed};
+  m_viewer_masks.emplace(owner_id, viewers);
+  return viewers;
 }
 
 auto VisibilityService::Snapshot::in_bounds(int grid_x, int grid_z) const -> bool {
@@ -423,7 +243,7 @@ auto VisibilityService::state_at(int grid_x, int grid_z) const -> VisibilityStat
     return VisibilityState::Visible;
   }
   std::shared_lock<std::shared_mutex> const lock(m_cells_mutex);
-  return static_cast<VisibilityState>(m_cells[index(grid_x, grid_z)]);
+  return static_cast<VisibilityState>(local_states_locked()[index(grid_x, grid_z)]);
 }
 
 auto VisibilityService::is_visible_world(float world_x, float world_z) const -> bool {
@@ -436,7 +256,7 @@ auto VisibilityService::is_visible_world(float world_x, float world_z) const ->
     return false;
   }
   std::shared_lock<std::shared_mutex> const lock(m_cells_mutex);
-  return m_cells[index(grid_x, grid_z)] ==
+  return local_states_locked()[index(grid_x, grid_z)] ==
          static_cast<std::uint8_t>(VisibilityState::Visible);
 }
 
@@ -450,7 +270,7 @@ auto VisibilityService::is_explored_world(float world_x, float world_z) const ->
     return false;
   }
   std::shared_lock<std::shared_mutex> const lock(m_cells_mutex);
-  const auto state = m_cells[index(grid_x, grid_z)];
+  const auto state = local_states_locked()[index(grid_x, grid_z)];
   return state == static_cast<std::uint8_t>(VisibilityState::Visible) ||
          state == static_cast<std::uint8_t>(VisibilityState::Explored);
 }
@@ -473,17 +293,31 @@ auto VisibilityService::snapshot_if_newer(std::uint64_t known_version) const
   return snapshot;
 }
 
+auto VisibilityService::snapshot_for(int player_id) -> VisibilityService::SnapshotPtr {
+  if (!m_initialized) {
+    return nullptr;
+  }
+  std::unique_lock<std::shared_mutex> const lock(m_cells_mutex);
+  const int slot = m_field.find_viewer(player_id);
+  if (slot < 0) {
+    return nullptr;
+  }
+  if (slot == m_local_slot) {
+    publish_snapshot_locked();
+    return snapshot_ptr();
+  }
+  return build_snapshot_locked(slot);
+}
+
 void VisibilityService::reveal_all() {
   if (!m_initialized) {
     return;
   }
   std::unique_lock<std::shared_mutex> const lock(m_cells_mutex);
-  std::fill(m_cells.begin(),
-            m_cells.end(),
-            static_cast<std::uint8_t>(VisibilityState::Visible));
-  const auto next_version = m_version.fetch_add(1, std::memory_order_release) + 1ULL;
+  m_field.reveal_all();
+  m_baseline_changed = true;
   reset_throttle();
-  publish_snapshot_locked(next_version);
+  publish_snapshot_locked();
 }
 
 auto VisibilityService::restore_explored(const std::vector<std::uint8_t>& explored,
@@ -493,26 +327,15 @@ auto VisibilityService::restore_explored(const std::vector<std::uint8_t>& explor
     return false;
   }
   std::unique_lock<std::shared_mutex> const lock(m_cells_mutex);
-  if (width != m_width || height != m_height || explored.size() != m_cells.size()) {
+  if (width != m_width || height != m_height ||
+      explored.size() != m_field.baseline().size()) {
     return false;
   }
 
-  const auto explored_val = static_cast<std::uint8_t>(VisibilityState::Explored);
-  const auto unseen_val = static_cast<std::uint8_t>(VisibilityState::Unseen);
-  bool changed = false;
-  for (std::size_t idx = 0; idx < m_cells.size(); ++idx) {
-    if (explored[idx] != 0U && m_cells[idx] == unseen_val) {
-      m_cells[idx] = explored_val;
-      changed = true;
-    }
-  }
-
-  if (!changed) {
-    return true;
+  if (m_field.mark_explored(explored)) {
+    m_baseline_changed = true;
+    publish_snapshot_locked();
   }
-
-  const auto next_version = m_version.fetch_add(1, std::memory_order_release) + 1ULL;
-  publish_snapshot_locked(next_version);
   return true;
 }
 
@@ -529,35 +352,86 @@ auto VisibilityService::world_to_grid(float world_coord, float half) const -> in
   return static_cast<int>(std::floor(grid_coord + k_half_cell_offset));
 }
 
-auto VisibilityService::should_start_new_job() const -> bool {
+auto VisibilityService::should_recompute() const -> bool {
   const auto now = std::chrono::steady_clock::now();
-  return (now - m_last_job_start_time) >= k_min_job_interval;
+  return (now - m_last_recompute_time) >= k_min_recompute_interval;
 }
 
 void VisibilityService::reset_throttle() {
-  m_last_job_start_time = {};
+  m_last_recompute_time = {};
+}
+
+void VisibilityService::reset_views_locked() {
+  m_field.resize(m_width, m_height);
+  m_views.clear();
+  m_viewer_masks.clear();
+  m_local_slot = -1;
+  m_baseline_changed = true;
 }
 
-void VisibilityService::reset_worker_state() {
-  std::lock_guard<std::mutex> const lock(m_queue_mutex);
-  m_pending_payload.reset();
-  m_completed_result.reset();
-  m_generation.store(0, std::memory_order_release);
+auto VisibilityService::local_states_locked() const
+    -> const std::vector<std::uint8_t>& {
+  return m_local_slot >= 0 ? m_field.states(m_local_slot) : m_field.baseline();
 }
 
-void VisibilityService::publish_snapshot_locked(std::uint64_t version) {
+auto VisibilityService::build_snapshot_locked(int slot) -> SnapshotPtr {
+  if (m_views.size() < static_cast<std::size_t>(m_field.viewer_count())) {
+    m_views.resize(static_cast<std::size_t>(m_field.viewer_count()));
+  }
+  auto& view = m_views[static_cast<std::size_t>(slot)];
+  const VisibilityDirtyRect dirty = m_field.take_dirty(slot);
+  if (view.snapshot != nullptr && dirty.empty()) {
+    return view.snapshot;
+  }
+
   auto snapshot = std::make_shared<Snapshot>();
-  snapshot->version = version;
+  snapshot->version = m_version.fetch_add(1, std::memory_order_acq_rel) + 1ULL;
   snapshot->initialized = m_initialized;
   snapshot->width = m_width;
   snapshot->height = m_height;
   snapshot->tile_size = m_tile_size;
   snapshot->half_width = m_half_width;
   snapshot->half_height = m_half_height;
-  snapshot->cells = m_cells;
-  auto published_snapshot = std::shared_ptr<const Snapshot>(std::move(snapshot));
+  snapshot->player_id = m_field.viewer_owner(slot);
+  snapshot->cells = m_field.states(slot);
+  if (view.snapshot != nullptr) {
+    snapshot->dirty_since_version = view.snapshot->version;
+    snapshot->dirty = dirty;
+  }
+  view.snapshot = std::move(snapshot);
+  return view.snapshot;
+}
+
+auto VisibilityService::publish_snapshot_locked() -> bool {
+  SnapshotPtr next;
+  if (m_local_slot >= 0) {
+    const auto local = static_cast<std::size_t>(m_local_slot);
+    if (local < m_views.size() && m_views[local].snapshot != snapshot_ptr()) {
+      // The local player changed; its cached view is older than what the
+      // presenters hold, so republish it whole under a fresh version.
+      m_views[local].snapshot.reset();
+    }
+    next = build_snapshot_locked(m_local_slot);
+  } else if (m_baseline_changed) {
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->version = m_version.fetch_add(1, std::memory_order_acq_rel) + 1ULL;
+    snapshot->initialized = m_initialized;
+    snapshot->width = m_width;
+    snapshot->height = m_height;
+    snapshot->tile_size = m_tile_size;
+    snapshot->half_width = m_half_width;
+    snapshot->half_height = m_half_height;
+    snapshot->player_id = m_local_player_id;
+    snapshot->cells = m_field.baseline();
+    next = std::move(snapshot);
+  }
+  m_baseline_changed = false;
+  if (next == nullptr || next == snapshot_ptr()) {
+    return false;
+  }
   std::atomic_store_explicit(
-      &m_published_snapshot, std::move(published_snapshot), std::memory_order_release);
+      &m_published_snapshot, std::move(next), std::memory_order_release);
+  return true;
 }
 
 } // namespace Game::Map
@@ -2,28 +2,20 @@
 
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <cstdint>
 #include <memory>
-#include <mutex>
-#include <optional>
 #include <shared_mutex>
-#include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include "visibility_field.h"
+
 namespace Engine::Core {
 class World;
 }
 
 namespace Game::Map {
 
-enum class VisibilityState : std::uint8_t {
-  Unseen = 0,
-  Explored = 1,
-  Visible = 2
-};
-
 class VisibilityService {
 public:
   struct Snapshot {
@@ -34,7 +26,12 @@ public:
     float tile_size = 1.0F;
     float half_width = 0.0F;
     float half_height = 0.0F;
+    int player_id = 0;
     std::vector<std::uint8_t> cells;
+    // Cells that differ from the snapshot published as `dirty_since_version`
+    // for the same player all lie inside `dirty`; 0 means diff everything.
+    std::uint64_t dirty_since_version = 0;
+    VisibilityDirtyRect dirty;
 
     auto state_at(int grid_x, int grid_z) const -> VisibilityState;
     auto is_visible_world(float world_x, float world_z) const -> bool;
@@ -73,6 +70,9 @@ public:
   auto snapshot() const -> Snapshot;
   auto snapshot_ptr() const -> SnapshotPtr;
   auto snapshot_if_newer(std::uint64_t known_version) const -> SnapshotPtr;
+  // The view of any owner that took part in the last update, e.g. an AI
+  // player or the player a spectator follows; nullptr for unknown owners.
+  auto snapshot_for(int player_id) -> SnapshotPtr;
 
   void reveal_all();
 
@@ -80,47 +80,25 @@ public:
                         int width,
                         int height) -> bool;
 
-  ~VisibilityService();
+  ~VisibilityService() = default;
 
 private:
   auto in_bounds(int x, int z) const -> bool;
   auto index(int x, int z) const -> int;
   auto world_to_grid(float world_coord, float half) const -> int;
 
-  struct VisionSource {
-    int center_x;
-    int center_z;
-    int cell_radius;
-    float expanded_radius_cells_sq;
-  };
-
-  struct JobPayload {
-    int width;
-    int height;
-    std::vector<std::uint8_t> cells;
-    std::vector<VisionSource> sources;
-    std::uint64_t generation;
+  struct PublishedView {
+    SnapshotPtr snapshot;
   };
 
-  struct JobResult {
-    std::vector<std::uint8_t> cells;
-    std::uint64_t generation;
-    bool changed;
-  };
-
-  auto gather_vision_sources(Engine::Core::World& world,
-                             int player_id) -> std::vector<VisionSource>;
-  auto
-  compose_job_payload(const std::vector<VisionSource>& sources) const -> JobPayload;
-  void enqueue_job(JobPayload&& payload);
-  void integrate_result(JobResult&& result);
-  auto should_start_new_job() const -> bool;
+  void place_vision_sources(Engine::Core::World& world, int player_id);
+  auto viewers_of(int owner_id) -> VisibilityField::ViewerMask;
+  auto should_recompute() const -> bool;
   void reset_throttle();
-  void reset_worker_state();
-  void publish_snapshot_locked(std::uint64_t version);
-  void worker_loop();
-  void ensure_worker_running();
-  static auto execute_job(JobPayload payload) -> JobResult;
+  void reset_views_locked();
+  auto build_snapshot_locked(int slot) -> SnapshotPtr;
+  auto publish_snapshot_locked() -> bool;
+  auto local_states_locked() const -> const std::vector<std::uint8_t>&;
 
   bool m_initialized = false;
   int m_width = 0;
@@ -130,26 +108,15 @@ private:
   float m_half_height = 0.0F;
 
   mutable std::shared_mutex m_cells_mutex;
-  std::vector<std::uint8_t> m_cells;
+  VisibilityField m_field;
+  int m_local_player_id = 0;
+  int m_local_slot = -1;
+  bool m_baseline_changed = false;
+  std::vector<PublishedView> m_views;
+  std::unordered_map<int, VisibilityField::ViewerMask> m_viewer_masks;
   std::atomic<std::uint64_t> m_version{0};
-  mutable std::atomic<std::uint64_t> m_generation{0};
   std::shared_ptr<const Snapshot> m_published_snapshot;
-  std::chrono::steady_clock::time_point m_last_job_start_time{};
-
-  std::mutex m_queue_mutex;
-  std::condition_variable m_queue_cv;
-  std::optional<JobPayload> m_pending_payload;
-  std::optional<JobResult> m_completed_result;
-  std::thread m_worker_thread;
-  std::atomic<bool> m_worker_running{false};
-  std::atomic<bool> m_shutdown_requested{false};
-
-  struct CachedPosition {
-    int grid_x;
-    int grid_z;
-  };
-  std::unordered_map<std::uint64_t, CachedPosition> m_last_positions;
-  bool m_force_full_update{true};
+  std::chrono::steady_clock::time_point m_last_recompute_time{};
 };
 
 } // namespace Game::Map
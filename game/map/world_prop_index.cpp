@@ -0,0 +1,90 @@
+#include "world_prop_index.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Game::Map {
+
+void WorldPropIndex::reset(int grid_width, int grid_height) {
+  m_columns = std::max(1, (std::max(grid_width, 1) + k_cell_tiles - 1) / k_cell_tiles);
+  m_rows = std::max(1, (std::max(grid_height, 1) + k_cell_tiles - 1) / k_cell_tiles);
+  m_entries.clear();
+  m_cell_of_slot.clear();
+  m_free_slots.clear();
+  m_slot_of_id.clear();
+  std::size_t const cell_count =
+      static_cast<std::size_t>(m_columns) * static_cast<std::size_t>(m_rows);
+  for (auto& cells : m_cells) {
+    cells.clear();
+    cells.resize(cell_count);
+  }
+}
+
+auto WorldPropIndex::clamp_column(float grid_x) const -> int {
+  float const column = std::floor(grid_x / static_cast<float>(k_cell_tiles));
+  return static_cast<int>(std::clamp(column, 0.0F, static_cast<float>(m_columns - 1)));
+}
+
+auto WorldPropIndex::clamp_row(float grid_z) const -> int {
+  float const row = std::floor(grid_z / static_cast<float>(k_cell_tiles));
+  return static_cast<int>(std::clamp(row, 0.0F, static_cast<float>(m_rows - 1)));
+}
+
+auto WorldPropIndex::insert(const Entry& entry) -> bool {
+  auto const kind = harvest_prop_kind(entry.type);
+  if (entry.id == 0 || !kind.has_value() || m_columns <= 0 ||
+      m_slot_of_id.contains(entry.id)) {
+    return false;
+  }
+  std::uint32_t slot = 0;
+  if (m_free_slots.empty()) {
+    slot = static_cast<std::uint32_t>(m_entries.size());
+    m_entries.push_back(entry);
+    m_cell_of_slot.push_back(0U);
+  } else {
+    slot = m_free_slots.back();
+    m_free_slots.pop_back();
+    m_entries[slot] = entry;
+  }
+  std::size_t const cell =
+      cell_index(clamp_column(entry.grid_x), clamp_row(entry.grid_z));
+  m_cell_of_slot[slot] = static_cast<std::uint32_t>(cell);
+  m_cells[static_cast<std::size_t>(*kind)][cell].push_back(slot);
+  m_slot_of_id.emplace(entry.id, slot);
+  return true;
+}
+
+auto WorldPropIndex::remove(std::uint64_t id) -> bool {
+  auto const it = m_slot_of_id.find(id);
+  if (it == m_slot_of_id.end()) {
+    return false;
+  }
+  std::uint32_t const slot = it->second;
+  m_slot_of_id.erase(it);
+  auto const kind = harvest_prop_kind(m_entries[slot].type);
+  auto& bucket = m_cells[static_cast<std::size_t>(*kind)][m_cell_of_slot[slot]];
+  auto const position = std::find(bucket.begin(), bucket.end(), slot);
+  if (position != bucket.end()) {
+    *position = bucket.back();
+    bucket.pop_back();
+  }
+  m_entries[slot] = Entry{};
+  m_free_slots.push_back(slot);
+  return true;
+}
+
+auto WorldPropIndex::set_reserved(std::uint64_t id, bool reserved) -> bool {
+  auto const it = m_slot_of_id.find(id);
+  if (it == m_slot_of_id.end()) {
+    return false;
+  }
+  m_entries[it->second].reserved = reserved;
+  return true;
+}
+
+auto WorldPropIndex::find(std::uint64_t id) const -> const Entry* {
+  auto const it = m_slot_of_id.find(id);
+  return it == m_slot_of_id.end() ? nullptr : &m_entries[it->second];
+}
+
+} // namespace Game::Map
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "map_definition.h"
+
+namespace Game::Map {
+
+enum class HarvestPropKind : std::uint8_t {
+  Tree,
+  Boulder,
+  IronOre
+};
+
+[[nodiscard]] constexpr auto
+harvest_prop_kind(WorldProp::Type type) -> std::optional<HarvestPropKind> {
+  if (is_tree_world_prop_type(type)) {
+    return HarvestPropKind::Tree;
+  }
+  if (is_boulder_world_prop_type(type)) {
+    return HarvestPropKind::Boulder;
+  }
+  if (is_iron_ore_world_prop_type(type)) {
+    return HarvestPropKind::IronOre;
+  }
+  return std::nullopt;
+}
+
+class WorldPropIndex {
+public:
+  struct Entry {
+    std::uint64_t id{0};
+    WorldProp::Type type{WorldProp::Type::Tent};
+    float grid_x{0.0F};
+    float grid_z{0.0F};
+    float world_x{0.0F};
+    float world_z{0.0F};
+    bool reserved{false};
+  };
+
+  void reset(int grid_width, int grid_height);
+
+  auto insert(const Entry& entry) -> bool;
+  auto remove(std::uint64_t id) -> bool;
+  auto set_reserved(std::uint64_t id, bool reserved) -> bool;
+
+  [[nodiscard]] auto find(std::uint64_t id) const -> const Entry*;
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return m_slot_of_id.size();
+  }
+
+  template <typename Fn>
+  void for_each_unreserved(HarvestPropKind kind,
+                           float grid_x,
+                           float grid_z,
+                           float grid_radius,
+                           Fn&& fn) const {
+    auto const& cells = m_cells[static_cast<std::size_t>(kind)];
+    if (cells.empty() || grid_radius < 0.0F) {
+      return;
+    }
+    int const min_cx = clamp_column(grid_x - grid_radius);
+    int const max_cx = clamp_column(grid_x + grid_radius);
+    int const min_cz = clamp_row(grid_z - grid_radius);
+    int const max_cz = clamp_row(grid_z + grid_radius);
+    for (int cz = min_cz; cz <= max_cz; ++cz) {
+      for (int cx = min_cx; cx <= max_cx; ++cx) {
+        for (std::uint32_t const slot : cells[cell_index(cx, cz)]) {
+          Entry const& entry = m_entries[slot];
+          if (!entry.reserved) {
+            fn(entry);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  static constexpr int k_cell_tiles = 4;
+  static constexpr std::size_t k_kind_count = 3;
+
+  [[nodiscard]] auto clamp_column(float grid_x) const -> int;
+  [[nodiscard]] auto clamp_row(float grid_z) const -> int;
+  [[nodiscard]] auto cell_index(int column, int row) const -> std::size_t {
+    return static_cast<std::size_t>(row) * static_cast<std::size_t>(m_columns) +
+           static_cast<std::size_t>(column);
+  }
+
+  int m_columns{0};
+  int m_rows{0};
+  std::vector<Entry> m_entries;
+  std::vector<std::uint32_t> m_cell_of_slot;
+  std::vector<std::uint32_t> m_free_slots;
+  std::unordered_map<std::uint64_t, std::uint32_t> m_slot_of_id;
+  std::array<std::vector<std::vector<std::uint32_t>>, k_kind_count> m_cells;
+};
+
+} // namespace Game::Map
@@ -121,10 +121,11 @@ auto MinimapFogCompositor::apply(const QImage& base_image,
   }
 
   m_dirty_pixels.clear();
-  for (std::size_t cell = 0; cell < snapshot.cells.size(); ++cell) {
+  auto collect_cell = [this, &snapshot](std::size_t cell) {
     if (snapshot.cells[cell] == m_previous_cells[cell]) {
-      continue;
+      return;
     }
+    m_previous_cells[cell] = snapshot.cells[cell];
     for (std::uint32_t cursor = m_reverse_offsets[cell];
          cursor < m_reverse_offsets[cell + 1U];
          ++cursor) {
@@ -135,9 +136,31 @@ auto MinimapFogCompositor::apply(const QImage& base_image,
       m_dirty_pixel_stamps[pixel] = m_dirty_generation;
       m_dirty_pixels.push_back(pixel);
     }
+  };
+
+  // A snapshot that follows the one already composed lists where its cells
+  // moved, so only that rectangle needs diffing.
+  const bool follows_composed = snapshot.dirty_since_version != 0U &&
+                                snapshot.dirty_since_version == m_snapshot_version;
+  if (follows_composed) {
+    const auto& dirty = snapshot.dirty;
+    const int min_x = std::max(0, dirty.min_x);
+    const int max_x = std::min(snapshot.width - 1, dirty.max_x);
+    for (int z = std::max(0, dirty.min_z);
+         z <= std::min(snapshot.height - 1, dirty.max_z);
+         ++z) {
+      const std::size_t row =
+          static_cast<std::size_t>(z) * static_cast<std::size_t>(snapshot.width);
+      for (int x = min_x; x <= max_x; ++x) {
+        collect_cell(row + static_cast<std::size_t>(x));
+      }
+    }
+  } else {
+    for (std::size_t cell = 0; cell < snapshot.cells.size(); ++cell) {
+      collect_cell(cell);
+    }
   }
 
-  m_previous_cells = snapshot.cells;
   m_snapshot_version = snapshot.version;
   if (m_dirty_pixels.empty()) {
     return false;
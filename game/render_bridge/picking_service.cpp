@@ -7,15 +7,169 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "../core/component.h"
 #include "../core/world.h"
+#include "../core/world_spatial_index.h"
+#include "../map/heightfield_quadtree.h"
 #include "../map/terrain_service.h"
 #include "scene/camera.h"
 
 namespace Game::Systems {
 
+namespace {
+
+constexpr float k_unit_pick_radius = 30.0F;
+constexpr float k_entity_height_margin = 1.5F;
+constexpr float k_index_slack = 2.0F;
+constexpr float k_ray_parallel_epsilon = 1.0e-5F;
+
+struct WorldRect {
+  float min_x{0.0F};
+  float min_z{0.0F};
+  float max_x{0.0F};
+  float max_z{0.0F};
+};
+
+auto entity_height_band() -> std::pair<float, float> {
+  auto& terrain_service = Game::Map::TerrainService::instance();
+  auto const& quadtree = terrain_service.height_quadtree();
+  float lo = 0.0F;
+  float hi = 0.0F;
+  if (terrain_service.is_initialized() && !quadtree.empty()) {
+    lo = std::min(lo, quadtree.min_height());
+    hi = std::max(hi, quadtree.max_height());
+  }
+  return {lo - k_entity_height_margin, hi + k_entity_height_margin};
+}
+
+auto world_rect_under(const Render::GL::Camera& cam,
+                      int view_w,
+                      int view_h,
+                      const QRectF& screen_rect,
+                      WorldRect& out) -> bool {
+  if (view_w <= 0 || view_h <= 0) {
+    return false;
+  }
+  auto const [lo, hi] = entity_height_band();
+  QPointF const corners[4] = {screen_rect.topLeft(),
+                              screen_rect.topRight(),
+                              screen_rect.bottomLeft(),
+                              screen_rect.bottomRight()};
+  out.min_x = std::numeric_limits<float>::max();
+  out.min_z = std::numeric_limits<float>::max();
+  out.max_x = std::numeric_limits<float>::lowest();
+  out.max_z = std::numeric_limits<float>::lowest();
+  for (QPointF const& corner : corners) {
+    QVector3D origin;
+    QVector3D direction;
+    if (!cam.screen_to_world_ray(
+            corner.x(), corner.y(), qreal(view_w), qreal(view_h), origin, direction) ||
+        std::abs(direction.y()) < k_ray_parallel_epsilon) {
+      return false;
+    }
+    float const t_lo = (lo - origin.y()) / direction.y();
+    float const t_hi = (hi - origin.y()) / direction.y();
+    if (std::max(t_lo, t_hi) < 0.0F) {
+      return false;
+    }
+    for (float const t : {std::max(t_lo, 0.0F), std::max(t_hi, 0.0F)}) {
+      QVector3D const point = origin + direction * t;
+      out.min_x = std::min(out.min_x, point.x());
+      out.min_z = std::min(out.min_z, point.z());
+      out.max_x = std::max(out.max_x, point.x());
+      out.max_z = std::max(out.max_z, point.z());
+    }
+  }
+  out.min_x -= k_index_slack;
+  out.min_z -= k_index_slack;
+  out.max_x += k_index_slack;
+  out.max_z += k_index_slack;
+  return true;
+}
+
+template <typename Fn>
+void for_each_pick_candidate(Engine::Core::World& world,
+                             const Render::GL::Camera& cam,
+                             int view_w,
+                             int view_h,
+                             const QRectF& screen_rect,
+                             bool include_buildings,
+                             Fn&& fn) {
+  WorldRect bounds;
+  if (!world_rect_under(cam, view_w, view_h, screen_rect, bounds)) {
+    for (auto* entity :
+         world.collect_entities_with<Engine::Core::TransformComponent>()) {
+      fn(entity);
+    }
+    return;
+  }
+
+  auto& index = world.spatial_index();
+  index.refresh(world);
+  index.for_each_in_rect(
+      bounds.min_x,
+      bounds.min_z,
+      bounds.max_x,
+      bounds.max_z,
+      [&](const Engine::Core::WorldSpatialIndex::Entry& entry) {
+        if (entry.is(Engine::Core::WorldSpatialIndex::k_building)) {
+          return;
+        }
+        if (auto* entity = world.get_entity(entry.id); entity != nullptr) {
+          fn(entity);
+        }
+      });
+  if (!include_buildings) {
+    return;
+  }
+  for (Engine::Core::EntityID const id :
+       world.entities_with<Engine::Core::BuildingComponent>()) {
+    if (auto* entity = world.get_entity(id); entity != nullptr) {
+      fn(entity);
+    }
+  }
+}
+
+template <typename DeltaFn>
+auto find_surface_crossing(const DeltaFn& height_delta,
+                           float t_begin,
+                           float t_end,
+                           float step,
+                           float& out_t) -> bool {
+  float prev_t = t_begin;
+  float prev_delta = height_delta(prev_t);
+  while (prev_t < t_end) {
+    float const t = std::min(prev_t + step, t_end);
+    float const delta = height_delta(t);
+    if ((prev_delta >= 0.0F && delta <= 0.0F) ||
+        (prev_delta <= 0.0F && delta >= 0.0F)) {
+      float lo = prev_t;
+      float hi = t;
+      for (int i = 0; i < 16; ++i) {
+        float const mid = (lo + hi) * 0.5F;
+        float const mid_delta = height_delta(mid);
+        if ((prev_delta >= 0.0F && mid_delta >= 0.0F) ||
+            (prev_delta <= 0.0F && mid_delta <= 0.0F)) {
+          lo = mid;
+          prev_delta = mid_delta;
+        } else {
+          hi = mid;
+        }
+      }
+      out_t = (lo + hi) * 0.5F;
+      return true;
+    }
+    prev_t = t;
+    prev_delta = delta;
+  }
+  return false;
+}
+
+} // namespace
+
 auto PickingService::world_to_screen(const Render::GL::Camera& cam,
                                      int view_w,
                                      int view_h,
@@ -66,33 +220,22 @@ auto PickingService::screen_to_surface(const Render::GL::Camera& cam,
 
   constexpr float k_step = 1.0F;
   float const max_t = std::max(cam.get_far(), k_step);
-  float prev_t = 0.0F;
-  float prev_delta = height_delta(prev_t);
-  for (float t = k_step; t <= max_t; t += k_step) {
-    float const delta = height_delta(t);
-    if ((prev_delta >= 0.0F && delta <= 0.0F) ||
-        (prev_delta <= 0.0F && delta >= 0.0F)) {
-      float lo = prev_t;
-      float hi = t;
-      for (int i = 0; i < 16; ++i) {
-        float const mid = (lo + hi) * 0.5F;
-        float const mid_delta = height_delta(mid);
-        if ((prev_delta >= 0.0F && mid_delta >= 0.0F) ||
-            (prev_delta <= 0.0F && mid_delta <= 0.0F)) {
-          lo = mid;
-          prev_delta = mid_delta;
-        } else {
-          hi = mid;
-        }
-      }
+  thread_local std::vector<Game::Map::HeightfieldQuadtree::RaySpan> spans;
+  auto const& quadtree = terrain_service.height_quadtree();
+  if (quadtree.empty()) {
+    spans.assign(1U, {.t_enter = 0.0F, .t_exit = max_t});
+  } else {
+    quadtree.collect_ray_spans(ray_origin, ray_dir, max_t, spans);
+  }
 
-      out_world = ray_origin + ray_dir * ((lo + hi) * 0.5F);
+  for (auto const& span : spans) {
+    float hit_t = 0.0F;
+    if (find_surface_crossing(height_delta, span.t_enter, span.t_exit, k_step, hit_t)) {
+      out_world = ray_origin + ray_dir * hit_t;
       out_world.setY(
           terrain_service.sample_surface_height(out_world.x(), out_world.z()).world_y);
       return true;
     }
-    prev_t = t;
-    prev_delta = delta;
   }
 
   return screen_to_ground(cam, view_w, view_h, screen_pt, out_world);
@@ -172,22 +315,25 @@ auto PickingService::pick_single(float sx,
                                  bool prefer_buildings_first)
     -> Engine::Core::EntityID {
 
-  const float base_unit_pick_radius = 30.0F;
+  const float base_unit_pick_radius = k_unit_pick_radius;
   const float base_building_pick_radius = 30.0F;
   float best_unit_dist2 = std::numeric_limits<float>::max();
   float best_building_dist2 = std::numeric_limits<float>::max();
   Engine::Core::EntityID best_unit_id = 0;
   Engine::Core::EntityID best_building_id = 0;
-  auto ents = world.collect_entities_with<Engine::Core::TransformComponent>();
-  for (auto* e : ents) {
+  QRectF const search_rect(sx - base_unit_pick_radius,
+                           sy - base_unit_pick_radius,
+                           base_unit_pick_radius * 2.0F,
+                           base_unit_pick_radius * 2.0F);
+  auto const consider = [&](Engine::Core::Entity* e) {
     if (!e->has_component<Engine::Core::UnitComponent>()) {
-      continue;
+      return;
     }
     auto* t = e->get_component<Engine::Core::TransformComponent>();
     auto* u = e->get_component<Engine::Core::UnitComponent>();
 
-    if (owner_filter != 0 && u->owner_id != owner_filter) {
-      continue;
+    if (t == nullptr || (owner_filter != 0 && u->owner_id != owner_filter)) {
+      return;
     }
 
     QPointF sp;
@@ -195,7 +341,7 @@ auto PickingService::pick_single(float sx,
                                 view_w,
                                 view_h,
                                 sp)) {
-      continue;
+      return;
     }
     auto const dx = float(sx - sp.x());
     auto const dy = float(sy - sp.y());
@@ -272,7 +418,8 @@ auto PickingService::pick_single(float sx,
         best_unit_id = e->get_id();
       }
     }
-  }
+  };
+  for_each_pick_candidate(world, camera, view_w, view_h, search_rect, true, consider);
   if (prefer_buildings_first) {
     if ((best_building_id != 0U) &&
         ((best_unit_id == 0U) || best_building_dist2 <= best_unit_dist2)) {
@@ -323,30 +470,34 @@ auto PickingService::pick_in_rect(float x1,
   float const min_y = std::min(y1, y2);
   float const max_y = std::max(y1, y2);
   std::vector<Engine::Core::EntityID> picked;
-  auto ents = world.collect_entities_with<Engine::Core::TransformComponent>();
-  for (auto* e : ents) {
-    if (!e->has_component<Engine::Core::UnitComponent>()) {
-      continue;
-    }
-    if (e->has_component<Engine::Core::BuildingComponent>()) {
-      continue;
-    }
-    auto* u = e->get_component<Engine::Core::UnitComponent>();
-    if ((u == nullptr) || u->owner_id != owner_filter) {
-      continue;
-    }
-    auto* t = e->get_component<Engine::Core::TransformComponent>();
-    QPointF sp;
-    if (!camera.world_to_screen(QVector3D(t->position.x, t->position.y, t->position.z),
-                                view_w,
-                                view_h,
-                                sp)) {
-      continue;
-    }
-    if (sp.x() >= min_x && sp.x() <= max_x && sp.y() >= min_y && sp.y() <= max_y) {
-      picked.push_back(e->get_id());
-    }
-  }
+  QRectF const search_rect(QPointF(min_x, min_y), QPointF(max_x, max_y));
+  for_each_pick_candidate(
+      world, camera, view_w, view_h, search_rect, false, [&](Engine::Core::Entity* e) {
+        if (!e->has_component<Engine::Core::UnitComponent>()) {
+          return;
+        }
+        if (e->has_component<Engine::Core::BuildingComponent>()) {
+          return;
+        }
+        auto* u = e->get_component<Engine::Core::UnitComponent>();
+        auto* t = e->get_component<Engine::Core::TransformComponent>();
+        if ((u == nullptr) || (t == nullptr) || u->owner_id != owner_filter) {
+          return;
+        }
+        QPointF sp;
+        if (!camera.world_to_screen(
+                QVector3D(t->position.x, t->position.y, t->position.z),
+                view_w,
+                view_h,
+                sp)) {
+          return;
+        }
+        if (sp.x() >= min_x && sp.x() <= max_x && sp.y() >= min_y &&
+            sp.y() <= max_y) {
+          picked.push_back(e->get_id());
+        }
+      });
+  std::sort(picked.begin(), picked.end());
   return picked;
 }
 
@@ -2280,7 +2280,7 @@ void Serialization::deserialize_terrain(
 }
 
 auto Serialization::serialize_world(const World* world) -> QJsonDocument {
-  QJsonObject world_obj;
+  QJsonObject world_obj = serialize_world_header(world);
   QJsonArray entities_array;
 
   world->for_each_entity([&entities_array](Entity& entity) {
@@ -2291,6 +2291,11 @@ auto Serialization::serialize_world(const World* world) -> QJsonDocument {
   });
 
   world_obj["entities"] = entities_array;
+  return QJsonDocument(world_obj);
+}
+
+auto Serialization::serialize_world_header(const World* world) -> QJsonObject {
+  QJsonObject world_obj;
   world_obj["nextEntityId"] = static_cast<qint64>(world->get_next_entity_id());
   world_obj["schemaVersion"] = 2;
   world_obj["owner_registry"] = Game::Systems::OwnerRegistry::instance().to_json();
@@ -2307,7 +2312,7 @@ auto Serialization::serialize_world(const World* world) -> QJsonDocument {
                                              terrain_service.authored_world_props());
   }
 
-  return QJsonDocument(world_obj);
+  return world_obj;
 }
 
 void Serialization::deserialize_world(World* world, const QJsonDocument& doc) {
@@ -2324,6 +2329,11 @@ void Serialization::deserialize_world(World* world, const QJsonDocument& doc) {
     }
   }
 
+  deserialize_world_header(world, world_obj);
+}
+
+void Serialization::deserialize_world_header(World* world,
+                                             const QJsonObject& world_obj) {
   if (world_obj.contains("nextEntityId")) {
     const auto next_id =
         static_cast<EntityID>(world_obj["nextEntityId"].toVariant().toULongLong());
@@ -23,6 +23,12 @@ public:
   static auto serialize_world(const class World* world) -> QJsonDocument;
   static void deserialize_world(class World* world, const QJsonDocument& doc);
 
+  // Everything serialize_world writes except the entities: next id, owner and
+  // army registries, and terrain. Binary world snapshots carry it as-is.
+  static auto serialize_world_header(const class World* world) -> QJsonObject;
+  static void deserialize_world_header(class World* world,
+                                       const QJsonObject& world_obj);
+
   static auto serialize_terrain(
       const Game::Map::TerrainHeightMap* height_map,
       const Game::Map::BiomeSettings& biome,
@@ -0,0 +1,1098 @@
+#include "world_snapshot.h"
+
+#include <QCborValue>
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QJsonValue>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../core/component.h"
+#include "../core/registry.h"
+#include "../core/world.h"
+#include "serialization.h"
+#include "snapshot_contract.h"
+
+namespace Engine::Core {
+
+// MovementComponent keeps its route private; the snapshot needs the same
+// fields Serialization writes.
+struct MovementSnapshotAccess {
+  template <typename Archive, typename Movement>
+  static void fields(Archive& archive, Movement& movement) {
+    archive(movement.has_target,
+            movement.target_x,
+            movement.target_y,
+            movement.goal_x,
+            movement.goal_y,
+            movement.vx,
+            movement.vz,
+            movement.precise_arrival,
+            movement.navigation_clearance,
+            movement.path_index);
+    archive.sequence(movement.path,
+                     [&](auto& waypoint) { archive(waypoint.first, waypoint.second); });
+  }
+
+  static void settle(MovementComponent& movement) {
+    movement.navigation_clearance = std::max(0.0F, movement.navigation_clearance);
+    movement.validate_path_index();
+    if (!movement.has_target) {
+      movement.clear_path();
+    }
+  }
+};
+
+} // namespace Engine::Core
+
+namespace Game::Save {
+
+namespace {
+
+using namespace Engine::Core;
+
+constexpr const char* k_magic = "SOIWSNP\x01";
+constexpr std::size_t k_magic_size = 8;
+constexpr std::uint32_t k_max_rows = 1U << 24U;
+constexpr std::uint32_t k_no_row = 0xFFFFFFFFU;
+
+template <typename T>
+using Bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+// Fields are written little-endian and unpadded, in the order a column's
+// fields() lists them.
+class ByteWriter {
+public:
+  explicit ByteWriter(QByteArray& out)
+      : m_out(&out) {}
+
+  template <typename... Fields>
+  void operator()(const Fields&... fields) {
+    (write(fields), ...);
+  }
+
+  template <typename T, typename Element>
+  void sequence(const std::vector<T>& values, Element&& element) {
+    write(static_cast<std::uint32_t>(values.size()));
+    for (const T& value : values) {
+      element(value);
+    }
+  }
+
+  template <typename T>
+  void write(const T& value) {
+    if constexpr (std::is_enum_v<T>) {
+      write(static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_same_v<T, bool>) {
+      write(static_cast<std::uint8_t>(value ? 1U : 0U));
+    } else if constexpr (std::is_floating_point_v<T>) {
+      write(std::bit_cast<Bits<T>>(value));
+    } else if constexpr (std::is_integral_v<T>) {
+      auto bits = static_cast<std::make_unsigned_t<T>>(value);
+      std::array<char, sizeof(T)> bytes{};
+      for (char& byte : bytes) {
+        byte = static_cast<char>(bits & 0xFFU);
+        if constexpr (sizeof(T) > 1) {
+          bits = static_cast<std::make_unsigned_t<T>>(bits >> 8U);
+        }
+      }
+      m_out->append(bytes.data(), static_cast<qsizetype>(bytes.size()));
+    } else {
+      static_assert(std::is_same_v<T, std::string>, "no snapshot encoding for type");
+      write(static_cast<std::uint32_t>(value.size()));
+      m_out->append(value.data(), static_cast<qsizetype>(value.size()));
+    }
+  }
+
+  void write_raw(const char* data, std::size_t size) {
+    m_out->append(data, static_cast<qsizetype>(size));
+  }
+
+  [[nodiscard]] auto position() const -> qsizetype { return m_out->size(); }
+
+  // Fills in a size written as a placeholder once the bytes after it exist.
+  void patch(qsizetype at, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+      (*m_out)[at + i] = static_cast<char>((value >> (8U * i)) & 0xFFU);
+    }
+  }
+
+private:
+  QByteArray* m_out;
+};
+
+// Reads what ByteWriter wrote. Running past the end leaves the reader failed
+// and every later field zeroed, so callers check ok() once per block.
+class ByteReader {
+public:
+  ByteReader(const char* data, std::size_t size)
+      : m_data(data)
+      , m_end(data + size) {}
+
+  [[nodiscard]] auto ok() const -> bool { return m_ok; }
+  [[nodiscard]] auto remaining() const -> std::size_t {
+    return static_cast<std::size_t>(m_end - m_data);
+  }
+  [[nodiscard]] auto at_end() const -> bool { return m_ok && m_data == m_end; }
+
+  template <typename... Fields>
+  void operator()(Fields&... fields) {
+    (read(fields), ...);
+  }
+
+  template <typename T, typename Element>
+  void sequence(std::vector<T>& values, Element&& element) {
+    std::uint32_t count = 0;
+    read(count);
+    if (count > remaining()) {
+      fail();
+      return;
+    }
+    values.resize(count);
+    for (T& value : values) {
+      element(value);
+    }
+  }
+
+  template <typename T>
+  void read(T& value) {
+    if constexpr (std::is_enum_v<T>) {
+      std::underlying_type_t<T> raw{};
+      read(raw);
+      value = static_cast<T>(raw);
+    } else if constexpr (std::is_same_v<T, bool>) {
+      std::uint8_t raw = 0;
+      read(raw);
+      value = raw != 0U;
+    } else if constexpr (std::is_floating_point_v<T>) {
+      Bits<T> raw = 0;
+      read(raw);
+      value = std::bit_cast<T>(raw);
+    } else if constexpr (std::is_integral_v<T>) {
+      const char* bytes = take(sizeof(T));
+      std::make_unsigned_t<T> bits = 0;
+      if (bytes != nullptr) {
+        for (std::size_t i = sizeof(T); i-- > 0;) {
+          bits = static_cast<std::make_unsigned_t<T>>(
+              (static_cast<std::uint64_t>(bits) << 8U) |
+              static_cast<unsigned char>(bytes[i]));
+        }
+      }
+      value = static_cast<T>(bits);
+    } else {
+      static_assert(std::is_same_v<T, std::string>, "no snapshot encoding for type");
+      std::uint32_t size = 0;
+      read(size);
+      const char* bytes = take(size);
+      value.assign(bytes != nullptr ? bytes : "", bytes != nullptr ? size : 0U);
+    }
+  }
+
+  auto take(std::size_t size) -> const char* {
+    if (!m_ok || size > remaining()) {
+      fail();
+      return nullptr;
+    }
+    const char* bytes = m_data;
+    m_data += size;
+    return bytes;
+  }
+
+private:
+  void fail() {
+    m_ok = false;
+    m_data = m_end;
+  }
+
+  const char* m_data;
+  const char* m_end;
+  bool m_ok{true};
+};
+
+// One specialization per saved component. fields() runs for both directions,
+// so the writer and reader cannot drift apart; settle() repeats the fix-ups
+// Serialization::deserialize_entity applies after reading the same fields.
+template <typename T>
+struct Column;
+
+template <>
+struct Column<TransformComponent> {
+  static constexpr std::string_view k_name = "transform";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.position.x, c.position.y, c.position.z);
+    a(c.rotation.x, c.rotation.y, c.rotation.z);
+    a(c.scale.x, c.scale.y, c.scale.z);
+    a(c.has_desired_yaw, c.desired_yaw);
+  }
+};
+
+template <>
+struct Column<RenderableComponent> {
+  static constexpr std::string_view k_name = "renderable";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.renderer_id, c.visible);
+  }
+};
+
+template <>
+struct Column<UnitComponent> {
+  static constexpr std::string_view k_name = "unit";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.health, c.max_health, c.speed, c.vision_range, c.spawn_type, c.owner_id);
+    a(c.nation_id, c.uses_nation_formation_profile);
+    a(c.render_individuals_per_unit_override, c.render_rider);
+    a(c.death_sequence_override);
+  }
+};
+
+template <>
+struct Column<MovementComponent> {
+  static constexpr std::string_view k_name = "movement";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    MovementSnapshotAccess::fields(a, c);
+  }
+  static void settle(MovementComponent& c) { MovementSnapshotAccess::settle(c); }
+};
+
+template <>
+struct Column<PlayerOrderIntentComponent> {
+  static constexpr std::string_view k_name = "player_order_intent";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.kind, c.suppress_opportunistic_combat);
+  }
+};
+
+template <>
+struct Column<AttackComponent> {
+  static constexpr std::string_view k_name = "attack";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.range, c.damage, c.cooldown, c.time_since_last);
+    a(c.melee_range, c.melee_damage, c.melee_cooldown);
+    a(c.preferred_mode, c.current_mode, c.can_melee, c.can_ranged);
+    a(c.max_height_difference, c.in_melee_lock, c.melee_lock_target_id);
+  }
+};
+
+template <>
+struct Column<AttackTargetComponent> {
+  static constexpr std::string_view k_name = "attack_target";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.target_id, c.should_chase, c.is_player_command);
+  }
+};
+
+template <>
+struct Column<CommanderComponent> {
+  static constexpr std::string_view k_name = "commander";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.commander_id, c.display_name, c.strategic_identity, c.passive_aura);
+    a(c.bonus_type, c.bonus_summary, c.rally_ability, c.death_consequence);
+    a(c.bodyguard_count, c.aura_radius, c.aura_morale_bonus, c.aura_bonus_value);
+    a(c.rally_range, c.rally_cooldown, c.rally_morale_restore);
+    a(c.rally_cooldown_remaining, c.rally_feedback_time);
+    a(c.death_shock_radius, c.death_morale_shock, c.aura_active);
+    a(c.aura_ability_active, c.aura_ability_requested, c.aura_ability_duration);
+    a(c.aura_ability_remaining, c.aura_ability_cooldown);
+    a(c.aura_ability_cooldown_remaining, c.aura_affinity_spawn_type);
+    a(c.wounded, c.rally_requested, c.rally_requires_manual_trigger);
+    a(c.fpv_controlled, c.flag_rally_cost);
+    a(c.flag_rally_pending_x, c.flag_rally_pending_z, c.flag_rally_animation_timer);
+    a(c.flag_rally_in_progress, c.flag_rally_at_position);
+    a(c.flag_rally_flag_x, c.flag_rally_flag_z);
+    a(c.flag_rally_flag_active, c.flag_rally_issue_commands);
+  }
+};
+
+template <>
+struct Column<RpgHealthComponent> {
+  static constexpr std::string_view k_name = "rpg_health";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.incoming_damage_scale, c.armor, c.crit_chance, c.crit_multiplier);
+  }
+};
+
+template <>
+struct Column<MoraleComponent> {
+  static constexpr std::string_view k_name = "morale";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.morale, c.commander_aura_bonus, c.shock_timer, c.wavering, c.routing);
+  }
+};
+
+template <>
+struct Column<UndeadComponent> {
+  static constexpr std::string_view k_name = "undead";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.morale_immune, c.fire_damage_multiplier, c.priest_damage_multiplier);
+    a(c.cavalry_charge_damage_multiplier, c.counts_for_economy);
+  }
+};
+
+template <>
+struct Column<CursedStatusComponent> {
+  static constexpr std::string_view k_name = "cursed_status";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.morale_penalty_per_hit, c.duration, c.remaining_duration, c.stacks);
+  }
+};
+
+template <>
+struct Column<BurningStatusComponent> {
+  static constexpr std::string_view k_name = "burning_status";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.duration, c.remaining_duration, c.ignition_elapsed, c.tick_interval);
+    a(c.tick_accumulator, c.damage_per_tick, c.attacker_id, c.fire_bonus_multiplier);
+  }
+};
+
+template <>
+struct Column<PatrolComponent> {
+  static constexpr std::string_view k_name = "patrol";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.current_waypoint, c.patrolling);
+    a.sequence(c.waypoints,
+               [&](auto& waypoint) { a(waypoint.first, waypoint.second); });
+  }
+};
+
+template <>
+struct Column<BuildingComponent> {
+  static constexpr std::string_view k_name = "building";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.original_nation_id);
+  }
+};
+
+template <>
+struct Column<ProductionComponent> {
+  static constexpr std::string_view k_name = "production";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.in_progress, c.build_time, c.time_remaining, c.produced_count, c.max_units);
+    a(c.product_type, c.rally_x, c.rally_z, c.rally_set);
+    a(c.villager_cost, c.manpower_available);
+    a.sequence(c.production_queue, [&](auto& troop) { a(troop); });
+  }
+};
+
+template <>
+struct Column<AIControlledComponent> {
+  static constexpr std::string_view k_name = "aiControlled";
+  template <typename Archive, typename C>
+  static void fields(Archive& /*a*/, C& /*c*/) {}
+};
+
+template <>
+struct Column<CaptureComponent> {
+  static constexpr std::string_view k_name = "capture";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.capturing_player_id, c.capture_progress, c.required_time);
+    a(c.is_being_captured);
+  }
+};
+
+template <>
+struct Column<AssaultWaveComponent> {
+  static constexpr std::string_view k_name = "assault_wave";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.active, c.wave_phase, c.has_march_target, c.march_target_x);
+    a(c.march_target_z);
+  }
+};
+
+template <>
+struct Column<HoldModeComponent> {
+  static constexpr std::string_view k_name = "hold_mode";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.active, c.exit_cooldown, c.stand_up_duration, c.kneel_entry_progress);
+    a(c.kneel_duration);
+  }
+};
+
+template <>
+struct Column<GuardModeComponent> {
+  static constexpr std::string_view k_name = "guard_mode";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.active, c.guarded_entity_id, c.guard_position_x, c.guard_position_z);
+    a(c.guard_radius, c.returning_to_guard_position, c.has_guard_target);
+  }
+};
+
+template <>
+struct Column<HealerComponent> {
+  static constexpr std::string_view k_name = "healer";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.healing_range, c.healing_amount, c.healing_cooldown, c.time_since_last_heal);
+    a(c.is_healing_active, c.healing_target_x, c.healing_target_z);
+    a(c.target_affinity, c.suppress_attack_while_healing);
+  }
+};
+
+template <>
+struct Column<SpecialAttackComponent> {
+  static constexpr std::string_view k_name = "special_attack";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.projectile_kind, c.use_projectile_system, c.friendly_fire);
+    a(c.splash_radius, c.splash_damage_multiplier);
+    a(c.bonus_damage_multiplier_vs_fire_vulnerable);
+    a(c.cursed_duration, c.cursed_morale_penalty_per_hit, c.cursed_stacks_per_hit);
+    a(c.fire_patch_duration, c.fire_patch_radius);
+    a(c.burn_duration, c.burn_tick_interval, c.burn_damage_per_tick);
+  }
+};
+
+template <>
+struct Column<FirePatchComponent> {
+  static constexpr std::string_view k_name = "fire_patch";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.radius, c.duration, c.remaining_duration, c.burn_duration);
+    a(c.burn_tick_interval, c.burn_damage_per_tick, c.attacker_owner_id);
+    a(c.attacker_id, c.friendly_fire, c.fire_bonus_multiplier);
+  }
+};
+
+template <>
+struct Column<StructureFireComponent> {
+  static constexpr std::string_view k_name = "structure_fire";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.ignition_progress, c.ignition_threshold, c.duration, c.remaining_duration);
+    a(c.ignition_elapsed, c.tick_interval, c.tick_accumulator);
+    a(c.damage_per_tick, c.attacker_id);
+  }
+};
+
+template <>
+struct Column<CommanderGuardComponent> {
+  static constexpr std::string_view k_name = "commander_guard";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.active, c.frontal_arc_dot, c.damage_multiplier);
+  }
+};
+
+template <>
+struct Column<CatapultLoadingComponent> {
+  static constexpr std::string_view k_name = "catapult_loading";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.state, c.loading_time, c.loading_duration, c.firing_time, c.firing_duration);
+    a(c.target_id, c.target_locked_x, c.target_locked_y, c.target_locked_z);
+    a(c.target_position_locked, c.loaded_projectile_kind);
+  }
+};
+
+template <>
+struct Column<ElephantComponent> {
+  static constexpr std::string_view k_name = "elephant";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.charge_state, c.charge_speed_multiplier, c.charge_duration);
+    a(c.charge_cooldown, c.trample_radius, c.trample_damage);
+    a(c.trample_damage_accumulator);
+  }
+};
+
+template <>
+struct Column<ElephantPanicComponent> {
+  static constexpr std::string_view k_name = "elephant_panic";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.duration);
+  }
+};
+
+template <>
+struct Column<ElephantStompImpactComponent> {
+  static constexpr std::string_view k_name = "elephant_stomp_impacts";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a.sequence(c.impacts, [&](auto& impact) { a(impact.x, impact.z, impact.time); });
+  }
+};
+
+template <>
+struct Column<CombatStateComponent> {
+  static constexpr std::string_view k_name = "combat_state";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.animation_state, c.attack_family, c.state_time, c.state_duration);
+    a(c.attack_offset, c.attack_variant);
+    a(c.intent.strike_dir_x, c.intent.strike_dir_y, c.intent.thrust_amount);
+    a(c.intent.elevation, c.intent.charge, c.intent.swing_speed);
+    a(c.intent.follow_through);
+    a(c.finisher_attack, c.is_hit_paused, c.hit_pause_remaining);
+  }
+  static void settle(CombatStateComponent& c) {
+    c.intent.windup_dir_x = -c.intent.strike_dir_x;
+    c.intent.windup_dir_y = -c.intent.strike_dir_y;
+    complete_melee_intent(c.intent);
+  }
+};
+
+template <>
+struct Column<HitFeedbackComponent> {
+  static constexpr std::string_view k_name = "hit_feedback";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.source_attacker_id, c.is_reacting, c.reaction_time, c.reaction_intensity);
+    a(c.knockback_x, c.knockback_z, c.reaction_duration, c.reaction_kind);
+  }
+};
+
+template <>
+struct Column<BuilderProductionComponent> {
+  static constexpr std::string_view k_name = "builder_production";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.in_progress, c.build_time, c.time_remaining, c.product_type);
+    a(c.construction_complete, c.has_construction_site);
+    a(c.construction_site_x, c.construction_site_z, c.construction_site_rotation_y);
+    a(c.has_task_target, c.task_target_id, c.task_target_x, c.task_target_z);
+    a(c.task_target_reserved, c.at_construction_site);
+    a(c.construction_site_entity_id, c.structure_task_entity_id);
+    a.sequence(c.queued_construction_site_ids, [&](auto& site_id) { a(site_id); });
+    a(c.bypass_movement_active, c.bypass_target_x, c.bypass_target_z);
+    a(c.has_gather_order, c.gather_product_type);
+    a(c.gather_anchor_x, c.gather_anchor_z);
+    a(c.auto_gather, c.auto_gather_priority);
+  }
+};
+
+template <>
+struct Column<WallSegmentComponent> {
+  static constexpr std::string_view k_name = "wall_segment";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.grid_x, c.grid_z);
+  }
+};
+
+template <>
+struct Column<WallConstructionSiteComponent> {
+  static constexpr std::string_view k_name = "wall_construction_site";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.owner_id, c.nation_id, c.build_time, c.progress, c.product_type);
+  }
+};
+
+template <>
+struct Column<DismantleSiteComponent> {
+  static constexpr std::string_view k_name = "dismantle_site";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.duration, c.progress);
+  }
+};
+
+template <>
+struct Column<GateComponent> {
+  static constexpr std::string_view k_name = "gate";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.state, c.manual_mode, c.open_amount, c.open_speed, c.trigger_radius);
+    a(c.hold_open_seconds, c.hold_timer);
+  }
+};
+
+template <>
+struct Column<FormationModeComponent> {
+  static constexpr std::string_view k_name = "formation_mode";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.active, c.formation_center_x, c.formation_center_z, c.formation_id);
+    a(c.stable_slot_id, c.stable_rank, c.stable_file);
+    a(c.stable_slot_x, c.stable_slot_z);
+  }
+};
+
+template <>
+struct Column<ArmyFormationMembershipComponent> {
+  static constexpr std::string_view k_name = "army_formation_membership";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.group_id, c.slot_id);
+  }
+};
+
+template <>
+struct Column<UnitLayoutStateComponent> {
+  static constexpr std::string_view k_name = "unit_layout_state";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.state, c.phase, c.transition_progress, c.transition_seconds);
+    a(c.layout_id, c.requested_layout_id);
+  }
+};
+
+template <>
+struct Column<StaminaComponent> {
+  static constexpr std::string_view k_name = "stamina";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.stamina, c.max_stamina, c.regen_rate, c.depletion_rate);
+    a(c.is_running, c.run_requested);
+  }
+};
+
+template <>
+struct Column<TerrainContextComponent> {
+  static constexpr std::string_view k_name = "terrain_context";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.is_on_bridge, c.is_at_hill_entrance, c.audio_cooldown);
+  }
+};
+
+template <>
+struct Column<HomeComponent> {
+  static constexpr std::string_view k_name = "home";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.population_contribution, c.nearest_barracks_id, c.update_cooldown);
+    a(c.family_generation_cooldown, c.family_generation_interval);
+    a(c.family_manpower_value);
+  }
+};
+
+template <>
+struct Column<FarmComponent> {
+  static constexpr std::string_view k_name = "farm";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.growth, c.cycle_seconds, c.harvests);
+  }
+};
+
+template <>
+struct Column<CivilianDeliveryComponent> {
+  static constexpr std::string_view k_name = "civilian_delivery";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.target_barracks_id);
+  }
+};
+
+template <>
+struct Column<ResourceCarryComponent> {
+  static constexpr std::string_view k_name = "resource_carry";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    for (auto& amount : c.amounts.values) {
+      a(amount);
+    }
+    a(c.depot_entity_id, c.has_depot);
+  }
+};
+
+template <>
+struct Column<SettlementResidentComponent> {
+  static constexpr std::string_view k_name = "settlement_resident";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.hearth_x, c.hearth_z, c.roam_radius, c.hearth_assigned, c.released);
+    a(c.errand, c.role, c.focus_id, c.errand_x, c.errand_z, c.focus_x, c.focus_z);
+    a(c.work_elapsed, c.errand_remaining, c.planned_dwell, c.think_cooldown);
+    a(c.rng_state);
+  }
+};
+
+template <>
+struct Column<WildlifeComponent> {
+  static constexpr std::string_view k_name = "wildlife";
+  template <typename Archive, typename C>
+  static void fields(Archive& a, C& c) {
+    a(c.species, c.behavior, c.group_id, c.home_x, c.home_z, c.roam_radius);
+    a(c.anchor_assigned, c.target_x, c.target_z, c.think_cooldown, c.state_timer);
+    a(c.alarm_timer, c.hostile_timer, c.bite_timer, c.bite_target_id);
+    a(c.bite_impact_pending, c.focus_id, c.aggressor_id, c.rng_state);
+  }
+};
+
+// Every component Serialization::serialize_entity writes, in column order.
+// SnapshotContractTest holds this list to the contract's authoritative entries.
+using SnapshotColumns = std::tuple<TransformComponent,
+                                   RenderableComponent,
+                                   UnitComponent,
+                                   MovementComponent,
+                                   PlayerOrderIntentComponent,
+                                   AttackComponent,
+                                   AttackTargetComponent,
+                                   CommanderComponent,
+                                   RpgHealthComponent,
+                                   MoraleComponent,
+                                   UndeadComponent,
+                                   CursedStatusComponent,
+                                   BurningStatusComponent,
+                                   PatrolComponent,
+                                   BuildingComponent,
+                                   ProductionComponent,
+                                   AIControlledComponent,
+                                   CaptureComponent,
+                                   AssaultWaveComponent,
+                                   HoldModeComponent,
+                                   GuardModeComponent,
+                                   HealerComponent,
+                                   SpecialAttackComponent,
+                                   FirePatchComponent,
+                                   StructureFireComponent,
+                                   CommanderGuardComponent,
+                                   CatapultLoadingComponent,
+                                   ElephantComponent,
+                                   ElephantPanicComponent,
+                                   ElephantStompImpactComponent,
+                                   CombatStateComponent,
+                                   HitFeedbackComponent,
+                                   BuilderProductionComponent,
+                                   WallSegmentComponent,
+                                   WallConstructionSiteComponent,
+                                   DismantleSiteComponent,
+                                   GateComponent,
+                                   FormationModeComponent,
+                                   ArmyFormationMembershipComponent,
+                                   UnitLayoutStateComponent,
+                                   StaminaComponent,
+                                   TerrainContextComponent,
+                                   HomeComponent,
+                                   FarmComponent,
+                                   CivilianDeliveryComponent,
+                                   ResourceCarryComponent,
+                                   SettlementResidentComponent,
+                                   WildlifeComponent>;
+
+template <typename Fn>
+void for_each_column(Fn&& fn) {
+  [&]<typename... Ts>(std::type_identity<std::tuple<Ts...>>) {
+    (fn(std::type_identity<Ts>{}), ...);
+  }(std::type_identity<SnapshotColumns>{});
+}
+
+// Writes one column: name, row indices into the entity table, then the packed
+// fields in dense storage order. Empty columns are left out.
+template <typename T>
+auto capture_column(const Registry& registry,
+                    std::span<const std::uint32_t> row_of_index,
+                    ByteWriter& out) -> bool {
+  const ComponentStorage<T>* store = registry.find_storage<T>();
+  if (store == nullptr || store->empty()) {
+    return false;
+  }
+
+  std::vector<std::uint32_t> rows;
+  std::vector<std::uint32_t> positions;
+  rows.reserve(store->size());
+  positions.reserve(store->size());
+  const auto entities = store->entities();
+  for (std::size_t position = 0; position < entities.size(); ++position) {
+    const std::uint32_t index = Handle::index_of(entities[position]);
+    if (index >= row_of_index.size() || row_of_index[index] == k_no_row) {
+      continue;
+    }
+    rows.push_back(row_of_index[index]);
+    positions.push_back(static_cast<std::uint32_t>(position));
+  }
+  if (rows.empty()) {
+    return false;
+  }
+
+  out.write(std::string(Column<T>::k_name));
+  out.write(static_cast<std::uint32_t>(rows.size()));
+  for (const std::uint32_t row : rows) {
+    out.write(row);
+  }
+  const qsizetype size_at = out.position();
+  out.write(std::uint32_t{0});
+  for (const std::uint32_t position : positions) {
+    Column<T>::fields(out, store->at(position));
+  }
+  out.patch(size_at,
+            static_cast<std::uint32_t>(out.position() - size_at - qsizetype{4}));
+  return true;
+}
+
+class StagedColumn {
+public:
+  StagedColumn() = default;
+  StagedColumn(const StagedColumn&) = delete;
+  StagedColumn(StagedColumn&&) = delete;
+  auto operator=(const StagedColumn&) -> StagedColumn& = delete;
+  auto operator=(StagedColumn&&) -> StagedColumn& = delete;
+  virtual ~StagedColumn() = default;
+
+  virtual void apply(Registry& registry) = 0;
+};
+
+// A decoded column waiting to be added in one Registry::emplace_bulk call.
+template <typename T>
+class TypedStagedColumn final : public StagedColumn {
+public:
+  std::vector<EntityID> entity_ids;
+  std::vector<T> values;
+
+  void apply(Registry& registry) override {
+    registry.emplace_bulk<T>(entity_ids, std::span<T>(values));
+  }
+};
+
+template <typename T>
+auto stage_column(ByteReader& payload, std::vector<EntityID> entity_ids)
+    -> std::unique_ptr<StagedColumn> {
+  auto column = std::make_unique<TypedStagedColumn<T>>();
+  column->entity_ids = std::move(entity_ids);
+  column->values.resize(column->entity_ids.size());
+  for (T& value : column->values) {
+    Column<T>::fields(payload, value);
+    if constexpr (requires { Column<T>::settle(value); }) {
+      Column<T>::settle(value);
+    }
+  }
+  if (!payload.at_end()) {
+    return nullptr;
+  }
+  return column;
+}
+
+auto make_error(QString* out_error, const QString& message) -> bool {
+  if (out_error != nullptr) {
+    *out_error = message;
+  }
+  return false;
+}
+
+auto truncated(QString* out_error) -> bool {
+  return make_error(out_error,
+                    QCoreApplication::translate("SaveFile",
+                                                "World snapshot is truncated"));
+}
+
+auto corrupted_column(QString* out_error, const std::string& name) -> bool {
+  return make_error(
+      out_error,
+      QCoreApplication::translate("SaveFile", "World snapshot column '%1' is corrupted")
+          .arg(QString::fromStdString(name)));
+}
+
+} // namespace
+
+auto is_world_snapshot(const QByteArray& bytes) -> bool {
+  return static_cast<std::size_t>(bytes.size()) >= k_magic_size &&
+         std::memcmp(bytes.constData(), k_magic, k_magic_size) == 0;
+}
+
+auto capture_world_snapshot(const World& world) -> QByteArray {
+  const World::EntityLock lock(world);
+  const Registry& registry = world.registry();
+
+  // Construction previews are UI state; serialize_world drops them too.
+  const auto* previews = registry.find_storage<ConstructionPreviewComponent>();
+  std::vector<std::uint32_t> row_of_index(registry.slot_count(), k_no_row);
+  std::vector<EntityID> entity_ids;
+  entity_ids.reserve(registry.entity_count());
+  for (std::uint32_t index = 1; index < registry.slot_count(); ++index) {
+    const EntityID entity_id = registry.entity_at_index(index);
+    if (entity_id == NULL_ENTITY ||
+        (previews != nullptr && previews->contains(entity_id))) {
+      continue;
+    }
+    row_of_index[index] = static_cast<std::uint32_t>(entity_ids.size());
+    entity_ids.push_back(entity_id);
+  }
+
+  QByteArray bytes;
+  bytes.reserve(static_cast<qsizetype>(entity_ids.size()) * 256);
+  ByteWriter out(bytes);
+  out.write_raw(k_magic, k_magic_size);
+  out.write(static_cast<std::uint32_t>(k_world_snapshot_format));
+  out.write(static_cast<std::uint32_t>(k_snapshot_version));
+
+  out.write(static_cast<std::uint32_t>(entity_ids.size()));
+  for (const EntityID entity_id : entity_ids) {
+    out.write(entity_id);
+  }
+
+  const qsizetype count_at = out.position();
+  out.write(std::uint32_t{0});
+  std::uint32_t column_count = 0;
+  for_each_column([&]<typename T>(std::type_identity<T>) {
+    if (capture_column<T>(registry, row_of_index, out)) {
+      ++column_count;
+    }
+  });
+  out.patch(count_at, column_count);
+
+  const QByteArray header =
+      QCborValue::fromJsonValue(Serialization::serialize_world_header(&world))
+          .toCbor(QCborValue::UseFloat);
+  out.write(static_cast<std::uint32_t>(header.size()));
+  out.write_raw(header.constData(), static_cast<std::size_t>(header.size()));
+  return bytes;
+}
+
+auto restore_world_snapshot(World& world,
+                            const QByteArray& bytes,
+                            QString* out_error) -> bool {
+  if (!is_world_snapshot(bytes)) {
+    return make_error(out_error,
+                      QCoreApplication::translate("SaveFile",
+                                                  "Not a world snapshot"));
+  }
+
+  ByteReader in(bytes.constData() + k_magic_size,
+                static_cast<std::size_t>(bytes.size()) - k_magic_size);
+  std::uint32_t format = 0;
+  std::uint32_t schema = 0;
+  in(format, schema);
+  if (!in.ok()) {
+    return truncated(out_error);
+  }
+  if (format != static_cast<std::uint32_t>(k_world_snapshot_format) ||
+      schema > static_cast<std::uint32_t>(k_snapshot_version)) {
+    return make_error(
+        out_error,
+        QCoreApplication::translate("SaveFile",
+                                    "Unsupported world snapshot version %1.%2")
+            .arg(format)
+            .arg(schema));
+  }
+
+  std::uint32_t entity_count = 0;
+  in(entity_count);
+  if (!in.ok() || entity_count > k_max_rows ||
+      std::size_t{entity_count} * sizeof(EntityID) > in.remaining()) {
+    return truncated(out_error);
+  }
+  std::vector<EntityID> entity_ids(entity_count);
+  for (EntityID& entity_id : entity_ids) {
+    in(entity_id);
+  }
+
+  std::uint32_t column_count = 0;
+  in(column_count);
+  if (!in.ok() || column_count > std::tuple_size_v<SnapshotColumns>) {
+    return truncated(out_error);
+  }
+
+  // Every column is decoded before the world is touched, so a bad slot leaves
+  // the running game alone.
+  std::vector<std::unique_ptr<StagedColumn>> staged;
+  staged.reserve(column_count);
+  for (std::uint32_t c = 0; c < column_count; ++c) {
+    std::string name;
+    std::uint32_t row_count = 0;
+    in(name, row_count);
+    if (!in.ok() || row_count > entity_count ||
+        std::size_t{row_count} * 4U > in.remaining()) {
+      return truncated(out_error);
+    }
+    std::vector<EntityID> column_ids(row_count);
+    bool rows_valid = true;
+    for (EntityID& entity_id : column_ids) {
+      std::uint32_t row = 0;
+      in(row);
+      rows_valid = rows_valid && row < entity_count;
+      entity_id = rows_valid ? entity_ids[row] : NULL_ENTITY;
+    }
+    std::uint32_t payload_size = 0;
+    in(payload_size);
+    const char* payload_bytes = in.take(payload_size);
+    if (!in.ok()) {
+      return truncated(out_error);
+    }
+    if (!rows_valid) {
+      return corrupted_column(out_error, name);
+    }
+
+    ByteReader payload(payload_bytes, payload_size);
+    std::unique_ptr<StagedColumn> column;
+    for_each_column([&]<typename T>(std::type_identity<T>) {
+      if (Column<T>::k_name == name) {
+        column = stage_column<T>(payload, std::move(column_ids));
+      }
+    });
+    if (column == nullptr) {
+      return corrupted_column(out_error, name);
+    }
+    staged.push_back(std::move(column));
+  }
+
+  std::uint32_t header_size = 0;
+  in(header_size);
+  const char* header_bytes = in.take(header_size);
+  if (!in.ok()) {
+    return truncated(out_error);
+  }
+  QCborParserError cbor_error{};
+  const QCborValue header = QCborValue::fromCbor(
+      QByteArray::fromRawData(header_bytes, static_cast<qsizetype>(header_size)),
+      &cbor_error);
+  if (cbor_error.error != QCborError::NoError || !header.isMap()) {
+    return truncated(out_error);
+  }
+
+  world.clear();
+  for (const EntityID entity_id : entity_ids) {
+    world.create_entity_with_id(entity_id);
+  }
+  for (const auto& column : staged) {
+    column->apply(world.registry());
+  }
+  Serialization::deserialize_world_header(&world, header.toJsonValue().toObject());
+  return true;
+}
+
+auto restore_world_bytes(World& world,
+                         const QByteArray& bytes,
+                         QString* out_error) -> bool {
+  if (is_world_snapshot(bytes)) {
+    return restore_world_snapshot(world, bytes, out_error);
+  }
+
+  QJsonParseError parse_error{};
+  const QJsonDocument doc = QJsonDocument::fromJson(bytes, &parse_error);
+  if (parse_error.error != QJsonParseError::NoError || !doc.isObject()) {
+    return make_error(out_error, parse_error.errorString());
+  }
+  world.clear();
+  Serialization::deserialize_world(&world, doc);
+  return true;
+}
+
+} // namespace Game::Save
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+namespace Engine::Core {
+class World;
+}
+
+namespace Game::Save {
+
+// Format 2 stores each component column as packed fields read straight from
+// its ComponentStorage; format 1 (JSON values re-encoded as CBOR) is gone.
+inline constexpr int k_world_snapshot_format = 2;
+
+[[nodiscard]] auto is_world_snapshot(const QByteArray& bytes) -> bool;
+
+// Must run on the thread that owns the world; the bytes can then be packed
+// and written anywhere.
+[[nodiscard]] auto capture_world_snapshot(const Engine::Core::World& world)
+    -> QByteArray;
+
+// Replaces the world's entities with the snapshot's. The world is left as it
+// was when the bytes do not decode.
+auto restore_world_snapshot(Engine::Core::World& world,
+                            const QByteArray& bytes,
+                            QString* out_error) -> bool;
+
+// Binary snapshots, or the JSON text that save slots held before them.
+auto restore_world_bytes(Engine::Core::World& world,
+                         const QByteArray& bytes,
+                         QString* out_error) -> bool;
+
+} // namespace Game::Save
@@ -103,6 +103,7 @@ void AISystem::shutdown_workers() {
     ai.context.nation = nullptr;
   }
   m_ai_instances.clear();
+  m_world_snapshot.reset();
 }
 
 void AISystem::initialize_ai_players() {
@@ -168,12 +169,19 @@ void AISystem::update(Engine::Core::World* world, float delta_time) {
       continue;
     }
 
-    AI::AISnapshot snapshot =
-        Game::Systems::AI::AISnapshotBuilder::build(*world, ai.context.player_id);
-    snapshot.game_time = m_total_game_time;
+    if (m_world_snapshot == nullptr || m_world_snapshot_update != m_update_count) {
+      m_world_snapshot =
+          AI::AISnapshotBuilder::build_world(*world, m_world_snapshot.get());
+      m_world_snapshot_update = m_update_count;
+    }
 
     AI::AIJob job;
-    job.snapshot = std::move(snapshot);
+    job.snapshot =
+        AI::AISnapshotBuilder::begin_player(*m_world_snapshot, ai.context.player_id);
+    job.snapshot.game_time = m_total_game_time;
+    job.world = m_world_snapshot;
+    job.enemy_owner_ids =
+        AI::AISnapshotBuilder::enemy_owners(*m_world_snapshot, ai.context.player_id);
     job.context = ai.context;
     job.context.nation = nullptr;
     job.delta_time = ai.update_timer;
@@ -43,6 +43,9 @@ public:
   [[nodiscard]] auto applied_command_count() const -> std::uint64_t {
     return m_applied_command_count;
   }
+  [[nodiscard]] auto world_snapshot() const -> const AI::AIWorldSnapshot* {
+    return m_world_snapshot.get();
+  }
 
   void set_ai_profile(int player_id, const AI::AIPlayerProfile& profile);
 
@@ -63,6 +66,9 @@ private:
   static constexpr std::uint64_t k_decision_latency_updates = 6;
   std::uint64_t m_update_count = 0;
 
+  std::shared_ptr<const AI::AIWorldSnapshot> m_world_snapshot;
+  std::uint64_t m_world_snapshot_update = 0;
+
   std::vector<AIInstance> m_ai_instances;
 
   AI::AICommandFilter m_command_filter;
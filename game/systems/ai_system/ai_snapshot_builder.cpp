@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -11,13 +12,16 @@
 #include "../../game_config.h"
 #include "../../map/terrain_service.h"
 #include "../nation_registry.h"
-#include "../owner_queries.h"
+#include "../owner_registry.h"
 #include "../player_resource_registry.h"
 #include "ai_utils.h"
 #include "systems/ai_system/ai_types.h"
 
 namespace {
 
+using Game::Systems::AI::AIUnitRecord;
+using Game::Systems::AI::AIWorldSnapshot;
+
 struct VisionSource {
   float x = 0.0F;
   float y = 0.0F;
@@ -27,45 +31,24 @@ struct VisionSource {
 
 constexpr float k_min_building_vision_range = 18.0F;
 
-auto collect_vision_sources(const std::vector<Engine::Core::Entity*>& entities)
-    -> std::vector<VisionSource> {
+auto collect_vision_sources(const std::vector<AIUnitRecord>& units,
+                            int owner_id) -> std::vector<VisionSource> {
   std::vector<VisionSource> sources;
-  sources.reserve(entities.size());
-
-  for (auto* entity : entities) {
-    if (entity == nullptr) {
-      continue;
-    }
-
-    auto* unit = entity->get_component<Engine::Core::UnitComponent>();
-    auto* transform = entity->get_component<Engine::Core::TransformComponent>();
-    if ((unit == nullptr) || (transform == nullptr) || unit->health <= 0) {
-      continue;
-    }
-
-    float vision_range = unit->vision_range;
-    if (entity->has_component<Engine::Core::BuildingComponent>()) {
-      vision_range = std::max(vision_range, k_min_building_vision_range);
-    }
-
-    if (vision_range <= 0.0F) {
+  for (const auto& record : units) {
+    if (record.entity.owner_id != owner_id || record.vision_range_sq <= 0.0F) {
       continue;
     }
-
-    sources.push_back({transform->position.x,
-                       0.0F,
-                       transform->position.z,
-                       vision_range * vision_range});
+    sources.push_back(
+        {record.entity.pos_x, 0.0F, record.entity.pos_z, record.vision_range_sq});
   }
-
   return sources;
 }
 
-auto is_visible_to_sources(const Engine::Core::TransformComponent& transform,
+auto is_visible_to_sources(const AIUnitRecord& record,
                            const std::vector<VisionSource>& sources) -> bool {
   for (const auto& source : sources) {
-    const float dx = transform.position.x - source.x;
-    const float dz = transform.position.z - source.z;
+    const float dx = record.entity.pos_x - source.x;
+    const float dz = record.entity.pos_z - source.z;
     const float dist_sq = dx * dx + dz * dz;
     if (dist_sq <= source.radius_sq) {
       return true;
@@ -75,33 +58,132 @@ auto is_visible_to_sources(const Engine::Core::TransformComponent& transform,
   return false;
 }
 
-} // namespace
+auto is_held_in_place(const Engine::Core::World& world,
+                      Engine::Core::EntityID id) -> bool {
+  const auto* guard_mode = world.try_get<Engine::Core::GuardModeComponent>(id);
+  if ((guard_mode != nullptr) && guard_mode->active && guard_mode->has_guard_target) {
+    return true;
+  }
 
-namespace Game::Systems::AI {
+  const auto* patrol = world.try_get<Engine::Core::PatrolComponent>(id);
+  if ((patrol != nullptr) && patrol->patrolling) {
+    return true;
+  }
 
-void AISnapshotBuilder::attach_nation(AISnapshot& snapshot, int ai_owner_id) {
-  const auto* nation =
-      Game::Systems::NationRegistry::instance().get_nation_for_player(ai_owner_id);
-  if (nation != nullptr) {
-    snapshot.nation = std::make_shared<const Game::Systems::Nation>(*nation);
+  const auto* hold_mode = world.try_get<Engine::Core::HoldModeComponent>(id);
+  return (hold_mode != nullptr) && hold_mode->active;
+}
+
+auto record_unit(const Engine::Core::World& world,
+                 Engine::Core::EntityID id,
+                 const Engine::Core::UnitComponent& unit) -> AIUnitRecord {
+  AIUnitRecord record;
+  record.ai_controlled = world.has<Engine::Core::AIControlledComponent>(id);
+  record.held = is_held_in_place(world, id);
+
+  auto& data = record.entity;
+  data.id = id;
+  data.spawn_type = unit.spawn_type;
+  data.owner_id = unit.owner_id;
+  data.health = unit.health;
+  data.max_health = unit.max_health;
+  data.is_building = world.has<Engine::Core::BuildingComponent>(id);
+  data.is_commander = world.has<Engine::Core::CommanderComponent>(id);
+
+  const auto* assault_wave = world.try_get<Engine::Core::AssaultWaveComponent>(id);
+  data.is_assault = (assault_wave != nullptr) && assault_wave->active;
+  if (data.is_assault) {
+    data.has_march_target = assault_wave->has_march_target;
+    data.march_target_x = assault_wave->march_target_x;
+    data.march_target_z = assault_wave->march_target_z;
+  }
+
+  if (const auto* transform = world.try_get<Engine::Core::TransformComponent>(id)) {
+    record.has_transform = true;
+    data.pos_x = transform->position.x;
+    data.pos_y = 0.0F;
+    data.pos_z = transform->position.z;
+
+    float vision_range = unit.vision_range;
+    if (data.is_building) {
+      vision_range = std::max(vision_range, k_min_building_vision_range);
+    }
+    if (unit.health > 0 && vision_range > 0.0F) {
+      record.vision_range_sq = vision_range * vision_range;
+    }
+  }
+
+  if (const auto* movement = world.try_get<Engine::Core::MovementComponent>(id)) {
+    data.movement =
+        Game::Systems::AI::MovementSnapshot{true, movement->get_has_target()};
   }
+
+  if (const auto* production = world.try_get<Engine::Core::ProductionComponent>(id)) {
+    data.production.has_component = true;
+    data.production.in_progress = production->in_progress;
+    data.production.build_time = production->build_time;
+    data.production.time_remaining = production->time_remaining;
+    data.production.produced_count = production->produced_count;
+    data.production.max_units = production->max_units;
+    data.production.product_type = production->product_type;
+    data.production.rally_set = production->rally_set;
+    data.production.rally_x = production->rally_x;
+    data.production.rally_z = production->rally_z;
+    data.production.queue_size = static_cast<int>(production->production_queue.size());
+  }
+
+  if (const auto* builder_prod =
+          world.try_get<Engine::Core::BuilderProductionComponent>(id)) {
+    data.builder_production.has_component = true;
+    data.builder_production.has_construction_site = builder_prod->has_construction_site;
+    data.builder_production.in_progress = builder_prod->in_progress;
+    data.builder_production.at_construction_site = builder_prod->at_construction_site;
+    data.builder_production.construction_site_x = builder_prod->construction_site_x;
+    data.builder_production.construction_site_z = builder_prod->construction_site_z;
+  }
+
+  return record;
 }
 
-auto AISnapshotBuilder::build(const Engine::Core::World& world,
-                              int ai_owner_id) -> AISnapshot {
-  AISnapshot snapshot;
-  snapshot.player_id = ai_owner_id;
-  snapshot.resources =
-      Game::Systems::PlayerResourceRegistry::instance().get_all(ai_owner_id);
-  snapshot.has_resource_snapshot = true;
+auto reusable_record(const AIWorldSnapshot* previous,
+                     const Engine::Core::World& world,
+                     std::uint32_t slot,
+                     Engine::Core::EntityID id) -> const AIUnitRecord* {
+  if (previous == nullptr || previous->source != &world ||
+      previous->write_epoch == 0 || slot >= previous->record_by_slot.size()) {
+    return nullptr;
+  }
+  const std::uint32_t index = previous->record_by_slot[slot];
+  if (index == AIWorldSnapshot::k_no_record) {
+    return nullptr;
+  }
+  const AIUnitRecord& record = previous->units[index];
+  if (record.entity.id != id ||
+      world.registry().written_at(slot) >= previous->write_epoch) {
+    return nullptr;
+  }
+  return &record;
+}
 
+void snapshot_map_state(AIWorldSnapshot& shared) {
   auto& terrain_service = Game::Map::TerrainService::instance();
   for (const auto& prop : terrain_service.world_props()) {
+    if (prop.type == Game::Map::WorldProp::Type::Ruins ||
+        prop.type == Game::Map::WorldProp::Type::MagicShrine) {
+      Game::Systems::AI::ContactSnapshot anchor;
+      anchor.id = static_cast<Engine::Core::EntityID>(prop.id);
+      anchor.pos_x = prop.x;
+      anchor.pos_y = 0.0F;
+      anchor.pos_z = prop.z;
+      anchor.health = 1;
+      anchor.max_health = 1;
+      shared.sacred_sites.push_back(anchor);
+    }
     if (!Game::Map::is_harvestable_world_prop_type(prop.type)) {
       continue;
     }
     const QVector3D position = terrain_service.world_prop_world_position(prop);
-    snapshot.resource_nodes.push_back(
+    shared.resource_nodes.push_back(
         {prop.id,
          prop.type,
          position.x(),
@@ -109,11 +191,7 @@ auto AISnapshotBuilder::build(const Engine::Core::World& world,
          terrain_service.is_world_prop_reserved(prop.id)});
   }
 
-  auto friendlies = world.get_units_owned_by(ai_owner_id);
-  const auto* nation =
-      Game::Systems::NationRegistry::instance().get_nation_for_player(ai_owner_id);
-  attach_nation(snapshot, ai_owner_id);
-  snapshot.max_troops_per_player =
+  shared.max_troops_per_player =
       Game::GameConfig::instance().get_max_troops_per_player();
   if (const auto* height_map =
           terrain_service.is_initialized() ? terrain_service.get_height_map() : nullptr;
@@ -122,171 +200,141 @@ auto AISnapshotBuilder::build(const Engine::Core::World& world,
     const float tile = height_map->get_tile_size();
     const float half_w = static_cast<float>(height_map->get_width()) * 0.5F - 0.5F;
     const float half_h = static_cast<float>(height_map->get_height()) * 0.5F - 0.5F;
-    snapshot.has_map_bounds = true;
-    snapshot.map_min_x = -half_w * tile;
-    snapshot.map_max_x = half_w * tile;
-    snapshot.map_min_z = -half_h * tile;
-    snapshot.map_max_z = half_h * tile;
+    shared.has_map_bounds = true;
+    shared.map_min_x = -half_w * tile;
+    shared.map_max_x = half_w * tile;
+    shared.map_min_z = -half_h * tile;
+    shared.map_max_z = half_h * tile;
   }
-  const auto vision_sources = collect_vision_sources(friendlies);
-  snapshot.friendly_units.reserve(friendlies.size());
+}
 
-  for (auto* entity : friendlies) {
-    if (!entity->has_component<Engine::Core::AIControlledComponent>()) {
-      continue;
-    }
+} // namespace
 
-    const auto* guard_mode = entity->get_component<Engine::Core::GuardModeComponent>();
-    if ((guard_mode != nullptr) && guard_mode->active && guard_mode->has_guard_target) {
-      continue;
-    }
+namespace Game::Systems::AI {
 
-    const auto* patrol = entity->get_component<Engine::Core::PatrolComponent>();
-    if ((patrol != nullptr) && patrol->patrolling) {
-      continue;
-    }
+void AISnapshotBuilder::attach_nation(AISnapshot& snapshot, int ai_owner_id) {
+  if (auto nation =
+          Game::Systems::NationRegistry::instance().shared_nation_for_player(
+              ai_owner_id)) {
+    snapshot.nation = std::move(nation);
+  }
+}
 
-    const auto* hold_mode = entity->get_component<Engine::Core::HoldModeComponent>();
-    if ((hold_mode != nullptr) && hold_mode->active) {
-      continue;
-    }
+auto AISnapshotBuilder::build_world(const Engine::Core::World& world,
+                                    const AIWorldSnapshot* previous)
+    -> std::shared_ptr<const AIWorldSnapshot> {
+  auto shared = std::make_shared<AIWorldSnapshot>();
+  snapshot_map_state(*shared);
+
+  const Engine::Core::World::EntityLock lock(world);
+  const auto& registry = world.registry();
+  shared->source = &world;
+  shared->write_epoch = registry.write_epoch();
+
+  std::vector<std::uint32_t> unit_slots;
+  const auto unit_ids = world.entities_with<Engine::Core::UnitComponent>();
+  unit_slots.reserve(unit_ids.size());
+  for (const Engine::Core::EntityID id : unit_ids) {
+    unit_slots.push_back(Engine::Core::Handle::index_of(id));
+  }
+  std::sort(unit_slots.begin(), unit_slots.end());
 
-    auto* unit = entity->get_component<Engine::Core::UnitComponent>();
+  shared->units.reserve(unit_slots.size());
+  shared->record_by_slot.assign(registry.slot_count(), AIWorldSnapshot::k_no_record);
+  for (const std::uint32_t slot : unit_slots) {
+    const Engine::Core::EntityID id = registry.entity_at_index(slot);
+    const auto* unit = world.try_get<Engine::Core::UnitComponent>(id);
     if (unit == nullptr) {
       continue;
     }
-
-    const auto* assault_wave =
-        entity->get_component<Engine::Core::AssaultWaveComponent>();
-    const bool is_assault = (assault_wave != nullptr) && assault_wave->active;
-
-    if (unit->health <= 0) {
-      continue;
-    }
-
-    EntitySnapshot data;
-    data.id = entity->get_id();
-    data.spawn_type = unit->spawn_type;
-    data.owner_id = unit->owner_id;
-    data.health = unit->health;
-    data.max_health = unit->max_health;
-    data.is_building = entity->has_component<Engine::Core::BuildingComponent>();
-    data.is_commander = entity->has_component<Engine::Core::CommanderComponent>();
-    data.is_assault = is_assault;
-    if (is_assault) {
-      data.has_march_target = assault_wave->has_march_target;
-      data.march_target_x = assault_wave->march_target_x;
-      data.march_target_z = assault_wave->march_target_z;
-    }
-
-    if (auto* transform = entity->get_component<Engine::Core::TransformComponent>()) {
-      data.pos_x = transform->position.x;
-      data.pos_y = 0.0F;
-      data.pos_z = transform->position.z;
-    }
-
-    if (auto* movement = entity->get_component<Engine::Core::MovementComponent>()) {
-      data.movement = MovementSnapshot{true, movement->get_has_target()};
-    }
-
-    if (auto* production = entity->get_component<Engine::Core::ProductionComponent>()) {
-      data.production.has_component = true;
-      data.production.in_progress = production->in_progress;
-      data.production.build_time = production->build_time;
-      data.production.time_remaining = production->time_remaining;
-      data.production.produced_count = production->produced_count;
-      data.production.max_units = production->max_units;
-      data.production.product_type = production->product_type;
-      data.production.rally_set = production->rally_set;
-      data.production.rally_x = production->rally_x;
-      data.production.rally_z = production->rally_z;
-      data.production.queue_size =
-          static_cast<int>(production->production_queue.size());
+    shared->record_by_slot[slot] = static_cast<std::uint32_t>(shared->units.size());
+    if (const auto* reused = reusable_record(previous, world, slot, id)) {
+      shared->units.push_back(*reused);
+      ++shared->reused_units;
+    } else {
+      shared->units.push_back(record_unit(world, id, *unit));
     }
-
-    if (auto* builder_prod =
-            entity->get_component<Engine::Core::BuilderProductionComponent>()) {
-      data.builder_production.has_component = true;
-      data.builder_production.has_construction_site =
-          builder_prod->has_construction_site;
-      data.builder_production.in_progress = builder_prod->in_progress;
-      data.builder_production.at_construction_site = builder_prod->at_construction_site;
-      data.builder_production.construction_site_x = builder_prod->construction_site_x;
-      data.builder_production.construction_site_z = builder_prod->construction_site_z;
+    const int owner_id = shared->units.back().entity.owner_id;
+    if (std::find(shared->owner_ids.begin(), shared->owner_ids.end(), owner_id) ==
+        shared->owner_ids.end()) {
+      shared->owner_ids.push_back(owner_id);
     }
-
-    snapshot.friendly_units.push_back(std::move(data));
   }
+  std::sort(shared->owner_ids.begin(), shared->owner_ids.end());
 
-  auto enemies = Game::Systems::enemy_units(world, ai_owner_id);
-  snapshot.visible_enemies.reserve(enemies.size());
-  snapshot.strategic_objectives.reserve(enemies.size());
+  return shared;
+}
 
-  if (nation != nullptr && !nation->has_economy) {
-    const auto& world_props = Game::Map::TerrainService::instance().world_props();
-    snapshot.defense_anchors.reserve(world_props.size());
-    for (const auto& prop : world_props) {
-      if (prop.type != Game::Map::WorldProp::Type::Ruins &&
-          prop.type != Game::Map::WorldProp::Type::MagicShrine) {
-        continue;
-      }
+auto AISnapshotBuilder::begin_player(const AIWorldSnapshot& shared,
+                                     int ai_owner_id) -> AISnapshot {
+  AISnapshot snapshot;
+  snapshot.player_id = ai_owner_id;
+  snapshot.resources =
+      Game::Systems::PlayerResourceRegistry::instance().get_all(ai_owner_id);
+  snapshot.has_resource_snapshot = true;
+  attach_nation(snapshot, ai_owner_id);
+  snapshot.max_troops_per_player = shared.max_troops_per_player;
+  snapshot.has_map_bounds = shared.has_map_bounds;
+  snapshot.map_min_x = shared.map_min_x;
+  snapshot.map_max_x = shared.map_max_x;
+  snapshot.map_min_z = shared.map_min_z;
+  snapshot.map_max_z = shared.map_max_z;
+  return snapshot;
+}
 
-      ContactSnapshot anchor;
-      anchor.id = static_cast<Engine::Core::EntityID>(prop.id);
-      anchor.pos_x = prop.x;
-      anchor.pos_y = 0.0F;
-      anchor.pos_z = prop.z;
-      anchor.health = 1;
-      anchor.max_health = 1;
-      snapshot.defense_anchors.push_back(std::move(anchor));
+auto AISnapshotBuilder::enemy_owners(const AIWorldSnapshot& shared,
+                                     int ai_owner_id) -> std::vector<int> {
+  auto& owners = Game::Systems::OwnerRegistry::instance();
+  std::vector<int> enemies;
+  for (const int owner_id : shared.owner_ids) {
+    if (owners.are_enemies(ai_owner_id, owner_id)) {
+      enemies.push_back(owner_id);
     }
   }
+  return enemies;
+}
 
-  for (auto* entity : enemies) {
-    auto* unit = entity->get_component<Engine::Core::UnitComponent>();
-    if ((unit == nullptr) || unit->health <= 0) {
-      continue;
-    }
+void AISnapshotBuilder::populate_units(const AIWorldSnapshot& shared,
+                                       std::span<const int> enemy_owner_ids,
+                                       AISnapshot& snapshot) {
+  const int ai_owner_id = snapshot.player_id;
+  snapshot.resource_nodes = shared.resource_nodes;
+  if (snapshot.nation != nullptr && !snapshot.nation->has_economy) {
+    snapshot.defense_anchors = shared.sacred_sites;
+  }
 
-    auto* transform = entity->get_component<Engine::Core::TransformComponent>();
-    if (transform == nullptr) {
+  const auto vision_sources = collect_vision_sources(shared.units, ai_owner_id);
+  for (const auto& record : shared.units) {
+    const EntitySnapshot& data = record.entity;
+    if (data.owner_id == ai_owner_id) {
+      if (record.ai_controlled && !record.held && data.health > 0) {
+        snapshot.friendly_units.push_back(data);
+      }
       continue;
     }
-
-    const bool is_building = entity->has_component<Engine::Core::BuildingComponent>();
-    const bool is_commander = entity->has_component<Engine::Core::CommanderComponent>();
-
-    if (is_building || is_commander) {
-      ContactSnapshot objective;
-      objective.id = entity->get_id();
-      objective.owner_id = unit->owner_id;
-      objective.is_building = is_building;
-      objective.pos_x = transform->position.x;
-      objective.pos_y = 0.0F;
-      objective.pos_z = transform->position.z;
-      objective.health = unit->health;
-      objective.max_health = unit->max_health;
-      objective.spawn_type = unit->spawn_type;
-      snapshot.strategic_objectives.push_back(std::move(objective));
-    }
-
-    if (!is_visible_to_sources(*transform, vision_sources)) {
+    if (data.health <= 0 || !record.has_transform ||
+        std::find(enemy_owner_ids.begin(), enemy_owner_ids.end(), data.owner_id) ==
+            enemy_owner_ids.end()) {
       continue;
     }
 
     ContactSnapshot contact;
-    contact.id = entity->get_id();
-    contact.owner_id = unit->owner_id;
-    contact.is_building = is_building;
-    contact.pos_x = transform->position.x;
+    contact.id = data.id;
+    contact.owner_id = data.owner_id;
+    contact.is_building = data.is_building;
+    contact.pos_x = data.pos_x;
     contact.pos_y = 0.0F;
-    contact.pos_z = transform->position.z;
+    contact.pos_z = data.pos_z;
+    contact.health = data.health;
+    contact.max_health = data.max_health;
+    contact.spawn_type = data.spawn_type;
 
-    contact.health = unit->health;
-    contact.max_health = unit->max_health;
-    contact.spawn_type = unit->spawn_type;
-
-    snapshot.visible_enemies.push_back(std::move(contact));
+    if (data.is_building || data.is_commander) {
+      snapshot.strategic_objectives.push_back(contact);
+    }
+    if (is_visible_to_sources(record, vision_sources)) {
+      snapshot.visible_enemies.push_back(contact);
+    }
   }
 
   const float engaged_radius_sq =
@@ -307,7 +355,13 @@ auto AISnapshotBuilder::build(const Engine::Core::World& world,
       }
     }
   }
+}
 
+auto AISnapshotBuilder::build(const Engine::Core::World& world,
+                              int ai_owner_id) -> AISnapshot {
+  const auto shared = build_world(world, nullptr);
+  AISnapshot snapshot = begin_player(*shared, ai_owner_id);
+  populate_units(*shared, enemy_owners(*shared, ai_owner_id), snapshot);
   return snapshot;
 }
 
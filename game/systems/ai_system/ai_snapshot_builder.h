@@ -1,5 +1,9 @@
 #pragma once
 
+#include <memory>
+#include <span>
+#include <vector>
+
 #include "ai_types.h"
 
 namespace Engine::Core {
@@ -10,6 +14,20 @@ namespace Game::Systems::AI {
 
 namespace AISnapshotBuilder {
 
+[[nodiscard]] auto
+build_world(const Engine::Core::World& world,
+            const AIWorldSnapshot* previous) -> std::shared_ptr<const AIWorldSnapshot>;
+
+[[nodiscard]] auto begin_player(const AIWorldSnapshot& shared,
+                                int ai_owner_id) -> AISnapshot;
+
+[[nodiscard]] auto enemy_owners(const AIWorldSnapshot& shared,
+                                int ai_owner_id) -> std::vector<int>;
+
+void populate_units(const AIWorldSnapshot& shared,
+                    std::span<const int> enemy_owner_ids,
+                    AISnapshot& snapshot);
+
 [[nodiscard]] auto build(const Engine::Core::World& world,
                          int ai_owner_id) -> AISnapshot;
 
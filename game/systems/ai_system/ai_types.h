@@ -2,6 +2,7 @@
 
 #include <QString>
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <unordered_map>
@@ -170,6 +171,35 @@ struct AISnapshot {
   float game_time = 0.0F;
 };
 
+struct AIUnitRecord {
+  EntitySnapshot entity;
+  bool has_transform = false;
+  bool ai_controlled = false;
+  bool held = false;
+  float vision_range_sq = 0.0F;
+};
+
+struct AIWorldSnapshot {
+  static constexpr std::uint32_t k_no_record = 0xFFFFFFFFU;
+
+  const void* source = nullptr;
+  std::uint64_t write_epoch = 0;
+  std::vector<AIUnitRecord> units;
+  std::vector<std::uint32_t> record_by_slot;
+  std::vector<int> owner_ids;
+  std::size_t reused_units = 0;
+
+  std::vector<ResourceNodeSnapshot> resource_nodes;
+  std::vector<ContactSnapshot> sacred_sites;
+  int max_troops_per_player = 0;
+
+  bool has_map_bounds = false;
+  float map_min_x = 0.0F;
+  float map_max_x = 0.0F;
+  float map_min_z = 0.0F;
+  float map_max_z = 0.0F;
+};
+
 struct AIStrategyConfig {
   struct PersonalityInputs {
     float aggression = 0.5F;
@@ -395,6 +425,8 @@ struct AIResult {
 
 struct AIJob {
   AISnapshot snapshot;
+  std::shared_ptr<const AIWorldSnapshot> world;
+  std::vector<int> enemy_owner_ids;
   AIContext context;
   float delta_time = 0.0F;
 };
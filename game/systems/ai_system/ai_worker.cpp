@@ -11,6 +11,7 @@
 #include "systems/ai_system/ai_behavior_registry.h"
 #include "systems/ai_system/ai_executor.h"
 #include "systems/ai_system/ai_reasoner.h"
+#include "systems/ai_system/ai_snapshot_builder.h"
 #include "systems/ai_system/ai_types.h"
 
 namespace Game::Systems::AI {
@@ -93,6 +94,12 @@ void AIWorker::worker_loop() {
     }
 
     try {
+      if (job.world != nullptr) {
+        AISnapshotBuilder::populate_units(
+            *job.world, job.enemy_owner_ids, job.snapshot);
+        job.world.reset();
+      }
+
       AIResult result;
       result.context = job.context;
 
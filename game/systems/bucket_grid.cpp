@@ -0,0 +1,243 @@
+#include "bucket_grid.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace Game::Systems {
+
+namespace {
+
+constexpr int k_max_cells_per_axis = 512;
+constexpr std::size_t k_min_compact_threshold = 64U;
+constexpr std::size_t k_compact_divisor = 8U;
+
+} // namespace
+
+BucketGrid::BucketGrid(float cell_size)
+    : m_cell_size(cell_size > 0.0F ? cell_size : 1.0F)
+    , m_inv_cell_size(1.0F / (cell_size > 0.0F ? cell_size : 1.0F)) {
+}
+
+void BucketGrid::clear() {
+  for (Item const& item : m_items) {
+    if (item.key != k_absent) {
+      m_slot_of_key[item.key] = k_absent;
+    }
+  }
+  for (Item const& item : m_loose) {
+    m_slot_of_key[item.key] = k_absent;
+  }
+  m_items.clear();
+  m_loose.clear();
+  m_cell_start.clear();
+  m_cells_x = 0;
+  m_cells_z = 0;
+  m_size = 0;
+  m_tombstones = 0;
+}
+
+void BucketGrid::reserve(std::size_t count) {
+  m_items.reserve(count);
+  m_loose.reserve(count);
+}
+
+auto BucketGrid::contains(std::uint32_t key) const -> bool {
+  return key < m_slot_of_key.size() && m_slot_of_key[key] != k_absent;
+}
+
+auto BucketGrid::cell_index(float x, float z) const -> std::size_t {
+  int const cx = clamp_cell(cell_of(x, m_origin_x), m_cells_x);
+  int const cz = clamp_cell(cell_of(z, m_origin_z), m_cells_z);
+  return static_cast<std::size_t>(cz) * static_cast<std::size_t>(m_cells_x) +
+         static_cast<std::size_t>(cx);
+}
+
+void BucketGrid::set_slot(std::uint32_t key, std::uint32_t slot) {
+  if (key >= m_slot_of_key.size()) {
+    m_slot_of_key.resize(static_cast<std::size_t>(key) + 1U, k_absent);
+  }
+  m_slot_of_key[key] = slot;
+}
+
+void BucketGrid::add_loose(const Item& item) {
+  set_slot(item.key, static_cast<std::uint32_t>(m_loose.size()) | k_loose_bit);
+  m_loose.push_back(item);
+}
+
+void BucketGrid::erase_loose(std::uint32_t index) {
+  if (index + 1U != m_loose.size()) {
+    m_loose[index] = m_loose.back();
+    m_slot_of_key[m_loose[index].key] = index | k_loose_bit;
+  }
+  m_loose.pop_back();
+}
+
+void BucketGrid::swap_items(std::size_t lhs, std::size_t rhs) {
+  if (lhs == rhs) {
+    return;
+  }
+  std::swap(m_items[lhs], m_items[rhs]);
+  if (m_items[lhs].key != k_absent) {
+    m_slot_of_key[m_items[lhs].key] = static_cast<std::uint32_t>(lhs);
+  }
+  if (m_items[rhs].key != k_absent) {
+    m_slot_of_key[m_items[rhs].key] = static_cast<std::uint32_t>(rhs);
+  }
+}
+
+void BucketGrid::shift(std::size_t position,
+                       std::size_t from_cell,
+                       std::size_t to_cell) {
+  if (from_cell < to_cell) {
+    for (std::size_t cell = from_cell; cell < to_cell; ++cell) {
+      std::size_t const last = m_cell_start[cell + 1U] - 1U;
+      swap_items(position, last);
+      position = last;
+      --m_cell_start[cell + 1U];
+    }
+    return;
+  }
+  for (std::size_t cell = from_cell; cell > to_cell; --cell) {
+    std::size_t const first = m_cell_start[cell];
+    swap_items(position, first);
+    position = first;
+    ++m_cell_start[cell];
+  }
+}
+
+void BucketGrid::compact_if_needed() {
+  if (!is_built()) {
+    return;
+  }
+  std::size_t const threshold =
+      std::max(k_min_compact_threshold, m_size / k_compact_divisor);
+  if (m_loose.size() + m_tombstones > threshold) {
+    build();
+  }
+}
+
+void BucketGrid::insert(std::uint32_t key, float x, float z) {
+  if (contains(key)) {
+    move(key, x, z);
+    return;
+  }
+  add_loose({key, x, z});
+  ++m_size;
+  compact_if_needed();
+}
+
+void BucketGrid::move(std::uint32_t key, float x, float z) {
+  if (!contains(key)) {
+    insert(key, x, z);
+    return;
+  }
+  std::uint32_t const slot = m_slot_of_key[key];
+  if ((slot & k_loose_bit) != 0U) {
+    Item& item = m_loose[slot & ~k_loose_bit];
+    item.x = x;
+    item.z = z;
+    return;
+  }
+
+  Item& item = m_items[slot];
+  std::size_t const from_cell = cell_index(item.x, item.z);
+  std::size_t const to_cell = cell_index(x, z);
+  item.x = x;
+  item.z = z;
+  if (from_cell == to_cell) {
+    return;
+  }
+  std::size_t const distance =
+      from_cell < to_cell ? to_cell - from_cell : from_cell - to_cell;
+  if (distance <= static_cast<std::size_t>(m_cells_x) + 1U) {
+    shift(slot, from_cell, to_cell);
+    ++m_stats.shifted_moves;
+    return;
+  }
+  item.key = k_absent;
+  ++m_tombstones;
+  add_loose({key, x, z});
+  ++m_stats.loose_moves;
+  compact_if_needed();
+}
+
+void BucketGrid::remove(std::uint32_t key) {
+  if (!contains(key)) {
+    return;
+  }
+  std::uint32_t const slot = m_slot_of_key[key];
+  m_slot_of_key[key] = k_absent;
+  if ((slot & k_loose_bit) != 0U) {
+    erase_loose(slot & ~k_loose_bit);
+  } else {
+    m_items[slot].key = k_absent;
+    ++m_tombstones;
+  }
+  --m_size;
+  compact_if_needed();
+}
+
+void BucketGrid::build() {
+  ++m_stats.builds;
+  for (Item const& item : m_items) {
+    if (item.key != k_absent) {
+      m_loose.push_back(item);
+    }
+  }
+  m_items.clear();
+  m_tombstones = 0;
+
+  if (m_loose.empty()) {
+    m_cell_start.assign(1U, 0U);
+    m_cells_x = 0;
+    m_cells_z = 0;
+    return;
+  }
+
+  float min_x = std::numeric_limits<float>::max();
+  float min_z = std::numeric_limits<float>::max();
+  float max_x = std::numeric_limits<float>::lowest();
+  float max_z = std::numeric_limits<float>::lowest();
+  for (Item const& item : m_loose) {
+    min_x = std::min(min_x, item.x);
+    max_x = std::max(max_x, item.x);
+    min_z = std::min(min_z, item.z);
+    max_z = std::max(max_z, item.z);
+  }
+
+  m_origin_x = min_x - m_cell_size;
+  m_origin_z = min_z - m_cell_size;
+  float const span_x = (max_x + m_cell_size) - m_origin_x;
+  float const span_z = (max_z + m_cell_size) - m_origin_z;
+  m_cells_x = std::clamp(
+      static_cast<int>(span_x * m_inv_cell_size) + 1, 1, k_max_cells_per_axis);
+  m_cells_z = std::clamp(
+      static_cast<int>(span_z * m_inv_cell_size) + 1, 1, k_max_cells_per_axis);
+
+  std::size_t const cell_count =
+      static_cast<std::size_t>(m_cells_x) * static_cast<std::size_t>(m_cells_z);
+  m_cell_counts.assign(cell_count, 0U);
+  for (Item const& item : m_loose) {
+    ++m_cell_counts[cell_index(item.x, item.z)];
+  }
+
+  m_cell_start.resize(cell_count + 1U);
+  std::uint32_t running = 0;
+  for (std::size_t cell = 0; cell < cell_count; ++cell) {
+    m_cell_start[cell] = running;
+    running += m_cell_counts[cell];
+    m_cell_counts[cell] = m_cell_start[cell];
+  }
+  m_cell_start[cell_count] = running;
+
+  m_items.resize(m_loose.size());
+  for (Item const& item : m_loose) {
+    std::uint32_t const position = m_cell_counts[cell_index(item.x, item.z)]++;
+    m_items[position] = item;
+    m_slot_of_key[item.key] = position;
+  }
+  m_loose.clear();
+}
+
+} // namespace Game::Systems
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Game::Systems {
+
+class BucketGrid {
+public:
+  static constexpr std::uint32_t k_absent = 0xFFFFFFFFU;
+
+  struct Item {
+    std::uint32_t key{k_absent};
+    float x{0.0F};
+    float z{0.0F};
+  };
+
+  explicit BucketGrid(float cell_size = 4.0F);
+
+  void clear();
+  void reserve(std::size_t count);
+
+  void insert(std::uint32_t key, float x, float z);
+  void move(std::uint32_t key, float x, float z);
+  void remove(std::uint32_t key);
+
+  void build();
+
+  [[nodiscard]] auto contains(std::uint32_t key) const -> bool;
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+  [[nodiscard]] auto cell_size() const noexcept -> float { return m_cell_size; }
+  [[nodiscard]] auto is_built() const noexcept -> bool { return m_cells_x > 0; }
+  [[nodiscard]] auto loose_count() const noexcept -> std::size_t {
+    return m_loose.size();
+  }
+
+  struct Stats {
+    std::uint64_t builds{0};
+    std::uint64_t shifted_moves{0};
+    std::uint64_t loose_moves{0};
+  };
+
+  [[nodiscard]] auto stats() const noexcept -> const Stats& { return m_stats; }
+
+  template <typename Fn>
+  void for_each_in_box(float x, float z, float half_extent, Fn&& fn) const {
+    if (is_built()) {
+      int const min_cx = clamp_cell(cell_of(x - half_extent, m_origin_x), m_cells_x);
+      int const max_cx = clamp_cell(cell_of(x + half_extent, m_origin_x), m_cells_x);
+      int const min_cz = clamp_cell(cell_of(z - half_extent, m_origin_z), m_cells_z);
+      int const max_cz = clamp_cell(cell_of(z + half_extent, m_origin_z), m_cells_z);
+      for (int cz = min_cz; cz <= max_cz; ++cz) {
+        std::size_t const row =
+            static_cast<std::size_t>(cz) * static_cast<std::size_t>(m_cells_x);
+        std::size_t const begin = m_cell_start[row + static_cast<std::size_t>(min_cx)];
+        std::size_t const end =
+            m_cell_start[row + static_cast<std::size_t>(max_cx) + 1U];
+        for (std::size_t i = begin; i < end; ++i) {
+          if (m_items[i].key != k_absent) {
+            fn(m_items[i]);
+          }
+        }
+      }
+    }
+    for (Item const& item : m_loose) {
+      if (std::abs(item.x - x) <= half_extent && std::abs(item.z - z) <= half_extent) {
+        fn(item);
+      }
+    }
+  }
+
+  template <typename Fn>
+  void for_each_in_radius(float x, float z, float radius, Fn&& fn) const {
+    float const radius_sq = radius * radius;
+    for_each_in_box(x, z, radius, [&](const Item& item) {
+      float const dx = item.x - x;
+      float const dz = item.z - z;
+      if (dx * dx + dz * dz <= radius_sq) {
+        fn(item);
+      }
+    });
+  }
+
+private:
+  static constexpr std::uint32_t k_loose_bit = 0x80000000U;
+
+  [[nodiscard]] auto cell_of(float value, float origin) const -> int {
+    return static_cast<int>(std::floor((value - origin) * m_inv_cell_size));
+  }
+  [[nodiscard]] static auto clamp_cell(int cell, int count) -> int {
+    return cell < 0 ? 0 : (cell >= count ? count - 1 : cell);
+  }
+  [[nodiscard]] auto cell_index(float x, float z) const -> std::size_t;
+
+  void set_slot(std::uint32_t key, std::uint32_t slot);
+  void add_loose(const Item& item);
+  void erase_loose(std::uint32_t index);
+  void shift(std::size_t position, std::size_t from_cell, std::size_t to_cell);
+  void swap_items(std::size_t lhs, std::size_t rhs);
+  void compact_if_needed();
+
+  float m_cell_size;
+  float m_inv_cell_size;
+  float m_origin_x{0.0F};
+  float m_origin_z{0.0F};
+  int m_cells_x{0};
+  int m_cells_z{0};
+
+  std::vector<Item> m_items;
+  std::vector<Item> m_loose;
+  std::vector<std::uint32_t> m_cell_start;
+  std::vector<std::uint32_t> m_cell_counts;
+  std::vector<std::uint32_t> m_slot_of_key;
+  std::size_t m_size{0};
+  std::size_t m_tombstones{0};
+  Stats m_stats;
+};
+
+} // namespace Game::Systems
@@ -557,13 +557,21 @@ auto BuildingCollisionRegistry::is_circle_overlapping_building(
     float z,
     float radius,
     Engine::Core::EntityID ignore_entity_id) const -> bool {
-  for (const auto& building : m_buildings) {
-    if (ignore_entity_id != 0 && building.entity_id == ignore_entity_id) {
-      continue;
-    }
-    if (circle_overlaps_footprint(building, x, z, radius)) {
-      return true;
-    }
+  bool overlapping = false;
+  for_each_building_in_region(
+      x - radius,
+      x + radius,
+      z - radius,
+      z + radius,
+      [&](const BuildingFootprint& building) {
+        if (overlapping ||
+            (ignore_entity_id != 0 && building.entity_id == ignore_entity_id)) {
+          return;
+        }
+        overlapping = circle_overlaps_footprint(building, x, z, radius);
+      });
+  if (overlapping) {
+    return true;
   }
 
   for (const auto& obstacle : m_authored_obstacles) {
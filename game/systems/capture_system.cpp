@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
 #include <vector>
 
 #include "../core/component.h"
@@ -65,7 +66,7 @@ void CaptureSystem::tally_nearby_troops(Engine::Core::World& world,
   }
 }
 
-void CaptureSystem::transfer_barrack_ownership(Engine::Core::World*,
+void CaptureSystem::transfer_barrack_ownership(Engine::Core::World* world,
                                                Engine::Core::Entity* barrack,
                                                int new_owner_id) {
   auto* unit = barrack->get_component<Engine::Core::UnitComponent>();
@@ -83,24 +84,27 @@ void CaptureSystem::transfer_barrack_ownership(Engine::Core::World*,
   Game::Systems::BuildingCollisionRegistry::instance().update_building_owner(
       barrack->get_id(), new_owner_id);
 
+  // The production swap lands at the phase barrier, before the capture event
+  // is published.
   if (!Game::Core::is_neutral_owner(new_owner_id) && (prod == nullptr)) {
-    prod = barrack->add_component<Engine::Core::ProductionComponent>();
-    if (prod != nullptr) {
-      prod->product_type = Game::Units::TroopType::Archer;
-      prod->max_units = 150;
-      prod->in_progress = false;
-      prod->time_remaining = 0.0F;
-      prod->produced_count = 0;
-      prod->rally_x = transform->position.x + 4.0F;
-      prod->rally_z = transform->position.z + 2.0F;
-      prod->rally_set = true;
-      const auto profile = TroopProfileService::instance().get_profile(
-          unit->nation_id, prod->product_type);
-      prod->build_time = profile.production.build_time;
-      prod->villager_cost = profile.production.cost;
-    }
+    Engine::Core::ProductionComponent added;
+    added.product_type = Game::Units::TroopType::Archer;
+    added.max_units = 150;
+    added.in_progress = false;
+    added.time_remaining = 0.0F;
+    added.produced_count = 0;
+    added.rally_x = transform->position.x + 4.0F;
+    added.rally_z = transform->position.z + 2.0F;
+    added.rally_set = true;
+    const auto profile = TroopProfileService::instance().get_profile(
+        unit->nation_id, added.product_type);
+    added.build_time = profile.production.build_time;
+    added.villager_cost = profile.production.cost;
+    world->deferred().add_component<Engine::Core::ProductionComponent>(
+        barrack->get_id(), std::move(added));
   } else if (Game::Core::is_neutral_owner(new_owner_id) && (prod != nullptr)) {
-    barrack->remove_component<Engine::Core::ProductionComponent>();
+    world->deferred().remove_component<Engine::Core::ProductionComponent>(
+        barrack->get_id());
   } else if (prod != nullptr) {
     prod->produced_count = 0;
     const auto profile = TroopProfileService::instance().get_profile(
@@ -109,7 +113,7 @@ void CaptureSystem::transfer_barrack_ownership(Engine::Core::World*,
     prod->villager_cost = profile.production.cost;
   }
 
-  Engine::Core::EventManager::instance().publish(Engine::Core::BarrackCapturedEvent(
+  world->events().push(Engine::Core::BarrackCapturedEvent(
       barrack->get_id(), previous_owner_id, new_owner_id));
 }
 
@@ -137,10 +141,13 @@ void CaptureSystem::process_barrack_capture(Engine::Core::World* world,
       continue;
     }
 
-    auto* capture =
-        Engine::Core::get_or_add_component<Engine::Core::CaptureComponent>(*barrack);
-    if (capture == nullptr) {
-      continue;
+    // A barracks seen for the first time is judged on a local component that
+    // joins the entity at the phase barrier.
+    Engine::Core::CaptureComponent first_seen;
+    auto* capture = barrack->get_component<Engine::Core::CaptureComponent>();
+    bool const adding_capture = capture == nullptr;
+    if (adding_capture) {
+      capture = &first_seen;
     }
 
     float const barrack_x = transform->position.x;
@@ -198,6 +205,11 @@ void CaptureSystem::process_barrack_capture(Engine::Core::World* world,
         }
       }
     }
+
+    if (adding_capture) {
+      world->deferred().add_component<Engine::Core::CaptureComponent>(
+          barrack->get_id(), first_seen);
+    }
   }
 }
 
@@ -104,11 +104,13 @@ void CohortSystem::run(Engine::Core::SystemContext& context) {
       }
 
       for (std::size_t const idx : members) {
-        auto* membership = context.emplace<Engine::Core::CohortMembershipComponent>(
-            candidates[idx].entity_id);
-        if (membership != nullptr) {
+        Engine::Core::EntityID const member_id = candidates[idx].entity_id;
+        if (auto* membership =
+                context.try_get<Engine::Core::CohortMembershipComponent>(member_id)) {
           membership->cohort_id = cohort_id;
           membership->cohort_activated = false;
+        } else {
+          m_joining.push_back({member_id, cohort_id});
         }
       }
 
@@ -127,6 +129,11 @@ void CohortSystem::run(Engine::Core::SystemContext& context) {
       activated_cohorts.insert(membership.cohort_id);
     }
   }
+  for (const JoiningMember& joining : m_joining) {
+    if (context.has<Engine::Core::AttackTargetComponent>(joining.entity_id)) {
+      activated_cohorts.insert(joining.cohort_id);
+    }
+  }
 
   for (auto [entity_id, membership] :
        context.view<Engine::Core::CohortMembershipComponent>()) {
@@ -140,6 +147,19 @@ void CohortSystem::run(Engine::Core::SystemContext& context) {
       ++m_diagnostics.cohorts_activated;
     }
   }
+
+  // New members join at the phase barrier, already activated if their cohort is.
+  for (const JoiningMember& joining : m_joining) {
+    Engine::Core::CohortMembershipComponent membership;
+    membership.cohort_id = joining.cohort_id;
+    membership.cohort_activated = activated_cohorts.contains(joining.cohort_id);
+    if (membership.cohort_activated) {
+      ++m_diagnostics.cohorts_activated;
+    }
+    context.deferred().add_component<Engine::Core::CohortMembershipComponent>(
+        joining.entity_id, membership);
+  }
+  m_joining.clear();
 }
 
 auto CohortSystem::access() const -> Engine::Core::SystemAccess {
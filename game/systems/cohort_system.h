@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
+#include "../core/entity_id.h"
 #include "../core/system.h"
 
 namespace Engine::Core {
@@ -31,7 +33,13 @@ public:
   static constexpr float k_reform_interval = 3.0F;
 
 private:
+  struct JoiningMember {
+    Engine::Core::EntityID entity_id;
+    std::uint32_t cohort_id;
+  };
+
   CohortDiagnostics m_diagnostics;
+  std::vector<JoiningMember> m_joining;
   float m_reform_timer{0.0F};
   std::uint32_t m_next_cohort_id{1};
 };
@@ -1,6 +1,7 @@
 #include "auto_engagement.h"
 
 #include <cmath>
+#include <cstddef>
 
 #include "../../core/component.h"
 #include "../../core/world.h"
@@ -44,6 +45,9 @@ void AutoEngagement::process(Engine::Core::World*,
     }
   }
 
+  m_seekers.clear();
+  m_detection_ranges.clear();
+  m_chases.clear();
   for (auto* unit : query_context.units) {
     if (unit->has_component<Engine::Core::PendingRemovalComponent>()) {
       continue;
@@ -100,7 +104,16 @@ void AutoEngagement::process(Engine::Core::World*,
       detection_range = std::min(detection_range, guard_mode->guard_radius);
     }
 
-    auto* nearest_enemy = find_nearest_enemy(unit, query_context, detection_range);
+    m_seekers.push_back(unit);
+    m_detection_ranges.push_back(detection_range);
+    m_chases.push_back(!shoots_without_closing);
+  }
+
+  find_nearest_enemies(m_seekers, m_detection_ranges, query_context, m_nearest);
+
+  for (std::size_t i = 0; i < m_seekers.size(); ++i) {
+    auto* unit = m_seekers[i];
+    auto* nearest_enemy = m_nearest[i];
     if (nearest_enemy != nullptr && melee_walled_off_from(unit, nearest_enemy)) {
       nearest_enemy = nullptr;
     }
@@ -112,7 +125,7 @@ void AutoEngagement::process(Engine::Core::World*,
       }
       if (attack_target != nullptr) {
         attack_target->target_id = nearest_enemy->get_id();
-        attack_target->should_chase = !shoots_without_closing;
+        attack_target->should_chase = m_chases[i];
 
         m_engagement_cooldowns[unit->get_id()] = Constants::k_engagement_cooldown;
       }
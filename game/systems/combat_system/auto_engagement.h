@@ -1,6 +1,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
 
 #include "../../core/entity.h"
 #include "combat_utils.h"
@@ -19,6 +20,10 @@ public:
 
 private:
   std::unordered_map<Engine::Core::EntityID, float> m_engagement_cooldowns;
+  std::vector<Engine::Core::Entity*> m_seekers;
+  std::vector<float> m_detection_ranges;
+  std::vector<bool> m_chases;
+  std::vector<Engine::Core::Entity*> m_nearest;
 };
 
 } // namespace Game::Systems::Combat
@@ -18,17 +18,13 @@
 namespace Game::Systems::Combat {
 
 namespace {
-constexpr float k_combat_query_cell_size = 15.0F;
+constexpr float k_spatial_index_slack = 1.0F;
 } // namespace
 
-CombatQueryContext::CombatQueryContext()
-    : unit_grid(k_combat_query_cell_size) {
-}
-
 void CombatQueryContext::clear() {
   units.clear();
-  unit_grid.clear();
-  nearby_unit_ids.clear();
+  spatial_index = nullptr;
+  nearby_queries.clear();
   m_present_owner_ids.clear();
 
   if (m_stamp == std::numeric_limits<std::uint32_t>::max()) {
@@ -84,6 +80,7 @@ auto CombatQueryContext::find_entity(Engine::Core::EntityID entity_id) const
 
 void CombatQueryContext::rebuild_hostility_table() {
   m_hostility.assign(k_owner_axis * k_owner_axis, 0U);
+  m_hostile_owner_masks.assign(k_owner_axis, ~std::uint64_t{0});
   const auto& owner_registry = Game::Systems::OwnerRegistry::instance();
   for (const int attacker : m_present_owner_ids) {
     if (attacker < 0 || attacker > k_max_cached_owner_id) {
@@ -99,6 +96,10 @@ void CombatQueryContext::rebuild_hostility_table() {
                   static_cast<std::size_t>(target)] =
           static_cast<std::uint8_t>(is_hostile ? k_hostility_hostile
                                                : k_hostility_friendly);
+      if (!is_hostile) {
+        m_hostile_owner_masks[static_cast<std::size_t>(attacker)] &=
+            ~Engine::Core::WorldSpatialIndex::owner_bit(target);
+      }
     }
   }
 }
@@ -120,6 +121,15 @@ auto CombatQueryContext::hostile(int attacker_owner_id,
                                                               target_owner_id);
 }
 
+auto CombatQueryContext::hostile_owner_mask(int attacker_owner_id) const
+    -> std::uint64_t {
+  if (attacker_owner_id < 0 || attacker_owner_id > k_max_cached_owner_id ||
+      m_hostile_owner_masks.empty()) {
+    return ~std::uint64_t{0};
+  }
+  return m_hostile_owner_masks[static_cast<std::size_t>(attacker_owner_id)];
+}
+
 void collect_unit_ids_near(Engine::Core::World& world,
                            float x,
                            float z,
@@ -162,18 +172,11 @@ void rebuild_combat_query_context(Engine::Core::World* world,
     const bool building = is_building(&entity);
     query_context.units.push_back(&entity);
     query_context.record_candidate(&entity, unit.owner_id, building);
-
-    if (building) {
-      continue;
-    }
-
-    auto* transform = entity.get_component<Engine::Core::TransformComponent>();
-    if (transform != nullptr) {
-      query_context.unit_grid.insert(
-          entity.get_id(), transform->position.x, transform->position.z);
-    }
   }
 
+  auto& index = world->spatial_index();
+  index.refresh(*world);
+  query_context.spatial_index = &index;
   query_context.rebuild_hostility_table();
 }
 
@@ -441,10 +444,33 @@ auto is_unit_idle(Engine::Core::Entity* unit) -> bool {
   return (patrol == nullptr) || !patrol->patrolling;
 }
 
-auto find_nearest_enemy(Engine::Core::Entity* unit,
-                        const CombatQueryContext& query_context,
-                        float max_range,
-                        std::uint64_t* scan_iterations) -> Engine::Core::Entity* {
+namespace {
+
+using Index = Engine::Core::WorldSpatialIndex;
+
+auto nearest_enemy_query(Engine::Core::Entity* unit,
+                         const CombatQueryContext& query_context,
+                         float max_range) -> Index::RadiusQuery {
+  auto* unit_comp = unit->get_component<Engine::Core::UnitComponent>();
+  auto* unit_transform = unit->get_component<Engine::Core::TransformComponent>();
+  if ((unit_comp == nullptr) || (unit_transform == nullptr)) {
+    return Index::RadiusQuery{.radius = -1.0F};
+  }
+  return Index::RadiusQuery{
+      .x = unit_transform->position.x,
+      .z = unit_transform->position.z,
+      .radius = max_range + k_spatial_index_slack,
+      .require_flags = Index::k_alive,
+      .reject_flags = static_cast<std::uint16_t>(Index::k_building |
+                                                 Index::k_pending_removal),
+      .owner_mask = query_context.hostile_owner_mask(unit_comp->owner_id)};
+}
+
+auto nearest_enemy_among(Engine::Core::Entity* unit,
+                         std::span<const std::uint32_t> hits,
+                         const CombatQueryContext& query_context,
+                         float max_range,
+                         std::uint64_t* scan_iterations) -> Engine::Core::Entity* {
   auto* unit_comp = unit->get_component<Engine::Core::UnitComponent>();
   auto* unit_transform = unit->get_component<Engine::Core::TransformComponent>();
   if ((unit_comp == nullptr) || (unit_transform == nullptr)) {
@@ -453,17 +479,14 @@ auto find_nearest_enemy(Engine::Core::Entity* unit,
 
   Engine::Core::Entity* nearest_enemy = nullptr;
   float nearest_dist_sq = max_range * max_range;
-  auto& nearby_ids = query_context.nearby_unit_ids;
-  query_context.unit_grid.get_entities_in_range(
-      unit_transform->position.x, unit_transform->position.z, max_range, nearby_ids);
-
   const int attacker_owner_id = unit_comp->owner_id;
+  const auto& entries = query_context.spatial_index->entries();
 
-  for (auto target_id : nearby_ids) {
+  for (const std::uint32_t hit : hits) {
     if (scan_iterations != nullptr) {
       *scan_iterations += 1;
     }
-    const CandidateRecord* record = query_context.find_record(target_id);
+    const CandidateRecord* record = query_context.find_record(entries[hit].id);
     if (record == nullptr || record->is_building) {
       continue;
     }
@@ -506,6 +529,50 @@ auto find_nearest_enemy(Engine::Core::Entity* unit,
   return nearest_enemy;
 }
 
+} // namespace
+
+auto find_nearest_enemy(Engine::Core::Entity* unit,
+                        const CombatQueryContext& query_context,
+                        float max_range,
+                        std::uint64_t* scan_iterations) -> Engine::Core::Entity* {
+  if (query_context.spatial_index == nullptr) {
+    return nullptr;
+  }
+  auto& queries = query_context.nearby_queries;
+  queries.clear();
+  queries.push_back(nearest_enemy_query(unit, query_context, max_range));
+  query_context.spatial_index->query_radius_batch(queries, query_context.nearby_hits);
+  return nearest_enemy_among(unit,
+                             query_context.nearby_hits.hits_for(0),
+                             query_context,
+                             max_range,
+                             scan_iterations);
+}
+
+void find_nearest_enemies(std::span<Engine::Core::Entity* const> units,
+                          std::span<const float> max_ranges,
+                          const CombatQueryContext& query_context,
+                          std::vector<Engine::Core::Entity*>& nearest,
+                          std::uint64_t* scan_iterations) {
+  nearest.assign(units.size(), nullptr);
+  if (query_context.spatial_index == nullptr || units.size() != max_ranges.size()) {
+    return;
+  }
+  auto& queries = query_context.nearby_queries;
+  queries.clear();
+  for (std::size_t i = 0; i < units.size(); ++i) {
+    queries.push_back(nearest_enemy_query(units[i], query_context, max_ranges[i]));
+  }
+  query_context.spatial_index->query_radius_batch(queries, query_context.nearby_hits);
+  for (std::size_t i = 0; i < units.size(); ++i) {
+    nearest[i] = nearest_enemy_among(units[i],
+                                     query_context.nearby_hits.hits_for(i),
+                                     query_context,
+                                     max_ranges[i],
+                                     scan_iterations);
+  }
+}
+
 auto should_auto_engage_melee(Engine::Core::Entity* unit) -> bool {
   if (unit == nullptr) {
     return false;
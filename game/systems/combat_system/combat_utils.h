@@ -2,10 +2,11 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 #include "../../core/entity.h"
-#include "../spatial_grid.h"
+#include "../../core/world_spatial_index.h"
 
 namespace Engine::Core {
 class World;
@@ -25,8 +26,6 @@ struct CandidateRecord {
 };
 
 struct CombatQueryContext {
-  CombatQueryContext();
-
   void clear();
 
   void record_candidate(Engine::Core::Entity* entity, int owner_id, bool building);
@@ -39,9 +38,12 @@ struct CombatQueryContext {
 
   [[nodiscard]] auto hostile(int attacker_owner_id, int target_owner_id) const -> bool;
 
+  [[nodiscard]] auto hostile_owner_mask(int attacker_owner_id) const -> std::uint64_t;
+
   std::vector<Engine::Core::Entity*> units;
-  Game::Systems::SpatialGrid unit_grid;
-  mutable std::vector<Engine::Core::EntityID> nearby_unit_ids;
+  const Engine::Core::WorldSpatialIndex* spatial_index{nullptr};
+  mutable std::vector<Engine::Core::WorldSpatialIndex::RadiusQuery> nearby_queries;
+  mutable Engine::Core::WorldSpatialIndex::BatchResult nearby_hits;
 
 private:
   static constexpr int k_max_cached_owner_id = 64;
@@ -59,6 +61,7 @@ private:
   std::vector<CandidateRecord> m_records;
   std::uint32_t m_stamp{0};
   std::vector<std::uint8_t> m_hostility;
+  std::vector<std::uint64_t> m_hostile_owner_masks;
   std::vector<int> m_present_owner_ids;
 };
 
@@ -119,6 +122,12 @@ auto find_nearest_enemy(Engine::Core::Entity* unit,
                         std::uint64_t* scan_iterations = nullptr)
     -> Engine::Core::Entity*;
 
+void find_nearest_enemies(std::span<Engine::Core::Entity* const> units,
+                          std::span<const float> max_ranges,
+                          const CombatQueryContext& query_context,
+                          std::vector<Engine::Core::Entity*>& nearest,
+                          std::uint64_t* scan_iterations = nullptr);
+
 auto should_auto_engage_melee(Engine::Core::Entity* unit) -> bool;
 
 } // namespace Game::Systems::Combat
@@ -8,6 +8,7 @@
 #include <limits>
 #include <numbers>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "../../core/component.h"
@@ -1045,8 +1046,13 @@ apply_unit_damage(Engine::Core::World* world,
 
   Game::Units::SpawnType const attacker_type =
       attacker_type_opt.value_or(Game::Units::SpawnType::Knight);
-  Engine::Core::EventManager::instance().publish(Engine::Core::CombatHitEvent(
-      attacker_id, target->get_id(), effective_damage, attacker_type, is_killing_blow));
+  Engine::Core::CombatHitEvent hit(
+      attacker_id, target->get_id(), effective_damage, attacker_type, is_killing_blow);
+  if (world != nullptr) {
+    world->events().push(std::move(hit));
+  } else {
+    Engine::Core::EventManager::instance().publish(hit);
+  }
 
   if (structure) {
     queue_structure_impact(*target, attacker, contact_point);
@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "../core/component.h"
@@ -292,6 +293,26 @@ void CommandService::move_units(Engine::Core::World& world,
   MovementSystem::issue_move_units(world, intents, options);
 }
 
+void CommandService::defer_move_unit(Engine::Core::World& world,
+                                     Engine::Core::EntityID unit_id,
+                                     const QVector3D& target,
+                                     const MoveOptions& options) {
+  world.deferred().run([unit_id, target, options](Engine::Core::World& at_barrier) {
+    MovementSystem::issue_move(at_barrier, unit_id, target, options);
+  });
+}
+
+void CommandService::defer_move_units(Engine::Core::World& world,
+                                      std::vector<Engine::Core::EntityID> units,
+                                      std::vector<QVector3D> targets,
+                                      const MoveOptions& options) {
+  world.deferred().run([units = std::move(units),
+                        targets = std::move(targets),
+                        options](Engine::Core::World& at_barrier) {
+    MovementSystem::issue_move_units(at_barrier, units, targets, options);
+  });
+}
+
 void CommandService::attack_target(Engine::Core::World& world,
                                    const std::vector<Engine::Core::EntityID>& units,
                                    Engine::Core::EntityID target_id,
@@ -83,6 +83,19 @@ public:
                          const std::vector<MoveIntent>& intents,
                          const MoveOptions& options);
 
+  // Issue the move at the next phase barrier instead of in place. A move can
+  // add and remove components, so a system that shares a parallel batch moves
+  // units through these.
+  static void defer_move_unit(Engine::Core::World& world,
+                              Engine::Core::EntityID unit_id,
+                              const QVector3D& target,
+                              const MoveOptions& options);
+
+  static void defer_move_units(Engine::Core::World& world,
+                               std::vector<Engine::Core::EntityID> units,
+                               std::vector<QVector3D> targets,
+                               const MoveOptions& options);
+
   static void attack_target(Engine::Core::World& world,
                             const std::vector<Engine::Core::EntityID>& units,
                             Engine::Core::EntityID target_id,
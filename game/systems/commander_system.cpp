@@ -4,7 +4,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <map>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "../core/component.h"
 #include "../core/event_manager.h"
@@ -41,13 +44,18 @@ constexpr float k_off_school_aura_scale = 0.5F;
   return dx * dx + dz * dz;
 }
 
+// Components handed to units that lack them. They are filled in place during
+// the update and added at the phase barrier, in entity order.
+struct PendingAdds {
+  std::map<Engine::Core::EntityID, Engine::Core::MoraleComponent> morale;
+  std::map<Engine::Core::EntityID, Engine::Core::CommanderAuraBuffComponent> buffs;
+};
+
 auto morale_for(Engine::Core::World* world,
+                PendingAdds& pending,
                 Engine::Core::EntityID entity_id) -> Engine::Core::MoraleComponent* {
   auto* morale = world->try_get<Engine::Core::MoraleComponent>(entity_id);
-  if (morale == nullptr) {
-    morale = world->emplace<Engine::Core::MoraleComponent>(entity_id);
-  }
-  return morale;
+  return morale != nullptr ? morale : &pending.morale[entity_id];
 }
 
 auto resolve_troop_type(const Engine::Core::UnitComponent* unit)
@@ -270,6 +278,7 @@ void collapse_nation_if_leaderless(Engine::Core::World& world, int owner_id) {
 }
 
 void apply_commander_death_shock(Engine::Core::World* world,
+                                 PendingAdds& pending,
                                  Engine::Core::Entity* commander_entity,
                                  Engine::Core::CommanderComponent& commander,
                                  const Engine::Core::UnitComponent& unit,
@@ -289,7 +298,7 @@ void apply_commander_death_shock(Engine::Core::World* world,
     if (distance_sq(origin, candidate_transform) > shock_radius_sq) {
       continue;
     }
-    if (auto* morale = morale_for(world, candidate_id)) {
+    if (auto* morale = morale_for(world, pending, candidate_id)) {
       morale->morale -= commander.death_morale_shock;
       morale->shock_timer = std::max(morale->shock_timer, 4.0F);
       refresh_morale_state(*morale);
@@ -305,6 +314,7 @@ void CommanderSystem::update(Engine::Core::World* world, float delta_time) {
   }
 
   reset_commander_modified_stats(world);
+  PendingAdds pending;
 
   for (auto [entity_id, morale] : world->view<Engine::Core::MoraleComponent>()) {
     (void)entity_id;
@@ -361,8 +371,10 @@ void CommanderSystem::update(Engine::Core::World* world, float delta_time) {
         commander->aura_ability_active = false;
         commander->aura_ability_remaining = 0.0F;
         apply_commander_death_shock(
-            world, commander_entity, *commander, *unit, *transform);
-        collapse_nation_if_leaderless(*world, unit->owner_id);
+            world, pending, commander_entity, *commander, *unit, *transform);
+        world->deferred().run([owner_id = unit->owner_id](Engine::Core::World& target) {
+          collapse_nation_if_leaderless(target, owner_id);
+        });
       }
       if (commander->flag_rally_in_progress || commander->flag_rally_flag_active ||
           commander->flag_rally_issue_commands) {
@@ -432,9 +444,12 @@ void CommanderSystem::update(Engine::Core::World* world, float delta_time) {
             stamina->is_running = false;
           }
         }
-        auto const move_plan =
-            CommandService::plan_ground_move(*world, rallied_units, rally_pos);
-        CommandService::issue_ground_move(*world, rallied_units, move_plan);
+        world->deferred().run([units = std::move(rallied_units),
+                               rally_pos](Engine::Core::World& target) {
+          auto const move_plan =
+              CommandService::plan_ground_move(target, units, rally_pos);
+          CommandService::issue_ground_move(target, units, move_plan);
+        });
       }
     }
 
@@ -455,25 +470,21 @@ void CommanderSystem::update(Engine::Core::World* world, float delta_time) {
       const float dist_sq = distance_sq(*transform, *candidate_transform);
       const bool candidate_is_troop = is_living_troop(candidate_unit);
       if (dist_sq <= aura_radius_sq && commander->aura_ability_active) {
+        Engine::Core::CommanderAuraBuffComponent* buff = nullptr;
         if (candidate_is_troop) {
-          auto* morale = morale_for(world, candidate->get_id());
-          if (morale != nullptr) {
-            morale->commander_aura_bonus =
-                std::max(morale->commander_aura_bonus, commander->aura_morale_bonus);
-            morale->morale += commander->aura_morale_bonus * delta_time * 0.05F;
-            refresh_morale_state(*morale);
-          }
+          auto* morale = morale_for(world, pending, candidate->get_id());
+          morale->commander_aura_bonus =
+              std::max(morale->commander_aura_bonus, commander->aura_morale_bonus);
+          morale->morale += commander->aura_morale_bonus * delta_time * 0.05F;
+          refresh_morale_state(*morale);
 
-          auto* buff =
-              candidate->get_component<Engine::Core::CommanderAuraBuffComponent>();
+          buff = candidate->get_component<Engine::Core::CommanderAuraBuffComponent>();
           if (buff == nullptr) {
-            buff = candidate->add_component<Engine::Core::CommanderAuraBuffComponent>();
-          }
-          if (buff != nullptr) {
-            buff->active = true;
-            buff->source_commander_id = commander_entity->get_id();
-            buff->strength = std::max(buff->strength, commander->aura_bonus_value);
+            buff = &pending.buffs[candidate->get_id()];
           }
+          buff->active = true;
+          buff->source_commander_id = commander_entity->get_id();
+          buff->strength = std::max(buff->strength, commander->aura_bonus_value);
         }
 
         const float affinity =
@@ -484,8 +495,6 @@ void CommanderSystem::update(Engine::Core::World* world, float delta_time) {
         const float aura_value = commander->aura_bonus_value * affinity;
 
         if (candidate_is_troop && commander->bonus_type == "health_regen") {
-          auto* buff =
-              candidate->get_component<Engine::Core::CommanderAuraBuffComponent>();
           if (buff != nullptr) {
             buff->health_regen_accumulator += std::max(0.0F, aura_value) * delta_time;
             const int restored =
@@ -534,13 +543,19 @@ void CommanderSystem::update(Engine::Core::World* world, float delta_time) {
       }
     }
   }
+
+  for (auto& [entity_id, morale] : pending.morale) {
+    world->deferred().add_component<Engine::Core::MoraleComponent>(entity_id, morale);
+  }
+  for (auto& [entity_id, buff] : pending.buffs) {
+    world->deferred().add_component<Engine::Core::CommanderAuraBuffComponent>(entity_id,
+                                                                             buff);
+  }
 }
 
 auto CommanderSystem::access() const -> Engine::Core::SystemAccess {
   using namespace Engine::Core;
-  return SystemAccess::declare(Reads<UnitComponent,
-                                     TransformComponent,
-                                     ProductionComponent,
+  return SystemAccess::declare(Reads<TransformComponent,
                                      CombatStateComponent,
                                      RpgCommanderActionComponent,
                                      BuildingComponent,
@@ -551,7 +566,9 @@ auto CommanderSystem::access() const -> Engine::Core::SystemAccess {
                                       MovementComponent,
                                       AttackComponent,
                                       AttackTargetComponent,
-                                      StaminaComponent>{});
+                                      StaminaComponent,
+                                      UnitComponent,
+                                      ProductionComponent>{});
 }
 
 } // namespace Game::Systems
@@ -126,21 +126,23 @@ void EngagementSlotSystem::run(Engine::Core::SystemContext& context) {
     float const anchor_x = std::cos(angle) * offset_dist;
     float const anchor_z = std::sin(angle) * offset_dist;
 
-    if (slot == nullptr) {
-      slot = context.emplace<Engine::Core::EngagementSlotComponent>(attacker_id);
-    }
+    Engine::Core::EngagementSlotComponent assigned;
+    assigned.target_id = target_id;
+    assigned.slot_index = slot_idx;
+    assigned.max_slots = k_max_slots_per_target;
+    assigned.anchor_offset_x = anchor_x;
+    assigned.anchor_offset_z = anchor_z;
+    assigned.valid = true;
+    assigned.lease_remaining = k_slot_lease_duration;
     if (slot != nullptr) {
-      slot->target_id = target_id;
-      slot->slot_index = slot_idx;
-      slot->max_slots = k_max_slots_per_target;
-      slot->anchor_offset_x = anchor_x;
-      slot->anchor_offset_z = anchor_z;
-      slot->valid = true;
-      slot->lease_remaining = k_slot_lease_duration;
-
-      occupancy.reserve(slot_idx, attacker_id);
-      ++m_diagnostics.slots_allocated;
+      *slot = assigned;
+    } else {
+      context.deferred().add_component<Engine::Core::EngagementSlotComponent>(
+          attacker_id, assigned);
     }
+
+    occupancy.reserve(slot_idx, attacker_id);
+    ++m_diagnostics.slots_allocated;
   }
 }
 
@@ -0,0 +1,167 @@
+#include "flow_field.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace Game::Systems {
+
+namespace {
+
+constexpr int k_unreached = std::numeric_limits<int>::max();
+constexpr std::uint8_t k_no_direction = 0xFFU;
+
+constexpr std::array<Point, 8> k_steps{Point{1, 0},
+                                       Point{-1, 0},
+                                       Point{0, 1},
+                                       Point{0, -1},
+                                       Point{1, 1},
+                                       Point{1, -1},
+                                       Point{-1, 1},
+                                       Point{-1, -1}};
+
+struct FieldOpen {
+  int cost;
+  int index;
+};
+
+auto field_open_after(const FieldOpen& lhs, const FieldOpen& rhs) -> bool {
+  if (lhs.cost != rhs.cost) {
+    return lhs.cost > rhs.cost;
+  }
+  return lhs.index > rhs.index;
+}
+
+} // namespace
+
+FlowField::FlowField(const Point& goal,
+                     Pathfinding::Passability passability,
+                     int clearance_quarters,
+                     const CellRange& bounds,
+                     std::uint64_t navigation_revision)
+    : m_goal(goal)
+    , m_passability(passability)
+    , m_clearance_quarters(clearance_quarters)
+    , m_bounds(bounds)
+    , m_navigation_revision(navigation_revision)
+    , m_columns(std::max(0, bounds.max_x - bounds.min_x + 1))
+    , m_rows(std::max(0, bounds.max_z - bounds.min_z + 1)) {
+  auto const cell_count =
+      static_cast<std::size_t>(m_columns) * static_cast<std::size_t>(m_rows);
+  m_integration.assign(cell_count, k_unreached);
+  m_direction.assign(cell_count, k_no_direction);
+}
+
+auto FlowField::contains(const Point& cell) const -> bool {
+  return cell.x >= m_bounds.min_x && cell.x <= m_bounds.max_x &&
+         cell.y >= m_bounds.min_z && cell.y <= m_bounds.max_z;
+}
+
+auto FlowField::covers(const CellRange& window) const -> bool {
+  return window.min_x >= m_bounds.min_x && window.max_x <= m_bounds.max_x &&
+         window.min_z >= m_bounds.min_z && window.max_z <= m_bounds.max_z;
+}
+
+auto FlowField::local_index(int x, int z) const -> std::size_t {
+  return static_cast<std::size_t>(z - m_bounds.min_z) *
+             static_cast<std::size_t>(m_columns) +
+         static_cast<std::size_t>(x - m_bounds.min_x);
+}
+
+auto FlowField::cost_to_goal(const Point& cell) const -> int {
+  if (!contains(cell)) {
+    return k_unreachable;
+  }
+  int const cost = m_integration[local_index(cell.x, cell.y)];
+  return cost == k_unreached ? k_unreachable : cost;
+}
+
+auto FlowField::next_step(const Point& cell) const -> std::optional<Point> {
+  if (!contains(cell)) {
+    return std::nullopt;
+  }
+  std::uint8_t const direction = m_direction[local_index(cell.x, cell.y)];
+  if (direction == k_no_direction) {
+    return std::nullopt;
+  }
+  Point const& step = k_steps[direction];
+  return Point{cell.x + step.x, cell.y + step.y};
+}
+
+auto FlowField::trace(const Point& from) const -> std::vector<Point> {
+  if (cost_to_goal(from) == k_unreachable) {
+    return {};
+  }
+  std::vector<Point> path;
+  path.push_back(from);
+  Point current = from;
+  std::size_t const limit = m_integration.size();
+  while (!(current == m_goal) && path.size() <= limit) {
+    auto const next = next_step(current);
+    if (!next.has_value()) {
+      return {};
+    }
+    current = *next;
+    path.push_back(current);
+  }
+  return path;
+}
+
+void FlowField::build(const Pathfinding& grid, int clearance_weight) {
+  m_reached_cells = 0;
+  if (!contains(m_goal) || !grid.is_walkable(m_goal.x, m_goal.y, m_passability)) {
+    return;
+  }
+
+  auto const open_cell = [this, &grid](int x, int z) -> bool {
+    return x >= m_bounds.min_x && x <= m_bounds.max_x && z >= m_bounds.min_z &&
+           z <= m_bounds.max_z && grid.is_walkable(x, z, m_passability);
+  };
+
+  thread_local std::vector<FieldOpen> open;
+  open.clear();
+
+  std::size_t const goal_index = local_index(m_goal.x, m_goal.y);
+  m_integration[goal_index] = 0;
+  open.push_back({0, static_cast<int>(goal_index)});
+
+  while (!open.empty()) {
+    std::pop_heap(open.begin(), open.end(), field_open_after);
+    FieldOpen const current = open.back();
+    open.pop_back();
+    auto const current_index = static_cast<std::size_t>(current.index);
+    if (current.cost > m_integration[current_index]) {
+      continue;
+    }
+    ++m_reached_cells;
+
+    int const x = m_bounds.min_x + (current.index % m_columns);
+    int const z = m_bounds.min_z + (current.index / m_columns);
+    int const entry_cost =
+        grid.clearance_penalty(x, z) * clearance_weight + current.cost;
+
+    for (std::size_t direction = 0; direction < k_steps.size(); ++direction) {
+      int const from_x = x - k_steps[direction].x;
+      int const from_z = z - k_steps[direction].y;
+      if (!open_cell(from_x, from_z)) {
+        continue;
+      }
+      bool const diagonal = k_steps[direction].x != 0 && k_steps[direction].y != 0;
+      if (diagonal && (!open_cell(x, from_z) || !open_cell(from_x, z))) {
+        continue;
+      }
+      int const cost = entry_cost + (diagonal ? Pathfinding::k_diagonal_step_cost
+                                              : Pathfinding::k_straight_step_cost);
+      std::size_t const from_index = local_index(from_x, from_z);
+      if (cost >= m_integration[from_index]) {
+        continue;
+      }
+      m_integration[from_index] = cost;
+      m_direction[from_index] = static_cast<std::uint8_t>(direction);
+      open.push_back({cost, static_cast<int>(from_index)});
+      std::push_heap(open.begin(), open.end(), field_open_after);
+    }
+  }
+}
+
+} // namespace Game::Systems
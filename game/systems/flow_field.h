@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "nav_grid_types.h"
+#include "pathfinding.h"
+
+namespace Game::Systems {
+
+class FlowField {
+public:
+  static constexpr int k_unreachable = -1;
+
+  FlowField(const Point& goal,
+            Pathfinding::Passability passability,
+            int clearance_quarters,
+            const CellRange& bounds,
+            std::uint64_t navigation_revision);
+
+  [[nodiscard]] auto goal() const noexcept -> const Point& { return m_goal; }
+  [[nodiscard]] auto passability() const noexcept -> Pathfinding::Passability {
+    return m_passability;
+  }
+  [[nodiscard]] auto clearance_quarters() const noexcept -> int {
+    return m_clearance_quarters;
+  }
+  [[nodiscard]] auto bounds() const noexcept -> const CellRange& { return m_bounds; }
+  [[nodiscard]] auto navigation_revision() const noexcept -> std::uint64_t {
+    return m_navigation_revision;
+  }
+  [[nodiscard]] auto reached_cells() const noexcept -> std::size_t {
+    return m_reached_cells;
+  }
+
+  [[nodiscard]] auto contains(const Point& cell) const -> bool;
+  [[nodiscard]] auto covers(const CellRange& window) const -> bool;
+  [[nodiscard]] auto cost_to_goal(const Point& cell) const -> int;
+  [[nodiscard]] auto next_step(const Point& cell) const -> std::optional<Point>;
+  [[nodiscard]] auto trace(const Point& from) const -> std::vector<Point>;
+
+private:
+  friend class Pathfinding;
+
+  void build(const Pathfinding& grid, int clearance_weight);
+  [[nodiscard]] auto local_index(int x, int z) const -> std::size_t;
+
+  Point m_goal;
+  Pathfinding::Passability m_passability;
+  int m_clearance_quarters;
+  CellRange m_bounds;
+  std::uint64_t m_navigation_revision;
+  int m_columns;
+  int m_rows;
+  std::vector<int> m_integration;
+  std::vector<std::uint8_t> m_direction;
+  std::size_t m_reached_cells{0};
+};
+
+} // namespace Game::Systems
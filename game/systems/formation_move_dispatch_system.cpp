@@ -1,15 +1,15 @@
 #include "formation_move_dispatch_system.h"
 
 #include "../core/component.h"
+#include "../core/world.h"
 #include "../formation/army_formation_registry.h"
 #include "command_service.h"
 
 namespace Game::Systems {
 
-void FormationMoveDispatchSystem::update(Engine::Core::World* world, float) {
-  if (world == nullptr) {
-    return;
-  }
+namespace {
+
+void dispatch_pending_moves(Engine::Core::World& world) {
   auto& registry = Game::Formation::ArmyFormationRegistry::instance();
   for (auto const id : registry.group_ids()) {
     auto* formation = registry.find(id);
@@ -21,16 +21,25 @@ void FormationMoveDispatchSystem::update(Engine::Core::World* world, float) {
       if (slot.occupant == 0U || slot.status == Game::Formation::SlotStatus::Blocked) {
         continue;
       }
-      CommandService::move_unit(*world, slot.occupant, slot.world_position);
+      CommandService::move_unit(world, slot.occupant, slot.world_position);
     }
   }
 }
 
+} // namespace
+
+void FormationMoveDispatchSystem::update(Engine::Core::World* world, float) {
+  if (world == nullptr) {
+    return;
+  }
+  // The formation registry is process-wide and a move can add components, so
+  // the dispatch itself runs at the phase barrier.
+  world->deferred().run(dispatch_pending_moves);
+}
+
 auto FormationMoveDispatchSystem::access() const -> Engine::Core::SystemAccess {
   using namespace Engine::Core;
-  return SystemAccess::declare(
-      Reads<UnitComponent, BuildingComponent, PendingRemovalComponent>{},
-      Writes<MovementComponent, TransformComponent, AttackComponent>{});
+  return SystemAccess::declare(Reads<>{}, Writes<>{});
 }
 
 } // namespace Game::Systems
@@ -54,7 +54,7 @@ void GateSystem::update(Engine::Core::World* world, float delta_time) {
   auto gate_view =
       world->entity_view<GateComponent, TransformComponent, UnitComponent>();
   if (gate_view.empty()) {
-    GateService::clear_blockers();
+    world->deferred().run([](Engine::Core::World&) { GateService::clear_blockers(); });
     return;
   }
 
@@ -82,7 +82,7 @@ void GateSystem::update(Engine::Core::World* world, float delta_time) {
   }
 
   if (gates.empty()) {
-    GateService::clear_blockers();
+    world->deferred().run([](Engine::Core::World&) { GateService::clear_blockers(); });
     return;
   }
 
@@ -154,16 +154,16 @@ void GateSystem::update(Engine::Core::World* world, float delta_time) {
 
     if (gate.state != previous_state) {
       if (gate.state == GateComponent::State::Opening) {
-        Engine::Core::EventManager::instance().publish(
-            Engine::Core::AudioCueEvent("build.gate_open"));
+        world->events().push(Engine::Core::AudioCueEvent("build.gate_open"));
       } else if (gate.state == GateComponent::State::Closing) {
-        Engine::Core::EventManager::instance().publish(
-            Engine::Core::AudioCueEvent("build.gate_close"));
+        world->events().push(Engine::Core::AudioCueEvent("build.gate_close"));
       }
     }
   }
 
-  GateService::refresh_blockers(*world);
+  // The blockers are shared with movement, so they are rebuilt at the barrier.
+  world->deferred().run(
+      [](Engine::Core::World& target) { GateService::refresh_blockers(target); });
 }
 
 auto GateSystem::access() const -> Engine::Core::SystemAccess {
@@ -68,10 +68,11 @@ void GuardSystem::run(Engine::Core::SystemContext& context) {
 
               CommandService::MoveOptions opts;
               opts.kind = MoveOrderKind::GuardReturn;
-              std::vector<Engine::Core::EntityID> const ids = {entity_id};
-              std::vector<QVector3D> const targets = {
-                  QVector3D(new_guard_x, 0.0F, new_guard_z)};
-              CommandService::move_units(context.world(), ids, targets, opts);
+              CommandService::defer_move_units(
+                  context.world(),
+                  {entity_id},
+                  {QVector3D(new_guard_x, 0.0F, new_guard_z)},
+                  opts);
             }
           }
         }
@@ -92,10 +93,12 @@ void GuardSystem::run(Engine::Core::SystemContext& context) {
 
           CommandService::MoveOptions opts;
           opts.kind = MoveOrderKind::GuardReturn;
-          std::vector<Engine::Core::EntityID> const ids = {entity_id};
-          std::vector<QVector3D> const targets = {QVector3D(
-              guard_mode->guard_position_x, 0.0F, guard_mode->guard_position_z)};
-          CommandService::move_units(context.world(), ids, targets, opts);
+          CommandService::defer_move_units(
+              context.world(),
+              {entity_id},
+              {QVector3D(
+                  guard_mode->guard_position_x, 0.0F, guard_mode->guard_position_z)},
+              opts);
         }
       }
     }
@@ -107,10 +110,11 @@ auto GuardSystem::access() const -> Engine::Core::SystemAccess {
   return SystemAccess::declare(
       Reads<UnitComponent,
             TransformComponent,
+            MovementComponent,
             AttackTargetComponent,
             BuildingComponent,
             PendingRemovalComponent>{},
-      Writes<GuardModeComponent, MovementComponent, AttackComponent>{});
+      Writes<GuardModeComponent>{});
 }
 
 } // namespace Game::Systems
@@ -45,7 +45,7 @@ void HealingSystem::run(Engine::Core::SystemContext& context) {
 
 void HealingSystem::process_healing(Engine::Core::SystemContext& context) {
   const float delta_time = context.delta_time();
-  auto* healing_beam_system = context.world().get_system<HealingBeamSystem>();
+  bool const has_beams = context.world().get_system<HealingBeamSystem>() != nullptr;
 
   auto& index = context.spatial_index();
   index.refresh(context.world());
@@ -132,8 +132,7 @@ void HealingSystem::process_healing(Engine::Core::SystemContext& context) {
         target_unit->health =
             std::min(target_unit->health + healer_comp->healing_amount,
                      HealingRules::maximum_recoverable_health(*target));
-        Engine::Core::EventManager::instance().publish(
-            Engine::Core::AudioCueEvent("combat.heal"));
+        context.world().events().push(Engine::Core::AudioCueEvent("combat.heal"));
 
         healer_comp->healing_target_x = target_transform->position.x;
         healer_comp->healing_target_z = target_transform->position.z;
@@ -145,7 +144,7 @@ void HealingSystem::process_healing(Engine::Core::SystemContext& context) {
           healer_transform->has_desired_yaw = true;
         }
 
-        if (healing_beam_system != nullptr) {
+        if (has_beams) {
           QVector3D const healer_pos(healer_transform->position.x,
                                      healer_transform->position.y + 1.2F,
                                      healer_transform->position.z);
@@ -155,7 +154,14 @@ void HealingSystem::process_healing(Engine::Core::SystemContext& context) {
 
           QVector3D const heal_color = get_healing_color(healer_unit->nation_id);
 
-          healing_beam_system->spawn_beam(healer_pos, target_pos, heal_color, 0.7F);
+          // HealingBeamSystem may share this batch, so the beam is added at the
+          // barrier.
+          context.deferred().run(
+              [healer_pos, target_pos, heal_color](Engine::Core::World& at_barrier) {
+                if (auto* beams = at_barrier.get_system<HealingBeamSystem>()) {
+                  beams->spawn_beam(healer_pos, target_pos, heal_color, 0.7F);
+                }
+              });
         }
 
         healed_any = true;
@@ -5,7 +5,6 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
-#include <unordered_map>
 #include <vector>
 
 #include "../core/component.h"
@@ -22,16 +21,6 @@ namespace Game::Systems {
 
 namespace {
 
-struct CellKey {
-  int cx;
-  int cz;
-};
-
-auto to_cell(float x, float z, float inv_cell_size) -> CellKey {
-  return {static_cast<int>(std::floor(x * inv_cell_size)),
-          static_cast<int>(std::floor(z * inv_cell_size))};
-}
-
 auto compute_avoidance_priority(Engine::Core::SystemContext& context,
                                 Engine::Core::EntityID entity_id) -> std::uint8_t {
   if (context.has<Engine::Core::BuildingComponent>(entity_id)) {
@@ -66,12 +55,6 @@ auto point_is_in_navigation_passage(float x, float z) -> bool {
 
 } // namespace
 
-auto LocalAvoidanceSystem::cell_key(int cell_x, int cell_z) -> std::int64_t {
-  auto const high = static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell_x));
-  auto const low = static_cast<std::uint32_t>(cell_z);
-  return static_cast<std::int64_t>((high << 32U) | low);
-}
-
 void LocalAvoidanceSystem::run(Engine::Core::SystemContext& context) {
   const float delta_time = context.delta_time();
   if (delta_time <= 0.0F) {
@@ -85,17 +68,11 @@ void LocalAvoidanceSystem::run(Engine::Core::SystemContext& context) {
     return;
   }
 
-  float const inv_cell_size = 1.0F / k_default_cell_size;
-  for (std::int64_t const key : m_active_cell_keys) {
-    if (auto bucket = m_grid.find(key); bucket != m_grid.end()) {
-      bucket->second.clear();
-    }
-  }
-  m_active_cell_keys.clear();
+  m_grid.clear();
   m_circles.clear();
-  m_grid.reserve(std::max(m_previous_cell_count, unit_ids.size() / 2U));
-  m_active_cell_keys.reserve(std::max(m_previous_cell_count, unit_ids.size() / 2U));
+  m_grid.reserve(unit_ids.size());
   m_circles.reserve(unit_ids.size());
+  float max_radius = 0.0F;
 
   for (auto [entity_id, unit, transform] :
        context.view<Engine::Core::UnitComponent, Engine::Core::TransformComponent>()) {
@@ -130,18 +107,11 @@ void LocalAvoidanceSystem::run(Engine::Core::SystemContext& context) {
 
     circle.priority = compute_avoidance_priority(context, entity_id);
 
-    std::size_t const idx = m_circles.size();
+    m_grid.insert(static_cast<std::uint32_t>(m_circles.size()), circle.x, circle.z);
     m_circles.push_back(circle);
-
-    CellKey const key = to_cell(circle.x, circle.z, inv_cell_size);
-    std::int64_t const packed_key = cell_key(key.cx, key.cz);
-    auto& bucket = m_grid[packed_key];
-    if (bucket.empty()) {
-      m_active_cell_keys.push_back(packed_key);
-    }
-    bucket.push_back(idx);
+    max_radius = std::max(max_radius, circle.radius);
   }
-  m_previous_cell_count = std::max(m_previous_cell_count, m_active_cell_keys.size());
+  m_grid.build();
 
   m_diagnostics.units_processed = static_cast<std::uint32_t>(m_circles.size());
 
@@ -153,62 +123,53 @@ void LocalAvoidanceSystem::run(Engine::Core::SystemContext& context) {
     if (!ci.is_moving) {
       continue;
     }
-    CellKey const center = to_cell(ci.x, ci.z, inv_cell_size);
     float sep_x = 0.0F;
     float sep_z = 0.0F;
     int neighbor_count = 0;
 
-    for (int dx = -1; dx <= 1; ++dx) {
-      for (int dz = -1; dz <= 1; ++dz) {
-        CellKey const neighbor_key{center.cx + dx, center.cz + dz};
-        auto it = m_grid.find(cell_key(neighbor_key.cx, neighbor_key.cz));
-        if (it == m_grid.end()) {
-          continue;
+    float const reach = ci.radius + max_radius + k_separation_radius;
+    m_grid.for_each_in_box(ci.x, ci.z, reach, [&](const BucketGrid::Item& item) {
+      if (item.key == i) {
+        return;
+      }
+      auto& cj = m_circles[item.key];
+      float const ddx = ci.x - cj.x;
+      float const ddz = ci.z - cj.z;
+      float const dist_sq = ddx * ddx + ddz * ddz;
+      float const min_dist = ci.radius + cj.radius + k_separation_radius;
+      float const min_dist_sq = min_dist * min_dist;
+
+      ++total_neighbors_checked;
+
+      if (dist_sq < min_dist_sq) {
+        float dist = std::sqrt(std::max(dist_sq, 0.0F));
+        float nx = 0.0F;
+        float nz = 0.0F;
+        if (dist > 1e-6F) {
+          nx = ddx / dist;
+          nz = ddz / dist;
+        } else {
+          auto const seed =
+              static_cast<std::uint32_t>((ci.id * 73856093U) ^ (cj.id * 19349663U));
+          float const angle = static_cast<float>(seed % 6283U) * 0.001F;
+          nx = std::cos(angle);
+          nz = std::sin(angle);
+          dist = 0.0F;
         }
-        for (std::size_t const j : it->second) {
-          if (j == i) {
-            continue;
-          }
-          auto& cj = m_circles[j];
-          float const ddx = ci.x - cj.x;
-          float const ddz = ci.z - cj.z;
-          float const dist_sq = ddx * ddx + ddz * ddz;
-          float const min_dist = ci.radius + cj.radius + k_separation_radius;
-          float const min_dist_sq = min_dist * min_dist;
-
-          ++total_neighbors_checked;
-
-          if (dist_sq < min_dist_sq) {
-            float dist = std::sqrt(std::max(dist_sq, 0.0F));
-            float nx = 0.0F;
-            float nz = 0.0F;
-            if (dist > 1e-6F) {
-              nx = ddx / dist;
-              nz = ddz / dist;
-            } else {
-              auto const seed =
-                  static_cast<std::uint32_t>((ci.id * 73856093U) ^ (cj.id * 19349663U));
-              float const angle = static_cast<float>(seed % 6283U) * 0.001F;
-              nx = std::cos(angle);
-              nz = std::sin(angle);
-              dist = 0.0F;
-            }
-            float const overlap = min_dist - dist;
-
-            float weight = 1.0F;
-            if (cj.priority > ci.priority) {
-              weight = 1.5F;
-            } else if (cj.priority < ci.priority) {
-              weight = 0.5F;
-            }
-
-            sep_x += nx * overlap * weight;
-            sep_z += nz * overlap * weight;
-            ++neighbor_count;
-          }
+        float const overlap = min_dist - dist;
+
+        float weight = 1.0F;
+        if (cj.priority > ci.priority) {
+          weight = 1.5F;
+        } else if (cj.priority < ci.priority) {
+          weight = 0.5F;
         }
+
+        sep_x += nx * overlap * weight;
+        sep_z += nz * overlap * weight;
+        ++neighbor_count;
       }
-    }
+    });
 
     if (neighbor_count > 0) {
       float const inv_n = 1.0F / static_cast<float>(neighbor_count);
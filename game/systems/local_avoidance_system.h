@@ -2,12 +2,12 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <unordered_map>
 #include <vector>
 
 #include "../core/component.h"
 #include "../core/entity_id.h"
 #include "../core/system.h"
+#include "bucket_grid.h"
 
 namespace Engine::Core {
 class SystemContext;
@@ -50,13 +50,9 @@ private:
     bool follows_navigation_path{false};
   };
 
-  static auto cell_key(int cell_x, int cell_z) -> std::int64_t;
-
   LocalAvoidanceDiagnostics m_diagnostics;
-  std::unordered_map<std::int64_t, std::vector<std::size_t>> m_grid;
-  std::vector<std::int64_t> m_active_cell_keys;
+  BucketGrid m_grid{k_default_cell_size};
   std::vector<UnitCircle> m_circles;
-  std::size_t m_previous_cell_count{0};
 };
 
 } // namespace Game::Systems
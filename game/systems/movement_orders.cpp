@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstdlib>
 #include <limits>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -12,6 +14,7 @@
 #include "../map/terrain_service.h"
 #include "combat_rules.h"
 #include "command_service.h"
+#include "flow_field.h"
 #include "formation_combat_geometry.h"
 #include "movement_system.h"
 #include "nav_grid.h"
@@ -25,12 +28,8 @@ constexpr float same_target_threshold_sq = 0.01F;
 
 constexpr int k_recovery_search_radius = 16;
 constexpr float k_route_keep_goal_shift = 1.5F;
-
-auto passability_for(const Engine::Core::MovementComponent& movement)
-    -> Pathfinding::Passability {
-  return movement.get_can_enter_forest() ? Pathfinding::Passability::Light
-                                         : Pathfinding::Passability::Heavy;
-}
+constexpr std::size_t k_flow_field_min_group = 8U;
+constexpr int k_flow_field_margin = 24;
 
 auto is_direct_path_walkable(const QVector3D& from,
                              const QVector3D& to,
@@ -166,6 +165,48 @@ auto align_portal_waypoint(const QVector3D& waypoint,
   return waypoint;
 }
 
+// Joins a path solved from an earlier position at the path cell nearest the
+// mover's current cell, so a result that lands a few ticks late does not walk
+// the mover back to where it stood when it asked. Fails when that cell is not
+// in straight reach; an empty path stays empty.
+auto reanchor_path(Pathfinding& pathfinder,
+                   const QVector3D& current,
+                   const Point& start,
+                   Pathfinding::Passability passability,
+                   float clearance_radius,
+                   const std::vector<Point>& resolved,
+                   std::vector<Point>& out) -> bool {
+  out.clear();
+  if (resolved.empty()) {
+    return true;
+  }
+  std::size_t join = 0;
+  int best_distance = std::numeric_limits<int>::max();
+  for (std::size_t index = 0; index < resolved.size(); ++index) {
+    int const distance = std::max(std::abs(resolved[index].x - start.x),
+                                  std::abs(resolved[index].y - start.y));
+    if (distance <= best_distance) {
+      best_distance = distance;
+      join = index;
+    }
+  }
+  if (resolved[join] != start &&
+      !pathfinder.is_world_segment_walkable(
+          current,
+          pathfinder.path_waypoint_world_position(resolved[join]),
+          passability,
+          clearance_radius)) {
+    return false;
+  }
+  out.reserve(resolved.size() - join + 1U);
+  if (resolved[join] != start) {
+    out.push_back(start);
+  }
+  out.insert(out.end(), resolved.begin() + static_cast<std::ptrdiff_t>(join),
+             resolved.end());
+  return true;
+}
+
 void pull_path_taut(Pathfinding& pathfinder,
                     const Engine::Core::TransformComponent& transform,
                     Pathfinding::Passability passability,
@@ -275,6 +316,12 @@ auto prepare_move(Engine::Core::World& world,
 
 } // namespace
 
+auto MovementSystem::passability_for(const Engine::Core::MovementComponent& movement)
+    -> Pathfinding::Passability {
+  return movement.get_can_enter_forest() ? Pathfinding::Passability::Light
+                                         : Pathfinding::Passability::Heavy;
+}
+
 void MovementSystem::assign_direct_target(Engine::Core::MovementComponent& movement,
                                           const QVector3D& target) {
   movement.clear_path();
@@ -355,7 +402,8 @@ void MovementSystem::assign_navigation_target(
     Pathfinding* pathfinder,
     const Engine::Core::TransformComponent& transform,
     Engine::Core::MovementComponent& movement,
-    const QVector3D& requested_target) {
+    const QVector3D& requested_target,
+    const std::vector<Point>* resolved_path) {
   if (movement.has_requested_goal && movement.has_target && movement.has_waypoints() &&
       movement.remaining_waypoints() > 1U) {
     float const moved_x = requested_target.x() - movement.requested_goal_x;
@@ -412,18 +460,38 @@ void MovementSystem::assign_navigation_target(
     return;
   }
 
-  auto const path = pathfinder->find_path(
-      start, end, passability_for(movement), movement.get_navigation_clearance());
+  std::vector<Point> path;
+  if (resolved_path == nullptr || !reanchor_path(*pathfinder,
+                                                 current_pos,
+                                                 start,
+                                                 passability_for(movement),
+                                                 movement.get_navigation_clearance(),
+                                                 *resolved_path,
+                                                 path)) {
+    path = pathfinder->find_path(
+        start, end, passability_for(movement), movement.get_navigation_clearance());
+  }
+  apply_navigation_path(
+      *pathfinder, transform, movement, requested_target, start, path);
+}
+
+void MovementSystem::apply_navigation_path(
+    Pathfinding& pathfinder,
+    const Engine::Core::TransformComponent& transform,
+    Engine::Core::MovementComponent& movement,
+    const QVector3D& requested_target,
+    const Point& start,
+    const std::vector<Point>& path) {
   bool const include_first_waypoint = should_include_resolved_start_waypoint(start) ||
                                       (!path.empty() && path.front() != start);
   if (!assign_path_to_movement(
-          *pathfinder, path, transform, movement, include_first_waypoint)) {
+          pathfinder, path, transform, movement, include_first_waypoint)) {
     QVector3D const fallback =
         path.empty()
             ? resolve_walkable_direct_target(requested_target,
                                              passability_for(movement),
                                              movement.get_navigation_clearance())
-            : pathfinder->path_waypoint_world_position(path.back());
+            : pathfinder.path_waypoint_world_position(path.back());
     assign_direct_target(movement, fallback);
   }
 }
@@ -624,8 +692,35 @@ void MovementSystem::issue_move_units(Engine::Core::World& world,
           leader_start, leader_target, group_passability, group_clearance) &&
       (leader_start_cell == leader_target_cell ||
        !segment_traverses_navigation_portal(leader_start, leader_target));
+  std::size_t const mover_count = static_cast<std::size_t>(
+      std::count_if(prepared.begin(), prepared.end(), [](PreparedMove const& move) {
+        return move.transform != nullptr && move.movement != nullptr;
+      }));
+  std::shared_ptr<const FlowField> field;
+  if (!leader_direct && mover_count >= k_flow_field_min_group) {
+    Point const field_goal = Pathfinding::find_nearest_walkable_point(
+        leader_target_cell, k_recovery_search_radius, *pathfinder, group_passability);
+    CellRange window{field_goal.x, field_goal.x, field_goal.y, field_goal.y};
+    for (auto const& move : prepared) {
+      if (move.transform == nullptr || move.movement == nullptr) {
+        continue;
+      }
+      Point const start = NavGrid::world_to_grid(move.transform->position.x,
+                                                 move.transform->position.z);
+      window.min_x = std::min(window.min_x, start.x);
+      window.max_x = std::max(window.max_x, start.x);
+      window.min_z = std::min(window.min_z, start.y);
+      window.max_z = std::max(window.max_z, start.y);
+    }
+    window.min_x -= k_flow_field_margin;
+    window.max_x += k_flow_field_margin;
+    window.min_z -= k_flow_field_margin;
+    window.max_z += k_flow_field_margin;
+    field = pathfinder->flow_field(
+        field_goal, group_passability, group_clearance, window);
+  }
   std::vector<Point> corridor;
-  if (!leader_direct) {
+  if (!leader_direct && field == nullptr) {
     corridor = pathfinder->find_path(
         leader_start_cell, leader_target_cell, group_passability, group_clearance);
   }
@@ -639,7 +734,39 @@ void MovementSystem::issue_move_units(Engine::Core::World& world,
     }
 
     bool assigned = false;
-    if (corridor.size() > 1U) {
+    if (field != nullptr) {
+      Point const start = NavGrid::world_to_grid(move.transform->position.x,
+                                                 move.transform->position.z);
+      auto const route = field->trace(start);
+      if (route.size() > 1U) {
+        QVector3D const field_exit =
+            pathfinder->path_waypoint_world_position(route.back());
+        QVector3D const resolved_target =
+            resolve_walkable_direct_target(targets[i],
+                                           passability_for(*move.movement),
+                                           move.movement->get_navigation_clearance());
+        if (pathfinder->is_world_segment_walkable(
+                field_exit,
+                resolved_target,
+                passability_for(*move.movement),
+                move.movement->get_navigation_clearance())) {
+          assigned =
+              assign_path_to_movement(*pathfinder,
+                                      route,
+                                      *move.transform,
+                                      *move.movement,
+                                      should_include_resolved_start_waypoint(start));
+        }
+        if (assigned) {
+          if (std::hypot(resolved_target.x() - field_exit.x(),
+                         resolved_target.z() - field_exit.z()) > 0.01F) {
+            move.movement->path.emplace_back(resolved_target.x(), resolved_target.z());
+          }
+          move.movement->goal_x = resolved_target.x();
+          move.movement->goal_y = resolved_target.z();
+        }
+      }
+    } else if (corridor.size() > 1U) {
       Point const start = NavGrid::world_to_grid(move.transform->position.x,
                                                  move.transform->position.z);
       Point const target = NavGrid::world_to_grid(targets[i].x(), targets[i].z());
@@ -709,6 +836,8 @@ void MovementSystem::issue_move_units(Engine::Core::World& world,
       } else if (movement_system != nullptr &&
                  movement_system->enqueue_pending_path_request(
                      move.entity->get_id(),
+                     *move.transform,
+                     *move.movement,
                      targets[i],
                      options.kind == MoveOrderKind::AttackChase,
                      pathfinder->navigation_revision())) {
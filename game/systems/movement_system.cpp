@@ -21,7 +21,7 @@
 #include "formation_combat_geometry.h"
 #include "gate_service.h"
 #include "nav_grid.h"
-#include "order_service.h"
+#include "path_request_service.h"
 #include "pathfinding.h"
 
 namespace Game::Systems {
@@ -311,6 +311,16 @@ auto is_point_allowed(const QVector3D& pos,
 
 namespace {
 
+// Movement shares batches with other systems, so a finished order's intent is
+// removed at the phase barrier.
+void drop_player_order_intent(Engine::Core::World& world,
+                              const Engine::Core::Entity& entity) {
+  if (entity.has_component<Engine::Core::PlayerOrderIntentComponent>()) {
+    world.deferred().remove_component<Engine::Core::PlayerOrderIntentComponent>(
+        entity.get_id());
+  }
+}
+
 void finalize_orientation(Engine::Core::Entity* entity,
                           Engine::Core::TransformComponent* transform,
                           Engine::Core::MovementComponent* movement,
@@ -396,9 +406,14 @@ void MovementSystem::update(Engine::Core::World* world, float delta_time) {
       m_obstruction_revision = revision;
 
       pathfinder->update_navigation_grid();
+      m_changed_regions.clear();
+      bool const scoped =
+          pathfinder->dirty_regions_since(m_dirty_region_sequence, m_changed_regions);
       auto entities = world->collect_entities_with<Engine::Core::MovementComponent>();
-      repath_after_obstruction_release(*world, entities);
+      repath_after_obstruction_release(
+          *world, *pathfinder, entities, scoped ? &m_changed_regions : nullptr);
     }
+    m_dirty_region_sequence = pathfinder->dirty_region_sequence();
   }
 
   m_duel_clock += delta_time;
@@ -412,54 +427,130 @@ void MovementSystem::update(Engine::Core::World* world, float delta_time) {
 }
 
 void MovementSystem::process_pending_path_requests(Engine::Core::World& world) {
-  std::size_t processed = 0;
-  while (processed < k_path_requests_per_tick && !m_pending_path_requests.empty()) {
-    PendingPathRequest request = std::move(m_pending_path_requests.front());
-    m_pending_path_requests.pop_front();
+  if (m_pending_path_requests.empty()) {
+    return;
+  }
+
+  auto* pathfinder = NavGrid::get_pathfinder();
+  std::vector<PathResult> results;
+  if (pathfinder != nullptr) {
+    results = m_path_requests.resolve(*pathfinder);
+  } else {
+    for (PendingPathRequest const& request : m_pending_path_requests) {
+      m_path_requests.cancel(request.ticket);
+    }
+  }
+
+  std::deque<PendingPathRequest> requests = std::move(m_pending_path_requests);
+  m_pending_path_requests.clear();
+  std::size_t result_index = 0;
+  for (PendingPathRequest const& request : requests) {
+    while (result_index < results.size() &&
+           results[result_index].ticket < request.ticket) {
+      ++result_index;
+    }
     auto* entity = world.get_entity(request.entity_id);
     if (entity == nullptr) {
-      ++processed;
       continue;
     }
     auto* transform = entity->get_component<Engine::Core::TransformComponent>();
     auto* movement = entity->get_component<Engine::Core::MovementComponent>();
-    if (transform != nullptr && movement != nullptr) {
-      float const goal_dx = movement->get_goal_x() - request.target.x();
-      float const goal_dz = movement->get_goal_y() - request.target.z();
-      if (goal_dx * goal_dx + goal_dz * goal_dz > 0.01F) {
-        ++processed;
-        continue;
-      }
-      assign_navigation_target(
-          NavGrid::get_pathfinder(), *transform, *movement, request.target);
-      movement->precise_arrival = request.precise_arrival;
+    if (transform == nullptr || movement == nullptr) {
+      continue;
+    }
+    float const goal_dx = movement->get_goal_x() - request.target.x();
+    float const goal_dz = movement->get_goal_y() - request.target.z();
+    if (goal_dx * goal_dx + goal_dz * goal_dz > 0.01F) {
+      continue;
     }
-    ++processed;
+    bool const resolved = pathfinder != nullptr && result_index < results.size() &&
+                          results[result_index].ticket == request.ticket;
+    assign_navigation_target(pathfinder,
+                             *transform,
+                             *movement,
+                             request.target,
+                             resolved ? &results[result_index].path : nullptr);
+    movement->precise_arrival = request.precise_arrival;
   }
 }
 
-auto MovementSystem::enqueue_pending_path_request(Engine::Core::EntityID entity_id,
-                                                  const QVector3D& target,
-                                                  bool precise_arrival,
-                                                  std::uint64_t navigation_revision)
-    -> bool {
+auto MovementSystem::enqueue_pending_path_request(
+    Engine::Core::EntityID entity_id,
+    const Engine::Core::TransformComponent& transform,
+    const Engine::Core::MovementComponent& movement,
+    const QVector3D& target,
+    bool precise_arrival,
+    std::uint64_t navigation_revision) -> bool {
   cancel_pending_path_request(entity_id);
   if (m_pending_path_requests.size() >= k_max_pending_path_requests) {
     return false;
   }
-  m_pending_path_requests.push_back(
-      {entity_id, target, navigation_revision, precise_arrival});
+  Point const start =
+      NavGrid::world_to_grid(transform.position.x, transform.position.z);
+  PathRequest const request{
+      .start = start,
+      .goal = NavGrid::world_to_grid(target.x(), target.z()),
+      .passability = passability_for(movement),
+      .clearance_radius = movement.get_navigation_clearance()};
+  m_pending_path_requests.push_back({entity_id,
+                                     target,
+                                     m_path_requests.submit(request),
+                                     navigation_revision,
+                                     precise_arrival});
   return true;
 }
 
 void MovementSystem::cancel_pending_path_request(Engine::Core::EntityID entity_id) {
-  std::erase_if(m_pending_path_requests, [entity_id](auto const& request) {
-    return request.entity_id == entity_id;
+  std::erase_if(m_pending_path_requests, [this, entity_id](auto const& request) {
+    if (request.entity_id != entity_id) {
+      return false;
+    }
+    m_path_requests.cancel(request.ticket);
+    return true;
   });
 }
 
+auto MovementSystem::route_corridor(const Pathfinding& pathfinder,
+                                    const Engine::Core::TransformComponent& transform,
+                                    const Engine::Core::MovementComponent& movement)
+    -> CellRange {
+  Point const here =
+      pathfinder.world_to_grid(transform.position.x, transform.position.z);
+  CellRange corridor{here.x, here.x, here.y, here.y};
+  auto include = [&pathfinder, &corridor](float world_x, float world_z) {
+    Point const cell = pathfinder.world_to_grid(world_x, world_z);
+    corridor.min_x = std::min(corridor.min_x, cell.x);
+    corridor.max_x = std::max(corridor.max_x, cell.x);
+    corridor.min_z = std::min(corridor.min_z, cell.y);
+    corridor.max_z = std::max(corridor.max_z, cell.y);
+  };
+  auto const& path = movement.get_path();
+  for (std::size_t i = movement.get_path_index(); i < path.size(); ++i) {
+    include(path[i].first, path[i].second);
+  }
+  include(movement.get_goal_x(), movement.get_goal_y());
+  if (movement.get_has_requested_goal()) {
+    include(movement.get_requested_goal_x(), movement.get_requested_goal_z());
+  }
+
+  int const pad =
+      1 + static_cast<int>(std::ceil(movement.get_navigation_clearance() /
+                                     std::max(pathfinder.grid_cell_size(), 0.01F)));
+  corridor.min_x -= pad;
+  corridor.max_x += pad;
+  corridor.min_z -= pad;
+  corridor.max_z += pad;
+  return corridor;
+}
+
 void MovementSystem::repath_after_obstruction_release(
-    Engine::Core::World& world, const std::vector<Engine::Core::Entity*>& movers) {
+    Engine::Core::World& world,
+    const Pathfinding& pathfinder,
+    const std::vector<Engine::Core::Entity*>& movers,
+    const std::vector<DirtyRegion>* changed) {
+  if (changed != nullptr && changed->empty()) {
+    return;
+  }
   for (auto* entity : movers) {
     if (entity == nullptr ||
         entity->has_component<Engine::Core::PendingRemovalComponent>()) {
@@ -476,6 +567,24 @@ void MovementSystem::repath_after_obstruction_release(
       continue;
     }
 
+    if (changed != nullptr) {
+      auto const* transform = entity->get_component<Engine::Core::TransformComponent>();
+      if (transform == nullptr) {
+        continue;
+      }
+      // The box spans the whole remaining route, so it also covers an
+      // obstacle the route detours around and that a release could open up.
+      CellRange const corridor = route_corridor(pathfinder, *transform, *movement);
+      bool const crosses_change = std::any_of(
+          changed->begin(), changed->end(), [&corridor](auto const& region) {
+            return region.min_x <= corridor.max_x && region.max_x >= corridor.min_x &&
+                   region.min_z <= corridor.max_z && region.max_z >= corridor.min_z;
+          });
+      if (!crosses_change) {
+        continue;
+      }
+    }
+
     QVector3D const goal =
         movement->get_has_requested_goal()
             ? QVector3D(movement->get_requested_goal_x(),
@@ -658,7 +767,7 @@ void MovementSystem::move_unit(Engine::Core::Entity* entity,
         commander != nullptr && commander->fpv_controlled && !commander->jump_active) {
       movement->has_target = false;
       movement->clear_path();
-      OrderService::clear_player_order_intent(entity);
+      drop_player_order_intent(*world, *entity);
       movement->vx = 0.0F;
       movement->vz = 0.0F;
     }
@@ -675,7 +784,7 @@ void MovementSystem::move_unit(Engine::Core::Entity* entity,
     if (hold_mode->active) {
       movement->has_target = false;
       movement->clear_path();
-      OrderService::clear_player_order_intent(entity);
+      drop_player_order_intent(*world, *entity);
       movement->vx = 0.0F;
       movement->vz = 0.0F;
       in_hold_mode = true;
@@ -715,7 +824,7 @@ void MovementSystem::move_unit(Engine::Core::Entity* entity,
   if ((atk != nullptr) && atk->in_melee_lock &&
       CombatRules::participates_in_rts_melee_lock(entity)) {
     movement->has_target = false;
-    OrderService::clear_player_order_intent(entity);
+    drop_player_order_intent(*world, *entity);
     movement->vx = 0.0F;
     movement->vz = 0.0F;
     movement->clear_path();
@@ -750,7 +859,7 @@ void MovementSystem::move_unit(Engine::Core::Entity* entity,
         movement->stuck_timer += delta_time;
         if (movement->stuck_timer >= k_stuck_timeout_seconds) {
           movement->stop();
-          OrderService::clear_player_order_intent(entity);
+          drop_player_order_intent(*world, *entity);
           movement->stuck_ref_valid = false;
           return;
         }
@@ -780,7 +889,7 @@ void MovementSystem::move_unit(Engine::Core::Entity* entity,
       movement->vz = 0.0F;
       movement->has_target = false;
       movement->clear_path();
-      OrderService::clear_player_order_intent(entity);
+      drop_player_order_intent(*world, *entity);
     } else {
 
       float const nx = dx / dist;
@@ -885,7 +994,7 @@ void MovementSystem::move_unit(Engine::Core::Entity* entity,
       }
 
       movement->stop();
-      OrderService::clear_player_order_intent(entity);
+      drop_player_order_intent(*world, *entity);
 
       auto* guard_mode = entity->get_component<Engine::Core::GuardModeComponent>();
       if ((guard_mode != nullptr) && guard_mode->active &&
@@ -999,17 +1108,18 @@ auto MovementSystem::access() const -> Engine::Core::SystemAccess {
   return SystemAccess::declare(Reads<UnitComponent,
                                      BuildingComponent,
                                      CommanderComponent,
-                                     GuardModeComponent,
-                                     HoldModeComponent,
                                      ElephantComponent,
                                      RpgCommanderActionComponent,
-                                     BuilderProductionComponent,
+                                     PlayerOrderIntentComponent,
                                      PendingRemovalComponent>{},
                                Writes<MovementComponent,
                                       TransformComponent,
                                       AttackComponent,
                                       StaminaComponent,
-                                      TerrainContextComponent>{});
+                                      TerrainContextComponent,
+                                      GuardModeComponent,
+                                      HoldModeComponent,
+                                      BuilderProductionComponent>{});
 }
 
 } // namespace Game::Systems
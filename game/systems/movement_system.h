@@ -10,6 +10,7 @@
 #include "../core/system.h"
 #include "../core/world.h"
 #include "command_service.h"
+#include "path_request_service.h"
 
 namespace Engine::Core {
 class Entity;
@@ -26,6 +27,9 @@ public:
 
   [[nodiscard]] auto access() const -> Engine::Core::SystemAccess override;
 
+  [[nodiscard]] static auto passability_for(
+      const Engine::Core::MovementComponent& movement) -> Pathfinding::Passability;
+
 private:
   friend class CommandService;
 
@@ -49,11 +53,22 @@ private:
                            Engine::Core::AttackComponent& attack,
                            float delta_time) const -> bool;
 
+  static void apply_navigation_path(Pathfinding& pathfinder,
+                                    const Engine::Core::TransformComponent& transform,
+                                    Engine::Core::MovementComponent& movement,
+                                    const QVector3D& requested_target,
+                                    const Point& start,
+                                    const std::vector<Point>& path);
+
+  // `resolved_path`, when given, was solved for this goal by a deferred
+  // request; it stands in for the search once the mover's current cell is
+  // joined onto it.
   static void
   assign_navigation_target(Pathfinding* pathfinder,
                            const Engine::Core::TransformComponent& transform,
                            Engine::Core::MovementComponent& movement,
-                           const QVector3D& requested_target);
+                           const QVector3D& requested_target,
+                           const std::vector<Point>* resolved_path = nullptr);
 
   static void issue_move(Engine::Core::World& world,
                          Engine::Core::EntityID unit_id,
@@ -78,27 +93,41 @@ private:
   void
   move_unit(Engine::Core::Entity* entity, Engine::Core::World* world, float delta_time);
 
+  // Repaths the movers whose route corridor overlaps one of `changed`; every
+  // mover when `changed` is null.
   void
   repath_after_obstruction_release(Engine::Core::World& world,
-                                   const std::vector<Engine::Core::Entity*>& movers);
+                                   const Pathfinding& pathfinder,
+                                   const std::vector<Engine::Core::Entity*>& movers,
+                                   const std::vector<DirtyRegion>* changed);
+  static auto route_corridor(const Pathfinding& pathfinder,
+                             const Engine::Core::TransformComponent& transform,
+                             const Engine::Core::MovementComponent& movement)
+      -> CellRange;
 
   std::uint64_t m_obstruction_revision{0};
+  std::uint64_t m_dirty_region_sequence{0};
+  std::vector<DirtyRegion> m_changed_regions;
 
   float m_duel_clock{0.0F};
   void process_pending_path_requests(Engine::Core::World& world);
   struct PendingPathRequest {
     Engine::Core::EntityID entity_id{0};
     QVector3D target;
+    PathTicket ticket{0};
     std::uint64_t navigation_revision{0};
     bool precise_arrival{false};
   };
 
   auto enqueue_pending_path_request(Engine::Core::EntityID entity_id,
+                                    const Engine::Core::TransformComponent& transform,
+                                    const Engine::Core::MovementComponent& movement,
                                     const QVector3D& target,
                                     bool precise_arrival,
                                     std::uint64_t navigation_revision) -> bool;
   void cancel_pending_path_request(Engine::Core::EntityID entity_id);
   std::deque<PendingPathRequest> m_pending_path_requests;
+  PathRequestService m_path_requests;
 
   static constexpr std::size_t k_path_requests_per_tick = 8U;
   static constexpr std::size_t k_max_pending_path_requests = 2048U;
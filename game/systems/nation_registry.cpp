@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -112,6 +113,7 @@ auto Nation::is_ranged_unit(Game::Units::TroopType unit_type) const -> bool {
 
 void NationRegistry::register_nation(Nation nation) {
 
+  m_shared_nations.erase(nation.id);
   auto it = m_nation_index.find(nation.id);
   if (it != m_nation_index.end()) {
 
@@ -146,6 +148,20 @@ auto NationRegistry::get_nation_for_player(int player_id) const -> const Nation*
   return nation;
 }
 
+auto NationRegistry::shared_nation_for_player(int player_id) const
+    -> std::shared_ptr<const Nation> {
+  const auto assigned = m_player_nations.find(player_id);
+  const NationID nation_id =
+      assigned != m_player_nations.end() ? assigned->second : m_default_nation;
+  auto& shared = m_shared_nations[nation_id];
+  if (shared == nullptr) {
+    if (const auto* nation = get_nation(nation_id)) {
+      shared = std::make_shared<const Nation>(*nation);
+    }
+  }
+  return shared;
+}
+
 void NationRegistry::set_player_nation(int player_id, NationID nation_id) {
   m_player_nations[player_id] = nation_id;
 }
@@ -222,6 +238,7 @@ void NationRegistry::register_default_nations() {
 void NationRegistry::clear() {
   m_nations.clear();
   m_nation_index.clear();
+  m_shared_nations.clear();
   m_player_nations.clear();
   m_initialized = false;
 }
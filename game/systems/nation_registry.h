@@ -126,6 +126,9 @@ public:
 
   auto get_nation_for_player(int player_id) const -> const Nation*;
 
+  [[nodiscard]] auto
+  shared_nation_for_player(int player_id) const -> std::shared_ptr<const Nation>;
+
   void set_player_nation(int player_id, NationID nation_id);
 
   [[nodiscard]] auto
@@ -147,6 +150,7 @@ private:
   std::vector<Nation> m_nations;
   std::unordered_map<NationID, size_t> m_nation_index;
   std::unordered_map<int, NationID> m_player_nations;
+  mutable std::unordered_map<NationID, std::shared_ptr<const Nation>> m_shared_nations;
   NationID m_default_nation = NationID::RomanRepublic;
   bool m_initialized = false;
 };
@@ -0,0 +1,603 @@
+#include "navigation_hierarchy.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+namespace Game::Systems {
+
+namespace {
+
+constexpr int k_unreached = std::numeric_limits<int>::max();
+constexpr int k_wide_entrance = 6;
+constexpr int k_start_parent = -2;
+constexpr int k_goal_key = -1;
+
+struct LocalOpen {
+  int cost;
+  int index;
+};
+
+auto local_open_after(const LocalOpen& lhs, const LocalOpen& rhs) -> bool {
+  if (lhs.cost != rhs.cost) {
+    return lhs.cost > rhs.cost;
+  }
+  return lhs.index > rhs.index;
+}
+
+struct AbstractOpen {
+  int f_cost;
+  int g_cost;
+  int key;
+};
+
+auto abstract_open_after(const AbstractOpen& lhs, const AbstractOpen& rhs) -> bool {
+  if (lhs.f_cost != rhs.f_cost) {
+    return lhs.f_cost > rhs.f_cost;
+  }
+  if (lhs.g_cost != rhs.g_cost) {
+    return lhs.g_cost > rhs.g_cost;
+  }
+  return lhs.key > rhs.key;
+}
+
+auto in_range(const CellRange& range, int x, int z) -> bool {
+  return x >= range.min_x && x <= range.max_x && z >= range.min_z && z <= range.max_z;
+}
+
+} // namespace
+
+NavigationHierarchy::NavigationHierarchy(int width, int height, int cluster_size)
+    : m_width(std::max(width, 0))
+    , m_height(std::max(height, 0))
+    , m_cluster_size(std::max(cluster_size, 4))
+    , m_columns((m_width + m_cluster_size - 1) / m_cluster_size)
+    , m_rows((m_height + m_cluster_size - 1) / m_cluster_size) {
+  auto const cluster_count =
+      static_cast<std::size_t>(m_columns) * static_cast<std::size_t>(m_rows);
+  for (Layer& target : m_layers) {
+    target.clusters.resize(cluster_count);
+    target.dirty.assign(cluster_count, 1);
+  }
+}
+
+auto NavigationHierarchy::layer(Pathfinding::Passability passability) -> Layer& {
+  return m_layers[static_cast<std::size_t>(passability)];
+}
+
+auto NavigationHierarchy::layer(Pathfinding::Passability passability) const
+    -> const Layer& {
+  return m_layers[static_cast<std::size_t>(passability)];
+}
+
+void NavigationHierarchy::mark_dirty(int min_x, int max_x, int min_z, int max_z) {
+  min_x = std::max(0, min_x);
+  max_x = std::min(m_width - 1, max_x);
+  min_z = std::max(0, min_z);
+  max_z = std::min(m_height - 1, max_z);
+  if (min_x > max_x || min_z > max_z) {
+    return;
+  }
+
+  int const first_column = min_x / m_cluster_size;
+  int const last_column = max_x / m_cluster_size;
+  int const first_row = min_z / m_cluster_size;
+  int const last_row = max_z / m_cluster_size;
+  for (Layer& target : m_layers) {
+    for (int row = first_row; row <= last_row; ++row) {
+      for (int column = first_column; column <= last_column; ++column) {
+        target.dirty[static_cast<std::size_t>((row * m_columns) + column)] = 1;
+      }
+    }
+    target.stale.store(true, std::memory_order_release);
+  }
+}
+
+void NavigationHierarchy::mark_all_dirty() {
+  for (Layer& target : m_layers) {
+    std::fill(target.dirty.begin(), target.dirty.end(), std::uint8_t{1});
+    target.stale.store(true, std::memory_order_release);
+  }
+}
+
+auto NavigationHierarchy::needs_refresh(Pathfinding::Passability passability) const
+    -> bool {
+  return layer(passability).stale.load(std::memory_order_acquire);
+}
+
+auto NavigationHierarchy::spans_clusters(const Point& start,
+                                         const Point& goal) const -> bool {
+  int const reach = std::max(std::abs(goal.x - start.x), std::abs(goal.y - start.y));
+  return reach > 2 * m_cluster_size;
+}
+
+auto NavigationHierarchy::cluster_index(const Point& cell) const -> int {
+  return ((cell.y / m_cluster_size) * m_columns) + (cell.x / m_cluster_size);
+}
+
+auto NavigationHierarchy::cluster_bounds(int index) const -> CellRange {
+  int const column = index % m_columns;
+  int const row = index / m_columns;
+  return {.min_x = column * m_cluster_size,
+          .max_x = std::min(m_width - 1, ((column + 1) * m_cluster_size) - 1),
+          .min_z = row * m_cluster_size,
+          .max_z = std::min(m_height - 1, ((row + 1) * m_cluster_size) - 1)};
+}
+
+auto NavigationHierarchy::portal_index(const Cluster& cluster, const Point& cell)
+    -> int {
+  auto const it = std::find(cluster.portals.begin(), cluster.portals.end(), cell);
+  return it == cluster.portals.end()
+             ? -1
+             : static_cast<int>(std::distance(cluster.portals.begin(), it));
+}
+
+void NavigationHierarchy::collect_entrances(const Pathfinding& grid,
+                                            Pathfinding::Passability passability,
+                                            int index,
+                                            bool east,
+                                            std::vector<Entrance>& out) const {
+  out.clear();
+  CellRange const bounds = cluster_bounds(index);
+  int const border = east ? bounds.max_x : bounds.max_z;
+  if (border + 1 >= (east ? m_width : m_height)) {
+    return;
+  }
+  int const first = east ? bounds.min_z : bounds.min_x;
+  int const last = east ? bounds.max_z : bounds.max_x;
+
+  auto const cell_at = [east, border](int along, int offset) -> Point {
+    return east ? Point{border + offset, along} : Point{along, border + offset};
+  };
+  auto const flush = [&out, &cell_at](int run_first, int run_last) {
+    int const length = run_last - run_first + 1;
+    if (length < k_wide_entrance) {
+      int const middle = run_first + ((length - 1) / 2);
+      out.push_back({cell_at(middle, 0), cell_at(middle, 1)});
+      return;
+    }
+    out.push_back({cell_at(run_first, 0), cell_at(run_first, 1)});
+    out.push_back({cell_at(run_last, 0), cell_at(run_last, 1)});
+  };
+
+  int run_first = -1;
+  for (int along = first; along <= last; ++along) {
+    Point const inside = cell_at(along, 0);
+    Point const outside = cell_at(along, 1);
+    bool const open = grid.is_walkable(inside.x, inside.y, passability) &&
+                      grid.is_walkable(outside.x, outside.y, passability);
+    if (open && run_first < 0) {
+      run_first = along;
+    } else if (!open && run_first >= 0) {
+      flush(run_first, along - 1);
+      run_first = -1;
+    }
+  }
+  if (run_first >= 0) {
+    flush(run_first, last);
+  }
+}
+
+void NavigationHierarchy::rebuild_portals(const Pathfinding& grid,
+                                          Pathfinding::Passability passability,
+                                          Layer& target,
+                                          int index) const {
+  Cluster& cluster = target.clusters[static_cast<std::size_t>(index)];
+  cluster.portals.clear();
+  cluster.links.clear();
+
+  auto const add_link = [&grid, &cluster](const Point& cell, const Point& partner) {
+    int slot = portal_index(cluster, cell);
+    if (slot < 0) {
+      slot = static_cast<int>(cluster.portals.size());
+      cluster.portals.push_back(cell);
+      cluster.links.emplace_back();
+    }
+    cluster.links[static_cast<std::size_t>(slot)].push_back(
+        {partner,
+         Pathfinding::k_straight_step_cost +
+             grid.clearance_penalty(partner.x, partner.y)});
+  };
+
+  for (Entrance const& entrance : cluster.east) {
+    add_link(entrance.inside, entrance.outside);
+  }
+  for (Entrance const& entrance : cluster.south) {
+    add_link(entrance.inside, entrance.outside);
+  }
+  if (index % m_columns > 0) {
+    for (Entrance const& entrance :
+         target.clusters[static_cast<std::size_t>(index - 1)].east) {
+      add_link(entrance.outside, entrance.inside);
+    }
+  }
+  if (index >= m_columns) {
+    for (Entrance const& entrance :
+         target.clusters[static_cast<std::size_t>(index - m_columns)].south) {
+      add_link(entrance.outside, entrance.inside);
+    }
+  }
+
+  std::size_t const count = cluster.portals.size();
+  cluster.costs.assign(count * count, -1);
+  CellRange const bounds = cluster_bounds(index);
+  bool open_field = true;
+  for (int z = bounds.min_z; z <= bounds.max_z && open_field; ++z) {
+    for (int x = bounds.min_x; x <= bounds.max_x; ++x) {
+      if (!grid.is_walkable(x, z, passability) || grid.clearance_penalty(x, z) != 0) {
+        open_field = false;
+        break;
+      }
+    }
+  }
+  if (open_field) {
+    for (std::size_t from = 0; from < count; ++from) {
+      for (std::size_t to = 0; to < count; ++to) {
+        Point const& a = cluster.portals[from];
+        Point const& b = cluster.portals[to];
+        int const dx = std::abs(a.x - b.x);
+        int const dz = std::abs(a.y - b.y);
+        int const diagonal = std::min(dx, dz);
+        cluster.costs[(from * count) + to] =
+            (diagonal * Pathfinding::k_diagonal_step_cost) +
+            ((std::max(dx, dz) - diagonal) * Pathfinding::k_straight_step_cost);
+      }
+    }
+    return;
+  }
+
+  LocalSearch search;
+  for (std::size_t from = 0; from < count; ++from) {
+    search_cluster(grid, passability, 1, bounds, cluster.portals[from], search);
+    for (std::size_t to = 0; to < count; ++to) {
+      int const cost = local_cost(search, cluster.portals[to]);
+      cluster.costs[(from * count) + to] = cost == k_unreached ? -1 : cost;
+    }
+  }
+}
+
+void NavigationHierarchy::refresh(const Pathfinding& grid,
+                                  Pathfinding::Passability passability) {
+  Layer& target = layer(passability);
+  if (!target.stale.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  int const cluster_count = m_columns * m_rows;
+  for (int index = 0; index < cluster_count; ++index) {
+    if (target.dirty[static_cast<std::size_t>(index)] == 0) {
+      continue;
+    }
+    auto& cluster = target.clusters[static_cast<std::size_t>(index)];
+    collect_entrances(grid, passability, index, true, cluster.east);
+    collect_entrances(grid, passability, index, false, cluster.south);
+    if (index % m_columns > 0) {
+      collect_entrances(grid,
+                        passability,
+                        index - 1,
+                        true,
+                        target.clusters[static_cast<std::size_t>(index - 1)].east);
+    }
+    if (index >= m_columns) {
+      collect_entrances(
+          grid,
+          passability,
+          index - m_columns,
+          false,
+          target.clusters[static_cast<std::size_t>(index - m_columns)].south);
+    }
+  }
+
+  std::vector<std::uint8_t> affected(static_cast<std::size_t>(cluster_count), 0);
+  for (int index = 0; index < cluster_count; ++index) {
+    if (target.dirty[static_cast<std::size_t>(index)] == 0) {
+      continue;
+    }
+    affected[static_cast<std::size_t>(index)] = 1;
+    int const column = index % m_columns;
+    if (column > 0) {
+      affected[static_cast<std::size_t>(index - 1)] = 1;
+    }
+    if (column + 1 < m_columns) {
+      affected[static_cast<std::size_t>(index + 1)] = 1;
+    }
+    if (index >= m_columns) {
+      affected[static_cast<std::size_t>(index - m_columns)] = 1;
+    }
+    if (index + m_columns < cluster_count) {
+      affected[static_cast<std::size_t>(index + m_columns)] = 1;
+    }
+  }
+
+  for (int index = 0; index < cluster_count; ++index) {
+    if (affected[static_cast<std::size_t>(index)] != 0) {
+      rebuild_portals(grid, passability, target, index);
+      ++m_rebuilt_clusters;
+    }
+  }
+
+  std::fill(target.dirty.begin(), target.dirty.end(), std::uint8_t{0});
+  target.stale.store(false, std::memory_order_release);
+}
+
+void NavigationHierarchy::search_cluster(const Pathfinding& grid,
+                                         Pathfinding::Passability passability,
+                                         int clearance_weight,
+                                         const CellRange& bounds,
+                                         const Point& origin,
+                                         LocalSearch& search) const {
+  int const span_x = bounds.max_x - bounds.min_x + 1;
+  int const span_z = bounds.max_z - bounds.min_z + 1;
+  auto const cell_count =
+      static_cast<std::size_t>(span_x) * static_cast<std::size_t>(span_z);
+  search.bounds = bounds;
+  search.cost.assign(cell_count, k_unreached);
+  search.parent.assign(cell_count, -1);
+  if (!in_range(bounds, origin.x, origin.y) ||
+      !grid.is_walkable(origin.x, origin.y, passability)) {
+    return;
+  }
+
+  auto const local = [&bounds, span_x](int x, int z) -> int {
+    return ((z - bounds.min_z) * span_x) + (x - bounds.min_x);
+  };
+
+  thread_local std::vector<LocalOpen> open;
+  open.clear();
+  int const origin_index = local(origin.x, origin.y);
+  search.cost[static_cast<std::size_t>(origin_index)] = 0;
+  open.push_back({0, origin_index});
+
+  while (!open.empty()) {
+    std::pop_heap(open.begin(), open.end(), local_open_after);
+    LocalOpen const current = open.back();
+    open.pop_back();
+    if (current.cost > search.cost[static_cast<std::size_t>(current.index)]) {
+      continue;
+    }
+    int const x = bounds.min_x + (current.index % span_x);
+    int const z = bounds.min_z + (current.index / span_x);
+    for (int dz = -1; dz <= 1; ++dz) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        if (dx == 0 && dz == 0) {
+          continue;
+        }
+        int const next_x = x + dx;
+        int const next_z = z + dz;
+        if (!in_range(bounds, next_x, next_z) ||
+            !grid.is_walkable(next_x, next_z, passability)) {
+          continue;
+        }
+        bool const diagonal = dx != 0 && dz != 0;
+        if (diagonal && (!grid.is_walkable(x + dx, z, passability) ||
+                         !grid.is_walkable(x, z + dz, passability))) {
+          continue;
+        }
+        int const step =
+            (diagonal ? Pathfinding::k_diagonal_step_cost
+                      : Pathfinding::k_straight_step_cost) +
+            (grid.clearance_penalty(next_x, next_z) * clearance_weight);
+        int const next_index = local(next_x, next_z);
+        int const next_cost = current.cost + step;
+        if (next_cost >= search.cost[static_cast<std::size_t>(next_index)]) {
+          continue;
+        }
+        search.cost[static_cast<std::size_t>(next_index)] = next_cost;
+        search.parent[static_cast<std::size_t>(next_index)] = current.index;
+        open.push_back({next_cost, next_index});
+        std::push_heap(open.begin(), open.end(), local_open_after);
+      }
+    }
+  }
+}
+
+auto NavigationHierarchy::local_cost(const LocalSearch& search,
+                                     const Point& cell) -> int {
+  if (!in_range(search.bounds, cell.x, cell.y)) {
+    return k_unreached;
+  }
+  int const span_x = search.bounds.max_x - search.bounds.min_x + 1;
+  auto const index = static_cast<std::size_t>(
+      ((cell.y - search.bounds.min_z) * span_x) + (cell.x - search.bounds.min_x));
+  return search.cost[index];
+}
+
+auto NavigationHierarchy::trace_local(const LocalSearch& search,
+                                      const Point& cell,
+                                      std::vector<Point>& reversed) -> bool {
+  if (local_cost(search, cell) == k_unreached) {
+    return false;
+  }
+  int const span_x = search.bounds.max_x - search.bounds.min_x + 1;
+  int index =
+      ((cell.y - search.bounds.min_z) * span_x) + (cell.x - search.bounds.min_x);
+  while (index >= 0) {
+    reversed.push_back({search.bounds.min_x + (index % span_x),
+                        search.bounds.min_z + (index / span_x)});
+    index = search.parent[static_cast<std::size_t>(index)];
+  }
+  return true;
+}
+
+auto NavigationHierarchy::find_path(const Pathfinding& grid,
+                                    const Point& start,
+                                    const Point& goal,
+                                    Pathfinding::Passability passability,
+                                    int clearance_weight) const
+    -> std::optional<std::vector<Point>> {
+  Layer const& source = layer(passability);
+  if (source.stale.load(std::memory_order_acquire) ||
+      !in_range({0, m_width - 1, 0, m_height - 1}, start.x, start.y) ||
+      !in_range({0, m_width - 1, 0, m_height - 1}, goal.x, goal.y)) {
+    return std::nullopt;
+  }
+  int const start_cluster = cluster_index(start);
+  int const goal_cluster = cluster_index(goal);
+  if (start_cluster == goal_cluster) {
+    return std::nullopt;
+  }
+
+  thread_local LocalSearch from_start;
+  thread_local LocalSearch from_goal;
+  thread_local LocalSearch leg;
+  search_cluster(grid,
+                 passability,
+                 clearance_weight,
+                 cluster_bounds(start_cluster),
+                 start,
+                 from_start);
+  search_cluster(grid,
+                 passability,
+                 clearance_weight,
+                 cluster_bounds(goal_cluster),
+                 goal,
+                 from_goal);
+
+  struct Node {
+    int g_cost;
+    int parent;
+    int cluster;
+    int portal;
+    bool closed;
+  };
+  std::unordered_map<int, Node> nodes;
+  std::vector<AbstractOpen> open;
+  auto const key_of = [this](const Point& cell) {
+    return (cell.y * m_width) + cell.x;
+  };
+  auto const relax = [&](const Point& cell,
+                         int cluster,
+                         int portal,
+                         int g_cost,
+                         int parent) {
+    auto [it, inserted] = nodes.try_emplace(
+        key_of(cell), Node{k_unreached, -1, cluster, portal, false});
+    if (it->second.closed || g_cost >= it->second.g_cost) {
+      return;
+    }
+    it->second.g_cost = g_cost;
+    it->second.parent = parent;
+    open.push_back(
+        {g_cost + Pathfinding::calculate_heuristic(cell, goal), g_cost, key_of(cell)});
+    std::push_heap(open.begin(), open.end(), abstract_open_after);
+  };
+
+  Cluster const& first = source.clusters[static_cast<std::size_t>(start_cluster)];
+  for (std::size_t portal = 0; portal < first.portals.size(); ++portal) {
+    int const cost = local_cost(from_start, first.portals[portal]);
+    if (cost != k_unreached) {
+      relax(first.portals[portal],
+            start_cluster,
+            static_cast<int>(portal),
+            cost,
+            k_start_parent);
+    }
+  }
+
+  int goal_cost = k_unreached;
+  int goal_parent = -1;
+  while (!open.empty()) {
+    std::pop_heap(open.begin(), open.end(), abstract_open_after);
+    AbstractOpen const current = open.back();
+    open.pop_back();
+    if (current.key == k_goal_key) {
+      if (current.g_cost == goal_cost) {
+        break;
+      }
+      continue;
+    }
+    Node& node = nodes.at(current.key);
+    if (node.closed || current.g_cost > node.g_cost) {
+      continue;
+    }
+    node.closed = true;
+
+    Cluster const& cluster = source.clusters[static_cast<std::size_t>(node.cluster)];
+    auto const portal = static_cast<std::size_t>(node.portal);
+    Point const cell = cluster.portals[portal];
+    if (node.cluster == goal_cluster) {
+      int const exit_cost = local_cost(from_goal, cell);
+      if (exit_cost != k_unreached && node.g_cost + exit_cost < goal_cost) {
+        goal_cost = node.g_cost + exit_cost;
+        goal_parent = current.key;
+        open.push_back({goal_cost, goal_cost, k_goal_key});
+        std::push_heap(open.begin(), open.end(), abstract_open_after);
+      }
+    }
+
+    std::size_t const count = cluster.portals.size();
+    int const g_cost = node.g_cost;
+    int const cluster_id = node.cluster;
+    for (std::size_t next = 0; next < count; ++next) {
+      int const cost = cluster.costs[(portal * count) + next];
+      if (next != portal && cost >= 0) {
+        relax(cluster.portals[next],
+              cluster_id,
+              static_cast<int>(next),
+              g_cost + cost,
+              current.key);
+      }
+    }
+    for (Link const& link : cluster.links[portal]) {
+      int const neighbour = cluster_index(link.cell);
+      int const slot =
+          portal_index(source.clusters[static_cast<std::size_t>(neighbour)], link.cell);
+      if (slot >= 0) {
+        relax(link.cell, neighbour, slot, g_cost + link.cost, current.key);
+      }
+    }
+  }
+  if (goal_parent < 0) {
+    return std::nullopt;
+  }
+
+  std::vector<Point> chain;
+  for (int key = goal_parent; key != k_start_parent; key = nodes.at(key).parent) {
+    chain.push_back({key % m_width, key / m_width});
+  }
+  std::reverse(chain.begin(), chain.end());
+
+  std::vector<Point> path;
+  std::vector<Point> reversed;
+  if (!trace_local(from_start, chain.front(), reversed)) {
+    return std::nullopt;
+  }
+  path.assign(reversed.rbegin(), reversed.rend());
+
+  for (std::size_t step = 1; step < chain.size(); ++step) {
+    Point const& from = chain[step - 1];
+    Point const& to = chain[step];
+    int const cluster = cluster_index(from);
+    if (cluster != cluster_index(to)) {
+      path.push_back(to);
+      continue;
+    }
+    search_cluster(
+        grid, passability, clearance_weight, cluster_bounds(cluster), from, leg);
+    reversed.clear();
+    if (!trace_local(leg, to, reversed)) {
+      return std::nullopt;
+    }
+    path.insert(path.end(), std::next(reversed.rbegin()), reversed.rend());
+  }
+
+  reversed.clear();
+  if (!trace_local(from_goal, chain.back(), reversed)) {
+    return std::nullopt;
+  }
+  path.insert(path.end(), std::next(reversed.begin()), reversed.end());
+  return path;
+}
+
+auto NavigationHierarchy::portal_count(Pathfinding::Passability passability) const
+    -> std::size_t {
+  std::size_t total = 0;
+  for (Cluster const& cluster : layer(passability).clusters) {
+    total += cluster.portals.size();
+  }
+  return total;
+}
+
+} // namespace Game::Systems
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "nav_grid_types.h"
+#include "pathfinding.h"
+
+namespace Game::Systems {
+
+class NavigationHierarchy {
+public:
+  static constexpr int k_default_cluster_size = 16;
+
+  NavigationHierarchy(int width, int height, int cluster_size = k_default_cluster_size);
+
+  NavigationHierarchy(const NavigationHierarchy&) = delete;
+  NavigationHierarchy(NavigationHierarchy&&) = delete;
+  auto operator=(const NavigationHierarchy&) -> NavigationHierarchy& = delete;
+  auto operator=(NavigationHierarchy&&) -> NavigationHierarchy& = delete;
+
+  [[nodiscard]] auto cluster_size() const noexcept -> int { return m_cluster_size; }
+  [[nodiscard]] auto cluster_columns() const noexcept -> int { return m_columns; }
+  [[nodiscard]] auto cluster_rows() const noexcept -> int { return m_rows; }
+
+  void mark_dirty(int min_x, int max_x, int min_z, int max_z);
+  void mark_all_dirty();
+
+  [[nodiscard]] auto needs_refresh(Pathfinding::Passability passability) const -> bool;
+  void refresh(const Pathfinding& grid, Pathfinding::Passability passability);
+
+  [[nodiscard]] auto spans_clusters(const Point& start, const Point& goal) const
+      -> bool;
+
+  [[nodiscard]] auto find_path(const Pathfinding& grid,
+                               const Point& start,
+                               const Point& goal,
+                               Pathfinding::Passability passability,
+                               int clearance_weight) const
+      -> std::optional<std::vector<Point>>;
+
+  [[nodiscard]] auto portal_count(Pathfinding::Passability passability) const
+      -> std::size_t;
+  [[nodiscard]] auto rebuilt_clusters() const noexcept -> std::uint64_t {
+    return m_rebuilt_clusters;
+  }
+
+private:
+  struct Entrance {
+    Point inside;
+    Point outside;
+  };
+
+  struct Link {
+    Point cell;
+    int cost{0};
+  };
+
+  struct Cluster {
+    std::vector<Entrance> east;
+    std::vector<Entrance> south;
+    std::vector<Point> portals;
+    std::vector<std::vector<Link>> links;
+    std::vector<int> costs;
+  };
+
+  struct Layer {
+    std::vector<Cluster> clusters;
+    std::vector<std::uint8_t> dirty;
+    std::atomic<bool> stale{true};
+  };
+
+  struct LocalSearch {
+    CellRange bounds;
+    std::vector<int> cost;
+    std::vector<int> parent;
+  };
+
+  [[nodiscard]] auto layer(Pathfinding::Passability passability) -> Layer&;
+  [[nodiscard]] auto layer(Pathfinding::Passability passability) const -> const Layer&;
+  [[nodiscard]] auto cluster_index(const Point& cell) const -> int;
+  [[nodiscard]] auto cluster_bounds(int index) const -> CellRange;
+  [[nodiscard]] static auto portal_index(const Cluster& cluster,
+                                         const Point& cell) -> int;
+
+  void collect_entrances(const Pathfinding& grid,
+                         Pathfinding::Passability passability,
+                         int index,
+                         bool east,
+                         std::vector<Entrance>& out) const;
+  void rebuild_portals(const Pathfinding& grid,
+                       Pathfinding::Passability passability,
+                       Layer& target,
+                       int index) const;
+
+  void search_cluster(const Pathfinding& grid,
+                      Pathfinding::Passability passability,
+                      int clearance_weight,
+                      const CellRange& bounds,
+                      const Point& origin,
+                      LocalSearch& search) const;
+  [[nodiscard]] static auto local_cost(const LocalSearch& search,
+                                       const Point& cell) -> int;
+  static auto trace_local(const LocalSearch& search,
+                          const Point& cell,
+                          std::vector<Point>& reversed) -> bool;
+
+  int m_width;
+  int m_height;
+  int m_cluster_size;
+  int m_columns;
+  int m_rows;
+  std::array<Layer, 2> m_layers;
+  std::uint64_t m_rebuilt_clusters{0};
+};
+
+} // namespace Game::Systems
@@ -0,0 +1,208 @@
+#include "path_request_service.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "../core/ambient_session.h"
+#include "../core/system_executor.h"
+
+namespace Game::Systems {
+
+namespace {
+
+auto clearance_quarters_of(float clearance_radius) -> int {
+  return static_cast<int>(std::ceil(std::max(0.0F, clearance_radius) * 4.0F));
+}
+
+auto floor_div(int value, int divisor) -> int {
+  int quotient = value / divisor;
+  if ((value % divisor != 0) && ((value < 0) != (divisor < 0))) {
+    --quotient;
+  }
+  return quotient;
+}
+
+} // namespace
+
+PathRequestService::PathRequestService(std::size_t worker_count)
+    : m_worker_count(worker_count) {}
+
+PathRequestService::~PathRequestService() = default;
+
+auto PathRequestService::default_worker_count() -> std::size_t {
+  std::size_t const hardware = std::thread::hardware_concurrency();
+  if (hardware <= 1U) {
+    return 0U;
+  }
+  return std::min(hardware - 1U, k_max_default_workers);
+}
+
+void PathRequestService::set_worker_count(std::size_t worker_count) {
+  if (worker_count == m_worker_count) {
+    return;
+  }
+  m_worker_count = worker_count;
+  m_executor.reset();
+}
+
+void PathRequestService::set_coalesce_span(int cells) {
+  m_coalesce_span = std::max(1, cells);
+}
+
+auto PathRequestService::submit(const PathRequest& request) -> PathTicket {
+  PathTicket const ticket = m_next_ticket++;
+  m_pending.push_back({ticket, request});
+  ++m_stats.submitted;
+  return ticket;
+}
+
+auto PathRequestService::cancel(PathTicket ticket) -> bool {
+  auto const it = std::lower_bound(m_pending.begin(),
+                                   m_pending.end(),
+                                   ticket,
+                                   [](const Pending& pending, PathTicket t) {
+                                     return pending.ticket < t;
+                                   });
+  if (it == m_pending.end() || it->ticket != ticket) {
+    return false;
+  }
+  m_pending.erase(it);
+  ++m_stats.cancelled;
+  return true;
+}
+
+auto PathRequestService::is_pending(PathTicket ticket) const -> bool {
+  return std::binary_search(m_pending.begin(),
+                            m_pending.end(),
+                            Pending{ticket, {}},
+                            [](const Pending& lhs, const Pending& rhs) {
+                              return lhs.ticket < rhs.ticket;
+                            });
+}
+
+auto PathRequestService::coalesce_key(const PathRequest& request) const
+    -> CoalesceKey {
+  return {request.goal.x,
+          request.goal.y,
+          floor_div(request.start.x, m_coalesce_span),
+          floor_div(request.start.y, m_coalesce_span),
+          request.passability,
+          clearance_quarters_of(request.clearance_radius)};
+}
+
+auto PathRequestService::CoalesceKeyHash::operator()(
+    const CoalesceKey& key) const noexcept -> std::size_t {
+  std::size_t result = std::hash<int>{}(key.goal_x);
+  auto combine = [&result](int value) {
+    result ^= std::hash<int>{}(value) + 0x9e3779b9U + (result << 6U) + (result >> 2U);
+  };
+  combine(key.goal_y);
+  combine(key.start_bucket_x);
+  combine(key.start_bucket_y);
+  combine(static_cast<int>(key.passability));
+  combine(key.clearance_quarters);
+  return result;
+}
+
+void PathRequestService::run_searches(Pathfinding& pathfinder,
+                                      std::vector<Search>& searches) {
+  if (searches.empty()) {
+    return;
+  }
+  m_stats.searches += searches.size();
+
+  const auto* ambient = Game::Session::ambient_services_or_null();
+  auto const solve = [this, &pathfinder, &searches, ambient](std::size_t index) {
+    const auto* previous = Game::Session::set_thread_ambient_services(ambient);
+    Search& search = searches[index];
+    PathRequest const& request = m_pending[search.leader].request;
+    search.path = pathfinder.find_path(request.start,
+                                       request.goal,
+                                       request.passability,
+                                       request.clearance_radius);
+    Game::Session::set_thread_ambient_services(previous);
+  };
+
+  if (m_worker_count == 0U || searches.size() < 2U) {
+    for (std::size_t index = 0; index < searches.size(); ++index) {
+      solve(index);
+    }
+    return;
+  }
+  if (m_executor == nullptr) {
+    m_executor = std::make_unique<Engine::Core::SystemExecutor>(m_worker_count);
+  }
+  m_executor->run(searches.size(), solve);
+}
+
+auto PathRequestService::resolve(Pathfinding& pathfinder) -> std::vector<PathResult> {
+  if (m_pending.empty()) {
+    return {};
+  }
+  ++m_stats.resolves;
+
+  pathfinder.update_navigation_grid();
+
+  std::vector<Search> searches;
+  std::unordered_map<CoalesceKey, std::size_t, CoalesceKeyHash> search_by_key;
+  search_by_key.reserve(m_pending.size());
+  for (std::size_t index = 0; index < m_pending.size(); ++index) {
+    auto const [it, inserted] = search_by_key.try_emplace(
+        coalesce_key(m_pending[index].request), searches.size());
+    if (inserted) {
+      searches.push_back({index, {}, {}});
+    } else {
+      searches[it->second].members.push_back(index);
+    }
+  }
+
+  run_searches(pathfinder, searches);
+
+  std::vector<PathResult> results(m_pending.size());
+  std::vector<Search> retries;
+  for (Search& search : searches) {
+    for (std::size_t const member : search.members) {
+      PathRequest const& request = m_pending[member].request;
+      PathRequest const& leader = m_pending[search.leader].request;
+      if (request.start == leader.start ||
+          (!search.path.empty() && request.start == search.path.front())) {
+        results[member].path = search.path;
+        results[member].coalesced = true;
+        continue;
+      }
+      if (!search.path.empty() &&
+          pathfinder.is_world_segment_walkable(
+              pathfinder.grid_to_world(request.start),
+              pathfinder.grid_to_world(search.path.front()),
+              request.passability,
+              request.clearance_radius)) {
+        auto& path = results[member].path;
+        path.reserve(search.path.size() + 1U);
+        path.push_back(request.start);
+        path.insert(path.end(), search.path.begin(), search.path.end());
+        results[member].coalesced = true;
+        continue;
+      }
+      retries.push_back({member, {}, {}});
+    }
+    results[search.leader].path = std::move(search.path);
+  }
+
+  run_searches(pathfinder, retries);
+  for (Search& retry : retries) {
+    results[retry.leader].path = std::move(retry.path);
+  }
+
+  for (std::size_t index = 0; index < m_pending.size(); ++index) {
+    results[index].ticket = m_pending[index].ticket;
+    m_stats.coalesced += results[index].coalesced ? 1U : 0U;
+  }
+  m_pending.clear();
+  return results;
+}
+
+} // namespace Game::Systems
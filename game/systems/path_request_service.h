@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "nav_grid_types.h"
+#include "pathfinding.h"
+
+namespace Engine::Core {
+class SystemExecutor;
+}
+
+namespace Game::Systems {
+
+using PathTicket = std::uint64_t;
+
+struct PathRequest {
+  Point start;
+  Point goal;
+  Pathfinding::Passability passability{Pathfinding::Passability::Light};
+  float clearance_radius{0.0F};
+};
+
+struct PathResult {
+  PathTicket ticket{0};
+  std::vector<Point> path;
+  bool coalesced{false};
+};
+
+class PathRequestService {
+public:
+  struct Stats {
+    std::uint64_t submitted{0};
+    std::uint64_t cancelled{0};
+    std::uint64_t searches{0};
+    std::uint64_t coalesced{0};
+    std::uint64_t resolves{0};
+  };
+
+  explicit PathRequestService(std::size_t worker_count = default_worker_count());
+  ~PathRequestService();
+
+  PathRequestService(const PathRequestService&) = delete;
+  PathRequestService(PathRequestService&&) = delete;
+  auto operator=(const PathRequestService&) -> PathRequestService& = delete;
+  auto operator=(PathRequestService&&) -> PathRequestService& = delete;
+
+  [[nodiscard]] static auto default_worker_count() -> std::size_t;
+
+  [[nodiscard]] auto worker_count() const noexcept -> std::size_t {
+    return m_worker_count;
+  }
+  void set_worker_count(std::size_t worker_count);
+
+  [[nodiscard]] auto coalesce_span() const noexcept -> int { return m_coalesce_span; }
+  void set_coalesce_span(int cells);
+
+  auto submit(const PathRequest& request) -> PathTicket;
+  auto cancel(PathTicket ticket) -> bool;
+
+  [[nodiscard]] auto is_pending(PathTicket ticket) const -> bool;
+  [[nodiscard]] auto pending_count() const noexcept -> std::size_t {
+    return m_pending.size();
+  }
+
+  auto resolve(Pathfinding& pathfinder) -> std::vector<PathResult>;
+
+  [[nodiscard]] auto stats() const noexcept -> const Stats& { return m_stats; }
+
+private:
+  struct Pending {
+    PathTicket ticket{0};
+    PathRequest request;
+  };
+
+  struct Search {
+    std::size_t leader{0};
+    std::vector<std::size_t> members;
+    std::vector<Point> path;
+  };
+
+  struct CoalesceKey {
+    int goal_x;
+    int goal_y;
+    int start_bucket_x;
+    int start_bucket_y;
+    Pathfinding::Passability passability;
+    int clearance_quarters;
+
+    auto operator==(const CoalesceKey&) const -> bool = default;
+  };
+
+  struct CoalesceKeyHash {
+    auto operator()(const CoalesceKey& key) const noexcept -> std::size_t;
+  };
+
+  [[nodiscard]] auto coalesce_key(const PathRequest& request) const -> CoalesceKey;
+  void run_searches(Pathfinding& pathfinder, std::vector<Search>& searches);
+
+  static constexpr std::size_t k_max_default_workers = 4U;
+
+  std::vector<Pending> m_pending;
+  std::unique_ptr<Engine::Core::SystemExecutor> m_executor;
+  std::size_t m_worker_count{0};
+  int m_coalesce_span{2};
+  PathTicket m_next_ticket{1};
+  Stats m_stats;
+};
+
+} // namespace Game::Systems
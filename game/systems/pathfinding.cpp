@@ -15,7 +15,9 @@
 
 #include "../map/terrain_service.h"
 #include "building_collision_registry.h"
+#include "flow_field.h"
 #include "map/terrain.h"
+#include "navigation_hierarchy.h"
 
 namespace Game::Systems {
 
@@ -120,8 +122,11 @@ void Pathfinding::NavigationGrid::set(int x, int y, CellValue value) {
 Pathfinding::Pathfinding(int width, int height)
     : m_width(width)
     , m_height(height)
-    , m_navigation_grid(width, height) {
+    , m_navigation_grid(width, height)
+    , m_hierarchy(std::make_unique<NavigationHierarchy>(width, height)) {
   m_navigation_grid_dirty.store(true, std::memory_order_release);
+  m_hierarchical_search.store(std::max(width, height) >= k_hierarchy_min_extent,
+                              std::memory_order_release);
 }
 
 Pathfinding::~Pathfinding() = default;
@@ -174,9 +179,31 @@ void Pathfinding::set_obstacle(int x, int y, bool is_obstacle) {
   m_navigation_grid.set(x, y, is_obstacle ? CellValue::Blocked : CellValue::Walkable);
 
   rebuild_clearance(x - 1, x + 1, y - 1, y + 1);
+  int const reach = k_clearance_radius + 2;
+  m_hierarchy->mark_dirty(x - reach, x + reach, y - reach, y + reach);
   m_navigation_revision.fetch_add(1, std::memory_order_release);
 }
 
+void Pathfinding::set_hierarchical_search(bool enabled) {
+  std::unique_lock<std::shared_mutex> const lock(m_navigation_mutex);
+  if (m_hierarchical_search.exchange(enabled, std::memory_order_acq_rel) != enabled) {
+    m_navigation_revision.fetch_add(1, std::memory_order_release);
+  }
+}
+
+auto Pathfinding::uses_hierarchy(const Point& start, const Point& end) const -> bool {
+  return m_hierarchical_search.load(std::memory_order_acquire) &&
+         m_hierarchy->spans_clusters(start, end);
+}
+
+void Pathfinding::refresh_hierarchy(Passability passability) {
+  if (!m_hierarchy->needs_refresh(passability)) {
+    return;
+  }
+  std::unique_lock<std::shared_mutex> const lock(m_navigation_mutex);
+  m_hierarchy->refresh(*this, passability);
+}
+
 auto Pathfinding::is_walkable(int x, int y, Passability passability) const -> bool {
   if (x < 0 || x >= m_width || y < 0 || y >= m_height) {
     return false;
@@ -343,6 +370,8 @@ auto Pathfinding::path_waypoint_world_position(const Point& path_cell) const
 void Pathfinding::mark_navigation_grid_dirty() {
   std::lock_guard<std::mutex> const lock(m_dirty_mutex);
   m_full_update_required = true;
+  m_region_log.clear();
+  m_region_log_base = ++m_region_log_end;
   m_navigation_grid_dirty.store(true, std::memory_order_release);
 }
 
@@ -359,6 +388,12 @@ void Pathfinding::mark_region_dirty(int min_x, int max_x, int min_z, int max_z)
 
   std::lock_guard<std::mutex> const lock(m_dirty_mutex);
   m_dirty_regions.emplace_back(min_x, max_x, min_z, max_z);
+  m_region_log.emplace_back(min_x, max_x, min_z, max_z);
+  ++m_region_log_end;
+  if (m_region_log.size() > k_max_logged_regions) {
+    m_region_log.pop_front();
+    ++m_region_log_base;
+  }
   m_navigation_grid_dirty.store(true, std::memory_order_release);
 }
 
@@ -390,6 +425,22 @@ auto Pathfinding::obstruction_revision() const -> std::uint64_t {
   return m_obstruction_revision.load(std::memory_order_acquire);
 }
 
+auto Pathfinding::dirty_region_sequence() const -> std::uint64_t {
+  std::lock_guard<std::mutex> const lock(m_dirty_mutex);
+  return m_region_log_end;
+}
+
+auto Pathfinding::dirty_regions_since(std::uint64_t sequence,
+                                      std::vector<DirtyRegion>& out) const -> bool {
+  std::lock_guard<std::mutex> const lock(m_dirty_mutex);
+  if (sequence < m_region_log_base || sequence > m_region_log_end) {
+    return false;
+  }
+  auto const first = static_cast<std::ptrdiff_t>(sequence - m_region_log_base);
+  out.insert(out.end(), m_region_log.begin() + first, m_region_log.end());
+  return true;
+}
+
 void Pathfinding::process_dirty_regions() {
   std::vector<DirtyRegion> regions_to_process;
 
@@ -457,6 +508,8 @@ void Pathfinding::update_region(int min_x, int max_x, int min_z, int max_z) {
   force_map_passage_cells_walkable(min_x, max_x, min_z, max_z);
 
   rebuild_clearance(min_x - 1, max_x + 1, min_z - 1, max_z + 1);
+  int const reach = k_clearance_radius + 2;
+  m_hierarchy->mark_dirty(min_x - reach, max_x + reach, min_z - reach, max_z + reach);
 }
 
 void Pathfinding::force_navigation_passages_walkable(int min_x,
@@ -818,6 +871,10 @@ auto Pathfinding::find_path(const Point& start,
     }
   }
 
+  if (uses_hierarchy(start, end)) {
+    refresh_hierarchy(passability);
+  }
+
   std::shared_lock<std::shared_mutex> const navigation_lock(m_navigation_mutex);
   auto path = find_path_internal(
       start, end, passability, static_cast<float>(clearance_quarters) * 0.25F);
@@ -847,6 +904,80 @@ auto Pathfinding::PathCacheKeyHash::operator()(const PathCacheKey& key) const no
   return result;
 }
 
+auto Pathfinding::flow_field(const Point& goal,
+                             Passability passability,
+                             float clearance_radius)
+    -> std::shared_ptr<const FlowField> {
+  return flow_field(
+      goal, passability, clearance_radius, CellRange{0, m_width - 1, 0, m_height - 1});
+}
+
+auto Pathfinding::flow_field(const Point& goal,
+                             Passability passability,
+                             float clearance_radius,
+                             const CellRange& window)
+    -> std::shared_ptr<const FlowField> {
+  if (m_navigation_grid_dirty.load(std::memory_order_acquire)) {
+    update_navigation_grid();
+  }
+
+  std::uint64_t const revision = navigation_revision();
+  int const clearance_quarters =
+      static_cast<int>(std::ceil(std::max(0.0F, clearance_radius) * 4.0F));
+  CellRange bounds{std::clamp(std::min(window.min_x, goal.x), 0, m_width - 1),
+                   std::clamp(std::max(window.max_x, goal.x), 0, m_width - 1),
+                   std::clamp(std::min(window.min_z, goal.y), 0, m_height - 1),
+                   std::clamp(std::max(window.max_z, goal.y), 0, m_height - 1)};
+  auto const same_key = [&](const std::shared_ptr<const FlowField>& field) {
+    return field->goal() == goal && field->passability() == passability &&
+           field->clearance_quarters() == clearance_quarters;
+  };
+  {
+    std::lock_guard<std::mutex> const cache_lock(m_flow_field_mutex);
+    std::erase_if(m_flow_fields,
+                  [revision](const std::shared_ptr<const FlowField>& field) {
+                    return field->navigation_revision() != revision;
+                  });
+    for (auto const& field : m_flow_fields) {
+      if (!same_key(field)) {
+        continue;
+      }
+      if (field->covers(bounds)) {
+        return field;
+      }
+      bounds.min_x = std::min(bounds.min_x, field->bounds().min_x);
+      bounds.max_x = std::max(bounds.max_x, field->bounds().max_x);
+      bounds.min_z = std::min(bounds.min_z, field->bounds().min_z);
+      bounds.max_z = std::max(bounds.max_z, field->bounds().max_z);
+    }
+  }
+
+  auto field = std::make_shared<FlowField>(
+      goal, passability, clearance_quarters, bounds, revision);
+  {
+    std::shared_lock<std::shared_mutex> const navigation_lock(m_navigation_mutex);
+    float const scaled_clearance =
+        static_cast<float>(clearance_quarters) * 0.25F * k_clearance_avoid_weight;
+    int const clearance_weight =
+        clearance_quarters > 0
+            ? std::max(1, static_cast<int>(std::lround(scaled_clearance)))
+            : 1;
+    field->build(*this, clearance_weight);
+  }
+  m_flow_field_builds.fetch_add(1, std::memory_order_relaxed);
+
+  std::lock_guard<std::mutex> const cache_lock(m_flow_field_mutex);
+  if (navigation_revision() != revision) {
+    return field;
+  }
+  std::erase_if(m_flow_fields, same_key);
+  if (m_flow_fields.size() >= k_max_cached_flow_fields) {
+    m_flow_fields.erase(m_flow_fields.begin());
+  }
+  m_flow_fields.push_back(field);
+  return field;
+}
+
 auto Pathfinding::find_path_internal(const Point& start,
                                      const Point& end,
                                      Passability passability,
@@ -892,6 +1023,14 @@ auto Pathfinding::find_path_internal(const Point& start,
     return {start};
   }
 
+  if (uses_hierarchy(start, end)) {
+    if (auto path = m_hierarchy->find_path(
+            *this, start, end, passability, clearance_weight);
+        path.has_value()) {
+      return std::move(*path);
+    }
+  }
+
   const std::uint32_t generation = next_generation(buffers);
 
   buffers.open_heap.clear();
@@ -5,6 +5,8 @@
 #include <array>
 #include <atomic>
 #include <cstdint>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
@@ -15,6 +17,8 @@
 namespace Game::Systems {
 
 class BuildingCollisionRegistry;
+class FlowField;
+class NavigationHierarchy;
 struct BuildingFootprint;
 
 class Pathfinding {
@@ -102,6 +106,16 @@ public:
 
   [[nodiscard]] auto obstruction_revision() const -> std::uint64_t;
 
+  // Each mark_region_dirty is also logged under a sequence number, so callers
+  // can ask which regions changed since they last looked. Only the newest
+  // k_max_logged_regions entries are kept.
+  static constexpr std::size_t k_max_logged_regions = 512U;
+  [[nodiscard]] auto dirty_region_sequence() const -> std::uint64_t;
+  // Appends the regions marked since `sequence` to `out`. Returns false when
+  // the log cannot tell: the whole grid changed or the entries were dropped.
+  auto dirty_regions_since(std::uint64_t sequence,
+                           std::vector<DirtyRegion>& out) const -> bool;
+
   auto find_path(const Point& start,
                  const Point& end,
                  Passability passability = Passability::Light,
@@ -111,6 +125,25 @@ public:
     return m_navigation_revision.load(std::memory_order_acquire);
   }
 
+  void set_hierarchical_search(bool enabled);
+  [[nodiscard]] auto hierarchical_search() const -> bool {
+    return m_hierarchical_search.load(std::memory_order_acquire);
+  }
+  [[nodiscard]] auto hierarchy() const -> const NavigationHierarchy& {
+    return *m_hierarchy;
+  }
+
+  auto flow_field(const Point& goal,
+                  Passability passability = Passability::Light,
+                  float clearance_radius = 0.0F) -> std::shared_ptr<const FlowField>;
+  auto flow_field(const Point& goal,
+                  Passability passability,
+                  float clearance_radius,
+                  const CellRange& window) -> std::shared_ptr<const FlowField>;
+  [[nodiscard]] auto flow_field_builds() const -> std::uint64_t {
+    return m_flow_field_builds.load(std::memory_order_acquire);
+  }
+
   static auto
   find_nearest_walkable_point(const Point& point,
                               int max_search_radius,
@@ -118,6 +151,12 @@ public:
                               Passability passability = Passability::Light) -> Point;
 
 private:
+  friend class FlowField;
+  friend class NavigationHierarchy;
+
+  [[nodiscard]] auto uses_hierarchy(const Point& start, const Point& end) const -> bool;
+  void refresh_hierarchy(Passability passability);
+
   auto find_path_internal(const Point& start,
                           const Point& end,
                           Passability passability,
@@ -146,6 +185,9 @@ private:
   static constexpr int k_clearance_avoid_weight = 6;
   static constexpr int k_turn_penalty = 1;
 
+  static constexpr int k_hierarchy_min_extent = 192;
+  static constexpr std::size_t k_max_cached_flow_fields = 8U;
+
   static constexpr int k_heuristic_weight_numerator = 12;
   static constexpr int k_heuristic_weight_denominator = 10;
 
@@ -238,8 +280,11 @@ private:
   mutable std::shared_mutex m_navigation_mutex;
   mutable std::mutex m_path_cache_mutex;
 
-  std::mutex m_dirty_mutex;
+  mutable std::mutex m_dirty_mutex;
   std::vector<DirtyRegion> m_dirty_regions;
+  std::deque<DirtyRegion> m_region_log;
+  std::uint64_t m_region_log_base{0};
+  std::uint64_t m_region_log_end{0};
   bool m_full_update_required{true};
   std::atomic<std::uint64_t> m_applied_world_props_revision{0};
   std::atomic<std::uint64_t> m_obstruction_revision{0};
@@ -250,6 +295,11 @@ private:
   std::atomic<std::uint64_t> m_navigation_revision{1};
   std::uint64_t m_path_cache_revision{0};
   std::unordered_map<PathCacheKey, std::vector<Point>, PathCacheKeyHash> m_path_cache;
+  mutable std::mutex m_flow_field_mutex;
+  std::vector<std::shared_ptr<const FlowField>> m_flow_fields;
+  std::atomic<std::uint64_t> m_flow_field_builds{0};
+  std::unique_ptr<NavigationHierarchy> m_hierarchy;
+  std::atomic<bool> m_hierarchical_search{false};
 };
 
 } // namespace Game::Systems
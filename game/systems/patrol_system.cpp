@@ -72,13 +72,15 @@ void PatrolSystem::run(Engine::Core::SystemContext& context) {
         });
 
     if (nearest_enemy != Engine::Core::NULL_ENTITY) {
-      if (attack_target == nullptr) {
-        attack_target =
-            context.emplace<Engine::Core::AttackTargetComponent>(entity.get_id());
-      }
       if (attack_target != nullptr) {
         attack_target->target_id = nearest_enemy;
         attack_target->should_chase = false;
+      } else {
+        Engine::Core::AttackTargetComponent engaged;
+        engaged.target_id = nearest_enemy;
+        engaged.should_chase = false;
+        context.deferred().add_component<Engine::Core::AttackTargetComponent>(
+            entity.get_id(), engaged);
       }
 
       continue;
@@ -103,7 +105,7 @@ void PatrolSystem::run(Engine::Core::SystemContext& context) {
 
     Game::Systems::CommandService::MoveOptions options;
     options.kind = Game::Systems::MoveOrderKind::ScriptedMove;
-    Game::Systems::CommandService::move_unit(
+    Game::Systems::CommandService::defer_move_unit(
         context.world(), entity.get_id(), QVector3D(target_x, 0.0F, target_z), options);
   }
 }
@@ -112,12 +114,10 @@ auto PatrolSystem::access() const -> Engine::Core::SystemAccess {
   using namespace Engine::Core;
   return SystemAccess::declare(Reads<UnitComponent,
                                      TransformComponent,
+                                     MovementComponent,
                                      BuildingComponent,
                                      PendingRemovalComponent>{},
-                               Writes<PatrolComponent,
-                                      AttackTargetComponent,
-                                      MovementComponent,
-                                      AttackComponent>{});
+                               Writes<PatrolComponent, AttackTargetComponent>{});
 }
 
 } // namespace Game::Systems
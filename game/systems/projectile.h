@@ -1,8 +1,6 @@
 #pragma once
 #include <QVector3D>
 
-#include <memory>
-
 #include "../core/entity.h"
 #include "projectile_kind.h"
 
@@ -32,6 +30,4 @@ public:
   virtual auto get_target_locked_position() const -> QVector3D = 0;
 };
 
-using ProjectilePtr = std::unique_ptr<Projectile>;
-
 } // namespace Game::Systems
@@ -0,0 +1,230 @@
+#include "projectile_store.h"
+
+#include <algorithm>
+
+namespace Game::Systems {
+
+auto ProjectileStore::spawn(const ProjectileLaunch& launch) -> std::uint32_t {
+  std::uint32_t slot = 0;
+  if (m_free_slots.empty()) {
+    slot = static_cast<std::uint32_t>(m_progress.size());
+    m_progress.push_back(0.0F);
+    m_speed.push_back(0.0F);
+    m_inv_dist.push_back(0.0F);
+    m_live.push_back(0U);
+    m_serial.push_back(0U);
+    m_start.emplace_back();
+    m_end.emplace_back();
+    m_arc_height.push_back(0.0F);
+    m_kind.push_back(ProjectileKind::Arrow);
+    m_body.push_back(ProjectileBody::Arrow);
+    m_flags.push_back(0U);
+    m_damage.emplace_back();
+    m_look.emplace_back();
+  } else {
+    slot = m_free_slots.back();
+    m_free_slots.pop_back();
+  }
+
+  std::uint8_t flags = 0U;
+  if (launch.ballista_bolt) {
+    flags |= k_flag_ballista_bolt;
+  }
+  if (launch.should_apply_damage) {
+    flags |= k_flag_apply_damage;
+  }
+  if (launch.friendly_fire) {
+    flags |= k_flag_friendly_fire;
+  }
+
+  m_progress[slot] = launch.visual_profile.initial_progress;
+  m_speed[slot] = launch.speed;
+  m_inv_dist[slot] = launch.inv_dist;
+  m_live[slot] = 1U;
+  m_serial[slot] = m_next_serial++;
+  m_start[slot] = launch.start;
+  m_end[slot] = launch.end;
+  m_arc_height[slot] = launch.arc_height;
+  m_kind[slot] = launch.kind;
+  m_body[slot] = launch.body;
+  m_flags[slot] = flags;
+  m_damage[slot] = {.damage = launch.damage,
+                    .attacker_id = launch.attacker_id,
+                    .target_id = launch.target_id,
+                    .target_locked_position = launch.target_locked_position,
+                    .impact_radius = launch.impact_radius,
+                    .splash_damage_multiplier = launch.splash_damage_multiplier};
+  m_look[slot] = {.color = launch.color,
+                  .style = launch.visual_style,
+                  .profile = launch.visual_profile};
+  ++m_live_count;
+  return slot;
+}
+
+void ProjectileStore::release(std::uint32_t slot) {
+  if (slot >= m_live.size() || m_live[slot] == 0U) {
+    return;
+  }
+  m_live[slot] = 0U;
+  m_progress[slot] = 0.0F;
+  m_speed[slot] = 0.0F;
+  m_inv_dist[slot] = 0.0F;
+  m_flags[slot] = 0U;
+  m_free_slots.push_back(slot);
+  --m_live_count;
+}
+
+void ProjectileStore::clear() {
+  m_progress.clear();
+  m_speed.clear();
+  m_inv_dist.clear();
+  m_live.clear();
+  m_serial.clear();
+  m_start.clear();
+  m_end.clear();
+  m_arc_height.clear();
+  m_kind.clear();
+  m_body.clear();
+  m_flags.clear();
+  m_damage.clear();
+  m_look.clear();
+  m_free_slots.clear();
+  m_live_count = 0;
+}
+
+void ProjectileStore::advance(float delta_time) {
+  float* const progress = m_progress.data();
+  float const* const speed = m_speed.data();
+  float const* const inv_dist = m_inv_dist.data();
+  std::size_t const count = m_progress.size();
+  // (dt * speed) * inv_dist rounds differently from dt * (speed * inv_dist);
+  // keep this order so a projectile lands on the same tick it always has.
+  for (std::size_t i = 0; i < count; ++i) {
+    float const next = progress[i] + delta_time * speed[i] * inv_dist[i];
+    progress[i] = next < 1.0F ? next : 1.0F;
+  }
+}
+
+void ProjectileStore::collect_due(float min_progress,
+                                  std::vector<std::uint32_t>& due) const {
+  due.clear();
+  std::size_t const count = m_progress.size();
+  for (std::size_t i = 0; i < count; ++i) {
+    if (m_live[i] != 0U && m_progress[i] >= min_progress) {
+      due.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+  std::sort(due.begin(), due.end(), [this](std::uint32_t lhs, std::uint32_t rhs) {
+    return m_serial[lhs] < m_serial[rhs];
+  });
+}
+
+auto ProjectileStore::next_live(std::uint32_t slot) const -> std::uint32_t {
+  auto const count = static_cast<std::uint32_t>(m_live.size());
+  while (slot < count && m_live[slot] == 0U) {
+    ++slot;
+  }
+  return std::min(slot, count);
+}
+
+auto ProjectileView::body() const -> ProjectileBody {
+  return m_store->m_body[m_slot];
+}
+
+auto ProjectileView::get_start() const -> QVector3D {
+  return m_store->m_start[m_slot];
+}
+
+auto ProjectileView::get_end() const -> QVector3D {
+  return m_store->m_end[m_slot];
+}
+
+auto ProjectileView::get_color() const -> QVector3D {
+  return m_store->m_look[m_slot].color;
+}
+
+auto ProjectileView::get_arc_height() const -> float {
+  return m_store->m_arc_height[m_slot];
+}
+
+auto ProjectileView::get_progress() const -> float {
+  return m_store->m_progress[m_slot];
+}
+
+auto ProjectileView::get_scale() const -> float {
+  return m_store->m_look[m_slot].profile.scale;
+}
+
+auto ProjectileView::get_kind() const -> ProjectileKind {
+  return m_store->m_kind[m_slot];
+}
+
+auto ProjectileView::is_active() const -> bool {
+  return m_store->m_live[m_slot] != 0U;
+}
+
+auto ProjectileView::is_ballista_bolt() const -> bool {
+  return (m_store->m_flags[m_slot] & ProjectileStore::k_flag_ballista_bolt) != 0U;
+}
+
+auto ProjectileView::visual_style() const -> ArrowVisualStyle {
+  return m_store->m_look[m_slot].style;
+}
+
+auto ProjectileView::length_scale() const -> float {
+  return m_store->m_look[m_slot].profile.length_scale;
+}
+
+auto ProjectileView::roll_deg() const -> float {
+  return m_store->m_look[m_slot].profile.roll_deg;
+}
+
+auto ProjectileView::spin_rate_deg() const -> float {
+  return m_store->m_look[m_slot].profile.spin_rate_deg;
+}
+
+auto ProjectileView::trail_alpha() const -> float {
+  return m_store->m_look[m_slot].profile.trail_alpha;
+}
+
+auto ProjectileView::trail_length() const -> float {
+  return m_store->m_look[m_slot].profile.trail_length;
+}
+
+auto ProjectileView::brightness() const -> float {
+  return m_store->m_look[m_slot].profile.brightness;
+}
+
+auto ProjectileView::impact_radius() const -> float {
+  return m_store->m_damage[m_slot].impact_radius;
+}
+
+auto ProjectileView::splash_damage_multiplier() const -> float {
+  return m_store->m_damage[m_slot].splash_damage_multiplier;
+}
+
+auto ProjectileView::friendly_fire() const -> bool {
+  return (m_store->m_flags[m_slot] & ProjectileStore::k_flag_friendly_fire) != 0U;
+}
+
+auto ProjectileView::should_apply_damage() const -> bool {
+  return (m_store->m_flags[m_slot] & ProjectileStore::k_flag_apply_damage) != 0U;
+}
+
+auto ProjectileView::get_damage() const -> int {
+  return m_store->m_damage[m_slot].damage;
+}
+
+auto ProjectileView::get_attacker_id() const -> Engine::Core::EntityID {
+  return m_store->m_damage[m_slot].attacker_id;
+}
+
+auto ProjectileView::get_target_id() const -> Engine::Core::EntityID {
+  return m_store->m_damage[m_slot].target_id;
+}
+
+auto ProjectileView::get_target_locked_position() const -> QVector3D {
+  return m_store->m_damage[m_slot].target_locked_position;
+}
+
+} // namespace Game::Systems
@@ -0,0 +1,168 @@
+#pragma once
+#include <QVector3D>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "../core/entity.h"
+#include "arrow_visual_profile.h"
+#include "projectile_kind.h"
+
+namespace Game::Systems {
+
+enum class ProjectileBody : std::uint8_t {
+  Arrow,
+  Stone
+};
+
+struct ProjectileLaunch {
+  QVector3D start;
+  QVector3D end;
+  QVector3D color;
+  QVector3D target_locked_position;
+  float speed{0.0F};
+  float arc_height{0.0F};
+  float inv_dist{1.0F};
+  ProjectileKind kind{ProjectileKind::Arrow};
+  ProjectileBody body{ProjectileBody::Arrow};
+  bool ballista_bolt{false};
+  bool should_apply_damage{false};
+  int damage{0};
+  Engine::Core::EntityID attacker_id{0};
+  Engine::Core::EntityID target_id{0};
+  float impact_radius{0.0F};
+  float splash_damage_multiplier{0.6F};
+  bool friendly_fire{false};
+  ArrowVisualStyle visual_style{ArrowVisualStyle::Focused};
+  ArrowVisualProfile visual_profile{};
+};
+
+class ProjectileStore;
+
+class ProjectileView {
+public:
+  ProjectileView(const ProjectileStore& store, std::uint32_t slot)
+      : m_store(&store)
+      , m_slot(slot) {}
+
+  [[nodiscard]] auto slot() const -> std::uint32_t { return m_slot; }
+  [[nodiscard]] auto body() const -> ProjectileBody;
+  [[nodiscard]] auto get_start() const -> QVector3D;
+  [[nodiscard]] auto get_end() const -> QVector3D;
+  [[nodiscard]] auto get_color() const -> QVector3D;
+  [[nodiscard]] auto get_arc_height() const -> float;
+  [[nodiscard]] auto get_progress() const -> float;
+  [[nodiscard]] auto get_scale() const -> float;
+  [[nodiscard]] auto get_kind() const -> ProjectileKind;
+  [[nodiscard]] auto is_active() const -> bool;
+  [[nodiscard]] auto is_ballista_bolt() const -> bool;
+  [[nodiscard]] auto visual_style() const -> ArrowVisualStyle;
+  [[nodiscard]] auto length_scale() const -> float;
+  [[nodiscard]] auto roll_deg() const -> float;
+  [[nodiscard]] auto spin_rate_deg() const -> float;
+  [[nodiscard]] auto trail_alpha() const -> float;
+  [[nodiscard]] auto trail_length() const -> float;
+  [[nodiscard]] auto brightness() const -> float;
+  [[nodiscard]] auto impact_radius() const -> float;
+  [[nodiscard]] auto splash_damage_multiplier() const -> float;
+  [[nodiscard]] auto friendly_fire() const -> bool;
+  [[nodiscard]] auto should_apply_damage() const -> bool;
+  [[nodiscard]] auto get_damage() const -> int;
+  [[nodiscard]] auto get_attacker_id() const -> Engine::Core::EntityID;
+  [[nodiscard]] auto get_target_id() const -> Engine::Core::EntityID;
+  [[nodiscard]] auto get_target_locked_position() const -> QVector3D;
+
+private:
+  const ProjectileStore* m_store;
+  std::uint32_t m_slot;
+};
+
+class ProjectileStore {
+public:
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ProjectileView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = ProjectileView;
+
+    Iterator(const ProjectileStore& store, std::uint32_t slot)
+        : m_store(&store)
+        , m_slot(store.next_live(slot)) {}
+
+    auto operator*() const -> ProjectileView { return {*m_store, m_slot}; }
+    auto operator++() -> Iterator& {
+      m_slot = m_store->next_live(m_slot + 1U);
+      return *this;
+    }
+    auto operator==(const Iterator& other) const -> bool {
+      return m_slot == other.m_slot;
+    }
+
+  private:
+    const ProjectileStore* m_store;
+    std::uint32_t m_slot;
+  };
+
+  auto spawn(const ProjectileLaunch& launch) -> std::uint32_t;
+  void release(std::uint32_t slot);
+  void clear();
+
+  void advance(float delta_time);
+  void collect_due(float min_progress, std::vector<std::uint32_t>& due) const;
+
+  [[nodiscard]] auto size() const -> std::size_t { return m_live_count; }
+  [[nodiscard]] auto empty() const -> bool { return m_live_count == 0; }
+  [[nodiscard]] auto capacity() const -> std::size_t { return m_progress.size(); }
+  [[nodiscard]] auto front() const -> ProjectileView { return *begin(); }
+  [[nodiscard]] auto begin() const -> Iterator { return {*this, 0U}; }
+  [[nodiscard]] auto end() const -> Iterator {
+    return {*this, static_cast<std::uint32_t>(m_progress.size())};
+  }
+
+private:
+  friend class ProjectileView;
+
+  static constexpr std::uint8_t k_flag_ballista_bolt = 1U << 0U;
+  static constexpr std::uint8_t k_flag_apply_damage = 1U << 1U;
+  static constexpr std::uint8_t k_flag_friendly_fire = 1U << 2U;
+
+  struct DamagePayload {
+    int damage{0};
+    Engine::Core::EntityID attacker_id{0};
+    Engine::Core::EntityID target_id{0};
+    QVector3D target_locked_position;
+    float impact_radius{0.0F};
+    float splash_damage_multiplier{0.6F};
+  };
+
+  struct Look {
+    QVector3D color;
+    ArrowVisualStyle style{ArrowVisualStyle::Focused};
+    ArrowVisualProfile profile{};
+  };
+
+  [[nodiscard]] auto next_live(std::uint32_t slot) const -> std::uint32_t;
+
+  std::vector<float> m_progress;
+  std::vector<float> m_speed;
+  std::vector<float> m_inv_dist;
+  std::vector<std::uint8_t> m_live;
+  std::vector<std::uint64_t> m_serial;
+  std::vector<QVector3D> m_start;
+  std::vector<QVector3D> m_end;
+  std::vector<float> m_arc_height;
+  std::vector<ProjectileKind> m_kind;
+  std::vector<ProjectileBody> m_body;
+  std::vector<std::uint8_t> m_flags;
+  std::vector<DamagePayload> m_damage;
+  std::vector<Look> m_look;
+  std::vector<std::uint32_t> m_free_slots;
+  std::size_t m_live_count{0};
+  std::uint64_t m_next_serial{0};
+};
+
+} // namespace Game::Systems
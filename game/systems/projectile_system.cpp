@@ -4,14 +4,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 #include "../core/component.h"
 #include "../core/event_manager.h"
 #include "../core/world.h"
 #include "../map/terrain_service.h"
-#include "arrow_projectile.h"
 #include "combat_system/combat_hit_resolver.h"
-#include "stone_projectile.h"
 
 namespace Game::Systems {
 
@@ -52,8 +51,8 @@ auto impact_cue_for_kind(ProjectileKind kind, bool is_ballista_bolt) -> const ch
 constexpr float k_projectile_escape_radius = 1.5F;
 
 auto target_escaped_impact(const Engine::Core::Entity* target,
-                           Projectile* projectile) -> bool {
-  if (target == nullptr || projectile == nullptr) {
+                           const ProjectileView& projectile) -> bool {
+  if (target == nullptr) {
     return true;
   }
 
@@ -65,7 +64,7 @@ auto target_escaped_impact(const Engine::Core::Entity* target,
 
   QVector3D const current_pos(
       target_transform->position.x, 0.0F, target_transform->position.z);
-  QVector3D locked_pos = projectile->get_target_locked_position();
+  QVector3D locked_pos = projectile.get_target_locked_position();
   locked_pos.setY(0.0F);
   return (current_pos - locked_pos).length() > k_projectile_escape_radius;
 }
@@ -157,11 +156,11 @@ auto target_escaped_impact(const Engine::Core::Entity* target,
 
 [[nodiscard]] auto
 valid_direct_target(Engine::Core::World* world,
-                    Projectile* projectile) -> Engine::Core::Entity* {
-  if (world == nullptr || projectile == nullptr || projectile->get_target_id() == 0) {
+                    const ProjectileView& projectile) -> Engine::Core::Entity* {
+  if (world == nullptr || projectile.get_target_id() == 0) {
     return nullptr;
   }
-  auto* target = world->get_entity(projectile->get_target_id());
+  auto* target = world->get_entity(projectile.get_target_id());
   if (target == nullptr ||
       target->has_component<Engine::Core::PendingRemovalComponent>() ||
       target_escaped_impact(target, projectile)) {
@@ -220,25 +219,25 @@ void ProjectileSystem::spawn_arrow(const QVector3D& start,
   visual_profile.brightness *= 0.80F + (0.20F * power);
   visual_profile.trail_alpha *= 0.56F + (0.44F * power);
 
-  m_projectiles.push_back(
-      std::make_unique<ArrowProjectile>(start,
-                                        end,
-                                        color,
-                                        speed,
-                                        arc_height,
-                                        inv_dist,
-                                        is_ballista_bolt,
-                                        kind,
-                                        should_apply_damage,
-                                        damage,
-                                        attacker_id,
-                                        target_id,
-                                        impact_radius,
-                                        splash_damage_multiplier,
-                                        friendly_fire,
-                                        visual_style,
-                                        visual_profile,
-                                        target_origin_at_launch.value_or(end)));
+  m_projectiles.spawn({.start = start,
+                       .end = end,
+                       .color = color,
+                       .target_locked_position = target_origin_at_launch.value_or(end),
+                       .speed = speed,
+                       .arc_height = arc_height,
+                       .inv_dist = inv_dist,
+                       .kind = kind,
+                       .body = ProjectileBody::Arrow,
+                       .ballista_bolt = is_ballista_bolt,
+                       .should_apply_damage = should_apply_damage,
+                       .damage = damage,
+                       .attacker_id = attacker_id,
+                       .target_id = target_id,
+                       .impact_radius = impact_radius,
+                       .splash_damage_multiplier = splash_damage_multiplier,
+                       .friendly_fire = friendly_fire,
+                       .visual_style = visual_style,
+                       .visual_profile = visual_profile});
 
   if (!is_ballista_bolt && kind != ProjectileKind::Stone &&
       kind != ProjectileKind::FlamingStone) {
@@ -269,20 +268,22 @@ void ProjectileSystem::spawn_stone(const QVector3D& start,
       std::clamp(k_stone_arc_multiplier * dist, k_stone_arc_min, k_stone_arc_max);
   float const inv_dist = (dist > 0.001F) ? (1.0F / dist) : 1.0F;
 
-  m_projectiles.push_back(
-      std::make_unique<StoneProjectile>(start,
-                                        end,
-                                        color,
-                                        speed,
-                                        arc_height,
-                                        inv_dist,
-                                        scale,
-                                        should_apply_damage,
-                                        damage,
-                                        attacker_id,
-                                        target_id,
-                                        target_origin_at_launch.value_or(end),
-                                        kind));
+  ArrowVisualProfile stone_profile;
+  stone_profile.scale = scale;
+  m_projectiles.spawn({.start = start,
+                       .end = end,
+                       .color = color,
+                       .target_locked_position = target_origin_at_launch.value_or(end),
+                       .speed = speed,
+                       .arc_height = arc_height,
+                       .inv_dist = inv_dist,
+                       .kind = kind,
+                       .body = ProjectileBody::Stone,
+                       .should_apply_damage = should_apply_damage,
+                       .damage = damage,
+                       .attacker_id = attacker_id,
+                       .target_id = target_id,
+                       .visual_profile = stone_profile});
 
   Engine::Core::EventManager::instance().publish(
       Engine::Core::AudioCueEvent(launch_cue_for_kind(kind, false)));
@@ -306,67 +307,56 @@ void ProjectileSystem::update(Engine::Core::World* world, float delta_time) {
   }
   std::erase_if(m_spent, [](auto const& spent) { return spent.age >= spent.lifetime; });
 
-  for (auto& projectile : m_projectiles) {
-    if (projectile == nullptr || !projectile->is_active()) {
-      continue;
-    }
-    projectile->update(delta_time);
-    if (projectile->get_progress() >= k_min_progress_for_impact) {
-      auto const resolution = resolve_impact(world, projectile.get());
-      publish_impact(*projectile, resolution);
-      projectile->deactivate();
-    }
+  m_projectiles.advance(delta_time);
+  m_projectiles.collect_due(k_min_progress_for_impact, m_due);
+  for (std::uint32_t const slot : m_due) {
+    ProjectileView const projectile(m_projectiles, slot);
+    auto const resolution = resolve_impact(world, projectile);
+    publish_impact(world, projectile, resolution);
+    m_projectiles.release(slot);
   }
-
-  m_projectiles.erase(
-      std::remove_if(m_projectiles.begin(),
-                     m_projectiles.end(),
-                     [](const ProjectilePtr& p) { return !p->is_active(); }),
-      m_projectiles.end());
 }
 
 auto ProjectileSystem::resolve_impact(Engine::Core::World* world,
-                                      Projectile* projectile) -> ImpactResolution {
+                                      const ProjectileView& projectile)
+    -> ImpactResolution {
   ImpactResolution resolution;
-  if (projectile == nullptr || world == nullptr) {
+  if (world == nullptr) {
     return resolution;
   }
 
-  if (auto* arrow_projectile = dynamic_cast<ArrowProjectile*>(projectile);
-      arrow_projectile != nullptr) {
-    if (arrow_projectile->get_kind() == ProjectileKind::Fireball) {
-      resolution.hit_target = valid_direct_target(world, projectile) != nullptr;
-      if (projectile->should_apply_damage()) {
-        auto const area_result =
-            Game::Systems::Combat::resolve_projectile_area_impact_hit(
-                world,
-                {.attacker_id = projectile->get_attacker_id(),
-                 .primary_target_id = projectile->get_target_id(),
-                 .impact_point = projectile->get_end(),
-                 .projectile_kind = arrow_projectile->get_kind(),
-                 .explicit_raw_damage = projectile->get_damage(),
-                 .radius = arrow_projectile->impact_radius(),
-                 .splash_damage_multiplier =
-                     arrow_projectile->splash_damage_multiplier(),
-                 .friendly_fire = arrow_projectile->friendly_fire()});
-        resolution.damage_applied =
-            area_result.applied_hits > 0 || area_result.fire_patch_spawned;
-      }
-      return resolution;
+  if (projectile.body() == ProjectileBody::Arrow &&
+      projectile.get_kind() == ProjectileKind::Fireball) {
+    resolution.hit_target = valid_direct_target(world, projectile) != nullptr;
+    if (projectile.should_apply_damage()) {
+      auto const area_result =
+          Game::Systems::Combat::resolve_projectile_area_impact_hit(
+              world,
+              {.attacker_id = projectile.get_attacker_id(),
+               .primary_target_id = projectile.get_target_id(),
+               .impact_point = projectile.get_end(),
+               .projectile_kind = projectile.get_kind(),
+               .explicit_raw_damage = projectile.get_damage(),
+               .radius = projectile.impact_radius(),
+               .splash_damage_multiplier = projectile.splash_damage_multiplier(),
+               .friendly_fire = projectile.friendly_fire()});
+      resolution.damage_applied =
+          area_result.applied_hits > 0 || area_result.fire_patch_spawned;
     }
+    return resolution;
   }
 
   auto* target = valid_direct_target(world, projectile);
   resolution.hit_target = target != nullptr;
-  if (target != nullptr && projectile->should_apply_damage()) {
+  if (target != nullptr && projectile.should_apply_damage()) {
     resolution.damage_applied = apply_projectile_damage(world,
                                                         target,
-                                                        projectile->get_damage(),
-                                                        projectile->get_attacker_id(),
-                                                        projectile->get_end(),
-                                                        projectile->get_kind());
+                                                        projectile.get_damage(),
+                                                        projectile.get_attacker_id(),
+                                                        projectile.get_end(),
+                                                        projectile.get_kind());
     if (resolution.damage_applied) {
-      confirm_commander_hit(world, projectile->get_attacker_id(), *target);
+      confirm_commander_hit(world, projectile.get_attacker_id(), *target);
     }
   }
   return resolution;
@@ -401,14 +391,13 @@ void ProjectileSystem::confirm_commander_hit(Engine::Core::World* world,
   ++targets->hit_confirm_sequence;
 }
 
-void ProjectileSystem::publish_impact(const Projectile& projectile,
+void ProjectileSystem::publish_impact(Engine::Core::World* world,
+                                      const ProjectileView& projectile,
                                       const ImpactResolution& resolution) {
-  bool ballista_bolt = false;
-  bool aimed_shot = false;
-  if (auto const* arrow = dynamic_cast<const ArrowProjectile*>(&projectile)) {
-    ballista_bolt = arrow->is_ballista_bolt();
-    aimed_shot = arrow->visual_style() == ArrowVisualStyle::Aimed;
-  }
+  bool const is_arrow = projectile.body() == ProjectileBody::Arrow;
+  bool const ballista_bolt = is_arrow && projectile.is_ballista_bolt();
+  bool const aimed_shot =
+      is_arrow && projectile.visual_style() == ArrowVisualStyle::Aimed;
   QVector3D incoming_direction = projectile.get_end() - projectile.get_start();
   if (incoming_direction.lengthSquared() > 1.0e-6F) {
     incoming_direction.normalize();
@@ -433,15 +422,20 @@ void ProjectileSystem::publish_impact(const Projectile& projectile,
       .target_id = projectile.get_target_id(),
   });
 
-  Engine::Core::EventManager::instance().publish(Engine::Core::AudioCueEvent(
-      (aimed_shot && resolution.hit_target)
-          ? "combat.hit.arrow"
-          : impact_cue_for_kind(projectile.get_kind(), ballista_bolt)));
+  Engine::Core::AudioCueEvent cue((aimed_shot && resolution.hit_target)
+                                      ? "combat.hit.arrow"
+                                      : impact_cue_for_kind(projectile.get_kind(),
+                                                            ballista_bolt));
+  if (world != nullptr) {
+    world->events().push(std::move(cue));
+  } else {
+    Engine::Core::EventManager::instance().publish(cue);
+  }
 
   record_spent_projectile(projectile, incoming_direction, ballista_bolt);
 }
 
-void ProjectileSystem::record_spent_projectile(const Projectile& projectile,
+void ProjectileSystem::record_spent_projectile(const ProjectileView& projectile,
                                                const QVector3D& incoming_direction,
                                                bool ballista_bolt) {
   if (!leaves_a_shaft(projectile.get_kind())) {
@@ -2,7 +2,6 @@
 #include <QVector3D>
 
 #include <cstdint>
-#include <memory>
 #include <optional>
 #include <vector>
 
@@ -11,7 +10,7 @@
 #include "../core/world.h"
 #include "../game_config.h"
 #include "arrow_visual_profile.h"
-#include "projectile.h"
+#include "projectile_store.h"
 #include "spent_projectile.h"
 
 namespace Game::Systems {
@@ -71,7 +70,7 @@ public:
                    std::optional<QVector3D> target_origin_at_launch = std::nullopt,
                    ProjectileKind kind = ProjectileKind::Stone);
 
-  [[nodiscard]] auto projectiles() const -> const std::vector<ProjectilePtr>& {
+  [[nodiscard]] auto projectiles() const -> const ProjectileStore& {
     return m_projectiles;
   }
   [[nodiscard]] auto impacts() const -> const std::vector<ProjectileImpactEvent>& {
@@ -87,19 +86,23 @@ private:
     bool damage_applied{false};
   };
 
-  [[nodiscard]] auto resolve_impact(Engine::Core::World* world,
-                                    Projectile* projectile) -> ImpactResolution;
-  void publish_impact(const Projectile& projectile, const ImpactResolution& resolution);
+  [[nodiscard]] static auto resolve_impact(Engine::Core::World* world,
+                                           const ProjectileView& projectile)
+      -> ImpactResolution;
+  void publish_impact(Engine::Core::World* world,
+                      const ProjectileView& projectile,
+                      const ImpactResolution& resolution);
   static void confirm_commander_hit(Engine::Core::World* world,
                                     Engine::Core::EntityID attacker_id,
                                     const Engine::Core::Entity& target);
-  void record_spent_projectile(const Projectile& projectile,
+  void record_spent_projectile(const ProjectileView& projectile,
                                const QVector3D& incoming_direction,
                                bool ballista_bolt);
 
   static constexpr int k_volley_arrow_threshold = 4;
 
-  std::vector<ProjectilePtr> m_projectiles;
+  ProjectileStore m_projectiles;
+  std::vector<std::uint32_t> m_due;
   std::vector<ProjectileImpactEvent> m_impacts;
   std::vector<SpentProjectile> m_spent;
   ArrowConfig m_arrow_config;
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "../core/component.h"
@@ -89,7 +91,13 @@ void approach_fill(float& current, float target, float delta_time) {
   }
 }
 
-void sync_stockpile_displays(Engine::Core::World* world, float delta_time) {
+// Stockpiles a barracks does not have yet are filled here and added at the
+// phase barrier.
+using NewStockpiles =
+    std::map<Engine::Core::EntityID, Engine::Core::StockpileComponent>;
+
+void sync_stockpile_displays(Engine::Core::World* world, float delta_time,
+                             NewStockpiles& created) {
   auto& resources = PlayerResourceRegistry::instance();
 
   for (auto [entity_id, unit_ref] : world->view<Engine::Core::UnitComponent>()) {
@@ -100,10 +108,7 @@ void sync_stockpile_displays(Engine::Core::World* world, float delta_time) {
 
     auto* stockpile = world->try_get<Engine::Core::StockpileComponent>(entity_id);
     if (stockpile == nullptr) {
-      stockpile = world->emplace<Engine::Core::StockpileComponent>(entity_id);
-      if (stockpile == nullptr) {
-        continue;
-      }
+      stockpile = &created[entity_id];
     }
 
     bool const owned = !Game::Core::is_neutral_owner(unit->owner_id);
@@ -150,7 +155,8 @@ void ResourceDeliverySystem::update(Engine::Core::World* world, float delta_time
     return;
   }
 
-  sync_stockpile_displays(world, delta_time);
+  NewStockpiles created;
+  sync_stockpile_displays(world, delta_time, created);
 
   std::vector<Engine::Core::EntityID> unloaded;
 
@@ -205,9 +211,11 @@ void ResourceDeliverySystem::update(Engine::Core::World* world, float delta_time
       credit_load(unit->owner_id, *carry);
       if (auto* stockpile = depot->get_component<Engine::Core::StockpileComponent>()) {
         stockpile->deposit_flash = k_stockpile_deposit_flash_seconds;
+      } else if (auto pending = created.find(depot->get_id());
+                 pending != created.end()) {
+        pending->second.deposit_flash = k_stockpile_deposit_flash_seconds;
       }
-      Engine::Core::EventManager::instance().publish(
-          Engine::Core::AudioCueEvent(k_deposit_cue));
+      world->events().push(Engine::Core::AudioCueEvent(k_deposit_cue));
       unloaded.push_back(hauler->get_id());
       continue;
     }
@@ -229,15 +237,17 @@ void ResourceDeliverySystem::update(Engine::Core::World* world, float delta_time
                                                           transform->position.y,
                                                           depot_transform->position.z));
     }
-    CommandService::move_unit(
+    CommandService::defer_move_unit(
         *world, hauler->get_id(), target, {.kind = MoveOrderKind::ScriptedMove});
     carry->haul_repath_cooldown = k_haul_repath_interval;
   }
 
   for (auto const id : unloaded) {
-    if (auto* entity = world->get_entity(id)) {
-      entity->remove_component<Engine::Core::ResourceCarryComponent>();
-    }
+    world->deferred().remove_component<Engine::Core::ResourceCarryComponent>(id);
+  }
+  for (auto& [id, stockpile] : created) {
+    world->deferred().add_component<Engine::Core::StockpileComponent>(
+        id, std::move(stockpile));
   }
 }
 
@@ -246,11 +256,10 @@ auto ResourceDeliverySystem::access() const -> Engine::Core::SystemAccess {
   return SystemAccess::declare(Reads<UnitComponent,
                                      TransformComponent,
                                      AttackTargetComponent,
+                                     MovementComponent,
+                                     BuilderProductionComponent,
                                      PendingRemovalComponent>{},
-                               Writes<ResourceCarryComponent,
-                                      StockpileComponent,
-                                      BuilderProductionComponent,
-                                      MovementComponent>{});
+                               Writes<ResourceCarryComponent, StockpileComponent>{});
 }
 
 } // namespace Game::Systems
@@ -6,7 +6,6 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
-#include <QJsonParseError>
 #include <QSaveFile>
 #include <QStandardPaths>
 
@@ -15,7 +14,7 @@
 #include <exception>
 
 #include "game/core/world.h"
-#include "game/save/serialization.h"
+#include "game/save/world_snapshot.h"
 #include "save_storage.h"
 
 namespace Game::Systems {
@@ -236,43 +235,36 @@ void SaveLoadService::run_write_job(SaveStorage& storage, const Job& job) {
     if (is_cancelled(job.id)) {
       cancelled = true;
     } else {
-      report(15, tr("Serializing world"));
-      const QByteArray world_bytes = job.request.world.toJson(QJsonDocument::Compact);
+      report(45, tr("Compressing"));
+      Save::Record record;
+      record.slot_name = job.request.slot_name;
+      record.title = job.request.title;
+      record.map_name = job.request.map_name;
+      record.map_path = job.request.map_path;
+      record.mode = job.request.mode;
+      record.campaign_id = job.request.campaign_id;
+      record.mission_id = job.request.mission_id;
+      record.difficulty = job.request.difficulty;
+      record.kind = job.request.kind;
+      record.play_time_seconds = job.request.play_time_seconds;
+      record.created_at = now_iso();
+      record.updated_at = record.created_at;
+      record.metadata = job.request.metadata;
+      record.screenshot = job.request.screenshot;
+      record.world = Save::pack(job.request.world);
 
       if (is_cancelled(job.id)) {
         cancelled = true;
       } else {
-        report(45, tr("Compressing"));
-        Save::Record record;
-        record.slot_name = job.request.slot_name;
-        record.title = job.request.title;
-        record.map_name = job.request.map_name;
-        record.map_path = job.request.map_path;
-        record.mode = job.request.mode;
-        record.campaign_id = job.request.campaign_id;
-        record.mission_id = job.request.mission_id;
-        record.difficulty = job.request.difficulty;
-        record.kind = job.request.kind;
-        record.play_time_seconds = job.request.play_time_seconds;
-        record.created_at = now_iso();
-        record.updated_at = record.created_at;
-        record.metadata = job.request.metadata;
-        record.screenshot = job.request.screenshot;
-        record.world = Save::pack(world_bytes);
-
-        if (is_cancelled(job.id)) {
-          cancelled = true;
-        } else {
-          report(75, tr("Writing"));
-          success = storage.write_slot(record, &error);
-          if (success && job.request.autosave_retention > 0) {
-            const int retention = clamp_retention(job.request.autosave_retention);
-            QString prune_error;
-            const QStringList autosaves =
-                storage.slot_names_by_kind(Save::SlotKind::Autosave, &prune_error);
-            for (int i = 0; i < autosaves.size() - retention; ++i) {
-              storage.delete_slot(autosaves.at(i), &prune_error);
-            }
+        report(75, tr("Writing"));
+        success = storage.write_slot(record, &error);
+        if (success && job.request.autosave_retention > 0) {
+          const int retention = clamp_retention(job.request.autosave_retention);
+          QString prune_error;
+          const QStringList autosaves =
+              storage.slot_names_by_kind(Save::SlotKind::Autosave, &prune_error);
+          for (int i = 0; i < autosaves.size() - retention; ++i) {
+            storage.delete_slot(autosaves.at(i), &prune_error);
           }
         }
       }
@@ -327,19 +319,14 @@ auto SaveLoadService::load_game_from_slot(Engine::Core::World& world,
       return false;
     }
 
-    QJsonParseError parse_error{};
-    const QJsonDocument doc = QJsonDocument::fromJson(world_bytes, &parse_error);
-    if (parse_error.error != QJsonParseError::NoError || !doc.isObject()) {
-      const QString message = tr("Save slot '%1' is corrupted: %2")
-                                  .arg(slot_name, parse_error.errorString());
+    if (!Game::Save::restore_world_bytes(world, world_bytes, &error)) {
+      const QString message =
+          tr("Save slot '%1' is corrupted: %2").arg(slot_name, error);
       set_last_error(message);
       qWarning() << message;
       return false;
     }
 
-    world.clear();
-    Engine::Core::Serialization::deserialize_world(&world, doc);
-
     m_last_record = record;
     set_last_error({});
     return true;
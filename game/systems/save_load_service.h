@@ -1,7 +1,6 @@
 #pragma once
 
 #include <QByteArray>
-#include <QJsonDocument>
 #include <QJsonObject>
 #include <QObject>
 #include <QString>
@@ -42,7 +41,8 @@ struct SaveRequest {
   double play_time_seconds = 0.0;
   QJsonObject metadata;
   QByteArray screenshot;
-  QJsonDocument world;
+  // Game::Save::capture_world_snapshot output, taken on the simulation thread.
+  QByteArray world;
   int autosave_retention = 0;
 };
 
@@ -57,13 +57,12 @@ void TargetCommitmentSystem::run(Engine::Core::SystemContext& context) {
 
     if (commitment == nullptr) {
       if (atk.in_melee_lock && attack_target != nullptr) {
-        commitment =
-            context.emplace<Engine::Core::TargetCommitmentComponent>(entity_id);
-        if (commitment != nullptr) {
-          commitment->committed_target_id = attack_target->target_id;
-          commitment->cooldown_remaining =
-              Engine::Core::TargetCommitmentComponent::k_switch_cooldown;
-        }
+        Engine::Core::TargetCommitmentComponent added;
+        added.committed_target_id = attack_target->target_id;
+        added.cooldown_remaining =
+            Engine::Core::TargetCommitmentComponent::k_switch_cooldown;
+        context.deferred().add_component<Engine::Core::TargetCommitmentComponent>(
+            entity_id, added);
       }
       continue;
     }
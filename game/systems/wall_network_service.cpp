@@ -6,7 +6,12 @@
 #include <array>
 #include <cmath>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "../core/component.h"
@@ -120,16 +125,409 @@ auto decode_key(std::uint64_t key) -> WallGridPosition {
   };
 }
 
-void add_owner_occupancy(WallNetworkService::OwnerOccupancyMap& out,
-                         int owner_id,
-                         int grid_x,
-                         int grid_z) {
-  if (owner_id <= 0) {
+// Wall-network occupancy of one world, kept across queries. Component adds and
+// removes, destroys and clears only queue the entity; the next query
+// re-evaluates what was queued, so a lookup is a hash probe rather than a walk
+// over every wall. Owner cell sets double as the connectivity graph: a cell's
+// neighbours are the four probes of compute_connection_mask.
+//
+// Only structures can enter the index, so only entities that have carried a
+// wall, gate or building component are watched; unit and transform churn on
+// anything else is never queued. A queue that still outgrows
+// k_max_pending_updates before a query drains it becomes one rescan.
+class WallOccupancyIndex {
+public:
+  static constexpr std::size_t k_max_pending_updates = 4096U;
+
+  struct CellCount {
+    int built{0};
+    int sites{0};
+    int towers{0};
+
+    [[nodiscard]] auto walls(bool include_construction_sites) const -> int {
+      return built + (include_construction_sites ? sites : 0);
+    }
+    [[nodiscard]] auto total() const -> int { return built + sites + towers; }
+  };
+
+  static auto of(Engine::Core::World& world) -> std::shared_ptr<WallOccupancyIndex>;
+
+  void on_component_changed(Engine::Core::EntityID entity_id,
+                            std::type_index type,
+                            bool added);
+  void on_entity_destroyed(Engine::Core::EntityID entity_id);
+
+  void invalidate(Engine::Core::EntityID entity_id) {
+    const std::lock_guard<std::mutex> lock(m_pending_mutex);
+    queue_locked(entity_id);
+  }
+
+  // Health and rotation changes raise no component event; refresh_world
+  // calls this so the next query rescans the world once.
+  void invalidate_all() {
+    const std::lock_guard<std::mutex> lock(m_pending_mutex);
+    m_pending.clear();
+    m_rebuild_pending = true;
+  }
+
+  [[nodiscard]] auto pending_updates() -> std::size_t {
+    const std::lock_guard<std::mutex> lock(m_pending_mutex);
+    return m_pending.size();
+  }
+
+  // Callers hold mutex() across sync and the reads that follow it.
+  void sync(Engine::Core::World& world);
+  auto mutex() -> std::mutex& { return m_mutex; }
+
+  [[nodiscard]] auto center_occupied(std::uint64_t key,
+                                     bool include_construction_sites,
+                                     Engine::Core::EntityID ignore_entity_id) const
+      -> bool;
+  [[nodiscard]] auto cell_occupied(std::uint64_t key,
+                                   bool include_construction_sites) const -> bool;
+  void collect_cells(WallNetworkService::OccupancySet& out,
+                     bool include_construction_sites) const;
+  void collect_owner_cells(WallNetworkService::OwnerOccupancyMap& out,
+                           bool include_construction_sites,
+                           bool include_towers) const;
+  [[nodiscard]] auto
+  owner_cells(int owner_id) const -> const WallNetworkService::OccupancySet*;
+
+private:
+  enum class Kind : std::uint8_t { Wall, Site, Tower };
+
+  struct Entry {
+    Kind kind{Kind::Wall};
+    int owner_id{0};
+    std::uint64_t center{0};
+    std::vector<std::uint64_t> cells;
+  };
+
+  // Callers hold m_pending_mutex.
+  void queue_locked(Engine::Core::EntityID entity_id);
+
+  static auto describe(Engine::Core::Entity* entity) -> std::optional<Entry>;
+  void reindex(Engine::Core::Entity* entity, Engine::Core::EntityID entity_id);
+  void rebuild(Engine::Core::World& world);
+  void count(const Entry& entry, int delta);
+
+  std::mutex m_mutex;
+  std::mutex m_pending_mutex;
+  std::vector<Engine::Core::EntityID> m_pending;
+  std::unordered_set<Engine::Core::EntityID> m_watched;
+  bool m_rebuild_pending{true};
+
+  std::unordered_map<Engine::Core::EntityID, Entry> m_entries;
+  std::unordered_map<std::uint64_t, CellCount> m_centers;
+  std::unordered_map<std::uint64_t, CellCount> m_cells;
+  std::unordered_map<int, std::unordered_map<std::uint64_t, CellCount>> m_owner_counts;
+  WallNetworkService::OwnerOccupancyMap m_owner_cells;
+};
+
+// Components only a structure carries; an entity that gains one is watched.
+auto is_structure_component(std::type_index type) -> bool {
+  static const std::array<std::type_index, 4> k_structure{
+      std::type_index(typeid(WallSegmentComponent)),
+      std::type_index(typeid(WallConstructionSiteComponent)),
+      std::type_index(typeid(BuildingComponent)),
+      std::type_index(typeid(GateComponent))};
+  return std::find(k_structure.begin(), k_structure.end(), type) != k_structure.end();
+}
+
+// Components that change how a watched structure is indexed.
+auto tracks_wall_component(std::type_index type) -> bool {
+  static const std::array<std::type_index, 4> k_tracked{
+      std::type_index(typeid(UnitComponent)),
+      std::type_index(typeid(TransformComponent)),
+      std::type_index(typeid(PendingRemovalComponent)),
+      std::type_index(typeid(ConstructionPreviewComponent))};
+  return is_structure_component(type) ||
+         std::find(k_tracked.begin(), k_tracked.end(), type) != k_tracked.end();
+}
+
+auto WallOccupancyIndex::of(Engine::Core::World& world)
+    -> std::shared_ptr<WallOccupancyIndex> {
+  // The observers own the index, so it goes away with its world and a world
+  // reallocated at the same address finds an expired entry.
+  static std::mutex mutex;
+  static auto* indices =
+      new std::unordered_map<const Engine::Core::World*,
+                             std::weak_ptr<WallOccupancyIndex>>();
+  const std::lock_guard<std::mutex> lock(mutex);
+  if (auto existing = (*indices)[&world].lock()) {
+    return existing;
+  }
+  std::erase_if(*indices, [](const auto& entry) { return entry.second.expired(); });
+
+  auto index = std::make_shared<WallOccupancyIndex>();
+  world.add_component_observer(
+      [index](Engine::Core::EntityID entity_id, std::type_index type, bool added) {
+        index->on_component_changed(entity_id, type, added);
+      });
+  world.add_entity_destroyed_observer([index](Engine::Core::EntityID entity_id) {
+    index->on_entity_destroyed(entity_id);
+  });
+  world.add_world_cleared_observer([index]() { index->invalidate_all(); });
+  (*indices)[&world] = index;
+  return index;
+}
+
+void WallOccupancyIndex::on_component_changed(Engine::Core::EntityID entity_id,
+                                              std::type_index type,
+                                              bool added) {
+  if (!tracks_wall_component(type)) {
     return;
   }
-  out[owner_id].insert(WallNetworkService::encode_key(grid_x, grid_z));
+  const std::lock_guard<std::mutex> lock(m_pending_mutex);
+  if (added && is_structure_component(type)) {
+    m_watched.insert(entity_id);
+  }
+  if (m_watched.contains(entity_id)) {
+    queue_locked(entity_id);
+  }
+}
+
+void WallOccupancyIndex::on_entity_destroyed(Engine::Core::EntityID entity_id) {
+  const std::lock_guard<std::mutex> lock(m_pending_mutex);
+  if (m_watched.erase(entity_id) != 0U) {
+    queue_locked(entity_id);
+  }
+}
+
+void WallOccupancyIndex::queue_locked(Engine::Core::EntityID entity_id) {
+  if (m_rebuild_pending) {
+    return;
+  }
+  if (m_pending.size() >= k_max_pending_updates) {
+    m_pending.clear();
+    m_rebuild_pending = true;
+    return;
+  }
+  m_pending.push_back(entity_id);
+}
+
+void WallOccupancyIndex::sync(Engine::Core::World& world) {
+  std::vector<Engine::Core::EntityID> pending;
+  bool rebuild_pending = false;
+  {
+    const std::lock_guard<std::mutex> lock(m_pending_mutex);
+    pending.swap(m_pending);
+    rebuild_pending = m_rebuild_pending;
+    m_rebuild_pending = false;
+  }
+  if (rebuild_pending) {
+    rebuild(world);
+    return;
+  }
+  std::sort(pending.begin(), pending.end());
+  pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+  for (const auto entity_id : pending) {
+    reindex(world.get_entity(entity_id), entity_id);
+  }
+}
+
+auto WallOccupancyIndex::describe(Engine::Core::Entity* entity)
+    -> std::optional<Entry> {
+  if (entity == nullptr) {
+    return std::nullopt;
+  }
+  const auto* transform = entity->get_component<TransformComponent>();
+  if (transform == nullptr) {
+    return std::nullopt;
+  }
+
+  const auto snapped = WallNetworkService::snap_world_position(transform->position.x,
+                                                               transform->position.z);
+  const auto center = WallNetworkService::encode_key(snapped.x, snapped.z);
+  if (auto* wall = entity->get_component<WallSegmentComponent>();
+      wall != nullptr && is_live_wall_entity(entity, true)) {
+    wall->grid_x = snapped.x;
+    wall->grid_z = snapped.z;
+    Entry entry{
+        .kind = entity->has_component<UnitComponent>() ? Kind::Wall : Kind::Site,
+        .owner_id = resolve_wall_network_owner_id(entity).value_or(0),
+        .center = center,
+        .cells = {}};
+    for (const auto& cell : wall_network_cells(entity, snapped)) {
+      entry.cells.push_back(WallNetworkService::encode_key(cell.x, cell.z));
+    }
+    return entry;
+  }
+
+  if (is_live_tower_socket_entity(entity)) {
+    return Entry{.kind = Kind::Tower,
+                 .owner_id = entity->get_component<UnitComponent>()->owner_id,
+                 .center = center,
+                 .cells = {center}};
+  }
+  return std::nullopt;
+}
+
+void WallOccupancyIndex::reindex(Engine::Core::Entity* entity,
+                                 Engine::Core::EntityID entity_id) {
+  if (auto it = m_entries.find(entity_id); it != m_entries.end()) {
+    count(it->second, -1);
+    m_entries.erase(it);
+  }
+  if (auto entry = describe(entity)) {
+    count(*entry, 1);
+    m_entries.emplace(entity_id, std::move(*entry));
+  }
+}
+
+void WallOccupancyIndex::rebuild(Engine::Core::World& world) {
+  m_entries.clear();
+  m_centers.clear();
+  m_cells.clear();
+  m_owner_counts.clear();
+  m_owner_cells.clear();
+
+  std::unordered_set<Engine::Core::EntityID> watched;
+  const auto& registry = world.registry();
+  for (const auto ids : {registry.entities_with<WallSegmentComponent>(),
+                         registry.entities_with<WallConstructionSiteComponent>(),
+                         registry.entities_with<BuildingComponent>(),
+                         registry.entities_with<GateComponent>()}) {
+    watched.insert(ids.begin(), ids.end());
+  }
+  {
+    const std::lock_guard<std::mutex> lock(m_pending_mutex);
+    m_watched = std::move(watched);
+  }
+
+  for (auto [entity, wall, transform] :
+       world.entity_view<WallSegmentComponent, TransformComponent>()) {
+    (void)wall;
+    (void)transform;
+    reindex(&entity, entity.get_id());
+  }
+  for (auto [entity, unit, transform] :
+       world.entity_view<UnitComponent, TransformComponent>()) {
+    (void)transform;
+    if (unit.spawn_type == Game::Units::SpawnType::DefenseTower) {
+      reindex(&entity, entity.get_id());
+    }
+  }
+}
+
+void WallOccupancyIndex::count(const Entry& entry, int delta) {
+  const auto bump = [&entry, delta](CellCount& cell) {
+    switch (entry.kind) {
+    case Kind::Wall:
+      cell.built += delta;
+      break;
+    case Kind::Site:
+      cell.sites += delta;
+      break;
+    case Kind::Tower:
+      cell.towers += delta;
+      break;
+    }
+  };
+  const auto bump_key = [&bump](auto& counts, std::uint64_t key) -> bool {
+    auto it = counts.try_emplace(key).first;
+    const bool was_empty = it->second.total() == 0;
+    bump(it->second);
+    if (it->second.total() == 0) {
+      counts.erase(it);
+      return !was_empty;
+    }
+    return was_empty;
+  };
+
+  if (entry.kind != Kind::Tower) {
+    bump_key(m_centers, entry.center);
+    for (const auto key : entry.cells) {
+      bump_key(m_cells, key);
+    }
+  }
+  if (entry.owner_id <= 0) {
+    return;
+  }
+  auto& owner_counts = m_owner_counts[entry.owner_id];
+  auto& owner_cells = m_owner_cells[entry.owner_id];
+  for (const auto key : entry.cells) {
+    if (!bump_key(owner_counts, key)) {
+      continue;
+    }
+    if (delta > 0) {
+      owner_cells.insert(key);
+    } else {
+      owner_cells.erase(key);
+    }
+  }
+}
+
+auto WallOccupancyIndex::center_occupied(std::uint64_t key,
+                                         bool include_construction_sites,
+                                         Engine::Core::EntityID ignore_entity_id) const
+    -> bool {
+  const auto it = m_centers.find(key);
+  if (it == m_centers.end()) {
+    return false;
+  }
+  int walls = it->second.walls(include_construction_sites);
+  if (ignore_entity_id != 0) {
+    const auto ignored = m_entries.find(ignore_entity_id);
+    if (ignored != m_entries.end() && ignored->second.center == key &&
+        (ignored->second.kind == Kind::Wall ||
+         (ignored->second.kind == Kind::Site && include_construction_sites))) {
+      --walls;
+    }
+  }
+  return walls > 0;
+}
+
+auto WallOccupancyIndex::cell_occupied(std::uint64_t key,
+                                       bool include_construction_sites) const -> bool {
+  const auto it = m_cells.find(key);
+  return it != m_cells.end() && it->second.walls(include_construction_sites) > 0;
+}
+
+void WallOccupancyIndex::collect_cells(WallNetworkService::OccupancySet& out,
+                                       bool include_construction_sites) const {
+  for (const auto& [key, cell] : m_cells) {
+    if (cell.walls(include_construction_sites) > 0) {
+      out.insert(key);
+    }
+  }
 }
 
+void WallOccupancyIndex::collect_owner_cells(WallNetworkService::OwnerOccupancyMap& out,
+                                             bool include_construction_sites,
+                                             bool include_towers) const {
+  for (const auto& [owner_id, counts] : m_owner_counts) {
+    for (const auto& [key, cell] : counts) {
+      if (cell.walls(include_construction_sites) > 0 ||
+          (include_towers && cell.towers > 0)) {
+        out[owner_id].insert(key);
+      }
+    }
+  }
+}
+
+auto WallOccupancyIndex::owner_cells(int owner_id) const
+    -> const WallNetworkService::OccupancySet* {
+  const auto it = m_owner_cells.find(owner_id);
+  return it != m_owner_cells.end() ? &it->second : nullptr;
+}
+
+// Holds a world's index locked and brought up to date for a run of reads.
+class SyncedWallOccupancy {
+public:
+  explicit SyncedWallOccupancy(Engine::Core::World& world)
+      : m_index(WallOccupancyIndex::of(world))
+      , m_lock(m_index->mutex()) {
+    m_index->sync(world);
+  }
+
+  auto operator->() const -> const WallOccupancyIndex* { return m_index.get(); }
+
+private:
+  std::shared_ptr<WallOccupancyIndex> m_index;
+  std::unique_lock<std::mutex> m_lock;
+};
+
 auto circle_overlaps_footprint(const BuildingFootprint& building,
                                float x,
                                float z,
@@ -192,25 +590,28 @@ auto collides_with_registered_building(Engine::Core::World& world,
   }
 
   static constexpr float k_touch_epsilon = 1.0e-4F;
-  for (const auto& building : collision_registry.get_all_buildings()) {
-    if (ignore_entity_id != 0 && building.entity_id == ignore_entity_id) {
-      continue;
-    }
-
-    float distance_sq = 0.0F;
-    if (!circle_overlaps_footprint(building, pos_x, pos_z, radius, &distance_sq)) {
-      continue;
-    }
+  bool collides = false;
+  collision_registry.for_each_building_in_region(
+      pos_x - radius,
+      pos_x + radius,
+      pos_z - radius,
+      pos_z + radius,
+      [&](const BuildingFootprint& building) {
+        if (collides ||
+            (ignore_entity_id != 0 && building.entity_id == ignore_entity_id)) {
+          return;
+        }
 
-    Engine::Core::Entity* entity = world.get_entity(building.entity_id);
-    if (entity_allows_wall_boundary_touch(entity) &&
-        distance_sq + k_touch_epsilon >= radius * radius) {
-      continue;
-    }
-    return true;
-  }
+        float distance_sq = 0.0F;
+        if (!circle_overlaps_footprint(building, pos_x, pos_z, radius, &distance_sq)) {
+          return;
+        }
 
-  return false;
+        Engine::Core::Entity* entity = world.get_entity(building.entity_id);
+        collides = !entity_allows_wall_boundary_touch(entity) ||
+                   distance_sq + k_touch_epsilon < radius * radius;
+      });
+  return collides;
 }
 
 auto is_buildable_world_position(float pos_x,
@@ -262,24 +663,10 @@ auto is_wall_key_occupied(Engine::Core::World& world,
                           int grid_z,
                           bool include_construction_sites,
                           Engine::Core::EntityID ignore_entity_id = 0) -> bool {
-  for (auto [entity, wall_ref, transform_ref] :
-       world.entity_view<WallSegmentComponent, TransformComponent>()) {
-    auto* wall = &wall_ref;
-    const auto* transform = &transform_ref;
-    if (entity.get_id() == ignore_entity_id ||
-        !is_live_wall_entity(&entity, include_construction_sites)) {
-      continue;
-    }
-
-    const auto snapped = WallNetworkService::snap_world_position(transform->position.x,
-                                                                 transform->position.z);
-    wall->grid_x = snapped.x;
-    wall->grid_z = snapped.z;
-    if (snapped.x == grid_x && snapped.z == grid_z) {
-      return true;
-    }
-  }
-  return false;
+  const SyncedWallOccupancy occupancy(world);
+  return occupancy->center_occupied(WallNetworkService::encode_key(grid_x, grid_z),
+                                    include_construction_sites,
+                                    ignore_entity_id);
 }
 
 auto canonical_variant_for_mask(std::uint8_t mask)
@@ -456,22 +843,8 @@ auto WallNetworkService::encode_key(int grid_x, int grid_z) -> std::uint64_t {
 void WallNetworkService::add_world_occupancy(Engine::Core::World& world,
                                              OccupancySet& out,
                                              bool include_construction_sites) {
-  for (auto [entity, wall_ref, transform_ref] :
-       world.entity_view<WallSegmentComponent, TransformComponent>()) {
-    auto* wall = &wall_ref;
-    const auto* transform = &transform_ref;
-    if (!is_live_wall_entity(&entity, include_construction_sites)) {
-      continue;
-    }
-
-    const auto snapped =
-        snap_world_position(transform->position.x, transform->position.z);
-    wall->grid_x = snapped.x;
-    wall->grid_z = snapped.z;
-    for (const auto& cell : wall_network_cells(&entity, snapped)) {
-      out.insert(encode_key(cell.x, cell.z));
-    }
-  }
+  const SyncedWallOccupancy occupancy(world);
+  occupancy->collect_cells(out, include_construction_sites);
 }
 
 void WallNetworkService::build_connection_occupancy(Engine::Core::World& world,
@@ -479,43 +852,26 @@ void WallNetworkService::build_connection_occupancy(Engine::Core::World& world,
                                                     bool include_construction_sites,
                                                     bool include_towers) {
   out.clear();
+  const SyncedWallOccupancy occupancy(world);
+  occupancy->collect_owner_cells(out, include_construction_sites, include_towers);
+}
 
-  for (auto [entity, wall_ref, transform_ref] :
-       world.entity_view<WallSegmentComponent, TransformComponent>()) {
-    auto* wall = &wall_ref;
-    const auto* transform = &transform_ref;
-    if (!is_live_wall_entity(&entity, include_construction_sites)) {
-      continue;
-    }
-
-    auto owner_id = resolve_wall_network_owner_id(&entity);
-    if (!owner_id.has_value()) {
-      continue;
-    }
-
-    const auto snapped =
-        snap_world_position(transform->position.x, transform->position.z);
-    wall->grid_x = snapped.x;
-    wall->grid_z = snapped.z;
-    for (const auto& cell : wall_network_cells(&entity, snapped)) {
-      add_owner_occupancy(out, *owner_id, cell.x, cell.z);
-    }
-  }
-
-  if (!include_towers) {
-    return;
-  }
-
-  for (auto [entity, unit, transform] :
-       world.entity_view<UnitComponent, TransformComponent>()) {
-    if (!is_live_tower_socket_entity(&entity)) {
-      continue;
-    }
+auto WallNetworkService::is_cell_occupied(Engine::Core::World& world,
+                                          int grid_x,
+                                          int grid_z,
+                                          bool include_construction_sites) -> bool {
+  const SyncedWallOccupancy occupancy(world);
+  return occupancy->cell_occupied(encode_key(grid_x, grid_z),
+                                  include_construction_sites);
+}
 
-    const auto snapped =
-        snap_world_position(transform.position.x, transform.position.z);
-    add_owner_occupancy(out, unit.owner_id, snapped.x, snapped.z);
-  }
+auto WallNetworkService::owner_connection_mask(Engine::Core::World& world,
+                                               int owner_id,
+                                               int grid_x,
+                                               int grid_z) -> std::uint8_t {
+  const SyncedWallOccupancy occupancy(world);
+  const auto* cells = occupancy->owner_cells(owner_id);
+  return cells != nullptr ? compute_connection_mask(*cells, grid_x, grid_z) : 0U;
 }
 
 auto WallNetworkService::compute_connection_mask(const OccupancySet& occupancy,
@@ -592,16 +948,14 @@ auto WallNetworkService::find_tower_snap_socket(Engine::Core::World& world,
     return std::nullopt;
   }
 
-  OwnerOccupancyMap connection_occupancy;
-  build_connection_occupancy(world, connection_occupancy, true, true);
-
-  const auto owner_it = connection_occupancy.find(owner_id);
-  if (owner_it == connection_occupancy.end() || owner_it->second.empty()) {
+  const SyncedWallOccupancy occupancy(world);
+  const auto* owner_cells = occupancy->owner_cells(owner_id);
+  if (owner_cells == nullptr || owner_cells->empty()) {
     return std::nullopt;
   }
 
   OccupancySet candidate_keys;
-  for (const auto key : owner_it->second) {
+  for (const auto key : *owner_cells) {
     const auto base = decode_key(key);
     candidate_keys.insert(encode_key(base.x, base.z - k_segment_spacing));
     candidate_keys.insert(encode_key(base.x + k_segment_spacing, base.z));
@@ -614,14 +968,12 @@ auto WallNetworkService::find_tower_snap_socket(Engine::Core::World& world,
   std::optional<WallGridPosition> best_position;
 
   for (const auto key : candidate_keys) {
-    if (owner_it->second.find(key) != owner_it->second.end()) {
+    if (owner_cells->find(key) != owner_cells->end() ||
+        occupancy->center_occupied(key, true, 0)) {
       continue;
     }
 
     const auto candidate = decode_key(key);
-    if (is_wall_key_occupied(world, candidate.x, candidate.z, true, 0)) {
-      continue;
-    }
 
     const auto candidate_world =
         NavGrid::grid_to_world(Point{candidate.x, candidate.z});
@@ -677,21 +1029,20 @@ auto WallNetworkService::resolve_appearance(Game::Systems::NationID nation_id,
 namespace {
 
 auto blocking_building_covers(float world_x, float world_z) -> bool {
-  for (const auto& building :
-       BuildingCollisionRegistry::instance().get_all_buildings()) {
-    if (!building.blocks_navigation) {
-      continue;
-    }
-    const float half_width = building.width / 2.0F;
-    const float half_depth = building.depth / 2.0F;
-    if (world_x >= building.center_x - half_width &&
-        world_x <= building.center_x + half_width &&
-        world_z >= building.center_z - half_depth &&
-        world_z <= building.center_z + half_depth) {
-      return true;
-    }
-  }
-  return false;
+  bool covered = false;
+  BuildingCollisionRegistry::instance().for_each_building_in_region(
+      world_x, world_x, world_z, world_z, [&](const BuildingFootprint& building) {
+        if (covered || !building.blocks_navigation) {
+          return;
+        }
+        const float half_width = building.width / 2.0F;
+        const float half_depth = building.depth / 2.0F;
+        covered = world_x >= building.center_x - half_width &&
+                  world_x <= building.center_x + half_width &&
+                  world_z >= building.center_z - half_depth &&
+                  world_z <= building.center_z + half_depth;
+      });
+  return covered;
 }
 
 auto collect_navigation_passages(
@@ -791,7 +1142,14 @@ auto collect_navigation_passages(
 
 } // namespace
 
+auto WallNetworkService::pending_occupancy_updates_for_test(Engine::Core::World& world)
+    -> std::size_t {
+  return WallOccupancyIndex::of(world)->pending_updates();
+}
+
 void WallNetworkService::refresh_world(Engine::Core::World& world) {
+  auto index = WallOccupancyIndex::of(world);
+  index->invalidate_all();
   OwnerOccupancyMap connection_occupancy;
   build_connection_occupancy(world, connection_occupancy, true, true);
   OccupancySet const empty_occupancy;
@@ -817,7 +1175,13 @@ void WallNetworkService::refresh_world(Engine::Core::World& world) {
     }
     const auto mask =
         compute_connection_mask(occupancy, wall->grid_x, wall->grid_z, self_cells);
+    const auto* transform = entity.get_component<TransformComponent>();
+    const float rotation_before = transform != nullptr ? transform->rotation.y : 0.0F;
     update_wall_entity_visuals(&entity, wall, mask);
+    if (transform != nullptr && transform->rotation.y != rotation_before) {
+      // A turned gate spans different cells.
+      index->invalidate(entity.get_id());
+    }
   }
 
   BuildingCollisionRegistry::instance().set_navigation_passages(
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -62,6 +63,16 @@ public:
                                          OwnerOccupancyMap& out,
                                          bool include_construction_sites = true,
                                          bool include_towers = true);
+  // Hash probes against the world's wall occupancy index, which follows
+  // component adds and removes between queries.
+  static auto is_cell_occupied(Engine::Core::World& world,
+                               int grid_x,
+                               int grid_z,
+                               bool include_construction_sites = true) -> bool;
+  static auto owner_connection_mask(Engine::Core::World& world,
+                                    int owner_id,
+                                    int grid_x,
+                                    int grid_z) -> std::uint8_t;
   static auto compute_connection_mask(const OccupancySet& occupancy,
                                       int grid_x,
                                       int grid_z) -> std::uint8_t;
@@ -89,6 +100,10 @@ public:
                                       float current_rotation_y) -> WallAppearance;
 
   static void refresh_world(Engine::Core::World& world);
+
+  // Entity updates the occupancy index has queued for its next query.
+  static auto pending_occupancy_updates_for_test(Engine::Core::World& world)
+      -> std::size_t;
 };
 
 } // namespace Game::Systems
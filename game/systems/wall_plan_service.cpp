@@ -57,11 +57,8 @@ auto WallPlanService::plan(Engine::Core::World& world,
                                   : WallNetworkService::build_axis_aligned_chain(
                                         request.anchor, request.target);
 
-  WallNetworkService::OccupancySet occupancy;
-  WallNetworkService::add_world_occupancy(world, occupancy, true);
-  WallNetworkService::OwnerOccupancyMap connection_occupancy_by_owner;
-  WallNetworkService::build_connection_occupancy(
-      world, connection_occupancy_by_owner, true, true);
+  // Segments accepted so far; the world's walls come from its occupancy index.
+  WallNetworkService::OccupancySet planned;
 
   int available_wood =
       PlayerResourceRegistry::instance().get(request.owner_id, ResourceType::Wood);
@@ -73,7 +70,8 @@ auto WallPlanService::plan(Engine::Core::World& world,
     segment.grid_z = grid_pos.z;
     segment.world_position = NavGrid::grid_to_world(Point{grid_pos.x, grid_pos.z});
 
-    if (occupancy.find(key) != occupancy.end()) {
+    if (planned.contains(key) ||
+        WallNetworkService::is_cell_occupied(world, grid_pos.x, grid_pos.z)) {
       segment.fault = WallSegmentFault::Occupied;
     } else if (const auto validation =
                    WallNetworkService::validate_wall_segment_placement(
@@ -87,26 +85,19 @@ auto WallPlanService::plan(Engine::Core::World& world,
       segment.valid = true;
       ++plan.valid_count;
       available_wood -= plan.wood_per_segment;
-      occupancy.insert(key);
+      planned.insert(key);
     }
     plan.segments.push_back(segment);
   }
 
   const auto nation_id = nation_of(request.owner_id);
-  auto preview_occupancy = connection_occupancy_by_owner.contains(request.owner_id)
-                               ? connection_occupancy_by_owner.at(request.owner_id)
-                               : WallNetworkService::OccupancySet{};
-  for (const auto& segment : plan.segments) {
-    if (segment.valid) {
-      preview_occupancy.insert(
-          WallNetworkService::encode_key(segment.grid_x, segment.grid_z));
-    }
-  }
-
   auto& terrain = Game::Map::TerrainService::instance();
   for (auto& segment : plan.segments) {
-    segment.connection_mask = WallNetworkService::compute_connection_mask(
-        preview_occupancy, segment.grid_x, segment.grid_z);
+    segment.connection_mask =
+        WallNetworkService::owner_connection_mask(
+            world, request.owner_id, segment.grid_x, segment.grid_z) |
+        WallNetworkService::compute_connection_mask(
+            planned, segment.grid_x, segment.grid_z);
     const auto appearance =
         request.gate ? WallNetworkService::resolve_gate_appearance(
                            nation_id, segment.connection_mask, request.rotation_y)
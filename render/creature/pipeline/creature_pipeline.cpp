@@ -80,12 +80,10 @@ void ensure_skin_atlas_for_submit(Render::GL::RiggedMeshCache& cache,
                                   const Render::GL::RiggedMeshEntry& entry,
                                   const Render::Creature::Bpat::BpatBlob& blob) {
   const auto* atlas = entry.skin_atlas.get();
-  const bool had_atlas = atlas != nullptr && atlas->frame_total == blob.frame_total() &&
-                         atlas->bone_count != 0U && !atlas->palettes.empty();
+  const bool had_atlas = atlas != nullptr && atlas->ready() && atlas->blob == &blob;
   Render::GL::rigged_entry_ensure_skin_atlas_from_blob(entry, blob);
   atlas = entry.skin_atlas.get();
-  if (!had_atlas && atlas != nullptr && atlas->frame_total == blob.frame_total() &&
-      atlas->bone_count != 0U && !atlas->palettes.empty()) {
+  if (!had_atlas && atlas != nullptr && atlas->ready() && atlas->blob == &blob) {
     cache.record_skin_atlas_build();
   }
 }
@@ -100,13 +98,20 @@ void ensure_skin_ubo_for_submit(Render::GL::RiggedMeshCache& cache,
                        Render::GL::BonePaletteArena::k_palette_bytes;
     cache.record_skin_ubo_upload(bytes);
   } else if (entry.skin_atlas != nullptr && entry.skin_atlas->palette_ubo == 0U &&
-             !entry.skin_atlas->palettes.empty() &&
-             entry.skin_atlas->frame_total != 0U &&
-             entry.skin_atlas->bone_count != 0U) {
+             entry.skin_atlas->ready()) {
     cache.mark_skin_ubo_upload_pending();
   }
 }
 
+void ensure_skin_frame_for_submit(Render::GL::RiggedMeshCache& cache,
+                                  const Render::GL::RiggedMeshEntry& entry,
+                                  std::uint32_t global_frame) {
+  auto const bytes = Render::GL::rigged_entry_ensure_skin_frame(entry, global_frame);
+  if (bytes != 0U) {
+    cache.record_skin_ubo_upload(bytes);
+  }
+}
+
 auto make_snapshot_key(const CreatureRenderAssetHandle& handle,
                        ArchetypeId archetype,
                        VariantId variant,
@@ -269,15 +274,11 @@ auto resolve_request_playback(const CreatureRenderAssetHandle& primary_handle,
 }
 
 auto frame_palette_for_global_frame(const Render::GL::RiggedMeshEntry& entry,
-                                    std::uint32_t global_frame) noexcept
-    -> const QMatrix4x4* {
-  if (entry.skin_atlas == nullptr || entry.skin_atlas->palettes.empty() ||
-      entry.skin_atlas->bone_count == 0 ||
-      global_frame >= entry.skin_atlas->frame_total) {
+                                    std::uint32_t global_frame) -> const QMatrix4x4* {
+  if (entry.skin_atlas == nullptr) {
     return nullptr;
   }
-  return entry.skin_atlas->palettes.data() +
-         static_cast<std::size_t>(global_frame) * entry.skin_atlas->bone_count;
+  return entry.skin_atlas->frame_palette(global_frame);
 }
 
 auto is_humanoid_upper_body_bone(std::size_t bone_index) noexcept -> bool {
@@ -303,54 +304,45 @@ auto is_humanoid_upper_body_bone(std::size_t bone_index) noexcept -> bool {
 using BonePaletteArray =
     std::array<QMatrix4x4, Render::GL::RiggedCreatureCmd::k_max_owned_bones>;
 
-template <class T>
-struct PooledPaletteAllocator {
-  using value_type = T;
-
-  PooledPaletteAllocator() noexcept = default;
-  template <class U>
-  PooledPaletteAllocator(const PooledPaletteAllocator<U>&) noexcept {}
-
-  static auto free_list() noexcept -> std::vector<void*>& {
-    thread_local auto* list = new std::vector<void*>();
-    return *list;
-  }
-
-  auto allocate(std::size_t n) -> T* {
-    if (n == 1U) {
-      auto& list = free_list();
-      if (!list.empty()) {
-        void* block = list.back();
-        list.pop_back();
-        return static_cast<T*>(block);
-      }
-      return static_cast<T*>(::operator new(sizeof(T)));
+class FramePaletteArena {
+public:
+  auto allocate() -> BonePaletteArray* {
+    std::uint32_t const now = Render::GL::humanoid_current_frame();
+    Generation& generation = m_generations[now % k_generations];
+    if (generation.frame != now) {
+      generation.frame = now;
+      generation.used = 0;
     }
-    return static_cast<T*>(::operator new(n * sizeof(T)));
-  }
-
-  void deallocate(T* ptr, std::size_t n) noexcept {
-    if (n == 1U) {
-      auto& list = free_list();
-      try {
-        list.push_back(static_cast<void*>(ptr));
-        return;
-      } catch (...) {
-      }
+    std::size_t const page = generation.used / k_palettes_per_page;
+    if (page == generation.pages.size()) {
+      generation.pages.push_back(std::make_unique<Page>());
     }
-    ::operator delete(static_cast<void*>(ptr));
+    BonePaletteArray* palette =
+        &(*generation.pages[page])[generation.used % k_palettes_per_page];
+    ++generation.used;
+    return palette;
   }
 
-  template <class U>
-  auto operator==(const PooledPaletteAllocator<U>&) const noexcept -> bool {
-    return true;
-  }
-  template <class U>
-  auto operator!=(const PooledPaletteAllocator<U>&) const noexcept -> bool {
-    return false;
-  }
+private:
+  static constexpr std::size_t k_generations =
+      Render::GL::RiggedCreatureCmd::k_frame_palette_generations;
+  static constexpr std::size_t k_palettes_per_page = 32U;
+  using Page = std::array<BonePaletteArray, k_palettes_per_page>;
+
+  struct Generation {
+    std::uint32_t frame{std::numeric_limits<std::uint32_t>::max()};
+    std::size_t used{0};
+    std::vector<std::unique_ptr<Page>> pages;
+  };
+
+  std::array<Generation, k_generations> m_generations{};
 };
 
+auto palette_arena() -> FramePaletteArena& {
+  thread_local FramePaletteArena arena;
+  return arena;
+}
+
 constexpr std::uint32_t k_blend_weight_buckets = 32U;
 
 auto blend_weight_bucket(float weight) noexcept -> std::uint32_t {
@@ -363,7 +355,7 @@ auto blend_bucket_weight(std::uint32_t bucket) noexcept -> float {
   return static_cast<float>(bucket) / static_cast<float>(k_blend_weight_buckets - 1U);
 }
 
-using OwnedPalette = std::shared_ptr<BonePaletteArray>;
+using FramePalette = const BonePaletteArray*;
 using LocalPose = std::array<Render::Creature::Bpat::LocalBonePose,
                              Render::GL::RiggedCreatureCmd::k_max_owned_bones>;
 
@@ -418,14 +410,13 @@ auto sample_local_pose(const Render::Creature::Bpat::BpatBlob& blob,
 
 auto skin_palette_from_local_pose(const Render::Creature::Bpat::BpatBlob& blob,
                                   const LocalPose& pose,
-                                  std::uint32_t bone_count) -> OwnedPalette {
+                                  std::uint32_t bone_count) -> FramePalette {
   auto const parents = blob.bone_parents();
   auto const inverse_bind = blob.inverse_bind_palette();
   if (parents.size() < bone_count || inverse_bind.size() < bone_count) {
     return {};
   }
-  auto owned = std::allocate_shared<BonePaletteArray>(
-      PooledPaletteAllocator<BonePaletteArray>{});
+  BonePaletteArray* owned = palette_arena().allocate();
   BonePaletteArray global{};
   for (std::uint32_t bone = 0; bone < bone_count; ++bone) {
     QMatrix4x4 local;
@@ -453,7 +444,7 @@ struct PaletteBlendKey {
 class PaletteBlendCache {
 public:
   template <typename Compute>
-  auto get_or_compute(const PaletteBlendKey& key, Compute&& compute) -> OwnedPalette {
+  auto get_or_compute(const PaletteBlendKey& key, Compute&& compute) -> FramePalette {
     if (std::uint32_t const now = Render::GL::humanoid_current_frame();
         now != m_frame) {
       m_frame = now;
@@ -485,7 +476,7 @@ private:
   struct Slot {
     PaletteBlendKey key{};
     std::uint32_t frame{std::numeric_limits<std::uint32_t>::max()};
-    OwnedPalette palette{};
+    FramePalette palette{nullptr};
   };
 
   static auto hash(const PaletteBlendKey& key) noexcept -> std::size_t {
@@ -566,17 +557,13 @@ void resolve_bone_probe(const Render::Creature::CreatureRenderRequest& req,
   probe->resolved = true;
 }
 
-void attach_owned_palette(
-    Render::GL::RiggedCreatureCmd& cmd,
-    std::shared_ptr<
-        std::array<QMatrix4x4, Render::GL::RiggedCreatureCmd::k_max_owned_bones>>
-        owned_palette,
-    std::uint32_t bone_count) {
-  if (!owned_palette) {
+void attach_frame_palette(Render::GL::RiggedCreatureCmd& cmd,
+                          FramePalette palette,
+                          std::uint32_t bone_count) {
+  if (palette == nullptr) {
     return;
   }
-  cmd.owned_bone_palette = std::move(owned_palette);
-  cmd.bone_palette = cmd.owned_bone_palette->data();
+  cmd.bone_palette = palette->data();
   cmd.bone_count = std::min<std::uint32_t>(
       bone_count, Render::GL::RiggedCreatureCmd::k_max_owned_bones);
   cmd.palette_ubo = 0U;
@@ -643,6 +630,8 @@ void submit_rigged_creature(const CreatureRenderAssetHandle& handle,
   ensure_skin_atlas_for_submit(cache, *entry, blob);
   if (renderer != nullptr) {
     ensure_skin_ubo_for_submit(cache, *entry);
+    ensure_skin_frame_for_submit(cache, *entry, global_frame);
+    ensure_skin_frame_for_submit(cache, *entry, primary_playback.next_global_frame);
   }
 
   const bool wants_layered_pose =
@@ -655,9 +644,9 @@ void submit_rigged_creature(const CreatureRenderAssetHandle& handle,
     return;
   }
   const bool frames_resident =
-      skin_atlas->palette_ubo != 0U && skin_atlas->frame_total != 0U &&
-      global_frame < skin_atlas->frame_total &&
-      primary_playback.next_global_frame < skin_atlas->frame_total;
+      Render::GL::rigged_entry_skin_frame_resident(*entry, global_frame) &&
+      Render::GL::rigged_entry_skin_frame_resident(*entry,
+                                                   primary_playback.next_global_frame);
   const bool use_resident_frames = frames_resident && !wants_layered_pose;
 
   const QMatrix4x4* frame_palette =
@@ -676,9 +665,8 @@ void submit_rigged_creature(const CreatureRenderAssetHandle& handle,
                              wear_params,
                              material_id_for_species(handle.archetype->species));
 
-  const bool skin_ubo_covers_frame = skin_atlas->palette_ubo != 0U &&
-                                     skin_atlas->frame_total != 0U &&
-                                     global_frame < skin_atlas->frame_total;
+  const bool skin_ubo_covers_frame =
+      Render::GL::rigged_entry_skin_frame_resident(*entry, global_frame);
   if (skin_ubo_covers_frame) {
     cmd.palette_ubo = skin_atlas->palette_ubo;
     cmd.palette_offset = static_cast<std::uint32_t>(
@@ -726,7 +714,7 @@ void submit_rigged_creature(const CreatureRenderAssetHandle& handle,
     const std::uint32_t bone_count = std::min<std::uint32_t>(
         skin_atlas->bone_count, Render::GL::RiggedCreatureCmd::k_max_owned_bones);
     const auto species_kind = handle.archetype->species;
-    OwnedPalette owned = blend_cache().get_or_compute(key, [&]() -> OwnedPalette {
+    FramePalette owned = blend_cache().get_or_compute(key, [&]() -> FramePalette {
       LocalPose pose{};
       if (!sample_local_pose(blob, primary_playback, bone_count, species_kind, pose)) {
         return {};
@@ -753,9 +741,7 @@ void submit_rigged_creature(const CreatureRenderAssetHandle& handle,
       }
       return skin_palette_from_local_pose(blob, pose, bone_count);
     });
-    if (owned) {
-      attach_owned_palette(cmd, std::move(owned), bone_count);
-    }
+    attach_frame_palette(cmd, owned, bone_count);
   }
   auto& animation_diagnostics =
       Render::Profiling::CombatAnimationDiagnostics::instance();
@@ -1001,8 +987,7 @@ auto submit_snapshot_creature(
   }
 
   ensure_skin_atlas_for_submit(rigged_cache, *source, blob);
-  if (source->skin_atlas == nullptr || source->skin_atlas->palettes.empty() ||
-      source->skin_atlas->bone_count == 0 ||
+  if (source->skin_atlas == nullptr || !source->skin_atlas->ready() ||
       global_frame >= source->skin_atlas->frame_total) {
     return false;
   }
@@ -47,7 +47,7 @@ enum class DrawCmdType : std::uint8_t {
   FogBatch = static_cast<std::uint8_t>(cmd_index_of<FogBatchCmd>),
   TerrainScatter = static_cast<std::uint8_t>(cmd_index_of<TerrainScatterCmd>),
   RainBatch = static_cast<std::uint8_t>(cmd_index_of<RainBatchCmd>),
-  TerrainSurface = static_cast<std::uint8_t>(cmd_index_of<TerrainSurfaceCmd>),
+  TerrainSurface = static_cast<std::uint8_t>(cmd_index_of<TerrainSurfaceRef>),
   TerrainFeature = static_cast<std::uint8_t>(cmd_index_of<TerrainFeatureCmd>),
   PrimitiveBatch = static_cast<std::uint8_t>(cmd_index_of<PrimitiveBatchCmd>),
   EffectBatch = static_cast<std::uint8_t>(cmd_index_of<EffectBatchCmd>),
@@ -64,7 +64,7 @@ constexpr std::size_t CylinderCmdIndex = cmd_index_of<CylinderCmd>;
 constexpr std::size_t FogBatchCmdIndex = cmd_index_of<FogBatchCmd>;
 constexpr std::size_t TerrainScatterCmdIndex = cmd_index_of<TerrainScatterCmd>;
 constexpr std::size_t RainBatchCmdIndex = cmd_index_of<RainBatchCmd>;
-constexpr std::size_t TerrainSurfaceCmdIndex = cmd_index_of<TerrainSurfaceCmd>;
+constexpr std::size_t TerrainSurfaceCmdIndex = cmd_index_of<TerrainSurfaceRef>;
 constexpr std::size_t TerrainFeatureCmdIndex = cmd_index_of<TerrainFeatureCmd>;
 constexpr std::size_t PrimitiveBatchCmdIndex = cmd_index_of<PrimitiveBatchCmd>;
 constexpr std::size_t EffectBatchCmdIndex = cmd_index_of<EffectBatchCmd>;
@@ -124,7 +124,7 @@ struct DrawCmdTraits<RainBatchCmd> {
   static constexpr RenderPassOrder pass = RenderPassOrder::RainBatch;
 };
 template <>
-struct DrawCmdTraits<TerrainSurfaceCmd> {
+struct DrawCmdTraits<TerrainSurfaceRef> {
   static constexpr RenderPassOrder pass = RenderPassOrder::TerrainSurface;
 };
 template <>
@@ -148,6 +148,14 @@ struct TerrainSurfaceCmd {
 
   using VisibilityResources = VisibilityMaskResources;
 
+  // Vertices blend toward the lattice `step` height texels apart as their
+  // distance to the camera goes from `start` to `end`; a zero step disables it.
+  struct LodMorph {
+    float start = 0.0F;
+    float end = 0.0F;
+    float step = 0.0F;
+  };
+
   Mesh* mesh = nullptr;
   const Material* material = nullptr;
   QMatrix4x4 model;
@@ -155,6 +163,7 @@ struct TerrainSurfaceCmd {
   TerrainChunkParams params;
   HeightResources height{};
   VisibilityResources visibility{};
+  LodMorph lod_morph{};
   std::uint16_t sort_key = 0x8000U;
   bool depth_write = true;
   bool wireframe = false;
@@ -164,6 +173,11 @@ struct TerrainSurfaceCmd {
   CommandPriority priority{CommandPriority::High};
 };
 
+struct TerrainSurfaceRef {
+  std::uint32_t slot = 0;
+  CommandPriority priority{CommandPriority::High};
+};
+
 struct TerrainFeatureCmd {
   Mesh* mesh = nullptr;
   QMatrix4x4 model;
@@ -192,7 +206,6 @@ struct TerrainFeatureCmd {
 struct GridCmd {
 
   QMatrix4x4 model;
-  QMatrix4x4 mvp;
   QVector3D color{0.2F, 0.25F, 0.2F};
   float cell_size = 1.0F;
   float thickness = 0.06F;
@@ -216,7 +229,6 @@ struct GroundMarkerCmd {
 
 struct SelectionSmokeCmd {
   QMatrix4x4 model;
-  QMatrix4x4 mvp;
   QVector3D color{1, 1, 1};
   float base_alpha = 0.15F;
   CommandPriority priority{CommandPriority::Critical};
@@ -260,7 +272,6 @@ struct EffectBatchCmd {
 
 struct ModeIndicatorCmd {
   QMatrix4x4 model;
-  QMatrix4x4 mvp;
   QVector3D color{1.0F, 1.0F, 1.0F};
   float alpha = 1.0F;
   int mode_type = 0;
@@ -270,6 +281,8 @@ struct ModeIndicatorCmd {
 struct RiggedCreatureCmd {
   static constexpr std::size_t k_max_role_colors = Render::RoleColorPalette::k_capacity;
   static constexpr std::size_t k_max_owned_bones = 64;
+  // Humanoid frames an arena bone_palette stays valid for, its own included.
+  static constexpr std::uint32_t k_frame_palette_generations = 3;
 
   RiggedMesh* mesh = nullptr;
 
@@ -279,7 +292,6 @@ struct RiggedCreatureCmd {
 
   const QMatrix4x4* bone_palette = nullptr;
   const QMatrix4x4* bone_palette_next = nullptr;
-  std::shared_ptr<std::array<QMatrix4x4, k_max_owned_bones>> owned_bone_palette{};
 
   std::uint32_t palette_ubo = 0;
   std::uint32_t palette_offset = 0;
@@ -306,7 +318,7 @@ using DrawCmd = std::variant<GridCmd,
                              FogBatchCmd,
                              TerrainScatterCmd,
                              RainBatchCmd,
-                             TerrainSurfaceCmd,
+                             TerrainSurfaceRef,
                              TerrainFeatureCmd,
                              PrimitiveBatchCmd,
                              EffectBatchCmd,
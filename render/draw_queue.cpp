@@ -4,7 +4,9 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <limits>
+#include <numeric>
 #include <variant>
 
 namespace Render::GL {
@@ -16,6 +18,7 @@ void DrawQueue::clear() {
       std::max(m_submission_bucket_high_water, m_submission_bucket_spans.size());
   m_local_light_high_water = std::max(m_local_light_high_water, m_local_lights.size());
   m_items.clear();
+  m_terrain_surfaces.clear();
   m_sort_indices.clear();
   m_sort_keys.clear();
   m_prepared_batches.clear();
@@ -24,6 +27,24 @@ void DrawQueue::clear() {
   m_local_lights.clear();
 }
 
+void DrawQueue::submit(const TerrainSurfaceCmd& cmd) {
+  m_terrain_surfaces.push_back(cmd);
+  submit(TerrainSurfaceRef{
+      .slot = static_cast<std::uint32_t>(m_terrain_surfaces.size() - 1U),
+      .priority = cmd.priority});
+}
+
+void DrawQueue::submit_staged(DrawQueue& staging, std::size_t begin, std::size_t end) {
+  for (std::size_t i = begin; i < end; ++i) {
+    DrawCmd& cmd = staging.m_items[i];
+    if (const auto* ref = std::get_if<TerrainSurfaceCmdIndex>(&cmd)) {
+      submit(staging.terrain_surface(*ref));
+      continue;
+    }
+    submit(std::move(cmd));
+  }
+}
+
 void DrawQueue::submit_local_light(const LocalLight& light) {
   if (m_local_lights.capacity() < m_local_light_high_water) {
     m_local_lights.reserve(m_local_light_high_water);
@@ -49,14 +70,9 @@ void DrawQueue::reserve_for_frame(std::size_t items_hint) {
 void DrawQueue::sort_for_batching() {
   const std::size_t count = m_items.size();
 
-  m_sort_keys.resize(count);
   m_sort_indices.resize(count);
   m_prepared_batches.clear();
-
-  for (std::size_t i = 0; i < count; ++i) {
-    m_sort_indices[i] = static_cast<uint32_t>(i);
-    m_sort_keys[i] = compute_sort_key(m_items[i]);
-  }
+  std::iota(m_sort_indices.begin(), m_sort_indices.end(), std::uint32_t{0});
 
   if (count >= 2) {
     if (!m_submission_bucket_ordered || !sort_bucketed_ranges(count)) {
@@ -88,7 +104,53 @@ auto DrawQueue::can_batch_mesh(std::size_t sorted_idx_a,
          mesh_a.blend_batchable == mesh_b.blend_batchable;
 }
 
+void DrawQueue::merge_shards(std::span<DrawQueue> shards) {
+  std::size_t total = m_items.size();
+  for (const DrawQueue& shard : shards) {
+    total += shard.m_items.size();
+  }
+  if (total > m_items.capacity()) {
+    m_items.reserve(total);
+    m_sort_keys.reserve(total);
+    m_sort_indices.reserve(total);
+  }
+
+  for (DrawQueue& shard : shards) {
+    const std::size_t offset = m_items.size();
+    if (!shard.m_submission_bucket_ordered) {
+      m_submission_bucket_ordered = false;
+    }
+    for (SubmissionBucketSpan span : shard.m_submission_bucket_spans) {
+      span.start += offset;
+      append_submission_span(span);
+    }
+    m_items.insert(m_items.end(),
+                   std::make_move_iterator(shard.m_items.begin()),
+                   std::make_move_iterator(shard.m_items.end()));
+    if (!shard.m_terrain_surfaces.empty()) {
+      const auto surface_base = static_cast<std::uint32_t>(m_terrain_surfaces.size());
+      m_terrain_surfaces.insert(m_terrain_surfaces.end(),
+                                shard.m_terrain_surfaces.begin(),
+                                shard.m_terrain_surfaces.end());
+      for (std::size_t i = offset; i < m_items.size(); ++i) {
+        if (auto* ref = std::get_if<TerrainSurfaceCmdIndex>(&m_items[i])) {
+          ref->slot += surface_base;
+        }
+      }
+    }
+    m_sort_keys.insert(
+        m_sort_keys.end(), shard.m_sort_keys.begin(), shard.m_sort_keys.end());
+    m_local_lights.insert(
+        m_local_lights.end(), shard.m_local_lights.begin(), shard.m_local_lights.end());
+    shard.clear();
+  }
+}
+
 void DrawQueue::sort_full_keys(std::size_t start, std::size_t end) {
+  if (end - start >= k_radix_sort_min_range) {
+    radix_sort_range(start, end);
+    return;
+  }
   std::stable_sort(m_sort_indices.begin() + static_cast<std::ptrdiff_t>(start),
                    m_sort_indices.begin() + static_cast<std::ptrdiff_t>(end),
                    [&](std::uint32_t lhs, std::uint32_t rhs) {
@@ -104,6 +166,62 @@ void DrawQueue::sort_full_keys(std::size_t start, std::size_t end) {
                    });
 }
 
+void DrawQueue::radix_sort_range(std::size_t start, std::size_t end) {
+  const std::size_t count = end - start;
+  m_radix_columns.resize(count * k_radix_columns);
+  m_radix_order.resize(count * 3U);
+
+  std::array<std::uint64_t, k_radix_columns> first{};
+  std::array<std::uint64_t, k_radix_columns> varying{};
+  std::uint32_t* const original = m_radix_order.data() + count * 2U;
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::uint32_t item = m_sort_indices[start + i];
+    const auto identity = full_resource_identity(m_items[item]);
+    const std::array<std::uint64_t, k_radix_columns> row = {
+        identity[3], identity[2], identity[1], identity[0], m_sort_keys[item]};
+    if (i == 0) {
+      first = row;
+    }
+    for (std::size_t column = 0; column < k_radix_columns; ++column) {
+      m_radix_columns[column * count + i] = row[column];
+      varying[column] |= row[column] ^ first[column];
+    }
+    original[i] = item;
+  }
+
+  std::uint32_t* src = m_radix_order.data();
+  std::uint32_t* dst = src + count;
+  std::iota(src, src + count, std::uint32_t{0});
+  std::array<std::uint32_t, 256> offsets{};
+  for (std::size_t column = 0; column < k_radix_columns; ++column) {
+    const std::uint64_t* const words = m_radix_columns.data() + column * count;
+    for (unsigned shift = 0; shift < 64U; shift += 8U) {
+      if (((varying[column] >> shift) & 0xFFU) == 0U) {
+        continue;
+      }
+      offsets.fill(0U);
+      for (std::size_t i = 0; i < count; ++i) {
+        ++offsets[(words[i] >> shift) & 0xFFU];
+      }
+      std::uint32_t running = 0;
+      for (std::uint32_t& offset : offsets) {
+        const std::uint32_t bucket_count = offset;
+        offset = running;
+        running += bucket_count;
+      }
+      for (std::size_t i = 0; i < count; ++i) {
+        const std::uint32_t position = src[i];
+        dst[offsets[(words[position] >> shift) & 0xFFU]++] = position;
+      }
+      std::swap(src, dst);
+    }
+  }
+
+  for (std::size_t i = 0; i < count; ++i) {
+    m_sort_indices[start + i] = original[src[i]];
+  }
+}
+
 auto DrawQueue::sort_bucketed_ranges(std::size_t count) -> bool {
   if (m_submission_bucket_spans.empty()) {
     return false;
@@ -208,14 +326,6 @@ void DrawQueue::populate_sort_identity_prefix(const DrawCmd& cmd,
   }
 }
 
-auto DrawQueue::compute_submission_bucket(const DrawCmd& cmd) const -> std::uint32_t {
-  SortIdentity identity;
-  populate_sort_identity_prefix(cmd, identity);
-  return (static_cast<std::uint32_t>(identity.pass) << 16) |
-         (static_cast<std::uint32_t>(identity.pipeline) << 8) |
-         static_cast<std::uint32_t>(identity.transparency_bucket & 0x0FU);
-}
-
 auto DrawQueue::preserves_append_order(const DrawCmd& cmd) const -> bool {
   switch (draw_cmd_type(cmd)) {
   case DrawCmdType::TerrainScatter:
@@ -242,30 +352,32 @@ auto DrawQueue::preserves_append_order(const DrawCmd& cmd) const -> bool {
   return false;
 }
 
-void DrawQueue::record_submission_bucket(const DrawCmd& cmd) {
-  const std::uint32_t bucket = compute_submission_bucket(cmd);
-  const bool append_ordered = preserves_append_order(cmd);
-  const std::size_t next_index = m_items.size();
+void DrawQueue::record_submission_bucket(std::uint64_t sort_key,
+                                         bool append_ordered) {
+  append_submission_span(SubmissionBucketSpan{
+      .bucket = static_cast<std::uint32_t>(sort_key >> k_submission_bucket_shift),
+      .start = m_items.size(),
+      .count = 1U,
+      .preserves_append_order = append_ordered});
+}
+
+void DrawQueue::append_submission_span(const SubmissionBucketSpan& span) {
   if (!m_submission_bucket_spans.empty()) {
     SubmissionBucketSpan& last = m_submission_bucket_spans.back();
-    if (bucket < last.bucket) {
+    if (span.bucket < last.bucket) {
       m_submission_bucket_ordered = false;
     }
-    if (bucket == last.bucket) {
-      ++last.count;
-      last.preserves_append_order = last.preserves_append_order && append_ordered;
+    if (span.bucket == last.bucket) {
+      last.count += span.count;
+      last.preserves_append_order =
+          last.preserves_append_order && span.preserves_append_order;
       return;
     }
   }
-
-  m_submission_bucket_spans.push_back(
-      SubmissionBucketSpan{.bucket = bucket,
-                           .start = next_index,
-                           .count = 1U,
-                           .preserves_append_order = append_ordered});
+  m_submission_bucket_spans.push_back(span);
 }
 
-auto DrawQueue::compute_sort_key(const DrawCmd& cmd) -> uint64_t {
+auto DrawQueue::compute_sort_key(const DrawCmd& cmd) const -> std::uint64_t {
   SortIdentity identity;
   populate_sort_identity_prefix(cmd, identity);
 
@@ -291,7 +403,7 @@ auto DrawQueue::compute_sort_key(const DrawCmd& cmd) -> uint64_t {
     break;
   }
   case DrawCmdType::TerrainSurface: {
-    const auto& chunk = std::get<TerrainSurfaceCmdIndex>(cmd);
+    const auto& chunk = terrain_surface(std::get<TerrainSurfaceCmdIndex>(cmd));
     identity.material = pack_12(chunk.sort_key);
     identity.mesh = pack_16(sort_id(chunk.mesh));
     identity.texture = pack_12(sort_id(chunk.material));
@@ -514,8 +626,8 @@ auto DrawQueue::can_batch_terrain_surface(std::size_t sorted_idx_a,
   if (a.index() != TerrainSurfaceCmdIndex || b.index() != TerrainSurfaceCmdIndex) {
     return false;
   }
-  const auto& surface_a = std::get<TerrainSurfaceCmdIndex>(a);
-  const auto& surface_b = std::get<TerrainSurfaceCmdIndex>(b);
+  const auto& surface_a = terrain_surface(std::get<TerrainSurfaceCmdIndex>(a));
+  const auto& surface_b = terrain_surface(std::get<TerrainSurfaceCmdIndex>(b));
   return surface_a.mesh != nullptr && surface_b.mesh != nullptr &&
          surface_a.params.is_ground_plane == surface_b.params.is_ground_plane &&
          surface_a.depth_write == surface_b.depth_write &&
@@ -554,7 +666,7 @@ auto DrawQueue::sort_id(const void* ptr) noexcept -> std::uint32_t {
   return static_cast<std::uint32_t>(value ^ (value >> 16U) ^ (value >> 32U));
 }
 
-auto DrawQueue::full_resource_identity(const DrawCmd& cmd) noexcept
+auto DrawQueue::full_resource_identity(const DrawCmd& cmd) const noexcept
     -> std::array<std::uintptr_t, 4> {
   if (cmd.index() == MeshCmdIndex) {
     const auto& mesh = std::get<MeshCmdIndex>(cmd);
@@ -569,7 +681,7 @@ auto DrawQueue::full_resource_identity(const DrawCmd& cmd) noexcept
     return {ptr_value(fog.instance_buffer), ptr_value(fog.instances), fog.count, 0U};
   }
   if (cmd.index() == TerrainSurfaceCmdIndex) {
-    const auto& chunk = std::get<TerrainSurfaceCmdIndex>(cmd);
+    const auto& chunk = terrain_surface(std::get<TerrainSurfaceCmdIndex>(cmd));
     return {static_cast<std::uintptr_t>(chunk.sort_key),
             ptr_value(chunk.mesh),
             ptr_value(chunk.material),
@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <span>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -69,10 +70,33 @@ public:
             typename = std::enable_if_t<std::is_constructible_v<DrawCmd, CmdT&&>>>
   void submit(CmdT&& cmd) {
     DrawCmd draw_cmd(std::forward<CmdT>(cmd));
-    record_submission_bucket(draw_cmd);
+    if (!m_keyed) {
+      m_items.emplace_back(std::move(draw_cmd));
+      return;
+    }
+    const std::uint64_t sort_key = compute_sort_key(draw_cmd);
+    record_submission_bucket(sort_key, preserves_append_order(draw_cmd));
+    m_sort_keys.push_back(sort_key);
     m_items.emplace_back(std::move(draw_cmd));
   }
 
+  void submit(const TerrainSurfaceCmd& cmd);
+
+  [[nodiscard]] auto
+  terrain_surface(const TerrainSurfaceRef& ref) const -> const TerrainSurfaceCmd& {
+    return m_terrain_surfaces[ref.slot];
+  }
+
+  // A staging queue records commands without keys or submission buckets.
+  // Worker jobs then key contiguous slices of it into shards.
+  void set_keyed(bool keyed) noexcept { m_keyed = keyed; }
+
+  // Moves staged commands [begin, end) into this queue as if they were
+  // submitted here in order. Jobs may drain disjoint slices concurrently.
+  void submit_staged(DrawQueue& staging, std::size_t begin, std::size_t end);
+
+  void merge_shards(std::span<DrawQueue> shards);
+
   [[nodiscard]] auto empty() const -> bool { return m_items.empty(); }
   [[nodiscard]] auto size() const -> std::size_t { return m_items.size(); }
 
@@ -153,20 +177,25 @@ private:
     ModeIndicator = 34
   };
 
+  static constexpr unsigned k_submission_bucket_shift = 44U;
+  static constexpr std::size_t k_radix_sort_min_range = 64;
+  static constexpr std::size_t k_radix_columns = 5;
+
   void sort_full_keys(std::size_t start, std::size_t end);
 
+  void radix_sort_range(std::size_t start, std::size_t end);
+
   [[nodiscard]] auto sort_bucketed_ranges(std::size_t count) -> bool;
 
   void populate_sort_identity_prefix(const DrawCmd& cmd, SortIdentity& identity) const;
 
-  [[nodiscard]] auto
-  compute_submission_bucket(const DrawCmd& cmd) const -> std::uint32_t;
-
   [[nodiscard]] auto preserves_append_order(const DrawCmd& cmd) const -> bool;
 
-  void record_submission_bucket(const DrawCmd& cmd);
+  void record_submission_bucket(std::uint64_t sort_key, bool append_ordered);
+
+  void append_submission_span(const SubmissionBucketSpan& span);
 
-  [[nodiscard]] auto compute_sort_key(const DrawCmd& cmd) -> uint64_t;
+  [[nodiscard]] auto compute_sort_key(const DrawCmd& cmd) const -> std::uint64_t;
 
   void build_prepared_batches();
 
@@ -204,15 +233,19 @@ private:
     return reinterpret_cast<std::uintptr_t>(ptr);
   }
 
-  [[nodiscard]] static auto
-  full_resource_identity(const DrawCmd& cmd) noexcept -> std::array<std::uintptr_t, 4>;
+  [[nodiscard]] auto full_resource_identity(const DrawCmd& cmd) const noexcept
+      -> std::array<std::uintptr_t, 4>;
 
   std::vector<DrawCmd> m_items;
+  std::vector<TerrainSurfaceCmd> m_terrain_surfaces;
   std::vector<uint32_t> m_sort_indices;
   std::vector<uint64_t> m_sort_keys;
   std::vector<PreparedBatch> m_prepared_batches;
   std::vector<SubmissionBucketSpan> m_submission_bucket_spans;
+  std::vector<std::uint64_t> m_radix_columns;
+  std::vector<std::uint32_t> m_radix_order;
   bool m_submission_bucket_ordered = true;
+  bool m_keyed = true;
   std::size_t m_items_high_water = 0;
   std::size_t m_prepared_high_water = 0;
   std::size_t m_submission_bucket_high_water = 0;
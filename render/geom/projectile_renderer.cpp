@@ -5,9 +5,7 @@
 #include <numbers>
 
 #include "arrow.h"
-#include "game/systems/arrow_projectile.h"
 #include "game/systems/projectile_system.h"
-#include "game/systems/stone_projectile.h"
 #include "render/gl/primitives.h"
 #include "render/gl/resources.h"
 #include "render/scene_renderer.h"
@@ -464,7 +462,7 @@ void render_spent_projectile(Renderer* renderer,
 
 void render_arrow_projectile(Renderer* renderer,
                              ResourceManager* resources,
-                             const Game::Systems::ArrowProjectile& arrow,
+                             const Game::Systems::ProjectileView& arrow,
                              const QVector3D& pos,
                              const QMatrix4x4& base_model,
                              ProjectileRelation relation) {
@@ -741,7 +739,7 @@ void render_arrow_projectile(Renderer* renderer,
 
 void render_stone_projectile(Renderer* renderer,
                              ResourceManager* resources,
-                             const Game::Systems::StoneProjectile& stone,
+                             const Game::Systems::ProjectileView& stone,
                              const QVector3D& position,
                              const QMatrix4x4& base_model) {
   if ((renderer == nullptr) || (resources == nullptr)) {
@@ -824,16 +822,16 @@ void render_projectiles(Renderer* renderer,
 
   const auto& projectiles = projectile_system.projectiles();
 
-  for (const auto& projectile : projectiles) {
-    if (!projectile->is_active() || projectile->get_progress() < 0.0F) {
+  for (auto const projectile : projectiles) {
+    if (!projectile.is_active() || projectile.get_progress() < 0.0F) {
       continue;
     }
 
-    const QVector3D delta = projectile->get_end() - projectile->get_start();
-    QVector3D pos = projectile->get_start() + delta * projectile->get_progress();
+    const QVector3D delta = projectile.get_end() - projectile.get_start();
+    QVector3D pos = projectile.get_start() + delta * projectile.get_progress();
 
-    float const h = projectile->get_arc_height() * 4.0F * projectile->get_progress() *
-                    (1.0F - projectile->get_progress());
+    float const h = projectile.get_arc_height() * 4.0F * projectile.get_progress() *
+                    (1.0F - projectile.get_progress());
     pos.setY(pos.y() + h);
 
     QMatrix4x4 model;
@@ -843,18 +841,16 @@ void render_projectiles(Renderer* renderer,
     float const yaw_deg = std::atan2(dir.x(), dir.z()) * k_rad_to_deg;
     model.rotate(yaw_deg, QVector3D(0, 1, 0));
 
-    if (const auto* arrow =
-            dynamic_cast<const Game::Systems::ArrowProjectile*>(projectile.get())) {
+    if (projectile.body() == Game::Systems::ProjectileBody::Arrow) {
       render_arrow_projectile(
           renderer,
           resources,
-          *arrow,
+          projectile,
           pos,
           model,
-          relation_of(arrow->get_attacker_id(), arrow->get_target_id()));
-    } else if (const auto* stone = dynamic_cast<const Game::Systems::StoneProjectile*>(
-                   projectile.get())) {
-      render_stone_projectile(renderer, resources, *stone, pos, model);
+          relation_of(projectile.get_attacker_id(), projectile.get_target_id()));
+    } else {
+      render_stone_projectile(renderer, resources, projectile, pos, model);
     }
   }
 
@@ -14,9 +14,7 @@ class ResourceManager;
 
 namespace Game::Systems {
 class ProjectileSystem;
-class Projectile;
-class ArrowProjectile;
-class StoneProjectile;
+class ProjectileView;
 } // namespace Game::Systems
 
 namespace Render::GL {
@@ -50,14 +48,14 @@ void render_projectiles(Renderer* renderer,
 
 void render_arrow_projectile(Renderer* renderer,
                              ResourceManager* resources,
-                             const Game::Systems::ArrowProjectile& arrow,
+                             const Game::Systems::ProjectileView& arrow,
                              const QVector3D& pos,
                              const QMatrix4x4& base_model,
                              ProjectileRelation relation = ProjectileRelation::Neutral);
 
 void render_stone_projectile(Renderer* renderer,
                              ResourceManager* resources,
-                             const Game::Systems::StoneProjectile& stone,
+                             const Game::Systems::ProjectileView& stone,
                              const QVector3D& pos,
                              const QMatrix4x4& base_model);
 
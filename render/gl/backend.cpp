@@ -688,8 +688,12 @@ void Backend::render_directional_shadows(const DrawQueue& queue, const Camera& c
     m_shadow_terrain_height_cache.clear();
   }
   for (const auto& item : queue.items()) {
-    const auto* terrain = std::get_if<TerrainSurfaceCmd>(&item);
-    if (terrain == nullptr || terrain->mesh == nullptr || terrain->horizon_dressing) {
+    const auto* ref = std::get_if<TerrainSurfaceRef>(&item);
+    if (ref == nullptr) {
+      continue;
+    }
+    const TerrainSurfaceCmd* terrain = &queue.terrain_surface(*ref);
+    if (terrain->mesh == nullptr || terrain->horizon_dressing) {
       continue;
     }
     auto found = m_shadow_terrain_height_cache.find(terrain->mesh);
@@ -783,9 +787,10 @@ void Backend::render_directional_shadows(const DrawQueue& queue, const Camera& c
       if (part->alpha >= k_opaque_threshold) {
         add_static_caster(part->mesh, part->world);
       }
-    } else if (const auto* terrain = std::get_if<TerrainSurfaceCmd>(&item)) {
-      if (!terrain->horizon_dressing) {
-        add_static_caster(terrain->mesh, terrain->model);
+    } else if (const auto* ref = std::get_if<TerrainSurfaceRef>(&item)) {
+      const TerrainSurfaceCmd& terrain = queue.terrain_surface(*ref);
+      if (!terrain.horizon_dressing) {
+        add_static_caster(terrain.mesh, terrain.model);
       }
     }
   }
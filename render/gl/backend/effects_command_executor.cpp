@@ -84,7 +84,7 @@ void Backend::execute_effects_commands(const PreparedBatch& prepared,
     }
 
     m_effects_pipeline->m_grid_shader->set_uniform(
-        m_effects_pipeline->m_grid_uniforms.mvp, gc.mvp);
+        m_effects_pipeline->m_grid_uniforms.mvp, view_proj * gc.model);
     m_effects_pipeline->m_grid_shader->set_uniform(
         m_effects_pipeline->m_grid_uniforms.model, gc.model);
     m_effects_pipeline->m_grid_shader->set_uniform(
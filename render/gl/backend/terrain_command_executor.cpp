@@ -349,6 +349,11 @@ void Backend::set_terrain_chunk_uniforms(Shader& shader,
       shader.set_uniform(pipeline.m_terrain_uniforms.height_to_world, height.to_world);
     }
   }
+  if (pipeline.m_terrain_uniforms.lod_morph != Shader::InvalidUniform) {
+    shader.set_uniform(
+        pipeline.m_terrain_uniforms.lod_morph,
+        QVector3D(single.lod_morph.start, single.lod_morph.end, single.lod_morph.step));
+  }
   const bool field_ready = height.enabled && height.field_texture != nullptr;
   if (pipeline.m_terrain_uniforms.has_field_texture != Shader::InvalidUniform) {
     shader.set_uniform(pipeline.m_terrain_uniforms.has_field_texture,
@@ -441,7 +446,7 @@ void Backend::execute_terrain_commands(const PreparedBatch& prepared,
   const auto& cmd = queue.get_sorted(i);
   switch (cmd.index()) {
   case TerrainSurfaceCmdIndex: {
-    const auto& terrain = std::get<TerrainSurfaceCmdIndex>(cmd);
+    const auto& terrain = queue.terrain_surface(std::get<TerrainSurfaceCmdIndex>(cmd));
 
     Shader* active_shader = terrain.params.is_ground_plane
                                 ? m_terrain_pipeline->m_ground_shader
@@ -481,8 +486,8 @@ void Backend::execute_terrain_commands(const PreparedBatch& prepared,
       polygon_mode_scope.emplace(GL_LINE);
     }
     for (std::size_t j = i; j < batch_end; ++j) {
-      const auto& single = std::get<TerrainSurfaceCmdIndex>(queue.get_sorted(j));
-      draw_surface(single);
+      draw_surface(
+          queue.terrain_surface(std::get<TerrainSurfaceCmdIndex>(queue.get_sorted(j))));
     }
     break;
   }
@@ -242,6 +242,8 @@ void TerrainPipeline::cache_terrain_uniforms() {
   m_terrain_uniforms.height_to_world =
       m_terrain_shader->optional_uniform_handle("u_height_tex_to_world");
   m_terrain_uniforms.camera_position = m_terrain_shader->uniform_handle("u_camera_pos");
+  m_terrain_uniforms.lod_morph =
+      m_terrain_shader->optional_uniform_handle("u_lod_morph");
   m_terrain_uniforms.has_visibility =
       m_terrain_shader->optional_uniform_handle("u_has_visibility");
   m_terrain_uniforms.visibility_texture =
@@ -134,6 +134,7 @@ public:
     GL::Shader::UniformHandle height_uv_offset{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle height_to_world{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle camera_position{GL::Shader::InvalidUniform};
+    GL::Shader::UniformHandle lod_morph{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle has_visibility{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle visibility_texture{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle visibility_size{GL::Shader::InvalidUniform};
@@ -24,6 +24,7 @@
 #include "render/gl/render_constants.h"
 #include "render/graphics_settings.h"
 #include "render/scene_renderer.h"
+#include "scatter_generation.h"
 #include "scatter_runtime.h"
 #include "scatter_submission.h"
 
@@ -163,185 +164,185 @@ auto BiomeRenderer::grass_matches_graphics_profile() const noexcept -> bool {
          std::abs(m_generated_grass_density - wanted) < 1e-4F;
 }
 
-void BiomeRenderer::scatter_grass_clusters(const GrassScatterContext& ctx) {
+void BiomeRenderer::scatter_grass_clusters(const GrassScatterContext& ctx,
+                                           int chunk_z,
+                                           std::vector<GrassInstanceGpu>& out) const {
   const auto& scatter_profile = ctx.scatter_profile;
   const auto& terrain_cache = ctx.terrain_cache;
   const float tile_safe = ctx.tile_safe;
   const int chunk_size = ctx.chunk_size;
   const auto& add_grass_blade = ctx.add_grass_blade;
-  for (int chunk_z = 0; chunk_z < m_height - 1; chunk_z += chunk_size) {
-    int const chunk_max_z = std::min(chunk_z + chunk_size, m_height - 1);
-    for (int chunk_x = 0; chunk_x < m_width - 1; chunk_x += chunk_size) {
-      int const chunk_max_x = std::min(chunk_x + chunk_size, m_width - 1);
-
-      int flat_count = 0;
-      int hill_count = 0;
-      float chunk_slope_sum = 0.0F;
-      int sample_count = 0;
-
-      for (int z = chunk_z; z < chunk_max_z && z < m_height - 1; ++z) {
-        for (int x = chunk_x; x < chunk_max_x && x < m_width - 1; ++x) {
-          Game::Map::TerrainType const t0 = terrain_cache.get_terrain_type_at(x, z);
-          Game::Map::TerrainType const t1 = terrain_cache.get_terrain_type_at(x + 1, z);
-          Game::Map::TerrainType const t2 = terrain_cache.get_terrain_type_at(x, z + 1);
-          Game::Map::TerrainType const t3 =
-              terrain_cache.get_terrain_type_at(x + 1, z + 1);
-
-          bool const unusable =
-              t0 == Game::Map::TerrainType::Mountain ||
-              t1 == Game::Map::TerrainType::Mountain ||
-              t2 == Game::Map::TerrainType::Mountain ||
-              t3 == Game::Map::TerrainType::Mountain ||
-              Game::Map::is_water_terrain(t0) || Game::Map::is_water_terrain(t1) ||
-              Game::Map::is_water_terrain(t2) || Game::Map::is_water_terrain(t3);
-          if (!unusable) {
-            if (t0 == Game::Map::TerrainType::Hill ||
-                t1 == Game::Map::TerrainType::Hill ||
-                t2 == Game::Map::TerrainType::Hill ||
-                t3 == Game::Map::TerrainType::Hill) {
-              hill_count++;
-            } else {
-              flat_count++;
-            }
+  int const chunk_max_z = std::min(chunk_z + chunk_size, m_height - 1);
+  for (int chunk_x = 0; chunk_x < m_width - 1; chunk_x += chunk_size) {
+    int const chunk_max_x = std::min(chunk_x + chunk_size, m_width - 1);
+
+    int flat_count = 0;
+    int hill_count = 0;
+    float chunk_slope_sum = 0.0F;
+    int sample_count = 0;
+
+    for (int z = chunk_z; z < chunk_max_z && z < m_height - 1; ++z) {
+      for (int x = chunk_x; x < chunk_max_x && x < m_width - 1; ++x) {
+        Game::Map::TerrainType const t0 = terrain_cache.get_terrain_type_at(x, z);
+        Game::Map::TerrainType const t1 = terrain_cache.get_terrain_type_at(x + 1, z);
+        Game::Map::TerrainType const t2 = terrain_cache.get_terrain_type_at(x, z + 1);
+        Game::Map::TerrainType const t3 =
+            terrain_cache.get_terrain_type_at(x + 1, z + 1);
+
+        bool const unusable =
+            t0 == Game::Map::TerrainType::Mountain ||
+            t1 == Game::Map::TerrainType::Mountain ||
+            t2 == Game::Map::TerrainType::Mountain ||
+            t3 == Game::Map::TerrainType::Mountain ||
+            Game::Map::is_water_terrain(t0) || Game::Map::is_water_terrain(t1) ||
+            Game::Map::is_water_terrain(t2) || Game::Map::is_water_terrain(t3);
+        if (!unusable) {
+          if (t0 == Game::Map::TerrainType::Hill ||
+              t1 == Game::Map::TerrainType::Hill ||
+              t2 == Game::Map::TerrainType::Hill ||
+              t3 == Game::Map::TerrainType::Hill) {
+            hill_count++;
+          } else {
+            flat_count++;
           }
-
-          float const slope0 = terrain_cache.get_slope_at(x, z);
-          float const slope1 = terrain_cache.get_slope_at(x + 1, z);
-          float const slope2 = terrain_cache.get_slope_at(x, z + 1);
-          float const slope3 = terrain_cache.get_slope_at(x + 1, z + 1);
-          float const avg_slope = (slope0 + slope1 + slope2 + slope3) * 0.25F;
-          chunk_slope_sum += avg_slope;
-          sample_count++;
         }
-      }
 
-      if (sample_count == 0) {
-        continue;
+        float const slope0 = terrain_cache.get_slope_at(x, z);
+        float const slope1 = terrain_cache.get_slope_at(x + 1, z);
+        float const slope2 = terrain_cache.get_slope_at(x, z + 1);
+        float const slope3 = terrain_cache.get_slope_at(x + 1, z + 1);
+        float const avg_slope = (slope0 + slope1 + slope2 + slope3) * 0.25F;
+        chunk_slope_sum += avg_slope;
+        sample_count++;
       }
+    }
 
-      const float usable_coverage =
-          sample_count > 0 ? float(flat_count + hill_count) / float(sample_count)
-                           : 0.0F;
-      if (usable_coverage < 0.05F) {
-        continue;
-      }
+    if (sample_count == 0) {
+      continue;
+    }
 
-      float const avg_slope = chunk_slope_sum / float(sample_count);
-
-      uint32_t state = hash_coords(chunk_x, chunk_z, m_noise_seed ^ 0xC915872BU);
-      float const slope_penalty = 1.0F - std::clamp(avg_slope * 1.35F, 0.0F, 0.75F);
-
-      float const type_bias = 1.0F;
-      constexpr float k_cluster_boost = 1.35F;
-      float const expected_clusters =
-          std::max(0.0F,
-                   scatter_profile.patch_density * k_cluster_boost * slope_penalty *
-                       type_bias * usable_coverage);
-      int cluster_count = static_cast<int>(std::floor(expected_clusters));
-      float const frac = expected_clusters - float(cluster_count);
-      if (rand_01(state) < frac) {
-        cluster_count += 1;
-      }
+    const float usable_coverage =
+        sample_count > 0 ? float(flat_count + hill_count) / float(sample_count)
+                         : 0.0F;
+    if (usable_coverage < 0.05F) {
+      continue;
+    }
 
-      if (cluster_count > 0) {
-        auto chunk_span_x = float(chunk_max_x - chunk_x + 1);
-        auto chunk_span_z = float(chunk_max_z - chunk_z + 1);
-        float const scatter_base = std::max(0.25F, scatter_profile.patch_jitter);
-
-        auto pick_cluster_center = [&](uint32_t& rng) -> std::optional<QVector2D> {
-          constexpr int k_max_attempts = 8;
-          for (int attempt = 0; attempt < k_max_attempts; ++attempt) {
-            float const candidate_gx = float(chunk_x) + rand_01(rng) * chunk_span_x;
-            float const candidate_gz = float(chunk_z) + rand_01(rng) * chunk_span_z;
-
-            int const cx = std::clamp(int(std::round(candidate_gx)), 0, m_width - 1);
-            int const cz = std::clamp(int(std::round(candidate_gz)), 0, m_height - 1);
-            Game::Map::TerrainType const center_terrain_type =
-                terrain_cache.get_terrain_type_at(cx, cz);
-            if (center_terrain_type == Game::Map::TerrainType::Mountain ||
-                Game::Map::is_water_terrain(center_terrain_type)) {
-              continue;
-            }
-
-            float const center_slope = terrain_cache.get_slope_at(cx, cz);
-            if (center_slope > 0.92F) {
-              continue;
-            }
-
-            return QVector2D(candidate_gx, candidate_gz);
-          }
-          return std::nullopt;
-        };
+    float const avg_slope = chunk_slope_sum / float(sample_count);
+
+    uint32_t state = hash_coords(chunk_x, chunk_z, m_noise_seed ^ 0xC915872BU);
+    float const slope_penalty = 1.0F - std::clamp(avg_slope * 1.35F, 0.0F, 0.75F);
+
+    float const type_bias = 1.0F;
+    constexpr float k_cluster_boost = 1.35F;
+    float const expected_clusters =
+        std::max(0.0F,
+                 scatter_profile.patch_density * k_cluster_boost * slope_penalty *
+                     type_bias * usable_coverage);
+    int cluster_count = static_cast<int>(std::floor(expected_clusters));
+    float const frac = expected_clusters - float(cluster_count);
+    if (rand_01(state) < frac) {
+      cluster_count += 1;
+    }
 
-        for (int cluster = 0; cluster < cluster_count; ++cluster) {
-          auto center = pick_cluster_center(state);
-          if (!center) {
+    if (cluster_count > 0) {
+      auto chunk_span_x = float(chunk_max_x - chunk_x + 1);
+      auto chunk_span_z = float(chunk_max_z - chunk_z + 1);
+      float const scatter_base = std::max(0.25F, scatter_profile.patch_jitter);
+
+      auto pick_cluster_center = [&](uint32_t& rng) -> std::optional<QVector2D> {
+        constexpr int k_max_attempts = 8;
+        for (int attempt = 0; attempt < k_max_attempts; ++attempt) {
+          float const candidate_gx = float(chunk_x) + rand_01(rng) * chunk_span_x;
+          float const candidate_gz = float(chunk_z) + rand_01(rng) * chunk_span_z;
+
+          int const cx = std::clamp(int(std::round(candidate_gx)), 0, m_width - 1);
+          int const cz = std::clamp(int(std::round(candidate_gz)), 0, m_height - 1);
+          Game::Map::TerrainType const center_terrain_type =
+              terrain_cache.get_terrain_type_at(cx, cz);
+          if (center_terrain_type == Game::Map::TerrainType::Mountain ||
+              Game::Map::is_water_terrain(center_terrain_type)) {
             continue;
           }
 
-          float const center_gx = center->x();
-          float const center_gz = center->y();
-
-          int blades = 6 + static_cast<int>(rand_01(state) * 6.0F);
-          blades =
-              std::max(4, int(std::round(blades * (0.85F + 0.3F * rand_01(state)))));
-          float const scatter_radius =
-              (0.45F + 0.55F * rand_01(state)) * scatter_base * tile_safe;
-
-          for (int blade = 0; blade < blades; ++blade) {
-            float const angle = rand_01(state) * MathConstants::k_two_pi;
-            float const radius = scatter_radius * std::sqrt(rand_01(state));
-            float const gx = center_gx + std::cos(angle) * radius / tile_safe;
-            float const gz = center_gz + std::sin(angle) * radius / tile_safe;
-            add_grass_blade(gx, gz, state);
+          float const center_slope = terrain_cache.get_slope_at(cx, cz);
+          if (center_slope > 0.92F) {
+            continue;
           }
+
+          return QVector2D(candidate_gx, candidate_gz);
+        }
+        return std::nullopt;
+      };
+
+      for (int cluster = 0; cluster < cluster_count; ++cluster) {
+        auto center = pick_cluster_center(state);
+        if (!center) {
+          continue;
+        }
+
+        float const center_gx = center->x();
+        float const center_gz = center->y();
+
+        int blades = 6 + static_cast<int>(rand_01(state) * 6.0F);
+        blades = std::max(4, int(std::round(blades * (0.85F + 0.3F * rand_01(state)))));
+        float const scatter_radius =
+            (0.45F + 0.55F * rand_01(state)) * scatter_base * tile_safe;
+
+        for (int blade = 0; blade < blades; ++blade) {
+          float const angle = rand_01(state) * MathConstants::k_two_pi;
+          float const radius = scatter_radius * std::sqrt(rand_01(state));
+          float const gx = center_gx + std::cos(angle) * radius / tile_safe;
+          float const gz = center_gz + std::sin(angle) * radius / tile_safe;
+          add_grass_blade(gx, gz, state, out);
         }
       }
     }
   }
 }
 
-void BiomeRenderer::scatter_background_grass(const GrassScatterContext& ctx) {
+void BiomeRenderer::scatter_background_grass(const GrassScatterContext& ctx,
+                                             int z,
+                                             std::vector<GrassInstanceGpu>& out) const {
   const auto& scatter_profile = ctx.scatter_profile;
   const auto& terrain_cache = ctx.terrain_cache;
   const auto& add_grass_blade = ctx.add_grass_blade;
 
   const float background_density =
       std::max(0.0F, scatter_profile.background_blade_density);
-  if (background_density > 0.0F) {
-    for (int z = 0; z < m_height; ++z) {
-      for (int x = 0; x < m_width; ++x) {
-        Game::Map::TerrainType const terrain_type =
-            terrain_cache.get_terrain_type_at(x, z);
-        if (terrain_type == Game::Map::TerrainType::Mountain ||
-            terrain_type == Game::Map::TerrainType::Hill ||
-            Game::Map::is_water_terrain(terrain_type)) {
-          continue;
-        }
+  if (background_density <= 0.0F) {
+    return;
+  }
+  for (int x = 0; x < m_width; ++x) {
+    Game::Map::TerrainType const terrain_type = terrain_cache.get_terrain_type_at(x, z);
+    if (terrain_type == Game::Map::TerrainType::Mountain ||
+        terrain_type == Game::Map::TerrainType::Hill ||
+        Game::Map::is_water_terrain(terrain_type)) {
+      continue;
+    }
 
-        float const slope = terrain_cache.get_slope_at(x, z);
-        if (slope > 0.95F) {
-          continue;
-        }
+    float const slope = terrain_cache.get_slope_at(x, z);
+    if (slope > 0.95F) {
+      continue;
+    }
 
-        int const idx = z * m_width + x;
-        uint32_t state =
-            hash_coords(x, z, m_noise_seed ^ 0x51bda7U ^ static_cast<uint32_t>(idx));
-        int base_count = static_cast<int>(std::floor(background_density));
-        float const frac = background_density - float(base_count);
-        if (rand_01(state) < frac) {
-          base_count += 1;
-        }
+    int const idx = z * m_width + x;
+    uint32_t state =
+        hash_coords(x, z, m_noise_seed ^ 0x51bda7U ^ static_cast<uint32_t>(idx));
+    int base_count = static_cast<int>(std::floor(background_density));
+    float const frac = background_density - float(base_count);
+    if (rand_01(state) < frac) {
+      base_count += 1;
+    }
 
-        for (int i = 0; i < base_count; ++i) {
-          float const gx = float(x) + rand_01(state);
-          float const gz = float(z) + rand_01(state);
-          add_grass_blade(gx, gz, state);
-        }
-      }
+    for (int i = 0; i < base_count; ++i) {
+      float const gx = float(x) + rand_01(state);
+      float const gz = float(z) + rand_01(state);
+      add_grass_blade(gx, gz, state, out);
     }
   }
 }
+
 void BiomeRenderer::generate_grass_instances() {
   auto& grass_instances = m_grass_state.instances;
   auto& grass_instance_count = m_grass_state.instance_count;
@@ -370,6 +371,45 @@ void BiomeRenderer::generate_grass_instances() {
   }
 
   const float tile_safe = std::max(0.001F, m_tile_size);
+  m_typical_blade_height =
+      0.5F * (scatter_profile.blade_height_min + scatter_profile.blade_height_max) *
+      tile_safe * 0.5F * k_grass_height_scale;
+
+  Scatter::InstanceCacheKey cache_key("grass");
+  cache_key.add(m_width);
+  cache_key.add(m_height);
+  cache_key.add(m_tile_size);
+  cache_key.add(m_noise_seed);
+  cache_key.add_all(m_height_data);
+  cache_key.add_all(m_terrain_types);
+  cache_key.add(scatter_profile.ground_type);
+  cache_key.add(scatter_profile.grass_primary);
+  cache_key.add(scatter_profile.grass_secondary);
+  cache_key.add(scatter_profile.grass_dry);
+  cache_key.add(scatter_profile.soil_color);
+  cache_key.add(scatter_profile.patch_density);
+  cache_key.add(scatter_profile.patch_jitter);
+  cache_key.add(scatter_profile.background_blade_density);
+  cache_key.add(scatter_profile.blade_height_min);
+  cache_key.add(scatter_profile.blade_height_max);
+  cache_key.add(scatter_profile.blade_width_min);
+  cache_key.add(scatter_profile.blade_width_max);
+  cache_key.add(scatter_profile.spawn_edge_padding);
+  cache_key.add_placement_obstacles();
+
+  if (!Scatter::load_cached_instances(cache_key, grass_instances)) {
+    build_grass_instances(scatter_profile, tile_safe);
+    Scatter::store_cached_instances(cache_key, grass_instances);
+  }
+
+  grass_instance_count = grass_instances.size();
+  grass_instances_dirty = grass_instance_count > 0;
+  m_grass_state.visibility_dirty = grass_instance_count > 0;
+}
+
+void BiomeRenderer::build_grass_instances(
+    const Game::Map::TerrainScatterProfile& scatter_profile, float tile_safe) {
+  auto& grass_instances = m_grass_state.instances;
 
   SpawnTerrainCache terrain_cache;
   terrain_cache.build_from_height_map(
@@ -386,22 +426,12 @@ void BiomeRenderer::generate_grass_instances() {
   SpawnValidator validator(terrain_cache, config);
   const int chunk_size = default_chunk_size;
 
-  const std::size_t cell_count =
-      static_cast<std::size_t>(m_width) * static_cast<std::size_t>(m_height);
-  const std::size_t chunk_columns =
-      static_cast<std::size_t>((std::max(0, m_width - 2) + chunk_size) / chunk_size);
   const std::size_t chunk_rows =
       static_cast<std::size_t>((std::max(0, m_height - 2) + chunk_size) / chunk_size);
-  const std::size_t chunk_count = chunk_columns * chunk_rows;
   const std::size_t background_blades_per_cell = static_cast<std::size_t>(
       std::ceil(std::max(0.0F, scatter_profile.background_blade_density)));
   const std::size_t cluster_count_per_chunk = static_cast<std::size_t>(
       std::ceil(std::max(0.0F, scatter_profile.patch_density * 2.0F)));
-  constexpr std::size_t k_max_blades_per_cluster = 12U;
-  const std::size_t reserve_hint =
-      cell_count * background_blades_per_cell +
-      chunk_count * cluster_count_per_chunk * k_max_blades_per_cluster;
-  grass_instances.reserve(reserve_hint);
 
   auto check_riverbank = [&](int ix, int iz, uint32_t& state) -> bool {
     constexpr int k_river_margin = 1;
@@ -431,7 +461,10 @@ void BiomeRenderer::generate_grass_instances() {
     return true;
   };
 
-  auto add_grass_blade = [&](float gx, float gz, uint32_t& state) {
+  auto add_grass_blade = [&](float gx,
+                             float gz,
+                             uint32_t& state,
+                             std::vector<GrassInstanceGpu>& out) {
     if (!validator.can_spawn_at_grid(gx, gz)) {
       return false;
     }
@@ -484,7 +517,7 @@ void BiomeRenderer::generate_grass_instances() {
     instance.color_width = QVector4D(color.x(), color.y(), color.z(), width);
     instance.sway_params =
         QVector4D(sway_strength, sway_speed, sway_phase, orientation);
-    grass_instances.push_back(std::move(instance));
+    out.push_back(std::move(instance));
     return true;
   };
 
@@ -513,19 +546,35 @@ void BiomeRenderer::generate_grass_instances() {
                                 .add_grass_blade = add_grass_blade,
                                 .quad_section = quad_section};
 
-  scatter_grass_clusters(ctx);
-  scatter_background_grass(ctx);
+  std::vector<std::vector<GrassInstanceGpu>> cluster_rows(chunk_rows);
+  std::vector<std::vector<GrassInstanceGpu>> background_rows(
+      static_cast<std::size_t>(m_height));
+  Scatter::run_generation_jobs(
+      cluster_rows.size() + background_rows.size(), [&](std::size_t job) {
+        if (job < cluster_rows.size()) {
+          scatter_grass_clusters(
+              ctx, static_cast<int>(job) * chunk_size, cluster_rows[job]);
+        } else {
+          std::size_t const z = job - cluster_rows.size();
+          scatter_background_grass(ctx, static_cast<int>(z), background_rows[z]);
+        }
+      });
+
+  std::size_t total = 0;
+  for (const auto& rows : {&cluster_rows, &background_rows}) {
+    for (const auto& row : *rows) {
+      total += row.size();
+    }
+  }
+  grass_instances.reserve(total);
+  for (const auto& rows : {&cluster_rows, &background_rows}) {
+    for (const auto& row : *rows) {
+      grass_instances.insert(grass_instances.end(), row.begin(), row.end());
+    }
+  }
 
   std::mt19937 shuffle_rng(m_noise_seed ^ 0x5f3aC71dU);
   std::shuffle(grass_instances.begin(), grass_instances.end(), shuffle_rng);
-
-  m_typical_blade_height =
-      0.5F * (scatter_profile.blade_height_min + scatter_profile.blade_height_max) *
-      tile_safe * 0.5F * k_grass_height_scale;
-
-  grass_instance_count = grass_instances.size();
-  grass_instances_dirty = grass_instance_count > 0;
-  m_grass_state.visibility_dirty = grass_instance_count > 0;
 }
 
 } // namespace Render::GL
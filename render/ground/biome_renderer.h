@@ -45,6 +45,11 @@ public:
     return m_grass_state.last_sync_stats;
   }
 
+  [[nodiscard]] auto
+  grass_instances_for_test() const -> const std::vector<GrassInstanceGpu>& {
+    return m_grass_state.instances;
+  }
+
 private:
   struct GrassScatterContext {
     const Game::Map::TerrainScatterProfile& scatter_profile;
@@ -53,7 +58,8 @@ private:
     int chunk_size;
     std::size_t cluster_count_per_chunk;
     std::size_t background_blades_per_cell;
-    const std::function<bool(float, float, std::uint32_t&)>& add_grass_blade;
+    const std::function<bool(
+        float, float, std::uint32_t&, std::vector<GrassInstanceGpu>&)>& add_grass_blade;
     const std::function<int(Game::Map::TerrainType,
                             Game::Map::TerrainType,
                             Game::Map::TerrainType,
@@ -62,9 +68,16 @@ private:
 
   void generate_grass_instances();
 
-  void scatter_grass_clusters(const GrassScatterContext& ctx);
+  void build_grass_instances(const Game::Map::TerrainScatterProfile& scatter_profile,
+                             float tile_safe);
+
+  void scatter_grass_clusters(const GrassScatterContext& ctx,
+                              int chunk_z,
+                              std::vector<GrassInstanceGpu>& out) const;
 
-  void scatter_background_grass(const GrassScatterContext& ctx);
+  void scatter_background_grass(const GrassScatterContext& ctx,
+                                int z,
+                                std::vector<GrassInstanceGpu>& out) const;
 
   int m_width = 0;
   int m_height = 0;
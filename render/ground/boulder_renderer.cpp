@@ -55,7 +55,7 @@ void BoulderRenderer::rebuild_boulder_instances() {
   m_state.instances.clear();
   append_world_prop_boulders();
   if (!m_use_world_props_exclusively) {
-    append_procedural_instances([this](std::vector<StoneInstanceGpu>& out) {
+    append_procedural_instances("boulder", [this](std::vector<StoneInstanceGpu>& out) {
       generate_procedural_boulders(out);
     });
   }
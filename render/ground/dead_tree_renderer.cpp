@@ -61,7 +61,7 @@ void DeadTreeRenderer::refresh_world_props(
 void DeadTreeRenderer::rebuild_dead_tree_instances() {
   m_state.instances.clear();
   append_world_prop_dead_trees();
-  append_procedural_instances([this](std::vector<PropInstanceGpu>& out) {
+  append_procedural_instances("dead_tree", [this](std::vector<PropInstanceGpu>& out) {
     generate_procedural_dead_trees(out);
   });
   finish_instance_rebuild();
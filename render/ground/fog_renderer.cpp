@@ -90,28 +90,8 @@ void FogRenderer::update_mask(int width,
     m_last_time = -1.0F;
   }
 
-  bool targets_changed = false;
-  for (std::size_t idx = 0; idx < cell_count; ++idx) {
-    const auto state = static_cast<Game::Map::VisibilityState>(cells[idx]);
-    const float target = state == Game::Map::VisibilityState::Unseen ? 1.0F : 0.0F;
-    const float seen = state == Game::Map::VisibilityState::Visible ? 1.0F : 0.0F;
-    const bool target_moved = m_target_fog[idx] != target;
-    const bool seen_moved = m_seen_amount[idx] != seen;
-    if (!target_moved && !seen_moved) {
-      continue;
-    }
-    const int x = static_cast<int>(idx % static_cast<std::size_t>(m_width));
-    const int z = static_cast<int>(idx / static_cast<std::size_t>(m_width));
-    if (target_moved) {
-      m_target_fog[idx] = target;
-      targets_changed = true;
-      m_fade_region.include(x, z, m_width, m_height);
-    }
-    if (seen_moved) {
-      m_seen_amount[idx] = seen;
-    }
-    m_mask_dirty.include(x, z, m_width, m_height);
-  }
+  const bool targets_changed =
+      retarget_cells(cells, Game::Map::VisibilityDirtyRect::whole(m_width, m_height));
 
   if (geometry_changed) {
 
@@ -131,6 +111,62 @@ void FogRenderer::update_mask(int width,
   }
 }
 
+void FogRenderer::update_mask_region(int width,
+                                     int height,
+                                     float tile_size,
+                                     const std::vector<std::uint8_t>& cells,
+                                     const Game::Map::VisibilityDirtyRect& changed) {
+  const auto cell_count =
+      static_cast<std::size_t>(std::max(0, width)) *
+      static_cast<std::size_t>(std::max(0, height));
+  const bool same_grid = width == m_width && height == m_height &&
+                         std::max(0.0001F, tile_size) == m_tile_size &&
+                         cell_count != 0 && cells.size() == cell_count &&
+                         m_target_fog.size() == cell_count;
+  if (!same_grid) {
+    update_mask(width, height, tile_size, cells);
+    return;
+  }
+
+  if (retarget_cells(cells, changed)) {
+    m_settled = false;
+    m_patches_dirty = true;
+    rebuild_patches();
+  }
+}
+
+auto FogRenderer::retarget_cells(const std::vector<std::uint8_t>& cells,
+                                 const Game::Map::VisibilityDirtyRect& region) -> bool {
+  bool targets_changed = false;
+  const int min_x = std::max(0, region.min_x);
+  const int max_x = std::min(m_width - 1, region.max_x);
+  for (int z = std::max(0, region.min_z); z <= std::min(m_height - 1, region.max_z);
+       ++z) {
+    for (int x = min_x; x <= max_x; ++x) {
+      const auto idx = static_cast<std::size_t>(z) * static_cast<std::size_t>(m_width) +
+                       static_cast<std::size_t>(x);
+      const auto state = static_cast<Game::Map::VisibilityState>(cells[idx]);
+      const float target = state == Game::Map::VisibilityState::Unseen ? 1.0F : 0.0F;
+      const float seen = state == Game::Map::VisibilityState::Visible ? 1.0F : 0.0F;
+      const bool target_moved = m_target_fog[idx] != target;
+      const bool seen_moved = m_seen_amount[idx] != seen;
+      if (!target_moved && !seen_moved) {
+        continue;
+      }
+      if (target_moved) {
+        m_target_fog[idx] = target;
+        targets_changed = true;
+        m_fade_region.include(x, z, m_width, m_height);
+      }
+      if (seen_moved) {
+        m_seen_amount[idx] = seen;
+      }
+      m_mask_dirty.include(x, z, m_width, m_height);
+    }
+  }
+  return targets_changed;
+}
+
 void FogRenderer::advance_reveal(float dt_seconds) {
   if (m_settled || m_fog_amount.size() != m_target_fog.size()) {
     return;
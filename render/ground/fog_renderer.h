@@ -33,6 +33,14 @@ public:
                    int height,
                    float tile_size,
                    const std::vector<std::uint8_t>& cells);
+  // Like update_mask, but only cells inside `changed` are compared; anything
+  // outside must match the previous mask. Falls back to update_mask when the
+  // grid differs.
+  void update_mask_region(int width,
+                          int height,
+                          float tile_size,
+                          const std::vector<std::uint8_t>& cells,
+                          const Game::Map::VisibilityDirtyRect& changed);
 
   void submit(Renderer& renderer, ResourceManager* resources) override;
 
@@ -44,6 +52,8 @@ public:
 
 private:
   void rebuild_patches();
+  auto retarget_cells(const std::vector<std::uint8_t>& cells,
+                      const Game::Map::VisibilityDirtyRect& region) -> bool;
   void upload_mask(Renderer& renderer);
   void upload_instances();
   void clear_state();
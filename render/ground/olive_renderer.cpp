@@ -80,8 +80,9 @@ void OliveRenderer::rebuild_olive_instances() {
   m_state.instances.clear();
   append_world_prop_olives();
   if (!m_use_world_props_exclusively) {
-    append_procedural_instances(
-        [this](std::vector<TreeInstanceGpu>& out) { generate_procedural_olives(out); });
+    append_procedural_instances("olive", [this](std::vector<TreeInstanceGpu>& out) {
+      generate_procedural_olives(out);
+    });
   }
   finish_instance_rebuild();
 }
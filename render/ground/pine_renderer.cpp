@@ -80,8 +80,9 @@ void PineRenderer::rebuild_pine_instances() {
   m_state.instances.clear();
   append_world_prop_pines();
   if (!m_use_world_props_exclusively) {
-    append_procedural_instances(
-        [this](std::vector<TreeInstanceGpu>& out) { generate_procedural_pines(out); });
+    append_procedural_instances("pine", [this](std::vector<TreeInstanceGpu>& out) {
+      generate_procedural_pines(out);
+    });
   }
   finish_instance_rebuild();
 }
@@ -51,7 +51,7 @@ void PlantRenderer::configure(const Game::Map::TerrainHeightMap& height_map,
   plant_params.wind_strength = wind_profile.sway_strength;
   plant_params.wind_speed = wind_profile.sway_speed;
 
-  generate_plant_instances();
+  generate_cached_instances("plant", [this] { generate_plant_instances(); });
 }
 
 void PlantRenderer::set_light_direction(const QVector3D& dir) {
@@ -0,0 +1,258 @@
+#include "scatter_generation.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStringLiteral>
+
+#include <memory>
+#include <mutex>
+
+#include "game/map/map_definition.h"
+#include "game/map/terrain.h"
+#include "game/map/terrain_service.h"
+#include "game/systems/building_collision_registry.h"
+#include "render/prepare_worker_pool.h"
+
+namespace Render::Ground::Scatter {
+
+namespace {
+
+constexpr const char* k_magic = "SOISCAT\x01";
+constexpr int k_magic_size = 8;
+constexpr int k_header_size = k_magic_size + 4 + 4 + 8;
+
+std::mutex g_cache_directory_mutex;
+QString g_cache_directory_override;
+
+std::mutex g_pool_mutex;
+std::unique_ptr<Render::PrepareWorkerPool> g_pool;
+std::optional<std::size_t> g_pool_workers;
+
+auto cache_directory() -> QString {
+  {
+    const std::lock_guard<std::mutex> lock(g_cache_directory_mutex);
+    if (!g_cache_directory_override.isEmpty()) {
+      return g_cache_directory_override;
+    }
+  }
+  const QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  if (base.isEmpty()) {
+    return {};
+  }
+  return base + QStringLiteral("/scatter");
+}
+
+void add_footprints(InstanceCacheKey& key,
+                    const std::vector<Game::Systems::BuildingFootprint>& footprints) {
+  key.add(static_cast<std::uint64_t>(footprints.size()));
+  for (const auto& footprint : footprints) {
+    key.add(footprint.center_x);
+    key.add(footprint.center_z);
+    key.add(footprint.width);
+    key.add(footprint.depth);
+  }
+}
+
+void prune_cache(const QDir& directory, const QString& kind) {
+  const QFileInfoList entries = directory.entryInfoList(
+      {kind + QStringLiteral("-*.bin")}, QDir::Files, QDir::Time);
+  for (qsizetype i = k_max_cached_layouts_per_kind; i < entries.size(); ++i) {
+    QFile::remove(entries.at(i).absoluteFilePath());
+  }
+}
+
+} // namespace
+
+void run_generation_jobs(std::size_t job_count,
+                         const std::function<void(std::size_t)>& job) {
+  const std::lock_guard<std::mutex> lock(g_pool_mutex);
+  if (!g_pool && g_pool_workers) {
+    g_pool = std::make_unique<Render::PrepareWorkerPool>(*g_pool_workers);
+  } else if (!g_pool) {
+    g_pool = std::make_unique<Render::PrepareWorkerPool>();
+  }
+  g_pool->run(job_count, job);
+}
+
+void set_generation_worker_count(std::optional<std::size_t> workers) {
+  const std::lock_guard<std::mutex> lock(g_pool_mutex);
+  if (workers != g_pool_workers) {
+    g_pool_workers = workers;
+    g_pool.reset();
+  }
+}
+
+void set_cache_directory(const QString& directory) {
+  const std::lock_guard<std::mutex> lock(g_cache_directory_mutex);
+  g_cache_directory_override = directory;
+}
+
+InstanceCacheKey::InstanceCacheKey(const char* kind)
+    : m_kind(QString::fromLatin1(kind)) {
+  m_hash.addData(m_kind.toLatin1());
+  add(k_instance_cache_version);
+}
+
+void InstanceCacheKey::add_bytes(const void* data, std::size_t size) {
+  m_hash.addData(QByteArrayView(static_cast<const char*>(data),
+                                static_cast<qsizetype>(size)));
+}
+
+void InstanceCacheKey::add_biome_settings(const Game::Map::BiomeSettings& settings) {
+  add(settings.ground_type);
+  add(settings.grass_primary);
+  add(settings.grass_secondary);
+  add(settings.grass_dry);
+  add(settings.soil_color);
+  add(settings.rock_low);
+  add(settings.rock_high);
+  add(settings.patch_density);
+  add(settings.patch_jitter);
+  add(settings.background_blade_density);
+  add(settings.blade_height_min);
+  add(settings.blade_height_max);
+  add(settings.blade_width_min);
+  add(settings.blade_width_max);
+  add(settings.sway_strength);
+  add(settings.sway_speed);
+  add(settings.height_noise_amplitude);
+  add(settings.height_noise_frequency);
+  add(settings.terrain_macro_noise_scale);
+  add(settings.terrain_detail_noise_scale);
+  add(settings.terrain_soil_height);
+  add(settings.terrain_soil_sharpness);
+  add(settings.terrain_rock_threshold);
+  add(settings.terrain_rock_sharpness);
+  add(settings.terrain_ambient_boost);
+  add(settings.terrain_rock_detail_strength);
+  add(settings.background_sway_variance);
+  add(settings.background_scatter_radius);
+  add(settings.plant_density);
+  add(settings.spawn_edge_padding);
+  add(settings.seed);
+  add(settings.ground_irregularity_enabled);
+  add(settings.irregularity_scale);
+  add(settings.irregularity_amplitude);
+  add(settings.procedural_boulders_enabled);
+  add(settings.procedural_iron_ore_enabled);
+  add(settings.procedural_trees_enabled);
+  add(settings.snow_coverage);
+  add(settings.moisture_level);
+  add(settings.crack_intensity);
+  add(settings.rock_exposure);
+  add(settings.grass_saturation);
+  add(settings.soil_roughness);
+  add(settings.snow_color);
+}
+
+void InstanceCacheKey::add_world_props(const std::vector<Game::Map::WorldProp>& props) {
+  add(static_cast<std::uint64_t>(props.size()));
+  for (const auto& prop : props) {
+    add(prop.id);
+    add(prop.type);
+    add(prop.x);
+    add(prop.z);
+    add(prop.scale);
+    add(prop.rotation);
+    add(prop.intensity);
+    add(prop.radius);
+    add(prop.persistent);
+  }
+}
+
+void InstanceCacheKey::add_placement_obstacles() {
+  const auto& terrain_service = Game::Map::TerrainService::instance();
+  const auto& roads = terrain_service.road_segments();
+  add(static_cast<std::uint64_t>(roads.size()));
+  for (const auto& road : roads) {
+    add(road.start);
+    add(road.end);
+    add(road.width);
+  }
+
+  const auto* height_map = terrain_service.get_height_map();
+  const std::size_t bridge_count =
+      height_map != nullptr ? height_map->get_bridges().size() : 0U;
+  add(static_cast<std::uint64_t>(bridge_count));
+  if (height_map != nullptr) {
+    for (const auto& bridge : height_map->get_bridges()) {
+      add(bridge.start);
+      add(bridge.end);
+      add(bridge.width);
+    }
+  }
+
+  const auto& buildings = Game::Systems::BuildingCollisionRegistry::instance();
+  add_footprints(*this, buildings.get_all_buildings());
+  add_footprints(*this, buildings.authored_obstacles());
+}
+
+auto InstanceCacheKey::file_name() const -> QString {
+  return m_kind + QLatin1Char('-') + QString::fromLatin1(m_hash.result().toHex()) +
+         QStringLiteral(".bin");
+}
+
+auto read_cached_instance_bytes(const InstanceCacheKey& key,
+                                std::size_t stride) -> std::optional<QByteArray> {
+  const QString directory = cache_directory();
+  if (directory.isEmpty()) {
+    return std::nullopt;
+  }
+  QFile file(directory + QLatin1Char('/') + key.file_name());
+  if (!file.open(QIODevice::ReadOnly) || file.size() < k_header_size) {
+    return std::nullopt;
+  }
+
+  QDataStream stream(&file);
+  stream.setByteOrder(QDataStream::LittleEndian);
+  char magic[k_magic_size];
+  quint32 version = 0;
+  quint32 stored_stride = 0;
+  quint64 count = 0;
+  stream.readRawData(magic, k_magic_size);
+  stream >> version >> stored_stride >> count;
+  if (stream.status() != QDataStream::Ok ||
+      std::memcmp(magic, k_magic, k_magic_size) != 0 ||
+      version != k_instance_cache_version || stored_stride != stride ||
+      count * stride != static_cast<quint64>(file.size() - k_header_size)) {
+    return std::nullopt;
+  }
+
+  QByteArray bytes = file.readAll();
+  if (static_cast<quint64>(bytes.size()) != count * stride) {
+    return std::nullopt;
+  }
+  return bytes;
+}
+
+void write_cached_instance_bytes(const InstanceCacheKey& key,
+                                 std::size_t stride,
+                                 const void* data,
+                                 std::size_t size) {
+  const QString directory = cache_directory();
+  if (directory.isEmpty() || !QDir().mkpath(directory)) {
+    return;
+  }
+
+  QSaveFile file(directory + QLatin1Char('/') + key.file_name());
+  if (!file.open(QIODevice::WriteOnly)) {
+    return;
+  }
+  QDataStream stream(&file);
+  stream.setByteOrder(QDataStream::LittleEndian);
+  stream.writeRawData(k_magic, k_magic_size);
+  stream << k_instance_cache_version << static_cast<quint32>(stride)
+         << static_cast<quint64>(size / stride);
+  stream.writeRawData(static_cast<const char*>(data), static_cast<int>(size));
+  if (stream.status() != QDataStream::Ok || !file.commit()) {
+    return;
+  }
+  prune_cache(QDir(directory), key.kind());
+}
+
+} // namespace Render::Ground::Scatter
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QString>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace Game::Map {
+struct BiomeSettings;
+struct WorldProp;
+} // namespace Game::Map
+
+namespace Render::Ground::Scatter {
+
+inline constexpr std::uint32_t k_instance_cache_version = 1U;
+inline constexpr int k_max_cached_layouts_per_kind = 8;
+
+void run_generation_jobs(std::size_t job_count,
+                         const std::function<void(std::size_t)>& job);
+
+// Pins the generation pool to `workers` threads; nullopt restores the default.
+void set_generation_worker_count(std::optional<std::size_t> workers);
+
+// Redirects the on-disk instance cache; an empty path restores the platform
+// cache directory.
+void set_cache_directory(const QString& directory);
+
+class InstanceCacheKey {
+public:
+  explicit InstanceCacheKey(const char* kind);
+
+  void add_bytes(const void* data, std::size_t size);
+
+  template <typename T> void add(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    add_bytes(&value, sizeof(T));
+  }
+
+  template <typename T> void add_all(const std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    add(static_cast<std::uint64_t>(values.size()));
+    add_bytes(values.data(), values.size() * sizeof(T));
+  }
+
+  // Field by field: both structs carry padding, so their raw bytes are not a key.
+  void add_biome_settings(const Game::Map::BiomeSettings& settings);
+  void add_world_props(const std::vector<Game::Map::WorldProp>& props);
+
+  void add_placement_obstacles();
+
+  [[nodiscard]] auto kind() const -> const QString& { return m_kind; }
+  [[nodiscard]] auto file_name() const -> QString;
+
+private:
+  QString m_kind;
+  QCryptographicHash m_hash{QCryptographicHash::Sha256};
+};
+
+[[nodiscard]] auto
+read_cached_instance_bytes(const InstanceCacheKey& key,
+                           std::size_t stride) -> std::optional<QByteArray>;
+
+void write_cached_instance_bytes(const InstanceCacheKey& key,
+                                 std::size_t stride,
+                                 const void* data,
+                                 std::size_t size);
+
+template <typename Instance>
+auto load_cached_instances(const InstanceCacheKey& key,
+                           std::vector<Instance>& out) -> bool {
+  static_assert(std::is_trivially_copyable_v<Instance>);
+  const auto bytes = read_cached_instance_bytes(key, sizeof(Instance));
+  if (!bytes) {
+    return false;
+  }
+  out.resize(static_cast<std::size_t>(bytes->size()) / sizeof(Instance));
+  std::memcpy(out.data(), bytes->constData(), out.size() * sizeof(Instance));
+  return true;
+}
+
+template <typename Instance>
+void store_cached_instances(const InstanceCacheKey& key,
+                            const std::vector<Instance>& instances) {
+  static_assert(std::is_trivially_copyable_v<Instance>);
+  write_cached_instance_bytes(
+      key, sizeof(Instance), instances.data(), instances.size() * sizeof(Instance));
+}
+
+} // namespace Render::Ground::Scatter
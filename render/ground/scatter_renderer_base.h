@@ -12,6 +12,7 @@
 #include "i_scatter_pass.h"
 #include "render/decoration_gpu.h"
 #include "render/scene_renderer.h"
+#include "scatter_generation.h"
 #include "scatter_renderer_state.h"
 #include "scatter_submission.h"
 
@@ -81,11 +82,46 @@ protected:
     m_procedural_generations = 0;
   }
 
+  // Everything the height-scatter generators read besides `props`, which is
+  // whichever prop list the pass places around.
+  void add_scatter_inputs(Render::Ground::Scatter::InstanceCacheKey& key,
+                          const std::vector<Game::Map::WorldProp>& props) const {
+    key.add(m_width);
+    key.add(m_height);
+    key.add(m_tile_size);
+    key.add(m_noise_seed);
+    key.add_all(m_height_data);
+    key.add_all(m_terrain_types);
+    key.add_biome_settings(m_biome_settings);
+    key.add_world_props(props);
+    key.add_placement_obstacles();
+  }
+
+  // Fills m_state.instances from the disk cache, or runs `generate` and stores
+  // what it produced.
+  template <typename Generate>
+  void generate_cached_instances(const char* kind, Generate&& generate) {
+    Render::Ground::Scatter::InstanceCacheKey key(kind);
+    add_scatter_inputs(key, m_world_props);
+    if (!Render::Ground::Scatter::load_cached_instances(key, m_state.instances)) {
+      m_state.instances.clear();
+      generate();
+      Render::Ground::Scatter::store_cached_instances(key, m_state.instances);
+    }
+    finish_instance_rebuild();
+  }
+
   template <typename GenerateProcedural>
-  void append_procedural_instances(GenerateProcedural&& generate) {
+  void append_procedural_instances(const char* kind, GenerateProcedural&& generate) {
     if (!m_procedural_cached) {
-      m_procedural_instances.clear();
-      generate(m_procedural_instances);
+      Render::Ground::Scatter::InstanceCacheKey key(kind);
+      add_scatter_inputs(key, m_scatter_seed_world_props);
+      if (!Render::Ground::Scatter::load_cached_instances(key,
+                                                          m_procedural_instances)) {
+        m_procedural_instances.clear();
+        generate(m_procedural_instances);
+        Render::Ground::Scatter::store_cached_instances(key, m_procedural_instances);
+      }
       m_procedural_cached = true;
       ++m_procedural_generations;
     }
@@ -104,6 +140,10 @@ public:
     return m_procedural_generations;
   }
 
+  [[nodiscard]] auto instances_for_test() const -> const std::vector<Instance>& {
+    return m_state.instances;
+  }
+
 protected:
   void set_light_direction_common(const QVector3D& dir,
                                   const QVector3D& default_direction) {
@@ -45,7 +45,7 @@ void StoneRenderer::configure(const Game::Map::TerrainHeightMap& height_map,
   stone_params.light_direction = m_light_direction;
   stone_params.time = 0.0F;
 
-  generate_stone_instances();
+  generate_cached_instances("stone", [this] { generate_stone_instances(); });
 }
 
 void StoneRenderer::set_light_direction(const QVector3D& dir) {
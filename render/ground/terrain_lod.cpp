@@ -0,0 +1,293 @@
+#include "terrain_lod.h"
+
+#include <QMatrix4x4>
+#include <QVector3D>
+#include <QVector4D>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace Render::GL {
+
+namespace {
+
+// Head-room for the vertex shader's height noise, which the bounds never see.
+constexpr float k_bounds_height_pad = 0.25F;
+
+auto sphere_intersects_box(const QVector3D& center,
+                           float radius,
+                           const QVector3D& box_min,
+                           const QVector3D& box_max) -> bool {
+  const float dx =
+      std::max({box_min.x() - center.x(), 0.0F, center.x() - box_max.x()});
+  const float dy =
+      std::max({box_min.y() - center.y(), 0.0F, center.y() - box_max.y()});
+  const float dz =
+      std::max({box_min.z() - center.z(), 0.0F, center.z() - box_max.z()});
+  return dx * dx + dy * dy + dz * dz <= radius * radius;
+}
+
+auto lattice_steps(int quads, int step) -> int { return (quads + step - 1) / step; }
+
+} // namespace
+
+auto TerrainLodFrustum::from_view_projection(const QMatrix4x4& view_projection)
+    -> TerrainLodFrustum {
+  const QVector4D row_x = view_projection.row(0);
+  const QVector4D row_y = view_projection.row(1);
+  const QVector4D row_z = view_projection.row(2);
+  const QVector4D row_w = view_projection.row(3);
+
+  TerrainLodFrustum frustum;
+  frustum.planes = {row_w + row_x,
+                    row_w - row_x,
+                    row_w + row_y,
+                    row_w - row_y,
+                    row_w + row_z,
+                    row_w - row_z};
+  for (auto& plane : frustum.planes) {
+    const float length = plane.toVector3D().length();
+    if (length > 0.0F) {
+      plane /= length;
+    }
+  }
+  frustum.enabled = true;
+  return frustum;
+}
+
+auto TerrainLodFrustum::intersects_box(const QVector3D& box_min,
+                                       const QVector3D& box_max,
+                                       float margin) const -> bool {
+  if (!enabled) {
+    return true;
+  }
+  for (const auto& plane : planes) {
+    const QVector3D farthest(plane.x() >= 0.0F ? box_max.x() : box_min.x(),
+                             plane.y() >= 0.0F ? box_max.y() : box_min.y(),
+                             plane.z() >= 0.0F ? box_max.z() : box_min.z());
+    if (QVector3D::dotProduct(plane.toVector3D(), farthest) + plane.w() < -margin) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TerrainLodTree::build(const std::vector<float>& heights,
+                           int width,
+                           int height,
+                           float tile_size,
+                           const TerrainLodSettings& settings) {
+  m_nodes.clear();
+  m_roots.clear();
+  m_width = width;
+  m_height = height;
+  m_tile_size = std::max(tile_size, 1e-4F);
+  m_leaf_quads = std::max(1, settings.leaf_quads);
+
+  // The coarsest level still has to land on every leaf's lattice, so its step
+  // may not exceed a leaf.
+  m_levels = std::clamp(settings.levels, 1, k_terrain_lod_max_levels);
+  while (m_levels > 1 && (1 << (m_levels - 1)) > m_leaf_quads) {
+    --m_levels;
+  }
+
+  const float ratio = std::max(settings.range_ratio, 1.5F);
+  const float morph_start = std::clamp(settings.morph_start, 0.0F, 0.95F);
+  float previous = 0.0F;
+  float range = std::max(settings.base_range, 1e-3F);
+  for (int level = 0; level < m_levels; ++level) {
+    m_ranges[static_cast<std::size_t>(level)] = range;
+    m_morph_starts[static_cast<std::size_t>(level)] =
+        previous + (range - previous) * morph_start;
+    previous = range;
+    range *= ratio;
+  }
+
+  const std::size_t vertex_count =
+      static_cast<std::size_t>(std::max(width, 0)) *
+      static_cast<std::size_t>(std::max(height, 0));
+  if (width < 2 || height < 2 || heights.size() < vertex_count) {
+    m_leaves_x = 0;
+    m_leaves_z = 0;
+    return;
+  }
+
+  m_leaves_x = lattice_steps(width - 1, m_leaf_quads);
+  m_leaves_z = lattice_steps(height - 1, m_leaf_quads);
+
+  const int root_size = m_leaf_quads << (m_levels - 1);
+  for (int root_z = 0; root_z < height - 1; root_z += root_size) {
+    for (int root_x = 0; root_x < width - 1; root_x += root_size) {
+      m_roots.push_back(build_node(heights, root_x, root_z, root_size, m_levels - 1));
+    }
+  }
+}
+
+auto TerrainLodTree::build_node(const std::vector<float>& heights,
+                                int min_x,
+                                int min_z,
+                                int size,
+                                int level) -> int {
+  Node node;
+  node.min_x = min_x;
+  node.min_z = min_z;
+  node.max_x = std::min(min_x + size, m_width - 1);
+  node.max_z = std::min(min_z + size, m_height - 1);
+
+  float min_y = std::numeric_limits<float>::max();
+  float max_y = std::numeric_limits<float>::lowest();
+  if (level == 0) {
+    for (int z = node.min_z; z <= node.max_z; ++z) {
+      for (int x = node.min_x; x <= node.max_x; ++x) {
+        const float h = heights[static_cast<std::size_t>(z) *
+                                    static_cast<std::size_t>(m_width) +
+                                static_cast<std::size_t>(x)];
+        min_y = std::min(min_y, h);
+        max_y = std::max(max_y, h);
+      }
+    }
+  } else {
+    const int half = size / 2;
+    for (int child = 0; child < 4; ++child) {
+      const int child_x = min_x + (child & 1) * half;
+      const int child_z = min_z + (child >> 1) * half;
+      if (child_x >= m_width - 1 || child_z >= m_height - 1) {
+        continue;
+      }
+      const int index = build_node(heights, child_x, child_z, half, level - 1);
+      node.children[static_cast<std::size_t>(child)] = index;
+      min_y = std::min(min_y, m_nodes[static_cast<std::size_t>(index)].bounds_min.y());
+      max_y = std::max(max_y, m_nodes[static_cast<std::size_t>(index)].bounds_max.y());
+    }
+  }
+
+  const float half_width = static_cast<float>(m_width) * 0.5F - 0.5F;
+  const float half_height = static_cast<float>(m_height) * 0.5F - 0.5F;
+  node.bounds_min =
+      QVector3D((static_cast<float>(node.min_x) - half_width) * m_tile_size,
+                min_y - k_bounds_height_pad,
+                (static_cast<float>(node.min_z) - half_height) * m_tile_size);
+  node.bounds_max =
+      QVector3D((static_cast<float>(node.max_x) - half_width) * m_tile_size,
+                max_y + k_bounds_height_pad,
+                (static_cast<float>(node.max_z) - half_height) * m_tile_size);
+
+  m_nodes.push_back(node);
+  return static_cast<int>(m_nodes.size()) - 1;
+}
+
+void TerrainLodTree::select(const TerrainLodView& view,
+                            std::vector<TerrainLodArea>& out,
+                            TerrainLodReport* report) const {
+  for (const int root : m_roots) {
+    // Terrain beyond the coarsest range is still drawn, at the coarsest level.
+    if (select_node(root, m_levels - 1, view, out, report) == Visit::OutOfRange) {
+      emit(m_nodes[static_cast<std::size_t>(root)], m_levels - 1, out, report);
+    }
+  }
+}
+
+auto TerrainLodTree::select_node(int index,
+                                 int level,
+                                 const TerrainLodView& view,
+                                 std::vector<TerrainLodArea>& out,
+                                 TerrainLodReport* report) const -> Visit {
+  const Node& node = m_nodes[static_cast<std::size_t>(index)];
+  if (!view.frustum.intersects_box(
+          node.bounds_min, node.bounds_max, view.cull_margin)) {
+    if (report != nullptr) {
+      ++report->culled_nodes;
+    }
+    return Visit::Culled;
+  }
+  if (!sphere_intersects_box(view.eye,
+                             m_ranges[static_cast<std::size_t>(level)],
+                             node.bounds_min,
+                             node.bounds_max)) {
+    return Visit::OutOfRange;
+  }
+  if (level == 0 ||
+      !sphere_intersects_box(view.eye,
+                             m_ranges[static_cast<std::size_t>(level - 1)],
+                             node.bounds_min,
+                             node.bounds_max)) {
+    emit(node, level, out, report);
+    return Visit::Selected;
+  }
+
+  // Quadrants the finer range does not reach stay at this level.
+  for (const int child : node.children) {
+    if (child < 0) {
+      continue;
+    }
+    if (select_node(child, level - 1, view, out, report) == Visit::OutOfRange) {
+      emit(m_nodes[static_cast<std::size_t>(child)], level, out, report);
+    }
+  }
+  return Visit::Selected;
+}
+
+void TerrainLodTree::emit(const Node& node,
+                          int level,
+                          std::vector<TerrainLodArea>& out,
+                          TerrainLodReport* report) const {
+  TerrainLodArea area;
+  area.min_x = node.min_x;
+  area.min_z = node.min_z;
+  area.max_x = node.max_x;
+  area.max_z = node.max_z;
+  area.level = level;
+  if (level + 1 < m_levels) {
+    area.morph_start = m_morph_starts[static_cast<std::size_t>(level)];
+    area.morph_end = m_ranges[static_cast<std::size_t>(level)];
+  }
+  out.push_back(area);
+
+  if (report == nullptr) {
+    return;
+  }
+  const int quads_x = area.max_x - area.min_x;
+  const int quads_z = area.max_z - area.min_z;
+  const std::size_t triangles = terrain_lod_triangles(quads_x, quads_z, level);
+  ++report->areas;
+  report->triangles += triangles;
+  report->full_density_triangles += terrain_lod_triangles(quads_x, quads_z, 0);
+  ++report->areas_per_level[static_cast<std::size_t>(level)];
+  report->triangles_per_level[static_cast<std::size_t>(level)] += triangles;
+}
+
+auto terrain_lod_triangles(int quads_x, int quads_z, int level) -> std::size_t {
+  const int step = 1 << level;
+  return 2U * static_cast<std::size_t>(lattice_steps(quads_x, step)) *
+         static_cast<std::size_t>(lattice_steps(quads_z, step));
+}
+
+auto build_terrain_lod_grid(int quads_x,
+                            int quads_z,
+                            int step) -> std::vector<unsigned int> {
+  std::vector<unsigned int> indices;
+  if (quads_x <= 0 || quads_z <= 0 || step <= 0) {
+    return indices;
+  }
+  indices.reserve(static_cast<std::size_t>(lattice_steps(quads_x, step)) *
+                  static_cast<std::size_t>(lattice_steps(quads_z, step)) * 6U);
+  const auto vertex = [quads_x](int x, int z) {
+    return static_cast<unsigned int>(z * (quads_x + 1) + x);
+  };
+  for (int z = 0; z < quads_z; z += step) {
+    const int next_z = std::min(z + step, quads_z);
+    for (int x = 0; x < quads_x; x += step) {
+      const int next_x = std::min(x + step, quads_x);
+      const unsigned int v0 = vertex(x, z);
+      const unsigned int v1 = vertex(next_x, z);
+      const unsigned int v2 = vertex(x, next_z);
+      const unsigned int v3 = vertex(next_x, next_z);
+      indices.insert(indices.end(), {v0, v1, v2, v2, v1, v3});
+    }
+  }
+  return indices;
+}
+
+} // namespace Render::GL
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <QMatrix4x4>
+#include <QVector3D>
+#include <QVector4D>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace Render::GL {
+
+inline constexpr int k_terrain_lod_max_levels = 5;
+
+// Continuous distance LOD over the heightmap. A leaf node is one terrain chunk;
+// a node at level L covers 2^L leaves per side and is drawn every 2^L quads,
+// so every selected node costs the same number of triangles.
+struct TerrainLodSettings {
+  int leaf_quads = 16;
+  int levels = k_terrain_lod_max_levels;
+  // World distance covered by level 0; each coarser level reaches
+  // `range_ratio` times further.
+  float base_range = 64.0F;
+  float range_ratio = 2.0F;
+  // Fraction of each level's band after which vertices start morphing toward
+  // the next coarser lattice.
+  float morph_start = 0.7F;
+};
+
+// Planes face inwards: a point is inside when dot(normal, p) + w >= 0.
+struct TerrainLodFrustum {
+  std::array<QVector4D, 6> planes{};
+  bool enabled = false;
+
+  [[nodiscard]] static auto
+  from_view_projection(const QMatrix4x4& view_projection) -> TerrainLodFrustum;
+
+  [[nodiscard]] auto intersects_box(const QVector3D& box_min,
+                                    const QVector3D& box_max,
+                                    float margin = 0.0F) const -> bool;
+};
+
+struct TerrainLodView {
+  QVector3D eye;
+  TerrainLodFrustum frustum;
+  float cull_margin = 0.0F;
+};
+
+// A selected node, or a quadrant of one, in heightmap quads: [min, max).
+// Vertices blend toward the next coarser lattice between `morph_start` and
+// `morph_end`; `morph_end` is zero at the coarsest level, which never morphs.
+struct TerrainLodArea {
+  int min_x = 0;
+  int min_z = 0;
+  int max_x = 0;
+  int max_z = 0;
+  int level = 0;
+  float morph_start = 0.0F;
+  float morph_end = 0.0F;
+};
+
+struct TerrainLodReport {
+  std::size_t areas = 0;
+  std::size_t culled_nodes = 0;
+  std::size_t triangles = 0;
+  // The same visible areas drawn at full density.
+  std::size_t full_density_triangles = 0;
+  std::array<std::size_t, k_terrain_lod_max_levels> areas_per_level{};
+  std::array<std::size_t, k_terrain_lod_max_levels> triangles_per_level{};
+};
+
+class TerrainLodTree {
+public:
+  void build(const std::vector<float>& heights,
+             int width,
+             int height,
+             float tile_size,
+             const TerrainLodSettings& settings = {});
+
+  // Walks the quadtree from the roots and appends the areas to draw.
+  void select(const TerrainLodView& view,
+              std::vector<TerrainLodArea>& out,
+              TerrainLodReport* report = nullptr) const;
+
+  [[nodiscard]] auto levels() const -> int { return m_levels; }
+  [[nodiscard]] auto leaf_quads() const -> int { return m_leaf_quads; }
+  [[nodiscard]] auto leaves_x() const -> int { return m_leaves_x; }
+  [[nodiscard]] auto leaves_z() const -> int { return m_leaves_z; }
+  [[nodiscard]] auto range(int level) const -> float {
+    return m_ranges[static_cast<std::size_t>(level)];
+  }
+  [[nodiscard]] auto node_count() const -> std::size_t { return m_nodes.size(); }
+
+private:
+  struct Node {
+    int min_x = 0;
+    int min_z = 0;
+    int max_x = 0;
+    int max_z = 0;
+    QVector3D bounds_min;
+    QVector3D bounds_max;
+    std::array<int, 4> children{-1, -1, -1, -1};
+  };
+
+  enum class Visit { Culled, OutOfRange, Selected };
+
+  auto build_node(const std::vector<float>& heights,
+                  int min_x,
+                  int min_z,
+                  int size,
+                  int level) -> int;
+  auto select_node(int index,
+                   int level,
+                   const TerrainLodView& view,
+                   std::vector<TerrainLodArea>& out,
+                   TerrainLodReport* report) const -> Visit;
+  void emit(const Node& node,
+            int level,
+            std::vector<TerrainLodArea>& out,
+            TerrainLodReport* report) const;
+
+  int m_width = 0;
+  int m_height = 0;
+  float m_tile_size = 1.0F;
+  int m_leaf_quads = 16;
+  int m_levels = 1;
+  int m_leaves_x = 0;
+  int m_leaves_z = 0;
+  std::array<float, k_terrain_lod_max_levels> m_ranges{};
+  std::array<float, k_terrain_lod_max_levels> m_morph_starts{};
+  std::vector<Node> m_nodes;
+  std::vector<int> m_roots;
+};
+
+// Triangles an area of `quads_x` by `quads_z` quads costs at `level`.
+[[nodiscard]] auto terrain_lod_triangles(int quads_x,
+                                         int quads_z,
+                                         int level) -> std::size_t;
+
+// Index list over a (quads_x + 1) by (quads_z + 1) row-major vertex grid that
+// draws every `step` quads, clipping the last row and column to the grid.
+// Leaves of the same size share one list per level; the winding matches the
+// full-density chunk meshes.
+[[nodiscard]] auto build_terrain_lod_grid(int quads_x,
+                                          int quads_z,
+                                          int step) -> std::vector<unsigned int>;
+
+} // namespace Render::GL
@@ -3,6 +3,7 @@
 #include <QMatrix4x4>
 #include <QVector3D>
 
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <functional>
@@ -18,6 +19,7 @@
 #include "render/i_render_pass.h"
 #include "render/mist_volume.h"
 #include "render/world_chunk.h"
+#include "render/ground/terrain_lod.h"
 
 namespace Render::GL {
 class Buffer;
@@ -41,6 +43,11 @@ public:
 
   void set_wireframe(bool enable) { m_wireframe = enable; }
 
+  // What the last submit selected, in grid triangles per LOD level.
+  [[nodiscard]] auto lod_report() const -> const TerrainLodReport& {
+    return m_lod_report;
+  }
+
 private:
   void build_meshes();
   [[nodiscard]] static auto
@@ -119,6 +126,16 @@ private:
                           int chunk_max_z,
                           std::size_t& total_triangles);
 
+  // Coarser meshes for every LOD level above 0, split into the same sections
+  // as the full-density chunk and built from the shared per-level grids.
+  void emit_chunk_lods(const TerrainMeshBuild& build,
+                       int chunk_x,
+                       int chunk_z,
+                       int chunk_max_x,
+                       int chunk_max_z,
+                       const std::vector<int>& quad_sections,
+                       const std::array<int, 3>& section_chunks);
+
   void finish_chunk_section(const TerrainMeshBuild& build,
                             const SectionData& section,
                             int section_index,
@@ -128,6 +145,7 @@ private:
                             int chunk_max_z,
                             std::size_t& total_triangles);
 
+  void select_lods(const Renderer& renderer);
   auto update_height_texture() -> TerrainSurfaceCmd::HeightResources;
   void bake_terrain_fields();
   void bake_terrain_noise_atlas();
@@ -138,6 +156,10 @@ private:
                                        float height) const -> QVector3D;
   struct ChunkMesh {
     std::unique_ptr<Mesh> mesh;
+    // Index k holds LOD level k + 1; empty where a coarser quad gave this
+    // section's area to a higher-priority one.
+    std::array<std::unique_ptr<Mesh>, k_terrain_lod_max_levels - 1> lod_meshes;
+    int leaf = 0;
     int min_x = 0;
     int max_x = 0;
     int min_z = 0;
@@ -159,6 +181,12 @@ private:
     TerrainChunkParams params;
   };
 
+  struct LeafLod {
+    int level = -1;
+    float morph_start = 0.0F;
+    float morph_end = 0.0F;
+  };
+
   struct ChunkVisibilityCacheEntry {
     std::uint64_t visibility_version = std::numeric_limits<std::uint64_t>::max();
     bool any_revealed = true;
@@ -190,6 +218,11 @@ private:
   bool m_noise_atlas_dirty = true;
   std::vector<ChunkMesh> m_chunks;
   std::vector<ChunkVisibilityCacheEntry> m_chunk_visibility_cache;
+  TerrainLodTree m_lod_tree;
+  std::vector<std::vector<unsigned int>> m_lod_grids;
+  std::vector<TerrainLodArea> m_lod_areas;
+  std::vector<LeafLod> m_leaf_lods;
+  TerrainLodReport m_lod_report;
   Game::Map::BiomeSettings m_biome_settings;
   std::uint32_t m_noise_seed = 0U;
   QVector3D m_light_direction{0.65F, 0.50F, 0.40F};
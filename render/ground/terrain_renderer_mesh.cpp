@@ -7,6 +7,7 @@
 #include <qvectornd.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -25,6 +26,7 @@
 #include "render/gl/render_constants.h"
 #include "render/gl/resources.h"
 #include "render/scene_renderer.h"
+#include "terrain_lod.h"
 #include "terrain_renderer.h"
 #include "world_chunk.h"
 
@@ -34,6 +36,10 @@ using std::uint32_t;
 using namespace Render::GL::Geometry;
 using namespace Render::Ground;
 
+// Level 0 reaches this many leaf chunks from the camera; with four the
+// coarser bands stay wider than a node, so neighbours differ by one level.
+constexpr float k_lod_base_range_leaves = 4.0F;
+
 inline auto apply_tint(const QVector3D& color, float tint) -> QVector3D {
   QVector3D const c = color * tint;
   return {std::clamp(c.x(), 0.0F, 1.0F),
@@ -544,6 +550,10 @@ void TerrainRenderer::emit_terrain_chunk(const TerrainMeshBuild& build,
     return add_vertex(section, pos, normal, entry_mask);
   };
 
+  std::vector<int> quad_sections;
+  quad_sections.reserve(static_cast<std::size_t>(chunk_max_x - chunk_x) *
+                        static_cast<std::size_t>(chunk_max_z - chunk_z));
+
   for (int z = chunk_z; z < chunk_max_z; ++z) {
     for (int x = chunk_x; x < chunk_max_x; ++x) {
       int const idx0 = z * m_width + x;
@@ -555,6 +565,7 @@ void TerrainRenderer::emit_terrain_chunk(const TerrainMeshBuild& build,
                                              m_terrain_types[idx1],
                                              m_terrain_types[idx2],
                                              m_terrain_types[idx3]);
+      quad_sections.push_back(section_index);
 
       SectionData& section = sections[section_index];
       unsigned int const v0 = ensure_vertex(section, idx0);
@@ -677,10 +688,12 @@ void TerrainRenderer::emit_terrain_chunk(const TerrainMeshBuild& build,
     }
   }
 
+  std::array<int, 3> section_chunks{-1, -1, -1};
   for (int i = 0; i < 3; ++i) {
     if (sections[i].indices.empty()) {
       continue;
     }
+    section_chunks[static_cast<std::size_t>(i)] = static_cast<int>(m_chunks.size());
     finish_chunk_section(build,
                          sections[i],
                          i,
@@ -690,11 +703,102 @@ void TerrainRenderer::emit_terrain_chunk(const TerrainMeshBuild& build,
                          chunk_max_z,
                          total_triangles);
   }
+
+  emit_chunk_lods(
+      build, chunk_x, chunk_z, chunk_max_x, chunk_max_z, quad_sections, section_chunks);
+}
+
+void TerrainRenderer::emit_chunk_lods(const TerrainMeshBuild& build,
+                                      int chunk_x,
+                                      int chunk_z,
+                                      int chunk_max_x,
+                                      int chunk_max_z,
+                                      const std::vector<int>& quad_sections,
+                                      const std::array<int, 3>& section_chunks) {
+  const int quads_x = chunk_max_x - chunk_x;
+  const int quads_z = chunk_max_z - chunk_z;
+  const int leaf_quads = m_lod_tree.leaf_quads();
+  const int leaf =
+      (chunk_z / leaf_quads) * m_lod_tree.leaves_x() + chunk_x / leaf_quads;
+  for (const int chunk_index : section_chunks) {
+    if (chunk_index >= 0) {
+      m_chunks[static_cast<std::size_t>(chunk_index)].leaf = leaf;
+    }
+  }
+
+  struct LodSection {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    std::unordered_map<unsigned int, unsigned int> remap;
+  };
+
+  for (int level = 1; level < m_lod_tree.levels(); ++level) {
+    const int step = 1 << level;
+    const bool full_leaf = quads_x == leaf_quads && quads_z == leaf_quads;
+    std::vector<unsigned int> partial_grid;
+    if (!full_leaf) {
+      partial_grid = build_terrain_lod_grid(quads_x, quads_z, step);
+    }
+    const std::vector<unsigned int>& grid =
+        full_leaf ? m_lod_grids[static_cast<std::size_t>(level)] : partial_grid;
+
+    std::array<LodSection, 3> sections;
+    auto local_vertex = [&](LodSection& section, unsigned int grid_vertex) {
+      auto it = section.remap.find(grid_vertex);
+      if (it != section.remap.end()) {
+        return it->second;
+      }
+      int const local_x = static_cast<int>(grid_vertex) % (quads_x + 1);
+      int const local_z = static_cast<int>(grid_vertex) / (quads_x + 1);
+      int const global_index = (chunk_z + local_z) * m_width + chunk_x + local_x;
+      const QVector3D& pos = build.positions[global_index];
+      const QVector3D& normal = build.normals[global_index];
+      Vertex v{};
+      v.position = {pos.x(), pos.y(), pos.z()};
+      v.normal = {normal.x(), normal.y(), normal.z()};
+      v.tex_coord[0] = build.feature_foot_weight[global_index];
+      v.tex_coord[1] =
+          build.entry_weight.empty() ? 0.0F : build.entry_weight[global_index];
+      section.vertices.push_back(v);
+      auto const local_index = static_cast<unsigned int>(section.vertices.size() - 1);
+      section.remap.emplace(grid_vertex, local_index);
+      return local_index;
+    };
+
+    // A coarse quad joins the highest-priority section among the quads it
+    // covers, the same rule the full-density mesh applies to its corners.
+    for (std::size_t quad = 0; quad + 5 < grid.size(); quad += 6) {
+      int const local_x = static_cast<int>(grid[quad]) % (quads_x + 1);
+      int const local_z = static_cast<int>(grid[quad]) / (quads_x + 1);
+      int section_index = 0;
+      for (int z = local_z; z < std::min(local_z + step, quads_z); ++z) {
+        for (int x = local_x; x < std::min(local_x + step, quads_x); ++x) {
+          section_index = std::max(
+              section_index, quad_sections[static_cast<std::size_t>(z * quads_x + x)]);
+        }
+      }
+      LodSection& section = sections[static_cast<std::size_t>(section_index)];
+      for (std::size_t corner = 0; corner < 6; ++corner) {
+        section.indices.push_back(local_vertex(section, grid[quad + corner]));
+      }
+    }
+
+    for (std::size_t i = 0; i < sections.size(); ++i) {
+      if (sections[i].indices.empty() || section_chunks[i] < 0) {
+        continue;
+      }
+      m_chunks[static_cast<std::size_t>(section_chunks[i])]
+          .lod_meshes[static_cast<std::size_t>(level - 1)] =
+          std::make_unique<Mesh>(sections[i].vertices, sections[i].indices);
+    }
+  }
 }
 
 void TerrainRenderer::build_meshes() {
   m_chunks.clear();
   m_chunk_visibility_cache.clear();
+  m_lod_tree = TerrainLodTree{};
+  m_lod_grids.clear();
 
   if (m_width < 2 || m_height < 2 || m_height_data.empty()) {
     return;
@@ -873,6 +977,16 @@ void TerrainRenderer::build_meshes() {
   const int chunk_size = default_chunk_size;
   std::size_t total_triangles = 0;
 
+  TerrainLodSettings lod_settings;
+  lod_settings.leaf_quads = chunk_size;
+  lod_settings.base_range = k_lod_base_range_leaves * chunk_size * m_tile_size;
+  m_lod_tree.build(height_data, m_width, m_height, m_tile_size, lod_settings);
+  m_lod_grids.assign(static_cast<std::size_t>(m_lod_tree.levels()), {});
+  for (int level = 1; level < m_lod_tree.levels(); ++level) {
+    m_lod_grids[static_cast<std::size_t>(level)] =
+        build_terrain_lod_grid(chunk_size, chunk_size, 1 << level);
+  }
+
   const TerrainMeshBuild build{.positions = positions,
                                .normals = normals,
                                .height_data = height_data,
@@ -13,6 +13,8 @@
 #include "render/gl/shader.h"
 #include "render/gl/texture.h"
 #include "render/scene_renderer.h"
+#include "render/submission_visibility.h"
+#include "terrain_lod.h"
 #include "terrain_renderer.h"
 
 namespace {
@@ -37,6 +39,9 @@ constexpr std::size_t k_terrain_field_channels = 4U;
 constexpr int k_microdetail_size = 1024;
 constexpr float k_microdetail_cells = 32.0F;
 
+constexpr float k_chunk_enter_margin = 2.0F;
+constexpr float k_chunk_keep_margin = 24.0F;
+
 } // namespace
 
 void TerrainRenderer::bake_terrain_fields() {
@@ -462,6 +467,44 @@ auto TerrainRenderer::update_height_texture() -> TerrainSurfaceCmd::HeightResour
   return resources;
 }
 
+void TerrainRenderer::select_lods(const Renderer& renderer) {
+  const std::size_t leaf_count = static_cast<std::size_t>(m_lod_tree.leaves_x()) *
+                                 static_cast<std::size_t>(m_lod_tree.leaves_z());
+  m_leaf_lods.assign(leaf_count, {});
+  m_lod_areas.clear();
+  m_lod_report = {};
+
+  const Camera* camera = renderer.camera();
+  if (camera == nullptr) {
+    std::fill(m_leaf_lods.begin(), m_leaf_lods.end(), LeafLod{.level = 0});
+    return;
+  }
+
+  // The tree culls with the keep margin so every chunk the per-chunk test
+  // below would keep is still selected.
+  TerrainLodView view;
+  view.eye = camera->get_position();
+  view.frustum =
+      TerrainLodFrustum::from_view_projection(camera->get_view_projection_matrix());
+  view.cull_margin =
+      k_chunk_keep_margin + SubmissionVisibilityPolicy::k_frustum_guard_band;
+  m_lod_tree.select(view, m_lod_areas, &m_lod_report);
+
+  const int leaf_quads = m_lod_tree.leaf_quads();
+  for (const auto& area : m_lod_areas) {
+    for (int leaf_z = area.min_z / leaf_quads; leaf_z * leaf_quads < area.max_z;
+         ++leaf_z) {
+      for (int leaf_x = area.min_x / leaf_quads; leaf_x * leaf_quads < area.max_x;
+           ++leaf_x) {
+        m_leaf_lods[static_cast<std::size_t>(leaf_z * m_lod_tree.leaves_x() + leaf_x)] =
+            {.level = area.level,
+             .morph_start = area.morph_start,
+             .morph_end = area.morph_end};
+      }
+    }
+  }
+}
+
 void TerrainRenderer::submit(Renderer& renderer, ResourceManager* resources) {
   if (m_chunks.empty()) {
     return;
@@ -483,21 +526,23 @@ void TerrainRenderer::submit(Renderer& renderer, ResourceManager* resources) {
     }
   }
 
+  select_lods(renderer);
+
   for (std::size_t chunk_index = 0; chunk_index < m_chunks.size(); ++chunk_index) {
     const auto& chunk = m_chunks[chunk_index];
     if (!chunk.mesh) {
       continue;
     }
 
-    constexpr float k_chunk_enter_margin = 2.0F;
-    constexpr float k_chunk_keep_margin = 24.0F;
+    const LeafLod& lod = m_leaf_lods[static_cast<std::size_t>(chunk.leaf)];
     if (m_chunk_visibility_cache.size() != m_chunks.size()) {
       m_chunk_visibility_cache.assign(m_chunks.size(), {});
     }
     auto& submission_cache = m_chunk_visibility_cache[chunk_index];
     const float cull_margin =
         submission_cache.was_submitted ? k_chunk_keep_margin : k_chunk_enter_margin;
-    if (!renderer.submission_visibility().accepts_sphere(chunk.cull_center,
+    if (lod.level < 0 ||
+        !renderer.submission_visibility().accepts_sphere(chunk.cull_center,
                                                          chunk.cull_radius +
                                                              cull_margin,
                                                          SubmissionFogMode::Ignore)) {
@@ -505,6 +550,12 @@ void TerrainRenderer::submit(Renderer& renderer, ResourceManager* resources) {
       continue;
     }
     submission_cache.was_submitted = true;
+    Mesh* mesh = lod.level == 0
+                     ? chunk.mesh.get()
+                     : chunk.lod_meshes[static_cast<std::size_t>(lod.level - 1)].get();
+    if (mesh == nullptr) {
+      continue;
+    }
 
     if (visibility_snapshot != nullptr) {
       auto& cache = m_chunk_visibility_cache[chunk_index];
@@ -529,12 +580,22 @@ void TerrainRenderer::submit(Renderer& renderer, ResourceManager* resources) {
     }
 
     TerrainSurfaceCmd cmd;
-    cmd.mesh = chunk.mesh.get();
+    cmd.mesh = mesh;
     cmd.model = k_identity_matrix;
     cmd.params = chunk.params;
     cmd.height = height_resources;
     cmd.visibility = visibility_resources;
     cmd.params.light_direction = m_light_direction;
+    if (lod.morph_end > 0.0F) {
+      cmd.lod_morph = {.start = lod.morph_start,
+                       .end = lod.morph_end,
+                       .step = static_cast<float>(2 << lod.level)};
+    }
+    // Height noise would pull the shared edges of neighbouring levels apart,
+    // and it is well below a pixel where the coarse levels start.
+    if (lod.level > 0) {
+      cmd.params.height_noise_strength = 0.0F;
+    }
     cmd.sort_key = 0x0080U;
     cmd.depth_write = true;
     cmd.wireframe = m_wireframe;
@@ -4,10 +4,13 @@
 
 namespace Render {
 
-PrepareWorkerPool::PrepareWorkerPool() {
-  unsigned const hardware = std::thread::hardware_concurrency();
-  std::size_t const workers =
-      hardware > 1U ? std::min<std::size_t>(hardware - 1U, 3U) : 0U;
+PrepareWorkerPool::PrepareWorkerPool()
+    : PrepareWorkerPool([] {
+        unsigned const hardware = std::thread::hardware_concurrency();
+        return hardware > 1U ? std::min<std::size_t>(hardware - 1U, 3U) : 0U;
+      }()) {}
+
+PrepareWorkerPool::PrepareWorkerPool(std::size_t workers) {
   m_workers.reserve(workers);
   for (std::size_t i = 0; i < workers; ++i) {
     m_workers.emplace_back([this] { worker_loop(); });
@@ -15,6 +15,7 @@ public:
   using Job = std::function<void(std::size_t)>;
 
   PrepareWorkerPool();
+  explicit PrepareWorkerPool(std::size_t workers);
   ~PrepareWorkerPool();
 
   PrepareWorkerPool(const PrepareWorkerPool&) = delete;
@@ -46,6 +46,28 @@ auto describe_rigged_key(const Render::Creature::CreatureSpec& spec,
 
 } // namespace
 
+auto RiggedSkinAtlas::frame_palette(std::uint32_t global_frame) const
+    -> const QMatrix4x4* {
+  if (!ready() || global_frame >= frame_total) {
+    return nullptr;
+  }
+  auto const palette = blob->frame_palette_view(global_frame);
+  return palette.size() >= bone_count ? palette.data() : nullptr;
+}
+
+namespace {
+
+void pad_palette_with_identity(float* frame_dst, std::uint32_t bone_count) {
+  QMatrix4x4 const ident;
+  for (std::uint32_t b = bone_count; b < BonePaletteArena::k_palette_width; ++b) {
+    std::memcpy(frame_dst + b * BonePaletteArena::k_matrix_floats,
+                ident.constData(),
+                sizeof(float) * BonePaletteArena::k_matrix_floats);
+  }
+}
+
+} // namespace
+
 void rigged_entry_ensure_skin_ubo(const RiggedMeshEntry& entry) {
   if (entry.skin_atlas == nullptr) {
     return;
@@ -54,7 +76,7 @@ void rigged_entry_ensure_skin_ubo(const RiggedMeshEntry& entry) {
   if (atlas.palette_ubo != 0) {
     return;
   }
-  if (atlas.palettes.empty() || atlas.frame_total == 0 || atlas.bone_count == 0) {
+  if (!atlas.ready()) {
     return;
   }
   if (Render::Creature::runtime_bake_forbidden()) {
@@ -68,28 +90,24 @@ void rigged_entry_ensure_skin_ubo(const RiggedMeshEntry& entry) {
     return;
   }
 
+  // Raw palettes are copied straight from the mapped file. Quantized blobs
+  // only reserve the buffer; each clip is uploaded when it is first drawn.
   const std::size_t stride = BonePaletteArena::k_palette_bytes;
-  std::vector<float> staging(static_cast<std::size_t>(atlas.frame_total) *
-                                 BonePaletteArena::k_palette_floats,
-                             0.0F);
-  for (std::uint32_t f = 0; f < atlas.frame_total; ++f) {
-    const QMatrix4x4* frame_src =
-        atlas.palettes.data() + static_cast<std::size_t>(f) * atlas.bone_count;
-
-    float* frame_dst = staging.data() +
-                       static_cast<std::size_t>(f) * BonePaletteArena::k_palette_floats;
-    for (std::uint32_t b = 0; b < atlas.bone_count; ++b) {
-      std::memcpy(frame_dst + b * BonePaletteArena::k_matrix_floats,
-                  frame_src[b].constData(),
-                  sizeof(float) * BonePaletteArena::k_matrix_floats);
-    }
-
-    for (std::uint32_t b = atlas.bone_count; b < BonePaletteArena::k_palette_width;
-         ++b) {
-      QMatrix4x4 const ident;
-      std::memcpy(frame_dst + b * BonePaletteArena::k_matrix_floats,
-                  ident.constData(),
-                  sizeof(float) * BonePaletteArena::k_matrix_floats);
+  const std::size_t buffer_bytes = static_cast<std::size_t>(atlas.frame_total) * stride;
+  auto const raw = atlas.blob->palette_floats();
+  std::vector<float> staging;
+  if (!raw.empty()) {
+    staging.assign(static_cast<std::size_t>(atlas.frame_total) *
+                       BonePaletteArena::k_palette_floats,
+                   0.0F);
+    const std::size_t frame_floats =
+        static_cast<std::size_t>(atlas.bone_count) * BonePaletteArena::k_matrix_floats;
+    for (std::uint32_t f = 0; f < atlas.frame_total; ++f) {
+      float* frame_dst = staging.data() + static_cast<std::size_t>(f) *
+                                              BonePaletteArena::k_palette_floats;
+      std::memcpy(
+          frame_dst, raw.data() + f * frame_floats, sizeof(float) * frame_floats);
+      pad_palette_with_identity(frame_dst, atlas.bone_count);
     }
   }
   GLuint ubo = 0;
@@ -99,12 +117,75 @@ void rigged_entry_ensure_skin_ubo(const RiggedMeshEntry& entry) {
   }
   fn->glBindBuffer(GL_UNIFORM_BUFFER, ubo);
   fn->glBufferData(GL_UNIFORM_BUFFER,
-                   static_cast<GLsizeiptr>(staging.size() * sizeof(float)),
-                   staging.data(),
+                   static_cast<GLsizeiptr>(buffer_bytes),
+                   staging.empty() ? nullptr : staging.data(),
                    GL_STATIC_DRAW);
   fn->glBindBuffer(GL_UNIFORM_BUFFER, 0);
   atlas.palette_ubo = ubo;
   atlas.frame_stride_bytes = stride;
+  atlas.uploaded_clips.assign(atlas.blob->clip_count(), !staging.empty());
+}
+
+auto rigged_entry_ensure_skin_frame(const RiggedMeshEntry& entry,
+                                    std::uint32_t global_frame) -> std::uint64_t {
+  if (entry.skin_atlas == nullptr) {
+    return 0U;
+  }
+  auto& atlas = *entry.skin_atlas;
+  if (atlas.palette_ubo == 0U || !atlas.ready() || global_frame >= atlas.frame_total) {
+    return 0U;
+  }
+  std::uint32_t const clip_index = atlas.blob->clip_of_frame(global_frame);
+  if (clip_index >= atlas.uploaded_clips.size() || atlas.uploaded_clips[clip_index]) {
+    return 0U;
+  }
+  auto* fn = rigged_cache_gl_funcs();
+  if (fn == nullptr) {
+    return 0U;
+  }
+
+  auto const clip = atlas.blob->clip(clip_index);
+  std::vector<float> staging(static_cast<std::size_t>(clip.frame_count) *
+                                 BonePaletteArena::k_palette_floats,
+                             0.0F);
+  for (std::uint32_t f = 0; f < clip.frame_count; ++f) {
+    auto const palette = atlas.blob->frame_palette_view(clip.frame_offset + f);
+    if (palette.size() < atlas.bone_count) {
+      return 0U;
+    }
+    float* frame_dst = staging.data() +
+                       static_cast<std::size_t>(f) * BonePaletteArena::k_palette_floats;
+    for (std::uint32_t b = 0; b < atlas.bone_count; ++b) {
+      std::memcpy(frame_dst + b * BonePaletteArena::k_matrix_floats,
+                  palette[b].constData(),
+                  sizeof(float) * BonePaletteArena::k_matrix_floats);
+    }
+    pad_palette_with_identity(frame_dst, atlas.bone_count);
+  }
+  std::size_t const bytes = staging.size() * sizeof(float);
+  fn->glBindBuffer(GL_UNIFORM_BUFFER, atlas.palette_ubo);
+  fn->glBufferSubData(
+      GL_UNIFORM_BUFFER,
+      static_cast<GLintptr>(static_cast<std::size_t>(clip.frame_offset) *
+                            atlas.frame_stride_bytes),
+      static_cast<GLsizeiptr>(bytes),
+      staging.data());
+  fn->glBindBuffer(GL_UNIFORM_BUFFER, 0);
+  atlas.uploaded_clips[clip_index] = true;
+  return bytes;
+}
+
+auto rigged_entry_skin_frame_resident(const RiggedMeshEntry& entry,
+                                      std::uint32_t global_frame) -> bool {
+  if (entry.skin_atlas == nullptr) {
+    return false;
+  }
+  auto const& atlas = *entry.skin_atlas;
+  if (atlas.palette_ubo == 0U || !atlas.ready() || global_frame >= atlas.frame_total) {
+    return false;
+  }
+  std::uint32_t const clip_index = atlas.blob->clip_of_frame(global_frame);
+  return clip_index < atlas.uploaded_clips.size() && atlas.uploaded_clips[clip_index];
 }
 
 auto RiggedMeshCache::get_or_bake(
@@ -248,8 +329,7 @@ void RiggedMeshCache::upload_pending_skin_ubos() {
   m_has_pending_skin_ubo_uploads = false;
   for (auto& [_, entry] : m_entries) {
     if (entry.skin_atlas == nullptr || entry.skin_atlas->palette_ubo != 0U ||
-        entry.skin_atlas->palettes.empty() || entry.skin_atlas->frame_total == 0U ||
-        entry.skin_atlas->bone_count == 0U) {
+        !entry.skin_atlas->ready()) {
       continue;
     }
 
@@ -270,7 +350,7 @@ void rigged_entry_ensure_skin_atlas_from_blob(
   }
   auto& atlas = *entry.skin_atlas;
   auto storage = blob.palette_storage();
-  if (storage == nullptr || storage->empty() || atlas.palette_storage == storage) {
+  if (storage == nullptr || atlas.palette_storage == storage) {
     return;
   }
   if (atlas.palette_ubo != 0U) {
@@ -282,7 +362,8 @@ void rigged_entry_ensure_skin_atlas_from_blob(
     atlas.frame_stride_bytes = 0;
   }
   atlas.palette_storage = std::move(storage);
-  atlas.palettes = blob.palette_matrices();
+  atlas.blob = &blob;
+  atlas.uploaded_clips.clear();
   atlas.frame_total = blob.frame_total();
   atlas.bone_count = blob.bone_count();
 }
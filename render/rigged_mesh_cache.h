@@ -19,15 +19,28 @@ namespace Render::Creature {
 struct CreatureSpec;
 }
 
+namespace Render::Creature::Bpat {
+class BpatBlob;
+}
+
 namespace Render::GL {
 
+// Frame palettes come from the blob's clip cache, so a quantized blob is only
+// decoded one clip at a time as its frames are sampled.
 struct RiggedSkinAtlas {
-  std::shared_ptr<const std::vector<QMatrix4x4>> palette_storage;
-  std::span<const QMatrix4x4> palettes;
+  const Render::Creature::Bpat::BpatBlob* blob{nullptr};
+  std::shared_ptr<const void> palette_storage;
   std::uint32_t frame_total{0};
   std::uint32_t bone_count{0};
   GLuint palette_ubo{0};
   std::size_t frame_stride_bytes{0};
+  std::vector<bool> uploaded_clips;
+
+  [[nodiscard]] auto ready() const noexcept -> bool {
+    return blob != nullptr && frame_total != 0U && bone_count != 0U;
+  }
+  [[nodiscard]] auto
+  frame_palette(std::uint32_t global_frame) const -> const QMatrix4x4*;
 };
 
 struct RiggedMeshEntry {
@@ -210,13 +223,13 @@ private:
 
 void rigged_entry_ensure_skin_ubo(const RiggedMeshEntry& entry);
 
-} // namespace Render::GL
+// Uploads the clip holding `global_frame` into the palette UBO if it is not
+// there yet. Returns the bytes uploaded.
+auto rigged_entry_ensure_skin_frame(const RiggedMeshEntry& entry,
+                                    std::uint32_t global_frame) -> std::uint64_t;
 
-namespace Render::Creature::Bpat {
-class BpatBlob;
-}
-
-namespace Render::GL {
+[[nodiscard]] auto rigged_entry_skin_frame_resident(const RiggedMeshEntry& entry,
+                                                    std::uint32_t global_frame) -> bool;
 
 void rigged_entry_ensure_skin_atlas_from_blob(
     const RiggedMeshEntry& entry, const Render::Creature::Bpat::BpatBlob& blob);
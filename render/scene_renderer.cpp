@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cassert>
 #include <chrono>
 #include <cmath>
 #include <cstddef>
@@ -94,6 +95,7 @@ Renderer::Renderer(ShaderQuality quality)
     : m_shader_quality(quality)
     , m_effects_submitter(std::make_unique<EffectsSubmitter>()) {
   m_active_queue = &m_queues[m_fill_queue_index];
+  m_unit_staging.set_keyed(false);
 }
 
 Renderer::~Renderer() {
@@ -194,6 +196,7 @@ void Renderer::begin_frame() {
       &profile, Render::Profiling::Phase::Collection);
 
   advance_pose_cache_frame();
+  Render::Creature::Bpat::BpatRegistry::instance().trim_decoded_clips();
 
   reset_humanoid_render_stats();
   reset_horse_render_stats();
@@ -204,6 +207,7 @@ void Renderer::begin_frame() {
   prune_animation_time_cache(m_battle_optimizer.frame_counter());
 
   m_active_queue = &m_queues[m_fill_queue_index];
+  m_queue_palette_frames[m_fill_queue_index] = humanoid_current_frame();
   m_active_queue->clear();
   m_active_queue->reserve_for_frame();
 
@@ -224,6 +228,15 @@ void Renderer::begin_frame() {
   m_rigged_mesh_cache.upload_pending_skin_ubos();
 }
 
+auto Renderer::render_queue_palettes_live() const -> bool {
+  // Rigged commands point into the palette arena of the frame that filled
+  // the queue, and the arena reuses that generation a few frames later.
+  std::uint32_t const age =
+      humanoid_current_frame() - m_queue_palette_frames[m_render_queue_index];
+  return m_queues[m_render_queue_index].empty() ||
+         age < RiggedCreatureCmd::k_frame_palette_generations;
+}
+
 void Renderer::end_frame() {
   if (m_paused.load()) {
     Render::Profiling::global_profile().end_frame();
@@ -233,6 +246,7 @@ void Renderer::end_frame() {
     auto& profile = Render::Profiling::global_profile();
     std::swap(m_fill_queue_index, m_render_queue_index);
     DrawQueue& render_queue = m_queues[m_render_queue_index];
+    assert(render_queue_palettes_live());
     {
       Render::Profiling::PhaseScope const sort_scope(&profile,
                                                      Render::Profiling::Phase::Sort);
@@ -270,6 +284,7 @@ auto Renderer::render_software_preview(int width, int height) -> QImage {
     return {};
   }
   DrawQueue const& queue = m_queues[m_render_queue_index];
+  assert(render_queue_palettes_live());
   SoftwareBackend backend;
   Render::Software::RasterSettings settings;
   settings.width = width;
@@ -559,7 +574,6 @@ void Renderer::grid(const QMatrix4x4& model,
                     float extent) {
   GridCmd cmd;
   cmd.model = model;
-  cmd.mvp = m_view_proj * model;
   cmd.color = color;
   cmd.cell_size = cell_size;
   cmd.thickness = thickness;
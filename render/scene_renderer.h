@@ -454,6 +454,7 @@ private:
   void prepare_unit_plans(std::vector<UnitRenderEntry>& entries,
                           std::vector<UnitDrawPlan>& plans,
                           Render::Profiling::FrameProfile& frame_profile);
+  void merge_unit_shards(DrawQueue& frame_queue);
   void
   submit_unit_entry(UnitRenderEntry& entry,
                     UnitDrawPlan& plan,
@@ -487,6 +488,7 @@ private:
   void process_async_template_prewarm();
   void cancel_async_template_prewarm();
 
+  [[nodiscard]] auto render_queue_palettes_live() const -> bool;
   void run_template_prewarm_item(const PrewarmProfile& profile,
                                  const PrewarmWorkItem& item);
 
@@ -500,6 +502,7 @@ private:
   DrawQueue* m_active_queue = nullptr;
   int m_fill_queue_index = 0;
   int m_render_queue_index = 1;
+  std::uint32_t m_queue_palette_frames[2]{};
 
   std::unique_ptr<EntityRendererRegistry> m_entity_registry;
   std::unique_ptr<EffectsSubmitter> m_effects_submitter;
@@ -541,6 +544,8 @@ private:
       m_unit_preparations;
   std::vector<std::uint8_t> m_prepare_warmed_handles;
   std::vector<std::size_t> m_parallel_prepare_jobs;
+  DrawQueue m_unit_staging;
+  std::vector<DrawQueue> m_unit_shards;
   ModelMatrixCache m_model_matrix_cache;
   RiggedMeshCache m_rigged_mesh_cache;
   SnapshotMeshCache m_snapshot_mesh_cache;
@@ -989,6 +989,32 @@ void Renderer::prepare_unit_plans(std::vector<UnitRenderEntry>& entries,
                                      .count());
 }
 
+void Renderer::merge_unit_shards(DrawQueue& frame_queue) {
+  constexpr std::size_t k_min_commands_per_shard = 512;
+  std::size_t const staged = m_unit_staging.size();
+  std::size_t const shard_count =
+      std::clamp<std::size_t>(staged / k_min_commands_per_shard,
+                              1U,
+                              m_prepare_pool.worker_count() + 1U);
+  if (m_unit_shards.size() < shard_count) {
+    m_unit_shards.resize(shard_count);
+  }
+
+  // Shards follow job order, so the merged queue ties exactly as if the
+  // staged commands had been submitted to it one by one.
+  m_prepare_pool.run(shard_count, [&](std::size_t shard) {
+    std::size_t const begin = staged * shard / shard_count;
+    std::size_t const end = staged * (shard + 1U) / shard_count;
+    m_unit_shards[shard].submit_staged(m_unit_staging, begin, end);
+  });
+  frame_queue.merge_shards(std::span<DrawQueue>(m_unit_shards.data(), shard_count));
+
+  for (const auto& light : m_unit_staging.local_lights()) {
+    frame_queue.submit_local_light(light);
+  }
+  m_unit_staging.clear();
+}
+
 void Renderer::submit_non_unit_entry(const RenderEntry& entry,
                                      Engine::Core::World* world,
                                      ResourceManager* res) {
@@ -1172,6 +1198,12 @@ void Renderer::render_world(Engine::Core::World* world) {
 
   prepare_unit_plans(unit_entries, unit_plans, frame_profile);
 
+  // Building unit commands touches the mesh caches, so it stays here; the
+  // commands are staged in unit order and keyed into shards afterwards.
+  DrawQueue* const frame_queue = m_active_queue;
+  if (frame_queue != nullptr) {
+    m_active_queue = &m_unit_staging;
+  }
   for (std::size_t i = 0; i < unit_entries.size(); ++i) {
     auto& plan = unit_plans[i];
     submit_unit_entry(unit_entries[i],
@@ -1181,6 +1213,10 @@ void Renderer::render_world(Engine::Core::World* world) {
                           ? &m_unit_preparations[i]
                           : nullptr);
   }
+  if (frame_queue != nullptr) {
+    m_active_queue = frame_queue;
+    merge_unit_shards(*frame_queue);
+  }
 
   m_battle_optimizer.commit_frame_stats(optimizer_stats);
 
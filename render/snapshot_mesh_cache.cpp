@@ -82,9 +82,10 @@ auto SnapshotMeshCache::get_or_bake(const Key& key,
     return nullptr;
   }
 
-  if (source.mesh == nullptr || source.skin_atlas == nullptr ||
-      source.skin_atlas->palettes.empty() || source.skin_atlas->bone_count == 0U ||
-      global_frame >= source.skin_atlas->frame_total ||
+  const QMatrix4x4* frame_palette = (source.skin_atlas != nullptr)
+                                        ? source.skin_atlas->frame_palette(global_frame)
+                                        : nullptr;
+  if (source.mesh == nullptr || frame_palette == nullptr ||
       source.mesh->get_vertices().empty() || source.mesh->get_indices().empty()) {
     ++m_frame_stats.misses;
     return nullptr;
@@ -92,10 +93,6 @@ auto SnapshotMeshCache::get_or_bake(const Key& key,
 
   const auto& src_vertices = source.mesh->get_vertices();
   const auto& src_indices = source.mesh->get_indices();
-  const QMatrix4x4* frame_palette =
-      source.skin_atlas->palettes.data() +
-      static_cast<std::size_t>(global_frame) *
-          static_cast<std::size_t>(source.skin_atlas->bone_count);
   auto baked = bake_snapshot_vertices(
       src_vertices,
       {frame_palette, static_cast<std::size_t>(source.skin_atlas->bone_count)});
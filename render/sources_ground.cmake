@@ -7,6 +7,7 @@ set(RENDER_GROUND_SOURCES
     ${CMAKE_CURRENT_SOURCE_DIR}/ground/fog_renderer.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/ground/map_boundary_fog_renderer.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/ground/ambient_fog_renderer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/ground/terrain_lod.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/ground/terrain_renderer.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/ground/terrain_renderer_mesh.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/ground/terrain_renderer_submission.cpp
@@ -19,6 +20,7 @@ set(RENDER_GROUND_SOURCES
     ${CMAKE_CURRENT_SOURCE_DIR}/ground/bridge_renderer.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/ground/terrain_feature_manager.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/ground/biome_renderer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/ground/scatter_generation.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/ground/stone_renderer.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/ground/plant_renderer.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/ground/pine_renderer.cpp
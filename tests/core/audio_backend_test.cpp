@@ -101,6 +101,20 @@ protected:
     return buffer;
   }
 
+  // Renders in device-sized blocks and refills the streams before each one, as
+  // the stream thread would, so the output does not depend on its timing.
+  auto render_pumped(unsigned frames) -> std::vector<float> {
+    constexpr unsigned BLOCK = 256;
+    std::vector<float> buffer;
+    buffer.reserve(static_cast<std::size_t>(frames) * CHANNELS);
+    for (unsigned done = 0; done < frames; done += BLOCK) {
+      m_backend.pump_streams();
+      const std::vector<float> block = render(BLOCK);
+      buffer.insert(buffer.end(), block.begin(), block.end());
+    }
+    return buffer;
+  }
+
   QTemporaryDir m_directory;
   QString m_path;
   MiniaudioBackend m_backend;
@@ -263,4 +277,69 @@ TEST_F(AudioBackendTest, ALoopingBedWrapsWithoutAClick) {
       << "largest step " << worst << " against a median of " << median;
 }
 
+TEST_F(AudioBackendTest, LongBedsStreamAndLoopWithoutAClick) {
+  const int bed_frames = SAMPLE_RATE * 2;
+  const QString bed_path = m_directory.filePath("long_bed.wav");
+  ASSERT_TRUE(write_unclosed_bed_wav(bed_path, bed_frames, 0.6F));
+  m_backend.set_stream_threshold_frames(SAMPLE_RATE);
+  ASSERT_TRUE(m_backend.request_track(
+      QStringLiteral("bed"), bed_path, Mastering::Material::Ambience));
+  ASSERT_TRUE(m_backend.request_track(
+      QStringLiteral("tone"), m_path, Mastering::Material::Music));
+  m_backend.wait_for_decodes();
+  EXPECT_TRUE(m_backend.is_track_streamed(QStringLiteral("bed")));
+  EXPECT_FALSE(m_backend.is_track_streamed(QStringLiteral("tone")));
+
+  m_backend.play_sound(QStringLiteral("bed"), 1.0F, true);
+  const std::vector<float> buffer =
+      render_pumped(static_cast<unsigned>(bed_frames) * 2U);
+  const std::size_t rendered = buffer.size() / CHANNELS;
+
+  // The mixer claims the stream in the first block and the next pump opens it;
+  // half the render still spans a loop.
+  std::size_t first = 0;
+  while (first < rendered && std::abs(buffer[first * CHANNELS]) < 1e-6F) {
+    ++first;
+  }
+  ASSERT_LT(first, rendered / 2) << "the stream never started";
+
+  constexpr std::size_t ATTACK_FRAMES = 256;
+  std::vector<float> steps;
+  for (std::size_t frame = first + ATTACK_FRAMES; frame < rendered; ++frame) {
+    steps.push_back(
+        std::abs(buffer[frame * CHANNELS] - buffer[(frame - 1) * CHANNELS]));
+  }
+  std::sort(steps.begin(), steps.end());
+  const float median = steps[steps.size() / 2];
+  const float worst = steps.back();
+  EXPECT_GT(median, 1e-4F) << "the stream went quiet";
+  EXPECT_LT(worst, std::max(median * 12.0F, 0.02F))
+      << "largest step " << worst << " against a median of " << median;
+}
+
+TEST_F(AudioBackendTest, CrossfadingChannelsEachStreamTheirOwnBed) {
+  const QString bed_path = m_directory.filePath("long_bed.wav");
+  ASSERT_TRUE(write_unclosed_bed_wav(bed_path, SAMPLE_RATE * 2, 0.6F));
+  m_backend.set_stream_threshold_frames(SAMPLE_RATE);
+  ASSERT_TRUE(m_backend.request_track(
+      QStringLiteral("bed"), bed_path, Mastering::Material::Music));
+  m_backend.wait_for_decodes();
+  ASSERT_TRUE(m_backend.is_track_streamed(QStringLiteral("bed")));
+
+  m_backend.play(0, QStringLiteral("bed"), 1.0F, true, 0);
+  render_pumped(SAMPLE_RATE / 4);
+  m_backend.stop(0, 200);
+  m_backend.play(1, QStringLiteral("bed"), 1.0F, true, 200);
+  render_pumped(SAMPLE_RATE / 2);
+
+  EXPECT_FALSE(m_backend.channel_playing(0));
+  EXPECT_TRUE(m_backend.channel_playing(1));
+  EXPECT_GT(peak_of(render_pumped(1024)), 0.01F);
+
+  m_backend.unload(QStringLiteral("bed"));
+  render(256);
+  EXPECT_LT(peak_of(render(256)), 1e-6F);
+  EXPECT_FALSE(m_backend.any_channel_playing());
+}
+
 } // namespace
@@ -0,0 +1,68 @@
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "game/audio/stream_ring.h"
+
+namespace {
+
+using Game::Audio::FrameRing;
+
+auto frames_from(float first, std::size_t count) -> std::vector<float> {
+  std::vector<float> frames;
+  for (std::size_t i = 0; i < count; ++i) {
+    frames.push_back(first + static_cast<float>(i));
+    frames.push_back(-(first + static_cast<float>(i)));
+  }
+  return frames;
+}
+
+TEST(AudioFrameRing, AcceptsOnlyWhatFits) {
+  FrameRing ring;
+  ring.allocate(8, 2);
+  EXPECT_EQ(ring.writable(), 8U);
+
+  EXPECT_EQ(ring.write(frames_from(0.0F, 6).data(), 6), 6U);
+  EXPECT_EQ(ring.write(frames_from(6.0F, 6).data(), 6), 2U);
+  EXPECT_EQ(ring.readable(), 8U);
+  EXPECT_EQ(ring.writable(), 0U);
+}
+
+TEST(AudioFrameRing, ReadsBackInOrderAcrossTheWrap) {
+  FrameRing ring;
+  ring.allocate(8, 2);
+  ASSERT_EQ(ring.write(frames_from(0.0F, 6).data(), 6), 6U);
+  std::size_t count = 0;
+  ring.peek(5, count);
+  ASSERT_EQ(count, 5U);
+  ring.consume(count);
+  ASSERT_EQ(ring.write(frames_from(6.0F, 6).data(), 6), 6U);
+
+  std::vector<float> seen;
+  while (ring.readable() > 0) {
+    const float* frames = ring.peek(16, count);
+    ASSERT_GT(count, 0U);
+    seen.insert(seen.end(), frames, frames + (count * 2));
+    ring.consume(count);
+  }
+  EXPECT_EQ(seen, frames_from(5.0F, 7));
+}
+
+TEST(AudioFrameRing, PeekStopsAtTheEndOfTheStorage) {
+  FrameRing ring;
+  ring.allocate(8, 2);
+  ASSERT_EQ(ring.write(frames_from(0.0F, 6).data(), 6), 6U);
+  ring.consume(6);
+  ASSERT_EQ(ring.write(frames_from(6.0F, 5).data(), 5), 5U);
+
+  std::size_t count = 0;
+  const float* frames = ring.peek(16, count);
+  EXPECT_EQ(count, 2U);
+  EXPECT_FLOAT_EQ(frames[0], 6.0F);
+
+  ring.reset();
+  EXPECT_EQ(ring.readable(), 0U);
+  EXPECT_EQ(ring.writable(), 8U);
+}
+
+} // namespace
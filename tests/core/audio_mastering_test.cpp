@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <gtest/gtest.h>
@@ -132,6 +133,35 @@ TEST(AudioMastering, LoudnessCorrectionStaysWithinItsAuthority) {
   EXPECT_LT(report.output_lufs, profile.target_lufs);
 }
 
+TEST(AudioMastering, StreamedMusicIsLevelledWithoutLimiting) {
+  const Mastering::Profile profile = Mastering::profile_for(Mastering::Material::Music);
+
+  auto quiet = make_stereo(SAMPLE_RATE * 5);
+  add_noise(quiet, 0.16F, 99);
+  Mastering::StreamMeter quiet_meter(SAMPLE_RATE);
+  constexpr std::size_t BLOCK = 4096;
+  for (std::size_t frame = 0; frame < quiet.size() / CHANNELS; frame += BLOCK) {
+    const std::size_t count = std::min(BLOCK, (quiet.size() / CHANNELS) - frame);
+    quiet_meter.push(quiet.data() + (frame * CHANNELS), count, CHANNELS);
+  }
+  const Mastering::Analysis whole =
+      Mastering::analyse(quiet.data(), quiet.size() / CHANNELS, CHANNELS, SAMPLE_RATE);
+  EXPECT_NEAR(quiet_meter.loudness_lufs(), whole.loudness_lufs, 0.01F);
+  EXPECT_FLOAT_EQ(quiet_meter.peak(), whole.peak);
+  EXPECT_NEAR(Mastering::stream_level(profile, quiet_meter).output_lufs,
+              profile.target_lufs,
+              1.0F);
+
+  auto peaky = make_stereo(SAMPLE_RATE * 3);
+  add_noise(peaky, 0.02F, 5);
+  peaky[SAMPLE_RATE] = 0.95F;
+  Mastering::StreamMeter peaky_meter(SAMPLE_RATE);
+  peaky_meter.push(peaky.data(), peaky.size() / CHANNELS, CHANNELS);
+  const Mastering::Report report = Mastering::stream_level(profile, peaky_meter);
+  EXPECT_LE(report.output_peak_db, profile.ceiling_db + 1e-4F);
+  EXPECT_LT(report.loudness_gain_db, profile.loudness_authority_db);
+}
+
 TEST(AudioMastering, VoiceAuthorityReachesTheQuietestShippedLines) {
   const Mastering::Profile profile = Mastering::profile_for(Mastering::Material::Voice);
 
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <vector>
 
@@ -9,7 +10,9 @@
 namespace {
 
 using Engine::Core::AttackComponent;
+using Engine::Core::ComponentGroup;
 using Engine::Core::EntityID;
+using Engine::Core::group_get;
 using Engine::Core::MovementComponent;
 using Engine::Core::Registry;
 using Engine::Core::TransformComponent;
@@ -151,4 +154,88 @@ TEST(WorldViewTest, MissingStorageYieldsAnEmptyView) {
   EXPECT_EQ(view.candidate_count(), 0U);
 }
 
+void expect_group_prefix(const Registry& registry, const ComponentGroup& group) {
+  const auto transforms = registry.entities_with<TransformComponent>();
+  const auto units = registry.entities_with<UnitComponent>();
+  std::vector<EntityID> brute;
+  for (const EntityID id : transforms) {
+    if (registry.has<UnitComponent>(id)) {
+      brute.push_back(id);
+    }
+  }
+
+  ASSERT_EQ(group.size(), brute.size());
+  std::vector<EntityID> prefix;
+  for (std::size_t i = 0; i < group.size(); ++i) {
+    EXPECT_EQ(transforms[i], units[i]) << "position " << i;
+    prefix.push_back(transforms[i]);
+  }
+  std::sort(prefix.begin(), prefix.end());
+  std::sort(brute.begin(), brute.end());
+  EXPECT_EQ(prefix, brute);
+}
+
+TEST(ComponentGroupTest, OwnedStoragesKeepMatchingEntitiesInASharedPrefix) {
+  Registry registry;
+  const ComponentGroup* group = registry.group<TransformComponent, UnitComponent>();
+  ASSERT_NE(group, nullptr);
+
+  std::vector<EntityID> ids;
+  for (int i = 0; i < 48; ++i) {
+    const EntityID id = registry.create_entity();
+    ids.push_back(id);
+    if (i % 3 != 0) {
+      registry.emplace<TransformComponent>(id);
+    }
+    if (i % 2 == 0) {
+      registry.emplace<UnitComponent>(id);
+    }
+  }
+  expect_group_prefix(registry, *group);
+
+  for (std::size_t i = 0; i < ids.size(); i += 5) {
+    registry.remove<UnitComponent>(ids[i]);
+  }
+  for (std::size_t i = 1; i < ids.size(); i += 7) {
+    registry.emplace<UnitComponent>(ids[i]);
+    registry.emplace<TransformComponent>(ids[i]);
+  }
+  for (std::size_t i = 2; i < ids.size(); i += 11) {
+    registry.destroy_entity(ids[i]);
+  }
+  expect_group_prefix(registry, *group);
+
+  registry.clear();
+  EXPECT_EQ(group->size(), 0U);
+}
+
+TEST(ComponentGroupTest, ObservedComponentsGateMembershipWithoutBeingReordered) {
+  Registry registry;
+  const ComponentGroup* group =
+      registry.group<MovementComponent>(group_get<TransformComponent, UnitComponent>);
+  ASSERT_NE(group, nullptr);
+
+  const EntityID id = registry.create_entity();
+  registry.emplace<MovementComponent>(id);
+  registry.emplace<TransformComponent>(id);
+  EXPECT_EQ(group->size(), 0U);
+
+  registry.emplace<UnitComponent>(id);
+  EXPECT_EQ(group->size(), 1U);
+
+  registry.remove<TransformComponent>(id);
+  EXPECT_EQ(group->size(), 0U);
+}
+
+TEST(ComponentGroupTest, AStorageBelongsToAtMostOneOwningGroup) {
+  Registry registry;
+  const ComponentGroup* first = registry.group<TransformComponent, UnitComponent>();
+  ASSERT_NE(first, nullptr);
+
+  const ComponentGroup* again = registry.group<TransformComponent, UnitComponent>();
+  EXPECT_EQ(again, first);
+  EXPECT_EQ(registry.group<UnitComponent>(group_get<AttackComponent>), nullptr);
+  EXPECT_NE(registry.group<AttackComponent>(group_get<UnitComponent>), nullptr);
+}
+
 } // namespace
@@ -321,6 +321,145 @@ TEST(WorldPresentationTest, RenderSnapshotCarriesWildlifeActionState) {
   EXPECT_TRUE(copied->bite_impact_pending);
 }
 
+auto spawn_standing_unit(World& world, float x) -> Entity* {
+  auto* entity = world.create_entity();
+  entity->add_component<TransformComponent>(x, 0.0F, 0.0F);
+  entity->add_component<UnitComponent>();
+  entity->add_component<Engine::Core::RenderableComponent>();
+  return entity;
+}
+
+auto settle_render_snapshots(World& world) -> void {
+  world.system_profiler().set_enabled(true);
+  world.request_render_snapshots();
+  for (int i = 0; i < 4; ++i) {
+    world.update(1.0F / 60.0F);
+  }
+}
+
+TEST(WorldPresentationTest, AStandingArmyIsNotRevisitedOncePublished) {
+  World world;
+  for (int i = 0; i < 64; ++i) {
+    spawn_standing_unit(world, static_cast<float>(i));
+  }
+  settle_render_snapshots(world);
+
+  world.update(1.0F / 60.0F);
+
+  auto const& publication = world.system_profiler().render_publication();
+  EXPECT_FALSE(publication.full_sweep);
+  EXPECT_EQ(publication.visited, 0U);
+  EXPECT_EQ(publication.copied, 0U);
+  EXPECT_EQ(world.acquire_render_snapshot()->render_unit_ids().size(), 64U);
+}
+
+TEST(WorldPresentationTest, OnlyTheWrittenEntityIsRepublished) {
+  World world;
+  std::vector<Entity*> army;
+  for (int i = 0; i < 32; ++i) {
+    army.push_back(spawn_standing_unit(world, static_cast<float>(i)));
+  }
+  settle_render_snapshots(world);
+
+  EntityID const id = army[5]->get_id();
+  army[5]->get_component<TransformComponent>()->position.z = 3.0F;
+
+  world.update(1.0F / 60.0F);
+  auto const& publication = world.system_profiler().render_publication();
+  EXPECT_EQ(publication.visited, 1U);
+  EXPECT_EQ(publication.copied, 1U);
+  EXPECT_FLOAT_EQ(world.acquire_render_snapshot()
+                      ->get_entity(id)
+                      ->get_component<TransformComponent>()
+                      ->position.z,
+                  3.0F);
+
+  world.update(1.0F / 60.0F);
+  EXPECT_EQ(world.system_profiler().render_publication().visited, 1U)
+      << "the other buffer has not seen the write yet";
+  EXPECT_FLOAT_EQ(world.acquire_render_snapshot()
+                      ->get_entity(id)
+                      ->get_component<TransformComponent>()
+                      ->position.z,
+                  3.0F);
+
+  world.update(1.0F / 60.0F);
+  EXPECT_EQ(world.system_profiler().render_publication().visited, 0U);
+}
+
+TEST(WorldPresentationTest, PublicationVisitsOnlyWrittenAndUnstableSlots) {
+  World world;
+  std::vector<Entity*> army;
+  for (int i = 0; i < 48; ++i) {
+    army.push_back(spawn_standing_unit(world, static_cast<float>(i)));
+  }
+  army[40]->add_component<Engine::Core::MovementComponent>()->set_manual_velocity(
+      1.0F, 0.0F);
+  settle_render_snapshots(world);
+
+  for (int write = 0; write < 5; ++write) {
+    army[3]->get_component<TransformComponent>()->position.y =
+        static_cast<float>(write);
+  }
+  world.update(1.0F / 60.0F);
+
+  auto const& publication = world.system_profiler().render_publication();
+  EXPECT_FALSE(publication.full_sweep);
+  EXPECT_EQ(publication.slot_count, 49U);
+  EXPECT_EQ(publication.visited, 2U)
+      << "the rewritten unit once, and the moving unit that is always refreshed";
+}
+
+TEST(WorldPresentationTest, ReadOnlyViewsDoNotCountAsWrites) {
+  World world;
+  for (int i = 0; i < 16; ++i) {
+    spawn_standing_unit(world, static_cast<float>(i));
+  }
+  settle_render_snapshots(world);
+
+  float sum = 0.0F;
+  for (auto [id, transform] : world.view<const TransformComponent>()) {
+    sum += transform.position.x;
+  }
+  EXPECT_GT(sum, 0.0F);
+
+  world.update(1.0F / 60.0F);
+  EXPECT_EQ(world.system_profiler().render_publication().visited, 0U);
+
+  for (auto [id, transform] : world.view<TransformComponent>()) {
+    transform.position.y = 1.0F;
+  }
+  world.update(1.0F / 60.0F);
+  EXPECT_EQ(world.system_profiler().render_publication().visited, 16U);
+}
+
+TEST(WorldPresentationTest, DestroyedAndHiddenEntitiesLeaveTheRenderLists) {
+  World world;
+  std::vector<Entity*> army;
+  for (int i = 0; i < 8; ++i) {
+    army.push_back(spawn_standing_unit(world, static_cast<float>(i)));
+  }
+  settle_render_snapshots(world);
+
+  EntityID const destroyed = army[2]->get_id();
+  EntityID const hidden = army[6]->get_id();
+  world.destroy_entity(destroyed);
+  army[6]->remove_component<Engine::Core::RenderableComponent>();
+
+  world.update(1.0F / 60.0F);
+  world.update(1.0F / 60.0F);
+
+  for (int frame = 0; frame < 2; ++frame) {
+    auto const snapshot = world.acquire_render_snapshot();
+    auto const ids = snapshot->render_unit_ids();
+    EXPECT_EQ(ids.size(), 6U);
+    EXPECT_EQ(std::find(ids.begin(), ids.end(), destroyed), ids.end());
+    EXPECT_EQ(std::find(ids.begin(), ids.end(), hidden), ids.end());
+    EXPECT_EQ(snapshot->get_entity(destroyed), nullptr);
+    world.update(1.0F / 60.0F);
+  }
+}
+
 TEST(ComponentIndexTest, DestroyingAnEntityDropsItFromEveryIndex) {
   World world;
 
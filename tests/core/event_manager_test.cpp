@@ -0,0 +1,216 @@
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+#include "game/core/component.h"
+#include "game/core/event_manager.h"
+#include "game/core/event_queue.h"
+#include "game/core/system.h"
+#include "game/core/world.h"
+
+namespace {
+
+using Engine::Core::Event;
+using Engine::Core::EventManager;
+using Engine::Core::EventQueue;
+using Engine::Core::Reads;
+using Engine::Core::ScopedEventSubscription;
+using Engine::Core::SystemAccess;
+using Engine::Core::SystemPhase;
+using Engine::Core::UnitComponent;
+using Engine::Core::World;
+
+class PingEvent : public Event {
+public:
+  explicit PingEvent(int value)
+      : value(value) {}
+  int value;
+};
+
+class NoteEvent : public Event {
+public:
+  explicit NoteEvent(std::string text)
+      : text(std::move(text)) {}
+  std::string text;
+};
+
+TEST(EventManagerTest, PublishesToEverySubscriberUntilUnsubscribed) {
+  std::vector<int> first;
+  std::vector<int> second;
+  auto& events = EventManager::instance();
+  auto const first_handle = events.subscribe<PingEvent>(
+      [&first](const PingEvent& event) { first.push_back(event.value); });
+  {
+    ScopedEventSubscription<PingEvent> const scoped(
+        [&second](const PingEvent& event) { second.push_back(event.value); });
+    EXPECT_EQ(events.get_subscriber_count(std::type_index(typeid(PingEvent))), 2U);
+    events.publish(PingEvent(1));
+  }
+  events.publish(PingEvent(2));
+  events.unsubscribe<PingEvent>(first_handle);
+  events.publish(PingEvent(3));
+
+  EXPECT_EQ(first, (std::vector<int>{1, 2}));
+  EXPECT_EQ(second, (std::vector<int>{1}));
+  EXPECT_EQ(events.get_subscriber_count(std::type_index(typeid(PingEvent))), 0U);
+}
+
+TEST(EventManagerTest, HandlerMayUnsubscribeItselfDuringPublish) {
+  auto& events = EventManager::instance();
+  int calls = 0;
+  int later_calls = 0;
+  Engine::Core::SubscriptionHandle self = 0;
+  self = events.subscribe<PingEvent>([&](const PingEvent&) {
+    ++calls;
+    events.unsubscribe<PingEvent>(self);
+  });
+  ScopedEventSubscription<PingEvent> const later(
+      [&later_calls](const PingEvent&) { ++later_calls; });
+
+  events.publish(PingEvent(0));
+  events.publish(PingEvent(0));
+
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(later_calls, 2);
+}
+
+TEST(EventManagerTest, ReplacedHandlerListsSurvivePublishUntilThePhaseBarrier) {
+  auto& events = EventManager::instance();
+  auto const type = std::type_index(typeid(NoteEvent));
+  std::vector<std::string> seen;
+  std::vector<ScopedEventSubscription<NoteEvent>> added;
+  ScopedEventSubscription<NoteEvent> const first([&](const NoteEvent& event) {
+    seen.push_back("first " + event.text);
+    if (added.size() < 4U) {
+      added.emplace_back([&seen](const NoteEvent& note) {
+        seen.push_back("added " + note.text);
+      });
+    }
+  });
+  ScopedEventSubscription<NoteEvent> const second(
+      [&seen](const NoteEvent& event) { seen.push_back("second " + event.text); });
+
+  events.publish(NoteEvent("a"));
+  EXPECT_EQ(seen, (std::vector<std::string>{"first a", "second a"}));
+  EXPECT_GT(events.get_stats(type).retired_handler_lists, 0U);
+
+  World world;
+  world.update(0.1F);
+  EXPECT_EQ(events.get_stats(type).retired_handler_lists, 0U);
+
+  seen.clear();
+  events.publish(NoteEvent("b"));
+  EXPECT_EQ(seen,
+            (std::vector<std::string>{"first b", "second b", "added b"}));
+  added.clear();
+}
+
+TEST(EventQueueTest, DeliversQueuedEventsInPushOrderAcrossTypes) {
+  std::vector<std::string> seen;
+  ScopedEventSubscription<PingEvent> const ping([&seen](const PingEvent& event) {
+    seen.push_back("ping" + std::to_string(event.value));
+  });
+  ScopedEventSubscription<NoteEvent> const note(
+      [&seen](const NoteEvent& event) { seen.push_back(event.text); });
+
+  EventQueue queue;
+  for (int round = 0; round < 2; ++round) {
+    seen.clear();
+    queue.push(PingEvent(1));
+    queue.push(NoteEvent("a"));
+    queue.push(PingEvent(2));
+    EXPECT_EQ(queue.pending(), 3U);
+    EXPECT_TRUE(seen.empty());
+
+    queue.deliver();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(seen, (std::vector<std::string>{"ping1", "a", "ping2"}));
+  }
+}
+
+TEST(EventQueueTest, EventsQueuedWhileDeliveringArriveInTheSamePass) {
+  EventQueue queue;
+  std::vector<int> seen;
+  ScopedEventSubscription<PingEvent> const ping([&](const PingEvent& event) {
+    seen.push_back(event.value);
+    if (event.value < 3) {
+      queue.push(PingEvent(event.value + 1));
+    }
+  });
+
+  queue.push(PingEvent(1));
+  queue.deliver();
+
+  EXPECT_EQ(seen, (std::vector<int>{1, 2, 3}));
+  EXPECT_TRUE(queue.empty());
+}
+
+class PingSystem : public Engine::Core::System {
+public:
+  PingSystem(SystemPhase phase, int value, std::vector<int>* seen_at_start)
+      : m_phase(phase)
+      , m_value(value)
+      , m_seen_at_start(seen_at_start) {}
+
+  void update(World* world, float) override {
+    if (m_seen_at_start != nullptr) {
+      m_seen_at_start->push_back(static_cast<int>(m_delivered_before));
+    }
+    world->events().push(PingEvent(m_value));
+  }
+  [[nodiscard]] auto phase() const -> SystemPhase override { return m_phase; }
+  [[nodiscard]] auto access() const -> SystemAccess override {
+    return SystemAccess::declare(Reads<UnitComponent>{});
+  }
+
+  std::size_t m_delivered_before{0};
+
+private:
+  SystemPhase m_phase;
+  int m_value;
+  std::vector<int>* m_seen_at_start;
+};
+
+TEST(EventQueueTest, WorldDeliversQueuedEventsAtEachPhaseBarrier) {
+  World world;
+  std::vector<int> delivered;
+  std::vector<int> seen_at_start;
+  auto movement = std::make_unique<PingSystem>(SystemPhase::Movement, 1, nullptr);
+  auto combat =
+      std::make_unique<PingSystem>(SystemPhase::Combat, 2, &seen_at_start);
+  PingSystem* const combat_system = combat.get();
+  ScopedEventSubscription<PingEvent> const ping([&](const PingEvent& event) {
+    delivered.push_back(event.value);
+    combat_system->m_delivered_before = delivered.size();
+  });
+  world.add_system(std::move(movement));
+  world.add_system(std::move(combat));
+
+  world.update(0.1F);
+
+  EXPECT_EQ(seen_at_start, (std::vector<int>{1}));
+  EXPECT_EQ(delivered, (std::vector<int>{1, 2}));
+}
+
+TEST(EventQueueTest, ParallelBatchEventsArriveInRegistrationOrder) {
+  World world;
+  world.set_worker_count(2);
+  std::vector<int> delivered;
+  ScopedEventSubscription<PingEvent> const ping(
+      [&delivered](const PingEvent& event) { delivered.push_back(event.value); });
+  for (int value = 1; value <= 4; ++value) {
+    world.add_system(std::make_unique<PingSystem>(SystemPhase::Combat, value, nullptr));
+  }
+
+  for (int tick = 0; tick < 8; ++tick) {
+    delivered.clear();
+    world.update(0.1F);
+    EXPECT_EQ(delivered, (std::vector<int>{1, 2, 3, 4})) << "tick " << tick;
+  }
+}
+
+} // namespace
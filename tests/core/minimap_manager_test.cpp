@@ -643,6 +643,42 @@ TEST(VisibilityServiceSnapshotTest, CommanderRallyFlagAddsVisionSource) {
   EXPECT_TRUE(visibility.is_visible_world(20.0F, 20.0F));
 }
 
+TEST(VisibilityServiceSnapshotTest, MovingASourcePublishesOnlyTheChangedRectangle) {
+  auto& visibility = VisibilityService::instance();
+  visibility.initialize(64, 64, 1.0F);
+
+  auto world = std::make_unique<Engine::Core::World>();
+  auto* scout = add_unit(*world, 0.0F, 0.0F, 1);
+  (void)add_unit(*world, -20.0F, 20.0F, 1);
+
+  visibility.compute_immediate(*world, 1);
+  const auto before = visibility.snapshot_ptr();
+  ASSERT_NE(before, nullptr);
+
+  auto* scout_transform = scout->get_component<Engine::Core::TransformComponent>();
+  ASSERT_NE(scout_transform, nullptr);
+  scout_transform->position.x = 3.0F;
+  visibility.compute_immediate(*world, 1);
+  const auto after = visibility.snapshot_ptr();
+  ASSERT_NE(after, nullptr);
+
+  EXPECT_EQ(after->dirty_since_version, before->version);
+  ASSERT_FALSE(after->dirty.empty());
+  EXPECT_LT(after->dirty.max_x - after->dirty.min_x, 32);
+  EXPECT_LT(after->dirty.max_z - after->dirty.min_z, 32);
+  for (int z = 0; z < 64; ++z) {
+    for (int x = 0; x < 64; ++x) {
+      const bool inside = x >= after->dirty.min_x && x <= after->dirty.max_x &&
+                          z >= after->dirty.min_z && z <= after->dirty.max_z;
+      if (!inside) {
+        ASSERT_EQ(after->state_at(x, z), before->state_at(x, z)) << x << "," << z;
+      }
+    }
+  }
+  EXPECT_EQ(visibility.snapshot_for(1), after);
+  EXPECT_EQ(visibility.snapshot_for(99), nullptr);
+}
+
 TEST(VisibilityCoordinatorTest, ForceRepublishSyncsFogAfterMinimapGeneration) {
   auto world = std::make_unique<Engine::Core::World>();
   auto* scout = add_unit(*world, 0.0F, 0.0F, 1);
@@ -11,6 +11,7 @@
 namespace {
 
 using Game::Audio::resample_to;
+using Game::Audio::StreamResampler;
 
 constexpr unsigned CHANNELS = 2;
 
@@ -202,4 +203,71 @@ TEST(ResamplerTest, EmptyOrDegenerateInputIsRefusedRatherThanCrashing) {
   EXPECT_FALSE(resample_to(pcm, CHANNELS, 16000, 0).applied);
 }
 
+// Feeds `source` from input frame `from` in uneven blocks and drains uneven
+// pulls, the way a stream decoder does.
+auto stream_through(StreamResampler& resampler,
+                    const std::vector<float>& source,
+                    std::size_t from) -> std::vector<float> {
+  constexpr std::size_t PUSH_FRAMES = 1000;
+  constexpr std::size_t PULL_FRAMES = 777;
+  const std::size_t frames_in = source.size() / CHANNELS;
+  std::vector<float> out;
+  std::vector<float> block(PULL_FRAMES * CHANNELS);
+  for (std::size_t frame = from;;) {
+    const std::size_t pulled = resampler.pull(block.data(), PULL_FRAMES);
+    out.insert(out.end(), block.begin(), block.begin() + pulled * CHANNELS);
+    if (pulled > 0) {
+      continue;
+    }
+    if (frame >= frames_in) {
+      resampler.finish();
+      for (;;) {
+        const std::size_t tail = resampler.pull(block.data(), PULL_FRAMES);
+        if (tail == 0) {
+          return out;
+        }
+        out.insert(out.end(), block.begin(), block.begin() + tail * CHANNELS);
+      }
+    }
+    const std::size_t count = std::min(PUSH_FRAMES, frames_in - frame);
+    resampler.push(source.data() + frame * CHANNELS, count);
+    frame += count;
+  }
+}
+
+TEST(ResamplerTest, StreamingProducesTheSameFramesAsTheWholeBuffer) {
+  for (const unsigned rate_in : {16000U, 32000U, 44100U, 48000U}) {
+    const std::vector<float> source = make_band_limited_noise(rate_in, 0.4);
+    std::vector<float> whole = source;
+    resample_to(whole, CHANNELS, rate_in, 48000);
+
+    StreamResampler resampler(CHANNELS, rate_in, 48000);
+    EXPECT_EQ(resampler.output_length(source.size() / CHANNELS),
+              whole.size() / CHANNELS);
+    const std::vector<float> streamed = stream_through(resampler, source, 0);
+
+    ASSERT_EQ(streamed.size(), whole.size()) << rate_in;
+    for (std::size_t i = 0; i < whole.size(); ++i) {
+      ASSERT_FLOAT_EQ(streamed[i], whole[i]) << rate_in << " sample " << i;
+    }
+  }
+}
+
+TEST(ResamplerTest, SeekingResumesOnTheSameFrames) {
+  const std::vector<float> source = make_band_limited_noise(16000, 0.4);
+  std::vector<float> whole = source;
+  resample_to(whole, CHANNELS, 16000, 48000);
+
+  constexpr std::size_t SEEK_FRAME = 12345;
+  StreamResampler resampler(CHANNELS, 16000, 48000);
+  const std::size_t from = resampler.seek(SEEK_FRAME);
+  EXPECT_LE(from, SEEK_FRAME / 3);
+  const std::vector<float> streamed = stream_through(resampler, source, from);
+
+  ASSERT_EQ(streamed.size(), whole.size() - SEEK_FRAME * CHANNELS);
+  for (std::size_t i = 0; i < streamed.size(); ++i) {
+    ASSERT_FLOAT_EQ(streamed[i], whole[SEEK_FRAME * CHANNELS + i]) << i;
+  }
+}
+
 } // namespace
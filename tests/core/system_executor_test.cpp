@@ -0,0 +1,244 @@
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "game/core/component.h"
+#include "game/core/entity.h"
+#include "game/core/system.h"
+#include "game/core/system_executor.h"
+#include "game/core/system_schedule.h"
+#include "game/core/world.h"
+
+namespace {
+
+using Engine::Core::AttackComponent;
+using Engine::Core::EntityID;
+using Engine::Core::plan_phase_batches;
+using Engine::Core::Reads;
+using Engine::Core::StaminaComponent;
+using Engine::Core::SystemAccess;
+using Engine::Core::SystemExecutor;
+using Engine::Core::SystemPhase;
+using Engine::Core::TransformComponent;
+using Engine::Core::UnitComponent;
+using Engine::Core::World;
+using Engine::Core::Writes;
+
+TEST(SystemExecutorTest, RunsEveryJobExactlyOnce) {
+  SystemExecutor executor(3);
+  ASSERT_EQ(executor.worker_count(), 3U);
+
+  for (std::size_t round = 0; round < 64; ++round) {
+    const std::size_t job_count = 1 + (round % 17);
+    std::vector<std::atomic<int>> hits(job_count);
+    executor.run(job_count, [&hits](std::size_t job) {
+      hits[job].fetch_add(1, std::memory_order_relaxed);
+    });
+    for (std::size_t job = 0; job < job_count; ++job) {
+      EXPECT_EQ(hits[job].load(), 1) << "round " << round << " job " << job;
+    }
+  }
+}
+
+TEST(SystemExecutorTest, RunsInlineWithoutWorkers) {
+  SystemExecutor executor(0);
+  std::vector<std::size_t> order;
+  executor.run(4, [&order](std::size_t job) { order.push_back(job); });
+  EXPECT_EQ(order, (std::vector<std::size_t>{0, 1, 2, 3}));
+}
+
+TEST(SystemExecutorTest, RethrowsAFailedJobOnTheCaller) {
+  SystemExecutor executor(2);
+  std::atomic<int> finished{0};
+  EXPECT_THROW(executor.run(8,
+                            [&finished](std::size_t job) {
+                              if (job == 5) {
+                                throw std::runtime_error("job failed");
+                              }
+                              finished.fetch_add(1, std::memory_order_relaxed);
+                            }),
+               std::runtime_error);
+  EXPECT_EQ(finished.load(), 7);
+
+  std::atomic<int> after{0};
+  executor.run(4, [&after](std::size_t) { after.fetch_add(1); });
+  EXPECT_EQ(after.load(), 4);
+}
+
+class DriftSystem : public Engine::Core::System {
+public:
+  void update(World* world, float delta_time) override {
+    for (auto [id, transform] : world->view<TransformComponent>()) {
+      const auto lane = static_cast<float>(id % 7U);
+      transform.position.x += delta_time * (1.0F + lane);
+      transform.position.z -= delta_time * 0.5F * lane;
+    }
+  }
+  [[nodiscard]] auto phase() const -> SystemPhase override {
+    return SystemPhase::Movement;
+  }
+  [[nodiscard]] auto access() const -> SystemAccess override {
+    return SystemAccess::declare(Writes<TransformComponent>{});
+  }
+};
+
+class AttritionSystem : public Engine::Core::System {
+public:
+  void update(World* world, float) override {
+    for (auto [id, unit] : world->view<UnitComponent>()) {
+      unit.health -= static_cast<int>(1U + (id % 5U));
+      if (unit.health <= 0) {
+        world->deferred().destroy_entity(id);
+      }
+    }
+  }
+  [[nodiscard]] auto phase() const -> SystemPhase override {
+    return SystemPhase::Movement;
+  }
+  [[nodiscard]] auto access() const -> SystemAccess override {
+    return SystemAccess::declare(Writes<UnitComponent>{});
+  }
+};
+
+class ArmingSystem : public Engine::Core::System {
+public:
+  void update(World* world, float) override {
+    for (auto [id, attack] : world->view<AttackComponent>()) {
+      attack.range += 0.25F;
+      if (attack.range > 4.0F) {
+        world->deferred().remove_component<AttackComponent>(id);
+      }
+    }
+  }
+  [[nodiscard]] auto phase() const -> SystemPhase override {
+    return SystemPhase::Movement;
+  }
+  [[nodiscard]] auto access() const -> SystemAccess override {
+    return SystemAccess::declare(Writes<AttackComponent>{});
+  }
+};
+
+class RearmSystem : public Engine::Core::System {
+public:
+  void update(World* world, float) override {
+    for (auto [id, unit] : world->view<UnitComponent>()) {
+      auto* entity = world->get_entity(id);
+      if (entity != nullptr && !entity->has_component<AttackComponent>() &&
+          unit.health % 3 == 0) {
+        world->deferred().add_component<AttackComponent>(id);
+      }
+    }
+  }
+  [[nodiscard]] auto phase() const -> SystemPhase override {
+    return SystemPhase::Combat;
+  }
+  [[nodiscard]] auto access() const -> SystemAccess override {
+    return SystemAccess::declare(Reads<UnitComponent>{}, Writes<AttackComponent>{});
+  }
+};
+
+class InPlaceSpawnSystem : public Engine::Core::System {
+public:
+  void update(World* world, float) override { world->create_entity(); }
+  [[nodiscard]] auto phase() const -> SystemPhase override {
+    return SystemPhase::Movement;
+  }
+  [[nodiscard]] auto access() const -> SystemAccess override {
+    return SystemAccess::declare(Writes<StaminaComponent>{});
+  }
+};
+
+void populate(World& world) {
+  world.add_system(std::make_unique<DriftSystem>());
+  world.add_system(std::make_unique<AttritionSystem>());
+  world.add_system(std::make_unique<ArmingSystem>());
+  world.add_system(std::make_unique<RearmSystem>());
+
+  for (int i = 0; i < 300; ++i) {
+    auto* entity = world.create_entity();
+    entity->add_component<TransformComponent>(static_cast<float>(i), 0.0F,
+                                              static_cast<float>(-i));
+    entity->add_component<UnitComponent>(40 + (i % 60), 100);
+    if (i % 4 == 0) {
+      entity->add_component<AttackComponent>();
+    }
+  }
+}
+
+auto digest(const World& world) -> std::uint64_t {
+  std::uint64_t hash = 1469598103934665603ULL;
+  const auto mix = [&hash](std::uint64_t value) {
+    hash ^= value;
+    hash *= 1099511628211ULL;
+  };
+  world.for_each_entity([&mix](const Engine::Core::Entity& entity) {
+    mix(entity.get_id());
+    if (const auto* transform = entity.get_component<TransformComponent>()) {
+      mix(static_cast<std::uint64_t>(
+          static_cast<std::int64_t>(transform->position.x * 1000.0F)));
+      mix(static_cast<std::uint64_t>(
+          static_cast<std::int64_t>(transform->position.z * 1000.0F)));
+    }
+    if (const auto* unit = entity.get_component<UnitComponent>()) {
+      mix(static_cast<std::uint64_t>(unit->health));
+    }
+    if (const auto* attack = entity.get_component<AttackComponent>()) {
+      mix(static_cast<std::uint64_t>(attack->range * 1000.0F));
+    }
+  });
+  return hash;
+}
+
+TEST(ParallelWorldUpdateTest, DisjointMovementSystemsShareABatch) {
+  const std::vector<SystemAccess> movement{DriftSystem{}.access(),
+                                           AttritionSystem{}.access(),
+                                           ArmingSystem{}.access()};
+  const auto batches = plan_phase_batches(movement);
+  ASSERT_EQ(batches.size(), 1U);
+  EXPECT_EQ(batches[0].size(), 3U);
+}
+
+TEST(ParallelWorldUpdateTest, MatchesTheSerialWorldTickForTick) {
+  World serial;
+  World parallel;
+  parallel.set_worker_count(3);
+  ASSERT_EQ(parallel.worker_count(), 3U);
+  populate(serial);
+  populate(parallel);
+
+  for (int tick = 0; tick < 80; ++tick) {
+    serial.update(0.05F);
+    parallel.update(0.05F);
+    ASSERT_EQ(serial.entity_count(), parallel.entity_count()) << "tick " << tick;
+    ASSERT_EQ(digest(serial), digest(parallel)) << "tick " << tick;
+  }
+  EXPECT_LT(serial.entity_count(), 300U);
+}
+
+TEST(ParallelWorldUpdateTest, AStructuralEditInsideABatchAbortsInEveryBuild) {
+  GTEST_FLAG_SET(death_test_style, "threadsafe");
+  EXPECT_DEATH(
+      {
+        World world;
+        world.set_worker_count(2);
+        world.add_system(std::make_unique<DriftSystem>());
+        world.add_system(std::make_unique<InPlaceSpawnSystem>());
+        world.update(0.05F);
+      },
+      "Registry::create_entity called from a parallel system batch");
+}
+
+TEST(ParallelWorldUpdateTest, DroppingTheWorkersFallsBackToSerial) {
+  World world;
+  world.set_worker_count(2);
+  world.set_worker_count(0);
+  EXPECT_EQ(world.worker_count(), 0U);
+  populate(world);
+  world.update(0.05F);
+  EXPECT_EQ(world.entity_count(), 300U);
+}
+
+} // namespace
@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <memory>
+#include <typeindex>
+#include <utility>
 #include <vector>
 
 #include "game/core/component.h"
@@ -100,6 +103,71 @@ TEST(SystemScheduleTest, BatchesRunInRegistrationOrder) {
   EXPECT_EQ(flattened, (std::vector<std::size_t>{0, 1, 2}));
 }
 
+TEST(SystemScheduleTest, StoragesOfAnOwningGroupCollideAsOneUnit) {
+  // Adding or removing a UnitComponent moves the entity inside the
+  // Transform/Unit group, which swaps TransformComponent's dense slots.
+  const std::vector<SystemAccess> systems{
+      access({}, {component_type_id<UnitComponent>()}),
+      access({component_type_id<TransformComponent>()}, {}),
+      access({component_type_id<AttackComponent>()}, {}),
+  };
+  const std::vector<std::vector<Engine::Core::ComponentTypeId>> linked{
+      {component_type_id<TransformComponent>(), component_type_id<UnitComponent>()}};
+
+  EXPECT_EQ(plan_phase_batches(systems).size(), 1U);
+
+  const auto batches = plan_phase_batches(systems, linked);
+  ASSERT_EQ(batches.size(), 2U);
+  EXPECT_EQ(batches[0], (std::vector<std::size_t>{0}));
+  EXPECT_EQ(batches[1], (std::vector<std::size_t>{1, 2}));
+}
+
+class UnitChurnSystem : public Engine::Core::System {
+public:
+  void update(World* world, float) override {
+    for (auto [id, unit] : world->view<UnitComponent>()) {
+      if (unit.health <= 0) {
+        world->deferred().remove_component<UnitComponent>(id);
+      }
+    }
+  }
+  [[nodiscard]] auto phase() const -> SystemPhase override {
+    return SystemPhase::Movement;
+  }
+  [[nodiscard]] auto access() const -> SystemAccess override {
+    return SystemAccess::declare(Engine::Core::Writes<UnitComponent>{});
+  }
+};
+
+class TransformReaderSystem : public Engine::Core::System {
+public:
+  void update(World* world, float) override {
+    for (auto [id, transform] : world->view<TransformComponent>()) {
+      m_sum += transform.position.x;
+    }
+  }
+  [[nodiscard]] auto phase() const -> SystemPhase override {
+    return SystemPhase::Movement;
+  }
+  [[nodiscard]] auto access() const -> SystemAccess override {
+    return SystemAccess::declare(Engine::Core::Reads<TransformComponent>{});
+  }
+
+private:
+  float m_sum = 0.0F;
+};
+
+TEST(SystemScheduleTest, TheWorldKeepsAUnitWriterAwayFromATransformReader) {
+  World world;
+  world.add_system(std::make_unique<UnitChurnSystem>());
+  world.add_system(std::make_unique<TransformReaderSystem>());
+
+  const auto batches = world.plan_phase_schedule(SystemPhase::Movement);
+  ASSERT_EQ(batches.size(), 2U);
+  EXPECT_EQ(batches[0], (std::vector<std::size_t>{0}));
+  EXPECT_EQ(batches[1], (std::vector<std::size_t>{1}));
+}
+
 TEST(SystemPhaseTest, EveryPhaseHasAName) {
   for (std::uint8_t raw = 0; raw < static_cast<std::uint8_t>(SystemPhase::_Count);
        ++raw) {
@@ -189,6 +257,71 @@ TEST(DeferredMutationsTest, AChangeRecordedByAChangeWaitsForTheNextBarrier) {
   EXPECT_FALSE(world.is_alive(id));
 }
 
+TEST(DeferredMutationsTest, DropsChangesForAnEntityDestroyedInTheSameStretch) {
+  World world;
+  const EntityID doomed = spawn_unit(world);
+  const EntityID survivor = spawn_unit(world);
+  std::vector<EntityID> added;
+  world.add_component_observer([&added](EntityID id, std::type_index, bool was_added) {
+    if (was_added) {
+      added.push_back(id);
+    }
+  });
+
+  DeferredMutations pending;
+  pending.add_component<MovementComponent>(doomed);
+  pending.add_component<MovementComponent>(survivor);
+  pending.destroy_entity(doomed);
+  pending.add_component<AttackComponent>(doomed);
+  pending.destroy_entity(doomed);
+  pending.apply(world);
+
+  EXPECT_EQ(added, (std::vector<EntityID>{survivor}));
+  EXPECT_FALSE(world.is_alive(doomed));
+  EXPECT_TRUE(world.get_entity(survivor)->has_component<MovementComponent>());
+}
+
+TEST(DeferredMutationsTest, ARunActionSeesEverythingRecordedBeforeIt) {
+  World world;
+  const EntityID id = spawn_unit(world);
+
+  DeferredMutations pending;
+  bool saw_movement = false;
+  pending.add_component<MovementComponent>(id);
+  pending.run([&saw_movement, id](World& target) {
+    saw_movement = target.get_entity(id)->has_component<MovementComponent>();
+  });
+  pending.destroy_entity(id);
+  pending.apply(world);
+
+  EXPECT_TRUE(saw_movement);
+  EXPECT_FALSE(world.is_alive(id));
+}
+
+TEST(DeferredMutationsTest, AppendKeepsEachBufferInTheOrderRecorded) {
+  World world;
+  const EntityID first = spawn_unit(world);
+  const EntityID second = spawn_unit(world);
+
+  DeferredMutations merged;
+  merged.add_component<AttackComponent>(first, 2.0F, 1.0F, 0.5F);
+  DeferredMutations job;
+  job.add_component<AttackComponent>(first, 6.0F, 1.0F, 0.5F);
+  job.add_component<AttackComponent>(second, 4.0F, 1.0F, 0.5F);
+  job.remove_component<UnitComponent>(second);
+  merged.append(std::move(job));
+
+  EXPECT_TRUE(job.empty());
+  EXPECT_EQ(merged.pending(), 4U);
+  merged.apply(world);
+
+  EXPECT_FLOAT_EQ(world.get_entity(first)->get_component<AttackComponent>()->range,
+                  6.0F);
+  EXPECT_FLOAT_EQ(world.get_entity(second)->get_component<AttackComponent>()->range,
+                  4.0F);
+  EXPECT_FALSE(world.get_entity(second)->has_component<UnitComponent>());
+}
+
 TEST(DeferredMutationsTest, LetsASystemRestructureTheWorldWhileWalkingAView) {
   World world;
   std::vector<EntityID> ids;
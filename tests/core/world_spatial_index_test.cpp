@@ -86,6 +86,48 @@ TEST(WorldSpatialIndexTest, AgreesWithTheBruteForceScanAtEveryRadius) {
   }
 }
 
+TEST(WorldSpatialIndexTest, RectQueriesAgreeWithTheBruteForceScan) {
+  World world;
+  std::vector<EntityID> ids;
+  for (int i = 0; i < 40; ++i) {
+    const auto fi = static_cast<float>(i);
+    ids.push_back(spawn(world,
+                        std::fmod(fi * 11.0F, 60.0F) - 30.0F,
+                        std::fmod(fi * 17.0F, 60.0F) - 30.0F,
+                        1));
+  }
+
+  auto& index = world.spatial_index();
+  index.rebuild(world);
+
+  const float rects[][4] = {{-5.0F, -5.0F, 5.0F, 5.0F},
+                            {-30.0F, -2.0F, 30.0F, 3.0F},
+                            {7.5F, -29.0F, 8.5F, 29.0F}};
+  for (const auto& rect : rects) {
+    std::vector<EntityID> brute;
+    for (const EntityID id : ids) {
+      auto* entity = world.get_entity(id);
+      const auto& position = entity->get_component<TransformComponent>()->position;
+      if (position.x >= rect[0] && position.x <= rect[2] && position.z >= rect[1] &&
+          position.z <= rect[3]) {
+        brute.push_back(id);
+      }
+    }
+    std::sort(brute.begin(), brute.end());
+
+    std::vector<EntityID> found;
+    index.for_each_in_rect(rect[0],
+                           rect[1],
+                           rect[2],
+                           rect[3],
+                           [&found](const WorldSpatialIndex::Entry& entry) {
+                             found.push_back(entry.id);
+                           });
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, brute) << "rect " << rect[0] << "," << rect[1];
+  }
+}
+
 TEST(WorldSpatialIndexTest, CarriesTheFlagsProximityQueriesFilterOn) {
   World world;
   const EntityID soldier = spawn(world, 0.0F, 0.0F, 1);
@@ -184,4 +226,87 @@ TEST(WorldSpatialIndexTest, ExaminesFarFewerCandidatesThanAFullScan) {
   EXPECT_LT(index.stats().candidates_examined, 100U);
 }
 
+TEST(WorldSpatialIndexTest, BatchQueriesMatchTheScalarVisitorForEveryQuery) {
+  World world;
+  for (int i = 0; i < 300; ++i) {
+    const auto fi = static_cast<float>(i);
+    spawn(world,
+          std::fmod(fi * 7.3F, 90.0F) - 45.0F,
+          std::fmod(fi * 11.9F, 90.0F) - 45.0F,
+          1 + (i % 3),
+          (i % 11 == 0) ? 0 : 100);
+  }
+
+  auto& index = world.spatial_index();
+  index.rebuild(world);
+
+  std::vector<WorldSpatialIndex::RadiusQuery> queries;
+  for (int q = 0; q < 24; ++q) {
+    const auto fq = static_cast<float>(q);
+    queries.push_back({.x = std::fmod(fq * 13.0F, 80.0F) - 40.0F,
+                       .z = std::fmod(fq * 29.0F, 80.0F) - 40.0F,
+                       .radius = 2.0F + fq,
+                       .require_flags = WorldSpatialIndex::k_alive,
+                       .owner_mask = WorldSpatialIndex::owner_bit(1) |
+                                     WorldSpatialIndex::owner_bit(3)});
+  }
+
+  WorldSpatialIndex::BatchResult result;
+  index.query_radius_batch(queries, result);
+  ASSERT_EQ(result.query_count(), queries.size());
+
+  for (std::size_t q = 0; q < queries.size(); ++q) {
+    std::vector<EntityID> expected;
+    index.for_each_in_radius(
+        queries[q].x,
+        queries[q].z,
+        queries[q].radius,
+        [&expected](const WorldSpatialIndex::Entry& entry) {
+          if (entry.is(WorldSpatialIndex::k_alive) &&
+              (entry.owner_id == 1 || entry.owner_id == 3)) {
+            expected.push_back(entry.id);
+          }
+        });
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<EntityID> batched;
+    for (const std::uint32_t hit : result.hits_for(q)) {
+      batched.push_back(index.entries()[hit].id);
+    }
+    std::sort(batched.begin(), batched.end());
+    EXPECT_EQ(batched, expected) << "query " << q;
+  }
+}
+
+TEST(WorldSpatialIndexTest, BatchQueriesRejectFlaggedCandidatesBeforeTheCaller) {
+  World world;
+  const EntityID enemy = spawn(world, 1.0F, 0.0F, 2);
+  spawn(world, 0.5F, 0.0F, 1);
+  spawn(world, 1.5F, 0.0F, 2, 0);
+  auto* fort = world.get_entity(spawn(world, 2.0F, 0.0F, 2));
+  fort->add_component<BuildingComponent>();
+
+  auto& index = world.spatial_index();
+  index.rebuild(world);
+  index.reset_stats();
+
+  const std::vector<WorldSpatialIndex::RadiusQuery> queries{
+      {.x = 0.0F,
+       .z = 0.0F,
+       .radius = 5.0F,
+       .require_flags = WorldSpatialIndex::k_alive,
+       .reject_flags = WorldSpatialIndex::k_building,
+       .owner_mask = ~WorldSpatialIndex::owner_bit(1)},
+      {.x = 0.0F, .z = 0.0F, .radius = -1.0F}};
+  WorldSpatialIndex::BatchResult result;
+  index.query_radius_batch(queries, result);
+
+  ASSERT_EQ(result.hits_for(0).size(), 1U);
+  EXPECT_EQ(index.entries()[result.hits_for(0)[0]].id, enemy);
+  EXPECT_TRUE(result.hits_for(1).empty());
+  EXPECT_EQ(index.stats().queries, 2U);
+  EXPECT_EQ(index.stats().candidates_examined, 4U);
+  EXPECT_EQ(index.stats().candidates_accepted, 1U);
+}
+
 } // namespace
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <gtest/gtest.h>
 #include <vector>
 
@@ -133,4 +134,38 @@ TEST(WorldViewTest, MatchesTheMaterialisingQuery) {
   EXPECT_EQ(collected, viewed);
 }
 
+TEST(WorldViewTest, GroupedTuplesWalkOnlyTheGroupPrefix) {
+  World world;
+  std::vector<EntityID> movers;
+  for (int i = 0; i < 32; ++i) {
+    const EntityID id = spawn_unit(world, static_cast<float>(i), 0.0F);
+    if (i % 4 == 0) {
+      world.get_entity(id)->add_component<MovementComponent>();
+      movers.push_back(id);
+    }
+  }
+  for (int i = 0; i < 24; ++i) {
+    world.create_entity()->add_component<UnitComponent>();
+    world.create_entity()->add_component<MovementComponent>();
+  }
+
+  auto units = world.view<TransformComponent, UnitComponent>();
+  EXPECT_EQ(units.candidate_count(), 32U);
+
+  const std::uint64_t before = world.query_counters().view_candidates;
+  std::vector<EntityID> visited;
+  for (auto [id, transform, movement, unit] :
+       world.view<TransformComponent, MovementComponent, UnitComponent>()) {
+    (void)transform;
+    (void)movement;
+    (void)unit;
+    visited.push_back(id);
+  }
+  EXPECT_EQ(world.query_counters().view_candidates - before, movers.size());
+
+  std::sort(visited.begin(), visited.end());
+  std::sort(movers.begin(), movers.end());
+  EXPECT_EQ(visited, movers);
+}
+
 } // namespace
@@ -40,7 +40,7 @@ auto make_request(const QString& slot_name) -> SaveRequest {
   request.mode = QStringLiteral("skirmish");
   request.difficulty = QStringLiteral("normal");
   request.metadata = QJsonObject{{"map_name", "River Crossing"}};
-  request.world = make_world_document(200);
+  request.world = make_world_document(200).toJson(QJsonDocument::Compact);
   return request;
 }
 
@@ -12,6 +12,7 @@
 #include "systems/nav_grid.h"
 #include "systems/pathfinding.h"
 #include "systems/troop_profile_service.h"
+#include "tests/support/phase_barrier.h"
 
 namespace {
 
@@ -187,6 +188,7 @@ TEST_F(ArmyFormationRegistryTest, RuntimePrunesDestroyedMembers) {
 
   ArmyFormationRuntime runtime;
   runtime.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   const auto* formation = ArmyFormationRegistry::instance().find(result.group_id);
   ASSERT_NE(formation, nullptr);
@@ -14,6 +14,7 @@
 #include "systems/nav_grid.h"
 #include "systems/pathfinding.h"
 #include "systems/troop_profile_service.h"
+#include "tests/support/phase_barrier.h"
 
 namespace {
 
@@ -208,6 +209,7 @@ TEST_F(FormationCohesionTest, TheRuntimeTickMeasuresCohesionWithoutBeingAsked) {
 
   ArmyFormationRuntime runtime;
   runtime.update(&m_world, 1.0F);
+  TestSupport::apply_phase_barrier(m_world);
 
   const auto* measured = ArmyFormationRegistry::instance().find(group_id);
   ASSERT_NE(measured, nullptr);
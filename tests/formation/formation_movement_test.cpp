@@ -12,6 +12,7 @@
 #include "systems/nav_grid.h"
 #include "systems/pathfinding.h"
 #include "systems/troop_profile_service.h"
+#include "tests/support/phase_barrier.h"
 
 namespace {
 
@@ -128,6 +129,7 @@ TEST_F(FormationMovementTest, MaintainFormationAdvancesTheAnchorInStages) {
 
   ArmyFormationRuntime runtime;
   runtime.update(&world, 0.3F);
+  TestSupport::apply_phase_barrier(world);
 
   float const second_anchor = registry.find(result.group_id)->anchor.z();
   EXPECT_GT(second_anchor, first_anchor);
@@ -160,6 +162,7 @@ TEST_F(FormationMovementTest, MaintainFormationDoesNotOvershootTheDestination) {
       transform->position.z = slot->world_position.z();
     }
     runtime.update(&world, 0.3F);
+    TestSupport::apply_phase_barrier(world);
   }
 
   const auto* formation = registry.find(result.group_id);
@@ -314,6 +317,7 @@ TEST_F(FormationMovementTest, TheAnchorAdvancesSmoothlyInsteadOfJumpingBetweenSt
       transform->position.z = slot->world_position.z();
     }
     runtime.update(&world, 0.3F);
+    TestSupport::apply_phase_barrier(world);
 
     const auto* advanced = registry.find(result.group_id);
     ASSERT_NE(advanced, nullptr);
@@ -366,6 +370,7 @@ TEST_F(FormationMovementTest, SlotErrorStaysBoundedWhileTheFormationMarches) {
           (slot->world_position.z() - transform->position.z) * 0.5F;
     }
     runtime.update(&world, 0.3F);
+    TestSupport::apply_phase_barrier(world);
   }
 
   EXPECT_LT(worst_slot_error, 2.5F)
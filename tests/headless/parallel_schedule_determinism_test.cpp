@@ -0,0 +1,129 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "game/command/command.h"
+#include "game/command/command_queue.h"
+#include "game/core/component.h"
+#include "game/core/world.h"
+#include "game/map/map_definition.h"
+#include "game/map/terrain_service.h"
+#include "game/session/session_context.h"
+#include "game/session/simulation_clock.h"
+#include "game/session/world_digest.h"
+#include "game/systems/default_content.h"
+#include "game/systems/nav_grid.h"
+#include "game/systems/owner_registry.h"
+#include "game/systems/runtime_system_registry.h"
+#include "game/units/factory.h"
+#include "game/units/spawn_type.h"
+
+namespace {
+
+using Engine::Core::TransformComponent;
+using Engine::Core::UnitComponent;
+using Game::Session::ScopedSession;
+using Game::Session::SessionContext;
+
+constexpr int k_map_size = 96;
+constexpr int k_left = 1;
+constexpr int k_right = 2;
+constexpr int k_ranks = 3;
+constexpr int k_files = 10;
+constexpr int k_ticks = 180;
+
+class ParallelScheduleDeterminismTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    Game::Systems::NavGrid::initialize(k_map_size, k_map_size);
+    m_factory = std::make_shared<Game::Units::UnitFactoryRegistry>();
+    Game::Units::register_built_in_units(*m_factory);
+  }
+
+  static void muster(SessionContext& session,
+                     int owner_id,
+                     float origin_z,
+                     float facing_z,
+                     std::vector<Engine::Core::EntityID>& ids) {
+    for (int rank = 0; rank < k_ranks; ++rank) {
+      for (int file = 0; file < k_files; ++file) {
+        auto* entity = session.world().create_entity();
+        auto* transform = entity->add_component<TransformComponent>();
+        transform->position.x = 12.0F + static_cast<float>(file) * 1.4F;
+        transform->position.z = origin_z + static_cast<float>(rank) * 1.4F * facing_z;
+        auto* unit = entity->add_component<UnitComponent>(120, 120, 2.4F, 14.0F);
+        unit->owner_id = owner_id;
+        unit->spawn_type = (file % 3 == 0) ? Game::Units::SpawnType::Archer
+                                           : Game::Units::SpawnType::Spearman;
+        entity->add_component<Engine::Core::MovementComponent>();
+        entity->add_component<Engine::Core::AttackComponent>(12.0F, 8.0F, 1.0F);
+        ids.push_back(entity->get_id());
+      }
+    }
+  }
+
+  // Digest after every tick of the same battle, run with `workers` threads.
+  auto run_battle(std::size_t workers) -> std::vector<std::uint64_t> {
+    SessionContext session;
+    const ScopedSession scope(session);
+    auto& owners = session.owners();
+    owners.register_owner_with_id(k_left, Game::Systems::OwnerType::Player, "left");
+    owners.register_owner_with_id(k_right, Game::Systems::OwnerType::AI, "right");
+    owners.set_owner_team(k_left, 1);
+    owners.set_owner_team(k_right, 2);
+    Game::Systems::initialize_default_content(session.nations());
+    Game::Systems::register_runtime_systems(session.world());
+    session.world().set_worker_count(workers);
+
+    Game::Map::MapDefinition map_definition;
+    map_definition.grid.width = k_map_size;
+    map_definition.grid.height = k_map_size;
+    map_definition.grid.tile_size = 1.0F;
+    session.terrain().initialize(map_definition);
+
+    std::vector<Engine::Core::EntityID> left;
+    std::vector<Engine::Core::EntityID> right;
+    muster(session, k_left, 40.0F, -1.0F, left);
+    muster(session, k_right, 56.0F, 1.0F, right);
+
+    // One side marches past the other so movement, avoidance and combat all
+    // run while the batches are shared.
+    Game::Command::Move move;
+    move.units = left;
+    for (std::size_t index = 0; index < left.size(); ++index) {
+      move.targets.emplace_back(
+          20.0F + static_cast<float>(index % k_files), 0.0F, 70.0F);
+    }
+    session.commands().submit(
+        Game::Command::Source::LocalPlayer, k_left, Game::Command::Payload{move});
+
+    const auto step = static_cast<float>(session.clock().tick_seconds());
+    std::vector<std::uint64_t> digests;
+    digests.reserve(k_ticks);
+    for (int tick = 0; tick < k_ticks; ++tick) {
+      session.world().update(step);
+      digests.push_back(Game::Session::world_digest(session.world()));
+    }
+    return digests;
+  }
+
+  std::shared_ptr<Game::Units::UnitFactoryRegistry> m_factory;
+};
+
+TEST_F(ParallelScheduleDeterminismTest, OneWorkerAndManyWorkersProduceTheSameWorld) {
+  const auto single = run_battle(1);
+  const auto many = run_battle(4);
+  ASSERT_EQ(single.size(), many.size());
+  for (std::size_t tick = 0; tick < single.size(); ++tick) {
+    ASSERT_EQ(single[tick], many[tick]) << "worlds diverged at tick " << tick + 1;
+  }
+}
+
+TEST_F(ParallelScheduleDeterminismTest, TheParallelScheduleMatchesTheSerialOne) {
+  const auto serial = run_battle(0);
+  const auto parallel = run_battle(4);
+  EXPECT_EQ(serial, parallel);
+}
+
+} // namespace
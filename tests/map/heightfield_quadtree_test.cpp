@@ -0,0 +1,83 @@
+#include <QVector3D>
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "game/map/heightfield_quadtree.h"
+
+namespace {
+
+using Game::Map::HeightfieldQuadtree;
+
+constexpr int k_width = 129;
+constexpr int k_height = 97;
+
+auto hill_height(int x, int z) -> float {
+  float const dx = static_cast<float>(x - 90);
+  float const dz = static_cast<float>(z - 40);
+  return 6.0F * std::exp(-(dx * dx + dz * dz) / 60.0F);
+}
+
+auto hill_heights() -> std::vector<float> {
+  std::vector<float> heights(static_cast<std::size_t>(k_width) * k_height);
+  for (int z = 0; z < k_height; ++z) {
+    for (int x = 0; x < k_width; ++x) {
+      heights[static_cast<std::size_t>(z) * k_width + x] = hill_height(x, z);
+    }
+  }
+  return heights;
+}
+
+TEST(HeightfieldQuadtreeTest, RootBoundsCoverEveryVertexPlusSlack) {
+  HeightfieldQuadtree tree;
+  tree.build(k_width, k_height, 1.0F, hill_heights(), 0.25F);
+
+  ASSERT_FALSE(tree.empty());
+  EXPECT_EQ(tree.leaf_count(), 16U * 12U);
+  EXPECT_NEAR(tree.min_height(), -0.25F, 1.0e-4F);
+  EXPECT_NEAR(tree.max_height(), 6.25F, 1.0e-4F);
+}
+
+TEST(HeightfieldQuadtreeTest, RaySpansSkipFlatGroundAndKeepTheHill) {
+  HeightfieldQuadtree tree;
+  tree.build(k_width, k_height, 1.0F, hill_heights(), 0.05F);
+
+  QVector3D const hill_top(90.0F - 64.0F, 6.0F, 40.0F - 48.0F);
+  QVector3D const origin(-70.0F, 30.0F, -30.0F);
+  QVector3D const direction = hill_top - origin;
+  float const max_t = 4.0F;
+
+  std::vector<HeightfieldQuadtree::RaySpan> spans;
+  tree.collect_ray_spans(origin, direction, max_t, spans);
+  ASSERT_FALSE(spans.empty());
+
+  float covered = 0.0F;
+  for (std::size_t i = 0; i < spans.size(); ++i) {
+    EXPECT_LE(spans[i].t_enter, spans[i].t_exit);
+    if (i > 0U) {
+      EXPECT_GT(spans[i].t_enter, spans[i - 1U].t_exit);
+    }
+    covered += spans[i].t_exit - spans[i].t_enter;
+  }
+  EXPECT_LT(covered, max_t * 0.25F);
+
+  float const hit_t = 1.0F;
+  bool const inside = std::any_of(spans.begin(), spans.end(), [&](const auto& span) {
+    return hit_t >= span.t_enter && hit_t <= span.t_exit;
+  });
+  EXPECT_TRUE(inside) << "the hill top at t=" << hit_t << " must stay reachable";
+}
+
+TEST(HeightfieldQuadtreeTest, RayAboveTheTallestLeafProducesNoSpans) {
+  HeightfieldQuadtree tree;
+  tree.build(k_width, k_height, 1.0F, hill_heights(), 0.05F);
+
+  std::vector<HeightfieldQuadtree::RaySpan> spans;
+  tree.collect_ray_spans(
+      QVector3D(-80.0F, 10.0F, 0.0F), QVector3D(1.0F, 0.0F, 0.0F), 300.0F, spans);
+  EXPECT_TRUE(spans.empty());
+}
+
+} // namespace
@@ -26,6 +26,7 @@
 #include "game/systems/victory_service.h"
 #include "render/scene_renderer.h"
 #include "scene/camera.h"
+#include "tests/support/phase_barrier.h"
 
 namespace {
 
@@ -412,6 +413,7 @@ TEST_F(IronSepulcherSkirmishTest, ShrineFlagOnlyFallsBetweenWaves) {
   for (int tick = 0; tick < 40; ++tick) {
     undead->update(&world, 0.25F);
     capture_system.update(&world, 0.25F);
+    TestSupport::apply_phase_barrier(world);
   }
 
   auto* capture = anchor->get_component<Engine::Core::CaptureComponent>();
@@ -428,6 +430,7 @@ TEST_F(IronSepulcherSkirmishTest, ShrineFlagOnlyFallsBetweenWaves) {
   EXPECT_FALSE(capture->capture_blocked);
 
   capture_system.update(&world, 0.25F);
+  TestSupport::apply_phase_barrier(world);
   EXPECT_TRUE(capture->is_being_captured)
       << "with the guardians down the flag starts coming off the pole";
   EXPECT_GT(capture->capture_progress, 0.0F);
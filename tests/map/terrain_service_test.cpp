@@ -1,6 +1,11 @@
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <gtest/gtest.h>
+#include <optional>
+#include <random>
+#include <tuple>
+#include <unordered_set>
 #include <utility>
 
 #include "app/session/skirmish_loader.h"
@@ -76,6 +81,90 @@ auto brute_point_near_road(const std::vector<Game::Map::RoadSegment>& roads,
   return false;
 }
 
+struct ScannedProp {
+  std::uint64_t id;
+  float grid_x;
+  float grid_z;
+  float world_x;
+  float world_z;
+};
+
+auto scan_unreserved_trees(const Game::Map::TerrainService& terrain,
+                           const std::unordered_set<std::uint64_t>& reserved)
+    -> std::vector<ScannedProp> {
+  auto const* height_map = terrain.get_height_map();
+  float const tile = height_map->get_tile_size();
+  float const half_w = static_cast<float>(height_map->get_width()) * 0.5F - 0.5F;
+  float const half_h = static_cast<float>(height_map->get_height()) * 0.5F - 0.5F;
+  std::vector<ScannedProp> scanned;
+  for (const auto& prop : terrain.world_props()) {
+    if (Game::Map::is_tree_world_prop_type(prop.type) && !reserved.contains(prop.id)) {
+      scanned.push_back({.id = prop.id,
+                         .grid_x = prop.x,
+                         .grid_z = prop.z,
+                         .world_x = (prop.x - half_w) * tile,
+                         .world_z = (prop.z - half_h) * tile});
+    }
+  }
+  return scanned;
+}
+
+auto brute_tree_near_grid(const std::vector<ScannedProp>& props,
+                          float grid_x,
+                          float grid_z,
+                          float max_grid_distance) -> std::optional<std::uint64_t> {
+  std::optional<std::tuple<float, std::uint64_t>> best;
+  for (const auto& prop : props) {
+    float const dx = prop.grid_x - grid_x;
+    float const dz = prop.grid_z - grid_z;
+    std::tuple<float, std::uint64_t> const key{dx * dx + dz * dz, prop.id};
+    if (std::get<0>(key) <= max_grid_distance * max_grid_distance &&
+        (!best.has_value() || key < *best)) {
+      best = key;
+    }
+  }
+  if (!best.has_value()) {
+    return std::nullopt;
+  }
+  return std::get<1>(*best);
+}
+
+auto brute_tree_near_world(const std::vector<ScannedProp>& props,
+                           const Game::Map::TerrainHeightMap& height_map,
+                           float world_x,
+                           float world_z,
+                           float max_world_distance) -> std::optional<std::uint64_t> {
+  float const tile = height_map.get_tile_size();
+  float const query_grid_x =
+      world_x / tile + (static_cast<float>(height_map.get_width()) * 0.5F - 0.5F);
+  float const query_grid_z =
+      world_z / tile + (static_cast<float>(height_map.get_height()) * 0.5F - 0.5F);
+  constexpr float k_snap = 3.0F;
+  std::optional<std::tuple<int, float, float, std::uint64_t>> best;
+  for (const auto& prop : props) {
+    float const dx = prop.world_x - world_x;
+    float const dz = prop.world_z - world_z;
+    float const distance_sq = dx * dx + dz * dz;
+    float const grid_dx = prop.grid_x - query_grid_x;
+    float const grid_dz = prop.grid_z - query_grid_z;
+    float const grid_distance_sq = grid_dx * grid_dx + grid_dz * grid_dz;
+    bool const within_world = distance_sq <= max_world_distance * max_world_distance;
+    if (!within_world && grid_distance_sq > k_snap * k_snap) {
+      continue;
+    }
+    std::tuple<int, float, float, std::uint64_t> const key =
+        within_world ? std::tuple{0, distance_sq, grid_distance_sq, prop.id}
+                     : std::tuple{1, grid_distance_sq, distance_sq, prop.id};
+    if (!best.has_value() || key < *best) {
+      best = key;
+    }
+  }
+  if (!best.has_value()) {
+    return std::nullopt;
+  }
+  return std::get<3>(*best);
+}
+
 TEST_F(TerrainServiceTest, BuildsDerivedFieldForFlatTerrainWithIrregularity) {
   Game::Map::MapDefinition map_def;
   map_def.grid.width = 6;
@@ -937,6 +1026,88 @@ TEST_F(TerrainServiceTest, IronOreLookupReserveAndHarvest) {
   EXPECT_FALSE(terrain.harvest_world_prop(iron_ore->id));
 }
 
+TEST_F(TerrainServiceTest, IndexedTreeLookupsMatchALinearScanAcrossEdits) {
+  Game::Map::MapDefinition map_def;
+  map_def.grid.width = 160;
+  map_def.grid.height = 120;
+  map_def.grid.tile_size = 1.5F;
+  map_def.biome.seed = 77U;
+  Game::Map::apply_ground_type_defaults(map_def.biome,
+                                        Game::Map::GroundType::SoilRocky);
+  std::mt19937 rng(5U);
+  std::uniform_real_distribution<float> grid_x(0.0F, 159.0F);
+  std::uniform_real_distribution<float> grid_z(0.0F, 119.0F);
+  for (int i = 0; i < 3000; ++i) {
+    auto const type = (i % 5 == 0) ? Game::Map::WorldProp::Type::Boulder
+                                   : Game::Map::WorldProp::Type::PineTree;
+    map_def.world_props.push_back({.type = type, .x = grid_x(rng), .z = grid_z(rng)});
+  }
+
+  auto& terrain = Game::Map::TerrainService::instance();
+  terrain.initialize(map_def);
+  std::unordered_set<std::uint64_t> reserved;
+
+  auto const expect_matches_scan = [&](int round) {
+    auto const scanned = scan_unreserved_trees(terrain, reserved);
+    std::uniform_real_distribution<float> world_x(-125.0F, 125.0F);
+    std::uniform_real_distribution<float> world_z(-95.0F, 95.0F);
+    for (int query = 0; query < 200; ++query) {
+      float const qx = world_x(rng);
+      float const qz = world_z(rng);
+      auto const by_world = terrain.find_tree_near_world(qx, qz, 2.5F);
+      auto const expected_world =
+          brute_tree_near_world(scanned, *terrain.get_height_map(), qx, qz, 2.5F);
+      ASSERT_EQ(by_world.has_value(), expected_world.has_value()) << "round " << round;
+      if (by_world.has_value()) {
+        EXPECT_EQ(by_world->id, *expected_world) << "round " << round;
+      }
+
+      float const gx = grid_x(rng);
+      float const gz = grid_z(rng);
+      auto const by_grid = terrain.find_tree_near_grid(gx, gz, 3.0F);
+      auto const expected_grid = brute_tree_near_grid(scanned, gx, gz, 3.0F);
+      ASSERT_EQ(by_grid.has_value(), expected_grid.has_value()) << "round " << round;
+      if (by_grid.has_value()) {
+        EXPECT_EQ(by_grid->id, *expected_grid) << "round " << round;
+      }
+    }
+  };
+
+  expect_matches_scan(0);
+
+  std::vector<std::uint64_t> tree_ids;
+  for (const auto& prop : terrain.world_props()) {
+    if (Game::Map::is_tree_world_prop_type(prop.type)) {
+      tree_ids.push_back(prop.id);
+    }
+  }
+  for (std::size_t i = 0; i < tree_ids.size(); i += 7) {
+    ASSERT_TRUE(terrain.reserve_world_prop(tree_ids[i]));
+    reserved.insert(tree_ids[i]);
+  }
+  for (std::size_t i = 3; i < tree_ids.size(); i += 11) {
+    if (reserved.erase(tree_ids[i]) > 0U) {
+      terrain.release_world_prop(tree_ids[i]);
+    }
+    EXPECT_TRUE(terrain.harvest_world_prop(tree_ids[i]));
+    EXPECT_FALSE(terrain.find_tree_by_id(tree_ids[i]).has_value());
+  }
+  for (int i = 0; i < 200; ++i) {
+    Game::Map::WorldProp const olive{.type = Game::Map::WorldProp::Type::OliveTree};
+    float const x = grid_x(rng) - 80.0F;
+    float const z = grid_z(rng) - 60.0F;
+    std::uint64_t const id = terrain.add_world_prop_at_world(olive, x, z);
+    EXPECT_TRUE(terrain.find_tree_by_id(id).has_value());
+  }
+  expect_matches_scan(1);
+
+  terrain.remove_non_persistent_props();
+  reserved.clear();
+  expect_matches_scan(2);
+  EXPECT_TRUE(terrain.reserve_world_prop(tree_ids.front()));
+  EXPECT_FALSE(terrain.find_boulder_by_id(tree_ids.front()).has_value());
+}
+
 TEST_F(TerrainServiceTest, SkirmishLoaderKeepsRuntimeHarvestScatterAvailable) {
   auto& nation_registry = Game::Systems::NationRegistry::instance();
   nation_registry.clear();
@@ -0,0 +1,160 @@
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "game/map/visibility_field.h"
+
+namespace {
+
+using Game::Map::VisibilityDirtyRect;
+using Game::Map::VisibilityField;
+using Game::Map::VisibilityState;
+using Game::Map::VisionCircle;
+
+constexpr int k_size = 48;
+
+auto circle_at(int x, int z, int radius) -> VisionCircle {
+  const float padded = static_cast<float>(radius) + 0.5F;
+  return {x, z, radius, padded * padded};
+}
+
+auto covers(const VisionCircle& circle, int x, int z) -> bool {
+  const int dx = x - circle.center_x;
+  const int dz = z - circle.center_z;
+  if (dx < -circle.cell_radius || dx > circle.cell_radius ||
+      dz < -circle.cell_radius || dz > circle.cell_radius) {
+    return false;
+  }
+  return static_cast<float>(dx * dx + dz * dz) <= circle.radius_cells_sq;
+}
+
+auto state_at(const VisibilityField& field, int slot, int x, int z) -> VisibilityState {
+  return static_cast<VisibilityState>(
+      field.states(slot)[static_cast<std::size_t>(z * field.width() + x)]);
+}
+
+TEST(VisibilityFieldTest, CountsMatchEveryCircleAfterRandomMoves) {
+  VisibilityField field;
+  field.resize(k_size, k_size);
+  ASSERT_EQ(field.add_viewer(1), 0);
+
+  std::mt19937 rng(7U);
+  std::uniform_int_distribution<int> coord(-4, k_size + 3);
+  std::uniform_int_distribution<int> radius(1, 7);
+  std::vector<VisionCircle> circles(6);
+  std::vector<std::uint8_t> ever_seen(static_cast<std::size_t>(k_size * k_size), 0U);
+
+  for (int frame = 0; frame < 40; ++frame) {
+    field.begin_frame();
+    for (std::size_t id = 0; id < circles.size(); ++id) {
+      if (frame == 0 || (rng() % 3U) == 0U) {
+        circles[id] = circle_at(coord(rng), coord(rng), radius(rng));
+      }
+      field.place(id, 1U, circles[id]);
+    }
+    field.end_frame();
+
+    for (int z = 0; z < k_size; ++z) {
+      for (int x = 0; x < k_size; ++x) {
+        int expected = 0;
+        for (const auto& circle : circles) {
+          expected += covers(circle, x, z) ? 1 : 0;
+        }
+        ASSERT_EQ(field.count_at(0, x, z), expected) << x << "," << z;
+        auto& seen = ever_seen[static_cast<std::size_t>(z * k_size + x)];
+        seen = static_cast<std::uint8_t>(seen | (expected > 0 ? 1U : 0U));
+        const VisibilityState want = expected > 0 ? VisibilityState::Visible
+                                     : seen != 0U ? VisibilityState::Explored
+                                                  : VisibilityState::Unseen;
+        ASSERT_EQ(state_at(field, 0, x, z), want) << x << "," << z;
+      }
+    }
+  }
+}
+
+TEST(VisibilityFieldTest, AMoveDirtiesOnlyTheCellsThatChanged) {
+  VisibilityField field;
+  field.resize(k_size, k_size);
+  field.add_viewer(1);
+  field.begin_frame();
+  field.place(1, 1U, circle_at(10, 10, 3));
+  field.end_frame();
+  (void)field.take_dirty(0);
+
+  field.begin_frame();
+  field.place(1, 1U, circle_at(11, 10, 3));
+  field.end_frame();
+  const VisibilityDirtyRect dirty = field.take_dirty(0);
+
+  ASSERT_FALSE(dirty.empty());
+  EXPECT_GE(dirty.min_x, 6);
+  EXPECT_LE(dirty.max_x, 15);
+  EXPECT_GE(dirty.min_z, 6);
+  EXPECT_LE(dirty.max_z, 14);
+  EXPECT_EQ(state_at(field, 0, 7, 10), VisibilityState::Explored);
+  EXPECT_EQ(state_at(field, 0, 14, 10), VisibilityState::Visible);
+  EXPECT_EQ(state_at(field, 0, 10, 10), VisibilityState::Visible);
+
+  field.begin_frame();
+  field.place(1, 1U, circle_at(11, 10, 3));
+  field.end_frame();
+  EXPECT_TRUE(field.take_dirty(0).empty());
+}
+
+TEST(VisibilityFieldTest, EachViewerSeesOnlyTheSourcesInItsMask) {
+  VisibilityField field;
+  field.resize(k_size, k_size);
+  const int first = field.add_viewer(1);
+  const int second = field.add_viewer(2);
+
+  field.begin_frame();
+  field.place(1, 1U << first, circle_at(8, 8, 2));
+  field.place(2, (1U << first) | (1U << second), circle_at(30, 30, 2));
+  field.end_frame();
+
+  EXPECT_EQ(state_at(field, first, 8, 8), VisibilityState::Visible);
+  EXPECT_EQ(state_at(field, second, 8, 8), VisibilityState::Unseen);
+  EXPECT_EQ(state_at(field, second, 30, 30), VisibilityState::Visible);
+
+  field.begin_frame();
+  field.place(1, 1U << second, circle_at(8, 8, 2));
+  field.end_frame();
+
+  EXPECT_EQ(state_at(field, first, 8, 8), VisibilityState::Explored);
+  EXPECT_EQ(state_at(field, second, 8, 8), VisibilityState::Visible);
+  EXPECT_EQ(state_at(field, first, 30, 30), VisibilityState::Explored);
+}
+
+TEST(VisibilityFieldTest, RevealAllFoldsBackToExploredOnTheNextFrame) {
+  VisibilityField field;
+  field.resize(k_size, k_size);
+  field.add_viewer(1);
+  field.reveal_all();
+  EXPECT_EQ(state_at(field, 0, 40, 40), VisibilityState::Visible);
+
+  field.begin_frame();
+  field.place(1, 1U, circle_at(5, 5, 2));
+  field.end_frame();
+
+  EXPECT_EQ(state_at(field, 0, 5, 5), VisibilityState::Visible);
+  EXPECT_EQ(state_at(field, 0, 40, 40), VisibilityState::Explored);
+  EXPECT_EQ(static_cast<VisibilityState>(field.baseline()[0]),
+            VisibilityState::Explored);
+}
+
+TEST(VisibilityFieldTest, NewViewersStartFromTheRestoredBaseline) {
+  VisibilityField field;
+  field.resize(4, 4);
+  std::vector<std::uint8_t> explored(16, 0U);
+  explored[5] = 1U;
+  ASSERT_TRUE(field.mark_explored(explored));
+  EXPECT_FALSE(field.mark_explored(explored));
+
+  const int slot = field.add_viewer(3);
+  EXPECT_EQ(state_at(field, slot, 1, 1), VisibilityState::Explored);
+  EXPECT_EQ(state_at(field, slot, 0, 0), VisibilityState::Unseen);
+}
+
+} // namespace
@@ -1,9 +1,13 @@
 #include <QMatrix4x4>
 #include <QVector3D>
 
+#include <cmath>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -24,6 +28,45 @@ QMatrix4x4 fingerprint_matrix(int seed) {
   return m;
 }
 
+auto chain_globals(float phase) -> std::vector<QMatrix4x4> {
+  std::vector<QMatrix4x4> global(3U);
+  global[0].translate(0.0F, 0.1F * std::sin(phase), 0.0F);
+  global[0].rotate(20.0F * std::sin(phase), 0.0F, 1.0F, 0.0F);
+  global[1] = global[0];
+  global[1].translate(0.0F, 1.0F, 0.0F);
+  global[1].rotate(35.0F * std::sin(phase * 2.0F), 1.0F, 0.0F, 0.0F);
+  global[2] = global[1];
+  global[2].translate(0.0F, 0.8F, 0.0F);
+  global[2].rotate(15.0F * std::cos(phase), 0.0F, 0.0F, 1.0F);
+  return global;
+}
+
+auto chain_writer() -> BpatWriter {
+  std::vector<QMatrix4x4> const bind = chain_globals(0.0F);
+  BpatWriter w(k_species_horse, 3U);
+  w.set_bind_palette(bind);
+  std::vector<std::uint8_t> const parents{k_no_parent_bone, 0U, 1U};
+  w.set_bone_parents(parents);
+
+  constexpr std::uint32_t k_walk_frames = 60U;
+  w.add_clip(ClipDescriptor{"walk", k_walk_frames, 30.0F, true});
+  std::vector<QMatrix4x4> palettes;
+  for (std::uint32_t f = 0; f < k_walk_frames; ++f) {
+    std::vector<QMatrix4x4> const global =
+        chain_globals(static_cast<float>(f) * 6.2831853F / k_walk_frames);
+    for (std::size_t b = 0; b < global.size(); ++b) {
+      palettes.push_back(global[b] * bind[b].inverted());
+    }
+  }
+  w.append_clip_palettes(palettes);
+
+  constexpr std::uint32_t k_idle_frames = 20U;
+  w.add_clip(ClipDescriptor{"idle", k_idle_frames, 30.0F, true});
+  std::vector<QMatrix4x4> const idle(k_idle_frames * 3U);
+  w.append_clip_palettes(idle);
+  return w;
+}
+
 std::vector<std::uint8_t> serialize(const BpatWriter& w) {
   std::stringstream ss(std::ios::out | std::ios::binary | std::ios::in);
   EXPECT_TRUE(w.write(ss));
@@ -39,7 +82,11 @@ TEST(BpatFormat, HeaderAndEntrySizesAreFrozen) {
   EXPECT_EQ(sizeof(BpatClipEntry), 48U);
   EXPECT_EQ(sizeof(BpatSocketEntry), 32U);
   EXPECT_EQ(sizeof(BpatFrameContact), 8U);
+  EXPECT_EQ(sizeof(BpatHeaderExtV4), 32U);
+  EXPECT_EQ(sizeof(BpatTrackEntry), 32U);
+  EXPECT_EQ(sizeof(BpatPoseKey), 16U);
   EXPECT_EQ(k_version, 3U);
+  EXPECT_EQ(k_version_quantized, 4U);
   EXPECT_EQ(k_magic[0], 'B');
   EXPECT_EQ(k_magic[3], 'T');
 }
@@ -276,6 +323,103 @@ TEST(BpatWriter, AuthoredClipMarkersRoundTrip) {
   EXPECT_FLOAT_EQ(idle_view.marker_contact, -1.0F);
 }
 
+TEST(BpatReader, MappedFileDecodesClipsOnFirstUseAndTrimsLeastRecentlyUsed) {
+  constexpr std::uint32_t bone_count = 4U;
+  constexpr std::uint32_t frames = 5U;
+  BpatWriter w(k_species_horse, bone_count);
+  std::vector<std::vector<QMatrix4x4>> clip_palettes;
+  for (int c = 0; c < 3; ++c) {
+    w.add_clip(ClipDescriptor{"clip" + std::to_string(c), frames, 30.0F, true});
+    std::vector<QMatrix4x4> palettes(bone_count * frames);
+    for (std::size_t i = 0; i < palettes.size(); ++i) {
+      palettes[i] = fingerprint_matrix((c * 100) + static_cast<int>(i));
+    }
+    w.append_clip_palettes(palettes);
+    clip_palettes.push_back(std::move(palettes));
+  }
+  auto const path =
+      std::filesystem::temp_directory_path() / "bpat_reader_mapped_test.bpat";
+  {
+    std::ofstream out(path, std::ios::binary);
+    ASSERT_TRUE(w.write(out));
+  }
+
+  BpatBlob blob = BpatBlob::from_file(path.string());
+  ASSERT_TRUE(blob.loaded()) << blob.last_error();
+  EXPECT_TRUE(blob.mapped());
+  EXPECT_EQ(blob.decoded_clip_count(), 0U);
+  EXPECT_EQ(blob.palette_floats().size(),
+            std::size_t{3U} * frames * bone_count * k_matrix_floats);
+
+  std::uint32_t const walk_frame = blob.clip(1).frame_offset + 2U;
+  auto const walk = blob.frame_palette_view(walk_frame);
+  ASSERT_EQ(walk.size(), bone_count);
+  EXPECT_EQ(walk[3], clip_palettes[1][(2U * bone_count) + 3U]);
+  EXPECT_EQ(blob.decoded_clip_count(), 1U);
+
+  blob.trim_decoded_clips(1U);
+  (void)blob.frame_palette_view(blob.clip(0).frame_offset);
+  (void)blob.frame_palette_view(blob.clip(2).frame_offset);
+  EXPECT_EQ(blob.decoded_clip_count(), 3U);
+
+  blob.trim_decoded_clips(1U);
+  EXPECT_EQ(blob.decoded_clip_count(), 2U)
+      << "clips used in the frame that just ended are never evicted";
+  blob.trim_decoded_clips(1U);
+  EXPECT_EQ(blob.decoded_clip_count(), 1U);
+
+  auto const again = blob.frame_palette_view(walk_frame);
+  ASSERT_EQ(again.size(), bone_count);
+  EXPECT_EQ(again[3], clip_palettes[1][(2U * bone_count) + 3U]);
+
+  blob = BpatBlob{};
+  std::filesystem::remove(path);
+}
+
+TEST(BpatWriter, QuantizedTracksStaySmallAndWithinTolerance) {
+  BpatWriter w = chain_writer();
+  auto raw = BpatBlob::from_bytes(serialize(w));
+  w.set_quantized_tracks(TrackTolerance{});
+  std::vector<std::uint8_t> quantized_bytes = serialize(w);
+  std::size_t const quantized_size = quantized_bytes.size();
+  auto quantized = BpatBlob::from_bytes(std::move(quantized_bytes));
+  ASSERT_TRUE(raw.loaded()) << raw.last_error();
+  ASSERT_TRUE(quantized.loaded()) << quantized.last_error();
+  EXPECT_LT(quantized_size * 3U, raw.raw_bytes().size());
+  EXPECT_TRUE(quantized.palette_floats().empty());
+  ASSERT_EQ(quantized.frame_total(), raw.frame_total());
+
+  for (std::uint32_t f = 0; f < raw.frame_total(); ++f) {
+    for (std::uint32_t b = 0; b < raw.bone_count(); ++b) {
+      auto const expected = raw.palette_matrix(f, b);
+      auto const actual = quantized.palette_matrix(f, b);
+      ASSERT_EQ(actual.size(), expected.size());
+      for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(actual[i], expected[i], 0.02F) << "frame " << f << " bone " << b;
+      }
+    }
+    auto const poses = quantized.frame_local_pose_view(f);
+    ASSERT_EQ(poses.size(), raw.bone_count());
+    EXPECT_NEAR(poses[1].translation.y(), 1.0F, 0.01F);
+  }
+}
+
+TEST(BpatReader, RejectsQuantizedTracksThatDoNotSpanTheirClip) {
+  BpatWriter w = chain_writer();
+  w.set_quantized_tracks(TrackTolerance{});
+  auto bytes = serialize(w);
+  BpatHeaderExtV4 ext_v4{};
+  std::memcpy(&ext_v4,
+              bytes.data() + sizeof(BpatHeader) + sizeof(BpatHeaderExtV3),
+              sizeof(ext_v4));
+  BpatTrackEntry track{};
+  std::memcpy(&track, bytes.data() + ext_v4.track_table_offset, sizeof(track));
+  track.key_count -= 1U;
+  std::memcpy(bytes.data() + ext_v4.track_table_offset, &track, sizeof(track));
+  auto blob = BpatBlob::from_bytes(std::move(bytes));
+  EXPECT_FALSE(blob.loaded());
+}
+
 TEST(BpatReader, RejectsBadMagic) {
   std::vector<std::uint8_t> bytes(sizeof(BpatHeader), 0U);
   bytes[0] = 'X';
@@ -1,8 +1,13 @@
 
 
 #include <gtest/gtest.h>
+#include <sstream>
+#include <string>
 #include <type_traits>
+#include <vector>
 
+#include "animation/bpat/bpat_reader.h"
+#include "animation/bpat/bpat_writer.h"
 #include "render/creature/runtime_bake_guard.h"
 #include "render/creature/spec.h"
 #include "render/elephant/elephant_spec.h"
@@ -119,6 +124,65 @@ TEST(RiggedMeshCache, DifferentAnimationSpeciesDoNotShareSkinAtlases) {
   EXPECT_NE(first->skin_atlas, second->skin_atlas);
 }
 
+TEST(RiggedMeshCache, QuantizedSkinAtlasDecodesOnlyTheClipsItSamples) {
+  using namespace Render::Creature::Bpat;
+  constexpr std::uint32_t k_bones = 2U;
+  constexpr std::uint32_t k_clips = 4U;
+  constexpr std::uint32_t k_frames = 30U;
+  std::vector<QMatrix4x4> bind(k_bones);
+  bind[1].translate(0.0F, 1.0F, 0.0F);
+  std::vector<std::uint8_t> const parents{k_no_parent_bone, 0U};
+  BpatWriter writer(k_species_horse, k_bones);
+  writer.set_bind_palette(bind);
+  writer.set_bone_parents(parents);
+  for (std::uint32_t c = 0; c < k_clips; ++c) {
+    writer.add_clip(ClipDescriptor{"clip" + std::to_string(c), k_frames});
+    std::vector<QMatrix4x4> palettes;
+    for (std::uint32_t f = 0; f < k_frames; ++f) {
+      QMatrix4x4 root;
+      root.rotate(static_cast<float>((c * 10U) + f), 0.0F, 1.0F, 0.0F);
+      palettes.push_back(root);
+      palettes.push_back(root);
+    }
+    writer.append_clip_palettes(palettes);
+  }
+  writer.set_quantized_tracks(TrackTolerance{});
+  std::stringstream stream(std::ios::out | std::ios::binary | std::ios::in);
+  ASSERT_TRUE(writer.write(stream));
+  const std::string bytes = stream.str();
+  const auto blob =
+      BpatBlob::from_bytes(std::vector<std::uint8_t>(bytes.begin(), bytes.end()));
+  ASSERT_TRUE(blob.loaded()) << blob.last_error();
+  ASSERT_TRUE(blob.palette_floats().empty());
+
+  RiggedMeshCache cache;
+  const auto* entry = cache.get_or_bake_prehashed(
+      Render::Humanoid::humanoid_creature_spec(),
+      CreatureLOD::Full,
+      Render::Humanoid::humanoid_bind_palette(),
+      0U,
+      {},
+      0U,
+      1U,
+      blob.species_id());
+  ASSERT_NE(entry, nullptr);
+  Render::GL::rigged_entry_ensure_skin_atlas_from_blob(*entry, blob);
+  ASSERT_TRUE(entry->skin_atlas->ready());
+  EXPECT_EQ(blob.decoded_clip_count(), 0U);
+  EXPECT_EQ(blob.decoded_bytes(), 0U) << "loading the atlas must not decode any clip";
+
+  ASSERT_NE(entry->skin_atlas->frame_palette(blob.clip(2U).frame_offset + 3U), nullptr);
+  EXPECT_EQ(blob.decoded_clip_count(), 1U);
+  std::size_t const one_clip = blob.decoded_bytes();
+  EXPECT_GT(one_clip, 0U);
+  std::size_t const every_clip = std::size_t{blob.frame_total()} * k_bones *
+                                 (sizeof(QMatrix4x4) + sizeof(LocalBonePose));
+  EXPECT_LT(one_clip * 2U, every_clip);
+
+  ASSERT_NE(entry->skin_atlas->frame_palette(blob.clip(2U).frame_offset), nullptr);
+  EXPECT_EQ(blob.decoded_bytes(), one_clip);
+}
+
 TEST(RiggedMeshCache, DifferentSpeciesProduceDistinctEntries) {
   RiggedMeshCache cache;
 
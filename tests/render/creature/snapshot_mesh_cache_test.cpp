@@ -10,6 +10,8 @@
 #include <string>
 #include <vector>
 
+#include "animation/bpat/bpat_reader.h"
+#include "animation/bpat/bpat_writer.h"
 #include "render/bone_palette_arena.h"
 #include "render/creature/pipeline/creature_asset.h"
 #include "render/creature/render_request.h"
@@ -58,18 +60,22 @@ auto make_two_bone_quad_entry() -> std::unique_ptr<RiggedMeshEntry> {
   entry->mesh =
       std::make_unique<Render::GL::RiggedMesh>(std::move(vertices), std::move(indices));
 
+  std::vector<QMatrix4x4> palettes(4U);
+  palettes[0].translate(0.0F, 2.0F, 0.0F);
+  palettes[3].scale(3.0F);
+  Render::Creature::Bpat::BpatWriter writer(Render::Creature::Bpat::k_species_sheep,
+                                            2U);
+  writer.add_clip(Render::Creature::Bpat::ClipDescriptor{"idle", 2U});
+  writer.append_clip_palettes(palettes);
+  std::stringstream stream(std::ios::out | std::ios::binary | std::ios::in);
+  EXPECT_TRUE(writer.write(stream));
+  const std::string bytes = stream.str();
+  static Render::Creature::Bpat::BpatBlob blob;
+  blob = Render::Creature::Bpat::BpatBlob::from_bytes(
+      std::vector<std::uint8_t>(bytes.begin(), bytes.end()));
+
   entry->skin_atlas = std::make_shared<Render::GL::RiggedSkinAtlas>();
-  entry->skin_atlas->bone_count = 2U;
-  entry->skin_atlas->frame_total = 2U;
-  static std::vector<QMatrix4x4> palettes;
-  palettes.assign(4U, QMatrix4x4{});
-  QMatrix4x4 f0_b0;
-  f0_b0.translate(0.0F, 2.0F, 0.0F);
-  palettes[0] = f0_b0;
-  QMatrix4x4 f1_b1;
-  f1_b1.scale(3.0F);
-  palettes[3] = f1_b1;
-  entry->skin_atlas->palettes = palettes;
+  Render::GL::rigged_entry_ensure_skin_atlas_from_blob(*entry, blob);
 
   return entry;
 }
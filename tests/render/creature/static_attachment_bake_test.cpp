@@ -7,9 +7,13 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <span>
+#include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "animation/bpat/bpat_reader.h"
+#include "animation/bpat/bpat_writer.h"
 #include "render/creature/archetype_registry.h"
 #include "render/creature/part_graph.h"
 #include "render/creature/pipeline/creature_asset.h"
@@ -410,14 +414,18 @@ TEST(StaticAttachmentBake, SnapshotKeepsTheAttachmentsTheBodyCameWith) {
   source.attachment_meshes.push_back(std::make_shared<Render::GL::RiggedMesh>(
       attachment_vertices, attachment_indices));
 
-  auto palettes = std::make_shared<std::vector<QMatrix4x4>>(
-      std::vector<QMatrix4x4>(Render::Humanoid::k_bone_count));
+  auto const bone_count = static_cast<std::uint32_t>(Render::Humanoid::k_bone_count);
+  Bpat::BpatWriter writer(Bpat::k_species_humanoid, bone_count);
+  writer.add_clip(Bpat::ClipDescriptor{"idle", 1U});
+  writer.append_clip_palettes(std::vector<QMatrix4x4>(bone_count));
+  std::stringstream stream(std::ios::out | std::ios::binary | std::ios::in);
+  ASSERT_TRUE(writer.write(stream));
+  const std::string bytes = stream.str();
+  const auto blob =
+      Bpat::BpatBlob::from_bytes(std::vector<std::uint8_t>(bytes.begin(), bytes.end()));
+  ASSERT_TRUE(blob.loaded()) << blob.last_error();
   source.skin_atlas = std::make_shared<Render::GL::RiggedSkinAtlas>();
-  source.skin_atlas->palette_storage = palettes;
-  source.skin_atlas->palettes = *palettes;
-  source.skin_atlas->frame_total = 1U;
-  source.skin_atlas->bone_count =
-      static_cast<std::uint32_t>(Render::Humanoid::k_bone_count);
+  Render::GL::rigged_entry_ensure_skin_atlas_from_blob(source, blob);
 
   Render::GL::SnapshotMeshCache cache;
   Render::GL::SnapshotMeshCache::Key key{};
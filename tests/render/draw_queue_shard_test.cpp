@@ -0,0 +1,261 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+#include "render/draw_queue.h"
+#include "render/prepare_worker_pool.h"
+
+namespace {
+
+using Render::GL::DrawCmd;
+using Render::GL::DrawPartCmd;
+using Render::GL::DrawPartCmdIndex;
+using Render::GL::DrawQueue;
+using Render::GL::GroundMarkerCmd;
+using Render::GL::Material;
+using Render::GL::Mesh;
+using Render::GL::MeshCmd;
+using Render::GL::MeshCmdIndex;
+using Render::GL::Shader;
+using Render::GL::TerrainSurfaceCmd;
+using Render::GL::TerrainSurfaceRef;
+using Render::GL::Texture;
+
+constexpr std::uintptr_t k_heap_base = 0x7F3A12000000U;
+
+template <typename T> auto heap_ptr(std::uintptr_t slot) -> T* {
+  return reinterpret_cast<T*>(k_heap_base + slot * 0x1D0U);
+}
+
+auto make_command(std::size_t i) -> DrawCmd {
+  std::mt19937 rng(static_cast<std::uint32_t>(i * 2654435761U));
+  if (i % 97U == 0U) {
+    return GroundMarkerCmd{};
+  }
+  if (i % 5U == 0U) {
+    DrawPartCmd part;
+    part.mesh = heap_ptr<Mesh>(rng() % 24U);
+    part.material = heap_ptr<Material>(4096U + rng() % 6U);
+    part.texture = heap_ptr<Texture>(8192U + rng() % 4U);
+    return part;
+  }
+  MeshCmd mesh;
+  mesh.mesh = heap_ptr<Mesh>(rng() % 40U);
+  mesh.shader = heap_ptr<Shader>(12288U + rng() % 3U);
+  mesh.texture = heap_ptr<Texture>(8192U + rng() % 9U);
+  mesh.alpha = rng() % 11U == 0U ? 0.5F : 1.0F;
+  return mesh;
+}
+
+void submit_command(DrawQueue& queue, std::size_t i) {
+  std::visit([&](auto&& cmd) { queue.submit(cmd); }, make_command(i));
+}
+
+auto resource_identity(const DrawCmd& cmd) -> std::array<std::uintptr_t, 4> {
+  const auto value = [](const void* ptr) {
+    return reinterpret_cast<std::uintptr_t>(ptr);
+  };
+  if (cmd.index() == MeshCmdIndex) {
+    const auto& mesh = std::get<MeshCmdIndex>(cmd);
+    return {value(mesh.shader), value(mesh.mesh), value(mesh.texture), 0U};
+  }
+  if (cmd.index() == DrawPartCmdIndex) {
+    const auto& part = std::get<DrawPartCmdIndex>(cmd);
+    return {value(part.material), value(part.mesh), value(part.texture), 0U};
+  }
+  return {0U, 0U, 0U, 0U};
+}
+
+auto sorted_item_indices(const DrawQueue& queue) -> std::vector<std::size_t> {
+  std::vector<std::size_t> indices;
+  indices.reserve(queue.size());
+  for (std::size_t i = 0; i < queue.size(); ++i) {
+    indices.push_back(static_cast<std::size_t>(&queue.get_sorted(i) -
+                                               queue.items().data()));
+  }
+  return indices;
+}
+
+void expect_same_batches(const DrawQueue& actual_queue,
+                         const DrawQueue& expected_queue) {
+  const auto& expected = expected_queue.prepared_batches();
+  const auto& actual = actual_queue.prepared_batches();
+  ASSERT_EQ(actual.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(actual[i].start, expected[i].start);
+    EXPECT_EQ(actual[i].count, expected[i].count);
+    EXPECT_EQ(actual[i].type, expected[i].type);
+    EXPECT_EQ(actual[i].kind, expected[i].kind);
+    EXPECT_EQ(actual[i].sort_key, expected[i].sort_key);
+  }
+}
+
+TEST(DrawQueueShards, RadixOrderMatchesKeyThenResourceThenSubmission) {
+  DrawQueue queue;
+  TerrainSurfaceCmd terrain;
+  terrain.mesh = heap_ptr<Mesh>(1U);
+  queue.submit(terrain);
+  for (std::size_t i = 0; i < 6000U; ++i) {
+    submit_command(queue, i);
+  }
+  queue.sort_for_batching();
+
+  const std::vector<std::size_t> order = sorted_item_indices(queue);
+  for (std::size_t i = 1; i < order.size(); ++i) {
+    const auto lhs = std::make_tuple(queue.sort_key_for_sorted(i - 1U),
+                                     resource_identity(queue.items()[order[i - 1U]]),
+                                     order[i - 1U]);
+    const auto rhs = std::make_tuple(queue.sort_key_for_sorted(i),
+                                     resource_identity(queue.items()[order[i]]),
+                                     order[i]);
+    ASSERT_LT(lhs, rhs) << "sorted position " << i;
+  }
+}
+
+TEST(DrawQueueShards, MergedShardsBatchExactlyLikeSerialSubmission) {
+  constexpr std::size_t k_commands = 30000;
+  constexpr std::size_t k_shards = 8;
+
+  DrawQueue serial;
+  for (std::size_t i = 0; i < k_commands; ++i) {
+    submit_command(serial, i);
+  }
+  serial.sort_for_batching();
+
+  std::vector<DrawQueue> shards(k_shards);
+  Render::PrepareWorkerPool pool;
+  pool.run(k_shards, [&](std::size_t shard) {
+    const std::size_t begin = k_commands * shard / k_shards;
+    const std::size_t end = k_commands * (shard + 1U) / k_shards;
+    for (std::size_t i = begin; i < end; ++i) {
+      submit_command(shards[shard], i);
+    }
+  });
+
+  DrawQueue merged;
+  merged.merge_shards(shards);
+  merged.sort_for_batching();
+
+  for (const DrawQueue& shard : shards) {
+    EXPECT_TRUE(shard.empty());
+  }
+  ASSERT_EQ(merged.size(), serial.size());
+  EXPECT_EQ(sorted_item_indices(merged), sorted_item_indices(serial));
+
+  expect_same_batches(merged, serial);
+}
+
+TEST(DrawQueueShards, RadixSortedRangesBatchLikeStableSort) {
+  for (const std::size_t count : {257U, 1000U, 6000U}) {
+    SCOPED_TRACE(count);
+    DrawQueue radix;
+    for (std::size_t i = 0; i < count; ++i) {
+      submit_command(radix, i);
+    }
+    radix.sort_for_batching();
+
+    const std::vector<std::size_t> radix_order = sorted_item_indices(radix);
+    std::vector<std::uint64_t> keys(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      keys[radix_order[i]] = radix.sort_key_for_sorted(i);
+    }
+
+    // The comparator the radix sort replaced, over the same packed keys.
+    std::vector<std::size_t> stable_order(count);
+    std::iota(stable_order.begin(), stable_order.end(), std::size_t{0});
+    std::stable_sort(stable_order.begin(),
+                     stable_order.end(),
+                     [&](std::size_t lhs, std::size_t rhs) {
+                       if (keys[lhs] != keys[rhs]) {
+                         return keys[lhs] < keys[rhs];
+                       }
+                       return resource_identity(radix.items()[lhs]) <
+                              resource_identity(radix.items()[rhs]);
+                     });
+    EXPECT_EQ(radix_order, stable_order);
+
+    // Submitted pre-sorted, no sort can move anything, so its batches are the
+    // ones std::stable_sort would have produced.
+    DrawQueue presorted;
+    for (const std::size_t i : stable_order) {
+      std::visit([&](const auto& cmd) { presorted.submit(cmd); }, radix.items()[i]);
+    }
+    presorted.sort_for_batching();
+    expect_same_batches(radix, presorted);
+  }
+}
+
+TEST(DrawQueueShards, StagedSlicesKeyedInShardsBatchLikeSerialSubmission) {
+  constexpr std::size_t k_commands = 12000;
+  constexpr std::size_t k_shards = 4;
+
+  DrawQueue serial;
+  DrawQueue staging;
+  staging.set_keyed(false);
+  for (DrawQueue* queue : {&serial, &staging}) {
+    TerrainSurfaceCmd terrain;
+    terrain.mesh = heap_ptr<Mesh>(3U);
+    queue->submit(terrain);
+    for (std::size_t i = 0; i < k_commands; ++i) {
+      submit_command(*queue, i);
+    }
+  }
+  serial.sort_for_batching();
+
+  std::vector<DrawQueue> shards(k_shards);
+  Render::PrepareWorkerPool pool;
+  pool.run(k_shards, [&](std::size_t shard) {
+    shards[shard].submit_staged(staging,
+                                staging.size() * shard / k_shards,
+                                staging.size() * (shard + 1U) / k_shards);
+  });
+
+  DrawQueue merged;
+  merged.merge_shards(shards);
+  merged.sort_for_batching();
+
+  ASSERT_EQ(merged.size(), serial.size());
+  EXPECT_EQ(sorted_item_indices(merged), sorted_item_indices(serial));
+  expect_same_batches(merged, serial);
+  const auto* ref = std::get_if<TerrainSurfaceRef>(&merged.items().front());
+  ASSERT_NE(ref, nullptr);
+  EXPECT_EQ(merged.terrain_surface(*ref).mesh, heap_ptr<Mesh>(3U));
+}
+
+TEST(DrawQueueShards, TerrainSurfacesFollowTheirRefsThroughMerge) {
+  std::vector<DrawQueue> shards(3);
+  for (std::size_t shard = 0; shard < shards.size(); ++shard) {
+    for (std::size_t chunk = 0; chunk < 2U; ++chunk) {
+      TerrainSurfaceCmd terrain;
+      terrain.mesh = heap_ptr<Mesh>(shard * 2U + chunk);
+      terrain.sort_key = static_cast<std::uint32_t>(shard * 2U + chunk);
+      shards[shard].submit(terrain);
+    }
+    submit_command(shards[shard], shard + 1U);
+  }
+
+  DrawQueue merged;
+  merged.merge_shards(shards);
+  merged.sort_for_batching();
+
+  std::vector<const Mesh*> meshes;
+  for (std::size_t i = 0; i < merged.size(); ++i) {
+    const auto* ref = std::get_if<TerrainSurfaceRef>(&merged.get_sorted(i));
+    if (ref != nullptr) {
+      meshes.push_back(merged.terrain_surface(*ref).mesh);
+    }
+  }
+  ASSERT_EQ(meshes.size(), 6U);
+  for (std::size_t i = 0; i < meshes.size(); ++i) {
+    EXPECT_EQ(meshes[i], heap_ptr<Mesh>(i));
+  }
+}
+
+} // namespace
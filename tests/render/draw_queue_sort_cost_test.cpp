@@ -12,6 +12,7 @@
 
 namespace {
 
+using Render::GL::DrawCmd;
 using Render::GL::DrawQueue;
 using Render::GL::GroundMarkerCmd;
 using Render::GL::Mesh;
@@ -133,4 +134,38 @@ TEST(DrawQueueSortCost, ReportsSortCostAcrossQueueSizes) {
   EXPECT_GT(at_100k, 0.0);
 }
 
+TEST(DrawQueueSortCost, ReportsCommandFootprintAndFillCost) {
+  static_assert(sizeof(DrawCmd) < sizeof(TerrainSurfaceCmd),
+                "terrain surfaces live beside the queue, not in every variant slot");
+
+  DrawQueue queue;
+  fill_frame(queue, 30000);
+  queue.sort_for_batching();
+
+  std::vector<double> fill_samples;
+  std::vector<double> sort_samples;
+  for (int i = 0; i < 10; ++i) {
+    const auto fill_started = std::chrono::steady_clock::now();
+    fill_frame(queue, 30000);
+    const auto sort_started = std::chrono::steady_clock::now();
+    queue.sort_for_batching();
+    const auto finished = std::chrono::steady_clock::now();
+    fill_samples.push_back(
+        std::chrono::duration<double, std::milli>(sort_started - fill_started).count());
+    sort_samples.push_back(
+        std::chrono::duration<double, std::milli>(finished - sort_started).count());
+  }
+  std::sort(fill_samples.begin(), fill_samples.end());
+  std::sort(sort_samples.begin(), sort_samples.end());
+
+  std::printf("draw command footprint: %zu bytes per slot (terrain surface %zu)\n"
+              "30,080 commands  fill %.3f ms  sort %.3f ms\n",
+              sizeof(DrawCmd),
+              sizeof(TerrainSurfaceCmd),
+              fill_samples[fill_samples.size() / 2U],
+              sort_samples[sort_samples.size() / 2U]);
+
+  EXPECT_EQ(queue.size(), 30000U + 16U + 64U);
+}
+
 } // namespace
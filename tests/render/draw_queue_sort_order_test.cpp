@@ -22,6 +22,7 @@ using Render::GL::TerrainFeatureCmd;
 using Render::GL::TerrainFeatureCmdIndex;
 using Render::GL::TerrainSurfaceCmd;
 using Render::GL::TerrainSurfaceCmdIndex;
+using Render::GL::TerrainSurfaceRef;
 using Render::GL::Texture;
 
 TEST(DrawQueueSortOrder, TerrainBeforeMeshBeforeGroundMarker) {
@@ -368,7 +369,7 @@ TEST(DrawQueueCommandTypes, IndexConstantsFollowTheVariantAlternatives) {
                      GroundMarkerCmd>);
   static_assert(
       std::is_same_v<std::variant_alternative_t<TerrainSurfaceCmdIndex, DrawCmd>,
-                     TerrainSurfaceCmd>);
+                     TerrainSurfaceRef>);
   static_assert(
       std::is_same_v<std::variant_alternative_t<TerrainFeatureCmdIndex, DrawCmd>,
                      TerrainFeatureCmd>);
@@ -1,4 +1,11 @@
+#include <QDir>
+#include <QStandardPaths>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QVector4D>
+
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <gtest/gtest.h>
 
@@ -15,6 +22,7 @@
 #include "render/ground/olive_renderer.h"
 #include "render/ground/pine_renderer.h"
 #include "render/ground/plant_renderer.h"
+#include "render/ground/scatter_generation.h"
 #include "render/ground/scatter_renderer_state.h"
 #include "render/ground/scatter_runtime.h"
 #include "render/ground/stone_renderer.h"
@@ -55,6 +63,34 @@ auto make_tree_map_definition(Game::Map::GroundType ground_type,
   return map_def;
 }
 
+// Points the scatter cache at an empty directory for the scope of a test, so a
+// layout left behind by an earlier run can never stand in for a fresh one.
+class ScopedScatterCache {
+public:
+  ScopedScatterCache() { Render::Ground::Scatter::set_cache_directory(m_dir.path()); }
+  ~ScopedScatterCache() {
+    Render::Ground::Scatter::set_cache_directory({});
+    Render::Ground::Scatter::set_generation_worker_count(std::nullopt);
+  }
+
+  ScopedScatterCache(const ScopedScatterCache&) = delete;
+  auto operator=(const ScopedScatterCache&) -> ScopedScatterCache& = delete;
+
+  [[nodiscard]] auto files(const QString& kind) const -> QStringList {
+    return QDir(m_dir.path()).entryList({kind + QStringLiteral("-*.bin")}, QDir::Files);
+  }
+
+private:
+  QTemporaryDir m_dir;
+};
+
+template <typename Instance>
+auto same_bytes(const std::vector<Instance>& a,
+                const std::vector<Instance>& b) -> bool {
+  return a.size() == b.size() &&
+         std::memcmp(a.data(), b.data(), a.size() * sizeof(Instance)) == 0;
+}
+
 TEST(ScatterRuntimeTest, DirectUploadDecisionRequiresDirtyOrMissingBuffer) {
   using Render::Ground::Scatter::direct_needs_buffer_upload;
 
@@ -199,6 +235,119 @@ TEST(ScatterRuntimeTest, BiomeRendererConfiguresLargeTerrainWithoutReallocationC
   EXPECT_GT(renderer.instance_count(), 0U);
 }
 
+TEST(ScatterRuntimeTest, InstanceCacheRoundTripsAndMissesOnAnotherKey) {
+  QStandardPaths::setTestModeEnabled(true);
+  using Render::Ground::Scatter::InstanceCacheKey;
+
+  InstanceCacheKey key("cache_test");
+  key.add(42);
+  std::vector<Render::GL::GrassInstanceGpu> instances(3);
+  instances[1].pos_height = QVector4D(1.0F, 2.0F, 3.0F, 4.0F);
+  Render::Ground::Scatter::store_cached_instances(key, instances);
+
+  std::vector<Render::GL::GrassInstanceGpu> loaded;
+  ASSERT_TRUE(Render::Ground::Scatter::load_cached_instances(key, loaded));
+  ASSERT_EQ(loaded.size(), instances.size());
+  EXPECT_EQ(loaded[1].pos_height, instances[1].pos_height);
+
+  InstanceCacheKey other("cache_test");
+  other.add(43);
+  EXPECT_NE(other.file_name(), key.file_name());
+  EXPECT_FALSE(Render::Ground::Scatter::load_cached_instances(other, loaded));
+}
+
+TEST(ScatterRuntimeTest, CachedGrassMatchesFreshlyGeneratedGrass) {
+  const ScopedScatterCache cache;
+  Game::Map::TerrainHeightMap const height_map(96, 96, 1.0F);
+  Game::Map::BiomeSettings biome_settings;
+  biome_settings.seed = 9001U;
+
+  Render::GL::BiomeRenderer fresh;
+  fresh.set_world_view(Render::WorldView::of_active_session());
+  fresh.configure(height_map, biome_settings);
+  ASSERT_GT(fresh.instance_count(), 0U);
+  ASSERT_EQ(cache.files(QStringLiteral("grass")).size(), 1);
+
+  Render::GL::BiomeRenderer cached;
+  cached.set_world_view(Render::WorldView::of_active_session());
+  cached.configure(height_map, biome_settings);
+
+  EXPECT_TRUE(
+      same_bytes(cached.grass_instances_for_test(), fresh.grass_instances_for_test()));
+}
+
+TEST(ScatterRuntimeTest, GrassIsIdenticalForOneWorkerAndMany) {
+  Game::Map::TerrainHeightMap const height_map(128, 128, 1.0F);
+  Game::Map::BiomeSettings biome_settings;
+  biome_settings.seed = 717U;
+
+  auto generate = [&](std::size_t workers) {
+    const ScopedScatterCache cache;
+    Render::Ground::Scatter::set_generation_worker_count(workers);
+    Render::GL::BiomeRenderer renderer;
+    renderer.set_world_view(Render::WorldView::of_active_session());
+    renderer.configure(height_map, biome_settings);
+    return renderer.grass_instances_for_test();
+  };
+
+  const auto single = generate(1);
+  const auto many = generate(4);
+  ASSERT_GT(single.size(), 0U);
+  EXPECT_TRUE(same_bytes(single, many));
+}
+
+TEST(ScatterRuntimeTest, StonePlantAndBoulderScatterComeBackFromTheDiskCache) {
+  const ScopedScatterCache cache;
+  Game::Map::TerrainHeightMap const height_map(96, 96, 1.0F);
+  Game::Map::BiomeSettings biome_settings;
+  Game::Map::apply_ground_type_defaults(biome_settings,
+                                        Game::Map::GroundType::SoilRocky);
+  biome_settings.seed = 4242U;
+  biome_settings.rock_exposure = 0.85F;
+  biome_settings.moisture_level = 0.20F;
+  biome_settings.plant_density = 0.35F;
+
+  Game::Map::WorldProp plant;
+  plant.type = Game::Map::WorldProp::Type::Plant;
+  plant.x = 30.0F;
+  plant.z = 41.0F;
+  std::vector<Game::Map::WorldProp> const props{plant};
+  std::vector<Game::Map::WorldProp> const no_props;
+
+  auto stones = [&] {
+    Render::GL::StoneRenderer renderer;
+    renderer.set_world_view(Render::WorldView::of_active_session());
+    renderer.configure(height_map, biome_settings, no_props);
+    return renderer.instances_for_test();
+  };
+  auto plants = [&] {
+    Render::GL::PlantRenderer renderer;
+    renderer.set_world_view(Render::WorldView::of_active_session());
+    renderer.configure(height_map, biome_settings, props);
+    return renderer.instances_for_test();
+  };
+  auto boulders = [&] {
+    Render::GL::BoulderRenderer renderer;
+    renderer.set_world_view(Render::WorldView::of_active_session());
+    renderer.configure(height_map, biome_settings, no_props, no_props);
+    return renderer.instances_for_test();
+  };
+
+  const auto fresh_stones = stones();
+  const auto fresh_plants = plants();
+  const auto fresh_boulders = boulders();
+  ASSERT_GT(fresh_stones.size(), 0U);
+  ASSERT_GT(fresh_plants.size(), 0U);
+  ASSERT_GT(fresh_boulders.size(), 0U);
+  EXPECT_EQ(cache.files(QStringLiteral("stone")).size(), 1);
+  EXPECT_EQ(cache.files(QStringLiteral("plant")).size(), 1);
+  EXPECT_EQ(cache.files(QStringLiteral("boulder")).size(), 1);
+
+  EXPECT_TRUE(same_bytes(stones(), fresh_stones));
+  EXPECT_TRUE(same_bytes(plants(), fresh_plants));
+  EXPECT_TRUE(same_bytes(boulders(), fresh_boulders));
+}
+
 TEST(ScatterRuntimeTest, LargeRockyMapsGetProceduralBouldersAndLogs) {
   Game::Map::TerrainHeightMap const height_map(96, 96, 1.0F);
   Game::Map::BiomeSettings biome_settings;
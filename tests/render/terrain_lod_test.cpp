@@ -0,0 +1,211 @@
+#include <QMatrix4x4>
+#include <QVector3D>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "render/ground/terrain_lod.h"
+
+namespace {
+
+using Render::GL::build_terrain_lod_grid;
+using Render::GL::TerrainLodArea;
+using Render::GL::TerrainLodFrustum;
+using Render::GL::TerrainLodReport;
+using Render::GL::TerrainLodTree;
+using Render::GL::TerrainLodView;
+using Render::GL::terrain_lod_triangles;
+
+constexpr int k_map_size = 257;
+
+auto rolling_heights(int size) -> std::vector<float> {
+  std::vector<float> heights(static_cast<std::size_t>(size) *
+                             static_cast<std::size_t>(size));
+  for (int z = 0; z < size; ++z) {
+    for (int x = 0; x < size; ++x) {
+      heights[static_cast<std::size_t>(z * size + x)] =
+          2.0F * std::sin(static_cast<float>(x) * 0.07F) *
+          std::cos(static_cast<float>(z) * 0.05F);
+    }
+  }
+  return heights;
+}
+
+auto camera_view(const QVector3D& eye, const QVector3D& target) -> TerrainLodView {
+  QMatrix4x4 view_projection;
+  view_projection.perspective(45.0F, 16.0F / 9.0F, 1.0F, 200.0F);
+  view_projection.lookAt(eye, target, QVector3D(0.0F, 1.0F, 0.0F));
+  TerrainLodView view;
+  view.eye = eye;
+  view.frustum = TerrainLodFrustum::from_view_projection(view_projection);
+  return view;
+}
+
+// LOD level per leaf chunk, -1 where nothing was selected; fails on overlap.
+auto leaf_levels(const TerrainLodTree& tree,
+                 const std::vector<TerrainLodArea>& areas) -> std::vector<int> {
+  std::vector<int> levels(static_cast<std::size_t>(tree.leaves_x() * tree.leaves_z()),
+                          -1);
+  const int leaf = tree.leaf_quads();
+  for (const auto& area : areas) {
+    EXPECT_EQ(area.min_x % leaf, 0);
+    EXPECT_EQ(area.min_z % leaf, 0);
+    for (int z = area.min_z / leaf; z * leaf < area.max_z; ++z) {
+      for (int x = area.min_x / leaf; x * leaf < area.max_x; ++x) {
+        auto& slot = levels[static_cast<std::size_t>(z * tree.leaves_x() + x)];
+        EXPECT_EQ(slot, -1) << "leaf " << x << "," << z << " selected twice";
+        slot = area.level;
+      }
+    }
+  }
+  return levels;
+}
+
+TEST(TerrainLodGrid, EachLevelDrawsAQuarterOfTheTrianglesOfTheLevelBelow) {
+  for (int level = 0; level < 5; ++level) {
+    const int step = 1 << level;
+    const auto grid = build_terrain_lod_grid(16, 16, step);
+    EXPECT_EQ(grid.size(), 6U * static_cast<std::size_t>((16 / step) * (16 / step)));
+    EXPECT_EQ(grid.size() / 3U, terrain_lod_triangles(16, 16, level));
+    EXPECT_EQ(*std::max_element(grid.begin(), grid.end()), 17U * 17U - 1U);
+  }
+}
+
+TEST(TerrainLodGrid, PartialLeavesClipTheLastRowAndColumn) {
+  const auto grid = build_terrain_lod_grid(5, 3, 2);
+  ASSERT_EQ(grid.size(), 6U * 3U * 2U);
+  EXPECT_EQ(terrain_lod_triangles(5, 3, 1), 12U);
+
+  // The last quad of the first row spans the single leftover column.
+  const auto vertex = [](int x, int z) { return static_cast<unsigned>(z * 6 + x); };
+  const std::vector<unsigned int> last_in_row(grid.begin() + 12, grid.begin() + 18);
+  EXPECT_EQ(last_in_row,
+            (std::vector<unsigned int>{vertex(4, 0),
+                                       vertex(5, 0),
+                                       vertex(4, 2),
+                                       vertex(4, 2),
+                                       vertex(5, 0),
+                                       vertex(5, 2)}));
+}
+
+TEST(TerrainLodTree, CoversTheWholeMapOnceWithNeighboursAtMostOneLevelApart) {
+  const auto heights = rolling_heights(k_map_size);
+  TerrainLodTree tree;
+  tree.build(heights, k_map_size, k_map_size, 1.0F);
+  ASSERT_EQ(tree.levels(), 5);
+  ASSERT_EQ(tree.leaves_x(), 16);
+
+  TerrainLodView view;
+  view.eye = QVector3D(-60.0F, 30.0F, -40.0F);
+  std::vector<TerrainLodArea> areas;
+  TerrainLodReport report;
+  tree.select(view, areas, &report);
+
+  const auto levels = leaf_levels(tree, areas);
+  for (int z = 0; z < tree.leaves_z(); ++z) {
+    for (int x = 0; x < tree.leaves_x(); ++x) {
+      const int level = levels[static_cast<std::size_t>(z * tree.leaves_x() + x)];
+      ASSERT_GE(level, 0) << "leaf " << x << "," << z << " left a hole";
+      if (x + 1 < tree.leaves_x()) {
+        EXPECT_LE(std::abs(level - levels[static_cast<std::size_t>(z * 16 + x + 1)]),
+                  1);
+      }
+      if (z + 1 < tree.leaves_z()) {
+        EXPECT_LE(std::abs(level - levels[static_cast<std::size_t>((z + 1) * 16 + x)]),
+                  1);
+      }
+    }
+  }
+  EXPECT_EQ(report.full_density_triangles, 2U * 256U * 256U);
+  EXPECT_EQ(report.culled_nodes, 0U);
+  EXPECT_EQ(report.areas, areas.size());
+
+  // The leaf under the eye is at full density, the far corner is not.
+  EXPECT_EQ(levels[static_cast<std::size_t>(5 * 16 + 4)], 0);
+  EXPECT_GT(levels[static_cast<std::size_t>(15 * 16 + 15)], 1);
+}
+
+TEST(TerrainLodTree, MorphBandsEndWhereTheNextLevelTakesOver) {
+  const auto heights = rolling_heights(k_map_size);
+  TerrainLodTree tree;
+  tree.build(heights, k_map_size, k_map_size, 1.0F);
+
+  TerrainLodView view;
+  view.eye = QVector3D(0.0F, 20.0F, 0.0F);
+  std::vector<TerrainLodArea> areas;
+  tree.select(view, areas);
+  for (const auto& area : areas) {
+    if (area.level + 1 == tree.levels()) {
+      EXPECT_EQ(area.morph_end, 0.0F);
+      continue;
+    }
+    const float floor = area.level > 0 ? tree.range(area.level - 1) : 0.0F;
+    EXPECT_FLOAT_EQ(area.morph_end, tree.range(area.level));
+    EXPECT_GT(area.morph_start, floor);
+    EXPECT_LT(area.morph_start, area.morph_end);
+  }
+}
+
+TEST(TerrainLodTree, ZoomedOutViewDrawsAFractionOfTheFullDensityTriangles) {
+  const auto heights = rolling_heights(k_map_size);
+  TerrainLodTree tree;
+  tree.build(heights, k_map_size, k_map_size, 1.0F);
+
+  std::vector<TerrainLodArea> areas;
+  TerrainLodReport report;
+  tree.select(camera_view(QVector3D(0.0F, 70.0F, 110.0F), QVector3D(0.0F, 0.0F, 0.0F)),
+              areas,
+              &report);
+
+  EXPECT_GT(report.culled_nodes, 0U);
+  EXPECT_GT(report.triangles, 0U);
+  EXPECT_LT(report.triangles * 4U, report.full_density_triangles);
+  EXPECT_EQ(report.areas_per_level[0], 0U);
+  std::size_t per_level_total = 0;
+  for (const std::size_t triangles : report.triangles_per_level) {
+    per_level_total += triangles;
+  }
+  EXPECT_EQ(per_level_total, report.triangles);
+}
+
+TEST(TerrainLodTree, CullsTheTerrainBehindTheCamera) {
+  const auto heights = rolling_heights(k_map_size);
+  TerrainLodTree tree;
+  tree.build(heights, k_map_size, k_map_size, 1.0F);
+
+  std::vector<TerrainLodArea> areas;
+  tree.select(camera_view(QVector3D(0.0F, 25.0F, 0.0F), QVector3D(0.0F, 0.0F, -40.0F)),
+              areas);
+  const auto levels = leaf_levels(tree, areas);
+
+  // Looking toward -z, so the rows at the +z edge are out of view.
+  for (int x = 0; x < tree.leaves_x(); ++x) {
+    EXPECT_EQ(levels[static_cast<std::size_t>(15 * 16 + x)], -1) << "leaf " << x;
+  }
+  EXPECT_EQ(levels[static_cast<std::size_t>(6 * 16 + 8)], 0);
+}
+
+TEST(TerrainLodTree, FlatMapSmallerThanALeafStillSelectsIt) {
+  const std::vector<float> heights(9U * 5U, 0.0F);
+  TerrainLodTree tree;
+  tree.build(heights, 9, 5, 1.0F);
+  ASSERT_EQ(tree.leaves_x(), 1);
+  ASSERT_EQ(tree.leaves_z(), 1);
+
+  TerrainLodView view;
+  view.eye = QVector3D(0.0F, 5.0F, 0.0F);
+  std::vector<TerrainLodArea> areas;
+  TerrainLodReport report;
+  tree.select(view, areas, &report);
+  ASSERT_EQ(areas.size(), 1U);
+  EXPECT_EQ(areas[0].max_x, 8);
+  EXPECT_EQ(areas[0].max_z, 4);
+  EXPECT_EQ(areas[0].level, 0);
+  EXPECT_EQ(report.triangles, 2U * 8U * 4U);
+}
+
+} // namespace
@@ -219,3 +219,75 @@ TEST(SnapshotContractTest, RenderSnapshotSplitMatchesTheContract) {
            "state; move it to copy_authoritative_snapshot_components";
   }
 }
+
+namespace {
+
+auto world_snapshot_source() -> std::string {
+  return read_text(find_repo_root() / "game" / "save" / "world_snapshot.cpp");
+}
+
+auto world_snapshot_specializations() -> std::set<std::string> {
+  const auto source = world_snapshot_source();
+  const std::regex pattern(R"(struct Column<([A-Za-z0-9_]+)> \{)");
+  std::set<std::string> names;
+  for (auto it = std::sregex_iterator(source.begin(), source.end(), pattern);
+       it != std::sregex_iterator();
+       ++it) {
+    names.insert((*it)[1].str());
+  }
+  return names;
+}
+
+auto world_snapshot_columns() -> std::vector<std::string> {
+  const auto source = world_snapshot_source();
+  const auto start = source.find("using SnapshotColumns = std::tuple<");
+  if (start == std::string::npos) {
+    return {};
+  }
+  const auto end = source.find(">;", start);
+  const std::string list = source.substr(start, end - start);
+  const std::regex pattern(R"(([A-Za-z0-9_]+Component))");
+  std::vector<std::string> names;
+  for (auto it = std::sregex_iterator(list.begin(), list.end(), pattern);
+       it != std::sregex_iterator();
+       ++it) {
+    names.push_back((*it)[1].str());
+  }
+  return names;
+}
+
+} // namespace
+
+TEST(SnapshotContractTest, WorldSnapshotColumnsMatchTheContract) {
+  const auto columns = world_snapshot_columns();
+  const auto specializations = world_snapshot_specializations();
+  ASSERT_FALSE(columns.empty()) << "world_snapshot.cpp could not be scanned";
+
+  std::set<std::string> listed;
+  for (const auto& name : columns) {
+    EXPECT_TRUE(listed.insert(name).second) << name << " is listed twice";
+    EXPECT_TRUE(specializations.contains(name))
+        << name << " is in SnapshotColumns but has no Column<> specialization";
+    const auto* spec = Game::Save::find(name.c_str());
+    ASSERT_NE(spec, nullptr) << name << " is not in the snapshot contract";
+    EXPECT_EQ(spec->classification, FieldClass::AuthoritativeSerialized)
+        << name << " is " << Game::Save::field_class_name(spec->classification)
+        << " but the binary world snapshot stores it.";
+  }
+  for (const auto& name : specializations) {
+    EXPECT_TRUE(listed.contains(name))
+        << "Column<" << name << "> is never captured; add it to SnapshotColumns.";
+  }
+
+  for (const auto& spec : Game::Save::fields()) {
+    const std::string name = spec.name;
+    if (spec.classification != FieldClass::AuthoritativeSerialized ||
+        name.find('.') != std::string::npos) {
+      continue;
+    }
+    EXPECT_TRUE(listed.contains(name))
+        << name
+        << " is authoritative-serialized but has no world snapshot column, so "
+           "binary saves silently drop it.";
+  }
+}
@@ -0,0 +1,659 @@
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "core/component.h"
+#include "core/world.h"
+#include "map/terrain_service.h"
+#include "save/serialization.h"
+#include "save/snapshot_contract.h"
+#include "save/world_snapshot.h"
+#include "tests/support/movement_test_access.h"
+#include "units/spawn_type.h"
+#include "units/troop_type.h"
+#include "wildlife/wildlife_species.h"
+
+using namespace Engine::Core;
+
+namespace {
+
+class WorldSnapshotTest : public ::testing::Test {
+protected:
+  void SetUp() override { world = std::make_unique<World>(); }
+
+  void TearDown() override {
+    Game::Map::TerrainService::instance().clear();
+    world.reset();
+  }
+
+  // Every component here carries values that differ from its defaults, so a
+  // field the snapshot drops shows up in the JSON comparison.
+  void populate(int count) {
+    for (int i = 1; i <= count; ++i) {
+      auto* entity = world->create_entity();
+      const auto f = static_cast<float>(i);
+
+      auto* transform = entity->add_component<TransformComponent>();
+      transform->position = {0.5F * f, 0.25F, -1.25F * f};
+      transform->rotation.y = 0.1F * f;
+      transform->has_desired_yaw = (i % 2) == 0;
+      transform->desired_yaw = 3.0F * f;
+
+      auto* unit = entity->add_component<UnitComponent>(100 - i, 120, 2.5F, 14.0F);
+      unit->owner_id = i % 3;
+      unit->spawn_type = (i % 2) == 0 ? Game::Units::SpawnType::Spearman
+                                      : Game::Units::SpawnType::Archer;
+
+      auto* renderable = entity->add_component<RenderableComponent>();
+      renderable->renderer_id = "troops/unit_" + std::to_string(i);
+      renderable->visible = (i % 5) != 0;
+
+      if (i % 3 == 0) {
+        auto* attack = entity->add_component<AttackComponent>(9.0F, 7 + i, 1.5F);
+        attack->time_since_last = 0.25F * f;
+        attack->in_melee_lock = true;
+        attack->melee_lock_target_id = static_cast<EntityID>(i - 1);
+      }
+      if (i % 4 == 0) {
+        auto* movement = entity->add_component<MovementComponent>();
+        MovementTestAccess::set_has_target(*movement, true);
+        MovementTestAccess::set_target_x(*movement, f);
+        MovementTestAccess::set_target_y(*movement, -f);
+        MovementTestAccess::set_goal_x(*movement, 2.0F * f);
+        MovementTestAccess::set_goal_y(*movement, -2.0F * f);
+        MovementTestAccess::set_vx(*movement, 0.75F);
+        MovementTestAccess::set_path(*movement, {{1.0F, 2.0F}, {3.5F, 4.0F}});
+        MovementTestAccess::set_path_index(*movement, 1);
+      }
+      if (i % 7 == 0) {
+        auto* patrol = entity->add_component<PatrolComponent>();
+        patrol->waypoints = {{f, 0.0F}, {0.0F, f}, {f, f}};
+        patrol->current_waypoint = 2;
+        patrol->patrolling = true;
+      }
+      if (i % 8 == 0) {
+        entity->add_component<BuildingComponent>();
+        auto* production = entity->add_component<ProductionComponent>();
+        production->in_progress = true;
+        production->time_remaining = 4.5F;
+        production->production_queue = {Game::Units::TroopType::Spearman,
+                                        Game::Units::TroopType::Archer};
+        entity->add_component<AIControlledComponent>();
+      }
+      if (i % 6 == 0) {
+        auto* stamina = entity->add_component<StaminaComponent>();
+        stamina->stamina = 40.0F;
+        stamina->is_running = true;
+      }
+    }
+  }
+
+  // One entity carrying every saved column, each with values that differ from
+  // its defaults. A field a column drops comes back default after a restore.
+  void populate_every_column() {
+    auto* soldier = world->create_entity();
+    auto* transform = soldier->add_component<TransformComponent>();
+    transform->position = {4.0F, 0.5F, -6.0F};
+    transform->rotation = {0.1F, 1.2F, 0.3F};
+    transform->scale = {1.5F, 1.5F, 1.5F};
+    transform->has_desired_yaw = true;
+    transform->desired_yaw = 42.0F;
+
+    auto* renderable = soldier->add_component<RenderableComponent>();
+    renderable->renderer_id = "troops/roman/swordsman";
+    renderable->visible = false;
+
+    auto* unit = soldier->add_component<UnitComponent>(80, 140, 3.25F, 17.0F);
+    unit->spawn_type = Game::Units::SpawnType::Knight;
+    unit->owner_id = 2;
+    unit->nation_id = Game::Systems::NationID::Carthage;
+    unit->uses_nation_formation_profile = true;
+    unit->render_individuals_per_unit_override = 9;
+    unit->render_rider = false;
+    unit->death_sequence_override = 3;
+
+    auto* movement = soldier->add_component<MovementComponent>();
+    MovementTestAccess::set_has_target(*movement, true);
+    MovementTestAccess::set_target_x(*movement, 7.0F);
+    MovementTestAccess::set_target_y(*movement, -3.0F);
+    MovementTestAccess::set_goal_x(*movement, 9.0F);
+    MovementTestAccess::set_goal_y(*movement, -5.0F);
+    MovementTestAccess::set_vx(*movement, 0.75F);
+    MovementTestAccess::set_path(*movement, {{1.0F, 2.0F}, {3.5F, 4.0F}});
+    MovementTestAccess::set_path_index(*movement, 1);
+
+    auto* order = soldier->add_component<PlayerOrderIntentComponent>();
+    order->kind = PlayerOrderIntentKind::ManualMove;
+    order->suppress_opportunistic_combat = true;
+
+    auto* attack = soldier->add_component<AttackComponent>(11.0F, 13, 1.75F);
+    attack->time_since_last = 0.5F;
+    attack->melee_range = 2.25F;
+    attack->melee_damage = 21;
+    attack->melee_cooldown = 0.9F;
+    attack->preferred_mode = AttackComponent::CombatMode::Melee;
+    attack->current_mode = AttackComponent::CombatMode::Melee;
+    attack->can_melee = false;
+    attack->can_ranged = true;
+    attack->max_height_difference = 4.5F;
+    attack->in_melee_lock = true;
+    attack->melee_lock_target_id = 77;
+
+    auto* attack_target = soldier->add_component<AttackTargetComponent>();
+    attack_target->target_id = 78;
+    attack_target->should_chase = true;
+    attack_target->is_player_command = true;
+
+    auto* commander = soldier->add_component<CommanderComponent>();
+    commander->commander_id = "hannibal";
+    commander->display_name = "Hannibal Barca";
+    commander->strategic_identity = "flanker";
+    commander->passive_aura = "elephant_terror";
+    commander->bonus_type = "morale";
+    commander->bonus_summary = "+morale near elephants";
+    commander->rally_ability = "war_horn";
+    commander->death_consequence = "army_wavers";
+    commander->bodyguard_count = 6;
+    commander->aura_radius = 18.0F;
+    commander->aura_morale_bonus = 9.0F;
+    commander->aura_bonus_value = 0.15F;
+    commander->rally_range = 14.0F;
+    commander->rally_cooldown = 30.0F;
+    commander->rally_morale_restore = 40.0F;
+    commander->rally_cooldown_remaining = 12.5F;
+    commander->rally_feedback_time = 0.75F;
+    commander->death_shock_radius = 20.0F;
+    commander->death_morale_shock = 35.0F;
+    commander->aura_active = false;
+    commander->aura_ability_active = true;
+    commander->aura_ability_requested = true;
+    commander->aura_ability_duration = 22.0F;
+    commander->aura_ability_remaining = 4.0F;
+    commander->aura_ability_cooldown = 75.0F;
+    commander->aura_ability_cooldown_remaining = 33.0F;
+    commander->aura_affinity_spawn_type = Game::Units::SpawnType::Spearman;
+    commander->wounded = true;
+    commander->rally_requested = true;
+    commander->rally_requires_manual_trigger = false;
+    commander->fpv_controlled = true;
+    commander->flag_rally_cost = 5.0F;
+    commander->flag_rally_pending_x = 12.0F;
+    commander->flag_rally_pending_z = -8.0F;
+    commander->flag_rally_animation_timer = 1.25F;
+    commander->flag_rally_in_progress = true;
+    commander->flag_rally_at_position = true;
+    commander->flag_rally_flag_x = 11.0F;
+    commander->flag_rally_flag_z = -7.0F;
+    commander->flag_rally_flag_active = true;
+    commander->flag_rally_issue_commands = true;
+
+    auto* rpg_health = soldier->add_component<RpgHealthComponent>();
+    rpg_health->incoming_damage_scale = 0.8F;
+    rpg_health->armor = 6.0F;
+    rpg_health->crit_chance = 0.2F;
+    rpg_health->crit_multiplier = 2.5F;
+
+    auto* morale = soldier->add_component<MoraleComponent>();
+    morale->morale = 33.0F;
+    morale->commander_aura_bonus = 4.0F;
+    morale->shock_timer = 1.5F;
+    morale->wavering = true;
+    morale->routing = true;
+
+    auto* undead = soldier->add_component<UndeadComponent>();
+    undead->morale_immune = false;
+    undead->fire_damage_multiplier = 2.0F;
+    undead->priest_damage_multiplier = 1.9F;
+    undead->cavalry_charge_damage_multiplier = 1.6F;
+    undead->counts_for_economy = true;
+
+    auto* cursed = soldier->add_component<CursedStatusComponent>();
+    cursed->morale_penalty_per_hit = 3.0F;
+    cursed->duration = 9.0F;
+    cursed->remaining_duration = 2.0F;
+    cursed->stacks = 4;
+
+    auto* burning = soldier->add_component<BurningStatusComponent>();
+    burning->duration = 5.0F;
+    burning->remaining_duration = 1.0F;
+    burning->ignition_elapsed = 0.3F;
+    burning->tick_interval = 0.25F;
+    burning->tick_accumulator = 0.1F;
+    burning->damage_per_tick = 7;
+    burning->attacker_id = 79;
+    burning->fire_bonus_multiplier = 1.4F;
+
+    auto* patrol = soldier->add_component<PatrolComponent>();
+    patrol->waypoints = {{1.0F, 0.0F}, {0.0F, 1.0F}, {2.0F, 2.0F}};
+    patrol->current_waypoint = 2;
+    patrol->patrolling = true;
+
+    auto* capture = soldier->add_component<CaptureComponent>();
+    capture->capturing_player_id = 3;
+    capture->capture_progress = 2.5F;
+    capture->required_time = 8.0F;
+    capture->is_being_captured = true;
+
+    auto* wave = soldier->add_component<AssaultWaveComponent>();
+    wave->active = false;
+    wave->wave_phase = 2;
+    wave->has_march_target = true;
+    wave->march_target_x = 30.0F;
+    wave->march_target_z = -12.0F;
+
+    auto* hold = soldier->add_component<HoldModeComponent>();
+    hold->active = false;
+    hold->exit_cooldown = 0.6F;
+    hold->stand_up_duration = 1.1F;
+    hold->kneel_entry_progress = 0.4F;
+    hold->kneel_duration = 0.9F;
+
+    auto* guard = soldier->add_component<GuardModeComponent>();
+    guard->active = false;
+    guard->guarded_entity_id = 80;
+    guard->guard_position_x = 5.0F;
+    guard->guard_position_z = 6.0F;
+    guard->guard_radius = 9.5F;
+    guard->returning_to_guard_position = true;
+    guard->has_guard_target = true;
+
+    auto* healer = soldier->add_component<HealerComponent>();
+    healer->healing_range = 10.0F;
+    healer->healing_amount = 8;
+    healer->healing_cooldown = 3.0F;
+    healer->time_since_last_heal = 1.0F;
+    healer->is_healing_active = true;
+    healer->healing_target_x = 2.0F;
+    healer->healing_target_z = 3.0F;
+    healer->target_affinity = HealerComponent::TargetAffinity::UndeadAllies;
+    healer->suppress_attack_while_healing = false;
+
+    auto* special = soldier->add_component<SpecialAttackComponent>();
+    special->projectile_kind = Game::Systems::ProjectileKind::CursedArrow;
+    special->use_projectile_system = true;
+    special->friendly_fire = true;
+    special->splash_radius = 2.0F;
+    special->splash_damage_multiplier = 0.4F;
+    special->bonus_damage_multiplier_vs_fire_vulnerable = 1.3F;
+    special->cursed_duration = 4.0F;
+    special->cursed_morale_penalty_per_hit = 2.0F;
+    special->cursed_stacks_per_hit = 2;
+    special->fire_patch_duration = 3.0F;
+    special->fire_patch_radius = 1.2F;
+    special->burn_duration = 2.0F;
+    special->burn_tick_interval = 0.3F;
+    special->burn_damage_per_tick = 3;
+
+    auto* commander_guard = soldier->add_component<CommanderGuardComponent>();
+    commander_guard->active = true;
+    commander_guard->frontal_arc_dot = 0.3F;
+    commander_guard->damage_multiplier = 0.5F;
+
+    auto* combat = soldier->add_component<CombatStateComponent>();
+    combat->animation_state = CombatAnimationState::Strike;
+    combat->attack_family = CombatAttackFamily::Spear;
+    combat->state_time = 0.2F;
+    combat->state_duration = 0.34F;
+    combat->attack_offset = 0.05F;
+    combat->attack_variant = 5;
+    // A unit strike axis survives the renormalization settle() repeats.
+    combat->intent.strike_dir_x = 0.0F;
+    combat->intent.strike_dir_y = -1.0F;
+    combat->intent.windup_dir_x = 0.0F;
+    combat->intent.windup_dir_y = 1.0F;
+    combat->intent.thrust_amount = 0.7F;
+    combat->intent.elevation = 0.2F;
+    combat->intent.charge = 0.9F;
+    combat->intent.swing_speed = 1.3F;
+    combat->intent.follow_through = 0.8F;
+    complete_melee_intent(combat->intent);
+    combat->finisher_attack = true;
+    combat->is_hit_paused = true;
+    combat->hit_pause_remaining = 0.05F;
+
+    auto* hit = soldier->add_component<HitFeedbackComponent>();
+    hit->source_attacker_id = 81;
+    hit->is_reacting = true;
+    hit->reaction_time = 0.1F;
+    hit->reaction_intensity = 0.6F;
+    hit->knockback_x = 0.05F;
+    hit->knockback_z = -0.04F;
+    hit->reaction_duration = 0.4F;
+    hit->reaction_kind = HitReactionKind::Stagger;
+
+    auto* formation = soldier->add_component<FormationModeComponent>();
+    formation->active = true;
+    formation->formation_center_x = 3.0F;
+    formation->formation_center_z = 4.0F;
+    formation->formation_id = 9001;
+    formation->stable_slot_id = 7;
+    formation->stable_rank = 2;
+    formation->stable_file = 3;
+    formation->stable_slot_x = 1.5F;
+    formation->stable_slot_z = -1.5F;
+
+    auto* membership = soldier->add_component<ArmyFormationMembershipComponent>();
+    membership->group_id = 44;
+    membership->slot_id = 12;
+
+    auto* layout = soldier->add_component<UnitLayoutStateComponent>();
+    layout->state = 2;
+    layout->phase = 0;
+    layout->transition_progress = 0.35F;
+    layout->transition_seconds = 1.2F;
+    layout->layout_id = 4;
+    layout->requested_layout_id = 5;
+
+    auto* stamina = soldier->add_component<StaminaComponent>();
+    stamina->stamina = 40.0F;
+    stamina->max_stamina = 120.0F;
+    stamina->regen_rate = 7.0F;
+    stamina->depletion_rate = 25.0F;
+    stamina->is_running = true;
+    stamina->run_requested = true;
+
+    auto* terrain = soldier->add_component<TerrainContextComponent>();
+    terrain->is_on_bridge = true;
+    terrain->is_at_hill_entrance = true;
+    terrain->audio_cooldown = 2.5F;
+
+    auto* builder = soldier->add_component<BuilderProductionComponent>();
+    builder->in_progress = true;
+    builder->build_time = 14.0F;
+    builder->time_remaining = 6.0F;
+    builder->product_type = "barracks";
+    builder->construction_complete = true;
+    builder->has_construction_site = true;
+    builder->construction_site_x = 20.0F;
+    builder->construction_site_z = 21.0F;
+    builder->construction_site_rotation_y = 90.0F;
+    builder->has_task_target = true;
+    builder->task_target_id = 82;
+    builder->task_target_x = 22.0F;
+    builder->task_target_z = 23.0F;
+    builder->task_target_reserved = true;
+    builder->at_construction_site = true;
+    builder->construction_site_entity_id = 83;
+    builder->structure_task_entity_id = 84;
+    builder->queued_construction_site_ids = {85, 86};
+    builder->bypass_movement_active = true;
+    builder->bypass_target_x = 24.0F;
+    builder->bypass_target_z = 25.0F;
+    builder->has_gather_order = true;
+    builder->gather_product_type = "wood";
+    builder->gather_anchor_x = 26.0F;
+    builder->gather_anchor_z = 27.0F;
+    builder->auto_gather = true;
+    builder->auto_gather_priority = "food";
+
+    auto* delivery = soldier->add_component<CivilianDeliveryComponent>();
+    delivery->target_barracks_id = 87;
+
+    auto* carry = soldier->add_component<ResourceCarryComponent>();
+    carry->amounts.set(Game::Systems::ResourceType::Wood, 12);
+    carry->amounts.set(Game::Systems::ResourceType::Iron, 3);
+    carry->depot_entity_id = 88;
+    carry->has_depot = true;
+
+    auto* resident = soldier->add_component<SettlementResidentComponent>();
+    resident->hearth_x = 40.0F;
+    resident->hearth_z = 41.0F;
+    resident->roam_radius = 9.0F;
+    resident->hearth_assigned = true;
+    resident->released = true;
+    resident->errand = SettlementErrand::Working;
+    resident->role = SettlementErrandRole::Labour;
+    resident->focus_id = 89;
+    resident->errand_x = 42.0F;
+    resident->errand_z = 43.0F;
+    resident->focus_x = 44.0F;
+    resident->focus_z = 45.0F;
+    resident->work_elapsed = 3.0F;
+    resident->errand_remaining = 4.0F;
+    resident->planned_dwell = 5.0F;
+    resident->think_cooldown = 0.5F;
+    resident->rng_state = 0xC0FFEEU;
+
+    auto* structure = world->create_entity();
+    structure->add_component<TransformComponent>()->position = {50.0F, 0.0F, 50.0F};
+    structure->add_component<BuildingComponent>()->original_nation_id =
+        Game::Systems::NationID::IronSepulcher;
+    structure->add_component<AIControlledComponent>();
+
+    auto* production = structure->add_component<ProductionComponent>();
+    production->in_progress = true;
+    production->build_time = 11.0F;
+    production->time_remaining = 4.5F;
+    production->produced_count = 3;
+    production->max_units = 17;
+    production->product_type = Game::Units::TroopType::Spearman;
+    production->rally_x = 52.0F;
+    production->rally_z = 53.0F;
+    production->rally_set = true;
+    production->villager_cost = 2;
+    production->manpower_available = 30;
+    production->production_queue = {Game::Units::TroopType::Archer,
+                                    Game::Units::TroopType::Spearman};
+
+    auto* fire = structure->add_component<StructureFireComponent>();
+    fire->ignition_progress = 0.4F;
+    fire->ignition_threshold = 2.0F;
+    fire->duration = 10.0F;
+    fire->remaining_duration = 7.0F;
+    fire->ignition_elapsed = 1.0F;
+    fire->tick_interval = 0.5F;
+    fire->tick_accumulator = 0.2F;
+    fire->damage_per_tick = 4;
+    fire->attacker_id = 90;
+
+    auto* catapult = structure->add_component<CatapultLoadingComponent>();
+    catapult->state = CatapultLoadingComponent::LoadingState::ReadyToFire;
+    catapult->loading_time = 1.5F;
+    catapult->loading_duration = 3.0F;
+    catapult->firing_time = 0.2F;
+    catapult->firing_duration = 0.7F;
+    catapult->target_id = 91;
+    catapult->target_locked_x = 60.0F;
+    catapult->target_locked_y = 1.0F;
+    catapult->target_locked_z = 61.0F;
+    catapult->target_position_locked = true;
+    catapult->loaded_projectile_kind = Game::Systems::ProjectileKind::Fireball;
+
+    auto* home = structure->add_component<HomeComponent>();
+    home->population_contribution = 75;
+    home->nearest_barracks_id = 92;
+    home->update_cooldown = 1.0F;
+    home->family_generation_cooldown = 6.0F;
+    home->family_generation_interval = 20.0F;
+    home->family_manpower_value = 11;
+
+    auto* farm = structure->add_component<FarmComponent>();
+    farm->growth = 0.6F;
+    farm->cycle_seconds = 90.0F;
+    farm->harvests = 4;
+
+    auto* wall = structure->add_component<WallSegmentComponent>();
+    wall->grid_x = 13;
+    wall->grid_z = -14;
+
+    auto* wall_site = structure->add_component<WallConstructionSiteComponent>();
+    wall_site->owner_id = 2;
+    wall_site->nation_id = Game::Systems::NationID::Carthage;
+    wall_site->build_time = 12.0F;
+    wall_site->progress = 0.45F;
+    wall_site->product_type = Game::Units::SpawnType::Knight;
+
+    auto* dismantle = structure->add_component<DismantleSiteComponent>();
+    dismantle->duration = 6.0F;
+    dismantle->progress = 0.25F;
+
+    auto* gate = structure->add_component<GateComponent>();
+    gate->state = GateComponent::State::Opening;
+    gate->manual_mode = GateComponent::ManualMode::ForcedOpen;
+    gate->open_amount = 0.5F;
+    gate->open_speed = 3.0F;
+    gate->trigger_radius = 7.0F;
+    gate->hold_open_seconds = 4.0F;
+    gate->hold_timer = 1.5F;
+
+    auto* beast = world->create_entity();
+    beast->add_component<TransformComponent>()->position = {-30.0F, 0.0F, 12.0F};
+
+    auto* elephant = beast->add_component<ElephantComponent>();
+    elephant->charge_state = ElephantComponent::ChargeState::Trampling;
+    elephant->charge_speed_multiplier = 2.2F;
+    elephant->charge_duration = 3.0F;
+    elephant->charge_cooldown = 5.0F;
+    elephant->trample_radius = 3.5F;
+    elephant->trample_damage = 55;
+    elephant->trample_damage_accumulator = 0.75F;
+
+    beast->add_component<ElephantPanicComponent>()->duration = 2.5F;
+    beast->add_component<ElephantStompImpactComponent>()->impacts = {
+        {1.0F, 2.0F, 0.1F}, {3.0F, 4.0F, 0.2F}};
+
+    auto* patch = beast->add_component<FirePatchComponent>();
+    patch->radius = 2.5F;
+    patch->duration = 6.0F;
+    patch->remaining_duration = 3.0F;
+    patch->burn_duration = 2.0F;
+    patch->burn_tick_interval = 0.4F;
+    patch->burn_damage_per_tick = 5;
+    patch->attacker_owner_id = 3;
+    patch->attacker_id = 93;
+    patch->friendly_fire = true;
+    patch->fire_bonus_multiplier = 1.2F;
+
+    auto* wildlife = beast->add_component<WildlifeComponent>();
+    wildlife->species = Game::Wildlife::Species::Wolf;
+    wildlife->behavior = Game::Wildlife::Behavior::Stalk;
+    wildlife->group_id = 6;
+    wildlife->home_x = -28.0F;
+    wildlife->home_z = 10.0F;
+    wildlife->roam_radius = 22.0F;
+    wildlife->anchor_assigned = true;
+    wildlife->target_x = -25.0F;
+    wildlife->target_z = 8.0F;
+    wildlife->think_cooldown = 0.4F;
+    wildlife->state_timer = 2.0F;
+    wildlife->alarm_timer = 1.0F;
+    wildlife->hostile_timer = 3.0F;
+    wildlife->bite_timer = 0.5F;
+    wildlife->bite_target_id = 94;
+    wildlife->bite_impact_pending = true;
+    wildlife->focus_id = 95;
+    wildlife->aggressor_id = 96;
+    wildlife->rng_state = 0xBADF00DU;
+  }
+
+  [[nodiscard]] auto world_json() const -> QJsonObject {
+    return Serialization::serialize_world(world.get()).object();
+  }
+
+  std::unique_ptr<World> world;
+};
+
+TEST_F(WorldSnapshotTest, RestoreReproducesTheSavedWorld) {
+  populate(64);
+  const QJsonObject before = world_json();
+
+  const QByteArray bytes = Game::Save::capture_world_snapshot(*world);
+  EXPECT_TRUE(Game::Save::is_world_snapshot(bytes));
+  EXPECT_LT(bytes.size(),
+            Serialization::serialize_world(world.get())
+                .toJson(QJsonDocument::Compact)
+                .size());
+
+  world = std::make_unique<World>();
+  QString error;
+  ASSERT_TRUE(Game::Save::restore_world_snapshot(*world, bytes, &error))
+      << error.toStdString();
+  EXPECT_EQ(world->entity_count(), 64U);
+  EXPECT_EQ(world_json(), before);
+}
+
+TEST_F(WorldSnapshotTest, EveryColumnSurvivesARoundTrip) {
+  populate_every_column();
+  const QJsonObject before = world_json();
+  const QByteArray bytes = Game::Save::capture_world_snapshot(*world);
+
+  // Entity ids follow the 20-byte header; the column count comes after them.
+  const qsizetype column_count_at = 20 + 3 * qsizetype{sizeof(EntityID)};
+  ASSERT_GE(bytes.size(), column_count_at + 4);
+  std::uint32_t column_count = 0;
+  std::memcpy(&column_count, bytes.constData() + column_count_at, 4);
+  std::size_t authoritative = 0;
+  for (const auto& spec : Game::Save::fields()) {
+    if (spec.classification == Game::Save::FieldClass::AuthoritativeSerialized &&
+        std::string_view(spec.name).ends_with("Component")) {
+      ++authoritative;
+    }
+  }
+  EXPECT_EQ(column_count, authoritative)
+      << "populate_every_column() is missing a saved component";
+
+  world = std::make_unique<World>();
+  QString error;
+  ASSERT_TRUE(Game::Save::restore_world_snapshot(*world, bytes, &error))
+      << error.toStdString();
+  EXPECT_EQ(world_json(), before);
+  EXPECT_EQ(Game::Save::capture_world_snapshot(*world), bytes);
+}
+
+TEST_F(WorldSnapshotTest, RestoreWorldBytesStillAcceptsJsonSaves) {
+  populate(12);
+  const QJsonObject before = world_json();
+  const QByteArray json =
+      Serialization::serialize_world(world.get()).toJson(QJsonDocument::Compact);
+
+  world = std::make_unique<World>();
+  QString error;
+  ASSERT_TRUE(Game::Save::restore_world_bytes(*world, json, &error))
+      << error.toStdString();
+  EXPECT_EQ(world_json(), before);
+
+  EXPECT_FALSE(
+      Game::Save::restore_world_bytes(*world, QByteArray("{\"entities\":"), &error));
+  EXPECT_FALSE(error.isEmpty());
+}
+
+TEST_F(WorldSnapshotTest, TruncatedSnapshotLeavesTheWorldUntouched) {
+  populate(24);
+  const QByteArray bytes = Game::Save::capture_world_snapshot(*world);
+  const QJsonObject before = world_json();
+
+  for (const qsizetype keep : {qsizetype{12}, bytes.size() / 2, bytes.size() - 1}) {
+    QString error;
+    EXPECT_FALSE(
+        Game::Save::restore_world_snapshot(*world, bytes.left(keep), &error))
+        << "kept " << keep << " bytes";
+    EXPECT_FALSE(error.isEmpty());
+    EXPECT_EQ(world_json(), before);
+  }
+}
+
+TEST_F(WorldSnapshotTest, ConstructionPreviewsAreNotSaved) {
+  populate(3);
+  auto* preview = world->create_entity();
+  preview->add_component<TransformComponent>();
+  preview->add_component<ConstructionPreviewComponent>();
+
+  const QByteArray bytes = Game::Save::capture_world_snapshot(*world);
+  world = std::make_unique<World>();
+  QString error;
+  ASSERT_TRUE(Game::Save::restore_world_snapshot(*world, bytes, &error))
+      << error.toStdString();
+  EXPECT_EQ(world->entity_count(), 3U);
+}
+
+} // namespace
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "core/world.h"
+
+namespace TestSupport {
+
+// Tests that call a system's update() directly skip World::update, so they
+// apply the deferred edits and queued events the way the phase barrier would.
+inline void apply_phase_barrier(Engine::Core::World& world) {
+  world.deferred().apply(world);
+  world.events().deliver();
+}
+
+} // namespace TestSupport
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <gtest/gtest.h>
 #include <string_view>
+#include <vector>
 
 #include "game/core/component.h"
 #include "game/core/ownership_constants.h"
@@ -770,6 +771,101 @@ TEST_F(AISystemTest, SnapshotBuilderUsesBuildingVisionForBaseDefense) {
   EXPECT_EQ(snapshot.visible_enemies.front().id, visible_enemy->get_id());
 }
 
+TEST_F(AISystemTest, SharedWorldSnapshotProjectsEachPlayersOwnView) {
+  using Game::Systems::AI::AISnapshotBuilder;
+
+  Engine::Core::World world;
+  auto& owners = Game::Systems::OwnerRegistry::instance();
+  owners.register_owner_with_id(3, Game::Systems::OwnerType::AI, "North");
+  owners.register_owner_with_id(5, Game::Systems::OwnerType::AI, "South");
+  owners.register_owner_with_id(7, Game::Systems::OwnerType::Player, "Enemy");
+  owners.set_owner_team(3, 1);
+  owners.set_owner_team(5, 1);
+  owners.set_owner_team(7, 2);
+
+  // North: one free unit, one held on patrol and one the AI does not control.
+  // Held and player-controlled units still see for their owner.
+  auto* north_free = add_world_unit(world, 3, 0.0F, 0.0F, 10.0F, true);
+  auto* north_held = add_world_unit(world, 3, 30.0F, 0.0F, 10.0F, true);
+  north_held->add_component<Engine::Core::PatrolComponent>()->patrolling = true;
+  (void)add_world_unit(world, 3, 60.0F, 0.0F, 10.0F, false);
+  auto* south = add_world_unit(world, 5, 0.0F, 40.0F, 10.0F, true);
+
+  auto* near_north = add_world_unit(world, 7, 5.0F, 0.0F, 10.0F, false);
+  auto* seen_by_held = add_world_unit(world, 7, 30.0F, 8.0F, 10.0F, false);
+  (void)add_world_unit(world, 7, 60.0F, 25.0F, 10.0F, false);
+  auto* near_south = add_world_unit(world, 7, 0.0F, 46.0F, 10.0F, false);
+  auto* dead = add_world_unit(world, 7, 1.0F, 1.0F, 10.0F, false);
+  dead->get_component<Engine::Core::UnitComponent>()->health = 0;
+
+  struct Expected {
+    int owner_id;
+    std::vector<Engine::Core::EntityID> friendly;
+    std::vector<Engine::Core::EntityID> visible;
+  };
+  const std::vector<Expected> expected = {
+      {3, {north_free->get_id()}, {near_north->get_id(), seen_by_held->get_id()}},
+      {5, {south->get_id()}, {near_south->get_id()}},
+  };
+
+  auto ids_of = [](const auto& entries) {
+    std::vector<Engine::Core::EntityID> ids;
+    for (const auto& entry : entries) {
+      ids.push_back(entry.id);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+
+  const auto shared = AISnapshotBuilder::build_world(world, nullptr);
+  for (const auto& player : expected) {
+    auto projected = AISnapshotBuilder::begin_player(*shared, player.owner_id);
+    AISnapshotBuilder::populate_units(
+        *shared, AISnapshotBuilder::enemy_owners(*shared, player.owner_id), projected);
+
+    EXPECT_EQ(ids_of(projected.friendly_units), player.friendly)
+        << "owner " << player.owner_id;
+    EXPECT_EQ(ids_of(projected.visible_enemies), player.visible)
+        << "owner " << player.owner_id;
+    for (const auto& enemy : projected.visible_enemies) {
+      EXPECT_EQ(enemy.owner_id, 7) << "an ally leaked into owner "
+                                   << player.owner_id << "'s enemies";
+    }
+    ASSERT_EQ(projected.friendly_units.size(), 1U);
+    EXPECT_TRUE(projected.friendly_units.front().engaged)
+        << "owner " << player.owner_id << " has an enemy within the engaged radius";
+  }
+}
+
+TEST_F(AISystemTest, SharedWorldSnapshotRebuildsOnlyUnitsWrittenSinceTheLastBuild) {
+  Engine::Core::World world;
+  auto& registry = world.registry();
+  registry.set_write_epoch(1);
+  std::vector<Engine::Core::Entity*> units;
+  for (int i = 0; i < 5; ++i) {
+    units.push_back(
+        add_world_unit(world, 3, static_cast<float>(i) * 4.0F, 0.0F, 10.0F, true));
+  }
+
+  registry.set_write_epoch(2);
+  const auto first = Game::Systems::AI::AISnapshotBuilder::build_world(world, nullptr);
+  EXPECT_EQ(first->reused_units, 0U);
+
+  registry.set_write_epoch(3);
+  units[2]->get_component<Engine::Core::UnitComponent>()->health = 40;
+  const auto second =
+      Game::Systems::AI::AISnapshotBuilder::build_world(world, first.get());
+
+  EXPECT_EQ(second->reused_units, units.size() - 1U);
+  ASSERT_EQ(second->units.size(), units.size());
+  const auto changed = std::find_if(
+      second->units.begin(), second->units.end(), [&](const auto& record) {
+        return record.entity.id == units[2]->get_id();
+      });
+  ASSERT_NE(changed, second->units.end());
+  EXPECT_EQ(changed->entity.health, 40);
+}
+
 TEST_F(AISystemTest, SepulcherStrategyParsesAliasesAndDisablesEconomyTargets) {
   EXPECT_EQ(Game::Systems::AI::AIStrategyFactory::parse_strategy("sepulcher_defense"),
             Game::Systems::AI::AIStrategy::SepulcherDefense);
@@ -24,6 +24,7 @@
 #include "game/systems/unit_activity.h"
 #include "game/units/spawn_type.h"
 #include "save/serialization.h"
+#include "tests/support/phase_barrier.h"
 
 namespace {
 
@@ -369,6 +370,7 @@ TEST_F(AutoGatherTest, WithNoDropOffLeftTheWorkerBanksTheLoadAndCarriesOn) {
 
   Game::Systems::ResourceDeliverySystem delivery;
   delivery.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_FALSE(worker->has_component<Engine::Core::ResourceCarryComponent>())
       << "a load with nowhere to go must not pin the worker forever";
@@ -14,6 +14,7 @@
 #include "systems/nav_grid.h"
 #include "systems/target_commitment_system.h"
 #include "tests/support/movement_test_access.h"
+#include "tests/support/phase_barrier.h"
 
 using namespace Engine::Core;
 using namespace Game::Systems;
@@ -150,6 +151,7 @@ TEST_F(EngagementSlotTest, MeleeAttackersGetDistinctSlots) {
 
   EngagementSlotSystem system;
   system.update(world.get(), 0.016F);
+  TestSupport::apply_phase_barrier(*world);
 
   std::set<std::uint8_t> slot_indices;
   for (auto* attacker : attackers) {
@@ -183,6 +185,7 @@ TEST_F(EngagementSlotTest, OverflowHandled) {
 
   EngagementSlotSystem system;
   system.update(world.get(), 0.016F);
+  TestSupport::apply_phase_barrier(*world);
 
   EXPECT_GT(system.diagnostics().overflow_redirects, 0U);
 }
@@ -225,9 +228,11 @@ TEST_F(TargetCommitmentTest, CannotSwitchDuringWindUp) {
   TargetCommitmentSystem system;
 
   system.update(world.get(), 0.016F);
+  TestSupport::apply_phase_barrier(*world);
 
   attack_target->target_id = enemy2->get_id();
   system.update(world.get(), 0.016F);
+  TestSupport::apply_phase_barrier(*world);
 
   EXPECT_EQ(attack_target->target_id, enemy1->get_id());
   EXPECT_GT(system.diagnostics().switches_blocked, 0U);
@@ -256,12 +261,14 @@ TEST_F(TargetCommitmentTest, BlockedSwitchReleasesConflictingReciprocalLock) {
 
   TargetCommitmentSystem system;
   system.update(world.get(), 0.016F);
+  TestSupport::apply_phase_barrier(*world);
 
   attack_target->target_id = enemy2->get_id();
   attack_target->should_chase = false;
   atk->in_melee_lock = true;
   atk->melee_lock_target_id = enemy2->get_id();
   system.update(world.get(), 0.0F);
+  TestSupport::apply_phase_barrier(*world);
 
   EXPECT_EQ(attack_target->target_id, enemy1->get_id());
   EXPECT_TRUE(attack_target->should_chase);
@@ -294,13 +301,16 @@ TEST_F(TargetCommitmentTest, CanSwitchAfterRecovery) {
 
   TargetCommitmentSystem system;
   system.update(world.get(), 0.016F);
+  TestSupport::apply_phase_barrier(*world);
 
   for (int i = 0; i < 60; ++i) {
     system.update(world.get(), 0.016F);
+    TestSupport::apply_phase_barrier(*world);
   }
 
   attack_target->target_id = enemy2->get_id();
   system.update(world.get(), 0.016F);
+  TestSupport::apply_phase_barrier(*world);
 
   EXPECT_EQ(attack_target->target_id, enemy2->get_id());
 }
@@ -325,9 +335,11 @@ TEST_F(TargetCommitmentTest, ForcedReleaseOnTargetDeath) {
 
   TargetCommitmentSystem system;
   system.update(world.get(), 0.016F);
+  TestSupport::apply_phase_barrier(*world);
 
   enemy_unit->health = 0;
   system.update(world.get(), 0.016F);
+  TestSupport::apply_phase_barrier(*world);
 
   auto* commitment = attacker->get_component<TargetCommitmentComponent>();
   ASSERT_NE(commitment, nullptr);
@@ -360,6 +372,7 @@ TEST_F(CohortSystemTest, NearbyUnitsFormCohort) {
 
   CohortSystem system;
   system.update(world.get(), 0.016F);
+  TestSupport::apply_phase_barrier(*world);
 
   EXPECT_GE(system.diagnostics().cohorts_formed, 1U);
   EXPECT_GE(system.diagnostics().units_in_cohorts, 4U);
@@ -380,11 +393,13 @@ TEST_F(CohortSystemTest, CohortActivatesWhenOneDetectsEnemy) {
   CohortSystem system;
 
   system.update(world.get(), 0.016F);
+  TestSupport::apply_phase_barrier(*world);
 
   auto* attack_target = units[0]->add_component<AttackTargetComponent>();
   attack_target->target_id = 999;
 
   system.update(world.get(), 0.016F);
+  TestSupport::apply_phase_barrier(*world);
 
   for (auto* entity : units) {
     auto* membership = entity->get_component<CohortMembershipComponent>();
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "game/systems/bucket_grid.h"
+
+namespace {
+
+using Game::Systems::BucketGrid;
+
+struct Point2 {
+  float x;
+  float z;
+};
+
+auto brute_force_radius(const std::vector<Point2>& points,
+                        const std::vector<bool>& live,
+                        float x,
+                        float z,
+                        float radius) -> std::vector<std::uint32_t> {
+  std::vector<std::uint32_t> keys;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    float const dx = points[i].x - x;
+    float const dz = points[i].z - z;
+    if (live[i] && dx * dx + dz * dz <= radius * radius) {
+      keys.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+  return keys;
+}
+
+auto grid_radius(const BucketGrid& grid, float x, float z, float radius)
+    -> std::vector<std::uint32_t> {
+  std::vector<std::uint32_t> keys;
+  grid.for_each_in_radius(x, z, radius, [&keys](const BucketGrid::Item& item) {
+    keys.push_back(item.key);
+  });
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+TEST(BucketGridTest, RadiusQueriesMatchABruteForceScan) {
+  std::mt19937 rng(7U);
+  std::uniform_real_distribution<float> coord(-120.0F, 120.0F);
+  std::vector<Point2> points(2000);
+  std::vector<bool> live(points.size(), true);
+  BucketGrid grid(4.0F);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    points[i] = {coord(rng), coord(rng)};
+    grid.insert(static_cast<std::uint32_t>(i), points[i].x, points[i].z);
+  }
+  grid.build();
+  EXPECT_EQ(grid.size(), points.size());
+  EXPECT_EQ(grid.loose_count(), 0U);
+
+  for (int query = 0; query < 50; ++query) {
+    float const x = coord(rng);
+    float const z = coord(rng);
+    EXPECT_EQ(grid_radius(grid, x, z, 9.0F),
+              brute_force_radius(points, live, x, z, 9.0F));
+  }
+}
+
+TEST(BucketGridTest, IncrementalMovesAndRemovalsKeepQueriesExact) {
+  std::mt19937 rng(11U);
+  std::uniform_real_distribution<float> coord(-60.0F, 60.0F);
+  std::uniform_real_distribution<float> step(-3.0F, 3.0F);
+  std::uniform_int_distribution<std::size_t> pick(0U, 499U);
+  std::vector<Point2> points(500);
+  std::vector<bool> live(points.size(), true);
+  BucketGrid grid(4.0F);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    points[i] = {coord(rng), coord(rng)};
+    grid.insert(static_cast<std::uint32_t>(i), points[i].x, points[i].z);
+  }
+  grid.build();
+
+  for (int tick = 0; tick < 40; ++tick) {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      points[i].x += step(rng);
+      points[i].z += step(rng);
+      if (live[i]) {
+        grid.move(static_cast<std::uint32_t>(i), points[i].x, points[i].z);
+      }
+    }
+    std::size_t const jumper = pick(rng);
+    points[jumper] = {coord(rng), coord(rng)};
+    if (live[jumper]) {
+      grid.move(static_cast<std::uint32_t>(jumper), points[jumper].x, points[jumper].z);
+    }
+    std::size_t const toggled = pick(rng);
+    if (live[toggled]) {
+      grid.remove(static_cast<std::uint32_t>(toggled));
+    } else {
+      grid.insert(
+          static_cast<std::uint32_t>(toggled), points[toggled].x, points[toggled].z);
+    }
+    live[toggled] = !live[toggled];
+
+    for (int query = 0; query < 10; ++query) {
+      float const x = coord(rng);
+      float const z = coord(rng);
+      ASSERT_EQ(grid_radius(grid, x, z, 7.5F),
+                brute_force_radius(points, live, x, z, 7.5F))
+          << "tick " << tick;
+    }
+  }
+  EXPECT_EQ(grid.size(),
+            static_cast<std::size_t>(std::count(live.begin(), live.end(), true)));
+  EXPECT_GT(grid.stats().shifted_moves, 0U);
+}
+
+TEST(BucketGridTest, QueriesBeforeTheFirstBuildSeeLooseItems) {
+  BucketGrid grid(4.0F);
+  grid.insert(3U, 1.0F, 1.0F);
+  grid.insert(9U, 50.0F, 50.0F);
+  EXPECT_FALSE(grid.is_built());
+  EXPECT_EQ(grid_radius(grid, 0.0F, 0.0F, 3.0F), std::vector<std::uint32_t>{3U});
+
+  grid.clear();
+  EXPECT_EQ(grid.size(), 0U);
+  EXPECT_FALSE(grid.contains(3U));
+  EXPECT_TRUE(grid_radius(grid, 0.0F, 0.0F, 100.0F).empty());
+}
+
+} // namespace
@@ -18,6 +18,7 @@
 #include "systems/nav_grid.h"
 #include "systems/pathfinding.h"
 #include "systems/wall_network_service.h"
+#include "tests/support/movement_test_access.h"
 
 using namespace Engine::Core;
 using namespace Game::Systems;
@@ -125,6 +126,39 @@ protected:
     return segments;
   }
 
+  // A mover already walking a deliberate detour to `goal`. A fresh path on the
+  // open grid never passes through `detour`, so the waypoint only survives
+  // while the mover has not been repathed.
+  auto make_detouring_mover(World& world,
+                            const QVector3D& start,
+                            const QVector3D& detour,
+                            const QVector3D& goal) -> Entity* {
+    auto* mover = make_soldier(world, start.x(), start.z(), 1);
+    auto* movement = mover->get_component<MovementComponent>();
+    MovementTestAccess::set_has_target(*movement, true);
+    MovementTestAccess::set_target_x(*movement, detour.x());
+    MovementTestAccess::set_target_y(*movement, detour.z());
+    MovementTestAccess::set_goal_x(*movement, goal.x());
+    MovementTestAccess::set_goal_y(*movement, goal.z());
+    MovementTestAccess::set_path(*movement,
+                                 {{detour.x(), detour.z()},
+                                  {goal.x(), detour.z()},
+                                  {goal.x(), goal.z()}});
+    MovementTestAccess::set_path_index(*movement, 0);
+    return mover;
+  }
+
+  static auto still_detours(const Entity& mover, const QVector3D& detour) -> bool {
+    const auto& path = mover.get_component<MovementComponent>()->get_path();
+    return !path.empty() && path.front().first == detour.x() &&
+           path.front().second == detour.z();
+  }
+
+  static void mark_cell_dirty(float world_x, float world_z) {
+    Point const cell = grid_cell(world_x, world_z);
+    pathfinder().mark_region_dirty(cell.x, cell.x, cell.y, cell.y);
+  }
+
   static void destroy_by_combat(World& world, Entity* target, Entity* attacker) {
     auto* unit = target->get_component<UnitComponent>();
     ASSERT_NE(unit, nullptr);
@@ -375,4 +409,72 @@ TEST_F(BuildingObstructionLifecycleTest, UnitsRerouteThroughNewlyOpenedBreach) {
   }
 }
 
+TEST_F(BuildingObstructionLifecycleTest, ReleaseRepathsOnlyMoversCrossingTheChange) {
+  World& world = m_session.world();
+  QVector3D const near_detour(-10.0F, 0.0F, -2.0F);
+  QVector3D const far_detour(6.0F, 0.0F, 4.0F);
+  auto* near_mover = make_detouring_mover(world,
+                                          QVector3D(-10.0F, 0.0F, -10.0F),
+                                          near_detour,
+                                          QVector3D(-4.0F, 0.0F, -10.0F));
+  auto* far_mover = make_detouring_mover(
+      world, QVector3D(6.0F, 0.0F, 10.0F), far_detour, QVector3D(12.0F, 0.0F, 10.0F));
+
+  MovementSystem movement_system;
+  constexpr float k_step = 1.0F / 30.0F;
+  movement_system.update(&world, k_step);
+  ASSERT_TRUE(still_detours(*near_mover, near_detour));
+  ASSERT_TRUE(still_detours(*far_mover, far_detour));
+
+  mark_cell_dirty(-7.0F, -6.0F);
+  pathfinder().mark_obstruction_released();
+  movement_system.update(&world, k_step);
+
+  EXPECT_FALSE(still_detours(*near_mover, near_detour))
+      << "the change sits inside the near mover's route and must repath it";
+  EXPECT_TRUE(still_detours(*far_mover, far_detour))
+      << "a mover whose route is nowhere near the change keeps its path";
+}
+
+TEST_F(BuildingObstructionLifecycleTest, UnscopedReleaseRepathsEveryMover) {
+  World& world = m_session.world();
+  QVector3D const near_detour(-10.0F, 0.0F, -2.0F);
+  QVector3D const far_detour(6.0F, 0.0F, 4.0F);
+
+  MovementSystem movement_system;
+  constexpr float k_step = 1.0F / 30.0F;
+  auto release_and_expect_full_repath = [&](auto&& mark_change, const char* cause) {
+    auto* near_mover = make_detouring_mover(world,
+                                            QVector3D(-10.0F, 0.0F, -10.0F),
+                                            near_detour,
+                                            QVector3D(-4.0F, 0.0F, -10.0F));
+    auto* far_mover = make_detouring_mover(
+        world, QVector3D(6.0F, 0.0F, 10.0F), far_detour, QVector3D(12.0F, 0.0F, 10.0F));
+    movement_system.update(&world, k_step);
+    ASSERT_TRUE(still_detours(*near_mover, near_detour)) << cause;
+    ASSERT_TRUE(still_detours(*far_mover, far_detour)) << cause;
+
+    mark_change();
+    pathfinder().mark_obstruction_released();
+    movement_system.update(&world, k_step);
+
+    EXPECT_FALSE(still_detours(*near_mover, near_detour)) << cause;
+    EXPECT_FALSE(still_detours(*far_mover, far_detour)) << cause;
+    world.destroy_entity(near_mover->get_id());
+    world.destroy_entity(far_mover->get_id());
+  };
+
+  // Every logged region is in a corner neither route touches; once the log
+  // drops the oldest, the movers cannot be scoped and all of them repath.
+  release_and_expect_full_repath(
+      [] {
+        for (std::size_t i = 0; i <= Pathfinding::k_max_logged_regions; ++i) {
+          mark_cell_dirty(14.0F, -14.0F);
+        }
+      },
+      "overflowed region log");
+  release_and_expect_full_repath([] { pathfinder().mark_navigation_grid_dirty(); },
+                                 "whole-grid dirty");
+}
+
 } // namespace
@@ -6,6 +6,7 @@
 #include "game/session/session_context.h"
 #include "game/systems/capture_system.h"
 #include "game/systems/owner_registry.h"
+#include "tests/support/phase_barrier.h"
 
 namespace {
 
@@ -65,6 +66,7 @@ TEST_F(CaptureSystemTest, TheStrongestBesiegerIsTheOneCapturing) {
   add_troop(k_bystander, 2.0F, 1.0F);
 
   m_system.update(&world(), 0.1F);
+  TestSupport::apply_phase_barrier(world());
 
   auto* capture = barracks->get_component<Engine::Core::CaptureComponent>();
   ASSERT_NE(capture, nullptr);
@@ -81,6 +83,7 @@ TEST_F(CaptureSystemTest, DefendersInTheRingHoldTheBarracks) {
   }
 
   m_system.update(&world(), 0.1F);
+  TestSupport::apply_phase_barrier(world());
 
   auto* capture = barracks->get_component<Engine::Core::CaptureComponent>();
   ASSERT_NE(capture, nullptr);
@@ -95,6 +98,7 @@ TEST_F(CaptureSystemTest, TroopsOutsideTheRingDoNotCount) {
   }
 
   m_system.update(&world(), 0.1F);
+  TestSupport::apply_phase_barrier(world());
 
   auto* capture = barracks->get_component<Engine::Core::CaptureComponent>();
   ASSERT_NE(capture, nullptr);
@@ -109,6 +113,7 @@ TEST_F(CaptureSystemTest, EachBarracksIsJudgedByItsOwnNeighbourhood) {
   }
 
   m_system.update(&world(), 0.1F);
+  TestSupport::apply_phase_barrier(world());
 
   EXPECT_TRUE(near_barracks->get_component<Engine::Core::CaptureComponent>()
                   ->is_being_captured);
@@ -13,7 +13,6 @@
 #include "core/entity.h"
 #include "core/ownership_constants.h"
 #include "core/world.h"
-#include "systems/arrow_projectile.h"
 #include "systems/cleanup_system.h"
 #include "systems/combat_actions/body_impact.h"
 #include "systems/combat_actions/combat_action_definition.h"
@@ -845,7 +844,7 @@ TEST_F(CombatModeTest, CombatQueryContextSkipsRemovedAndDeadSpatialEntries) {
 
   ASSERT_NE(target, nullptr);
   EXPECT_EQ(target->get_id(), valid_enemy->get_id());
-  EXPECT_EQ(scan_iterations, 2U);
+  EXPECT_EQ(scan_iterations, 1U);
 }
 
 TEST_F(CombatModeTest, EnemyValidityHelperAllowsBuildingsOnlyWhenRequested) {
@@ -2090,12 +2089,11 @@ TEST_F(CombatModeTest, RangedAttackAgainstRpgCommanderSpawnsOneFocusedArrow) {
   auto* projectile_system = world->get_system<Game::Systems::ProjectileSystem>();
   ASSERT_NE(projectile_system, nullptr);
   ASSERT_EQ(projectile_system->projectiles().size(), 1U);
-  auto const* arrow = dynamic_cast<Game::Systems::ArrowProjectile const*>(
-      projectile_system->projectiles().front().get());
-  ASSERT_NE(arrow, nullptr);
-  EXPECT_EQ(arrow->visual_style(), Game::Systems::ArrowVisualStyle::Focused);
-  EXPECT_TRUE(arrow->should_apply_damage());
-  EXPECT_EQ(arrow->get_target_id(), commander->get_id());
+  auto const arrow = projectile_system->projectiles().front();
+  ASSERT_EQ(arrow.body(), Game::Systems::ProjectileBody::Arrow);
+  EXPECT_EQ(arrow.visual_style(), Game::Systems::ArrowVisualStyle::Focused);
+  EXPECT_TRUE(arrow.should_apply_damage());
+  EXPECT_EQ(arrow.get_target_id(), commander->get_id());
 }
 
 TEST_F(CombatModeTest, InterruptedBowActionCreatesNoProjectileOrDamage) {
@@ -5596,11 +5594,11 @@ TEST_F(CombatModeTest, CommanderBowActionReleasesProjectileAtAuthoredEvent) {
       action_seconds(Game::Systems::CombatActions::CombatActionId::RpgBowShot, 0.039F));
 
   ASSERT_EQ(projectile_system->projectiles().size(), 1U);
-  auto const& projectile = projectile_system->projectiles().front();
-  EXPECT_TRUE(projectile->should_apply_damage());
-  EXPECT_EQ(projectile->get_attacker_id(), commander->get_id());
-  EXPECT_EQ(projectile->get_target_id(), enemy->get_id());
-  EXPECT_EQ(projectile->get_damage(), 13);
+  auto const projectile = projectile_system->projectiles().front();
+  EXPECT_TRUE(projectile.should_apply_damage());
+  EXPECT_EQ(projectile.get_attacker_id(), commander->get_id());
+  EXPECT_EQ(projectile.get_target_id(), enemy->get_id());
+  EXPECT_EQ(projectile.get_damage(), 13);
   EXPECT_EQ(action->last_hit_target_id, enemy->get_id());
   EXPECT_EQ(action->last_damage, 13);
   EXPECT_EQ(enemy->get_component<UnitComponent>()->health, 100);
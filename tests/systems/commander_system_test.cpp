@@ -18,6 +18,7 @@
 #include "game/units/troop_catalog_loader.h"
 #include "game/units/troop_type.h"
 #include "tests/support/movement_test_access.h"
+#include "tests/support/phase_barrier.h"
 
 namespace {
 
@@ -357,6 +358,7 @@ TEST(CommanderSystemTest, CommanderDeathDisablesAuraAndShocksNearbyAllies) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_TRUE(commander_data->wounded);
   EXPECT_FALSE(commander_data->aura_active);
@@ -420,12 +422,14 @@ TEST(CommanderSystemTest, AuraAppliesAttackAndProductionBonusesByType) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 1.0F);
+  TestSupport::apply_phase_barrier(world);
   EXPECT_EQ(ally_attack->melee_damage, expected_boosted_melee);
 
   commander_data->bonus_type = "production_haste";
   commander_data->aura_bonus_value = 0.5F;
   const float before_haste = barracks_prod->time_remaining;
   system.update(&world, 1.0F);
+  TestSupport::apply_phase_barrier(world);
   const float expected_haste_time = before_haste - commander_data->aura_bonus_value;
   EXPECT_FLOAT_EQ(barracks_prod->time_remaining, expected_haste_time);
 }
@@ -470,10 +474,12 @@ TEST(CommanderSystemTest, AttackBoostFallsOffOutsideAura) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 1.0F);
+  TestSupport::apply_phase_barrier(world);
   EXPECT_EQ(ally_attack->melee_damage, boosted_melee);
 
   ally_transform->position = {10.0F, 0.0F, 0.0F};
   system.update(&world, 1.0F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(ally_attack->damage, base_profile.combat.ranged_damage);
   EXPECT_EQ(ally_attack->melee_damage, base_profile.combat.melee_damage);
@@ -517,10 +523,12 @@ TEST(CommanderSystemTest, SpeedBoostFallsOffWhenCommanderIsWounded) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 1.0F);
+  TestSupport::apply_phase_barrier(world);
   EXPECT_FLOAT_EQ(ally_unit->speed, base_profile.combat.speed * 1.20F);
 
   commander_unit->health = 0;
   system.update(&world, 1.0F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_FLOAT_EQ(ally_unit->speed, base_profile.combat.speed);
 }
@@ -562,6 +570,7 @@ TEST(CommanderSystemTest, ManualRallyRequestRestoresNearbyWaveringAlly) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_FALSE(commander_data->rally_requested);
   EXPECT_FLOAT_EQ(commander_data->rally_cooldown_remaining, 12.0F);
@@ -607,6 +616,7 @@ TEST(CommanderSystemTest, ManualRallyModeDoesNotAutoTriggerWithoutRequest) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_FLOAT_EQ(commander_data->rally_cooldown_remaining, 0.0F);
   EXPECT_FLOAT_EQ(commander_data->rally_feedback_time, 0.0F);
@@ -661,11 +671,13 @@ TEST(CommanderFlagRallyTest, FlagRallyCompletesAfterArrivalAndTimerExpires) {
   Game::Systems::CommanderSystem system;
 
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
   EXPECT_TRUE(commander_data->flag_rally_at_position);
   EXPECT_NEAR(commander_data->flag_rally_animation_timer, 2.0F, 0.01F);
   EXPECT_FALSE(commander_data->flag_rally_flag_active);
 
   system.update(&world, 2.0F);
+  TestSupport::apply_phase_barrier(world);
   EXPECT_FALSE(commander_data->flag_rally_in_progress);
   EXPECT_FALSE(commander_data->flag_rally_at_position);
   EXPECT_TRUE(commander_data->flag_rally_flag_active);
@@ -717,6 +729,7 @@ TEST(CommanderFlagRallyTest, FlagRallyCancelledOnCommanderDeath) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_FALSE(commander_data->flag_rally_in_progress);
   EXPECT_FALSE(commander_data->flag_rally_at_position);
@@ -768,6 +781,7 @@ TEST(CommanderFlagRallyTest, CommanderMovingTowardsFlagPositionDoesNotCompleteEa
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_FALSE(commander_data->flag_rally_at_position);
   EXPECT_FALSE(commander_data->flag_rally_flag_active);
@@ -802,6 +816,7 @@ TEST(CommanderFlagRallyTest, DivergentMoveOrderCancelsFlagRally) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_FALSE(commander_data->flag_rally_in_progress);
   EXPECT_FALSE(commander_data->flag_rally_at_position);
@@ -835,6 +850,7 @@ TEST(CommanderFlagRallyTest, CombatInterruptCancelsPlantingPhase) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_FALSE(commander_data->flag_rally_in_progress);
   EXPECT_FALSE(commander_data->flag_rally_at_position);
@@ -863,6 +879,7 @@ TEST(CommanderAuraAbilityTest, ActivationStartsDurationTimer) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_TRUE(commander_data->aura_ability_active);
   EXPECT_FALSE(commander_data->aura_ability_requested);
@@ -891,6 +908,7 @@ TEST(CommanderAuraAbilityTest, DurationExpiresAndStartsCooldown) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_FALSE(commander_data->aura_ability_active);
   EXPECT_GT(commander_data->aura_ability_cooldown_remaining, 0.0F);
@@ -919,6 +937,7 @@ TEST(CommanderAuraAbilityTest, CooldownPreventsReactivation) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_FALSE(commander_data->aura_ability_active);
 }
@@ -944,6 +963,7 @@ TEST(CommanderAuraAbilityTest, DeathDeactivatesAbility) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_FALSE(commander_data->aura_ability_active);
 }
@@ -983,6 +1003,7 @@ TEST(CommanderAuraAbilityTest, ExplicitActivationAppliesConfiguredDamageBoost) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
   const int base_damage = ally_attack->damage;
   const int base_melee = ally_attack->melee_damage;
   ASSERT_GT(base_damage, 0);
@@ -992,6 +1013,7 @@ TEST(CommanderAuraAbilityTest, ExplicitActivationAppliesConfiguredDamageBoost) {
 
   commander_data->aura_ability_requested = true;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(ally_attack->damage,
             std::max(1, static_cast<int>(std::round(base_damage * 1.25F))));
@@ -1052,12 +1074,14 @@ TEST(CommanderAuraAbilityTest, ConfiguredBonusFavoursTheCommandersOwnWeaponSchoo
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
   const int base_damage = ally_attack->damage;
   const int base_melee = ally_attack->melee_damage;
   const int off_base_melee = off_attack->melee_damage;
 
   commander_data->aura_ability_requested = true;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(ally_attack->damage,
             std::max(1, static_cast<int>(std::round(base_damage * 1.25F))));
@@ -1103,6 +1127,7 @@ TEST(CommanderAuraAbilityTest, AllTroopsInRadiusReceiveVisibleBuffMarker) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(ally_unit->health, 100);
   auto* buff = ally->get_component<Engine::Core::CommanderAuraBuffComponent>();
@@ -1146,11 +1171,13 @@ TEST(CommanderAuraAbilityTest, TroopsOutsideRadiusGetNoBoost) {
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
   const int base_damage = ally_attack->damage;
   const int base_health = ally_unit->health;
 
   commander_data->aura_ability_requested = true;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(ally_attack->damage, base_damage);
   EXPECT_EQ(ally_unit->health, base_health);
@@ -1211,11 +1238,13 @@ TEST(CommanderSystemTest, CommanderDeathTurnsTheNationsCampsNeutralAndDisbandsIt
 
   Game::Systems::CommanderSystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
   EXPECT_EQ(fixture.barracks->get_component<Engine::Core::UnitComponent>()->owner_id, 2)
       << "a living commander must keep its nation intact";
 
   fixture.commander->get_component<Engine::Core::UnitComponent>()->health = 0;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(fixture.barracks->get_component<Engine::Core::UnitComponent>()->owner_id,
             Game::Core::NEUTRAL_OWNER_ID)
@@ -1240,6 +1269,7 @@ TEST(CommanderSystemTest, NationOnlyCollapsesWhenItsLastCommanderFalls) {
   Game::Systems::CommanderSystem system;
   fixture.commander->get_component<Engine::Core::UnitComponent>()->health = 0;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(fixture.barracks->get_component<Engine::Core::UnitComponent>()->owner_id,
             2);
@@ -1247,6 +1277,7 @@ TEST(CommanderSystemTest, NationOnlyCollapsesWhenItsLastCommanderFalls) {
 
   second_commander->get_component<Engine::Core::UnitComponent>()->health = 0;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(fixture.barracks->get_component<Engine::Core::UnitComponent>()->owner_id,
             Game::Core::NEUTRAL_OWNER_ID);
@@ -16,6 +16,7 @@
 #include "systems/nation_loader.h"
 #include "systems/nation_registry.h"
 #include "systems/owner_registry.h"
+#include "tests/support/phase_barrier.h"
 #include "units/spawn_type.h"
 
 using namespace Engine::Core;
@@ -54,7 +55,10 @@ protected:
     return entity;
   }
 
-  void initialize_layouts() { layouts.update(world.get(), 1.0F / 60.0F); }
+  void initialize_layouts() {
+    layouts.update(world.get(), 1.0F / 60.0F);
+    TestSupport::apply_phase_barrier(*world);
+  }
 
   void issue_guard(std::initializer_list<Entity*> entities, bool active = true) {
     std::vector<EntityID> ids;
@@ -73,6 +77,7 @@ protected:
   void advance(float seconds, float step = 1.0F / 60.0F) {
     for (float elapsed = 0.0F; elapsed < seconds; elapsed += step) {
       layouts.update(world.get(), step);
+      TestSupport::apply_phase_barrier(*world);
     }
   }
 
@@ -0,0 +1,134 @@
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "game/map/terrain_service.h"
+#include "game/systems/building_collision_registry.h"
+#include "game/systems/flow_field.h"
+#include "game/systems/pathfinding.h"
+
+namespace {
+
+using Game::Systems::CellRange;
+using Game::Systems::FlowField;
+using Game::Systems::Pathfinding;
+using Game::Systems::Point;
+
+constexpr int k_extent = 96;
+
+class FlowFieldTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    m_pathfinding.set_grid_offset(-(k_extent * 0.5F - 0.5F), -(k_extent * 0.5F - 0.5F));
+    m_pathfinding.update_navigation_grid();
+    for (int y = 0; y < k_extent; ++y) {
+      if (y < 60 || y > 63) {
+        m_pathfinding.set_obstacle(48, y, true);
+      }
+    }
+  }
+
+  void TearDown() override {
+    Game::Systems::BuildingCollisionRegistry::instance().clear();
+    Game::Map::TerrainService::instance().clear();
+  }
+
+  void expect_walkable_route(const std::vector<Point>& path,
+                             const Point& start,
+                             const Point& goal) {
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path.front(), start);
+    EXPECT_EQ(path.back(), goal);
+    for (std::size_t i = 0; i < path.size(); ++i) {
+      EXPECT_TRUE(m_pathfinding.is_walkable(path[i].x, path[i].y)) << "step " << i;
+      if (i == 0) {
+        continue;
+      }
+      int const dx = path[i].x - path[i - 1].x;
+      int const dy = path[i].y - path[i - 1].y;
+      ASSERT_LE(std::abs(dx), 1) << "step " << i;
+      ASSERT_LE(std::abs(dy), 1) << "step " << i;
+      if (dx != 0 && dy != 0) {
+        EXPECT_TRUE(m_pathfinding.is_walkable(path[i - 1].x + dx, path[i - 1].y));
+        EXPECT_TRUE(m_pathfinding.is_walkable(path[i - 1].x, path[i - 1].y + dy));
+      }
+    }
+  }
+
+  static auto step_cost(const std::vector<Point>& path) -> int {
+    int cost = 0;
+    for (std::size_t i = 1; i < path.size(); ++i) {
+      bool const diagonal = path[i].x != path[i - 1].x && path[i].y != path[i - 1].y;
+      cost += diagonal ? 14 : 10;
+    }
+    return cost;
+  }
+
+  Pathfinding m_pathfinding{k_extent, k_extent};
+};
+
+TEST_F(FlowFieldTest, EveryUnitTracesAWalkableRouteThroughTheGap) {
+  Point const goal{80, 20};
+  auto const field = m_pathfinding.flow_field(goal);
+  ASSERT_NE(field, nullptr);
+  EXPECT_EQ(field->cost_to_goal(goal), 0);
+
+  for (int row = 0; row < 6; ++row) {
+    for (int column = 0; column < 6; ++column) {
+      Point const start{10 + column * 3, 10 + row * 3};
+      auto const route = field->trace(start);
+      expect_walkable_route(route, start, goal);
+      bool crosses_gap = false;
+      for (Point const& cell : route) {
+        crosses_gap = crosses_gap || (cell.x == 48 && cell.y >= 60 && cell.y <= 63);
+      }
+      EXPECT_TRUE(crosses_gap);
+
+      auto const searched = m_pathfinding.find_path(start, goal);
+      EXPECT_LE(step_cost(route) * 100, step_cost(searched) * 105);
+    }
+  }
+  EXPECT_EQ(m_pathfinding.flow_field_builds(), 1U);
+}
+
+TEST_F(FlowFieldTest, CachedFieldIsSharedUntilTheGridChanges) {
+  Point const goal{80, 20};
+  CellRange const window{0, 90, 0, 90};
+  auto const first =
+      m_pathfinding.flow_field(goal, Pathfinding::Passability::Light, 0.0F, window);
+  auto const narrower = m_pathfinding.flow_field(
+      goal, Pathfinding::Passability::Light, 0.0F, CellRange{10, 85, 10, 70});
+  EXPECT_EQ(first, narrower);
+  EXPECT_EQ(m_pathfinding.flow_field_builds(), 1U);
+
+  auto const heavy =
+      m_pathfinding.flow_field(goal, Pathfinding::Passability::Heavy, 0.0F, window);
+  EXPECT_NE(first, heavy);
+  EXPECT_EQ(m_pathfinding.flow_field_builds(), 2U);
+
+  for (int y = 60; y <= 63; ++y) {
+    m_pathfinding.set_obstacle(48, y, true);
+  }
+  auto const rebuilt =
+      m_pathfinding.flow_field(goal, Pathfinding::Passability::Light, 0.0F, window);
+  EXPECT_NE(first, rebuilt);
+  EXPECT_EQ(m_pathfinding.flow_field_builds(), 3U);
+  EXPECT_EQ(rebuilt->cost_to_goal({10, 10}), FlowField::k_unreachable);
+  EXPECT_TRUE(rebuilt->trace({10, 10}).empty());
+}
+
+TEST_F(FlowFieldTest, WindowGrowsToCoverLaterRequests) {
+  Point const goal{80, 20};
+  auto const small = m_pathfinding.flow_field(
+      goal, Pathfinding::Passability::Light, 0.0F, CellRange{70, 90, 10, 30});
+  EXPECT_FALSE(small->contains({10, 10}));
+  EXPECT_TRUE(small->trace({10, 10}).empty());
+
+  auto const grown = m_pathfinding.flow_field(
+      goal, Pathfinding::Passability::Light, 0.0F, CellRange{0, 90, 0, 90});
+  EXPECT_NE(small, grown);
+  EXPECT_TRUE(grown->covers(small->bounds()));
+  expect_walkable_route(grown->trace({10, 10}), {10, 10}, goal);
+}
+
+} // namespace
@@ -31,6 +31,7 @@
 #include "game/units/spawn_type.h"
 #include "game/units/troop_catalog_loader.h"
 #include "game/wildlife/wildlife_species.h"
+#include "tests/support/phase_barrier.h"
 
 namespace {
 
@@ -209,6 +210,7 @@ TEST_F(FoodEconomyTest, ReapingARipeFarmLoadsFoodAndSowsTheFieldAgain) {
 
   Game::Systems::ResourceDeliverySystem delivery;
   delivery.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
   EXPECT_EQ(Game::Systems::PlayerResourceRegistry::instance().get(
                 k_owner, Game::Systems::ResourceType::Food),
             Game::Systems::k_harvest_grain_food_reward)
@@ -15,6 +15,7 @@
 #include "systems/pathfinding.h"
 #include "systems/wall_network_service.h"
 #include "systems/world_restore.h"
+#include "tests/support/phase_barrier.h"
 #include "units/spawn_type.h"
 #include "units/troop_config.h"
 #include "units/troop_type.h"
@@ -107,6 +108,7 @@ protected:
     GateSystem system;
     for (float elapsed = 0.0F; elapsed < seconds; elapsed += step) {
       system.update(&world, step);
+      TestSupport::apply_phase_barrier(world);
     }
   }
 };
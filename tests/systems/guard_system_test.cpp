@@ -7,6 +7,7 @@
 #include "systems/building_collision_registry.h"
 #include "systems/guard_system.h"
 #include "systems/nav_grid.h"
+#include "tests/support/phase_barrier.h"
 
 using namespace Engine::Core;
 using namespace Game::Systems;
@@ -52,6 +53,7 @@ TEST_F(GuardSystemTest, GuardFollowsMovingEntity) {
   guard_mode->guard_position_z = 5.0F;
 
   guard_system.update(world.get(), 0.1F);
+  TestSupport::apply_phase_barrier(*world);
 
   EXPECT_TRUE(guard_movement->get_has_target());
   EXPECT_FLOAT_EQ(guard_movement->get_goal_x(), 5.0F);
@@ -61,6 +63,7 @@ TEST_F(GuardSystemTest, GuardFollowsMovingEntity) {
   guarded_transform->position.z = 15.0F;
 
   guard_system.update(world.get(), 0.1F);
+  TestSupport::apply_phase_barrier(*world);
 
   EXPECT_FLOAT_EQ(guard_mode->guard_position_x, 15.0F);
   EXPECT_FLOAT_EQ(guard_mode->guard_position_z, 15.0F);
@@ -92,6 +95,7 @@ TEST_F(GuardSystemTest, GuardDoesNotFollowSmallMovements) {
   guard_mode->guard_position_z = 5.5F;
 
   guard_system.update(world.get(), 0.1F);
+  TestSupport::apply_phase_barrier(*world);
 
   EXPECT_FALSE(guard_movement->get_has_target());
 }
@@ -125,6 +129,7 @@ TEST_F(GuardSystemTest, GuardDoesNotFollowWhileAttacking) {
   attack_target->target_id = enemy->get_id();
 
   guard_system.update(world.get(), 0.1F);
+  TestSupport::apply_phase_barrier(*world);
 
   EXPECT_FALSE(guard_movement->get_has_target());
 
@@ -149,6 +154,7 @@ TEST_F(GuardSystemTest, GuardReturnsToPositionWhenGuardingLocation) {
   guard_mode->returning_to_guard_position = false;
 
   guard_system.update(world.get(), 0.1F);
+  TestSupport::apply_phase_barrier(*world);
 
   EXPECT_TRUE(guard_movement->get_has_target());
   EXPECT_FLOAT_EQ(guard_movement->get_goal_x(), 10.0F);
@@ -173,6 +179,7 @@ TEST_F(GuardSystemTest, GuardDoesNotMoveWhenAlreadyAtPosition) {
   guard_mode->returning_to_guard_position = false;
 
   guard_system.update(world.get(), 0.1F);
+  TestSupport::apply_phase_barrier(*world);
 
   EXPECT_FALSE(guard_movement->get_has_target());
   EXPECT_FALSE(guard_mode->returning_to_guard_position);
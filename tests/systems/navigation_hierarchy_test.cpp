@@ -0,0 +1,159 @@
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "game/map/terrain_service.h"
+#include "game/systems/building_collision_registry.h"
+#include "game/systems/navigation_hierarchy.h"
+#include "game/systems/pathfinding.h"
+
+namespace {
+
+using Game::Systems::NavigationHierarchy;
+using Game::Systems::Pathfinding;
+using Game::Systems::Point;
+
+constexpr int k_extent = 256;
+
+class NavigationHierarchyTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    m_pathfinding.set_grid_offset(-(k_extent * 0.5F - 0.5F), -(k_extent * 0.5F - 0.5F));
+    m_pathfinding.update_navigation_grid();
+    for (int y = 0; y < k_extent; ++y) {
+      if (y < 200 || y > 203) {
+        m_pathfinding.set_obstacle(80, y, true);
+      }
+      if (y < 30 || y > 34) {
+        m_pathfinding.set_obstacle(170, y, true);
+      }
+    }
+  }
+
+  void TearDown() override {
+    Game::Systems::BuildingCollisionRegistry::instance().clear();
+    Game::Map::TerrainService::instance().clear();
+  }
+
+  auto flat_path(const Point& start, const Point& goal) -> std::vector<Point> {
+    m_pathfinding.set_hierarchical_search(false);
+    auto path = m_pathfinding.find_path(start, goal);
+    m_pathfinding.set_hierarchical_search(true);
+    return path;
+  }
+
+  void expect_walkable_route(const std::vector<Point>& path,
+                             const Point& start,
+                             const Point& goal) {
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path.front(), start);
+    EXPECT_EQ(path.back(), goal);
+    for (std::size_t i = 0; i < path.size(); ++i) {
+      EXPECT_TRUE(m_pathfinding.is_walkable(path[i].x, path[i].y)) << "step " << i;
+      if (i == 0) {
+        continue;
+      }
+      int const dx = path[i].x - path[i - 1].x;
+      int const dy = path[i].y - path[i - 1].y;
+      ASSERT_LE(std::abs(dx), 1) << "step " << i;
+      ASSERT_LE(std::abs(dy), 1) << "step " << i;
+      ASSERT_FALSE(dx == 0 && dy == 0) << "step " << i;
+      if (dx != 0 && dy != 0) {
+        EXPECT_TRUE(m_pathfinding.is_walkable(path[i - 1].x + dx, path[i - 1].y));
+        EXPECT_TRUE(m_pathfinding.is_walkable(path[i - 1].x, path[i - 1].y + dy));
+      }
+    }
+  }
+
+  static auto step_cost(const std::vector<Point>& path) -> int {
+    int cost = 0;
+    for (std::size_t i = 1; i < path.size(); ++i) {
+      bool const diagonal = path[i].x != path[i - 1].x && path[i].y != path[i - 1].y;
+      cost += diagonal ? 14 : 10;
+    }
+    return cost;
+  }
+
+  Pathfinding m_pathfinding{k_extent, k_extent};
+};
+
+TEST_F(NavigationHierarchyTest, LargeGridsSearchTheAbstractGraphByDefault) {
+  EXPECT_TRUE(m_pathfinding.hierarchical_search());
+  EXPECT_FALSE(Pathfinding(64, 64).hierarchical_search());
+  EXPECT_TRUE(m_pathfinding.hierarchy().spans_clusters({10, 10}, {240, 240}));
+  EXPECT_FALSE(m_pathfinding.hierarchy().spans_clusters({10, 10}, {20, 20}));
+}
+
+TEST_F(NavigationHierarchyTest, LongRouteThreadsTheGapsAndStaysNearTheFlatCost) {
+  Point const start{10, 10};
+  Point const goal{245, 240};
+
+  auto const path = m_pathfinding.find_path(start, goal);
+  expect_walkable_route(path, start, goal);
+  EXPECT_GT(
+      m_pathfinding.hierarchy().portal_count(Pathfinding::Passability::Light), 0U);
+
+  auto const flat = flat_path(start, goal);
+  expect_walkable_route(flat, start, goal);
+  EXPECT_LE(step_cost(path) * 100, step_cost(flat) * 125);
+}
+
+TEST_F(NavigationHierarchyTest, BlockingAGapRebuildsOnlyTheClustersAroundIt) {
+  Point const start{10, 10};
+  Point const goal{245, 240};
+  auto const before = m_pathfinding.find_path(start, goal);
+  expect_walkable_route(before, start, goal);
+  auto const& hierarchy = m_pathfinding.hierarchy();
+  auto const initial_builds = hierarchy.rebuilt_clusters();
+  int const cluster_count = hierarchy.cluster_columns() * hierarchy.cluster_rows();
+  EXPECT_EQ(initial_builds, static_cast<std::uint64_t>(cluster_count));
+
+  for (int y = 200; y <= 203; ++y) {
+    m_pathfinding.set_obstacle(80, y, true);
+  }
+  for (int y = 120; y <= 123; ++y) {
+    m_pathfinding.set_obstacle(80, y, false);
+  }
+
+  auto const after = m_pathfinding.find_path(start, goal);
+  expect_walkable_route(after, start, goal);
+  EXPECT_NE(before, after);
+  auto const rebuilt = hierarchy.rebuilt_clusters() - initial_builds;
+  EXPECT_GT(rebuilt, 0U);
+  EXPECT_LT(rebuilt, static_cast<std::uint64_t>(cluster_count / 4));
+
+  bool crosses_new_gap = false;
+  for (Point const& cell : after) {
+    EXPECT_FALSE(cell.x == 80 && cell.y >= 200 && cell.y <= 203);
+    crosses_new_gap =
+        crosses_new_gap || (cell.x == 80 && cell.y >= 120 && cell.y <= 123);
+  }
+  EXPECT_TRUE(crosses_new_gap);
+}
+
+TEST_F(NavigationHierarchyTest, UnreachableGoalsFallBackToTheFlatPartialPath) {
+  for (int x = 220; x < k_extent; ++x) {
+    m_pathfinding.set_obstacle(x, 220, true);
+  }
+  for (int y = 220; y < k_extent; ++y) {
+    m_pathfinding.set_obstacle(220, y, true);
+  }
+  Point const start{10, 10};
+  Point const goal{240, 240};
+
+  auto const path = m_pathfinding.find_path(start, goal);
+  auto const flat = flat_path(start, goal);
+  EXPECT_EQ(path, flat);
+}
+
+TEST_F(NavigationHierarchyTest, HeavyUnitsGetTheirOwnLayer) {
+  Point const start{10, 10};
+  Point const goal{245, 240};
+  auto const path =
+      m_pathfinding.find_path(start, goal, Pathfinding::Passability::Heavy);
+  expect_walkable_route(path, start, goal);
+  EXPECT_GT(
+      m_pathfinding.hierarchy().portal_count(Pathfinding::Passability::Heavy), 0U);
+}
+
+} // namespace
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "game/map/terrain_service.h"
+#include "game/systems/building_collision_registry.h"
+#include "game/systems/path_request_service.h"
+#include "game/systems/pathfinding.h"
+
+namespace {
+
+using Game::Systems::PathRequest;
+using Game::Systems::PathRequestService;
+using Game::Systems::PathResult;
+using Game::Systems::PathTicket;
+using Game::Systems::Pathfinding;
+using Game::Systems::Point;
+
+class PathRequestServiceTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    m_pathfinding.set_grid_offset(-15.5F, -15.5F);
+    m_pathfinding.update_navigation_grid();
+    for (int y = 0; y < 28; ++y) {
+      m_pathfinding.set_obstacle(14, y, true);
+    }
+  }
+
+  void TearDown() override {
+    Game::Systems::BuildingCollisionRegistry::instance().clear();
+    Game::Map::TerrainService::instance().clear();
+  }
+
+  Pathfinding m_pathfinding{32, 32};
+};
+
+TEST_F(PathRequestServiceTest, ResolvesEveryTicketInSubmissionOrder) {
+  PathRequestService service(3);
+  std::vector<PathRequest> requests;
+  for (int i = 0; i < 12; ++i) {
+    requests.push_back({.start = {2, 2 + (i * 2)}, .goal = {29, 29 - (i * 2)}});
+  }
+
+  std::vector<PathTicket> tickets;
+  for (auto const& request : requests) {
+    tickets.push_back(service.submit(request));
+  }
+  EXPECT_EQ(service.pending_count(), requests.size());
+
+  auto const results = service.resolve(m_pathfinding);
+  EXPECT_EQ(service.pending_count(), 0U);
+  ASSERT_EQ(results.size(), requests.size());
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i].ticket, tickets[i]);
+    EXPECT_FALSE(results[i].coalesced);
+    EXPECT_EQ(results[i].path,
+              m_pathfinding.find_path(requests[i].start, requests[i].goal));
+  }
+  EXPECT_EQ(service.stats().searches, requests.size());
+}
+
+TEST_F(PathRequestServiceTest, IdenticalRequestsShareOneSearch) {
+  PathRequestService service(2);
+  PathRequest const request{.start = {3, 5}, .goal = {28, 6}, .clearance_radius = 0.1F};
+  for (int i = 0; i < 40; ++i) {
+    service.submit(request);
+  }
+
+  auto const results = service.resolve(m_pathfinding);
+  ASSERT_EQ(results.size(), 40U);
+  EXPECT_EQ(service.stats().searches, 1U);
+  EXPECT_EQ(service.stats().coalesced, 39U);
+  EXPECT_FALSE(results.front().coalesced);
+  for (auto const& result : results) {
+    EXPECT_EQ(result.path, results.front().path);
+  }
+  ASSERT_FALSE(results.front().path.empty());
+  EXPECT_EQ(results.front().path.back(), request.goal);
+}
+
+TEST_F(PathRequestServiceTest, NearbyStartsJoinTheLeaderPathFromTheirOwnCell) {
+  PathRequestService service(0);
+  service.set_coalesce_span(4);
+  service.submit({.start = {4, 4}, .goal = {28, 4}});
+  service.submit({.start = {5, 5}, .goal = {28, 4}});
+
+  auto const results = service.resolve(m_pathfinding);
+  ASSERT_EQ(results.size(), 2U);
+  EXPECT_EQ(service.stats().searches, 1U);
+  EXPECT_TRUE(results[1].coalesced);
+  ASSERT_GE(results[1].path.size(), 2U);
+  EXPECT_EQ(results[1].path.front(), (Point{5, 5}));
+  EXPECT_EQ(results[1].path[1], results[0].path.front());
+  EXPECT_EQ(results[1].path.back(), results[0].path.back());
+}
+
+TEST_F(PathRequestServiceTest, NearbyStartsAcrossAWallAreSearchedSeparately) {
+  PathRequestService service(2);
+  service.set_coalesce_span(4);
+  service.submit({.start = {13, 8}, .goal = {8, 30}});
+  service.submit({.start = {15, 8}, .goal = {8, 30}});
+
+  auto const results = service.resolve(m_pathfinding);
+  ASSERT_EQ(results.size(), 2U);
+  EXPECT_EQ(service.stats().searches, 2U);
+  EXPECT_FALSE(results[1].coalesced);
+  EXPECT_EQ(results[1].path, m_pathfinding.find_path({15, 8}, {8, 30}));
+}
+
+TEST_F(PathRequestServiceTest, CancelledTicketsAreNeverSolved) {
+  PathRequestService service(0);
+  PathTicket const kept = service.submit({.start = {1, 1}, .goal = {10, 10}});
+  PathTicket const dropped = service.submit({.start = {1, 20}, .goal = {30, 20}});
+
+  EXPECT_TRUE(service.cancel(dropped));
+  EXPECT_FALSE(service.cancel(dropped));
+  EXPECT_FALSE(service.is_pending(dropped));
+  EXPECT_TRUE(service.is_pending(kept));
+
+  auto const results = service.resolve(m_pathfinding);
+  ASSERT_EQ(results.size(), 1U);
+  EXPECT_EQ(results.front().ticket, kept);
+  EXPECT_EQ(service.stats().cancelled, 1U);
+}
+
+TEST_F(PathRequestServiceTest, WorkerCountDoesNotChangeTheResults) {
+  PathRequestService serial(0);
+  PathRequestService parallel(4);
+  for (int i = 0; i < 64; ++i) {
+    PathRequest const request{
+        .start = {1 + (i % 13), 1 + ((i * 7) % 29)},
+        .goal = {30 - (i % 11), 2 + ((i * 5) % 27)},
+        .passability = (i % 3 == 0) ? Pathfinding::Passability::Heavy
+                                    : Pathfinding::Passability::Light,
+        .clearance_radius = static_cast<float>(i % 4) * 0.25F};
+    serial.submit(request);
+    parallel.submit(request);
+  }
+
+  auto const expected = serial.resolve(m_pathfinding);
+  auto const actual = parallel.resolve(m_pathfinding);
+  ASSERT_EQ(expected.size(), actual.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i].ticket, actual[i].ticket);
+    EXPECT_EQ(expected[i].coalesced, actual[i].coalesced);
+    EXPECT_EQ(expected[i].path, actual[i].path) << "request " << i;
+  }
+}
+
+} // namespace
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <gtest/gtest.h>
 #include <optional>
 #include <vector>
@@ -162,6 +163,29 @@ TEST_F(PathfindingTest, HarvestedTreeClearsTreeMarkerAfterDirtyUpdate) {
   EXPECT_TRUE(pathfinding.is_walkable(3, 4));
 }
 
+TEST_F(PathfindingTest, DirtyRegionLogReportsRegionsMarkedSinceASequence) {
+  Game::Systems::Pathfinding pathfinding(16, 16);
+  std::uint64_t const before = pathfinding.dirty_region_sequence();
+  pathfinding.mark_region_dirty(2, 4, 3, 5);
+  pathfinding.mark_region_dirty(10, 12, -3, 12);
+
+  std::vector<Game::Systems::DirtyRegion> changed;
+  ASSERT_TRUE(pathfinding.dirty_regions_since(before, changed));
+  ASSERT_EQ(changed.size(), 2U);
+  EXPECT_EQ(changed[0].min_x, 2);
+  EXPECT_EQ(changed[0].max_z, 5);
+  EXPECT_EQ(changed[1].min_z, 0);
+
+  std::uint64_t const after = pathfinding.dirty_region_sequence();
+  changed.clear();
+  ASSERT_TRUE(pathfinding.dirty_regions_since(after, changed));
+  EXPECT_TRUE(changed.empty());
+
+  pathfinding.mark_navigation_grid_dirty();
+  EXPECT_FALSE(pathfinding.dirty_regions_since(after, changed))
+      << "a whole-grid change cannot be scoped to regions";
+}
+
 TEST_F(PathfindingTest, HarvestedBoulderClearsMarkerAfterDirtyUpdate) {
   Game::Map::MapDefinition map_def;
   map_def.grid.width = 16;
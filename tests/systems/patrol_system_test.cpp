@@ -4,6 +4,7 @@
 #include "core/entity.h"
 #include "core/world.h"
 #include "systems/patrol_system.h"
+#include "tests/support/phase_barrier.h"
 
 using namespace Engine::Core;
 using namespace Game::Systems;
@@ -48,6 +49,7 @@ TEST_F(PatrolSystemTest, PatrollingUnitIgnoresEnemyBuildings) {
   enemy_building->add_component<BuildingComponent>();
 
   patrol_system->update(world.get(), 0.1F);
+  TestSupport::apply_phase_barrier(*world);
 
   auto* attack_target = unit->get_component<AttackTargetComponent>();
   EXPECT_EQ(attack_target, nullptr)
@@ -77,6 +79,7 @@ TEST_F(PatrolSystemTest, PatrollingUnitAttacksEnemyTroops) {
   enemy_unit_comp->owner_id = 2;
 
   patrol_system->update(world.get(), 0.1F);
+  TestSupport::apply_phase_barrier(*world);
 
   auto* attack_target = unit->get_component<AttackTargetComponent>();
   ASSERT_NE(attack_target, nullptr)
@@ -108,6 +111,7 @@ TEST_F(PatrolSystemTest, PatrollingUnitIgnoresFriendlyUnits) {
   friendly_unit_comp->owner_id = 1;
 
   patrol_system->update(world.get(), 0.1F);
+  TestSupport::apply_phase_barrier(*world);
 
   auto* attack_target = unit->get_component<AttackTargetComponent>();
   EXPECT_EQ(attack_target, nullptr)
@@ -136,6 +140,7 @@ TEST_F(PatrolSystemTest, PatrollingUnitIgnoresDeadEnemies) {
   enemy_unit_comp->owner_id = 2;
 
   patrol_system->update(world.get(), 0.1F);
+  TestSupport::apply_phase_barrier(*world);
 
   auto* attack_target = unit->get_component<AttackTargetComponent>();
   EXPECT_EQ(attack_target, nullptr) << "Patrolling unit should not attack dead enemies";
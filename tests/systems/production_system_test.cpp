@@ -16,6 +16,7 @@
 #include "game/systems/resource_delivery_system.h"
 #include "game/units/factory.h"
 #include "tests/support/movement_test_access.h"
+#include "tests/support/phase_barrier.h"
 
 namespace {
 
@@ -104,6 +105,7 @@ TEST_F(ProductionSystemTest, BuilderChopsTreeAndAwardsWood) {
 
   Game::Systems::ResourceDeliverySystem delivery;
   delivery.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(Game::Systems::PlayerResourceRegistry::instance().get(
                 1, Game::Systems::ResourceType::Wood),
@@ -186,6 +188,7 @@ TEST_F(ProductionSystemTest, BuilderCollectsStoneAndAwardsStone) {
 
   Game::Systems::ResourceDeliverySystem delivery;
   delivery.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(Game::Systems::PlayerResourceRegistry::instance().get(
                 1, Game::Systems::ResourceType::Stone),
@@ -268,6 +271,7 @@ TEST_F(ProductionSystemTest, BuilderCollectsIronOreAndAwardsIron) {
 
   Game::Systems::ResourceDeliverySystem delivery;
   delivery.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(Game::Systems::PlayerResourceRegistry::instance().get(
                 1, Game::Systems::ResourceType::Iron),
@@ -0,0 +1,147 @@
+#include <QVector3D>
+
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "systems/projectile_store.h"
+
+namespace {
+
+using Game::Systems::ProjectileBody;
+using Game::Systems::ProjectileKind;
+using Game::Systems::ProjectileLaunch;
+using Game::Systems::ProjectileStore;
+
+auto launch_towards(float distance, float speed) -> ProjectileLaunch {
+  return {.start = QVector3D(0.0F, 1.0F, 0.0F),
+          .end = QVector3D(distance, 0.0F, 0.0F),
+          .color = QVector3D(1.0F, 0.5F, 0.25F),
+          .speed = speed,
+          .arc_height = 2.0F,
+          .inv_dist = 1.0F / distance};
+}
+
+TEST(ProjectileStoreTest, AdvanceClampsProgressAndReportsArrivalsInLaunchOrder) {
+  ProjectileStore store;
+  auto const slow = store.spawn(launch_towards(10.0F, 5.0F));
+  auto const fast = store.spawn(launch_towards(10.0F, 20.0F));
+  auto const medium = store.spawn(launch_towards(10.0F, 10.0F));
+  EXPECT_EQ(store.size(), 3U);
+
+  std::vector<std::uint32_t> due;
+  store.advance(0.5F);
+  store.collect_due(1.0F, due);
+  EXPECT_EQ(due, std::vector<std::uint32_t>{fast});
+  EXPECT_FLOAT_EQ(Game::Systems::ProjectileView(store, fast).get_progress(), 1.0F);
+  EXPECT_FLOAT_EQ(Game::Systems::ProjectileView(store, slow).get_progress(), 0.25F);
+
+  store.release(fast);
+  auto const reused = store.spawn(launch_towards(10.0F, 100.0F));
+  EXPECT_EQ(reused, fast);
+  EXPECT_EQ(store.capacity(), 3U);
+
+  store.advance(0.5F);
+  store.collect_due(1.0F, due);
+  EXPECT_EQ(due, (std::vector<std::uint32_t>{medium, reused}));
+}
+
+TEST(ProjectileStoreTest, IterationSkipsReleasedSlotsAndKeepsPayloads) {
+  ProjectileStore store;
+  auto first = launch_towards(8.0F, 4.0F);
+  first.body = ProjectileBody::Stone;
+  first.kind = ProjectileKind::FlamingStone;
+  first.should_apply_damage = true;
+  first.damage = 42;
+  first.attacker_id = 7;
+  first.target_id = 9;
+  first.target_locked_position = QVector3D(8.0F, 0.0F, 1.0F);
+  auto const stone = store.spawn(first);
+
+  auto second = launch_towards(6.0F, 4.0F);
+  second.ballista_bolt = true;
+  second.friendly_fire = true;
+  second.visual_profile.scale = 1.5F;
+  auto const bolt = store.spawn(second);
+
+  store.release(stone);
+  store.release(stone);
+  EXPECT_EQ(store.size(), 1U);
+
+  std::vector<std::uint32_t> visited;
+  for (auto const projectile : store) {
+    visited.push_back(projectile.slot());
+  }
+  EXPECT_EQ(visited, std::vector<std::uint32_t>{bolt});
+
+  auto const view = store.front();
+  EXPECT_EQ(view.body(), ProjectileBody::Arrow);
+  EXPECT_TRUE(view.is_ballista_bolt());
+  EXPECT_TRUE(view.friendly_fire());
+  EXPECT_FALSE(view.should_apply_damage());
+  EXPECT_FLOAT_EQ(view.get_scale(), 1.5F);
+  EXPECT_EQ(view.get_end(), QVector3D(6.0F, 0.0F, 0.0F));
+
+  auto const restored = store.spawn(first);
+  auto const stone_view = Game::Systems::ProjectileView(store, restored);
+  EXPECT_EQ(stone_view.get_kind(), ProjectileKind::FlamingStone);
+  EXPECT_TRUE(stone_view.should_apply_damage());
+  EXPECT_EQ(stone_view.get_damage(), 42);
+  EXPECT_EQ(stone_view.get_attacker_id(), 7U);
+  EXPECT_EQ(stone_view.get_target_id(), 9U);
+  EXPECT_EQ(stone_view.get_target_locked_position(), QVector3D(8.0F, 0.0F, 1.0F));
+
+  store.clear();
+  EXPECT_TRUE(store.empty());
+  EXPECT_TRUE(store.begin() == store.end());
+}
+
+TEST(ProjectileStoreTest, AdvanceMatchesScalarUpdateEveryTick) {
+  // The scalar update each projectile used to run, in its order of operations.
+  auto reference_step = [](float progress, float dt, float speed, float inv_dist) {
+    float const next = progress + dt * speed * inv_dist;
+    return next >= 1.0F ? 1.0F : next;
+  };
+
+  std::vector<float> const distances{3.7F, 7.3F, 11.1F, 17.3F, 23.45F, 31.7F};
+  std::vector<float> const speeds{9.5F, 12.25F, 14.3F, 21.1F};
+  for (float const dt : {1.0F / 60.0F, 1.0F / 30.0F, 0.0125F}) {
+    ProjectileStore store;
+    std::vector<std::uint32_t> slots;
+    std::vector<float> expected;
+    std::vector<ProjectileLaunch> launches;
+    for (float const distance : distances) {
+      for (float const speed : speeds) {
+        launches.push_back(launch_towards(distance, speed));
+        slots.push_back(store.spawn(launches.back()));
+        expected.push_back(0.0F);
+      }
+    }
+
+    std::vector<int> impact_tick(slots.size(), 0);
+    std::vector<int> expected_impact_tick(slots.size(), 0);
+    std::vector<std::uint32_t> due;
+    for (int tick = 1; tick <= 400; ++tick) {
+      store.advance(dt);
+      store.collect_due(1.0F, due);
+      for (std::size_t i = 0; i < slots.size(); ++i) {
+        expected[i] =
+            reference_step(expected[i], dt, launches[i].speed, launches[i].inv_dist);
+        ASSERT_EQ(Game::Systems::ProjectileView(store, slots[i]).get_progress(),
+                  expected[i])
+            << "slot " << i << " tick " << tick;
+        if (expected_impact_tick[i] == 0 && expected[i] >= 1.0F) {
+          expected_impact_tick[i] = tick;
+        }
+        if (impact_tick[i] == 0 &&
+            std::find(due.begin(), due.end(), slots[i]) != due.end()) {
+          impact_tick[i] = tick;
+        }
+      }
+    }
+    EXPECT_EQ(impact_tick, expected_impact_tick);
+  }
+}
+
+} // namespace
@@ -16,6 +16,7 @@
 #include "game/systems/resource_delivery_system.h"
 #include "game/systems/resource_stockpile.h"
 #include "game/units/spawn_type.h"
+#include "tests/support/phase_barrier.h"
 
 namespace {
 
@@ -82,6 +83,7 @@ TEST_F(ResourceDeliverySystemTest,
 
   Game::Systems::ResourceDeliverySystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(
       Game::Systems::PlayerResourceRegistry::instance().get(1, ResourceType::Wood), 0);
@@ -95,6 +97,7 @@ TEST_F(ResourceDeliverySystemTest, AHaulerIsWalkedTowardsTheStockpile) {
 
   Game::Systems::ResourceDeliverySystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   const auto* movement = hauler->get_component<Engine::Core::MovementComponent>();
   ASSERT_NE(movement, nullptr);
@@ -115,6 +118,7 @@ TEST_F(ResourceDeliverySystemTest, UnloadingAtTheYardCreditsTheOwnerOnce) {
 
   Game::Systems::ResourceDeliverySystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(
       Game::Systems::PlayerResourceRegistry::instance().get(1, ResourceType::Iron), 30);
@@ -125,6 +129,7 @@ TEST_F(ResourceDeliverySystemTest, UnloadingAtTheYardCreditsTheOwnerOnce) {
   EXPECT_GT(stockpile->deposit_flash, 0.0F);
 
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
   EXPECT_EQ(
       Game::Systems::PlayerResourceRegistry::instance().get(1, ResourceType::Iron), 30);
 }
@@ -140,6 +145,7 @@ TEST_F(ResourceDeliverySystemTest, TheYardIsFoundThroughARotatedBarracks) {
 
   Game::Systems::ResourceDeliverySystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(
       Game::Systems::PlayerResourceRegistry::instance().get(1, ResourceType::Wood), 40);
@@ -154,6 +160,7 @@ TEST_F(ResourceDeliverySystemTest, AnEnemyBarracksIsNotAValidDropOff) {
 
   Game::Systems::ResourceDeliverySystem system;
   system.update(&world, 0.1F);
+  TestSupport::apply_phase_barrier(world);
 
   EXPECT_EQ(
       Game::Systems::PlayerResourceRegistry::instance().get(2, ResourceType::Wood), 0);
@@ -183,7 +190,9 @@ TEST_F(ResourceDeliverySystemTest, AHaulerWalksTheWholeWayHomeBeforeTheCountersM
   bool credited = false;
   for (int tick = 0; tick < 900 && !credited; ++tick) {
     delivery.update(&world, 1.0F / 30.0F);
+    TestSupport::apply_phase_barrier(world);
     movement.update(&world, 1.0F / 30.0F);
+    TestSupport::apply_phase_barrier(world);
     credited = Game::Systems::PlayerResourceRegistry::instance().get(
                    1, ResourceType::Wood) > 0;
     if (!credited) {
@@ -216,6 +225,7 @@ TEST_F(ResourceDeliverySystemTest, PileHeightsFollowTheOwnersStores) {
   Game::Systems::ResourceDeliverySystem system;
   for (int tick = 0; tick < 60; ++tick) {
     system.update(&world, 0.1F);
+    TestSupport::apply_phase_barrier(world);
   }
 
   const auto* stockpile = barracks->get_component<Engine::Core::StockpileComponent>();
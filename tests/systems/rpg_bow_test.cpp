@@ -451,8 +451,8 @@ TEST_F(RpgBowTest, AnArrowFliesEvenWhenTheShotHitsNothing) {
   EXPECT_EQ(empty_shot.target_id, 0U);
   EXPECT_EQ(empty_shot.damage, 0);
   ASSERT_EQ(projectiles->projectiles().size(), 1U);
-  EXPECT_GT((projectiles->projectiles().front()->get_end() -
-             projectiles->projectiles().front()->get_start())
+  EXPECT_GT((projectiles->projectiles().front().get_end() -
+             projectiles->projectiles().front().get_start())
                 .length(),
             10.0F);
 
@@ -105,6 +105,8 @@ TEST_F(StructureCombatTest, AppliedDamageAndEventsUseEffectiveStructureDamage) {
 
   auto const result = Game::Systems::Combat::apply_unit_damage(
       &world, structure, 100, attacker->get_id());
+  EXPECT_TRUE(hit_damage.empty());
+  world.events().deliver();
 
   EXPECT_EQ(result.applied_damage, 12);
   EXPECT_EQ(result.new_health, 988);
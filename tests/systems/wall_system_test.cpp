@@ -430,6 +430,78 @@ TEST_F(WallMechanicsTest, TowerSnapSocketRejectsOccupiedEndpoint) {
   EXPECT_FALSE(snapped.has_value());
 }
 
+TEST_F(WallMechanicsTest, OccupancyIndexFollowsWallsAddedAndRemoved) {
+  Engine::Core::World world;
+
+  const QVector3D left = NavGrid::grid_to_world(Game::Systems::Point{2, 4});
+  auto* first = make_wall(world, left.x(), 0.0F, left.z(), 1);
+  EXPECT_TRUE(WallNetworkService::is_cell_occupied(world, 2, 4));
+  EXPECT_EQ(WallNetworkService::owner_connection_mask(world, 1, 4, 4),
+            WallNetworkService::k_connection_west);
+  EXPECT_EQ(WallNetworkService::owner_connection_mask(world, 2, 4, 4), 0U);
+
+  const QVector3D right = NavGrid::grid_to_world(Game::Systems::Point{6, 4});
+  auto* second = make_wall(world, right.x(), 0.0F, right.z(), 1);
+  EXPECT_EQ(WallNetworkService::owner_connection_mask(world, 1, 4, 4),
+            WallNetworkService::k_connection_west |
+                WallNetworkService::k_connection_east);
+
+  first->add_component<PendingRemovalComponent>();
+  EXPECT_FALSE(WallNetworkService::is_cell_occupied(world, 2, 4));
+  EXPECT_EQ(WallNetworkService::owner_connection_mask(world, 1, 4, 4),
+            WallNetworkService::k_connection_east);
+
+  world.destroy_entity(second->get_id());
+  EXPECT_FALSE(WallNetworkService::is_cell_occupied(world, 6, 4));
+  EXPECT_EQ(WallNetworkService::owner_connection_mask(world, 1, 4, 4), 0U);
+
+  const auto site_grid = WallNetworkService::snap_world_position(left.x(), left.z());
+  make_construction_site(world, left.x(), left.z(), 1);
+  EXPECT_TRUE(WallNetworkService::is_cell_occupied(world, site_grid.x, site_grid.z));
+  EXPECT_FALSE(
+      WallNetworkService::is_cell_occupied(world, site_grid.x, site_grid.z, false));
+}
+
+TEST_F(WallMechanicsTest, OccupancyIndexOnlyQueuesStructures) {
+  Engine::Core::World world;
+
+  const QVector3D left = NavGrid::grid_to_world(Game::Systems::Point{2, 4});
+  make_wall(world, left.x(), 0.0F, left.z(), 1);
+  ASSERT_TRUE(WallNetworkService::is_cell_occupied(world, 2, 4));
+
+  std::vector<EntityID> soldiers;
+  for (int i = 0; i < 64; ++i) {
+    auto* soldier = world.create_entity();
+    soldier->add_component<TransformComponent>(static_cast<float>(i % 8), 0.0F, 1.0F);
+    soldier->add_component<UnitComponent>(100, 100, 1.0F, 10.0F)->owner_id = 1;
+    soldiers.push_back(soldier->get_id());
+  }
+  for (std::size_t i = 0; i < soldiers.size(); i += 2) {
+    world.get_entity(soldiers[i])->add_component<PendingRemovalComponent>();
+    world.destroy_entity(soldiers[i + 1]);
+  }
+  EXPECT_EQ(WallNetworkService::pending_occupancy_updates_for_test(world), 0U)
+      << "units that never carried a structure component must not be queued";
+
+  // The spawn type lands after every component add, so the tower is only
+  // recognised because its BuildingComponent put it on the watch list.
+  const QVector3D right = NavGrid::grid_to_world(Game::Systems::Point{6, 4});
+  auto* tower = world.create_entity();
+  tower->add_component<BuildingComponent>();
+  tower->add_component<TransformComponent>(right.x(), 0.0F, right.z());
+  auto* unit = tower->add_component<UnitComponent>(2000, 2000, 0.0F, 20.0F);
+  unit->owner_id = 1;
+  unit->spawn_type = Game::Units::SpawnType::DefenseTower;
+  EXPECT_GT(WallNetworkService::pending_occupancy_updates_for_test(world), 0U);
+  EXPECT_EQ(WallNetworkService::owner_connection_mask(world, 1, 4, 4),
+            WallNetworkService::k_connection_west |
+                WallNetworkService::k_connection_east);
+
+  world.destroy_entity(tower->get_id());
+  EXPECT_EQ(WallNetworkService::owner_connection_mask(world, 1, 4, 4),
+            WallNetworkService::k_connection_west);
+}
+
 TEST_F(WallMechanicsTest, BuilderConstructionQueueConsumesMultipleWallSites) {
   Engine::Core::World world;
 
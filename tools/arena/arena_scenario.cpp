@@ -1772,16 +1772,15 @@ struct ArenaScenarioRunner::Impl {
     if (system == nullptr) {
       return;
     }
-    for (auto const& projectile : system->projectiles()) {
-      if (projectile == nullptr || !projectile->is_active() ||
-          projectile->get_progress() < 0.0F) {
+    for (auto const projectile : system->projectiles()) {
+      if (!projectile.is_active() || projectile.get_progress() < 0.0F) {
         continue;
       }
-      auto const key = projectile_pair_key(projectile->get_attacker_id(),
-                                           projectile->get_target_id());
+      auto const key = projectile_pair_key(projectile.get_attacker_id(),
+                                           projectile.get_target_id());
       if (!key.isEmpty()) {
         projectile_flights[key] = true;
-        if (Game::Systems::is_incendiary_projectile_kind(projectile->get_kind())) {
+        if (Game::Systems::is_incendiary_projectile_kind(projectile.get_kind())) {
           flaming_projectile_flights[key] = true;
         } else {
           plain_projectile_flights[key] = true;
@@ -6,17 +6,20 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "animation/bpat/bpat_format.h"
+#include "animation/bpat/bpat_reader.h"
 #include "animation/bpat/bpat_writer.h"
 #include "animation/clip_manifest.h"
 #include "game/session/session_context.h"
@@ -98,6 +101,37 @@ auto build_clip_variant_table(std::uint32_t species_id,
   return table;
 }
 
+auto to_bytes(const std::string& data) -> std::vector<std::uint8_t> {
+  return {data.begin(), data.end()};
+}
+
+void report_track_compression(std::string_view species_name,
+                              const std::string& raw,
+                              const std::string& quantized) {
+  auto const raw_blob = bpat::BpatBlob::from_bytes(to_bytes(raw));
+  auto const quantized_blob = bpat::BpatBlob::from_bytes(to_bytes(quantized));
+  if (!raw_blob.loaded() || !quantized_blob.loaded()) {
+    std::cerr << "[bpat_baker] warning: cannot reload " << species_name
+              << " for the track report\n";
+    return;
+  }
+  float max_error = 0.0F;
+  for (std::uint32_t f = 0; f < raw_blob.frame_total(); ++f) {
+    for (std::uint32_t b = 0; b < raw_blob.bone_count(); ++b) {
+      auto const expected = raw_blob.palette_matrix(f, b);
+      auto const actual = quantized_blob.palette_matrix(f, b);
+      for (std::size_t i = 0; i < expected.size(); ++i) {
+        max_error = std::max(max_error, std::abs(expected[i] - actual[i]));
+      }
+    }
+  }
+  std::cout << "[bpat_baker] " << species_name << " tracks: v3 " << raw.size()
+            << " bytes, v4 " << quantized.size() << " bytes ("
+            << (100.0 * static_cast<double>(quantized.size()) /
+                static_cast<double>(raw.size()))
+            << "%), max palette error " << max_error << "\n";
+}
+
 bool bake_species_manifest(const std::filesystem::path& out_dir,
                            const Render::Creature::SpeciesManifest& manifest) {
   if (manifest.bind_palette == nullptr || manifest.creature_spec == nullptr ||
@@ -190,15 +224,24 @@ bool bake_species_manifest(const std::filesystem::path& out_dir,
 
   std::filesystem::create_directories(out_dir);
   std::filesystem::path const out_path = out_dir / std::string(manifest.bpat_file_name);
+  std::ostringstream raw_tracks;
+  std::ostringstream quantized_tracks;
+  bool const raw_written = writer.write(raw_tracks);
+  writer.set_quantized_tracks(bpat::TrackTolerance{});
+  if (!raw_written || !writer.write(quantized_tracks)) {
+    std::cerr << "[bpat_baker] write failed for " << out_path << "\n";
+    return false;
+  }
+  report_track_compression(
+      manifest.species_name, raw_tracks.str(), quantized_tracks.str());
+
   std::ofstream out(out_path, std::ios::binary | std::ios::trunc);
   if (!out) {
     std::cerr << "[bpat_baker] cannot open " << out_path << " for writing\n";
     return false;
   }
-  if (!writer.write(out)) {
-    std::cerr << "[bpat_baker] write failed for " << out_path << "\n";
-    return false;
-  }
+  std::string const bytes = quantized_tracks.str();
+  out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
   out.flush();
   std::cout << "[bpat_baker] wrote " << out_path << " (" << writer.frame_total()
             << " frames, " << manifest.clips.size() << " clips, " << bind_palette.size()
@@ -51,6 +51,7 @@ struct Options {
   std::vector<int> unit_counts{1000, 5000, 10000};
   int ticks{k_default_ticks};
   bool per_system{true};
+  int workers{0};
 };
 
 auto files_per_army(int units_per_side) -> int {
@@ -126,7 +127,8 @@ struct Result {
   std::string system_report;
 };
 
-auto run_scenario(int units_per_side, int ticks, bool per_system) -> Result {
+auto run_scenario(int units_per_side, int ticks, bool per_system, int workers)
+    -> Result {
   const int map_size = map_size_for(units_per_side);
   Game::Systems::NavGrid::initialize(map_size, map_size);
 
@@ -161,6 +163,7 @@ auto run_scenario(int units_per_side, int ticks, bool per_system) -> Result {
   auto& world = session->world();
   auto& profiler = world.system_profiler();
   profiler.set_enabled(per_system);
+  world.set_worker_count(static_cast<std::size_t>(std::max(0, workers)));
 
   Result result;
   result.units = units_per_side * 2;
@@ -233,8 +236,12 @@ auto parse_options(int argc, char** argv, Options& options) -> bool {
       options.ticks = std::atoi(argv[++i]);
     } else if (arg == "--no-systems") {
       options.per_system = false;
+    } else if (arg == "--workers" && i + 1 < argc) {
+      options.workers = std::atoi(argv[++i]);
+      options.per_system = false;
     } else if (arg == "--help" || arg == "-h") {
-      std::printf("usage: sim_benchmark [--units N] [--ticks N] [--no-systems]\n");
+      std::printf("usage: sim_benchmark [--units N] [--ticks N] [--no-systems] "
+                  "[--workers N]\n");
       return false;
     } else {
       std::fprintf(stderr, "sim_benchmark: unknown argument '%s'\n", arg.c_str());
@@ -258,9 +265,13 @@ auto main(int argc, char** argv) -> int {
 
   std::printf("Standard of Iron -- simulation benchmark\n");
   std::printf("%d ticks per scenario, fixed 1/60 s step\n", options.ticks);
+  if (options.workers > 0) {
+    std::printf("%d system workers, per-system profile off\n", options.workers);
+  }
 
   for (const int units : options.unit_counts) {
-    const Result result = run_scenario(units / 2, options.ticks, options.per_system);
+    const Result result = run_scenario(
+        units / 2, options.ticks, options.per_system, options.workers);
     print_result(result);
   }
 